@@ -0,0 +1,388 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_HAS_TSC 1
+#else
+#define BENCH_HAS_TSC 0
+#endif
+
+#include "libuimg.h"
+
+
+// Maximum number of timed runs per operation (the median is taken over these)
+#define BENCH_MAX_RUNS 101
+// Default number of timed runs per operation
+#define BENCH_DEFAULT_RUNS 5
+// Default number of untimed warmup runs per operation
+#define BENCH_DEFAULT_WARMUP 1
+
+
+/**
+ * @brief Output formats supported by the benchmark.
+ */
+typedef enum {
+    OUTPUT_TEXT,
+    OUTPUT_CSV,
+    OUTPUT_JSON
+} OutputFormat_t;
+
+
+/**
+ * @brief A named image resolution.
+ */
+typedef struct {
+    const char * name;
+    uint16_t width;
+    uint16_t height;
+} Resolution_t;
+
+
+/**
+ * @brief The result of benchmarking a single operation at a single resolution.
+ */
+typedef struct {
+    uint64_t median_ns;
+    uint64_t min_ns;
+    uint64_t median_cycles;
+} BenchResult_t;
+
+
+static const Resolution_t resolutions[] = {
+    { "QQVGA", 160, 120 },
+    { "QVGA", 320, 240 },
+    { "VGA", 640, 480 },
+    { "HD", 1280, 720 },
+    { "FHD", 1920, 1080 },
+    { "4K", 3840, 2160 }
+};
+
+static const char * format_names[ASCII + 1] = {
+    "YUV444",
+    "YUV444p",
+    "YUV420p",
+    "RGB24",
+    "RGB565",
+    "RGB8",
+    "GRAYSCALE",
+    "NV12",
+    "NV21",
+    "YUYV",
+    "UYVY",
+    "BGR24",
+    "RGBA8888",
+    "BGRA8888",
+    "XRGB8888",
+    "ASCII"
+};
+
+
+// Wrappers running the operations on the internal thread pool (see `--threads`)
+static uint8_t convert_parallel (Image_t * img1, Image_t * img2)
+{
+    return convert_image_parallel(img1, img2, NULL);
+}
+
+
+static uint8_t flipX_parallel (Image_t * img)
+{
+    return flipX_image_parallel(img, NULL);
+}
+
+
+static uint8_t flipY_parallel (Image_t * img)
+{
+    return flipY_image_parallel(img, NULL);
+}
+
+
+static uint64_t get_time_ns (void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+
+static uint64_t get_cycles (void)
+{
+#if BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+
+static int compare_u64 (const void * a, const void * b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+
+    return (x > y) - (x < y);
+}
+
+
+static void fill_random (Image_t * img)
+{
+    uint32_t i = 0;
+    uint32_t size = get_image_data_size(img->width, img->height, img->format);
+    uint32_t state = 0x12345678;
+
+    // Pseudo-random data, so that clamping branches don't get an unrealistically easy time
+    for (i = 0; i < size; i++) {
+        state = state * 1103515245 + 12345;
+        img->data[i] = (uint8_t) (state >> 16);
+    }
+}
+
+
+static BenchResult_t run_benchmark (uint8_t (* conversion) (Image_t *, Image_t *),
+                                    uint8_t (* flip) (Image_t *),
+                                    Image_t * img1,
+                                    Image_t * img2,
+                                    uint32_t warmup,
+                                    uint32_t runs)
+{
+    uint32_t i = 0;
+    uint64_t start_ns = 0;
+    uint64_t start_cycles = 0;
+    uint64_t times_ns[BENCH_MAX_RUNS] = { 0 };
+    uint64_t times_cycles[BENCH_MAX_RUNS] = { 0 };
+    BenchResult_t result = { 0, 0, 0 };
+
+    for (i = 0; i < warmup + runs; i++) {
+        start_ns = get_time_ns();
+        start_cycles = get_cycles();
+
+        if (conversion) conversion(img1, img2);
+        else flip(img1);
+
+        if (i >= warmup) {
+            times_cycles[i - warmup] = get_cycles() - start_cycles;
+            times_ns[i - warmup] = get_time_ns() - start_ns;
+        }
+    }
+
+    qsort(times_ns, runs, sizeof(uint64_t), compare_u64);
+    qsort(times_cycles, runs, sizeof(uint64_t), compare_u64);
+
+    result.median_ns = times_ns[runs / 2];
+    result.min_ns = times_ns[0];
+    result.median_cycles = times_cycles[runs / 2];
+
+    return result;
+}
+
+
+static void print_header (OutputFormat_t output)
+{
+    switch (output) {
+        case OUTPUT_CSV:
+            printf("operation,base_format,target_format,resolution,width,height,median_ns,min_ns,ns_per_pixel,"
+                   "mb_per_s,cycles_per_pixel\n");
+            break;
+
+        case OUTPUT_JSON:
+            printf("[\n");
+            break;
+
+        default:
+        case OUTPUT_TEXT:
+            printf("%-8s %-10s %-10s %-6s %11s %11s %9s %10s %8s\n", "op", "base", "target", "res", "median_us",
+                   "min_us", "ns/px", "MB/s", "cyc/px");
+            break;
+    }
+}
+
+
+static void print_result (OutputFormat_t output,
+                          uint8_t first,
+                          const char * operation,
+                          PixelFormat_t base_format,
+                          PixelFormat_t target_format,
+                          const Resolution_t * res,
+                          uint32_t bytes,
+                          BenchResult_t result)
+{
+    double pixels = (double) res->width * res->height;
+    double ns_per_pixel = result.median_ns / pixels;
+    double mb_per_s = result.median_ns ? bytes / (result.median_ns / 1e9) / 1e6 : 0;
+    double cycles_per_pixel = result.median_cycles / pixels;
+
+    switch (output) {
+        case OUTPUT_CSV:
+            printf("%s,%s,%s,%s,%u,%u,%llu,%llu,%.4f,%.2f,%.4f\n", operation, format_names[base_format],
+                   format_names[target_format], res->name, res->width, res->height,
+                   (unsigned long long) result.median_ns, (unsigned long long) result.min_ns, ns_per_pixel, mb_per_s,
+                   cycles_per_pixel);
+            break;
+
+        case OUTPUT_JSON:
+            printf("%s  {\"operation\": \"%s\", \"base_format\": \"%s\", \"target_format\": \"%s\", "
+                   "\"resolution\": \"%s\", \"width\": %u, \"height\": %u, \"median_ns\": %llu, \"min_ns\": %llu, "
+                   "\"ns_per_pixel\": %.4f, \"mb_per_s\": %.2f, \"cycles_per_pixel\": %.4f}", first ? "" : ",\n",
+                   operation, format_names[base_format], format_names[target_format], res->name, res->width,
+                   res->height, (unsigned long long) result.median_ns, (unsigned long long) result.min_ns,
+                   ns_per_pixel, mb_per_s, cycles_per_pixel);
+            break;
+
+        default:
+        case OUTPUT_TEXT:
+            printf("%-8s %-10s %-10s %-6s %11.1f %11.1f %9.3f %10.1f %8.2f\n", operation, format_names[base_format],
+                   format_names[target_format], res->name, result.median_ns / 1e3, result.min_ns / 1e3,
+                   ns_per_pixel, mb_per_s, cycles_per_pixel);
+            break;
+    }
+}
+
+
+static void print_usage (const char * name)
+{
+    printf("Usage: %s [options]\n\n", name);
+    printf("Benchmarks every entry of conversion_function_LUT and flip_function_LUT.\n\n");
+    printf("Options:\n");
+    printf("  -f, --format <text|csv|json>  Output format (default: text)\n");
+    printf("  -r, --runs <n>                Timed runs per operation, median is reported (default: %d, max: %d)\n",
+           BENCH_DEFAULT_RUNS, BENCH_MAX_RUNS);
+    printf("  -w, --warmup <n>              Untimed warmup runs per operation (default: %d)\n",
+           BENCH_DEFAULT_WARMUP);
+    printf("  -s, --sizes <list>            Comma-separated resolutions (default: all of QQVGA,QVGA,VGA,HD,FHD,4K)\n");
+    printf("  -t, --threads <n>             Run the parallel operations on n threads (default: 1, serial operations)\n");
+    printf("  -h, --help                    Show this message\n");
+}
+
+
+int main (int argc, char ** argv)
+{
+    int i = 0;
+    uint32_t r = 0;
+    uint32_t base = 0;
+    uint32_t target = 0;
+    uint32_t axis = 0;
+    uint32_t runs = BENCH_DEFAULT_RUNS;
+    uint32_t warmup = BENCH_DEFAULT_WARMUP;
+    uint32_t threads = 1;
+    uint32_t bytes = 0;
+    uint8_t first = 1;
+    uint8_t selected[sizeof(resolutions) / sizeof(resolutions[0])] = { 0 };
+    uint32_t resolution_count = sizeof(resolutions) / sizeof(resolutions[0]);
+    OutputFormat_t output = OUTPUT_TEXT;
+    const Resolution_t * res = NULL;
+    Image_t * img1 = NULL;
+    Image_t * img2 = NULL;
+    BenchResult_t result = { 0, 0, 0 };
+    char * token = NULL;
+
+    memset(selected, 1, sizeof(selected));
+
+    for (i = 1; i < argc; i++) {
+        if ((!strcmp(argv[i], "-f") || !strcmp(argv[i], "--format")) && i + 1 < argc) {
+            i++;
+            if (!strcmp(argv[i], "csv")) output = OUTPUT_CSV;
+            else if (!strcmp(argv[i], "json")) output = OUTPUT_JSON;
+            else if (!strcmp(argv[i], "text")) output = OUTPUT_TEXT;
+            else {
+                fprintf(stderr, "Unknown output format '%s'\n", argv[i]);
+                return 1;
+            }
+        } else if ((!strcmp(argv[i], "-r") || !strcmp(argv[i], "--runs")) && i + 1 < argc) {
+            runs = strtoul(argv[++i], NULL, 10);
+            if (runs < 1 || runs > BENCH_MAX_RUNS) {
+                fprintf(stderr, "Number of runs must be between 1 and %d\n", BENCH_MAX_RUNS);
+                return 1;
+            }
+        } else if ((!strcmp(argv[i], "-w") || !strcmp(argv[i], "--warmup")) && i + 1 < argc) {
+            warmup = strtoul(argv[++i], NULL, 10);
+        } else if ((!strcmp(argv[i], "-t") || !strcmp(argv[i], "--threads")) && i + 1 < argc) {
+            threads = strtoul(argv[++i], NULL, 10);
+            if (threads > 1 && !init_thread_pool(threads)) {
+                fprintf(stderr, "Could not start a pool of %u threads\n", threads);
+                return 1;
+            }
+        } else if ((!strcmp(argv[i], "-s") || !strcmp(argv[i], "--sizes")) && i + 1 < argc) {
+            memset(selected, 0, sizeof(selected));
+            for (token = strtok(argv[++i], ","); token; token = strtok(NULL, ",")) {
+                for (r = 0; r < resolution_count; r++) {
+                    if (!strcmp(token, resolutions[r].name)) break;
+                }
+                if (r == resolution_count) {
+                    fprintf(stderr, "Unknown resolution '%s'\n", token);
+                    return 1;
+                }
+                selected[r] = 1;
+            }
+        } else {
+            print_usage(argv[0]);
+            return strcmp(argv[i], "-h") && strcmp(argv[i], "--help");
+        }
+    }
+
+    print_header(output);
+
+    for (r = 0; r < resolution_count; r++) {
+        if (!selected[r]) continue;
+        res = &resolutions[r];
+
+        // Conversions
+        for (base = 0; base < ASCII; base++) {
+            for (target = 0; target <= ASCII; target++) {
+                if (!conversion_function_LUT[base][target]) continue;
+
+                img1 = create_image(res->width, res->height, base);
+                img2 = create_image(res->width, res->height, target);
+                if (!img1 || !img2) {
+                    fprintf(stderr, "Could not allocate %s images\n", res->name);
+                    return 1;
+                }
+                fill_random(img1);
+
+                result = run_benchmark(threads > 1 ? convert_parallel : conversion_function_LUT[base][target],
+                                       NULL, img1, img2, warmup, runs);
+                bytes = get_image_data_size(res->width, res->height, base) +
+                        get_image_data_size(res->width, res->height, target);
+                print_result(output, first, "convert", base, target, res, bytes, result);
+                first = 0;
+
+                destroy_image(img1);
+                destroy_image(img2);
+            }
+        }
+
+        // Flips
+        for (axis = 0; axis < 2; axis++) {
+            for (base = 0; base <= ASCII; base++) {
+                if (!flip_function_LUT[axis][base]) continue;
+
+                img1 = create_image(res->width, res->height, base);
+                if (!img1) {
+                    fprintf(stderr, "Could not allocate %s image\n", res->name);
+                    return 1;
+                }
+                fill_random(img1);
+
+                result = run_benchmark(NULL,
+                                       threads > 1 ? (axis ? flipY_parallel : flipX_parallel)
+                                                   : flip_function_LUT[axis][base],
+                                       img1, NULL, warmup, runs);
+                // Flips read and write every byte of the image once
+                bytes = 2 * get_image_data_size(res->width, res->height, base);
+                print_result(output, first, axis ? "flipY" : "flipX", base, base, res, bytes, result);
+                first = 0;
+
+                destroy_image(img1);
+            }
+        }
+    }
+
+    if (output == OUTPUT_JSON) printf("\n]\n");
+
+    shutdown_thread_pool();
+
+    return 0;
+}
@@ -2,8 +2,22 @@
 #define __LIB_UIMG_MAIN_H__
 
 #include "libuimg_img.h"
+#include "libuimg_pool.h"
+#include "libuimg_raw.h"
+#include "libuimg_pnm.h"
+#include "libuimg_jpeg.h"
+#include "libuimg_png.h"
 #include "libuimg_conversions.h"
 #include "libuimg_flips.h"
+#include "libuimg_rotations.h"
+#include "libuimg_scaling.h"
+#include "libuimg_colorspace.h"
+#include "libuimg_blend.h"
+#include "libuimg_simd.h"
+#include "libuimg_threads.h"
+#include "libuimg_stream.h"
+#include "libuimg_plan.h"
+#include "libuimg_y4m.h"
 
 
 #define LIBUIMG_VERSION 0.0.1 /**< The current version of libuimg. */
@@ -0,0 +1,329 @@
+#include <string.h>
+
+#include "libuimg_blend.h"
+#include "libuimg_simd.h"
+#include "libuimg_colorspace.h"
+
+
+/**
+ * @brief An overlay to composite, with its position in the image.
+ */
+typedef struct {
+    /** The overlay (RGBA8888 or GRAYSCALE). */
+    const Image_t * overlay_img;
+    /** The alpha values of a GRAYSCALE overlay (NULL for an RGBA8888 overlay). */
+    const Image_t * mask_img;
+    /** The column of the image the left edge of the overlay is placed at. */
+    int32_t x;
+    /** The row of the image the top edge of the overlay is placed at. */
+    int32_t y;
+    /** The first column of the image covered by the overlay. */
+    int32_t first_col;
+    /** The column of the image following the last one covered by the overlay. */
+    int32_t end_col;
+    /** The first row of the image covered by the overlay. */
+    int32_t first_row;
+    /** The row of the image following the last one covered by the overlay. */
+    int32_t end_row;
+} Overlay_t;
+
+
+/**
+ * @brief A block of overlay pixels, covering up to `SIMD_BLOCK_SIZE` pixels of a row of the image.
+ */
+typedef struct {
+    /** The R, G and B values of the pixels (straight alpha). */
+    uint8_t rgb[3][SIMD_BLOCK_SIZE];
+    /** The alpha values of the pixels (0 for pixels outside of the overlay). */
+    uint8_t alpha[SIMD_BLOCK_SIZE];
+} OverlayBlock_t;
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * OVERLAY BLOCKS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Check whether every alpha value of a span of pixels is 0 (alpha values being `step` bytes apart)
+static inline uint8_t is_transparent_span (const uint8_t * alpha, uint32_t count, uint8_t step)
+{
+    uint32_t i = 0;
+    uint8_t any = 0;
+
+    for (i = 0; i < count; i++) {
+        any |= alpha[i * step];
+    }
+
+    return !any;
+}
+
+
+// Load the overlay pixels covering `count` pixels of a row of the image from column `col` (pixels outside of the
+// overlay are transparent). Return 0 without loading anything if all of them are transparent.
+static uint8_t load_overlay_block (const Overlay_t * overlay,
+                                   int32_t col,
+                                   int32_t row,
+                                   uint32_t count,
+                                   OverlayBlock_t * block)
+{
+    int32_t first = 0;
+    int32_t end = 0;
+    uint16_t overlay_col = 0;
+    uint16_t overlay_row = 0;
+    const uint8_t * pixels = NULL;
+    const uint8_t * mask = NULL;
+
+    if (row < overlay->first_row || row >= overlay->end_row) return 0;
+
+    // Part of the block that lies within the overlay
+    first = overlay->first_col - col;
+    if (first < 0) first = 0;
+    end = overlay->end_col - col;
+    if (end > (int32_t) count) end = count;
+    if (first >= end) return 0;
+
+    overlay_col = col + first - overlay->x;
+    overlay_row = row - overlay->y;
+    pixels = get_image_row(overlay->overlay_img, 0, overlay_row);
+
+    // The alpha values are checked before anything else is read, so that transparent tiles cost as little as possible
+    if (overlay->mask_img) {
+        mask = get_image_row(overlay->mask_img, 0, overlay_row) + overlay_col;
+        if (is_transparent_span(mask, end - first, 1)) return 0;
+
+        memcpy(&block->alpha[first], mask, end - first);
+        memcpy(&block->rgb[0][first], pixels + overlay_col, end - first);
+        memcpy(&block->rgb[1][first], pixels + overlay_col, end - first);
+        memcpy(&block->rgb[2][first], pixels + overlay_col, end - first);
+    }
+    else {
+        // RGBA8888 pixels are little-endian words, stored as A, B, G, R
+        pixels += overlay_col * 4;
+        if (is_transparent_span(pixels, end - first, 4)) return 0;
+
+        deinterleave_32bpp_block(pixels, &block->alpha[first], &block->rgb[2][first], &block->rgb[1][first],
+                                 &block->rgb[0][first], end - first);
+    }
+
+    memset(block->alpha, 0, first);
+    memset(&block->alpha[end], 0, count - end);
+
+    return 1;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * RGB COMPOSITING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Composite a premultiplied block onto RGB24 pixels
+static void blend_RGB24_block (const OverlayBlock_t * block, uint8_t * pixels, uint32_t count)
+{
+    uint8_t k = 0;
+    uint8_t channels[3][SIMD_BLOCK_SIZE] = { { 0 } };
+
+    deinterleave_24bpp_block(pixels, channels[0], channels[1], channels[2], count);
+    for (k = 0; k < 3; k++) {
+        blend_8bpp_block(block->rgb[k], block->alpha, channels[k], count);
+    }
+    interleave_24bpp_block(channels[0], channels[1], channels[2], pixels, count);
+}
+
+
+// Composite a premultiplied block onto RGB565 pixels
+static void blend_RGB565_block (const OverlayBlock_t * block, uint8_t * pixels, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+    uint8_t low[SIMD_BLOCK_SIZE] = { 0 };
+    uint8_t high[SIMD_BLOCK_SIZE] = { 0 };
+    uint8_t channels[3][SIMD_BLOCK_SIZE] = { { 0 } };
+
+    // Channels are expanded by replicating their top bits, so that truncating them back is lossless where the overlay
+    // is transparent
+    deinterleave_16bpp_block(pixels, low, high, count);
+    for (i = 0; i < count; i++) {
+        channels[0][i] = (high[i] & 0xf8) | (high[i] >> 5);
+        channels[1][i] = ((high[i] & 0x07) << 5) | ((low[i] & 0xe0) >> 3) | ((high[i] & 0x06) >> 1);
+        channels[2][i] = (low[i] << 3) | ((low[i] & 0x1f) >> 2);
+    }
+
+    for (k = 0; k < 3; k++) {
+        blend_8bpp_block(block->rgb[k], block->alpha, channels[k], count);
+    }
+
+    for (i = 0; i < count; i++) {
+        high[i] = (channels[0][i] & 0xf8) | (channels[1][i] >> 5);
+        low[i] = ((channels[1][i] << 3) & 0xe0) | (channels[2][i] >> 3);
+    }
+    interleave_16bpp_block(low, high, pixels, count);
+}
+
+
+// Composite an overlay onto an RGB24 or RGB565 image, one block of a row at a time
+static void blend_rgb_rows (Image_t * img, const Overlay_t * overlay)
+{
+    int32_t row = 0;
+    int32_t col = 0;
+    uint32_t count = 0;
+    uint8_t k = 0;
+    uint8_t * pixels = NULL;
+    OverlayBlock_t block = { { { 0 } }, { 0 } };
+
+    for (row = overlay->first_row; row < overlay->end_row; row++) {
+        pixels = get_image_row(img, 0, row);
+
+        for (col = overlay->first_col; col < overlay->end_col; col += count) {
+            count = overlay->end_col - col;
+            if (count > SIMD_BLOCK_SIZE) count = SIMD_BLOCK_SIZE;
+
+            if (!load_overlay_block(overlay, col, row, count, &block)) continue;
+
+            for (k = 0; k < 3; k++) {
+                premultiply_8bpp_block(block.rgb[k], block.alpha, block.rgb[k], count);
+            }
+
+            if (img->format == RGB565) blend_RGB565_block(&block, pixels + col * 2, count);
+            else blend_RGB24_block(&block, pixels + col * 3, count);
+        }
+    }
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * YUV420p COMPOSITING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Composite an overlay onto a YUV420p image, one tile of two rows at a time (so that every chroma value is composited
+// once, with all of the pixels sharing it)
+static void blend_YUV420p_rows (Image_t * img, const Overlay_t * overlay)
+{
+    int32_t row = 0;
+    int32_t col = 0;
+    int32_t first_row = overlay->first_row & ~1;
+    int32_t first_col = overlay->first_col & ~1;
+    int32_t end_col = (overlay->end_col + 1) & ~1;
+    uint32_t count = 0;
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t n = 0;
+    uint32_t sums[3] = { 0 };
+    uint8_t k = 0;
+    uint8_t c = 0;
+    uint8_t row_count = 0;
+    uint8_t visible = 0;
+    OverlayBlock_t blocks[2] = { { { { 0 } }, { 0 } } };
+    uint8_t yuv[2][3][SIMD_BLOCK_SIZE] = { { { 0 } } };
+    uint8_t chroma[2][SIMD_BLOCK_SIZE / 2] = { { 0 } };
+    uint8_t chroma_alpha[SIMD_BLOCK_SIZE / 2] = { 0 };
+
+    if (end_col > img->width) end_col = img->width;
+
+    for (row = first_row; row < overlay->end_row; row += 2) {
+        row_count = (row + 1 < img->height) ? 2 : 1;
+
+        // Blocks start on even columns, so that they never split a chroma value
+        for (col = first_col; col < end_col; col += count) {
+            count = end_col - col;
+            if (count > SIMD_BLOCK_SIZE) count = SIMD_BLOCK_SIZE;
+            visible = 0;
+
+            for (k = 0; k < row_count; k++) {
+                if (!load_overlay_block(overlay, col, row + k, count, &blocks[k])) {
+                    // Transparent rows still take part in the chroma averages
+                    memset(blocks[k].alpha, 0, count);
+                    for (c = 0; c < 3; c++) {
+                        memset(yuv[k][c], 0, count);
+                    }
+                    continue;
+                }
+
+                // Colors are converted with straight alpha (the offsets of the matrix do not commute with it)
+                convert_color_block(get_rgb_to_yuv_matrix(img->colorspace), blocks[k].rgb[0], blocks[k].rgb[1],
+                                    blocks[k].rgb[2], yuv[k][0], yuv[k][1], yuv[k][2], count);
+                for (c = 0; c < 3; c++) {
+                    premultiply_8bpp_block(yuv[k][c], blocks[k].alpha, yuv[k][c], count);
+                }
+
+                blend_8bpp_block(yuv[k][0], blocks[k].alpha, get_image_row(img, 0, row + k) + col, count);
+                visible = 1;
+            }
+
+            if (!visible) continue;
+
+            // Average of the premultiplied chroma and alpha values of every 2x2 block (within the image)
+            for (j = 0; j < (count + 1) / 2; j++) {
+                n = 0;
+                sums[0] = 0;
+                sums[1] = 0;
+                sums[2] = 0;
+
+                for (k = 0; k < row_count; k++) {
+                    for (i = j * 2; i < j * 2 + 2 && i < count; i++) {
+                        sums[0] += yuv[k][1][i];
+                        sums[1] += yuv[k][2][i];
+                        sums[2] += blocks[k].alpha[i];
+                        n++;
+                    }
+                }
+
+                chroma[0][j] = (sums[0] + n / 2) / n;
+                chroma[1][j] = (sums[1] + n / 2) / n;
+                chroma_alpha[j] = (sums[2] + n / 2) / n;
+            }
+
+            blend_8bpp_block(chroma[0], chroma_alpha, get_image_row(img, 1, row / 2) + col / 2, (count + 1) / 2);
+            blend_8bpp_block(chroma[1], chroma_alpha, get_image_row(img, 2, row / 2) + col / 2, (count + 1) / 2);
+        }
+    }
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * HIGH-LEVEL BLENDING FUNCTIONS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+uint8_t blend_image (Image_t * img, const Image_t * overlay_img, const Image_t * mask_img, int32_t x, int32_t y)
+{
+    Overlay_t overlay;
+
+    if (!img || !img->data) return 0;
+    if (img->format != RGB24 && img->format != RGB565 && img->format != YUV420p) return 0;
+    if (!overlay_img || !overlay_img->data) return 0;
+
+    if (overlay_img->format == RGBA8888) {
+        if (mask_img) return 0;
+    }
+    else if (overlay_img->format == GRAYSCALE) {
+        if (!mask_img || !mask_img->data) return 0;
+        if (mask_img->format != GRAYSCALE) return 0;
+        if (mask_img->width != overlay_img->width || mask_img->height != overlay_img->height) return 0;
+    }
+    else {
+        return 0;
+    }
+
+    // Nothing to do if the overlay lies outside of the image
+    if (x >= (int32_t) img->width || y >= (int32_t) img->height) return 1;
+
+    overlay.overlay_img = overlay_img;
+    overlay.mask_img = mask_img;
+    overlay.x = x;
+    overlay.y = y;
+    overlay.first_col = (x < 0) ? 0 : x;
+    overlay.end_col = x + overlay_img->width;
+    if (overlay.end_col > img->width) overlay.end_col = img->width;
+    overlay.first_row = (y < 0) ? 0 : y;
+    overlay.end_row = y + overlay_img->height;
+    if (overlay.end_row > img->height) overlay.end_row = img->height;
+
+    if (overlay.first_col >= overlay.end_col || overlay.first_row >= overlay.end_row) return 1;
+
+    if (img->format == YUV420p) blend_YUV420p_rows(img, &overlay);
+    else blend_rgb_rows(img, &overlay);
+
+    return 1;
+}
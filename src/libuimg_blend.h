@@ -0,0 +1,36 @@
+#ifndef __LIB_UIMG_BLEND_H__
+#define __LIB_UIMG_BLEND_H__
+
+
+#include "libuimg_img.h"
+
+
+/**
+ * @brief      Alpha-composite an overlay onto an image (the "over" operator).
+ *
+ * The overlay is either an RGBA8888 image (with straight, not premultiplied, alpha values) and no mask, or a
+ * GRAYSCALE image and a GRAYSCALE mask of the same size holding the alpha value of every pixel (typically, for
+ * antialiased text). Its top-left corner is placed at (x, y) in the image, and it is clipped to the image; x and y may
+ * be negative.
+ *
+ * Colors are premultiplied by their alpha values and composited with exact 8-bit fixed-point math: a transparent
+ * pixel leaves the image untouched and an opaque one replaces it. RGB565 pixels are expanded to 8 bits per channel
+ * and truncated back. The overlay is converted to YUV for YUV420p images: Y values are composited for every pixel,
+ * and U and V values once per 2x2 block, with the average premultiplied U, V and alpha values of the block.
+ *
+ * The overlay is processed in tiles of up to `SIMD_BLOCK_SIZE` pixels, and fully transparent tiles are skipped
+ * without touching the image, so that sparse overlays (such as text or bounding boxes) cost little more than reading
+ * their alpha values.
+ *
+ * @param      img          The image to composite the overlay onto (RGB24, RGB565 or YUV420p).
+ * @param[in]  overlay_img  The overlay (RGBA8888 or GRAYSCALE).
+ * @param[in]  mask_img     The alpha values of a GRAYSCALE overlay (GRAYSCALE), or NULL for an RGBA8888 overlay.
+ * @param[in]  x            The column of the image the left edge of the overlay is placed at.
+ * @param[in]  y            The row of the image the top edge of the overlay is placed at.
+ *
+ * @return     1 if successful (including when the overlay lies outside of the image), 0 otherwise.
+ */
+uint8_t blend_image (Image_t * img, const Image_t * overlay_img, const Image_t * mask_img, int32_t x, int32_t y);
+
+
+#endif
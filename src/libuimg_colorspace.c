@@ -0,0 +1,130 @@
+#include "libuimg_colorspace.h"
+
+
+/**
+ * @brief The YUV -> RGB matrices, indexed by standard then range.
+ *
+ * Coefficients are the 8-bit fixed-point inverses of the RGB -> YUV transformations (scaled by 255/219 for Y and
+ * 255/224 for U and V in limited range); BT.601 limited range is `yuv_to_rgb_matrix`.
+ */
+static const ColorMatrix_t yuv_to_rgb_matrices[3][2] = {
+    {
+        {
+            .in_offset = { 16, 128, 128 },
+            .coef = { { 298, 0, 409 }, { 298, -100, -208 }, { 298, 516, 0 } },
+            .out_offset = { 0, 0, 0 }
+        },
+        {
+            .in_offset = { 0, 128, 128 },
+            .coef = { { 256, 0, 359 }, { 256, -88, -183 }, { 256, 454, 0 } },
+            .out_offset = { 0, 0, 0 }
+        }
+    },
+    {
+        {
+            .in_offset = { 16, 128, 128 },
+            .coef = { { 298, 0, 459 }, { 298, -55, -136 }, { 298, 541, 0 } },
+            .out_offset = { 0, 0, 0 }
+        },
+        {
+            .in_offset = { 0, 128, 128 },
+            .coef = { { 256, 0, 403 }, { 256, -48, -120 }, { 256, 475, 0 } },
+            .out_offset = { 0, 0, 0 }
+        }
+    },
+    {
+        {
+            .in_offset = { 16, 128, 128 },
+            .coef = { { 298, 0, 430 }, { 298, -48, -167 }, { 298, 548, 0 } },
+            .out_offset = { 0, 0, 0 }
+        },
+        {
+            .in_offset = { 0, 128, 128 },
+            .coef = { { 256, 0, 377 }, { 256, -42, -146 }, { 256, 482, 0 } },
+            .out_offset = { 0, 0, 0 }
+        }
+    }
+};
+
+/**
+ * @brief The RGB -> YUV matrices, indexed by standard then range.
+ *
+ * Coefficients are rounded so that the rows of Y add up to 220 (limited range) or 256 (full range), and the rows of U
+ * and V to 0: white maps to the highest Y value, and grays to neutral U and V values. BT.601 limited range is
+ * `rgb_to_yuv_matrix`.
+ */
+static const ColorMatrix_t rgb_to_yuv_matrices[3][2] = {
+    {
+        {
+            .in_offset = { 0, 0, 0 },
+            .coef = { { 66, 129, 25 }, { -38, -74, 112 }, { 112, -94, -18 } },
+            .out_offset = { 16, 128, 128 }
+        },
+        {
+            .in_offset = { 0, 0, 0 },
+            .coef = { { 77, 150, 29 }, { -43, -85, 128 }, { 128, -107, -21 } },
+            .out_offset = { 0, 128, 128 }
+        }
+    },
+    {
+        {
+            .in_offset = { 0, 0, 0 },
+            .coef = { { 47, 157, 16 }, { -26, -86, 112 }, { 112, -102, -10 } },
+            .out_offset = { 16, 128, 128 }
+        },
+        {
+            .in_offset = { 0, 0, 0 },
+            .coef = { { 54, 183, 19 }, { -29, -99, 128 }, { 128, -116, -12 } },
+            .out_offset = { 0, 128, 128 }
+        }
+    },
+    {
+        {
+            .in_offset = { 0, 0, 0 },
+            .coef = { { 58, 149, 13 }, { -31, -81, 112 }, { 112, -103, -9 } },
+            .out_offset = { 16, 128, 128 }
+        },
+        {
+            .in_offset = { 0, 0, 0 },
+            .coef = { { 67, 174, 15 }, { -36, -92, 128 }, { 128, -118, -10 } },
+            .out_offset = { 0, 128, 128 }
+        }
+    }
+};
+
+
+uint8_t init_colorspace (Colorspace_t * colorspace, ColorStandard_t standard, ColorRange_t range)
+{
+    if (!colorspace) return 0;
+    if (standard > COLOR_BT2020) return 0;
+    if (range > COLOR_FULL_RANGE) return 0;
+
+    colorspace->standard = standard;
+    colorspace->range = range;
+
+    colorspace->yuv_to_rgb = yuv_to_rgb_matrices[standard][range];
+    init_color_terms(&colorspace->yuv_to_rgb, colorspace->yuv_to_rgb_terms);
+    colorspace->yuv_to_rgb.terms = (const int32_t (*)[3][256]) colorspace->yuv_to_rgb_terms;
+
+    colorspace->rgb_to_yuv = rgb_to_yuv_matrices[standard][range];
+    init_color_terms(&colorspace->rgb_to_yuv, colorspace->rgb_to_yuv_terms);
+    colorspace->rgb_to_yuv.terms = (const int32_t (*)[3][256]) colorspace->rgb_to_yuv_terms;
+
+    return 1;
+}
+
+
+const ColorMatrix_t * get_yuv_to_rgb_matrix (const Colorspace_t * colorspace)
+{
+    if (!colorspace) return &yuv_to_rgb_matrix;
+
+    return &colorspace->yuv_to_rgb;
+}
+
+
+const ColorMatrix_t * get_rgb_to_yuv_matrix (const Colorspace_t * colorspace)
+{
+    if (!colorspace) return &rgb_to_yuv_matrix;
+
+    return &colorspace->rgb_to_yuv;
+}
@@ -0,0 +1,85 @@
+#ifndef __LIB_UIMG_COLORSPACE_H__
+#define __LIB_UIMG_COLORSPACE_H__
+
+
+#include "libuimg_img.h"
+#include "libuimg_simd.h"
+
+
+/**
+ * @brief Enumeration of the supported YUV standards (which set the weights of R, G and B in Y).
+ */
+typedef enum {
+    COLOR_BT601,   /**< ITU-R BT.601 (SD video, JPEG/JFIF, most cameras). */
+    COLOR_BT709,   /**< ITU-R BT.709 (HD video). */
+    COLOR_BT2020   /**< ITU-R BT.2020 (UHD video, non-constant luminance). */
+} ColorStandard_t;
+
+/**
+ * @brief Enumeration of the supported ranges of YUV values.
+ */
+typedef enum {
+    COLOR_LIMITED_RANGE, /**< Y from 16 to 235, U and V from 16 to 240 (video, most cameras). */
+    COLOR_FULL_RANGE     /**< Y, U and V from 0 to 255 (JPEG/JFIF). */
+} ColorRange_t;
+
+
+/**
+ * @brief A YUV color space: a standard, a range, and the matrices (and their precomputed tables) to convert from and
+ * to RGB.
+ *
+ * Images point to their color space through their `colorspace` field, and any number of images may share one. The
+ * contribution tables take about 18 KB, so color spaces are best declared as static variables (or allocated) and
+ * initialized once, rather than put on the stack. They are only read by conversions, which can therefore run on
+ * several threads at once.
+ */
+struct Colorspace {
+    /** The YUV standard. */
+    ColorStandard_t standard;
+    /** The range of the YUV values. */
+    ColorRange_t range;
+    /** The YUV -> RGB matrix (pointing to `yuv_to_rgb_terms`). */
+    ColorMatrix_t yuv_to_rgb;
+    /** The RGB -> YUV matrix (pointing to `rgb_to_yuv_terms`). */
+    ColorMatrix_t rgb_to_yuv;
+    /** The contributions of every Y, U and V value to R, G and B (see `init_color_terms()`). */
+    int32_t yuv_to_rgb_terms[3][3][256];
+    /** The contributions of every R, G and B value to Y, U and V (see `init_color_terms()`). */
+    int32_t rgb_to_yuv_terms[3][3][256];
+};
+
+
+/**
+ * @brief      Initialize a color space, and precompute its tables.
+ *
+ * Setting the `colorspace` field of an image to NULL is equivalent to pointing it to a BT.601 limited-range color
+ * space; results are bit-identical either way.
+ *
+ * @param      colorspace  The color space to initialize.
+ * @param[in]  standard    The YUV standard.
+ * @param[in]  range       The range of the YUV values.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t init_colorspace (Colorspace_t * colorspace, ColorStandard_t standard, ColorRange_t range);
+
+/**
+ * @brief      Get the YUV -> RGB matrix of a color space.
+ *
+ * @param[in]  colorspace  The color space, or NULL for BT.601 limited range.
+ *
+ * @return     The YUV -> RGB matrix.
+ */
+const ColorMatrix_t * get_yuv_to_rgb_matrix (const Colorspace_t * colorspace);
+
+/**
+ * @brief      Get the RGB -> YUV matrix of a color space.
+ *
+ * @param[in]  colorspace  The color space, or NULL for BT.601 limited range.
+ *
+ * @return     The RGB -> YUV matrix.
+ */
+const ColorMatrix_t * get_rgb_to_yuv_matrix (const Colorspace_t * colorspace);
+
+
+#endif
@@ -1,4 +1,13 @@
 #include "libuimg_conversions.h"
+#include "libuimg_flips.h"
+
+
+// Conversions going through an intermediate format (see `convert_via_format()`)
+static uint8_t convert_via_YUV420p (Image_t * base_img, Image_t * converted_img);
+static uint8_t convert_via_YUV444p (Image_t * base_img, Image_t * converted_img);
+static uint8_t convert_via_RGB24 (Image_t * base_img, Image_t * converted_img);
+// Conversion between two RGB formats with 8-bit channels (see `get_rgb_layout()`)
+static uint8_t convert_rgb_layout (Image_t * base_img, Image_t * converted_img);
 
 
 /**
@@ -10,6 +19,11 @@
  * 
  * The only particularity of this LUT is that it is not square; this is because the ASCII format should be used only
  * for debugging, and thus it is useless to convert something back from ASCII to some other format.
+ *
+ * Only the most common pairs involving NV12, NV21, YUYV and UYVY have their own conversion function; the others go
+ * through YUV420p (for NV12 and NV21) or YUV444p (for YUYV and UYVY). Likewise, BGR24, RGBA8888, BGRA8888 and XRGB8888
+ * only have their own conversion functions from and to YUV420p and the other RGB formats, and go through RGB24
+ * otherwise.
  */
 uint8_t (* conversion_function_LUT[ASCII][ASCII + 1]) (Image_t * img1, Image_t * img2) = {
     {
@@ -20,6 +34,14 @@ uint8_t (* conversion_function_LUT[ASCII][ASCII + 1]) (Image_t * img1, Image_t *
         convert_YUV444_to_RGB565,
         convert_YUV444_to_RGB8,
         convert_YUV444_to_GRAYSCALE,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
         convert_YUV444_to_ASCII
     },
     {
@@ -30,6 +52,14 @@ uint8_t (* conversion_function_LUT[ASCII][ASCII + 1]) (Image_t * img1, Image_t *
         convert_YUV444p_to_RGB565,
         convert_YUV444p_to_RGB8,
         convert_YUV444p_to_GRAYSCALE,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_YUV444p_to_YUYV,
+        convert_YUV444p_to_UYVY,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
         convert_YUV444p_to_ASCII
     },
     {
@@ -40,6 +70,14 @@ uint8_t (* conversion_function_LUT[ASCII][ASCII + 1]) (Image_t * img1, Image_t *
         convert_YUV420p_to_RGB565,
         convert_YUV420p_to_RGB8,
         convert_YUV420p_to_GRAYSCALE,
+        convert_YUV420p_to_NV12,
+        convert_YUV420p_to_NV21,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_YUV420p_to_BGR24,
+        convert_YUV420p_to_RGBA8888,
+        convert_YUV420p_to_BGRA8888,
+        convert_YUV420p_to_XRGB8888,
         convert_YUV420p_to_ASCII
     },
     {
@@ -50,6 +88,14 @@ uint8_t (* conversion_function_LUT[ASCII][ASCII + 1]) (Image_t * img1, Image_t *
         convert_RGB24_to_RGB565,
         convert_RGB24_to_RGB8,
         convert_RGB24_to_GRAYSCALE,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_RGB24_to_BGR24,
+        convert_RGB24_to_RGBA8888,
+        convert_RGB24_to_BGRA8888,
+        convert_RGB24_to_XRGB8888,
         convert_RGB24_to_ASCII
     },
     {
@@ -60,6 +106,14 @@ uint8_t (* conversion_function_LUT[ASCII][ASCII + 1]) (Image_t * img1, Image_t *
         NULL,
         convert_RGB565_to_RGB8,
         convert_RGB565_to_GRAYSCALE,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
         convert_RGB565_to_ASCII
     },
     {
@@ -70,6 +124,14 @@ uint8_t (* conversion_function_LUT[ASCII][ASCII + 1]) (Image_t * img1, Image_t *
         convert_RGB8_to_RGB565,
         NULL,
         convert_RGB8_to_GRAYSCALE,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
         convert_RGB8_to_ASCII
     },
     {
@@ -80,7 +142,159 @@ uint8_t (* conversion_function_LUT[ASCII][ASCII + 1]) (Image_t * img1, Image_t *
         convert_GRAYSCALE_to_RGB565,
         convert_GRAYSCALE_to_RGB8,
         NULL,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
         convert_GRAYSCALE_to_ASCII
+    },
+    {
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_NV12_to_YUV420p,
+        convert_NV12_to_RGB24,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        NULL,
+        convert_NV12_to_NV21,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p
+    },
+    {
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_NV21_to_YUV420p,
+        convert_NV21_to_RGB24,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_NV21_to_NV12,
+        NULL,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_YUV420p
+    },
+    {
+        convert_via_YUV444p,
+        convert_YUYV_to_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_YUYV_to_RGB565,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        NULL,
+        convert_YUYV_to_UYVY,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p
+    },
+    {
+        convert_via_YUV444p,
+        convert_UYVY_to_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_UYVY_to_RGB565,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_UYVY_to_YUYV,
+        NULL,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p,
+        convert_via_YUV444p
+    },
+    {
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_BGR24_to_YUV420p,
+        convert_BGR24_to_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        NULL,
+        convert_rgb_layout,
+        convert_rgb_layout,
+        convert_rgb_layout,
+        convert_via_RGB24
+    },
+    {
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_RGBA8888_to_YUV420p,
+        convert_RGBA8888_to_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_rgb_layout,
+        NULL,
+        convert_rgb_layout,
+        convert_rgb_layout,
+        convert_via_RGB24
+    },
+    {
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_BGRA8888_to_YUV420p,
+        convert_BGRA8888_to_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_rgb_layout,
+        convert_rgb_layout,
+        NULL,
+        convert_rgb_layout,
+        convert_via_RGB24
+    },
+    {
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_XRGB8888_to_YUV420p,
+        convert_XRGB8888_to_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_via_YUV420p,
+        convert_via_YUV420p,
+        convert_via_RGB24,
+        convert_via_RGB24,
+        convert_rgb_layout,
+        convert_rgb_layout,
+        convert_rgb_layout,
+        NULL,
+        convert_via_RGB24
     }
 };
 
@@ -101,6 +315,495 @@ uint8_t convert_image (Image_t * base_img, Image_t * converted_img)
 }
 
 
+uint8_t convert_and_flip_image (Image_t * base_img, Image_t * converted_img, uint8_t flip_flags)
+{
+    uint16_t row = 0;
+    uint16_t rows = 0;
+    Image_t target;
+    Image_t base_view;
+    Image_t target_view;
+
+    // Check image pointers
+    if (!base_img) return 0;
+    if (!converted_img) return 0;
+    // Verify that both images have the same dimensions
+    if (base_img->width != converted_img->width || base_img->height != converted_img->height) return 0;
+    // Check flags
+    if (flip_flags & ~(FLIP_X_AXIS | FLIP_Y_AXIS)) return 0;
+    // Nothing is converted if the format does not change, so the converted image is simply flipped
+    if (base_img->format == converted_img->format) {
+        if ((flip_flags & FLIP_X_AXIS) && !flipX_image(converted_img)) return 0;
+        if ((flip_flags & FLIP_Y_AXIS) && !flipY_image(converted_img)) return 0;
+        return 1;
+    }
+    // Conversions from ASCII are forbidden
+    if (base_img->format == ASCII) return 0;
+
+    // Writing to a view with reversed rows flips the converted image along the X axis
+    if (flip_flags & FLIP_X_AXIS) {
+        if (!create_reversed_image_view(converted_img, &target)) return 0;
+    } else {
+        target = *converted_img;
+    }
+
+    if (!(flip_flags & FLIP_Y_AXIS)) return convert_image(base_img, &target);
+
+    // Pairs of rows, so that YUV420p chroma rows are never split
+    for (row = 0; row < base_img->height; row += rows) {
+        rows = (base_img->height - row < 2) ? base_img->height - row : 2;
+
+        if (!create_image_view(base_img, 0, row, base_img->width, rows, &base_view)) return 0;
+        if (!create_image_view(&target, 0, row, base_img->width, rows, &target_view)) return 0;
+        if (!convert_image(&base_view, &target_view)) return 0;
+        if (!flipY_image(&target_view)) return 0;
+    }
+
+    return 1;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * QUANTIZATION LOOK-UP TABLES
+ * --------------------------------------------------------------------------------------------------------------------
+ *
+ * These tables hold the results of `rescale_color()` for every possible input value, so that packing conversions do
+ * not need any floating point math. They were generated by running `rescale_color()` itself, and must be kept in sync
+ * with it.
+ */
+
+/** Equivalent to `rescale_color(value, 0, 255, 0, 32)`. */
+const uint8_t rescale_8bit_to_5bit_LUT[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  1,  1,  1,  1,  1,  1,  1,  1,
+     2,  2,  2,  2,  2,  2,  2,  2,  3,  3,  3,  3,  3,  3,  3,  3,
+     4,  4,  4,  4,  4,  4,  4,  4,  5,  5,  5,  5,  5,  5,  5,  5,
+     6,  6,  6,  6,  6,  6,  6,  6,  7,  7,  7,  7,  7,  7,  7,  7,
+     8,  8,  8,  8,  8,  8,  8,  8,  9,  9,  9,  9,  9,  9,  9,  9,
+    10, 10, 10, 10, 10, 10, 10, 10, 11, 11, 11, 11, 11, 11, 11, 11,
+    12, 12, 12, 12, 12, 12, 12, 12, 13, 13, 13, 13, 13, 13, 13, 13,
+    14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15, 15, 15,
+    16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17,
+    18, 18, 18, 18, 18, 18, 18, 18, 19, 19, 19, 19, 19, 19, 19, 19,
+    20, 20, 20, 20, 20, 20, 20, 20, 21, 21, 21, 21, 21, 21, 21, 21,
+    22, 22, 22, 22, 22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23,
+    24, 24, 24, 24, 24, 24, 24, 24, 25, 25, 25, 25, 25, 25, 25, 25,
+    26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27,
+    28, 28, 28, 28, 28, 28, 28, 28, 29, 29, 29, 29, 29, 29, 29, 29,
+    30, 30, 30, 30, 30, 30, 30, 30, 31, 31, 31, 31, 31, 31, 31, 32
+};
+
+/** Equivalent to `rescale_color(value, 0, 255, 0, 64)`. */
+const uint8_t rescale_8bit_to_6bit_LUT[256] = {
+     0,  0,  0,  0,  1,  1,  1,  1,  2,  2,  2,  2,  3,  3,  3,  3,
+     4,  4,  4,  4,  5,  5,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7,
+     8,  8,  8,  8,  9,  9,  9,  9, 10, 10, 10, 10, 11, 11, 11, 11,
+    12, 12, 12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15,
+    16, 16, 16, 16, 17, 17, 17, 17, 18, 18, 18, 18, 19, 19, 19, 19,
+    20, 20, 20, 20, 21, 21, 21, 21, 22, 22, 22, 22, 23, 23, 23, 23,
+    24, 24, 24, 24, 25, 25, 25, 25, 26, 26, 26, 26, 27, 27, 27, 27,
+    28, 28, 28, 28, 29, 29, 29, 29, 30, 30, 30, 30, 31, 31, 31, 31,
+    32, 32, 32, 32, 33, 33, 33, 33, 34, 34, 34, 34, 35, 35, 35, 35,
+    36, 36, 36, 36, 37, 37, 37, 37, 38, 38, 38, 38, 39, 39, 39, 39,
+    40, 40, 40, 40, 41, 41, 41, 41, 42, 42, 42, 42, 43, 43, 43, 43,
+    44, 44, 44, 44, 45, 45, 45, 45, 46, 46, 46, 46, 47, 47, 47, 47,
+    48, 48, 48, 48, 49, 49, 49, 49, 50, 50, 50, 50, 51, 51, 51, 51,
+    52, 52, 52, 52, 53, 53, 53, 53, 54, 54, 54, 54, 55, 55, 55, 55,
+    56, 56, 56, 56, 57, 57, 57, 57, 58, 58, 58, 58, 59, 59, 59, 59,
+    60, 60, 60, 60, 61, 61, 61, 61, 62, 62, 62, 62, 63, 63, 63, 64
+};
+
+/** Equivalent to `rescale_color(value, 0, 255, 0, 8)`. */
+const uint8_t rescale_8bit_to_3bit_LUT[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+     4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+     4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,  4,
+     5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,
+     5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,  5,
+     6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,
+     6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,  6,
+     7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,
+     7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  7,  8
+};
+
+/** Equivalent to `rescale_color(value, 0, 255, 0, 4)`. */
+const uint8_t rescale_8bit_to_2bit_LUT[256] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,  1,
+     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+     2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,  2,
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,
+     3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  3,  4
+};
+
+/** Equivalent to `rescale_color(value, 0, 32, 0, 8)`. */
+const uint8_t rescale_5bit_to_3bit_LUT[32] = {
+     0,  0,  0,  0,  1,  1,  1,  1,  2,  2,  2,  2,  3,  3,  3,  3,
+     4,  4,  4,  4,  5,  5,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7
+};
+
+/** Equivalent to `rescale_color(value, 0, 64, 0, 8)`. */
+const uint8_t rescale_6bit_to_3bit_LUT[64] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  1,  1,  1,  1,  1,  1,  1,  1,
+     2,  2,  2,  2,  2,  2,  2,  2,  3,  3,  3,  3,  3,  3,  3,  3,
+     4,  4,  4,  4,  4,  4,  4,  4,  5,  5,  5,  5,  5,  5,  5,  5,
+     6,  6,  6,  6,  6,  6,  6,  6,  7,  7,  7,  7,  7,  7,  7,  7
+};
+
+/** Equivalent to `rescale_color(value, 0, 32, 0, 4)`. */
+const uint8_t rescale_5bit_to_2bit_LUT[32] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  1,  1,  1,  1,  1,  1,  1,  1,
+     2,  2,  2,  2,  2,  2,  2,  2,  3,  3,  3,  3,  3,  3,  3,  3
+};
+
+/** Equivalent to `y_to_ascii(value)`. */
+const uint8_t y_to_ascii_LUT[256] = {
+    ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ',
+    ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', '.', '.', '.', '.', '.', '.', '.', '.',
+    '.', '.', '.', '.', '.', '.', '.', '.', '.', '.', '.', '.', '.', '.', '.', ',',
+    ',', ',', ',', ',', ',', ',', ',', ',', ',', ',', ',', ',', ',', ',', ',', ',',
+    ',', ',', ',', ',', ',', ',', '-', '-', '-', '-', '-', '-', '-', '-', '-', '-',
+    '-', '-', '-', '-', '-', '-', '-', '-', '-', '-', '-', '-', '-', '+', '+', '+',
+    '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+', '+',
+    '+', '+', '+', '+', ':', ':', ':', ':', ':', ':', ':', ':', ':', ':', ':', ':',
+    ':', ':', ':', ':', ':', ':', ':', ':', ':', ':', ':', ':', '/', '/', '/', '/',
+    '/', '/', '/', '/', '/', '/', '/', '/', '/', '/', '/', '/', '/', '/', '/', '/',
+    '/', '/', '/', '=', '=', '=', '=', '=', '=', '=', '=', '=', '=', '=', '=', '=',
+    '=', '=', '=', '=', '=', '=', '=', '=', '=', '=', '$', '$', '$', '$', '$', '$',
+    '$', '$', '$', '$', '$', '$', '$', '$', '$', '$', '$', '$', '$', '$', '$', '$',
+    '$', '%', '%', '%', '%', '%', '%', '%', '%', '%', '%', '%', '%', '%', '%', '%',
+    '%', '%', '%', '%', '%', '%', '%', '%', '#', '#', '#', '#', '#', '#', '#', '#',
+    '#', '#', '#', '#', '#', '#', '#', '#', '#', '#', '#', '#', '#', '#', '#', '@'
+};
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * BLOCK HELPER FUNCTIONS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Number of pixels to convert in the next block, given the number of pixels remaining in the row
+#define BLOCK_COUNT(remaining) ((remaining) < SIMD_BLOCK_SIZE ? (remaining) : SIMD_BLOCK_SIZE)
+
+
+// Used in place of the U and V components of GRAYSCALE images
+static const uint8_t zero_block[SIMD_BLOCK_SIZE] = { 0 };
+
+
+static void upsample_chroma_block (const uint8_t * src_row, uint8_t * dst, uint32_t column, uint32_t count)
+{
+    uint32_t i = 0;
+
+    // Each U (or V) value covers two horizontally adjacent pixels
+    for (i = 0; i < count; i++) {
+        dst[i] = src_row[(column + i) / 2];
+    }
+}
+
+
+static void subsample_chroma_block (const uint8_t * src, uint8_t * dst_row, uint32_t column, uint32_t count)
+{
+    uint32_t i = 0;
+
+    // The last pixel of each pair determines the U (or V) value
+    for (i = 0; i < count; i++) {
+        dst_row[(column + i) / 2] = src[i];
+    }
+}
+
+
+// Number of rows of a pair whose U and V values are needed to downsample them into a YUV420p image
+static inline uint8_t get_chroma_row_count (const Image_t * img_yuv420p, uint8_t row_count)
+{
+    return (img_yuv420p->chroma_siting == CHROMA_SITING_TOP_LEFT) ? 1 : row_count;
+}
+
+
+// Downsample the U and V values of a block of one or two rows (see `get_chroma_row_count()`) into the chroma rows of a
+// YUV420p image, according to its chroma siting
+static void downsample_chroma_blocks (uint8_t chroma_blocks[2][2][SIMD_BLOCK_SIZE],
+                                      uint8_t chroma_rows,
+                                      Image_t * img_yuv420p,
+                                      uint32_t row,
+                                      uint32_t column,
+                                      uint32_t count)
+{
+    uint8_t c = 0;
+
+    for (c = 0; c < 2; c++) {
+        downsample_chroma_block(chroma_blocks[0][c],
+                                (chroma_rows > 1) ? chroma_blocks[1][c] : NULL,
+                                get_image_row(img_yuv420p, c + 1, row / 2) + column / 2,
+                                count,
+                                img_yuv420p->chroma_siting);
+    }
+}
+
+
+static void pack_RGB565_block (const uint8_t * r, const uint8_t * g, const uint8_t * b, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t r_value = 0;
+    uint8_t g_value = 0;
+    uint8_t b_value = 0;
+
+    for (i = 0; i < count; i++) {
+        r_value = rescale_8bit_to_5bit_LUT[r[i]];
+        g_value = rescale_8bit_to_6bit_LUT[g[i]];
+        b_value = rescale_8bit_to_5bit_LUT[b[i]];
+
+        dst[i * 2] = (b_value & 0x1f) | ((g_value & 0x07) << 5);
+        dst[i * 2 + 1] = ((g_value & 0x38) >> 3) | ((r_value & 0x1f) << 3);
+    }
+}
+
+
+static void pack_RGB8_block (const uint8_t * r, const uint8_t * g, const uint8_t * b, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t r_value = 0;
+    uint8_t g_value = 0;
+    uint8_t b_value = 0;
+
+    for (i = 0; i < count; i++) {
+        r_value = rescale_8bit_to_3bit_LUT[r[i]];
+        g_value = rescale_8bit_to_3bit_LUT[g[i]];
+        b_value = rescale_8bit_to_2bit_LUT[b[i]];
+
+        dst[i] = (b_value & 0x03) | ((g_value & 0x07) << 2) | ((r_value & 0x07) << 5);
+    }
+}
+
+
+static void unpack_RGB565_block (const uint8_t * src, uint8_t * r, uint8_t * g, uint8_t * b, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        b[i] = src[i * 2] & 0x1f;
+        g[i] = ((src[i * 2] & 0xe0) >> 5) | ((src[i * 2 + 1] & 0x07) << 3);
+        r[i] = (src[i * 2 + 1] & 0xf8) >> 3;
+    }
+}
+
+
+static void unpack_RGB8_block (const uint8_t * src, uint8_t * r, uint8_t * g, uint8_t * b, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        b[i] = src[i] & 0x03;
+        g[i] = (src[i] >> 2) & 0x07;
+        r[i] = (src[i] >> 5) & 0x07;
+    }
+}
+
+
+static void y_to_ascii_block (const uint8_t * y, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        dst[i] = y_to_ascii(y[i]);
+    }
+}
+
+
+// Split a block of YUYV (luma first) or UYVY (chroma first) pixels; `y` must have room for a whole last macropixel
+static void unpack_422_block (const uint8_t * src,
+                              uint8_t luma_first,
+                              uint8_t * y,
+                              uint8_t * u,
+                              uint8_t * v,
+                              uint32_t count)
+{
+    uint32_t padded_count = count + (count & 1);
+    uint8_t chroma_block[SIMD_BLOCK_SIZE] = { 0 };
+
+    // Every pixel holds its Y value and, in turn, the U or V value of its macropixel
+    if (luma_first) deinterleave_16bpp_block(src, y, chroma_block, padded_count);
+    else deinterleave_16bpp_block(src, chroma_block, y, padded_count);
+
+    deinterleave_16bpp_block(chroma_block, u, v, padded_count / 2);
+}
+
+
+// Merge a block of pixels into YUYV (luma first) or UYVY (chroma first) pixels; `y` must hold a whole last macropixel
+static void pack_422_block (const uint8_t * y,
+                            const uint8_t * u,
+                            const uint8_t * v,
+                            uint8_t luma_first,
+                            uint8_t * dst,
+                            uint32_t count)
+{
+    uint32_t padded_count = count + (count & 1);
+    uint8_t chroma_block[SIMD_BLOCK_SIZE] = { 0 };
+
+    interleave_16bpp_block(u, v, chroma_block, padded_count / 2);
+
+    if (luma_first) interleave_16bpp_block(y, chroma_block, dst, padded_count);
+    else interleave_16bpp_block(chroma_block, y, dst, padded_count);
+}
+
+
+// Swap the two bytes of every pair (U and V in NV12 / NV21 chroma rows, Y and U or V in YUYV / UYVY rows)
+static void swap_byte_pairs (const uint8_t * src, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t temp_data = 0;
+
+    // The source and destination may be the same row
+    for (i = 0; i < count; i++) {
+        temp_data = src[i * 2];
+        dst[i * 2] = src[i * 2 + 1];
+        dst[i * 2 + 1] = temp_data;
+    }
+}
+
+
+/**
+ * @brief The layout of the pixels of an RGB format with 8-bit channels, given as the offsets of the channels.
+ */
+typedef struct {
+    /** The size of a pixel (in bytes). */
+    uint8_t pixel_size;
+    /** The offset of the R value. */
+    uint8_t r;
+    /** The offset of the G value. */
+    uint8_t g;
+    /** The offset of the B value. */
+    uint8_t b;
+    /** The offset of the fourth byte of 32-bit pixels. */
+    uint8_t a;
+    /** 1 if the fourth byte is an alpha value, 0 if it is unused (or if there is none). */
+    uint8_t has_alpha;
+} RgbLayout_t;
+
+
+// Get the layout of RGB24, BGR24 and 32-bit pixels (NULL for other formats)
+static const RgbLayout_t * get_rgb_layout (PixelFormat_t format)
+{
+    static const RgbLayout_t rgb24_layout = { 3, 0, 1, 2, 3, 0 };
+    static const RgbLayout_t bgr24_layout = { 3, 2, 1, 0, 3, 0 };
+    // 32-bit formats are little-endian words, so the least significant channel comes first in memory
+    static const RgbLayout_t rgba8888_layout = { 4, 3, 2, 1, 0, 1 };
+    static const RgbLayout_t bgra8888_layout = { 4, 1, 2, 3, 0, 1 };
+    static const RgbLayout_t xrgb8888_layout = { 4, 2, 1, 0, 3, 0 };
+
+    switch (format) {
+        case RGB24:
+            return &rgb24_layout;
+
+        case BGR24:
+            return &bgr24_layout;
+
+        case RGBA8888:
+            return &rgba8888_layout;
+
+        case BGRA8888:
+            return &bgra8888_layout;
+
+        case XRGB8888:
+            return &xrgb8888_layout;
+
+        default:
+            return NULL;
+    }
+}
+
+
+// Split a block of pixels of an RGB format; `a` receives the fourth byte of 32-bit pixels (and is unused otherwise)
+static void unpack_rgb_block (const uint8_t * src,
+                              const RgbLayout_t * layout,
+                              uint8_t * r,
+                              uint8_t * g,
+                              uint8_t * b,
+                              uint8_t * a,
+                              uint32_t count)
+{
+    uint8_t * channels[4] = { NULL };
+
+    // Channels are (de)interleaved in memory order, then handed out according to the layout
+    channels[layout->r] = r;
+    channels[layout->g] = g;
+    channels[layout->b] = b;
+    channels[layout->a] = a;
+
+    if (layout->pixel_size == 3) deinterleave_24bpp_block(src, channels[0], channels[1], channels[2], count);
+    else deinterleave_32bpp_block(src, channels[0], channels[1], channels[2], channels[3], count);
+}
+
+
+// Merge a block of pixels into an RGB format; `a` gives the fourth byte of 32-bit pixels (and is unused otherwise)
+static void pack_rgb_block (const uint8_t * r,
+                            const uint8_t * g,
+                            const uint8_t * b,
+                            const uint8_t * a,
+                            const RgbLayout_t * layout,
+                            uint8_t * dst,
+                            uint32_t count)
+{
+    const uint8_t * channels[4] = { NULL };
+
+    channels[layout->r] = r;
+    channels[layout->g] = g;
+    channels[layout->b] = b;
+    channels[layout->a] = a;
+
+    if (layout->pixel_size == 3) interleave_24bpp_block(channels[0], channels[1], channels[2], dst, count);
+    else interleave_32bpp_block(channels[0], channels[1], channels[2], channels[3], dst, count);
+}
+
+
+static uint8_t convert_YUV420p_to_RGB565_rows (Image_t * img_yuv420p, Image_t * img_rgb565, uint8_t swap_bytes)
+{
+    uint32_t i = 0;
+    uint16_t height = 0;
+    uint8_t last_row = 0;
+
+    if (!img_yuv420p) return 0;
+    if (img_yuv420p->format != YUV420p) return 0;
+    if (!img_rgb565) return 0;
+    if (img_rgb565->format != RGB565) return 0;
+    if (img_yuv420p->width != img_rgb565->width || img_yuv420p->height != img_rgb565->height) return 0;
+
+    height = img_yuv420p->height;
+
+    // Both rows sharing the same U, V rows are converted together, so that the chroma contributions are computed once
+    // for every 2x2 block of pixels, and the pixels are packed right away (no intermediate R, G, B blocks)
+    for (i = 0; i < height; i += 2) {
+        last_row = (i + 1 == height);
+
+        convert_YUV420p_to_RGB565_block(get_yuv_to_rgb_matrix(img_yuv420p->colorspace),
+                                        get_image_row(img_yuv420p, 0, i),
+                                        last_row ? NULL : get_image_row(img_yuv420p, 0, i + 1),
+                                        get_image_row(img_yuv420p, 1, i / 2),
+                                        get_image_row(img_yuv420p, 2, i / 2),
+                                        get_image_row(img_rgb565, 0, i),
+                                        last_row ? NULL : get_image_row(img_rgb565, 0, i + 1),
+                                        img_yuv420p->width,
+                                        swap_bytes);
+    }
+
+    return 1;
+}
+
+
 /* --------------------------------------------------------------------------------------------------------------------
  * LOW-LEVEL CONVERSION FUNCTIONS
  * --------------------------------------------------------------------------------------------------------------------
@@ -111,6 +814,10 @@ uint8_t convert_YUV444_to_YUV444p (Image_t * img_yuv444, Image_t * img_yuv444p)
     uint32_t i = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
 
     if (!img_yuv444) return 0;
     if (img_yuv444->format != YUV444) return 0;
@@ -125,13 +832,15 @@ uint8_t convert_YUV444_to_YUV444p (Image_t * img_yuv444, Image_t * img_yuv444p)
     // Base image: YUV YUV YUV YUV
     // New image: YYYY UUUU VVVV
 
-    for (i = 0; i < width * height; i++) {
-        // Copy Y component
-        img_yuv444p->data[i] = img_yuv444->data[i * 3];
-        // Copy U component
-        img_yuv444p->data[i + width * height] = img_yuv444->data[i * 3 + 1];
-        // Copy V component
-        img_yuv444p->data[i + width * height * 2] = img_yuv444->data[i * 3 + 2];
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_yuv444, 0, i);
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+
+        // Separate Y, U and V components
+        deinterleave_24bpp_block(base_row, y_row, u_row, v_row, width);
     }
 
     return 1;
@@ -142,10 +851,14 @@ uint8_t convert_YUV444_to_YUV420p (Image_t * img_yuv444, Image_t * img_yuv420p)
 {
     uint32_t i = 0;
     uint32_t j = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t k = 0;
+    uint8_t row_count = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * y_row = NULL;
+    uint8_t chroma_blocks[2][2][SIMD_BLOCK_SIZE] = { { { 0 } } };
 
     if (!img_yuv444) return 0;
     if (img_yuv444->format != YUV444) return 0;
@@ -159,20 +872,25 @@ uint8_t convert_YUV444_to_YUV420p (Image_t * img_yuv444, Image_t * img_yuv420p)
     // In YUV420p, 4 Y values share a single U and V value
     // Base image: YUV YUV YUV YUV
     // New image: YYYY U V
-    
-    u_offset = width * height;
-    v_offset = u_offset + UROUND_UP(width / 2) * UROUND_UP(height / 2);
+    // Pairs of rows are processed in blocks, so that the U and V values of every 2x2 block are downsampled at once
 
-    for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // Copy Y data
-            img_yuv420p->data[i * width + j] = img_yuv444->data[i * 3 * width + j * 3];
-            // Copy U data
-            img_yuv420p->data[u_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = img_yuv444->data[i * 3 * width +
-                                                                                                      j * 3 + 1];
-            // Copy V data
-            img_yuv420p->data[v_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = img_yuv444->data[i * 3 * width +
-                                                                                                      j * 3 + 2];
+    for (i = 0; i < height; i += 2) {
+        row_count = (height - i < 2) ? 1 : 2;
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            for (k = 0; k < row_count; k++) {
+                base_row = get_image_row(img_yuv444, 0, i + k);
+                y_row = get_image_row(img_yuv420p, 0, i + k);
+
+                // Copy Y data, and separate U and V data
+                deinterleave_24bpp_block(&base_row[j * 3], &y_row[j], chroma_blocks[k][0], chroma_blocks[k][1], count);
+            }
+
+            // Four Y values share one U and one V value
+            downsample_chroma_blocks(chroma_blocks, get_chroma_row_count(img_yuv420p, row_count), img_yuv420p, i, j,
+                                     count);
         }
     }
 
@@ -183,8 +901,14 @@ uint8_t convert_YUV444_to_YUV420p (Image_t * img_yuv444, Image_t * img_yuv420p)
 uint8_t convert_YUV444_to_RGB24 (Image_t * img_yuv444, Image_t * img_rgb24)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_yuv444) return 0;
     if (img_yuv444->format != YUV444) return 0;
@@ -198,20 +922,23 @@ uint8_t convert_YUV444_to_RGB24 (Image_t * img_yuv444, Image_t * img_rgb24)
     // In RGB24, each pixel has one R, one G and one B value
     // Base image: YUV YUV YUV YUV
     // New image: RGB RGB RGB RGB
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
-    for (i = 0; i < width * height * 3; i += 3) {
-        // Copy Y -> R component
-        img_rgb24->data[i] = yuv_to_rgb_r(img_yuv444->data[i],
-                                          img_yuv444->data[i + 1],
-                                          img_yuv444->data[i + 2]);
-        // Copy U -> G component
-        img_rgb24->data[i + 1] = yuv_to_rgb_g(img_yuv444->data[i],
-                                              img_yuv444->data[i + 1],
-                                              img_yuv444->data[i + 2]);
-        // Copy V -> B component
-        img_rgb24->data[i + 2] = yuv_to_rgb_b(img_yuv444->data[i],
-                                              img_yuv444->data[i + 1],
-                                              img_yuv444->data[i + 2]);
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_yuv444, 0, i);
+        conv_row = get_image_row(img_rgb24, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Separate Y, U and V components
+            deinterleave_24bpp_block(&base_row[j * 3], yuv_block[0], yuv_block[1], yuv_block[2], count);
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_yuv444->colorspace), yuv_block[0], yuv_block[1], yuv_block[2],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Put R, G and B components together in new image
+            interleave_24bpp_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j * 3], count);
+        }
     }
 
     return 1;
@@ -221,11 +948,14 @@ uint8_t convert_YUV444_to_RGB24 (Image_t * img_yuv444, Image_t * img_rgb24)
 uint8_t convert_YUV444_to_RGB565 (Image_t * img_yuv444, Image_t * img_rgb565)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_yuv444) return 0;
     if (img_yuv444->format != YUV444) return 0;
@@ -237,30 +967,24 @@ uint8_t convert_YUV444_to_RGB565 (Image_t * img_yuv444, Image_t * img_rgb565)
     height = img_yuv444->height;
 
     // In RGB565, R is encoded on 5 bits, G on 6 and B on 5, so we have 16 bits per pixel
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Convert values
-        r_value = yuv_to_rgb_r(img_yuv444->data[i * 3],
-                               img_yuv444->data[i * 3 + 1],
-                               img_yuv444->data[i * 3 + 2]);
-
-        g_value = yuv_to_rgb_g(img_yuv444->data[i * 3],
-                               img_yuv444->data[i * 3 + 1],
-                               img_yuv444->data[i * 3 + 2]);
-
-        b_value = yuv_to_rgb_b(img_yuv444->data[i * 3],
-                               img_yuv444->data[i * 3 + 1],
-                               img_yuv444->data[i * 3 + 2]);
-
-        // Rescale values
-        r_value = rescale_color(r_value, 0, 255, 0, 32);
-        g_value = rescale_color(g_value, 0, 255, 0, 64);
-        b_value = rescale_color(b_value, 0, 255, 0, 32);
-
-        // Put values together in new image
-        // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
-        img_rgb565->data[i * 2] = (b_value & 0x1f) | ((g_value & 0x07) << 5);
-        img_rgb565->data[i * 2 + 1] = ((g_value & 0x38) >> 3) | ((r_value & 0x1f) << 3);
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_yuv444, 0, i);
+        conv_row = get_image_row(img_rgb565, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Separate Y, U and V components
+            deinterleave_24bpp_block(&base_row[j * 3], yuv_block[0], yuv_block[1], yuv_block[2], count);
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_yuv444->colorspace), yuv_block[0], yuv_block[1], yuv_block[2],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Rescale values and put them together in new image
+            // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
+            pack_RGB565_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j * 2], count);
+        }
     }
 
     return 1;
@@ -270,11 +994,14 @@ uint8_t convert_YUV444_to_RGB565 (Image_t * img_yuv444, Image_t * img_rgb565)
 uint8_t convert_YUV444_to_RGB8 (Image_t * img_yuv444, Image_t * img_rgb8)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_yuv444) return 0;
     if (img_yuv444->format != YUV444) return 0;
@@ -286,29 +1013,24 @@ uint8_t convert_YUV444_to_RGB8 (Image_t * img_yuv444, Image_t * img_rgb8)
     height = img_yuv444->height;
 
     // In RGB8, R is encoded on 3 bits, G on 3 and B on 2, so we have 8 bits per pixel
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Convert values
-        r_value = yuv_to_rgb_r(img_yuv444->data[i * 3],
-                               img_yuv444->data[i * 3 + 1],
-                               img_yuv444->data[i * 3 + 2]);
-
-        g_value = yuv_to_rgb_g(img_yuv444->data[i * 3],
-                               img_yuv444->data[i * 3 + 1],
-                               img_yuv444->data[i * 3 + 2]);
-
-        b_value = yuv_to_rgb_b(img_yuv444->data[i * 3],
-                               img_yuv444->data[i * 3 + 1],
-                               img_yuv444->data[i * 3 + 2]);
-
-        // Rescale values
-        r_value = rescale_color(r_value, 0, 255, 0, 8);
-        g_value = rescale_color(g_value, 0, 255, 0, 8);
-        b_value = rescale_color(b_value, 0, 255, 0, 4);
-
-        // Put values together in new image
-        // MSB | 3 bits of R, 3 bits of G 2 bits of B | LSB
-        img_rgb8->data[i] = (b_value & 0x07) | ((g_value & 0x07) << 2) | ((g_value & 0x03) << 5);
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_yuv444, 0, i);
+        conv_row = get_image_row(img_rgb8, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Separate Y, U and V components
+            deinterleave_24bpp_block(&base_row[j * 3], yuv_block[0], yuv_block[1], yuv_block[2], count);
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_yuv444->colorspace), yuv_block[0], yuv_block[1], yuv_block[2],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Rescale values and put them together in new image
+            // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
+            pack_RGB8_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j], count);
+        }
     }
 
     return 1;
@@ -318,8 +1040,11 @@ uint8_t convert_YUV444_to_RGB8 (Image_t * img_yuv444, Image_t * img_rgb8)
 uint8_t convert_YUV444_to_GRAYSCALE (Image_t * img_yuv444, Image_t * img_grayscale)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_yuv444) return 0;
     if (img_yuv444->format != YUV444) return 0;
@@ -334,9 +1059,15 @@ uint8_t convert_YUV444_to_GRAYSCALE (Image_t * img_yuv444, Image_t * img_graysca
     // Base image: YUV YUV YUV YUV
     // New image: Y Y Y Y
 
-    for (i = 0; i < width * height; i++) {
-        // Copy Y component
-        img_grayscale->data[i] = img_yuv444->data[i * 3];
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_yuv444, 0, i);
+        conv_row = get_image_row(img_grayscale, 0, i);
+
+        for (j = 0; j < width; j++) {
+            // Copy Y component
+            conv_row[j] = base_row[j * 3];
+        }
     }
 
     return 1;
@@ -346,8 +1077,11 @@ uint8_t convert_YUV444_to_GRAYSCALE (Image_t * img_yuv444, Image_t * img_graysca
 uint8_t convert_YUV444_to_ASCII (Image_t * img_yuv444, Image_t * img_ascii)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_yuv444) return 0;
     if (img_yuv444->format != YUV444) return 0;
@@ -362,9 +1096,15 @@ uint8_t convert_YUV444_to_ASCII (Image_t * img_yuv444, Image_t * img_ascii)
     // Base image: YUV YUV YUV YUV
     // New image: Y Y Y Y
 
-    for (i = 0; i < width * height; i++) {
-        // Copy Y component
-        img_ascii->data[i] = y_to_ascii(img_yuv444->data[i * 3]);
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_yuv444, 0, i);
+        conv_row = get_image_row(img_ascii, 0, i);
+
+        for (j = 0; j < width; j++) {
+            // Copy Y component
+            conv_row[j] = y_to_ascii(base_row[j * 3]);
+        }
     }
 
     return 1;
@@ -376,6 +1116,10 @@ uint8_t convert_YUV444p_to_YUV444 (Image_t * img_yuv444p, Image_t * img_yuv444)
     uint32_t i = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_yuv444p) return 0;
     if (img_yuv444p->format != YUV444p) return 0;
@@ -390,14 +1134,16 @@ uint8_t convert_YUV444p_to_YUV444 (Image_t * img_yuv444p, Image_t * img_yuv444)
     // Base image: YYYY UUUU VVVV
     // New image: YUV YUV YUV YUV
 
-    for (i = 0; i < width * height; i++) {
-        // Copy Y component
-        img_yuv444->data[i * 3] = img_yuv444p->data[i];
-        // Copy U component
-        img_yuv444->data[i * 3 + 1] = img_yuv444p->data[i + width * height];
-        // Copy V component
-        img_yuv444->data[i * 3 + 2] = img_yuv444p->data[i + width * height * 2];
-    }
+
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+        conv_row = get_image_row(img_yuv444, 0, i);
+
+        // Put Y, U and V components together in new image
+        interleave_24bpp_block(y_row, u_row, v_row, conv_row, width);
+    }
 
     return 1;
 }
@@ -406,11 +1152,11 @@ uint8_t convert_YUV444p_to_YUV444 (Image_t * img_yuv444p, Image_t * img_yuv444)
 uint8_t convert_YUV444p_to_YUV420p (Image_t * img_yuv444p, Image_t * img_yuv420p)
 {
     uint32_t i = 0;
-    uint32_t j = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t k = 0;
+    uint8_t row_count = 0;
+    uint8_t chroma_rows = 0;
 
     if (!img_yuv444p) return 0;
     if (img_yuv444p->format != YUV444p) return 0;
@@ -424,23 +1170,23 @@ uint8_t convert_YUV444p_to_YUV420p (Image_t * img_yuv444p, Image_t * img_yuv420p
     // In YUV420p, four Y values share one U and one V value
     // Base image: YYYY UUUU VVVV
     // New image: YYYY U V
-    
-    // Copy Y data
-    memcpy(img_yuv420p->data, img_yuv444p->data, width * height);
 
-    u_offset = width * height;
-    v_offset = u_offset + UROUND_UP(width / 2) * UROUND_UP(height / 2);
+    for (i = 0; i < height; i += 2) {
+        row_count = (height - i < 2) ? 1 : 2;
+        chroma_rows = get_chroma_row_count(img_yuv420p, row_count);
 
-    for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // Copy U data
-            img_yuv420p->data[u_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = img_yuv444p->data[u_offset + 
-                                                                                                       i * width +
-                                                                                                       j];
-            // Copy V data
-            img_yuv420p->data[v_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = img_yuv444p->data[u_offset * 2 +
-                                                                                                       i * width +
-                                                                                                       j];
+        // Copy Y data
+        for (k = 0; k < row_count; k++) {
+            memcpy(get_image_row(img_yuv420p, 0, i + k), get_image_row(img_yuv444p, 0, i + k), width);
+        }
+
+        // Downsample U and V data, a whole pair of rows at a time
+        for (k = 1; k < 3; k++) {
+            downsample_chroma_block(get_image_row(img_yuv444p, k, i),
+                                    (chroma_rows > 1) ? get_image_row(img_yuv444p, k, i + 1) : NULL,
+                                    get_image_row(img_yuv420p, k, i / 2),
+                                    width,
+                                    img_yuv420p->chroma_siting);
         }
     }
 
@@ -451,8 +1197,15 @@ uint8_t convert_YUV444p_to_YUV420p (Image_t * img_yuv444p, Image_t * img_yuv420p
 uint8_t convert_YUV444p_to_RGB24 (Image_t * img_yuv444p, Image_t * img_rgb24)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_yuv444p) return 0;
     if (img_yuv444p->format != YUV444p) return 0;
@@ -466,20 +1219,23 @@ uint8_t convert_YUV444p_to_RGB24 (Image_t * img_yuv444p, Image_t * img_rgb24)
     // In RGB24, each pixel has one R, one G and one B value
     // Base image: YYYY UUUU VVVV
     // New image: RGB RGB RGB RGB
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Copy Y -> R component
-        img_rgb24->data[i * 3] = yuv_to_rgb_r(img_yuv444p->data[i],
-                                              img_yuv444p->data[i + width * height],
-                                              img_yuv444p->data[i + width * height * 2]);
-        // Copy U -> G component
-        img_rgb24->data[i * 3 + 1] = yuv_to_rgb_g(img_yuv444p->data[i],
-                                              img_yuv444p->data[i + width * height],
-                                              img_yuv444p->data[i + width * height * 2]);
-        // Copy V -> B component
-        img_rgb24->data[i * 3 + 2] = yuv_to_rgb_b(img_yuv444p->data[i],
-                                              img_yuv444p->data[i + width * height],
-                                              img_yuv444p->data[i + width * height * 2]);
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+        conv_row = get_image_row(img_rgb24, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_yuv444p->colorspace), &y_row[j], &u_row[j], &v_row[j],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Put R, G and B components together in new image
+            interleave_24bpp_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j * 3], count);
+        }
     }
 
     return 1;
@@ -489,11 +1245,15 @@ uint8_t convert_YUV444p_to_RGB24 (Image_t * img_yuv444p, Image_t * img_rgb24)
 uint8_t convert_YUV444p_to_RGB565 (Image_t * img_yuv444p, Image_t * img_rgb565)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_yuv444p) return 0;
     if (img_yuv444p->format != YUV444p) return 0;
@@ -505,30 +1265,24 @@ uint8_t convert_YUV444p_to_RGB565 (Image_t * img_yuv444p, Image_t * img_rgb565)
     height = img_yuv444p->height;
 
     // In RGB565, R is encoded on 5 bits, G on 6 and B on 5, so we have 16 bits per pixel
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Convert values
-        r_value = yuv_to_rgb_r(img_yuv444p->data[i],
-                               img_yuv444p->data[i + width * height],
-                               img_yuv444p->data[i + width * height * 2]);
-
-        g_value = yuv_to_rgb_g(img_yuv444p->data[i],
-                               img_yuv444p->data[i + width * height],
-                               img_yuv444p->data[i + width * height * 2]);
-
-        b_value = yuv_to_rgb_b(img_yuv444p->data[i],
-                               img_yuv444p->data[i + width * height],
-                               img_yuv444p->data[i + width * height * 2]);
-
-        // Rescale values
-        r_value = rescale_color(r_value, 0, 255, 0, 32);
-        g_value = rescale_color(g_value, 0, 255, 0, 64);
-        b_value = rescale_color(b_value, 0, 255, 0, 32);
-
-        // Put values together in new image
-        // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
-        img_rgb565->data[i * 2] = (b_value & 0x1f) | ((g_value & 0x07) << 5);
-        img_rgb565->data[i * 2 + 1] = ((g_value & 0x38) >> 3) | ((r_value & 0x1f) << 3);
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+        conv_row = get_image_row(img_rgb565, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_yuv444p->colorspace), &y_row[j], &u_row[j], &v_row[j],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Rescale values and put them together in new image
+            // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
+            pack_RGB565_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j * 2], count);
+        }
     }
 
     return 1;
@@ -538,11 +1292,15 @@ uint8_t convert_YUV444p_to_RGB565 (Image_t * img_yuv444p, Image_t * img_rgb565)
 uint8_t convert_YUV444p_to_RGB8 (Image_t * img_yuv444p, Image_t * img_rgb8)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_yuv444p) return 0;
     if (img_yuv444p->format != YUV444p) return 0;
@@ -554,29 +1312,24 @@ uint8_t convert_YUV444p_to_RGB8 (Image_t * img_yuv444p, Image_t * img_rgb8)
     height = img_yuv444p->height;
 
     // In RGB8, R is encoded on 3 bits, G on 3 and B on 2, so we have 8 bits per pixel
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Convert values
-        r_value = yuv_to_rgb_r(img_yuv444p->data[i],
-                               img_yuv444p->data[i + width * height],
-                               img_yuv444p->data[i + width * height * 2]);
-
-        g_value = yuv_to_rgb_g(img_yuv444p->data[i],
-                               img_yuv444p->data[i + width * height],
-                               img_yuv444p->data[i + width * height * 2]);
-
-        b_value = yuv_to_rgb_b(img_yuv444p->data[i],
-                               img_yuv444p->data[i + width * height],
-                               img_yuv444p->data[i + width * height * 2]);
-
-        // Rescale values
-        r_value = rescale_color(r_value, 0, 255, 0, 8);
-        g_value = rescale_color(g_value, 0, 255, 0, 8);
-        b_value = rescale_color(b_value, 0, 255, 0, 4);
-
-        // Put values together in new image
-        // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
-        img_rgb8->data[i] = (b_value & 0x03) | ((g_value & 0x07) << 2) | ((r_value & 0x07) << 5);
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+        conv_row = get_image_row(img_rgb8, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_yuv444p->colorspace), &y_row[j], &u_row[j], &v_row[j],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Rescale values and put them together in new image
+            // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
+            pack_RGB8_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j], count);
+        }
     }
 
     return 1;
@@ -585,8 +1338,11 @@ uint8_t convert_YUV444p_to_RGB8 (Image_t * img_yuv444p, Image_t * img_rgb8)
 
 uint8_t convert_YUV444p_to_GRAYSCALE (Image_t * img_yuv444p, Image_t * img_grayscale)
 {
+    uint32_t i = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_y_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_yuv444p) return 0;
     if (img_yuv444p->format != YUV444p) return 0;
@@ -601,8 +1357,14 @@ uint8_t convert_YUV444p_to_GRAYSCALE (Image_t * img_yuv444p, Image_t * img_grays
     // Base image: YYYYY UUUU VVVV
     // New image: Y Y Y Y
 
-    // Copy Y component
-    memcpy(img_grayscale->data, img_yuv444p->data, width * height);
+
+    for (i = 0; i < height; i++) {
+        base_y_row = get_image_row(img_yuv444p, 0, i);
+        conv_row = get_image_row(img_grayscale, 0, i);
+
+        // Copy Y component
+        memcpy(conv_row, base_y_row, width);
+    }
 
     return 1;
 }
@@ -611,8 +1373,11 @@ uint8_t convert_YUV444p_to_GRAYSCALE (Image_t * img_yuv444p, Image_t * img_grays
 uint8_t convert_YUV444p_to_ASCII (Image_t * img_yuv444p, Image_t * img_ascii)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_y_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_yuv444p) return 0;
     if (img_yuv444p->format != YUV444p) return 0;
@@ -627,9 +1392,14 @@ uint8_t convert_YUV444p_to_ASCII (Image_t * img_yuv444p, Image_t * img_ascii)
     // Base image: YYYYY UUUU VVVV
     // New image: Y Y Y Y
 
-    // Copy Y component
-    for (i = 0; i < width * height; i++) {
-        img_ascii->data[i] = y_to_ascii(img_yuv444p->data[i]);
+
+    for (i = 0; i < height; i++) {
+        base_y_row = get_image_row(img_yuv444p, 0, i);
+        conv_row = get_image_row(img_ascii, 0, i);
+
+        for (j = 0; j < width; j++) {
+            conv_row[j] = y_to_ascii(base_y_row[j]);
+        }
     }
 
     return 1;
@@ -643,8 +1413,10 @@ uint8_t convert_YUV420p_to_YUV444 (Image_t * img_yuv420p, Image_t * img_yuv444)
     uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint32_t base_row_offset = 0;
-    uint32_t conv_row_offset = 0;
+    uint8_t * base_y_row = NULL;
+    uint8_t * base_u_row = NULL;
+    uint8_t * base_v_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_yuv420p) return 0;
     if (img_yuv420p->format != YUV420p) return 0;
@@ -659,9 +1431,9 @@ uint8_t convert_YUV420p_to_YUV444 (Image_t * img_yuv420p, Image_t * img_yuv444)
     // This necessitates upscaling, so U and V values will be quadrupled by doubling them horizontally and vertically
     // Base image: YYYY U V
     // New image: YUV YUV YUV YUV
-    // 
+    //
     // More explicitly, for a 3x3 image (to show how to handle odd dimensions):
-    // 
+    //
     // Base 3x3 YUV420p image:
     //
     //     Y0 Y1 Y2
@@ -669,11 +1441,11 @@ uint8_t convert_YUV420p_to_YUV444 (Image_t * img_yuv420p, Image_t * img_yuv444)
     //     Y6 Y7 Y8
     //     --------
     //     U0    U1
-    //     
+    //
     //     U2    U3
     //     --------
     //     V0    V1
-    //     
+    //
     //     V2    V3
     //
     //
@@ -686,28 +1458,20 @@ uint8_t convert_YUV420p_to_YUV444 (Image_t * img_yuv420p, Image_t * img_yuv444)
     //
     // In conclusion, because the dimensions are odd, U1 is shared among 2 pixels only (Y2 and Y5), U2 is shared among
     // 2 pixels only (Y6 and Y7) and U3 is used by one pixel only (Y8).
-    
-    for (i = 0; i < width * height; i++) {
-        // Copy Y component
-        img_yuv444->data[i * 3] = img_yuv420p->data[i];
-    }
+
 
     for (i = 0; i < height; i++) {
-        // On the base image, we need to skip the Y values (W x H bytes)
-        base_row_offset = width * height + (i / 2) * UROUND_UP(width / 2);
-        // On the converted image, we only want 
-        conv_row_offset = i * 3 * width;
+        base_y_row = get_image_row(img_yuv420p, 0, i);
+        base_u_row = get_image_row(img_yuv420p, 1, i / 2);
+        base_v_row = get_image_row(img_yuv420p, 2, i / 2);
+        conv_row = get_image_row(img_yuv444, 0, i);
 
         for (j = 0; j < width; j++) {
-            // U values are duplicated horizontally & vertically
-            img_yuv444->data[conv_row_offset + j * 3 + 1] = img_yuv420p->data[base_row_offset + (j / 2)];
-
-            // Increment base offset to handle V values of the current iteration
-            base_row_offset += UROUND_UP(width / 2) * UROUND_UP(height / 2);
-            // V values are duplicated horizontally & vertically
-            img_yuv444->data[i * 3 * width + j * 3 + 2] = img_yuv420p->data[base_row_offset + (j / 2)];
-            // Reset base row offset for the U values of the next iteration
-            base_row_offset -= UROUND_UP(width / 2) * UROUND_UP(height / 2);
+            // Copy Y component
+            conv_row[j * 3] = base_y_row[j];
+            // U and V values are duplicated horizontally & vertically
+            conv_row[j * 3 + 1] = base_u_row[j / 2];
+            conv_row[j * 3 + 2] = base_v_row[j / 2];
         }
     }
 
@@ -718,11 +1482,14 @@ uint8_t convert_YUV420p_to_YUV444 (Image_t * img_yuv420p, Image_t * img_yuv444)
 uint8_t convert_YUV420p_to_YUV444p (Image_t * img_yuv420p, Image_t * img_yuv444p)
 {
     uint32_t i = 0;
-    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint32_t base_offset = 0;
-    uint32_t converted_offset = 0;
+    uint8_t * base_y_row = NULL;
+    uint8_t * base_u_row = NULL;
+    uint8_t * base_v_row = NULL;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
 
     if (!img_yuv420p) return 0;
     if (img_yuv420p->format != YUV420p) return 0;
@@ -738,7 +1505,7 @@ uint8_t convert_YUV420p_to_YUV444p (Image_t * img_yuv420p, Image_t * img_yuv444p
     // Base image: YYYY U V
     // New image: YYYY UUUU VVVV
     // More explicitly, for a 3x3 image (to show how to handle odd dimensions):
-    // 
+    //
     // Base 3x3 YUV420p image:
     //
     //     Y0 Y1 Y2
@@ -746,11 +1513,11 @@ uint8_t convert_YUV420p_to_YUV444p (Image_t * img_yuv420p, Image_t * img_yuv444p
     //     Y6 Y7 Y8
     //     --------
     //     U0    U1
-    //     
+    //
     //     U2    U3
     //     --------
     //     V0    V1
-    //     
+    //
     //     V2    V3
     //
     //
@@ -771,32 +1538,23 @@ uint8_t convert_YUV420p_to_YUV444p (Image_t * img_yuv420p, Image_t * img_yuv444p
     //
     // In conclusion, because the dimensions are odd, U1 is shared among 2 pixels only (Y2 and Y5), U2 is shared among
     // 2 pixels only (Y6 and Y7) and U3 is used by one pixel only (Y8).
-    
+
     // Copy Y component
-    memcpy(img_yuv444p->data, img_yuv420p->data, width * height);
 
-    base_offset = width * height;
-    converted_offset = width * height;
 
     for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // U values are duplicated horizontally & vertically
-            img_yuv444p->data[converted_offset + i * width + j] = img_yuv420p->data[base_offset +
-                                                                                    (i / 2) * UROUND_UP(width / 2) +
-                                                                                    (j / 2)];
-        }
-    }
-
-    base_offset += UROUND_UP(width / 2) * UROUND_UP(height / 2);
-    converted_offset += width * height;
+        base_y_row = get_image_row(img_yuv420p, 0, i);
+        base_u_row = get_image_row(img_yuv420p, 1, i / 2);
+        base_v_row = get_image_row(img_yuv420p, 2, i / 2);
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
 
-    for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // V values are duplicated horizontally & vertically
-            img_yuv444p->data[converted_offset + i * width + j] = img_yuv420p->data[base_offset +
-                                                                                    (i / 2) * UROUND_UP(width / 2) +
-                                                                                    (j / 2)];
-        }
+        // Copy Y component
+        memcpy(y_row, base_y_row, width);
+        // U and V values are duplicated horizontally & vertically
+        upsample_chroma_block(base_u_row, u_row, 0, width);
+        upsample_chroma_block(base_v_row, v_row, 0, width);
     }
 
     return 1;
@@ -807,13 +1565,15 @@ uint8_t convert_YUV420p_to_RGB24 (Image_t * img_yuv420p, Image_t * img_rgb24)
 {
     uint32_t i = 0;
     uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
-    uint8_t y_value = 0;
-    uint8_t u_value = 0;
-    uint8_t v_value = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_yuv420p) return 0;
     if (img_yuv420p->format != YUV420p) return 0;
@@ -829,23 +1589,25 @@ uint8_t convert_YUV420p_to_RGB24 (Image_t * img_yuv420p, Image_t * img_rgb24)
     // Base image: YYYY U V
     // New image: RGB RGB RGB RGB
     // See `convert_YUV420p_to_YUV444()` or `convert_YUV420p_to_YUV444p()` for more info
-
-    u_offset = width * height;
-    v_offset = u_offset + UROUND_UP(width / 2) * UROUND_UP(height / 2);
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
     for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // Get values for the YUV pixel corresponding to the current RGB pixel
-            y_value = img_yuv420p->data[i * width + j];
-            u_value = img_yuv420p->data[u_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)];
-            v_value = img_yuv420p->data[v_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)];
-
-            // Copy R data
-            img_rgb24->data[i * 3 * width + j * 3] = yuv_to_rgb_r(y_value, u_value, v_value);
-            // Copy G data
-            img_rgb24->data[i * 3 * width + j * 3 + 1] = yuv_to_rgb_g(y_value, u_value, v_value);
-            // Copy B data
-            img_rgb24->data[i * 3 * width + j * 3 + 2] = yuv_to_rgb_b(y_value, u_value, v_value);
+        y_row = get_image_row(img_yuv420p, 0, i);
+        u_row = get_image_row(img_yuv420p, 1, i / 2);
+        v_row = get_image_row(img_yuv420p, 2, i / 2);
+        conv_row = get_image_row(img_rgb24, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // U and V values are duplicated horizontally (and vertically, since two rows share the same U, V rows)
+            upsample_chroma_block(u_row, yuv_block[1], j, count);
+            upsample_chroma_block(v_row, yuv_block[2], j, count);
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_yuv420p->colorspace), &y_row[j], yuv_block[1], yuv_block[2],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Put R, G and B components together in new image
+            interleave_24bpp_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j * 3], count);
         }
     }
 
@@ -855,62 +1617,18 @@ uint8_t convert_YUV420p_to_RGB24 (Image_t * img_yuv420p, Image_t * img_rgb24)
 
 uint8_t convert_YUV420p_to_RGB565 (Image_t * img_yuv420p, Image_t * img_rgb565)
 {
-    uint32_t i = 0;
-    uint32_t j = 0;
-    uint16_t width = 0;
-    uint16_t height = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
-    uint8_t y_value = 0;
-    uint8_t u_value = 0;
-    uint8_t v_value = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
-
-    if (!img_yuv420p) return 0;
-    if (img_yuv420p->format != YUV420p) return 0;
-    if (!img_rgb565) return 0;
-    if (img_rgb565->format != RGB565) return 0;
-    if (img_yuv420p->width != img_rgb565->width || img_yuv420p->height != img_rgb565->height) return 0;
-
-    width = img_yuv420p->width;
-    height = img_yuv420p->height;
-
     // In RGB565, R is encoded on 5 bits, G on 6 and B on 5, so we have 16 bits per pixel
     // This necessitates upscaling, so U and V values will be quadrupled
     // See `convert_YUV420p_to_YUV444()` or `convert_YUV420p_to_YUV444p()` for more info
+    // This is the hottest path of camera -> display pipelines, so it has its own kernel: see
+    // `convert_YUV420p_to_RGB565_rows()`
+    return convert_YUV420p_to_RGB565_rows(img_yuv420p, img_rgb565, 0);
+}
 
-    u_offset = width * height;
-    v_offset = u_offset + UROUND_UP(width / 2) * UROUND_UP(height / 2);
-
-    for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // Get values for the YUV pixel corresponding to the current RGB pixel
-            y_value = img_yuv420p->data[i * width + j];
-            u_value = img_yuv420p->data[u_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)];
-            v_value = img_yuv420p->data[v_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)];
-
-            // Calculate R data
-            r_value = yuv_to_rgb_r(y_value, u_value, v_value);
-            // Calculate G data
-            g_value = yuv_to_rgb_g(y_value, u_value, v_value);
-            // Calculate B data
-            b_value = yuv_to_rgb_b(y_value, u_value, v_value);
-
-            // Rescale values to new range
-            r_value = rescale_color(r_value, 0, 255, 0, 32);
-            g_value = rescale_color(g_value, 0, 255, 0, 64);
-            b_value = rescale_color(b_value, 0, 255, 0, 32);
-
-            // Put values together in new image
-            // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
-            img_rgb565->data[i * 2 * width + j * 2] = (b_value & 0x1f) | ((g_value & 0x07) << 5);
-            img_rgb565->data[i * 2 * width + j * 2 + 1] = ((g_value & 0x38) >> 3) | ((r_value & 0x1f) << 3);
-        }
-    }
 
-    return 1;
+uint8_t convert_YUV420p_to_RGB565_byteswapped (Image_t * img_yuv420p, Image_t * img_rgb565)
+{
+    return convert_YUV420p_to_RGB565_rows(img_yuv420p, img_rgb565, 1);
 }
 
 
@@ -918,16 +1636,15 @@ uint8_t convert_YUV420p_to_RGB8 (Image_t * img_yuv420p, Image_t * img_rgb8)
 {
     uint32_t i = 0;
     uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
-    uint8_t y_value = 0;
-    uint8_t u_value = 0;
-    uint8_t v_value = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_yuv420p) return 0;
     if (img_yuv420p->format != YUV420p) return 0;
@@ -941,31 +1658,26 @@ uint8_t convert_YUV420p_to_RGB8 (Image_t * img_yuv420p, Image_t * img_rgb8)
     // In RGB8, R is encoded on 3 bits, G on 3 and B on 2, so we have 8 bits per pixel
     // This necessitates upscaling, so U and V values will be quadrupled
     // See `convert_YUV420p_to_YUV444()` or `convert_YUV420p_to_YUV444p()` for more info
-
-    u_offset = width * height;
-    v_offset = u_offset + UROUND_UP(width / 2) * UROUND_UP(height / 2);
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
     for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // Get values for the YUV pixel corresponding to the current RGB pixel
-            y_value = img_yuv420p->data[i * width + j];
-            u_value = img_yuv420p->data[u_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)];
-            v_value = img_yuv420p->data[v_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)];
-
-            // Calculate R data
-            r_value = yuv_to_rgb_r(y_value, u_value, v_value);
-            // Calculate G data
-            g_value = yuv_to_rgb_g(y_value, u_value, v_value);
-            // Calculate B data
-            b_value = yuv_to_rgb_b(y_value, u_value, v_value);
-
-            r_value = rescale_color(r_value, 0, 255, 0, 8);
-            g_value = rescale_color(g_value, 0, 255, 0, 8);
-            b_value = rescale_color(b_value, 0, 255, 0, 4);
-
-            // Put values together in new image
+        y_row = get_image_row(img_yuv420p, 0, i);
+        u_row = get_image_row(img_yuv420p, 1, i / 2);
+        v_row = get_image_row(img_yuv420p, 2, i / 2);
+        conv_row = get_image_row(img_rgb8, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // U and V values are duplicated horizontally (and vertically, since two rows share the same U, V rows)
+            upsample_chroma_block(u_row, yuv_block[1], j, count);
+            upsample_chroma_block(v_row, yuv_block[2], j, count);
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_yuv420p->colorspace), &y_row[j], yuv_block[1], yuv_block[2],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Rescale values and put them together in new image
             // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
-            img_rgb8->data[i * width + j] = (b_value & 0x03) | ((g_value & 0x07) << 2) | ((r_value & 0x07) << 5);
+            pack_RGB8_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j], count);
         }
     }
 
@@ -975,8 +1687,11 @@ uint8_t convert_YUV420p_to_RGB8 (Image_t * img_yuv420p, Image_t * img_rgb8)
 
 uint8_t convert_YUV420p_to_GRAYSCALE (Image_t * img_yuv420p, Image_t * img_grayscale)
 {
+    uint32_t i = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_y_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_yuv420p) return 0;
     if (img_yuv420p->format != YUV420p) return 0;
@@ -990,9 +1705,17 @@ uint8_t convert_YUV420p_to_GRAYSCALE (Image_t * img_yuv420p, Image_t * img_grays
     // In GRAYSCALE, each pixel has one Y value
     // Base image: YYYYY U V
     // New image: Y Y Y Y
-    
+
     // Copy Y component
-    memcpy(img_grayscale->data, img_yuv420p->data, width * height);
+
+
+    for (i = 0; i < height; i++) {
+        base_y_row = get_image_row(img_yuv420p, 0, i);
+        conv_row = get_image_row(img_grayscale, 0, i);
+
+        // Copy Y component
+        memcpy(conv_row, base_y_row, width);
+    }
 
     return 1;
 }
@@ -1001,8 +1724,11 @@ uint8_t convert_YUV420p_to_GRAYSCALE (Image_t * img_yuv420p, Image_t * img_grays
 uint8_t convert_YUV420p_to_ASCII (Image_t * img_yuv420p, Image_t * img_ascii)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_y_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_yuv420p) return 0;
     if (img_yuv420p->format != YUV420p) return 0;
@@ -1016,10 +1742,17 @@ uint8_t convert_YUV420p_to_ASCII (Image_t * img_yuv420p, Image_t * img_ascii)
     // In ASCII, each pixel has one Y value
     // Base image: YYYYY U V
     // New image: Y Y Y Y
-    
+
     // Copy Y component
-    for (i = 0; i < width * height; i++) {
-        img_ascii->data[i] = y_to_ascii(img_yuv420p->data[i]);
+
+
+    for (i = 0; i < height; i++) {
+        base_y_row = get_image_row(img_yuv420p, 0, i);
+        conv_row = get_image_row(img_ascii, 0, i);
+
+        for (j = 0; j < width; j++) {
+            conv_row[j] = y_to_ascii(base_y_row[j]);
+        }
     }
 
     return 1;
@@ -1029,11 +1762,14 @@ uint8_t convert_YUV420p_to_ASCII (Image_t * img_yuv420p, Image_t * img_ascii)
 uint8_t convert_RGB24_to_YUV444 (Image_t * img_rgb24, Image_t * img_yuv444)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t y_value = 0;
-    uint8_t u_value = 0;
-    uint8_t v_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb24) return 0;
     if (img_rgb24->format != RGB24) return 0;
@@ -1047,19 +1783,23 @@ uint8_t convert_RGB24_to_YUV444 (Image_t * img_rgb24, Image_t * img_yuv444)
     // In YUV444, each pixel has one Y, one U and one V value
     // Base image: RGB RGB RGB RGB
     // New image: YUV YUV YUV YUV
+    // Pixels are converted in blocks, so that the RGB->YUV transformation can be vectorized
 
-    for (i = 0; i < width * height * 3; i += 3) {
-        // Transform RGB -> YUV
-        y_value = rgb_to_yuv_y(img_rgb24->data[i], img_rgb24->data[i + 1], img_rgb24->data[i + 2]);
-        u_value = rgb_to_yuv_u(img_rgb24->data[i], img_rgb24->data[i + 1], img_rgb24->data[i + 2]);
-        v_value = rgb_to_yuv_v(img_rgb24->data[i], img_rgb24->data[i + 1], img_rgb24->data[i + 2]);
-
-        // Copy Y component
-        img_yuv444->data[i] = y_value;
-        // Copy U component
-        img_yuv444->data[i + 1] = u_value;
-        // Copy V component
-        img_yuv444->data[i + 2] = v_value;
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb24, 0, i);
+        conv_row = get_image_row(img_yuv444, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Separate R, G and B components
+            deinterleave_24bpp_block(&base_row[j * 3], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->YUV
+            convert_color_block(get_rgb_to_yuv_matrix(img_yuv444->colorspace), rgb_block[0], rgb_block[1], rgb_block[2],
+                                yuv_block[0], yuv_block[1], yuv_block[2], count);
+            // Put Y, U and V components together in new image
+            interleave_24bpp_block(yuv_block[0], yuv_block[1], yuv_block[2], &conv_row[j * 3], count);
+        }
     }
 
     return 1;
@@ -1069,11 +1809,15 @@ uint8_t convert_RGB24_to_YUV444 (Image_t * img_rgb24, Image_t * img_yuv444)
 uint8_t convert_RGB24_to_YUV444p (Image_t * img_rgb24, Image_t * img_yuv444p)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t y_value = 0;
-    uint8_t u_value = 0;
-    uint8_t v_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb24) return 0;
     if (img_rgb24->format != RGB24) return 0;
@@ -1087,19 +1831,23 @@ uint8_t convert_RGB24_to_YUV444p (Image_t * img_rgb24, Image_t * img_yuv444p)
     // In YUV444p, each pixel has one Y, one U and one V value
     // Base image: RGB RGB RGB RGB
     // New image: YYYY UUUU VVVV
+    // Pixels are converted in blocks, so that the RGB->YUV transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Transform RGB -> YUV
-        y_value = rgb_to_yuv_y(img_rgb24->data[i * 3], img_rgb24->data[i * 3 + 1], img_rgb24->data[i * 3 + 2]);
-        u_value = rgb_to_yuv_u(img_rgb24->data[i * 3], img_rgb24->data[i * 3 + 1], img_rgb24->data[i * 3 + 2]);
-        v_value = rgb_to_yuv_v(img_rgb24->data[i * 3], img_rgb24->data[i * 3 + 1], img_rgb24->data[i * 3 + 2]);
-
-        // Copy Y component
-        img_yuv444p->data[i] = y_value;
-        // Copy U component
-        img_yuv444p->data[i + width * height] = u_value;
-        // Copy V component
-        img_yuv444p->data[i + width * height * 2] = v_value;
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb24, 0, i);
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Separate R, G and B components
+            deinterleave_24bpp_block(&base_row[j * 3], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->YUV
+            convert_color_block(get_rgb_to_yuv_matrix(img_yuv444p->colorspace), rgb_block[0], rgb_block[1],
+                                rgb_block[2], &y_row[j], &u_row[j], &v_row[j], count);
+        }
     }
 
     return 1;
@@ -1110,16 +1858,16 @@ uint8_t convert_RGB24_to_YUV420p (Image_t * img_rgb24, Image_t * img_yuv420p)
 {
     uint32_t i = 0;
     uint32_t j = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
-    uint8_t y_value = 0;
-    uint8_t u_value = 0;
-    uint8_t v_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t k = 0;
+    uint8_t row_count = 0;
+    uint8_t chroma_rows = 0;
+    uint8_t * y_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t chroma_blocks[2][2][SIMD_BLOCK_SIZE] = { { { 0 } } };
 
     if (!img_rgb24) return 0;
     if (img_rgb24->format != RGB24) return 0;
@@ -1133,26 +1881,29 @@ uint8_t convert_RGB24_to_YUV420p (Image_t * img_rgb24, Image_t * img_yuv420p)
     // In YUV420p, four Y values share one U and one V value
     // Base image: RGB RGB RGB RGB
     // New image: YYYY U V
-    
-    u_offset = width * height;
-    v_offset = u_offset + UROUND_UP(width / 2) * UROUND_UP(height / 2);
+    // Pixels are converted in blocks, so that the RGB->YUV transformation can be vectorized
 
-    for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // Get values for the RGB pixel corresponding to the current YUV pixel
-            r_value = img_rgb24->data[i * 3 * width + j * 3];
-            g_value = img_rgb24->data[i * 3 * width + j * 3 + 1];
-            b_value = img_rgb24->data[i * 3 * width + j * 3 + 2];
-
-            // Transform values to YUV
-            y_value = rgb_to_yuv_y(r_value, g_value, b_value);
-            u_value = rgb_to_yuv_u(r_value, g_value, b_value);
-            v_value = rgb_to_yuv_v(r_value, g_value, b_value);
-
-            // Copy Y, U and V data
-            img_yuv420p->data[i * width + j] = y_value;
-            img_yuv420p->data[u_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = u_value;
-            img_yuv420p->data[v_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = v_value;
+    for (i = 0; i < height; i += 2) {
+        row_count = (height - i < 2) ? 1 : 2;
+        chroma_rows = get_chroma_row_count(img_yuv420p, row_count);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            for (k = 0; k < row_count; k++) {
+                base_row = get_image_row(img_rgb24, 0, i + k);
+                y_row = get_image_row(img_yuv420p, 0, i + k);
+
+                // Separate R, G and B components
+                deinterleave_24bpp_block(&base_row[j * 3], rgb_block[0], rgb_block[1], rgb_block[2], count);
+                // Transform RGB->YUV (U and V values are only needed for the rows that are downsampled)
+                convert_color_block(get_rgb_to_yuv_matrix(img_yuv420p->colorspace), rgb_block[0], rgb_block[1],
+                                    rgb_block[2], &y_row[j], (k < chroma_rows) ? chroma_blocks[k][0] : NULL,
+                                    (k < chroma_rows) ? chroma_blocks[k][1] : NULL, count);
+            }
+
+            // Four Y values share one U and one V value
+            downsample_chroma_blocks(chroma_blocks, chroma_rows, img_yuv420p, i, j, count);
         }
     }
 
@@ -1163,8 +1914,11 @@ uint8_t convert_RGB24_to_YUV420p (Image_t * img_rgb24, Image_t * img_yuv420p)
 uint8_t convert_RGB24_to_RGB565 (Image_t * img_rgb24, Image_t * img_rgb565)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
     uint8_t r_value = 0;
     uint8_t g_value = 0;
     uint8_t b_value = 0;
@@ -1180,16 +1934,22 @@ uint8_t convert_RGB24_to_RGB565 (Image_t * img_rgb24, Image_t * img_rgb565)
 
     // In RGB565, R is encoded on 5 bits, G on 6 and B on 5, so we have 16 bits per pixel
 
-    for (i = 0; i < width * height; i++) {
-        // Rescale values
-        r_value = rescale_color(img_rgb24->data[i * 3], 0, 255, 0, 32);
-        g_value = rescale_color(img_rgb24->data[i * 3 + 1], 0, 255, 0, 64);
-        b_value = rescale_color(img_rgb24->data[i * 3 + 2], 0, 255, 0, 32);
 
-        // Put values together in new image
-        // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
-        img_rgb565->data[i * 2] = (b_value & 0x1f) | ((g_value & 0x07) << 5);
-        img_rgb565->data[i * 2 + 1] = ((g_value & 0x38) >> 3) | ((r_value & 0x1f) << 3);
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb24, 0, i);
+        conv_row = get_image_row(img_rgb565, 0, i);
+
+        for (j = 0; j < width; j++) {
+            // Rescale values
+            r_value = rescale_8bit_to_5bit_LUT[base_row[j * 3]];
+            g_value = rescale_8bit_to_6bit_LUT[base_row[j * 3 + 1]];
+            b_value = rescale_8bit_to_5bit_LUT[base_row[j * 3 + 2]];
+
+            // Put values together in new image
+            // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
+            conv_row[j * 2] = (b_value & 0x1f) | ((g_value & 0x07) << 5);
+            conv_row[j * 2 + 1] = ((g_value & 0x38) >> 3) | ((r_value & 0x1f) << 3);
+        }
     }
 
     return 1;
@@ -1199,8 +1959,11 @@ uint8_t convert_RGB24_to_RGB565 (Image_t * img_rgb24, Image_t * img_rgb565)
 uint8_t convert_RGB24_to_RGB8 (Image_t * img_rgb24, Image_t * img_rgb8)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
     uint8_t r_value = 0;
     uint8_t g_value = 0;
     uint8_t b_value = 0;
@@ -1216,15 +1979,21 @@ uint8_t convert_RGB24_to_RGB8 (Image_t * img_rgb24, Image_t * img_rgb8)
 
     // In RGB8, R is encoded on 3 bits, G on 3 and B on 2, so we have 8 bits per pixel
 
-    for (i = 0; i < width * height; i++) {
-        // Rescale values
-        r_value = rescale_color(img_rgb24->data[i * 3], 0, 255, 0, 8);
-        g_value = rescale_color(img_rgb24->data[i * 3 + 1], 0, 255, 0, 8);
-        b_value = rescale_color(img_rgb24->data[i * 3 + 2], 0, 255, 0, 4);
 
-        // Put values together in new image
-        // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
-        img_rgb8->data[i] = (b_value & 0x03) | ((g_value & 0x07) << 2) | ((r_value & 0x07) << 5);
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb24, 0, i);
+        conv_row = get_image_row(img_rgb8, 0, i);
+
+        for (j = 0; j < width; j++) {
+            // Rescale values
+            r_value = rescale_8bit_to_3bit_LUT[base_row[j * 3]];
+            g_value = rescale_8bit_to_3bit_LUT[base_row[j * 3 + 1]];
+            b_value = rescale_8bit_to_2bit_LUT[base_row[j * 3 + 2]];
+
+            // Put values together in new image
+            // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
+            conv_row[j] = (b_value & 0x03) | ((g_value & 0x07) << 2) | ((r_value & 0x07) << 5);
+        }
     }
 
     return 1;
@@ -1234,9 +2003,13 @@ uint8_t convert_RGB24_to_RGB8 (Image_t * img_rgb24, Image_t * img_rgb8)
 uint8_t convert_RGB24_to_GRAYSCALE (Image_t * img_rgb24, Image_t * img_grayscale)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t y_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb24) return 0;
     if (img_rgb24->format != RGB24) return 0;
@@ -1250,13 +2023,21 @@ uint8_t convert_RGB24_to_GRAYSCALE (Image_t * img_rgb24, Image_t * img_grayscale
     // In GRAYSCALE, each pixel has one Y value
     // Base image: RGB RGB RGB RGB
     // New image: YYYY
+    // Pixels are converted in blocks, so that the RGB->Y transformation can be vectorized
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb24, 0, i);
+        conv_row = get_image_row(img_grayscale, 0, i);
 
-    for (i = 0; i < width * height; i++) {
-        // Transform RGB -> Y
-        y_value = rgb_to_yuv_y(img_rgb24->data[i * 3], img_rgb24->data[i * 3 + 1], img_rgb24->data[i * 3 + 2]);
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Copy Y component
-        img_grayscale->data[i] = y_value;
+            // Separate R, G and B components
+            deinterleave_24bpp_block(&base_row[j * 3], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->Y
+            convert_color_block(get_rgb_to_yuv_matrix(img_grayscale->colorspace), rgb_block[0], rgb_block[1],
+                                rgb_block[2], &conv_row[j], NULL, NULL, count);
+        }
     }
 
     return 1;
@@ -1266,9 +2047,14 @@ uint8_t convert_RGB24_to_GRAYSCALE (Image_t * img_rgb24, Image_t * img_grayscale
 uint8_t convert_RGB24_to_ASCII (Image_t * img_rgb24, Image_t * img_ascii)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t y_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb24) return 0;
     if (img_rgb24->format != RGB24) return 0;
@@ -1282,13 +2068,23 @@ uint8_t convert_RGB24_to_ASCII (Image_t * img_rgb24, Image_t * img_ascii)
     // In ASCII, each pixel has one Y value
     // Base image: RGB RGB RGB RGB
     // New image: YYYY
+    // Pixels are converted in blocks, so that the RGB->Y transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Transform RGB -> Y
-        y_value = rgb_to_yuv_y(img_rgb24->data[i * 3], img_rgb24->data[i * 3 + 1], img_rgb24->data[i * 3 + 2]);
-
-        // Copy Y component
-        img_ascii->data[i] = y_to_ascii(y_value);
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb24, 0, i);
+        conv_row = get_image_row(img_ascii, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Separate R, G and B components
+            deinterleave_24bpp_block(&base_row[j * 3], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->Y
+            convert_color_block(get_rgb_to_yuv_matrix(img_ascii->colorspace), rgb_block[0], rgb_block[1], rgb_block[2],
+                                yuv_block[0], NULL, NULL, count);
+            // Transform Y -> ASCII
+            y_to_ascii_block(yuv_block[0], &conv_row[j], count);
+        }
     }
 
     return 1;
@@ -1298,11 +2094,14 @@ uint8_t convert_RGB24_to_ASCII (Image_t * img_rgb24, Image_t * img_ascii)
 uint8_t convert_RGB565_to_YUV444 (Image_t * img_rgb565, Image_t * img_yuv444)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb565) return 0;
     if (img_rgb565->format != RGB565) return 0;
@@ -1314,17 +2113,23 @@ uint8_t convert_RGB565_to_YUV444 (Image_t * img_rgb565, Image_t * img_yuv444)
     height = img_rgb565->height;
 
     // In YUV444, each pixel has one Y, one U and one V value: YUV YUV YUV YUV
+    // Pixels are converted in blocks, so that the RGB->YUV transformation can be vectorized
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb565, 0, i);
+        conv_row = get_image_row(img_yuv444, 0, i);
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values
-        b_value = img_rgb565->data[2 * i] & 0x1f;
-        g_value = ((img_rgb565->data[2 * i] & 0xe0) >> 5) | ((img_rgb565->data[2 * i + 1] & 0x07) << 3);
-        r_value = (img_rgb565->data[2 * i + 1] & 0xf8) >> 3;
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Transform RGB -> YUV and apply YUV values to new image
-        img_yuv444->data[3 * i] = rgb_to_yuv_y(r_value, g_value, b_value);
-        img_yuv444->data[3 * i + 1] = rgb_to_yuv_u(r_value, g_value, b_value);
-        img_yuv444->data[3 * i + 2] = rgb_to_yuv_v(r_value, g_value, b_value);
+            // Extract R, G and B values
+            unpack_RGB565_block(&base_row[j * 2], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->YUV
+            convert_color_block(get_rgb_to_yuv_matrix(img_yuv444->colorspace), rgb_block[0], rgb_block[1], rgb_block[2],
+                                yuv_block[0], yuv_block[1], yuv_block[2], count);
+            // Put Y, U and V components together in new image
+            interleave_24bpp_block(yuv_block[0], yuv_block[1], yuv_block[2], &conv_row[j * 3], count);
+        }
     }
 
     return 1;
@@ -1334,11 +2139,15 @@ uint8_t convert_RGB565_to_YUV444 (Image_t * img_rgb565, Image_t * img_yuv444)
 uint8_t convert_RGB565_to_YUV444p (Image_t * img_rgb565, Image_t * img_yuv444p)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb565) return 0;
     if (img_rgb565->format != RGB565) return 0;
@@ -1350,17 +2159,23 @@ uint8_t convert_RGB565_to_YUV444p (Image_t * img_rgb565, Image_t * img_yuv444p)
     height = img_rgb565->height;
 
     // In YUV444p, each pixel has one Y, one U and one V value: YYYY UUUU VVVV
+    // Pixels are converted in blocks, so that the RGB->YUV transformation can be vectorized
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb565, 0, i);
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values
-        b_value = img_rgb565->data[2 * i] & 0x1f;
-        g_value = ((img_rgb565->data[2 * i] & 0xe0) >> 5) | ((img_rgb565->data[2 * i + 1] & 0x07) << 3);
-        r_value = (img_rgb565->data[2 * i + 1] & 0xf8) >> 3;
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Transform RGB -> YUV and apply YUV values to new image
-        img_yuv444p->data[i] = rgb_to_yuv_y(r_value, g_value, b_value);
-        img_yuv444p->data[i + width * height] = rgb_to_yuv_u(r_value, g_value, b_value);
-        img_yuv444p->data[i + width * height * 2] = rgb_to_yuv_v(r_value, g_value, b_value);
+            // Extract R, G and B values
+            unpack_RGB565_block(&base_row[j * 2], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->YUV
+            convert_color_block(get_rgb_to_yuv_matrix(img_yuv444p->colorspace), rgb_block[0], rgb_block[1],
+                                rgb_block[2], &y_row[j], &u_row[j], &v_row[j], count);
+        }
     }
 
     return 1;
@@ -1371,13 +2186,16 @@ uint8_t convert_RGB565_to_YUV420p (Image_t * img_rgb565, Image_t * img_yuv420p)
 {
     uint32_t i = 0;
     uint32_t j = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t k = 0;
+    uint8_t row_count = 0;
+    uint8_t chroma_rows = 0;
+    uint8_t * y_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t chroma_blocks[2][2][SIMD_BLOCK_SIZE] = { { { 0 } } };
 
     if (!img_rgb565) return 0;
     if (img_rgb565->format != RGB565) return 0;
@@ -1389,26 +2207,29 @@ uint8_t convert_RGB565_to_YUV420p (Image_t * img_rgb565, Image_t * img_yuv420p)
     height = img_rgb565->height;
 
     // In YUV420p, each pixel has one Y, one U and one V value: YYYY U V
+    // Pixels are converted in blocks, so that the RGB->YUV transformation can be vectorized
 
-    u_offset = width * height;
-    v_offset = u_offset + UROUND_UP(width / 2) * UROUND_UP(height / 2);
+    for (i = 0; i < height; i += 2) {
+        row_count = (height - i < 2) ? 1 : 2;
+        chroma_rows = get_chroma_row_count(img_yuv420p, row_count);
 
-    for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // Extract R, G and B values
-            b_value = img_rgb565->data[i * 2 * width + j * 2] & 0x1f;
-            g_value = ((img_rgb565->data[i * 2 * width + j * 2] & 0xe0) >> 5) |
-                      ((img_rgb565->data[i * 2 * width + j * 2 + 1] & 0x07) << 3);
-            r_value = (img_rgb565->data[i * 2 * width + j * 2 + 1] & 0xf8) >> 3;
-
-            // Transform RGB -> YUV and apply YUV values to new image
-            img_yuv420p->data[i * width + j] = rgb_to_yuv_y(r_value, g_value, b_value);
-            img_yuv420p->data[u_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = rgb_to_yuv_u(r_value,
-                                                                                                  g_value,
-                                                                                                  b_value);
-            img_yuv420p->data[v_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = rgb_to_yuv_v(r_value,
-                                                                                                  g_value,
-                                                                                                  b_value);
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            for (k = 0; k < row_count; k++) {
+                base_row = get_image_row(img_rgb565, 0, i + k);
+                y_row = get_image_row(img_yuv420p, 0, i + k);
+
+                // Extract R, G and B values
+                unpack_RGB565_block(&base_row[j * 2], rgb_block[0], rgb_block[1], rgb_block[2], count);
+                // Transform RGB->YUV (U and V values are only needed for the rows that are downsampled)
+                convert_color_block(get_rgb_to_yuv_matrix(img_yuv420p->colorspace), rgb_block[0], rgb_block[1],
+                                    rgb_block[2], &y_row[j], (k < chroma_rows) ? chroma_blocks[k][0] : NULL,
+                                    (k < chroma_rows) ? chroma_blocks[k][1] : NULL, count);
+            }
+
+            // Four Y values share one U and one V value
+            downsample_chroma_blocks(chroma_blocks, chroma_rows, img_yuv420p, i, j, count);
         }
     }
 
@@ -1419,8 +2240,11 @@ uint8_t convert_RGB565_to_YUV420p (Image_t * img_rgb565, Image_t * img_yuv420p)
 uint8_t convert_RGB565_to_RGB24 (Image_t * img_rgb565, Image_t * img_rgb24)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
     uint8_t r_value = 0;
     uint8_t g_value = 0;
     uint8_t b_value = 0;
@@ -1436,16 +2260,22 @@ uint8_t convert_RGB565_to_RGB24 (Image_t * img_rgb565, Image_t * img_rgb24)
 
     // In RGB24, each pixel has one R, one G and one B value: RGB RGB RGB RGB
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values for base image
-        b_value = img_rgb565->data[2 * i] & 0x1f;
-        g_value = ((img_rgb565->data[2 * i] & 0xe0) >> 5) | ((img_rgb565->data[2 * i + 1] & 0x07) << 3);
-        r_value = (img_rgb565->data[2 * i + 1] & 0xf8) >> 3;
 
-        // Apply scaled values to new image
-        img_rgb24->data[3 * i] = r_value;
-        img_rgb24->data[3 * i + 1] = g_value;
-        img_rgb24->data[3 * i + 2] = b_value;
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb565, 0, i);
+        conv_row = get_image_row(img_rgb24, 0, i);
+
+        for (j = 0; j < width; j++) {
+            // Extract R, G and B values for base image
+            b_value = base_row[j * 2] & 0x1f;
+            g_value = ((base_row[j * 2] & 0xe0) >> 5) | ((base_row[j * 2 + 1] & 0x07) << 3);
+            r_value = (base_row[j * 2 + 1] & 0xf8) >> 3;
+
+            // Apply scaled values to new image
+            conv_row[j * 3] = r_value;
+            conv_row[j * 3 + 1] = g_value;
+            conv_row[j * 3 + 2] = b_value;
+        }
     }
 
     return 1;
@@ -1455,8 +2285,11 @@ uint8_t convert_RGB565_to_RGB24 (Image_t * img_rgb565, Image_t * img_rgb24)
 uint8_t convert_RGB565_to_RGB8 (Image_t * img_rgb565, Image_t * img_rgb8)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
     uint8_t r_value = 0;
     uint8_t g_value = 0;
     uint8_t b_value = 0;
@@ -1472,20 +2305,26 @@ uint8_t convert_RGB565_to_RGB8 (Image_t * img_rgb565, Image_t * img_rgb8)
 
     // In RGB8, R is encoded on 3 bits, G on 3 and B on 2, so we have 8 bits per pixel
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values for base image
-        b_value = img_rgb565->data[2 * i] & 0x1f;
-        g_value = ((img_rgb565->data[2 * i] & 0xe0) >> 5) | ((img_rgb565->data[2 * i + 1] & 0x07) << 3);
-        r_value = (img_rgb565->data[2 * i + 1] & 0xf8) >> 3;
 
-        // Rescale values
-        r_value = rescale_color(r_value, 0, 32, 0, 8);
-        g_value = rescale_color(g_value, 0, 64, 0, 8);
-        b_value = rescale_color(b_value, 0, 32, 0, 4);
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb565, 0, i);
+        conv_row = get_image_row(img_rgb8, 0, i);
+
+        for (j = 0; j < width; j++) {
+            // Extract R, G and B values for base image
+            b_value = base_row[j * 2] & 0x1f;
+            g_value = ((base_row[j * 2] & 0xe0) >> 5) | ((base_row[j * 2 + 1] & 0x07) << 3);
+            r_value = (base_row[j * 2 + 1] & 0xf8) >> 3;
+
+            // Rescale values
+            r_value = rescale_5bit_to_3bit_LUT[r_value];
+            g_value = rescale_6bit_to_3bit_LUT[g_value];
+            b_value = rescale_5bit_to_2bit_LUT[b_value];
 
-        // Put values together in new image
-        // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
-        img_rgb8->data[i] = (b_value & 0x03) | ((g_value & 0x07) << 2) | ((r_value & 0x07) << 5);
+            // Put values together in new image
+            // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
+            conv_row[j] = (b_value & 0x03) | ((g_value & 0x07) << 2) | ((r_value & 0x07) << 5);
+        }
     }
 
     return 1;
@@ -1495,11 +2334,13 @@ uint8_t convert_RGB565_to_RGB8 (Image_t * img_rgb565, Image_t * img_rgb8)
 uint8_t convert_RGB565_to_GRAYSCALE (Image_t * img_rgb565, Image_t * img_grayscale)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb565) return 0;
     if (img_rgb565->format != RGB565) return 0;
@@ -1511,15 +2352,21 @@ uint8_t convert_RGB565_to_GRAYSCALE (Image_t * img_rgb565, Image_t * img_graysca
     height = img_rgb565->height;
 
     // In GRAYSCALE, each pixel only has a single Y value: Y Y Y Y
+    // Pixels are converted in blocks, so that the RGB->Y transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values for base image
-        b_value = img_rgb565->data[2 * i] & 0x1f;
-        g_value = ((img_rgb565->data[2 * i] & 0xe0) >> 5) | ((img_rgb565->data[2 * i + 1] & 0x07) << 3);
-        r_value = (img_rgb565->data[2 * i + 1] & 0xf8) >> 3;
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb565, 0, i);
+        conv_row = get_image_row(img_grayscale, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Convert values to Y-channel only
-        img_grayscale->data[i] = rgb_to_yuv_y(r_value, g_value, b_value);
+            // Extract R, G and B values
+            unpack_RGB565_block(&base_row[j * 2], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->Y
+            convert_color_block(get_rgb_to_yuv_matrix(img_grayscale->colorspace), rgb_block[0], rgb_block[1],
+                                rgb_block[2], &conv_row[j], NULL, NULL, count);
+        }
     }
 
     return 1;
@@ -1529,11 +2376,14 @@ uint8_t convert_RGB565_to_GRAYSCALE (Image_t * img_rgb565, Image_t * img_graysca
 uint8_t convert_RGB565_to_ASCII (Image_t * img_rgb565, Image_t * img_ascii)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb565) return 0;
     if (img_rgb565->format != RGB565) return 0;
@@ -1545,15 +2395,23 @@ uint8_t convert_RGB565_to_ASCII (Image_t * img_rgb565, Image_t * img_ascii)
     height = img_rgb565->height;
 
     // In ASCII, each pixel only has a single Y value: Y Y Y Y
+    // Pixels are converted in blocks, so that the RGB->Y transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values for base image
-        b_value = img_rgb565->data[2 * i] & 0x1f;
-        g_value = ((img_rgb565->data[2 * i] & 0xe0) >> 5) | ((img_rgb565->data[2 * i + 1] & 0x07) << 3);
-        r_value = (img_rgb565->data[2 * i + 1] & 0xf8) >> 3;
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb565, 0, i);
+        conv_row = get_image_row(img_ascii, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Convert values to Y-channel only
-        img_ascii->data[i] = y_to_ascii(rgb_to_yuv_y(r_value, g_value, b_value));
+            // Extract R, G and B values
+            unpack_RGB565_block(&base_row[j * 2], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->Y
+            convert_color_block(get_rgb_to_yuv_matrix(img_ascii->colorspace), rgb_block[0], rgb_block[1], rgb_block[2],
+                                yuv_block[0], NULL, NULL, count);
+            // Transform Y -> ASCII
+            y_to_ascii_block(yuv_block[0], &conv_row[j], count);
+        }
     }
 
     return 1;
@@ -1563,11 +2421,14 @@ uint8_t convert_RGB565_to_ASCII (Image_t * img_rgb565, Image_t * img_ascii)
 uint8_t convert_RGB8_to_YUV444 (Image_t * img_rgb8, Image_t * img_yuv444)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb8) return 0;
     if (img_rgb8->format != RGB8) return 0;
@@ -1579,17 +2440,23 @@ uint8_t convert_RGB8_to_YUV444 (Image_t * img_rgb8, Image_t * img_yuv444)
     height = img_rgb8->height;
 
     // In YUV444, each pixel has one Y, one U and one V value: YUV YUV YUV YUV
+    // Pixels are converted in blocks, so that the RGB->YUV transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values
-        b_value = img_rgb8->data[i] & 0x03;
-        g_value = (img_rgb8->data[i] >> 2) & 0x07;
-        r_value = (img_rgb8->data[i] >> 5) & 0x07;
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb8, 0, i);
+        conv_row = get_image_row(img_yuv444, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Transform RGB -> YUV and apply YUV values to new image
-        img_yuv444->data[3 * i] = rgb_to_yuv_y(r_value, g_value, b_value);
-        img_yuv444->data[3 * i + 1] = rgb_to_yuv_u(r_value, g_value, b_value);
-        img_yuv444->data[3 * i + 2] = rgb_to_yuv_v(r_value, g_value, b_value);
+            // Extract R, G and B values
+            unpack_RGB8_block(&base_row[j], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->YUV
+            convert_color_block(get_rgb_to_yuv_matrix(img_yuv444->colorspace), rgb_block[0], rgb_block[1], rgb_block[2],
+                                yuv_block[0], yuv_block[1], yuv_block[2], count);
+            // Put Y, U and V components together in new image
+            interleave_24bpp_block(yuv_block[0], yuv_block[1], yuv_block[2], &conv_row[j * 3], count);
+        }
     }
 
     return 1;
@@ -1599,11 +2466,15 @@ uint8_t convert_RGB8_to_YUV444 (Image_t * img_rgb8, Image_t * img_yuv444)
 uint8_t convert_RGB8_to_YUV444p (Image_t * img_rgb8, Image_t * img_yuv444p)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb8) return 0;
     if (img_rgb8->format != RGB8) return 0;
@@ -1615,17 +2486,23 @@ uint8_t convert_RGB8_to_YUV444p (Image_t * img_rgb8, Image_t * img_yuv444p)
     height = img_rgb8->height;
 
     // In YUV444p, each pixel has one Y, one U and one V value: YYYY UUUU VVVV
+    // Pixels are converted in blocks, so that the RGB->YUV transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values
-        b_value = img_rgb8->data[i] & 0x03;
-        g_value = (img_rgb8->data[i] >> 2) & 0x07;
-        r_value = (img_rgb8->data[i] >> 5) & 0x07;
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb8, 0, i);
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Transform RGB -> YUV and apply YUV values to new image
-        img_yuv444p->data[i] = rgb_to_yuv_y(r_value, g_value, b_value);
-        img_yuv444p->data[i + width * height] = rgb_to_yuv_u(r_value, g_value, b_value);
-        img_yuv444p->data[i + width * height * 2] = rgb_to_yuv_v(r_value, g_value, b_value);
+            // Extract R, G and B values
+            unpack_RGB8_block(&base_row[j], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->YUV
+            convert_color_block(get_rgb_to_yuv_matrix(img_yuv444p->colorspace), rgb_block[0], rgb_block[1],
+                                rgb_block[2], &y_row[j], &u_row[j], &v_row[j], count);
+        }
     }
 
     return 1;
@@ -1636,13 +2513,16 @@ uint8_t convert_RGB8_to_YUV420p (Image_t * img_rgb8, Image_t * img_yuv420p)
 {
     uint32_t i = 0;
     uint32_t j = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t k = 0;
+    uint8_t row_count = 0;
+    uint8_t chroma_rows = 0;
+    uint8_t * y_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t chroma_blocks[2][2][SIMD_BLOCK_SIZE] = { { { 0 } } };
 
     if (!img_rgb8) return 0;
     if (img_rgb8->format != RGB8) return 0;
@@ -1654,25 +2534,29 @@ uint8_t convert_RGB8_to_YUV420p (Image_t * img_rgb8, Image_t * img_yuv420p)
     height = img_rgb8->height;
 
     // In YUV420p, each pixel has one Y, one U and one V value: YYYY U V
+    // Pixels are converted in blocks, so that the RGB->YUV transformation can be vectorized
 
-    u_offset = width * height;
-    v_offset = u_offset + UROUND_UP(width / 2) * UROUND_UP(height / 2);
+    for (i = 0; i < height; i += 2) {
+        row_count = (height - i < 2) ? 1 : 2;
+        chroma_rows = get_chroma_row_count(img_yuv420p, row_count);
 
-    for (i = 0; i < height; i++) {
-        for (j = 0; j < width; j++) {
-            // Extract R, G and B values
-            b_value = img_rgb8->data[i * width + j] & 0x03;
-            g_value = (img_rgb8->data[i * width + j] >> 2) & 0x07;
-            r_value = (img_rgb8->data[i * width + j] >> 5) & 0x07;
-
-            // Transform RGB -> YUV and apply YUV values to new image
-            img_yuv420p->data[i * width + j] = rgb_to_yuv_y(r_value, g_value, b_value);
-            img_yuv420p->data[u_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = rgb_to_yuv_u(r_value,
-                                                                                                  g_value,
-                                                                                                  b_value);
-            img_yuv420p->data[v_offset + (i / 2) * UROUND_UP(width / 2) + (j / 2)] = rgb_to_yuv_v(r_value,
-                                                                                                  g_value,
-                                                                                                  b_value);
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            for (k = 0; k < row_count; k++) {
+                base_row = get_image_row(img_rgb8, 0, i + k);
+                y_row = get_image_row(img_yuv420p, 0, i + k);
+
+                // Extract R, G and B values
+                unpack_RGB8_block(&base_row[j], rgb_block[0], rgb_block[1], rgb_block[2], count);
+                // Transform RGB->YUV (U and V values are only needed for the rows that are downsampled)
+                convert_color_block(get_rgb_to_yuv_matrix(img_yuv420p->colorspace), rgb_block[0], rgb_block[1],
+                                    rgb_block[2], &y_row[j], (k < chroma_rows) ? chroma_blocks[k][0] : NULL,
+                                    (k < chroma_rows) ? chroma_blocks[k][1] : NULL, count);
+            }
+
+            // Four Y values share one U and one V value
+            downsample_chroma_blocks(chroma_blocks, chroma_rows, img_yuv420p, i, j, count);
         }
     }
 
@@ -1683,8 +2567,11 @@ uint8_t convert_RGB8_to_YUV420p (Image_t * img_rgb8, Image_t * img_yuv420p)
 uint8_t convert_RGB8_to_RGB24 (Image_t * img_rgb8, Image_t * img_rgb24)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
     uint8_t r_value = 0;
     uint8_t g_value = 0;
     uint8_t b_value = 0;
@@ -1700,16 +2587,22 @@ uint8_t convert_RGB8_to_RGB24 (Image_t * img_rgb8, Image_t * img_rgb24)
 
     // In RGB24, each pixel has one R, one G and one B value: RGB RGB RGB RGB
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values
-        b_value = img_rgb8->data[i] & 0x03;
-        g_value = (img_rgb8->data[i] >> 2) & 0x07;
-        r_value = (img_rgb8->data[i] >> 5) & 0x07;
 
-        // Apply scaled values to new image
-        img_rgb24->data[3 * i] = r_value;
-        img_rgb24->data[3 * i + 1] = g_value;
-        img_rgb24->data[3 * i + 2] = b_value;
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb8, 0, i);
+        conv_row = get_image_row(img_rgb24, 0, i);
+
+        for (j = 0; j < width; j++) {
+            // Extract R, G and B values
+            b_value = base_row[j] & 0x03;
+            g_value = (base_row[j] >> 2) & 0x07;
+            r_value = (base_row[j] >> 5) & 0x07;
+
+            // Apply scaled values to new image
+            conv_row[j * 3] = r_value;
+            conv_row[j * 3 + 1] = g_value;
+            conv_row[j * 3 + 2] = b_value;
+        }
     }
 
     return 1;
@@ -1719,8 +2612,11 @@ uint8_t convert_RGB8_to_RGB24 (Image_t * img_rgb8, Image_t * img_rgb24)
 uint8_t convert_RGB8_to_RGB565 (Image_t * img_rgb8, Image_t * img_rgb565)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
     uint8_t r_value = 0;
     uint8_t g_value = 0;
     uint8_t b_value = 0;
@@ -1736,30 +2632,38 @@ uint8_t convert_RGB8_to_RGB565 (Image_t * img_rgb8, Image_t * img_rgb565)
 
     // In RGB565, R is encoded on 5 bits, G on 6 and B on 5, so we have 16 bits per pixel
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values
-        b_value = img_rgb8->data[i] & 0x03;
-        g_value = (img_rgb8->data[i] >> 2) & 0x07;
-        r_value = (img_rgb8->data[i] >> 5) & 0x07;
 
-        // Put values together in new image
-        // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
-        img_rgb565->data[i * 2] = (b_value & 0x1f) | ((g_value & 0x07) << 5);
-        img_rgb565->data[i * 2 + 1] = ((g_value & 0x38) >> 3) | ((r_value & 0x1f) << 3);
-    }
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb8, 0, i);
+        conv_row = get_image_row(img_rgb565, 0, i);
 
-    return 1;
-}
+        for (j = 0; j < width; j++) {
+            // Extract R, G and B values
+            b_value = base_row[j] & 0x03;
+            g_value = (base_row[j] >> 2) & 0x07;
+            r_value = (base_row[j] >> 5) & 0x07;
+
+            // Put values together in new image
+            // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
+            conv_row[j * 2] = (b_value & 0x1f) | ((g_value & 0x07) << 5);
+            conv_row[j * 2 + 1] = ((g_value & 0x38) >> 3) | ((r_value & 0x1f) << 3);
+        }
+    }
+
+    return 1;
+}
 
 
 uint8_t convert_RGB8_to_GRAYSCALE (Image_t * img_rgb8, Image_t * img_grayscale)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb8) return 0;
     if (img_rgb8->format != RGB8) return 0;
@@ -1771,15 +2675,21 @@ uint8_t convert_RGB8_to_GRAYSCALE (Image_t * img_rgb8, Image_t * img_grayscale)
     height = img_rgb8->height;
 
     // In GRAYSCALE, each pixel only has one Y value: Y Y Y Y
+    // Pixels are converted in blocks, so that the RGB->Y transformation can be vectorized
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb8, 0, i);
+        conv_row = get_image_row(img_grayscale, 0, i);
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values
-        b_value = img_rgb8->data[i] & 0x03;
-        g_value = (img_rgb8->data[i] >> 2) & 0x07;
-        r_value = (img_rgb8->data[i] >> 5) & 0x07;
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Set Y-channel only
-        img_grayscale->data[i] = rgb_to_yuv_y(r_value, g_value, b_value);
+            // Extract R, G and B values
+            unpack_RGB8_block(&base_row[j], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->Y
+            convert_color_block(get_rgb_to_yuv_matrix(img_grayscale->colorspace), rgb_block[0], rgb_block[1],
+                                rgb_block[2], &conv_row[j], NULL, NULL, count);
+        }
     }
 
     return 1;
@@ -1789,11 +2699,14 @@ uint8_t convert_RGB8_to_GRAYSCALE (Image_t * img_rgb8, Image_t * img_grayscale)
 uint8_t convert_RGB8_to_ASCII (Image_t * img_rgb8, Image_t * img_ascii)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_rgb8) return 0;
     if (img_rgb8->format != RGB8) return 0;
@@ -1805,15 +2718,23 @@ uint8_t convert_RGB8_to_ASCII (Image_t * img_rgb8, Image_t * img_ascii)
     height = img_rgb8->height;
 
     // In ASCII, each pixel only has one Y value: Y Y Y Y
+    // Pixels are converted in blocks, so that the RGB->Y transformation can be vectorized
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_rgb8, 0, i);
+        conv_row = get_image_row(img_ascii, 0, i);
 
-    for (i = 0; i < width * height; i++) {
-        // Extract R, G and B values
-        b_value = img_rgb8->data[i] & 0x03;
-        g_value = (img_rgb8->data[i] >> 2) & 0x07;
-        r_value = (img_rgb8->data[i] >> 5) & 0x07;
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Set Y-channel only
-        img_ascii->data[i] = y_to_ascii(rgb_to_yuv_y(r_value, g_value, b_value));
+            // Extract R, G and B values
+            unpack_RGB8_block(&base_row[j], rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Transform RGB->Y
+            convert_color_block(get_rgb_to_yuv_matrix(img_ascii->colorspace), rgb_block[0], rgb_block[1], rgb_block[2],
+                                yuv_block[0], NULL, NULL, count);
+            // Transform Y -> ASCII
+            y_to_ascii_block(yuv_block[0], &conv_row[j], count);
+        }
     }
 
     return 1;
@@ -1823,8 +2744,11 @@ uint8_t convert_RGB8_to_ASCII (Image_t * img_rgb8, Image_t * img_ascii)
 uint8_t convert_GRAYSCALE_to_YUV444 (Image_t * img_grayscale, Image_t * img_yuv444)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_grayscale) return 0;
     if (img_grayscale->format != GRAYSCALE) return 0;
@@ -1840,13 +2764,19 @@ uint8_t convert_GRAYSCALE_to_YUV444 (Image_t * img_grayscale, Image_t * img_yuv4
     // New image: YUV YUV YUV YUV
     // Since there is no U, V information in the base image, they will be set to 0
 
-    for (i = 0; i < width * height; i++) {
-        // Copy Y component
-        img_yuv444->data[i * 3] = img_grayscale->data[i];
-        // Set U component to be all zeroes, since there is no U data in the base image
-        img_yuv444->data[i * 3 + 1] = 0;
-        // Set V component to be all zeroes, since there is no V data in the base image
-        img_yuv444->data[i * 3 + 2] = 0;
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_grayscale, 0, i);
+        conv_row = get_image_row(img_yuv444, 0, i);
+
+        for (j = 0; j < width; j++) {
+            // Copy Y component
+            conv_row[j * 3] = base_row[j];
+            // Set U component to be all zeroes, since there is no U data in the base image
+            conv_row[j * 3 + 1] = 0;
+            // Set V component to be all zeroes, since there is no V data in the base image
+            conv_row[j * 3 + 2] = 0;
+        }
     }
 
     return 1;
@@ -1855,8 +2785,13 @@ uint8_t convert_GRAYSCALE_to_YUV444 (Image_t * img_grayscale, Image_t * img_yuv4
 
 uint8_t convert_GRAYSCALE_to_YUV444p (Image_t * img_grayscale, Image_t * img_yuv444p)
 {
+    uint32_t i = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
 
     if (!img_grayscale) return 0;
     if (img_grayscale->format != GRAYSCALE) return 0;
@@ -1871,13 +2806,23 @@ uint8_t convert_GRAYSCALE_to_YUV444p (Image_t * img_grayscale, Image_t * img_yuv
     // Base image: YYYY
     // New image: YYYY UUUU VVVV
     // Since there is no U, V information in the base image, they will be set to 0
-    
+
     // Copy Y component
-    memcpy(img_yuv444p->data, img_grayscale->data, width * height);
-    // Set U component to be all zeroes, since there is no U data in the base image
-    memset(&img_yuv444p->data[width * height], 0, width * height);
-    // Set V component to be all zeroes, since there is no V data in the base image
-    memset(&img_yuv444p->data[width * height * 2], 0, width * height);
+
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_grayscale, 0, i);
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+
+        // Copy Y component
+        memcpy(y_row, base_row, width);
+        // Set U component to be all zeroes, since there is no U data in the base image
+        memset(u_row, 0, width);
+        // Set V component to be all zeroes, since there is no V data in the base image
+        memset(v_row, 0, width);
+    }
 
     return 1;
 }
@@ -1885,8 +2830,13 @@ uint8_t convert_GRAYSCALE_to_YUV444p (Image_t * img_grayscale, Image_t * img_yuv
 
 uint8_t convert_GRAYSCALE_to_YUV420p (Image_t * img_grayscale, Image_t * img_yuv420p)
 {
+    uint32_t i = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
 
     if (!img_grayscale) return 0;
     if (img_grayscale->format != GRAYSCALE) return 0;
@@ -1901,15 +2851,27 @@ uint8_t convert_GRAYSCALE_to_YUV420p (Image_t * img_grayscale, Image_t * img_yuv
     // Base image: YYYY
     // New image: YYYY U V
     // Since there is no U, V information in the base image, they will be set to 0
-    
+
     // Copy Y component
-    memcpy(img_yuv420p->data, img_grayscale->data, width * height);
-    // Set U component to be all zeroes, since there is no U data in the base image
-    memset(&img_yuv420p->data[width * height], 0, UROUND_UP(width / 2) * UROUND_UP(height / 2));
-    // Set V component to be all zeroes, since there is no V data in the base image
-    memset(&img_yuv420p->data[width * height + UROUND_UP(width / 2) * UROUND_UP(height / 2)],
-           0,
-           UROUND_UP(width / 2) * UROUND_UP(height / 2));
+
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_grayscale, 0, i);
+        y_row = get_image_row(img_yuv420p, 0, i);
+
+        // Copy Y component
+        memcpy(y_row, base_row, width);
+    }
+
+    for (i = 0; i < UROUND_UP(height / 2); i++) {
+        u_row = get_image_row(img_yuv420p, 1, i);
+        v_row = get_image_row(img_yuv420p, 2, i);
+
+        // Set U component to be all zeroes, since there is no U data in the base image
+        memset(u_row, 0, UROUND_UP(width / 2));
+        // Set V component to be all zeroes, since there is no V data in the base image
+        memset(v_row, 0, UROUND_UP(width / 2));
+    }
 
     return 1;
 }
@@ -1918,8 +2880,13 @@ uint8_t convert_GRAYSCALE_to_YUV420p (Image_t * img_grayscale, Image_t * img_yuv
 uint8_t convert_GRAYSCALE_to_RGB24 (Image_t * img_grayscale, Image_t * img_rgb24)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_grayscale) return 0;
     if (img_grayscale->format != GRAYSCALE) return 0;
@@ -1934,14 +2901,21 @@ uint8_t convert_GRAYSCALE_to_RGB24 (Image_t * img_grayscale, Image_t * img_rgb24
     // Base image: YYYY
     // New image: RGB RGB RGB RGB
     // Since there is no U, V information in the base image, they will be set to 0
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
+
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_grayscale, 0, i);
+        conv_row = get_image_row(img_rgb24, 0, i);
 
-    for (i = 0; i < width * height; i++) {
-        // Set R component
-        img_rgb24->data[i * 3] = yuv_to_rgb_r(img_grayscale->data[i], 0, 0);
-        // Set G component
-        img_rgb24->data[i * 3 + 1] = yuv_to_rgb_g(img_grayscale->data[i], 0, 0);
-        // Set B component
-        img_rgb24->data[i * 3 + 2] = yuv_to_rgb_b(img_grayscale->data[i], 0, 0);
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_grayscale->colorspace), &y_row[j], zero_block, zero_block,
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Put R, G and B components together in new image
+            interleave_24bpp_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j * 3], count);
+        }
     }
 
     return 1;
@@ -1951,11 +2925,13 @@ uint8_t convert_GRAYSCALE_to_RGB24 (Image_t * img_grayscale, Image_t * img_rgb24
 uint8_t convert_GRAYSCALE_to_RGB565 (Image_t * img_grayscale, Image_t * img_rgb565)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_grayscale) return 0;
     if (img_grayscale->format != GRAYSCALE) return 0;
@@ -1968,22 +2944,22 @@ uint8_t convert_GRAYSCALE_to_RGB565 (Image_t * img_grayscale, Image_t * img_rgb5
 
     // In RGB565, each pixel has 5 bits for R, 6 bits for G and 5 bits for B
     // Since there is no U, V information in the base image, they will be set to 0
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Transform YUV -> RGB
-        r_value = yuv_to_rgb_r(img_grayscale->data[i], 0, 0);
-        g_value = yuv_to_rgb_g(img_grayscale->data[i], 0, 0);
-        b_value = yuv_to_rgb_b(img_grayscale->data[i], 0, 0);
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_grayscale, 0, i);
+        conv_row = get_image_row(img_rgb565, 0, i);
 
-        // Rescale values
-        r_value = rescale_color(r_value, 0, 255, 0, 32);
-        g_value = rescale_color(g_value, 0, 255, 0, 64);
-        b_value = rescale_color(b_value, 0, 255, 0, 32);
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Put values together in new image
-        // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
-        img_rgb565->data[i * 2] = (b_value & 0x1f) | ((g_value & 0x07) << 5);
-        img_rgb565->data[i * 2 + 1] = ((g_value & 0x38) >> 3) | ((r_value & 0x1f) << 3);
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_grayscale->colorspace), &y_row[j], zero_block, zero_block,
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Rescale values and put them together in new image
+            // MSB | 5 bits of R, 6 bits of G, 5 bits of B | LSB
+            pack_RGB565_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j * 2], count);
+        }
     }
 
     return 1;
@@ -1993,11 +2969,13 @@ uint8_t convert_GRAYSCALE_to_RGB565 (Image_t * img_grayscale, Image_t * img_rgb5
 uint8_t convert_GRAYSCALE_to_RGB8 (Image_t * img_grayscale, Image_t * img_rgb8)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint8_t r_value = 0;
-    uint8_t g_value = 0;
-    uint8_t b_value = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
 
     if (!img_grayscale) return 0;
     if (img_grayscale->format != GRAYSCALE) return 0;
@@ -2010,21 +2988,22 @@ uint8_t convert_GRAYSCALE_to_RGB8 (Image_t * img_grayscale, Image_t * img_rgb8)
 
     // In RGB8, each pixel has 3 bits for R, 3 bits for G and 2 bits for B
     // Since there is no U, V information in the base image, they will be set to 0
+    // Pixels are converted in blocks, so that the YUV->RGB transformation can be vectorized
 
-    for (i = 0; i < width * height; i++) {
-        // Transform YUV -> RGB
-        r_value = yuv_to_rgb_r(img_grayscale->data[i], 0, 0);
-        g_value = yuv_to_rgb_g(img_grayscale->data[i], 0, 0);
-        b_value = yuv_to_rgb_b(img_grayscale->data[i], 0, 0);
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_grayscale, 0, i);
+        conv_row = get_image_row(img_rgb8, 0, i);
 
-        // Rescale values
-        r_value = rescale_color(r_value, 0, 255, 0, 8);
-        g_value = rescale_color(g_value, 0, 255, 0, 8);
-        b_value = rescale_color(b_value, 0, 255, 0, 4);
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
 
-        // Put values together in new image
-        // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
-        img_rgb8->data[i] = (b_value & 0x03) | ((g_value & 0x07) << 2) | ((r_value & 0x07) << 5);
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_grayscale->colorspace), &y_row[j], zero_block, zero_block,
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Rescale values and put them together in new image
+            // MSB | 3 bits of R, 3 bits of G, 2 bits of B | LSB
+            pack_RGB8_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j], count);
+        }
     }
 
     return 1;
@@ -2034,8 +3013,11 @@ uint8_t convert_GRAYSCALE_to_RGB8 (Image_t * img_grayscale, Image_t * img_rgb8)
 uint8_t convert_GRAYSCALE_to_ASCII (Image_t * img_grayscale, Image_t * img_ascii)
 {
     uint32_t i = 0;
+    uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
 
     if (!img_grayscale) return 0;
     if (img_grayscale->format != GRAYSCALE) return 0;
@@ -2046,14 +3028,791 @@ uint8_t convert_GRAYSCALE_to_ASCII (Image_t * img_grayscale, Image_t * img_ascii
     width = img_grayscale->width;
     height = img_grayscale->height;
 
-    for (i = 0; i < width * height; i++) {
-        img_ascii->data[i] = y_to_ascii(img_grayscale->data[i]);
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_grayscale, 0, i);
+        conv_row = get_image_row(img_ascii, 0, i);
+
+        for (j = 0; j < width; j++) {
+            conv_row[j] = y_to_ascii(base_row[j]);
+        }
     }
 
     return 1;
 }
 
 
+/* --------------------------------------------------------------------------------------------------------------------
+ * SEMI-PLANAR AND PACKED 4:2:2 CONVERSION FUNCTIONS
+ * --------------------------------------------------------------------------------------------------------------------
+ *
+ * NV12 and NV21 have the same samples as YUV420p, and YUYV and UYVY the same samples as YUV444p with every other U and
+ * V value dropped, so only the conversions from and to these formats (and the ones on the hot paths of capture
+ * pipelines) have their own kernels. All others go through a small intermediate image, see `convert_via_format()`.
+ */
+
+static uint8_t convert_YUV420p_to_semiplanar (Image_t * img_yuv420p, Image_t * img_nv, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+
+    if (!img_yuv420p) return 0;
+    if (img_yuv420p->format != YUV420p) return 0;
+    if (!img_nv) return 0;
+    if (img_nv->format != format) return 0;
+    if (img_yuv420p->width != img_nv->width || img_yuv420p->height != img_nv->height) return 0;
+
+    width = img_yuv420p->width;
+    height = img_yuv420p->height;
+
+    // In NV12, the U and V planes are merged into a single plane of U, V pairs (V, U pairs in NV21)
+    // Base image: YYYY U V
+    // New image: YYYY UV
+
+    for (i = 0; i < height; i++) {
+        memcpy(get_image_row(img_nv, 0, i), get_image_row(img_yuv420p, 0, i), width);
+    }
+
+    for (i = 0; i < get_image_plane_height(height, YUV420p, 1); i++) {
+        if (format == NV12) {
+            interleave_16bpp_block(get_image_row(img_yuv420p, 1, i), get_image_row(img_yuv420p, 2, i),
+                                   get_image_row(img_nv, 1, i), UROUND_UP(width / 2));
+        } else {
+            interleave_16bpp_block(get_image_row(img_yuv420p, 2, i), get_image_row(img_yuv420p, 1, i),
+                                   get_image_row(img_nv, 1, i), UROUND_UP(width / 2));
+        }
+    }
+
+    return 1;
+}
+
+
+static uint8_t convert_semiplanar_to_YUV420p (Image_t * img_nv, Image_t * img_yuv420p, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+
+    if (!img_nv) return 0;
+    if (img_nv->format != format) return 0;
+    if (!img_yuv420p) return 0;
+    if (img_yuv420p->format != YUV420p) return 0;
+    if (img_nv->width != img_yuv420p->width || img_nv->height != img_yuv420p->height) return 0;
+
+    width = img_nv->width;
+    height = img_nv->height;
+
+    // Base image: YYYY UV
+    // New image: YYYY U V
+
+    for (i = 0; i < height; i++) {
+        memcpy(get_image_row(img_yuv420p, 0, i), get_image_row(img_nv, 0, i), width);
+    }
+
+    for (i = 0; i < get_image_plane_height(height, YUV420p, 1); i++) {
+        if (format == NV12) {
+            deinterleave_16bpp_block(get_image_row(img_nv, 1, i), get_image_row(img_yuv420p, 1, i),
+                                     get_image_row(img_yuv420p, 2, i), UROUND_UP(width / 2));
+        } else {
+            deinterleave_16bpp_block(get_image_row(img_nv, 1, i), get_image_row(img_yuv420p, 2, i),
+                                     get_image_row(img_yuv420p, 1, i), UROUND_UP(width / 2));
+        }
+    }
+
+    return 1;
+}
+
+
+static uint8_t swap_semiplanar_chroma (Image_t * base_img, Image_t * converted_img, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+
+    if (!base_img) return 0;
+    if (base_img->format != (format == NV12 ? NV21 : NV12)) return 0;
+    if (!converted_img) return 0;
+    if (converted_img->format != format) return 0;
+    if (base_img->width != converted_img->width || base_img->height != converted_img->height) return 0;
+
+    width = base_img->width;
+    height = base_img->height;
+
+    // Only the order of the U and V values changes
+    for (i = 0; i < height; i++) {
+        memcpy(get_image_row(converted_img, 0, i), get_image_row(base_img, 0, i), width);
+    }
+
+    for (i = 0; i < get_image_plane_height(height, format, 1); i++) {
+        swap_byte_pairs(get_image_row(base_img, 1, i), get_image_row(converted_img, 1, i), UROUND_UP(width / 2));
+    }
+
+    return 1;
+}
+
+
+static uint8_t convert_semiplanar_to_RGB24 (Image_t * img_nv, Image_t * img_rgb24, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * uv_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t chroma_block[2][SIMD_BLOCK_SIZE / 2] = { { 0 } };
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+
+    if (!img_nv) return 0;
+    if (img_nv->format != format) return 0;
+    if (!img_rgb24) return 0;
+    if (img_rgb24->format != RGB24) return 0;
+    if (img_nv->width != img_rgb24->width || img_nv->height != img_rgb24->height) return 0;
+
+    width = img_nv->width;
+    height = img_nv->height;
+
+    // Same as `convert_YUV420p_to_RGB24()`, with the U and V values of each block split out of the chroma row first
+
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_nv, 0, i);
+        uv_row = get_image_row(img_nv, 1, i / 2);
+        conv_row = get_image_row(img_rgb24, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // Blocks start on even columns, and the chroma pair of column j is at offset j of the chroma row
+            deinterleave_16bpp_block(&uv_row[j], chroma_block[0], chroma_block[1], UROUND_UP(count / 2));
+            upsample_chroma_block(chroma_block[format == NV12 ? 0 : 1], yuv_block[1], 0, count);
+            upsample_chroma_block(chroma_block[format == NV12 ? 1 : 0], yuv_block[2], 0, count);
+            // Transform YUV -> RGB
+            convert_color_block(get_yuv_to_rgb_matrix(img_nv->colorspace), &y_row[j], yuv_block[1], yuv_block[2],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            // Put R, G and B components together in new image
+            interleave_24bpp_block(rgb_block[0], rgb_block[1], rgb_block[2], &conv_row[j * 3], count);
+        }
+    }
+
+    return 1;
+}
+
+
+static uint8_t convert_YUV444p_to_packed_422 (Image_t * img_yuv444p, Image_t * img_422, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t y_block[SIMD_BLOCK_SIZE] = { 0 };
+    uint8_t chroma_block[2][SIMD_BLOCK_SIZE / 2] = { { 0 } };
+
+    if (!img_yuv444p) return 0;
+    if (img_yuv444p->format != YUV444p) return 0;
+    if (!img_422) return 0;
+    if (img_422->format != format) return 0;
+    if (img_yuv444p->width != img_422->width || img_yuv444p->height != img_422->height) return 0;
+
+    width = img_yuv444p->width;
+    height = img_yuv444p->height;
+
+    // In YUYV, two horizontally adjacent Y values share one U and one V value
+    // Base image: YYYY UUUU VVVV
+    // New image: YUYV YUYV (UYVY UYVY)
+
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+        conv_row = get_image_row(img_422, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            // The padding pixel of the last macropixel of odd-width rows repeats the last pixel
+            memcpy(y_block, &y_row[j], count);
+            if (count & 1) y_block[count] = y_block[count - 1];
+
+            subsample_chroma_block(&u_row[j], chroma_block[0], 0, count);
+            subsample_chroma_block(&v_row[j], chroma_block[1], 0, count);
+            pack_422_block(y_block, chroma_block[0], chroma_block[1], format == YUYV, &conv_row[j * 2], count);
+        }
+    }
+
+    return 1;
+}
+
+
+static uint8_t convert_packed_422_to_YUV444p (Image_t * img_422, Image_t * img_yuv444p, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t y_block[SIMD_BLOCK_SIZE] = { 0 };
+    uint8_t chroma_block[2][SIMD_BLOCK_SIZE / 2] = { { 0 } };
+
+    if (!img_422) return 0;
+    if (img_422->format != format) return 0;
+    if (!img_yuv444p) return 0;
+    if (img_yuv444p->format != YUV444p) return 0;
+    if (img_422->width != img_yuv444p->width || img_422->height != img_yuv444p->height) return 0;
+
+    width = img_422->width;
+    height = img_422->height;
+
+    // U and V values are duplicated horizontally
+    // Base image: YUYV YUYV (UYVY UYVY)
+    // New image: YYYY UUUU VVVV
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_422, 0, i);
+        y_row = get_image_row(img_yuv444p, 0, i);
+        u_row = get_image_row(img_yuv444p, 1, i);
+        v_row = get_image_row(img_yuv444p, 2, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            unpack_422_block(&base_row[j * 2], format == YUYV, y_block, chroma_block[0], chroma_block[1], count);
+            memcpy(&y_row[j], y_block, count);
+            upsample_chroma_block(chroma_block[0], &u_row[j], 0, count);
+            upsample_chroma_block(chroma_block[1], &v_row[j], 0, count);
+        }
+    }
+
+    return 1;
+}
+
+
+static uint8_t swap_packed_422 (Image_t * base_img, Image_t * converted_img, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+
+    if (!base_img) return 0;
+    if (base_img->format != (format == YUYV ? UYVY : YUYV)) return 0;
+    if (!converted_img) return 0;
+    if (converted_img->format != format) return 0;
+    if (base_img->width != converted_img->width || base_img->height != converted_img->height) return 0;
+
+    width = base_img->width;
+    height = base_img->height;
+
+    // YUYV and UYVY only differ by the order of the bytes of every pixel
+    for (i = 0; i < height; i++) {
+        swap_byte_pairs(get_image_row(base_img, 0, i), get_image_row(converted_img, 0, i), UROUND_UP(width / 2) * 2);
+    }
+
+    return 1;
+}
+
+
+static uint8_t convert_packed_422_to_RGB565 (Image_t * img_422, Image_t * img_rgb565, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    uint8_t y_block[SIMD_BLOCK_SIZE] = { 0 };
+    uint8_t chroma_block[2][SIMD_BLOCK_SIZE / 2] = { { 0 } };
+
+    if (!img_422) return 0;
+    if (img_422->format != format) return 0;
+    if (!img_rgb565) return 0;
+    if (img_rgb565->format != RGB565) return 0;
+    if (img_422->width != img_rgb565->width || img_422->height != img_rgb565->height) return 0;
+
+    width = img_422->width;
+    height = img_422->height;
+
+    // A YUYV row has the same samples as a YUV420p row (with its own chroma row), so once split, every block goes
+    // through the YUV420p -> RGB565 kernel: the chroma contributions are computed once per macropixel, and the pixels
+    // are packed right away
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(img_422, 0, i);
+        conv_row = get_image_row(img_rgb565, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            unpack_422_block(&base_row[j * 2], format == YUYV, y_block, chroma_block[0], chroma_block[1], count);
+            convert_YUV420p_to_RGB565_block(get_yuv_to_rgb_matrix(img_422->colorspace), y_block, NULL, chroma_block[0],
+                                            chroma_block[1], &conv_row[j * 2], NULL, count, 0);
+        }
+    }
+
+    return 1;
+}
+
+
+// Convert an image through an intermediate format, in tiles of `SIMD_BLOCK_SIZE` x 2 pixels, so that the intermediate
+// pixels always fit in a small buffer (and in the cache); tiles start on even rows and columns, so that chroma samples
+// are never split
+static uint8_t convert_via_format (Image_t * base_img, Image_t * converted_img, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
+    uint16_t rows = 0;
+    uint8_t tile_data[SIMD_BLOCK_SIZE * 2 * 3] = { 0 };
+    Image_t tile;
+    Image_t tile_view;
+    Image_t base_view;
+    Image_t converted_view;
+
+    if (!base_img) return 0;
+    if (!converted_img) return 0;
+    if (base_img->width != converted_img->width || base_img->height != converted_img->height) return 0;
+    if (base_img->format >= ASCII || converted_img->format > ASCII) return 0;
+    if (base_img->format == format || converted_img->format == format) return 0;
+
+    init_image(&tile, SIMD_BLOCK_SIZE, 2, format, tile_data, NULL);
+    // Intermediate YUV values belong to the color space (and chroma siting) of the YUV side of the conversion
+    if (get_rgb_layout(base_img->format) || base_img->format == RGB565 || base_img->format == RGB8) {
+        tile.colorspace = converted_img->colorspace;
+        tile.chroma_siting = converted_img->chroma_siting;
+    } else {
+        tile.colorspace = base_img->colorspace;
+        tile.chroma_siting = base_img->chroma_siting;
+    }
+
+    for (i = 0; i < base_img->height; i += rows) {
+        rows = (base_img->height - i < 2) ? base_img->height - i : 2;
+
+        for (j = 0; j < base_img->width; j += count) {
+            count = BLOCK_COUNT(base_img->width - j);
+
+            if (!create_image_view(base_img, j, i, count, rows, &base_view)) return 0;
+            if (!create_image_view(converted_img, j, i, count, rows, &converted_view)) return 0;
+            if (!create_image_view(&tile, 0, 0, count, rows, &tile_view)) return 0;
+
+            if (!conversion_function_LUT[base_img->format][format](&base_view, &tile_view)) return 0;
+            if (!conversion_function_LUT[format][converted_img->format](&tile_view, &converted_view)) return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+static uint8_t convert_via_YUV420p (Image_t * base_img, Image_t * converted_img)
+{
+    return convert_via_format(base_img, converted_img, YUV420p);
+}
+
+
+static uint8_t convert_via_YUV444p (Image_t * base_img, Image_t * converted_img)
+{
+    return convert_via_format(base_img, converted_img, YUV444p);
+}
+
+
+uint8_t convert_YUV420p_to_NV12 (Image_t * img_yuv420p, Image_t * img_nv12)
+{
+    return convert_YUV420p_to_semiplanar(img_yuv420p, img_nv12, NV12);
+}
+
+
+uint8_t convert_YUV420p_to_NV21 (Image_t * img_yuv420p, Image_t * img_nv21)
+{
+    return convert_YUV420p_to_semiplanar(img_yuv420p, img_nv21, NV21);
+}
+
+
+uint8_t convert_NV12_to_YUV420p (Image_t * img_nv12, Image_t * img_yuv420p)
+{
+    return convert_semiplanar_to_YUV420p(img_nv12, img_yuv420p, NV12);
+}
+
+
+uint8_t convert_NV21_to_YUV420p (Image_t * img_nv21, Image_t * img_yuv420p)
+{
+    return convert_semiplanar_to_YUV420p(img_nv21, img_yuv420p, NV21);
+}
+
+
+uint8_t convert_NV12_to_NV21 (Image_t * img_nv12, Image_t * img_nv21)
+{
+    return swap_semiplanar_chroma(img_nv12, img_nv21, NV21);
+}
+
+
+uint8_t convert_NV21_to_NV12 (Image_t * img_nv21, Image_t * img_nv12)
+{
+    return swap_semiplanar_chroma(img_nv21, img_nv12, NV12);
+}
+
+
+uint8_t convert_NV12_to_RGB24 (Image_t * img_nv12, Image_t * img_rgb24)
+{
+    return convert_semiplanar_to_RGB24(img_nv12, img_rgb24, NV12);
+}
+
+
+uint8_t convert_NV21_to_RGB24 (Image_t * img_nv21, Image_t * img_rgb24)
+{
+    return convert_semiplanar_to_RGB24(img_nv21, img_rgb24, NV21);
+}
+
+
+uint8_t convert_YUV444p_to_YUYV (Image_t * img_yuv444p, Image_t * img_yuyv)
+{
+    return convert_YUV444p_to_packed_422(img_yuv444p, img_yuyv, YUYV);
+}
+
+
+uint8_t convert_YUV444p_to_UYVY (Image_t * img_yuv444p, Image_t * img_uyvy)
+{
+    return convert_YUV444p_to_packed_422(img_yuv444p, img_uyvy, UYVY);
+}
+
+
+uint8_t convert_YUYV_to_YUV444p (Image_t * img_yuyv, Image_t * img_yuv444p)
+{
+    return convert_packed_422_to_YUV444p(img_yuyv, img_yuv444p, YUYV);
+}
+
+
+uint8_t convert_UYVY_to_YUV444p (Image_t * img_uyvy, Image_t * img_yuv444p)
+{
+    return convert_packed_422_to_YUV444p(img_uyvy, img_yuv444p, UYVY);
+}
+
+
+uint8_t convert_YUYV_to_UYVY (Image_t * img_yuyv, Image_t * img_uyvy)
+{
+    return swap_packed_422(img_yuyv, img_uyvy, UYVY);
+}
+
+
+uint8_t convert_UYVY_to_YUYV (Image_t * img_uyvy, Image_t * img_yuyv)
+{
+    return swap_packed_422(img_uyvy, img_yuyv, YUYV);
+}
+
+
+uint8_t convert_YUYV_to_RGB565 (Image_t * img_yuyv, Image_t * img_rgb565)
+{
+    return convert_packed_422_to_RGB565(img_yuyv, img_rgb565, YUYV);
+}
+
+
+uint8_t convert_UYVY_to_RGB565 (Image_t * img_uyvy, Image_t * img_rgb565)
+{
+    return convert_packed_422_to_RGB565(img_uyvy, img_rgb565, UYVY);
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * BGR24 AND 32-BIT CONVERSION FUNCTIONS
+ * --------------------------------------------------------------------------------------------------------------------
+ *
+ * RGB24, BGR24, RGBA8888, BGRA8888 and XRGB8888 only differ by the order (and size) of their pixels, so conversions
+ * between them all go through `convert_rgb_layout()`; the conversions from and to YUV420p (the usual way to and from
+ * a display) have their own kernels, and all others go through RGB24 (or YUV420p for NV12 and NV21).
+ */
+
+static uint8_t convert_rgb_layout (Image_t * base_img, Image_t * converted_img)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t * conv_row = NULL;
+    const uint8_t * alpha = NULL;
+    const RgbLayout_t * base_layout = NULL;
+    const RgbLayout_t * conv_layout = NULL;
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t alpha_block[SIMD_BLOCK_SIZE] = { 0 };
+    uint8_t opaque_block[SIMD_BLOCK_SIZE] = { 0 };
+
+    if (!base_img) return 0;
+    if (!converted_img) return 0;
+    if (base_img->width != converted_img->width || base_img->height != converted_img->height) return 0;
+
+    base_layout = get_rgb_layout(base_img->format);
+    conv_layout = get_rgb_layout(converted_img->format);
+    if (!base_layout || !conv_layout) return 0;
+
+    width = base_img->width;
+    height = base_img->height;
+
+    // Alpha values are kept if both formats have them, and pixels are opaque otherwise (XRGB8888 included)
+    memset(opaque_block, 0xff, sizeof(opaque_block));
+    alpha = (base_layout->has_alpha && conv_layout->has_alpha) ? alpha_block : opaque_block;
+
+    for (i = 0; i < height; i++) {
+        base_row = get_image_row(base_img, 0, i);
+        conv_row = get_image_row(converted_img, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            unpack_rgb_block(&base_row[j * base_layout->pixel_size], base_layout, rgb_block[0], rgb_block[1],
+                             rgb_block[2], alpha_block, count);
+            pack_rgb_block(rgb_block[0], rgb_block[1], rgb_block[2], alpha, conv_layout,
+                           &conv_row[j * conv_layout->pixel_size], count);
+        }
+    }
+
+    return 1;
+}
+
+
+static uint8_t convert_YUV420p_to_rgb_layout (Image_t * img_yuv420p, Image_t * img_rgb, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t * y_row = NULL;
+    uint8_t * u_row = NULL;
+    uint8_t * v_row = NULL;
+    uint8_t * conv_row = NULL;
+    const RgbLayout_t * layout = get_rgb_layout(format);
+    uint8_t yuv_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t rgb_block[3][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t opaque_block[SIMD_BLOCK_SIZE] = { 0 };
+
+    if (!img_yuv420p) return 0;
+    if (img_yuv420p->format != YUV420p) return 0;
+    if (!img_rgb) return 0;
+    if (img_rgb->format != format) return 0;
+    if (img_yuv420p->width != img_rgb->width || img_yuv420p->height != img_rgb->height) return 0;
+
+    width = img_yuv420p->width;
+    height = img_yuv420p->height;
+
+    // Same as `convert_YUV420p_to_RGB24()`, with the pixels packed in the order of the format (32-bit pixels are
+    // written as whole words, and are opaque)
+    memset(opaque_block, 0xff, sizeof(opaque_block));
+
+    for (i = 0; i < height; i++) {
+        y_row = get_image_row(img_yuv420p, 0, i);
+        u_row = get_image_row(img_yuv420p, 1, i / 2);
+        v_row = get_image_row(img_yuv420p, 2, i / 2);
+        conv_row = get_image_row(img_rgb, 0, i);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            upsample_chroma_block(u_row, yuv_block[1], j, count);
+            upsample_chroma_block(v_row, yuv_block[2], j, count);
+            convert_color_block(get_yuv_to_rgb_matrix(img_yuv420p->colorspace), &y_row[j], yuv_block[1], yuv_block[2],
+                                rgb_block[0], rgb_block[1], rgb_block[2], count);
+            pack_rgb_block(rgb_block[0], rgb_block[1], rgb_block[2], opaque_block, layout,
+                           &conv_row[j * layout->pixel_size], count);
+        }
+    }
+
+    return 1;
+}
+
+
+static uint8_t convert_rgb_layout_to_YUV420p (Image_t * img_rgb, Image_t * img_yuv420p, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t count = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    uint8_t * base_row = NULL;
+    uint8_t k = 0;
+    uint8_t row_count = 0;
+    uint8_t chroma_rows = 0;
+    uint8_t * y_row = NULL;
+    const RgbLayout_t * layout = get_rgb_layout(format);
+    uint8_t rgb_block[4][SIMD_BLOCK_SIZE] = { { 0 } };
+    uint8_t chroma_blocks[2][2][SIMD_BLOCK_SIZE] = { { { 0 } } };
+
+    if (!img_rgb) return 0;
+    if (img_rgb->format != format) return 0;
+    if (!img_yuv420p) return 0;
+    if (img_yuv420p->format != YUV420p) return 0;
+    if (img_rgb->width != img_yuv420p->width || img_rgb->height != img_yuv420p->height) return 0;
+
+    width = img_rgb->width;
+    height = img_rgb->height;
+
+    // Same as `convert_RGB24_to_YUV420p()`, with the pixels unpacked in the order of the format (alpha values are
+    // dropped)
+
+    for (i = 0; i < height; i += 2) {
+        row_count = (height - i < 2) ? 1 : 2;
+        chroma_rows = get_chroma_row_count(img_yuv420p, row_count);
+
+        for (j = 0; j < width; j += count) {
+            count = BLOCK_COUNT(width - j);
+
+            for (k = 0; k < row_count; k++) {
+                base_row = get_image_row(img_rgb, 0, i + k);
+                y_row = get_image_row(img_yuv420p, 0, i + k);
+
+                // Extract R, G and B values
+                unpack_rgb_block(&base_row[j * layout->pixel_size], layout, rgb_block[0], rgb_block[1], rgb_block[2],
+                                 rgb_block[3], count);
+                // Transform RGB->YUV (U and V values are only needed for the rows that are downsampled)
+                convert_color_block(get_rgb_to_yuv_matrix(img_yuv420p->colorspace), rgb_block[0], rgb_block[1],
+                                    rgb_block[2], &y_row[j], (k < chroma_rows) ? chroma_blocks[k][0] : NULL,
+                                    (k < chroma_rows) ? chroma_blocks[k][1] : NULL, count);
+            }
+
+            // Four Y values share one U and one V value
+            downsample_chroma_blocks(chroma_blocks, chroma_rows, img_yuv420p, i, j, count);
+        }
+    }
+
+    return 1;
+}
+
+
+static uint8_t convert_via_RGB24 (Image_t * base_img, Image_t * converted_img)
+{
+    return convert_via_format(base_img, converted_img, RGB24);
+}
+
+
+uint8_t convert_YUV420p_to_BGR24 (Image_t * img_yuv420p, Image_t * img_bgr24)
+{
+    return convert_YUV420p_to_rgb_layout(img_yuv420p, img_bgr24, BGR24);
+}
+
+
+uint8_t convert_YUV420p_to_RGBA8888 (Image_t * img_yuv420p, Image_t * img_rgba8888)
+{
+    return convert_YUV420p_to_rgb_layout(img_yuv420p, img_rgba8888, RGBA8888);
+}
+
+
+uint8_t convert_YUV420p_to_BGRA8888 (Image_t * img_yuv420p, Image_t * img_bgra8888)
+{
+    return convert_YUV420p_to_rgb_layout(img_yuv420p, img_bgra8888, BGRA8888);
+}
+
+
+uint8_t convert_YUV420p_to_XRGB8888 (Image_t * img_yuv420p, Image_t * img_xrgb8888)
+{
+    return convert_YUV420p_to_rgb_layout(img_yuv420p, img_xrgb8888, XRGB8888);
+}
+
+
+uint8_t convert_BGR24_to_YUV420p (Image_t * img_bgr24, Image_t * img_yuv420p)
+{
+    return convert_rgb_layout_to_YUV420p(img_bgr24, img_yuv420p, BGR24);
+}
+
+
+uint8_t convert_RGBA8888_to_YUV420p (Image_t * img_rgba8888, Image_t * img_yuv420p)
+{
+    return convert_rgb_layout_to_YUV420p(img_rgba8888, img_yuv420p, RGBA8888);
+}
+
+
+uint8_t convert_BGRA8888_to_YUV420p (Image_t * img_bgra8888, Image_t * img_yuv420p)
+{
+    return convert_rgb_layout_to_YUV420p(img_bgra8888, img_yuv420p, BGRA8888);
+}
+
+
+uint8_t convert_XRGB8888_to_YUV420p (Image_t * img_xrgb8888, Image_t * img_yuv420p)
+{
+    return convert_rgb_layout_to_YUV420p(img_xrgb8888, img_yuv420p, XRGB8888);
+}
+
+
+uint8_t convert_RGB24_to_BGR24 (Image_t * img_rgb24, Image_t * img_bgr24)
+{
+    if (!img_rgb24 || img_rgb24->format != RGB24) return 0;
+    if (!img_bgr24 || img_bgr24->format != BGR24) return 0;
+
+    return convert_rgb_layout(img_rgb24, img_bgr24);
+}
+
+
+uint8_t convert_RGB24_to_RGBA8888 (Image_t * img_rgb24, Image_t * img_rgba8888)
+{
+    if (!img_rgb24 || img_rgb24->format != RGB24) return 0;
+    if (!img_rgba8888 || img_rgba8888->format != RGBA8888) return 0;
+
+    return convert_rgb_layout(img_rgb24, img_rgba8888);
+}
+
+
+uint8_t convert_RGB24_to_BGRA8888 (Image_t * img_rgb24, Image_t * img_bgra8888)
+{
+    if (!img_rgb24 || img_rgb24->format != RGB24) return 0;
+    if (!img_bgra8888 || img_bgra8888->format != BGRA8888) return 0;
+
+    return convert_rgb_layout(img_rgb24, img_bgra8888);
+}
+
+
+uint8_t convert_RGB24_to_XRGB8888 (Image_t * img_rgb24, Image_t * img_xrgb8888)
+{
+    if (!img_rgb24 || img_rgb24->format != RGB24) return 0;
+    if (!img_xrgb8888 || img_xrgb8888->format != XRGB8888) return 0;
+
+    return convert_rgb_layout(img_rgb24, img_xrgb8888);
+}
+
+
+uint8_t convert_BGR24_to_RGB24 (Image_t * img_bgr24, Image_t * img_rgb24)
+{
+    if (!img_bgr24 || img_bgr24->format != BGR24) return 0;
+    if (!img_rgb24 || img_rgb24->format != RGB24) return 0;
+
+    return convert_rgb_layout(img_bgr24, img_rgb24);
+}
+
+
+uint8_t convert_RGBA8888_to_RGB24 (Image_t * img_rgba8888, Image_t * img_rgb24)
+{
+    if (!img_rgba8888 || img_rgba8888->format != RGBA8888) return 0;
+    if (!img_rgb24 || img_rgb24->format != RGB24) return 0;
+
+    return convert_rgb_layout(img_rgba8888, img_rgb24);
+}
+
+
+uint8_t convert_BGRA8888_to_RGB24 (Image_t * img_bgra8888, Image_t * img_rgb24)
+{
+    if (!img_bgra8888 || img_bgra8888->format != BGRA8888) return 0;
+    if (!img_rgb24 || img_rgb24->format != RGB24) return 0;
+
+    return convert_rgb_layout(img_bgra8888, img_rgb24);
+}
+
+
+uint8_t convert_XRGB8888_to_RGB24 (Image_t * img_xrgb8888, Image_t * img_rgb24)
+{
+    if (!img_xrgb8888 || img_xrgb8888->format != XRGB8888) return 0;
+    if (!img_rgb24 || img_rgb24->format != RGB24) return 0;
+
+    return convert_rgb_layout(img_xrgb8888, img_rgb24);
+}
+
+
 /* --------------------------------------------------------------------------------------------------------------------
  * COLOR TRANSFORMATION FUNCTIONS
  * --------------------------------------------------------------------------------------------------------------------
@@ -2166,34 +3925,6 @@ uint8_t rgb_to_yuv_v (uint8_t r, uint8_t g, uint8_t b)
 
 uint8_t y_to_ascii (uint8_t y)
 {
-    y = rescale_color(y, 0, 255, 0, 11);
-
-    // Assuming y is in the range [0, 11]
-    switch (y) {
-        case 11:
-            return '@';
-        case 10:
-            return '#';
-        case 9:
-            return '%';
-        case 8:
-            return '$';
-        case 7:
-            return '=';
-        case 6:
-            return '/';
-        case 5:
-            return ':';
-        case 4:
-            return '+';
-        case 3:
-            return '-';
-        case 2:
-            return ',';
-        case 1:
-            return '.';
-        default:
-        case 0:
-            return ' ';
-    }
+    // 12 levels of brightness, from darkest to brightest: " .,-+:/=$%#@"
+    return y_to_ascii_LUT[y];
 }
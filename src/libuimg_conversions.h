@@ -6,6 +6,16 @@
 
 
 #include "libuimg_img.h"
+#include "libuimg_simd.h"
+#include "libuimg_colorspace.h"
+
+
+/**
+ * @brief Conversion function Look-Up Table.
+ *
+ * Indexed by base format then converted format; entries on the diagonal are NULL. See `libuimg_conversions.c`.
+ */
+extern uint8_t (* conversion_function_LUT[ASCII][ASCII + 1]) (Image_t * img1, Image_t * img2);
 
 
 /**
@@ -21,6 +31,26 @@
 uint8_t convert_image (Image_t * base_img, Image_t * converted_img);
 
 
+#define FLIP_X_AXIS 0x01 /**< Flip the converted image along the X axis (top to bottom). */
+#define FLIP_Y_AXIS 0x02 /**< Flip the converted image along the Y axis (left to right). */
+
+
+/**
+ * @brief      Convert a base image to a different format and flip it, in a single pass.
+ *
+ * The result is identical to that of `convert_image()` followed by `flipX_image()` and/or `flipY_image()`, but the
+ * converted image is only gone through once: X flips are done by writing the rows in reverse order, and Y flips are
+ * done on every pair of rows right after it has been converted, while it is still in the cache.
+ *
+ * @param      base_img       The base image to be converted.
+ * @param      converted_img  The converted (and flipped) image.
+ * @param[in]  flip_flags     The axes to flip the converted image along (`FLIP_X_AXIS` and/or `FLIP_Y_AXIS`).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_and_flip_image (Image_t * base_img, Image_t * converted_img, uint8_t flip_flags);
+
+
 /**
  * @brief      Convert a base image to a different format.
  *
@@ -34,10 +64,26 @@ uint8_t convert_image (Image_t * base_img, Image_t * converted_img);
 Image_t * convert_dynamic_image (Image_t * base_img, PixelFormat_t format);
 
 
+/** @brief Quantization tables, equivalent to `rescale_color(value, 0, 255, 0, 2^n)` for n = 5, 6, 3 and 2 bits. */
+extern const uint8_t rescale_8bit_to_5bit_LUT[256];
+extern const uint8_t rescale_8bit_to_6bit_LUT[256];
+extern const uint8_t rescale_8bit_to_3bit_LUT[256];
+extern const uint8_t rescale_8bit_to_2bit_LUT[256];
+
+/** @brief Requantization tables for RGB565 -> RGB8, equivalent to `rescale_color(value, 0, 2^m, 0, 2^n)`. */
+extern const uint8_t rescale_5bit_to_3bit_LUT[32];
+extern const uint8_t rescale_6bit_to_3bit_LUT[64];
+extern const uint8_t rescale_5bit_to_2bit_LUT[32];
+
+/** @brief ASCII table (12 levels of brightness), equivalent to `y_to_ascii(value)`. */
+extern const uint8_t y_to_ascii_LUT[256];
+
+
 /**
  * @brief      Rescale a color value.
  * 
  * Maps a value from a range [old_min, old_max] to a range [new_min, new_max].
+ * This function uses floating point math; the conversions use the equivalent quantization tables instead.
  *
  * @param[in]  value    The value to rescale.
  * @param[in]  old_min  The old minimum.
@@ -348,6 +394,19 @@ uint8_t convert_YUV420p_to_RGB24 (Image_t * img_yuv420p, Image_t * img_rgb24);
  */
 uint8_t convert_YUV420p_to_RGB565 (Image_t * img_yuv420p, Image_t * img_rgb565);
 
+/**
+ * @brief      Convert a YUV420p image to an RGB565 image with big-endian pixels.
+ *
+ * The two bytes of every pixel are swapped with respect to `convert_YUV420p_to_RGB565()`, which is the byte order
+ * expected by most SPI displays; the converted image can therefore be sent to them as is.
+ *
+ * @param      img_yuv420p  The YUV420p image to convert.
+ * @param      img_rgb565   The converted (byte-swapped) RGB565 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUV420p_to_RGB565_byteswapped (Image_t * img_yuv420p, Image_t * img_rgb565);
+
 /**
  * @brief      Convert a YUV420p image to an RGB8 image.
  * 
@@ -729,5 +788,402 @@ uint8_t convert_GRAYSCALE_to_RGB8 (Image_t * img_grayscale, Image_t * img_rgb8);
  */
 uint8_t convert_GRAYSCALE_to_ASCII (Image_t * img_grayscale, Image_t * img_ascii);
 
+/**
+ * @brief      Convert a YUV420p image to an NV12 image.
+ *
+ * This conversion is lossless; the U and V planes are merged into a single plane of U, V pairs.
+ *
+ * @param      img_yuv420p  The YUV420p image to convert.
+ * @param      img_nv12     The converted NV12 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUV420p_to_NV12 (Image_t * img_yuv420p, Image_t * img_nv12);
+
+/**
+ * @brief      Convert a YUV420p image to an NV21 image.
+ *
+ * This conversion is lossless; the U and V planes are merged into a single plane of V, U pairs.
+ *
+ * @param      img_yuv420p  The YUV420p image to convert.
+ * @param      img_nv21     The converted NV21 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUV420p_to_NV21 (Image_t * img_yuv420p, Image_t * img_nv21);
+
+/**
+ * @brief      Convert an NV12 image to a YUV420p image.
+ *
+ * This conversion is lossless; the chroma plane is split into a U plane and a V plane.
+ *
+ * @param      img_nv12     The NV12 image to convert.
+ * @param      img_yuv420p  The converted YUV420p image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_NV12_to_YUV420p (Image_t * img_nv12, Image_t * img_yuv420p);
+
+/**
+ * @brief      Convert an NV21 image to a YUV420p image.
+ *
+ * This conversion is lossless; the chroma plane is split into a U plane and a V plane.
+ *
+ * @param      img_nv21     The NV21 image to convert.
+ * @param      img_yuv420p  The converted YUV420p image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_NV21_to_YUV420p (Image_t * img_nv21, Image_t * img_yuv420p);
+
+/**
+ * @brief      Convert an NV12 image to an NV21 image.
+ *
+ * This conversion is lossless; the U and V values of every chroma pair are swapped.
+ *
+ * @param      img_nv12  The NV12 image to convert.
+ * @param      img_nv21  The converted NV21 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_NV12_to_NV21 (Image_t * img_nv12, Image_t * img_nv21);
+
+/**
+ * @brief      Convert an NV21 image to an NV12 image.
+ *
+ * This conversion is lossless; the U and V values of every chroma pair are swapped.
+ *
+ * @param      img_nv21  The NV21 image to convert.
+ * @param      img_nv12  The converted NV12 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_NV21_to_NV12 (Image_t * img_nv21, Image_t * img_nv12);
+
+/**
+ * @brief      Convert an NV12 image to an RGB24 image.
+ *
+ * The result is identical to that of `convert_YUV420p_to_RGB24()` on the same samples.
+ *
+ * @param      img_nv12   The NV12 image to convert.
+ * @param      img_rgb24  The converted RGB24 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_NV12_to_RGB24 (Image_t * img_nv12, Image_t * img_rgb24);
+
+/**
+ * @brief      Convert an NV21 image to an RGB24 image.
+ *
+ * The result is identical to that of `convert_YUV420p_to_RGB24()` on the same samples.
+ *
+ * @param      img_nv21   The NV21 image to convert.
+ * @param      img_rgb24  The converted RGB24 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_NV21_to_RGB24 (Image_t * img_nv21, Image_t * img_rgb24);
+
+/**
+ * @brief      Convert a YUV444p image to a YUYV image.
+ *
+ * This conversion is lossy, since every two horizontally adjacent pixels share the same U and V values (those of the
+ * second pixel, as in `convert_YUV444p_to_YUV420p()`).
+ *
+ * @param      img_yuv444p  The YUV444p image to convert.
+ * @param      img_yuyv     The converted YUYV image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUV444p_to_YUYV (Image_t * img_yuv444p, Image_t * img_yuyv);
+
+/**
+ * @brief      Convert a YUV444p image to a UYVY image.
+ *
+ * This conversion is lossy, since every two horizontally adjacent pixels share the same U and V values (those of the
+ * second pixel, as in `convert_YUV444p_to_YUV420p()`).
+ *
+ * @param      img_yuv444p  The YUV444p image to convert.
+ * @param      img_uyvy     The converted UYVY image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUV444p_to_UYVY (Image_t * img_yuv444p, Image_t * img_uyvy);
+
+/**
+ * @brief      Convert a YUYV image to a YUV444p image.
+ *
+ * This conversion uses upsampling: the U and V values of every macropixel are duplicated.
+ *
+ * @param      img_yuyv     The YUYV image to convert.
+ * @param      img_yuv444p  The converted YUV444p image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUYV_to_YUV444p (Image_t * img_yuyv, Image_t * img_yuv444p);
+
+/**
+ * @brief      Convert a UYVY image to a YUV444p image.
+ *
+ * This conversion uses upsampling: the U and V values of every macropixel are duplicated.
+ *
+ * @param      img_uyvy     The UYVY image to convert.
+ * @param      img_yuv444p  The converted YUV444p image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_UYVY_to_YUV444p (Image_t * img_uyvy, Image_t * img_yuv444p);
+
+/**
+ * @brief      Convert a YUYV image to a UYVY image.
+ *
+ * This conversion is lossless; the two bytes of every pixel are swapped.
+ *
+ * @param      img_yuyv  The YUYV image to convert.
+ * @param      img_uyvy  The converted UYVY image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUYV_to_UYVY (Image_t * img_yuyv, Image_t * img_uyvy);
+
+/**
+ * @brief      Convert a UYVY image to a YUYV image.
+ *
+ * This conversion is lossless; the two bytes of every pixel are swapped.
+ *
+ * @param      img_uyvy  The UYVY image to convert.
+ * @param      img_yuyv  The converted YUYV image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_UYVY_to_YUYV (Image_t * img_uyvy, Image_t * img_yuyv);
+
+/**
+ * @brief      Convert a YUYV image to an RGB565 image.
+ *
+ * This conversion is lossy; the YUV->RGB conversion is nonlinear. Every row goes through the same kernel as
+ * `convert_YUV420p_to_RGB565()`, so the chroma contributions are computed once per macropixel.
+ *
+ * @param      img_yuyv    The YUYV image to convert.
+ * @param      img_rgb565  The converted RGB565 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUYV_to_RGB565 (Image_t * img_yuyv, Image_t * img_rgb565);
+
+/**
+ * @brief      Convert a UYVY image to an RGB565 image.
+ *
+ * This conversion is lossy; the YUV->RGB conversion is nonlinear. Every row goes through the same kernel as
+ * `convert_YUV420p_to_RGB565()`, so the chroma contributions are computed once per macropixel.
+ *
+ * @param      img_uyvy    The UYVY image to convert.
+ * @param      img_rgb565  The converted RGB565 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_UYVY_to_RGB565 (Image_t * img_uyvy, Image_t * img_rgb565);
+
+/**
+ * @brief      Convert a YUV420p image to a BGR24 image.
+ *
+ * This conversion is lossy; the YUV->RGB conversion is nonlinear. The result is identical to that of
+ * `convert_YUV420p_to_RGB24()` with the channels in another order.
+ *
+ * @param      img_yuv420p  The YUV420p image to convert.
+ * @param      img_bgr24    The converted BGR24 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUV420p_to_BGR24 (Image_t * img_yuv420p, Image_t * img_bgr24);
+
+/**
+ * @brief      Convert a YUV420p image to an RGBA8888 image.
+ *
+ * This conversion is lossy; the YUV->RGB conversion is nonlinear. The result is identical to that of
+ * `convert_YUV420p_to_RGB24()` with the channels in another order (pixels are opaque).
+ *
+ * @param      img_yuv420p   The YUV420p image to convert.
+ * @param      img_rgba8888  The converted RGBA8888 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUV420p_to_RGBA8888 (Image_t * img_yuv420p, Image_t * img_rgba8888);
+
+/**
+ * @brief      Convert a YUV420p image to a BGRA8888 image.
+ *
+ * This conversion is lossy; the YUV->RGB conversion is nonlinear. The result is identical to that of
+ * `convert_YUV420p_to_RGB24()` with the channels in another order (pixels are opaque).
+ *
+ * @param      img_yuv420p   The YUV420p image to convert.
+ * @param      img_bgra8888  The converted BGRA8888 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUV420p_to_BGRA8888 (Image_t * img_yuv420p, Image_t * img_bgra8888);
+
+/**
+ * @brief      Convert a YUV420p image to an XRGB8888 image.
+ *
+ * This conversion is lossy; the YUV->RGB conversion is nonlinear. The result is identical to that of
+ * `convert_YUV420p_to_RGB24()` with the channels in another order, and every pixel is written as a whole word
+ * (X is set to 0xff).
+ *
+ * @param      img_yuv420p   The YUV420p image to convert.
+ * @param      img_xrgb8888  The converted XRGB8888 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_YUV420p_to_XRGB8888 (Image_t * img_yuv420p, Image_t * img_xrgb8888);
+
+/**
+ * @brief      Convert a BGR24 image to a YUV420p image.
+ *
+ * This conversion is lossy; the RGB->YUV conversion is nonlinear. The result is identical to that of
+ * `convert_RGB24_to_YUV420p()` on the same R, G and B values.
+ *
+ * @param      img_bgr24    The BGR24 image to convert.
+ * @param      img_yuv420p  The converted YUV420p image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_BGR24_to_YUV420p (Image_t * img_bgr24, Image_t * img_yuv420p);
+
+/**
+ * @brief      Convert an RGBA8888 image to a YUV420p image.
+ *
+ * This conversion is lossy; the RGB->YUV conversion is nonlinear. The result is identical to that of
+ * `convert_RGB24_to_YUV420p()` on the same R, G and B values (alpha values are ignored).
+ *
+ * @param      img_rgba8888  The RGBA8888 image to convert.
+ * @param      img_yuv420p   The converted YUV420p image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_RGBA8888_to_YUV420p (Image_t * img_rgba8888, Image_t * img_yuv420p);
+
+/**
+ * @brief      Convert a BGRA8888 image to a YUV420p image.
+ *
+ * This conversion is lossy; the RGB->YUV conversion is nonlinear. The result is identical to that of
+ * `convert_RGB24_to_YUV420p()` on the same R, G and B values (alpha values are ignored).
+ *
+ * @param      img_bgra8888  The BGRA8888 image to convert.
+ * @param      img_yuv420p   The converted YUV420p image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_BGRA8888_to_YUV420p (Image_t * img_bgra8888, Image_t * img_yuv420p);
+
+/**
+ * @brief      Convert an XRGB8888 image to a YUV420p image.
+ *
+ * This conversion is lossy; the RGB->YUV conversion is nonlinear. The result is identical to that of
+ * `convert_RGB24_to_YUV420p()` on the same R, G and B values.
+ *
+ * @param      img_xrgb8888  The XRGB8888 image to convert.
+ * @param      img_yuv420p   The converted YUV420p image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_XRGB8888_to_YUV420p (Image_t * img_xrgb8888, Image_t * img_yuv420p);
+
+/**
+ * @brief      Convert an RGB24 image to a BGR24 image.
+ *
+ * This conversion is lossless; the R and B values of every pixel are swapped.
+ *
+ * @param      img_rgb24  The RGB24 image to convert.
+ * @param      img_bgr24  The converted BGR24 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_RGB24_to_BGR24 (Image_t * img_rgb24, Image_t * img_bgr24);
+
+/**
+ * @brief      Convert an RGB24 image to an RGBA8888 image.
+ *
+ * This conversion is lossless; every pixel is made opaque.
+ *
+ * @param      img_rgb24     The RGB24 image to convert.
+ * @param      img_rgba8888  The converted RGBA8888 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_RGB24_to_RGBA8888 (Image_t * img_rgb24, Image_t * img_rgba8888);
+
+/**
+ * @brief      Convert an RGB24 image to a BGRA8888 image.
+ *
+ * This conversion is lossless; every pixel is made opaque.
+ *
+ * @param      img_rgb24     The RGB24 image to convert.
+ * @param      img_bgra8888  The converted BGRA8888 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_RGB24_to_BGRA8888 (Image_t * img_rgb24, Image_t * img_bgra8888);
+
+/**
+ * @brief      Convert an RGB24 image to an XRGB8888 image.
+ *
+ * This conversion is lossless; every pixel is made opaque (X is set to 0xff).
+ *
+ * @param      img_rgb24     The RGB24 image to convert.
+ * @param      img_xrgb8888  The converted XRGB8888 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_RGB24_to_XRGB8888 (Image_t * img_rgb24, Image_t * img_xrgb8888);
+
+/**
+ * @brief      Convert a BGR24 image to an RGB24 image.
+ *
+ * This conversion is lossless; the R and B values of every pixel are swapped.
+ *
+ * @param      img_bgr24  The BGR24 image to convert.
+ * @param      img_rgb24  The converted RGB24 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_BGR24_to_RGB24 (Image_t * img_bgr24, Image_t * img_rgb24);
+
+/**
+ * @brief      Convert an RGBA8888 image to an RGB24 image.
+ *
+ * This conversion drops the alpha values (pixels are not blended with any background).
+ *
+ * @param      img_rgba8888  The RGBA8888 image to convert.
+ * @param      img_rgb24     The converted RGB24 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_RGBA8888_to_RGB24 (Image_t * img_rgba8888, Image_t * img_rgb24);
+
+/**
+ * @brief      Convert a BGRA8888 image to an RGB24 image.
+ *
+ * This conversion drops the alpha values (pixels are not blended with any background).
+ *
+ * @param      img_bgra8888  The BGRA8888 image to convert.
+ * @param      img_rgb24     The converted RGB24 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_BGRA8888_to_RGB24 (Image_t * img_bgra8888, Image_t * img_rgb24);
+
+/**
+ * @brief      Convert an XRGB8888 image to an RGB24 image.
+ *
+ * This conversion is lossless; the unused byte of every pixel is dropped.
+ *
+ * @param      img_xrgb8888  The XRGB8888 image to convert.
+ * @param      img_rgb24     The converted RGB24 image.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_XRGB8888_to_RGB24 (Image_t * img_xrgb8888, Image_t * img_rgb24);
+
 
 #endif
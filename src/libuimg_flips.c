@@ -1,5 +1,7 @@
 #include "libuimg_flips.h"
 
+#include <string.h>
+
 
 /**
  * @brief       Flip function Look-Up Table.
@@ -17,6 +19,14 @@ uint8_t (* flip_function_LUT[2][ASCII + 1]) (Image_t * img) = {
         flipX_RGB565,
         flipX_RGB8,
         flipX_GRAYSCALE,
+        flipX_NV12,
+        flipX_NV21,
+        flipX_YUYV,
+        flipX_UYVY,
+        flipX_BGR24,
+        flipX_RGBA8888,
+        flipX_BGRA8888,
+        flipX_XRGB8888,
         flipX_ASCII
     },
     {
@@ -27,6 +37,14 @@ uint8_t (* flip_function_LUT[2][ASCII + 1]) (Image_t * img) = {
         flipY_RGB565,
         flipY_RGB8,
         flipY_GRAYSCALE,
+        flipY_NV12,
+        flipY_NV21,
+        flipY_YUYV,
+        flipY_UYVY,
+        flipY_BGR24,
+        flipY_RGBA8888,
+        flipY_BGRA8888,
+        flipY_XRGB8888,
         flipY_ASCII
     }
 };
@@ -64,112 +82,21 @@ uint8_t flipX_YUV444 (Image_t * img_yuv444)
 
 uint8_t flipX_YUV444p (Image_t * img_yuv444p)
 {
-    uint32_t i = 0;
-    uint32_t j = 0;
-    uint16_t width = 0;
-    uint16_t height = 0;
-    uint8_t temp_data = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
-    uint16_t loop_height = 0;
-    uint32_t row_offset_top = 0;
-    uint32_t row_offset_bottom = 0;
-
     if (!img_yuv444p) return 0;
     if (img_yuv444p->format != YUV444p) return 0;
 
-    width = img_yuv444p->width;
-    height = img_yuv444p->height;
-    loop_height = height / 2;
-
-    u_offset = width * height;
-    v_offset = u_offset * 2;
-
-    for (i = 0; i < loop_height; i++) {
-        row_offset_top = i * width;
-        row_offset_bottom = (height - 1 - i) * width;
-
-        for (j = 0; j < width; j++) {
-            // Flip Y component
-            temp_data = img_yuv444p->data[row_offset_top + j];
-            img_yuv444p->data[row_offset_top + j] = img_yuv444p->data[row_offset_bottom + j];
-            img_yuv444p->data[row_offset_bottom + j] = temp_data;
-
-            // Flip U component
-            temp_data = img_yuv444p->data[u_offset + row_offset_top + j];
-            img_yuv444p->data[u_offset + row_offset_top + j] = img_yuv444p->data[u_offset + row_offset_bottom + j];
-            img_yuv444p->data[u_offset + row_offset_bottom + j] = temp_data;
-
-            // Flip V component
-            temp_data = img_yuv444p->data[v_offset + row_offset_top + j];
-            img_yuv444p->data[v_offset + row_offset_top + j] = img_yuv444p->data[v_offset + row_offset_bottom + j];
-            img_yuv444p->data[v_offset + row_offset_bottom + j] = temp_data;
-        }
-    }
-
-    return 1;
+    // Flip Y, U and V components
+    return flipX_plane(img_yuv444p, 0) && flipX_plane(img_yuv444p, 1) && flipX_plane(img_yuv444p, 2);
 }
 
 
 uint8_t flipX_YUV420p (Image_t * img_yuv420p)
 {
-    uint32_t i = 0;
-    uint32_t j = 0;
-    uint16_t width = 0;
-    uint16_t height = 0;
-    uint8_t temp_data = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
-    uint16_t uv_width = 0;
-    uint32_t row_offset_up_y = 0;
-    uint32_t row_offset_bottom_y = 0;
-    uint32_t row_offset_up_uv = 0;
-    uint32_t row_offset_bottom_uv = 0;
-    uint16_t loop_height = 0;
-
     if (!img_yuv420p) return 0;
     if (img_yuv420p->format != YUV420p) return 0;
 
-    width = img_yuv420p->width;
-    height = img_yuv420p->height;
-    loop_height = UROUND_UP(height / 2);
-
-    u_offset = width * height;
-    uv_width = UROUND_UP(width / 2);
-    v_offset = u_offset + uv_width * UROUND_UP(height / 2);
-
-    for (i = 0; i < loop_height; i++) {
-        row_offset_up_y = i * width;
-        row_offset_bottom_y = (height - 1 - i) * width;
-        row_offset_up_uv = i / 2 * uv_width;
-        row_offset_bottom_uv = (UROUND_UP(height / 2) - 1 - i / 2) * uv_width;
- 
-        for (j = 0; j < width; j++) {
-            // Flip Y component
-            temp_data = img_yuv420p->data[row_offset_up_y + j];
-            img_yuv420p->data[row_offset_up_y + j] = img_yuv420p->data[row_offset_bottom_y + j];
-            img_yuv420p->data[row_offset_bottom_y + j] = temp_data;
-
-            // Only flip when i and j are even, otherwise the U, V elements will be flipped twice
-            if (i % 2 == 0 && j % 2 == 0) {
-                // Flip U component
-                temp_data = img_yuv420p->data[u_offset + row_offset_up_uv + j / 2];
-                img_yuv420p->data[u_offset + row_offset_up_uv + j / 2] = img_yuv420p->data[u_offset +
-                                                                                             row_offset_bottom_uv +
-                                                                                             j / 2];
-                img_yuv420p->data[u_offset + row_offset_bottom_uv + j / 2] = temp_data;
-
-                // Flip V component
-                temp_data = img_yuv420p->data[v_offset + row_offset_up_uv + j / 2];
-                img_yuv420p->data[v_offset + row_offset_up_uv + j / 2] = img_yuv420p->data[v_offset +
-                                                                                             row_offset_bottom_uv +
-                                                                                             j / 2];
-                img_yuv420p->data[v_offset + row_offset_bottom_uv + j / 2] = temp_data;
-            }
-        }
-    }
-
-    return 1;
+    // Flip Y, U and V components (the U and V planes have half as many rows)
+    return flipX_plane(img_yuv420p, 0) && flipX_plane(img_yuv420p, 1) && flipX_plane(img_yuv420p, 2);
 }
 
 
@@ -184,41 +111,10 @@ uint8_t flipX_RGB24 (Image_t * img_rgb24)
 
 uint8_t flipX_RGB565 (Image_t * img_rgb565)
 {
-    uint32_t i = 0;
-    uint32_t j = 0;
-    uint16_t width = 0;
-    uint16_t height = 0;
-    uint16_t loop_width = 0;
-    uint16_t loop_height = 0;
-    uint8_t temp_data = 0;
-    uint32_t row_offset_top = 0;
-    uint32_t row_offset_bottom = 0;
-
     if (!img_rgb565) return 0;
     if (img_rgb565->format != RGB565) return 0;
 
-    width = img_rgb565->width;
-    height = img_rgb565->height;
-    loop_height = height;
-    loop_width = width * 2;
-
-    for (i = 0; i < loop_height; i += 2) {
-        row_offset_top = i * width;
-        row_offset_bottom = ((height - 1) * 2 - i) * width;
-
-        for (j = 0; j < loop_width; j += 2) {
-            // Flip 2 bytes at a time
-            temp_data = img_rgb565->data[row_offset_top + j];
-            img_rgb565->data[row_offset_top + j] = img_rgb565->data[row_offset_bottom + j];
-            img_rgb565->data[row_offset_bottom + j] = temp_data;
-
-            temp_data = img_rgb565->data[row_offset_top + j + 1];
-            img_rgb565->data[row_offset_top + j + 1] = img_rgb565->data[row_offset_bottom + j + 1];
-            img_rgb565->data[row_offset_bottom + j + 1] = temp_data;
-        }
-    }
-
-    return 1;
+    return flipX_plane(img_rgb565, 0);
 }
 
 
@@ -240,6 +136,80 @@ uint8_t flipX_GRAYSCALE (Image_t * img_grayscale)
 }
 
 
+uint8_t flipX_NV12 (Image_t * img_nv12)
+{
+    if (!img_nv12) return 0;
+    if (img_nv12->format != NV12) return 0;
+
+    // Flip Y and UV components (the UV plane has half as many rows)
+    return flipX_plane(img_nv12, 0) && flipX_plane(img_nv12, 1);
+}
+
+
+uint8_t flipX_NV21 (Image_t * img_nv21)
+{
+    if (!img_nv21) return 0;
+    if (img_nv21->format != NV21) return 0;
+
+    // Flip Y and VU components (the VU plane has half as many rows)
+    return flipX_plane(img_nv21, 0) && flipX_plane(img_nv21, 1);
+}
+
+
+uint8_t flipX_YUYV (Image_t * img_yuyv)
+{
+    if (!img_yuyv) return 0;
+    if (img_yuyv->format != YUYV) return 0;
+
+    return flipX_plane(img_yuyv, 0);
+}
+
+
+uint8_t flipX_UYVY (Image_t * img_uyvy)
+{
+    if (!img_uyvy) return 0;
+    if (img_uyvy->format != UYVY) return 0;
+
+    return flipX_plane(img_uyvy, 0);
+}
+
+
+uint8_t flipX_BGR24 (Image_t * img_bgr24)
+{
+    if (!img_bgr24) return 0;
+    if (img_bgr24->format != BGR24) return 0;
+
+    return flipX_24bpp(img_bgr24);
+}
+
+
+uint8_t flipX_RGBA8888 (Image_t * img_rgba8888)
+{
+    if (!img_rgba8888) return 0;
+    if (img_rgba8888->format != RGBA8888) return 0;
+
+    return flipX_32bpp(img_rgba8888);
+}
+
+
+uint8_t flipX_BGRA8888 (Image_t * img_bgra8888)
+{
+    if (!img_bgra8888) return 0;
+    if (img_bgra8888->format != BGRA8888) return 0;
+
+    return flipX_32bpp(img_bgra8888);
+}
+
+
+uint8_t flipX_XRGB8888 (Image_t * img_xrgb8888)
+{
+    if (!img_xrgb8888) return 0;
+    if (img_xrgb8888->format != XRGB8888) return 0;
+
+    return flipX_32bpp(img_xrgb8888);
+}
+
+
 uint8_t flipX_ASCII (Image_t * img_ascii)
 {
     if (!img_ascii) return 0;
@@ -260,112 +230,21 @@ uint8_t flipY_YUV444 (Image_t * img_yuv444)
 
 uint8_t flipY_YUV444p (Image_t * img_yuv444p)
 {
-    uint32_t i = 0;
-    uint32_t j = 0;
-    uint16_t width = 0;
-    uint16_t height = 0;
-    uint8_t temp_data = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
-    uint16_t loop_width = 0;
-    uint32_t row_offset_left = 0;
-    uint32_t row_offset_right = 0;
-
     if (!img_yuv444p) return 0;
     if (img_yuv444p->format != YUV444p) return 0;
 
-    width = img_yuv444p->width;
-    height = img_yuv444p->height;
-    loop_width = width / 2;
-
-    u_offset = width * height;
-    v_offset = u_offset * 2;
-
-    for (i = 0; i < height; i++) {
-        row_offset_left = i * width;
-        row_offset_right = (i + 1) * width - 1;
-
-        for (j = 0; j < loop_width; j++) {
-            // Flip Y component
-            temp_data = img_yuv444p->data[row_offset_left + j];
-            img_yuv444p->data[row_offset_left + j] = img_yuv444p->data[row_offset_right - j];
-            img_yuv444p->data[row_offset_right - j] = temp_data;
-
-            // Flip U component
-            temp_data = img_yuv444p->data[u_offset + row_offset_left + j];
-            img_yuv444p->data[u_offset + row_offset_left + j] = img_yuv444p->data[u_offset + row_offset_right - j];
-            img_yuv444p->data[u_offset + row_offset_right - j] = temp_data;
-
-            // Flip V component
-            temp_data = img_yuv444p->data[v_offset + row_offset_left + j];
-            img_yuv444p->data[v_offset + row_offset_left + j] = img_yuv444p->data[v_offset + row_offset_right - j];
-            img_yuv444p->data[v_offset + row_offset_right - j] = temp_data;
-        }
-    }
-
-    return 1;
+    // Flip Y, U and V components
+    return flipY_plane(img_yuv444p, 0, 1) && flipY_plane(img_yuv444p, 1, 1) && flipY_plane(img_yuv444p, 2, 1);
 }
 
 
 uint8_t flipY_YUV420p (Image_t * img_yuv420p)
 {
-    uint32_t i = 0;
-    uint32_t j = 0;
-    uint16_t width = 0;
-    uint16_t height = 0;
-    uint8_t temp_data = 0;
-    uint32_t u_offset = 0;
-    uint32_t v_offset = 0;
-    uint16_t uv_width = 0;
-    uint32_t row_offset_left_y = 0;
-    uint32_t row_offset_right_y = 0;
-    uint32_t row_offset_left_uv = 0;
-    uint32_t row_offset_right_uv = 0;
-    uint16_t loop_width = 0;
-
     if (!img_yuv420p) return 0;
     if (img_yuv420p->format != YUV420p) return 0;
 
-    width = img_yuv420p->width;
-    height = img_yuv420p->height;
-    loop_width = UROUND_UP(width / 2);
-
-    u_offset = width * height;
-    uv_width = UROUND_UP(width / 2);
-    v_offset = u_offset + uv_width * UROUND_UP(height / 2);
-
-    for (i = 0; i < height; i++) {
-        row_offset_left_y = i * width;
-        row_offset_right_y = (i + 1) * width - 1;
-        row_offset_left_uv = i / 2 * uv_width;
-        row_offset_right_uv = (i / 2 + 1) * uv_width - 1;
- 
-        for (j = 0; j < loop_width; j++) {
-            // Flip Y component
-            temp_data = img_yuv420p->data[row_offset_left_y + j];
-            img_yuv420p->data[row_offset_left_y + j] = img_yuv420p->data[row_offset_right_y - j];
-            img_yuv420p->data[row_offset_right_y - j] = temp_data;
-
-            // Only flip when i and j are even, otherwise the U, V elements will be flipped twice
-            if (i % 2 == 0 && j % 2 == 0) {
-                // Flip U component
-                temp_data = img_yuv420p->data[u_offset + row_offset_left_uv + j / 2];
-                img_yuv420p->data[u_offset + row_offset_left_uv + j / 2] = img_yuv420p->data[u_offset +
-                                                                                             row_offset_right_uv -
-                                                                                             j / 2];
-                img_yuv420p->data[u_offset + row_offset_right_uv - j / 2] = temp_data;
-
-                // Flip V component
-                temp_data = img_yuv420p->data[v_offset + row_offset_left_uv + j / 2];
-                img_yuv420p->data[v_offset + row_offset_left_uv + j / 2] = img_yuv420p->data[v_offset +
-                                                                                             row_offset_right_uv -
-                                                                                             j / 2];
-                img_yuv420p->data[v_offset + row_offset_right_uv - j / 2] = temp_data;
-            }
-        }
-    }
-
-    return 1;
+    // Flip Y, U and V components (the U and V planes have half as many columns)
+    return flipY_plane(img_yuv420p, 0, 1) && flipY_plane(img_yuv420p, 1, 1) && flipY_plane(img_yuv420p, 2, 1);
 }
 
 
@@ -380,41 +259,11 @@ uint8_t flipY_RGB24 (Image_t * img_rgb24)
 
 uint8_t flipY_RGB565 (Image_t * img_rgb565)
 {
-    uint32_t i = 0;
-    uint32_t j = 0;
-    uint16_t width = 0;
-    uint16_t height = 0;
-    uint16_t loop_width = 0;
-    uint16_t loop_height = 0;
-    uint8_t temp_data = 0;
-    uint32_t row_offset_left = 0;
-    uint32_t row_offset_right = 0;
-
     if (!img_rgb565) return 0;
     if (img_rgb565->format != RGB565) return 0;
 
-    width = img_rgb565->width;
-    height = img_rgb565->height;
-    loop_height = height * 2;
-    loop_width = width;
-
-    for (i = 0; i < loop_height; i += 2) {
-        row_offset_left = i * width;
-        row_offset_right = (i + 2) * width - 1;
-
-        for (j = 0; j < loop_width; j += 2) {
-            // Flip 2 bytes at a time
-            temp_data = img_rgb565->data[row_offset_left + j];
-            img_rgb565->data[row_offset_left + j] = img_rgb565->data[row_offset_right - 1 - j];
-            img_rgb565->data[row_offset_right - 1 - j] = temp_data;
-
-            temp_data = img_rgb565->data[row_offset_left + j + 1];
-            img_rgb565->data[row_offset_left + j + 1] = img_rgb565->data[row_offset_right - j];
-            img_rgb565->data[row_offset_right - j] = temp_data;
-        }
-    }
-
-    return 1;
+    // Flip 2 bytes at a time
+    return flipY_plane(img_rgb565, 0, 2);
 }
 
 
@@ -436,6 +285,80 @@ uint8_t flipY_GRAYSCALE (Image_t * img_grayscale)
 }
 
 
+uint8_t flipY_NV12 (Image_t * img_nv12)
+{
+    if (!img_nv12) return 0;
+    if (img_nv12->format != NV12) return 0;
+
+    // Flip Y components, then U, V pairs 2 bytes at a time
+    return flipY_plane(img_nv12, 0, 1) && flipY_plane(img_nv12, 1, 2);
+}
+
+
+uint8_t flipY_NV21 (Image_t * img_nv21)
+{
+    if (!img_nv21) return 0;
+    if (img_nv21->format != NV21) return 0;
+
+    // Flip Y components, then V, U pairs 2 bytes at a time
+    return flipY_plane(img_nv21, 0, 1) && flipY_plane(img_nv21, 1, 2);
+}
+
+
+uint8_t flipY_YUYV (Image_t * img_yuyv)
+{
+    if (!img_yuyv) return 0;
+    if (img_yuyv->format != YUYV) return 0;
+
+    return flipY_422(img_yuyv, 0);
+}
+
+
+uint8_t flipY_UYVY (Image_t * img_uyvy)
+{
+    if (!img_uyvy) return 0;
+    if (img_uyvy->format != UYVY) return 0;
+
+    return flipY_422(img_uyvy, 1);
+}
+
+
+uint8_t flipY_BGR24 (Image_t * img_bgr24)
+{
+    if (!img_bgr24) return 0;
+    if (img_bgr24->format != BGR24) return 0;
+
+    return flipY_24bpp(img_bgr24);
+}
+
+
+uint8_t flipY_RGBA8888 (Image_t * img_rgba8888)
+{
+    if (!img_rgba8888) return 0;
+    if (img_rgba8888->format != RGBA8888) return 0;
+
+    return flipY_32bpp(img_rgba8888);
+}
+
+
+uint8_t flipY_BGRA8888 (Image_t * img_bgra8888)
+{
+    if (!img_bgra8888) return 0;
+    if (img_bgra8888->format != BGRA8888) return 0;
+
+    return flipY_32bpp(img_bgra8888);
+}
+
+
+uint8_t flipY_XRGB8888 (Image_t * img_xrgb8888)
+{
+    if (!img_xrgb8888) return 0;
+    if (img_xrgb8888->format != XRGB8888) return 0;
+
+    return flipY_32bpp(img_xrgb8888);
+}
+
+
 uint8_t flipY_ASCII (Image_t * img_ascii)
 {
     if (!img_ascii) return 0;
@@ -450,44 +373,41 @@ uint8_t flipY_ASCII (Image_t * img_ascii)
  * --------------------------------------------------------------------------------------------------------------------
  */
 
-uint8_t flipX_24bpp (Image_t * img)
+uint8_t flipX_plane (Image_t * img, uint8_t plane)
+{
+    if (!img) return 0;
+
+    return flipX_plane_rows(img, plane, 0, get_image_plane_height(img->height, img->format, plane) / 2);
+}
+
+
+uint8_t flipX_plane_rows (Image_t * img, uint8_t plane, uint16_t first_row, uint16_t last_row)
 {
     uint32_t i = 0;
     uint32_t j = 0;
-    uint16_t width = 0;
     uint16_t height = 0;
-    uint32_t loop_width = 0;
-    uint32_t loop_height = 0;
+    uint32_t row_size = 0;
     uint8_t temp_data = 0;
-    uint32_t row_offset_top = 0;
-    uint32_t row_offset_bottom = 0;
+    uint8_t * row_top = NULL;
+    uint8_t * row_bottom = NULL;
 
     if (!img) return 0;
+    if (plane >= get_image_plane_count(img->format)) return 0;
 
-    width = img->width;
-    height = img->height;
-    loop_width = width * 3;
-    loop_height = (height / 2) * 3;
-
-    for (i = 0; i < loop_height; i += 3) {
-        row_offset_top = i * width;
-        row_offset_bottom = ((height - 1) * 3 - i) * width;
-
-        for (j = 0; j < loop_width; j += 3) {
-            // Flip 1st channel
-            temp_data = img->data[row_offset_top + j];
-            img->data[row_offset_top + j] = img->data[row_offset_bottom + j];
-            img->data[row_offset_bottom + j] = temp_data;
-
-            // Flip 2nd channel
-            temp_data = img->data[row_offset_top + j + 1];
-            img->data[row_offset_top + j + 1] = img->data[row_offset_bottom + j + 1];
-            img->data[row_offset_bottom + j + 1] = temp_data;
-
-            // Flip 3rd channel
-            temp_data = img->data[row_offset_top + j + 2];
-            img->data[row_offset_top + j + 2] = img->data[row_offset_bottom + j + 2];
-            img->data[row_offset_bottom + j + 2] = temp_data;
+    height = get_image_plane_height(img->height, img->format, plane);
+    row_size = get_image_row_size(img->width, img->format, plane);
+
+    if (last_row > height / 2) return 0;
+
+    for (i = first_row; i < last_row; i++) {
+        row_top = get_image_row(img, plane, i);
+        row_bottom = get_image_row(img, plane, height - 1 - i);
+
+        for (j = 0; j < row_size; j++) {
+            // Flip elements of row
+            temp_data = row_top[j];
+            row_top[j] = row_bottom[j];
+            row_bottom[j] = temp_data;
         }
     }
 
@@ -495,32 +415,33 @@ uint8_t flipX_24bpp (Image_t * img)
 }
 
 
-uint8_t flipX_8bpp (Image_t * img)
+uint8_t flipY_plane (Image_t * img, uint8_t plane, uint8_t pixel_size)
 {
     uint32_t i = 0;
     uint32_t j = 0;
-    uint16_t width = 0;
+    uint32_t k = 0;
     uint16_t height = 0;
-    uint16_t loop_height = 0;
+    uint32_t row_size = 0;
     uint8_t temp_data = 0;
-    uint32_t row_offset_top = 0;
-    uint32_t row_offset_bottom = 0;
+    uint8_t * row = NULL;
 
     if (!img) return 0;
+    if (plane >= get_image_plane_count(img->format)) return 0;
+    if (!pixel_size) return 0;
 
-    width = img->width;
-    height = img->height;
-    loop_height = height / 2;
-
-    for (i = 0; i < loop_height; i++) {
-        row_offset_top = i * width;
-        row_offset_bottom = (height - 1 - i) * width;
+    height = get_image_plane_height(img->height, img->format, plane);
+    row_size = get_image_row_size(img->width, img->format, plane);
 
-        for (j = 0; j < width; j++) {
-            // Flip elements of row
-            temp_data = img->data[row_offset_top + j];
-            img->data[row_offset_top + j] = img->data[row_offset_bottom + j];
-            img->data[row_offset_bottom + j] = temp_data;
+    for (i = 0; i < height; i++) {
+        row = get_image_row(img, plane, i);
+
+        // j is the offset of the left pixel, row_size - pixel_size - j the offset of the right one
+        for (j = 0; j < (row_size / pixel_size / 2) * pixel_size; j += pixel_size) {
+            for (k = 0; k < pixel_size; k++) {
+                temp_data = row[j + k];
+                row[j + k] = row[row_size - pixel_size - j + k];
+                row[row_size - pixel_size - j + k] = temp_data;
+            }
         }
     }
 
@@ -528,44 +449,47 @@ uint8_t flipX_8bpp (Image_t * img)
 }
 
 
-uint8_t flipY_24bpp (Image_t * img)
+uint8_t flipY_422 (Image_t * img, uint8_t luma_offset)
 {
     uint32_t i = 0;
     uint32_t j = 0;
     uint16_t width = 0;
     uint16_t height = 0;
-    uint32_t loop_width = 0;
-    uint32_t loop_height = 0;
+    uint32_t macropixels = 0;
+    uint32_t left = 0;
+    uint32_t right = 0;
     uint8_t temp_data = 0;
-    uint32_t row_offset_left = 0;
-    uint32_t row_offset_right = 0;
+    uint8_t * row = NULL;
 
     if (!img) return 0;
+    if (luma_offset > 1) return 0;
 
     width = img->width;
     height = img->height;
-    loop_width = (width / 2) * 3;
-    loop_height = height * 3;
-
-    for (i = 0; i < loop_height; i += 3) {
-        row_offset_left = i * width;
-        row_offset_right = (i + 3) * width - 1;
-
-        for (j = 0; j < loop_width; j += 3) {
-            // Flip 1st channel
-            temp_data = img->data[row_offset_left + j];
-            img->data[row_offset_left + j] = img->data[row_offset_right - 2 - j];
-            img->data[row_offset_right - 2 - j] = temp_data;
-
-            // Flip 2nd channel
-            temp_data = img->data[row_offset_left + j + 1];
-            img->data[row_offset_left + j + 1] = img->data[row_offset_right - 1 - j];
-            img->data[row_offset_right - 1 - j] = temp_data;
-
-            // Flip 3rd channel
-            temp_data = img->data[row_offset_left + j + 2];
-            img->data[row_offset_left + j + 2] = img->data[row_offset_right - j];
-            img->data[row_offset_right - j] = temp_data;
+    macropixels = UROUND_UP(width / 2);
+
+    for (i = 0; i < height; i++) {
+        row = get_image_row(img, 0, i);
+
+        // Y values are mirrored one pixel at a time (the padding Y value of odd-width rows is left in place)
+        for (j = 0; j < width / 2; j++) {
+            left = j * 2 + luma_offset;
+            right = (width - 1 - j) * 2 + luma_offset;
+            temp_data = row[left];
+            row[left] = row[right];
+            row[right] = temp_data;
+        }
+
+        // U and V values are mirrored one macropixel at a time, as with the chroma planes of YUV420p
+        for (j = 0; j < macropixels / 2; j++) {
+            left = j * 4 + 1 - luma_offset;
+            right = (macropixels - 1 - j) * 4 + 1 - luma_offset;
+            temp_data = row[left];
+            row[left] = row[right];
+            row[right] = temp_data;
+            temp_data = row[left + 2];
+            row[left + 2] = row[right + 2];
+            row[right + 2] = temp_data;
         }
     }
 
@@ -573,34 +497,60 @@ uint8_t flipY_24bpp (Image_t * img)
 }
 
 
-uint8_t flipY_8bpp (Image_t * img)
+uint8_t flipX_32bpp (Image_t * img)
+{
+    return flipX_plane(img, 0);
+}
+
+
+uint8_t flipX_24bpp (Image_t * img)
+{
+    return flipX_plane(img, 0);
+}
+
+
+uint8_t flipX_8bpp (Image_t * img)
+{
+    return flipX_plane(img, 0);
+}
+
+
+uint8_t flipY_32bpp (Image_t * img)
 {
     uint32_t i = 0;
     uint32_t j = 0;
     uint16_t width = 0;
-    uint16_t height = 0;
-    uint16_t loop_width = 0;
-    uint8_t temp_data = 0;
-    uint32_t row_offset_left = 0;
-    uint32_t row_offset_right = 0;
+    uint32_t left_pixel = 0;
+    uint32_t right_pixel = 0;
+    uint8_t * row = NULL;
 
     if (!img) return 0;
 
     width = img->width;
-    height = img->height;
-    loop_width = width / 2;
 
-    for (i = 0; i < height; i++) {
-        row_offset_left = i * width;
-        row_offset_right = (i + 1) * width - 1;
+    for (i = 0; i < img->height; i++) {
+        row = get_image_row(img, 0, i);
 
-        for (j = 0; j < loop_width; j++) {
-            // Flip elements of row
-            temp_data = img->data[row_offset_left + j];
-            img->data[row_offset_left + j] = img->data[row_offset_right - j];
-            img->data[row_offset_right - j] = temp_data;
+        // Pixels are swapped as whole words (rows are not necessarily aligned, hence the copies)
+        for (j = 0; j < width / 2; j++) {
+            memcpy(&left_pixel, &row[j * 4], 4);
+            memcpy(&right_pixel, &row[(width - 1 - j) * 4], 4);
+            memcpy(&row[j * 4], &right_pixel, 4);
+            memcpy(&row[(width - 1 - j) * 4], &left_pixel, 4);
         }
     }
 
     return 1;
 }
+
+
+uint8_t flipY_24bpp (Image_t * img)
+{
+    return flipY_plane(img, 0, 3);
+}
+
+
+uint8_t flipY_8bpp (Image_t * img)
+{
+    return flipY_plane(img, 0, 1);
+}
@@ -5,6 +5,14 @@
 #include "libuimg_img.h"
 
 
+/**
+ * @brief Flip function Look-Up Table.
+ *
+ * Indexed by axis (0 = X, 1 = Y) then image format. See `libuimg_flips.c`.
+ */
+extern uint8_t (* flip_function_LUT[2][ASCII + 1]) (Image_t * img);
+
+
 /**
  * @brief      Flip an image along the Y axis.
  *
@@ -78,6 +86,78 @@ uint8_t flipX_RGB8 (Image_t * img_rgb8);
  */
 uint8_t flipX_GRAYSCALE (Image_t * img_grayscale);
 
+/**
+ * @brief      Flip an NV12 image along the X axis.
+ *
+ * @param      img_nv12  The NV12 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_NV12 (Image_t * img_nv12);
+
+/**
+ * @brief      Flip an NV21 image along the X axis.
+ *
+ * @param      img_nv21  The NV21 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_NV21 (Image_t * img_nv21);
+
+/**
+ * @brief      Flip a YUYV image along the X axis.
+ *
+ * @param      img_yuyv  The YUYV image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_YUYV (Image_t * img_yuyv);
+
+/**
+ * @brief      Flip a UYVY image along the X axis.
+ *
+ * @param      img_uyvy  The UYVY image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_UYVY (Image_t * img_uyvy);
+
+/**
+ * @brief      Flip a BGR24 image along the X axis.
+ *
+ * @param      img_bgr24  The BGR24 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_BGR24 (Image_t * img_bgr24);
+
+/**
+ * @brief      Flip an RGBA8888 image along the X axis.
+ *
+ * @param      img_rgba8888  The RGBA8888 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_RGBA8888 (Image_t * img_rgba8888);
+
+/**
+ * @brief      Flip a BGRA8888 image along the X axis.
+ *
+ * @param      img_bgra8888  The BGRA8888 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_BGRA8888 (Image_t * img_bgra8888);
+
+/**
+ * @brief      Flip an XRGB8888 image along the X axis.
+ *
+ * @param      img_xrgb8888  The XRGB8888 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_XRGB8888 (Image_t * img_xrgb8888);
+
 /**
  * @brief      Flip a ASCII image along the X axis.
  *
@@ -161,6 +241,78 @@ uint8_t flipY_RGB8 (Image_t * img_rgb8);
  */
 uint8_t flipY_GRAYSCALE (Image_t * img_grayscale);
 
+/**
+ * @brief      Flip an NV12 image along the Y axis.
+ *
+ * @param      img_nv12  The NV12 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_NV12 (Image_t * img_nv12);
+
+/**
+ * @brief      Flip an NV21 image along the Y axis.
+ *
+ * @param      img_nv21  The NV21 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_NV21 (Image_t * img_nv21);
+
+/**
+ * @brief      Flip a YUYV image along the Y axis.
+ *
+ * @param      img_yuyv  The YUYV image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_YUYV (Image_t * img_yuyv);
+
+/**
+ * @brief      Flip a UYVY image along the Y axis.
+ *
+ * @param      img_uyvy  The UYVY image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_UYVY (Image_t * img_uyvy);
+
+/**
+ * @brief      Flip a BGR24 image along the Y axis.
+ *
+ * @param      img_bgr24  The BGR24 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_BGR24 (Image_t * img_bgr24);
+
+/**
+ * @brief      Flip an RGBA8888 image along the Y axis.
+ *
+ * @param      img_rgba8888  The RGBA8888 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_RGBA8888 (Image_t * img_rgba8888);
+
+/**
+ * @brief      Flip a BGRA8888 image along the Y axis.
+ *
+ * @param      img_bgra8888  The BGRA8888 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_BGRA8888 (Image_t * img_bgra8888);
+
+/**
+ * @brief      Flip an XRGB8888 image along the Y axis.
+ *
+ * @param      img_xrgb8888  The XRGB8888 image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_XRGB8888 (Image_t * img_xrgb8888);
+
 /**
  * @brief      Flip a ASCII image along the Y axis.
  *
@@ -171,6 +323,63 @@ uint8_t flipY_GRAYSCALE (Image_t * img_grayscale);
 uint8_t flipY_ASCII (Image_t * img_ascii);
 
 
+/**
+ * @brief      Flip a single plane of an image along the X axis.
+ *
+ * @param      img    The image to flip.
+ * @param[in]  plane  The index of the plane (0 for packed formats).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_plane (Image_t * img, uint8_t plane);
+
+/**
+ * @brief      Flip a range of rows of a single plane of an image along the X axis.
+ *
+ * Every row of the [first_row, last_row) range is swapped with its mirror row; flipping the rows of
+ * [0, plane height / 2) flips the whole plane, and disjoint ranges can be flipped concurrently.
+ *
+ * @param      img        The image to flip.
+ * @param[in]  plane      The index of the plane (0 for packed formats).
+ * @param[in]  first_row  The first row to swap (within the plane).
+ * @param[in]  last_row   The row after the last one to swap (within the plane, at most half of the plane height).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_plane_rows (Image_t * img, uint8_t plane, uint16_t first_row, uint16_t last_row);
+
+/**
+ * @brief      Flip a single plane of an image along the Y axis.
+ *
+ * @param      img         The image to flip.
+ * @param[in]  plane       The index of the plane (0 for packed formats).
+ * @param[in]  pixel_size  The size of a pixel in the plane (in bytes), so that multi-byte pixels are kept intact.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_plane (Image_t * img, uint8_t plane, uint8_t pixel_size);
+
+/**
+ * @brief      Flip a packed 4:2:2 image (YUYV or UYVY) along the Y axis.
+ *
+ * Y values are mirrored one pixel at a time, and U, V values one macropixel (of two pixels) at a time.
+ *
+ * @param      img          The packed 4:2:2 image to flip.
+ * @param[in]  luma_offset  The offset of the first Y value of every macropixel (0 for YUYV, 1 for UYVY).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_422 (Image_t * img, uint8_t luma_offset);
+
+/**
+ * @brief      Flip a 32-bits-per-pixel packed image along the X axis.
+ *
+ * @param      img   The packed 32-bpp image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_32bpp (Image_t * img);
+
 /**
  * @brief      Flip a 24-bits-per-pixel packed image along the X axis.
  *
@@ -190,6 +399,17 @@ uint8_t flipX_24bpp (Image_t * img);
 uint8_t flipX_8bpp (Image_t * img);
 
 
+/**
+ * @brief      Flip a 32-bits-per-pixel packed image along the Y axis.
+ *
+ * Pixels are moved as whole 32-bit words.
+ *
+ * @param      img   The packed 32-bpp image to flip.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_32bpp (Image_t * img);
+
 /**
  * @brief      Flip a 24-bits-per-pixel packed image along the Y axis.
  *
@@ -1,19 +1,40 @@
 #include "libuimg_img.h"
 
 
-Image_t * create_image (uint16_t width, uint16_t height, PixelFormat_t format)
+#if defined(__linux__) || defined(__APPLE__)
+#define LIBUIMG_HAS_MMAP 1
+#include <sys/mman.h>
+#endif
+
+
+#define HUGE_PAGE_SIZE (2u << 20) /**< The size of a huge page (on x86-64 and AArch64 Linux). */
+
+// Round a size up to a multiple of an alignment (a power of 2)
+#define ALIGN_UP(size, alignment) (((size) + (alignment) - 1) & ~((size_t) (alignment) - 1))
+
+
+/**
+ * @brief An image created by `create_aligned_image()`, followed by its (aligned) pixel data.
+ */
+typedef struct {
+    /** The image itself (first, so that the image pointer is the start of the allocation). */
+    Image_t img;
+    /** The size of the mapping holding the image (0 if it was allocated with `calloc()`). */
+    size_t mapped_size;
+} AlignedImage_t;
+
+
+// Whether the chroma rows of a format cover two rows of pixels
+static uint8_t has_half_height_chroma (PixelFormat_t format)
 {
-    uint32_t data_size = 0;
+    return format == YUV420p || format == NV12 || format == NV21;
+}
 
-    // Create new image
-    Image_t * new_image = calloc(1, sizeof(Image_t));
-    if (!new_image) return NULL;
 
-    // Fill in width, height and pixel format
-    new_image->width = width;
-    new_image->height = height;
-    new_image->format = format;
-    new_image->data = NULL;
+uint32_t get_image_data_size (uint16_t width, uint16_t height, PixelFormat_t format)
+{
+    uint64_t data_size = 0;
+    uint64_t pixels = (uint64_t) width * height;
 
     // Get data size based on format
     switch (format) {
@@ -21,24 +42,286 @@ Image_t * create_image (uint16_t width, uint16_t height, PixelFormat_t format)
         case YUV444:
         case YUV444p:
         case RGB24:
-            data_size = width * height * 3;
+        case BGR24:
+            data_size = pixels * 3;
+            break;
+
+        case RGBA8888:
+        case BGRA8888:
+        case XRGB8888:
+            data_size = pixels * 4;
+            break;
+
+        case RGB565:
+            data_size = pixels * 2;
+            break;
+
+        case YUV420p:
+        case NV12:
+        case NV21:
+            data_size = pixels + 2 * ((uint64_t) UROUND_UP(width / 2) * UROUND_UP(height / 2));
+            break;
+
+        case YUYV:
+        case UYVY:
+            // Odd widths are padded to a whole macropixel
+            data_size = (uint64_t) UROUND_UP(width / 2) * 4 * height;
+            break;
+
+        case RGB8:
+        case GRAYSCALE:
+        case ASCII:
+            data_size = pixels;
+            break;
+    }
+
+    // Sizes are computed in 64 bits, so that the largest images are reported as not fitting rather than wrapping around
+    if (data_size > UINT32_MAX) return 0;
+
+    return (uint32_t) data_size;
+}
+
+
+uint8_t get_image_plane_count (PixelFormat_t format)
+{
+    if (format == YUV444p || format == YUV420p) return 3;
+    if (format == NV12 || format == NV21) return 2;
+
+    return 1;
+}
+
+
+uint32_t get_image_row_size (uint16_t width, PixelFormat_t format, uint8_t plane)
+{
+    uint32_t row_size = 0;
+
+    switch (format) {
+        default:
+        case YUV444:
+        case RGB24:
+        case BGR24:
+            row_size = width * 3;
+            break;
+
+        case RGBA8888:
+        case BGRA8888:
+        case XRGB8888:
+            row_size = width * 4;
             break;
 
         case RGB565:
-            data_size = width * height * 2;
+            row_size = width * 2;
             break;
 
         case YUV420p:
-            data_size = width * height + 2 * (UROUND_UP(width / 2) * UROUND_UP(height / 2));
+            row_size = plane ? UROUND_UP(width / 2) : width;
             break;
 
+        case NV12:
+        case NV21:
+            row_size = plane ? UROUND_UP(width / 2) * 2 : width;
+            break;
+
+        case YUYV:
+        case UYVY:
+            row_size = UROUND_UP(width / 2) * 4;
+            break;
+
+        case YUV444p:
         case RGB8:
         case GRAYSCALE:
         case ASCII:
-            data_size = width * height;
+            row_size = width;
             break;
     }
 
+    return row_size;
+}
+
+
+uint16_t get_image_plane_height (uint16_t height, PixelFormat_t format, uint8_t plane)
+{
+    if (has_half_height_chroma(format) && plane) return UROUND_UP(height / 2);
+
+    return height;
+}
+
+
+int32_t get_image_stride (const Image_t * img, uint8_t plane)
+{
+    if (!img) return 0;
+    if (img->strides[plane]) return img->strides[plane];
+
+    return get_image_row_size(img->width, img->format, plane);
+}
+
+
+uint8_t * get_image_plane (const Image_t * img, uint8_t plane)
+{
+    int32_t stride = 0;
+    uint8_t * previous_plane = NULL;
+
+    if (!img) return NULL;
+    if (img->planes[plane]) return img->planes[plane];
+    if (plane == 0) return img->data;
+
+    // The plane directly follows the previous one
+    previous_plane = get_image_plane(img, plane - 1);
+    if (!previous_plane) return NULL;
+
+    stride = get_image_stride(img, plane - 1);
+    if (stride < 0) stride = -stride;
+
+    return previous_plane + (uint32_t) stride * get_image_plane_height(img->height, img->format, plane - 1);
+}
+
+
+uint8_t * get_image_row (const Image_t * img, uint8_t plane, uint16_t row)
+{
+    return get_image_plane(img, plane) + (intptr_t) get_image_stride(img, plane) * row;
+}
+
+
+uint8_t init_image (Image_t * img,
+                    uint16_t width,
+                    uint16_t height,
+                    PixelFormat_t format,
+                    uint8_t * data,
+                    const int32_t * strides)
+{
+    uint8_t k = 0;
+
+    if (!img) return 0;
+    if (!data) return 0;
+
+    img->width = width;
+    img->height = height;
+    img->format = format;
+    img->data = data;
+
+    for (k = 0; k < 3; k++) {
+        img->planes[k] = NULL;
+        img->strides[k] = 0;
+    }
+    img->colorspace = NULL;
+    img->chroma_siting = CHROMA_SITING_CENTER;
+
+    if (strides) {
+        for (k = 0; k < get_image_plane_count(format); k++) {
+            // Rows may be padded, but they cannot overlap
+            if (strides[k] && (uint32_t) strides[k] < get_image_row_size(width, format, k)) return 0;
+            img->strides[k] = strides[k];
+        }
+    }
+
+    return 1;
+}
+
+
+uint8_t create_image_view (const Image_t * parent,
+                           uint16_t x,
+                           uint16_t y,
+                           uint16_t width,
+                           uint16_t height,
+                           Image_t * view)
+{
+    uint8_t k = 0;
+    uint16_t plane_x = 0;
+    uint16_t plane_y = 0;
+    uint8_t * planes[3] = { NULL, NULL, NULL };
+    int32_t strides[3] = { 0, 0, 0 };
+
+    if (!parent) return 0;
+    if (!parent->data) return 0;
+    if (!view) return 0;
+    if ((uint32_t) x + width > parent->width || (uint32_t) y + height > parent->height) return 0;
+    // Chroma samples cover 2x2 pixels in YUV420p, NV12 and NV21, and 2 pixels of a row in YUYV and UYVY
+    if (has_half_height_chroma(parent->format) && (x % 2 || y % 2)) return 0;
+    if ((parent->format == YUYV || parent->format == UYVY) && x % 2) return 0;
+
+    for (k = 0; k < get_image_plane_count(parent->format); k++) {
+        // NV12 and NV21 chroma rows hold one U and one V sample per pair of pixels, so only their rows are halved
+        plane_x = (parent->format == YUV420p && k) ? x / 2 : x;
+        plane_y = (has_half_height_chroma(parent->format) && k) ? y / 2 : y;
+
+        strides[k] = get_image_stride(parent, k);
+        // Row offset within the plane, in bytes
+        planes[k] = get_image_row(parent, k, plane_y) + get_image_row_size(plane_x, parent->format, 0);
+    }
+
+    // The parent image may be the view itself, so it is only written to once everything has been computed
+    view->width = width;
+    view->height = height;
+    view->format = parent->format;
+    view->data = planes[0];
+    view->colorspace = parent->colorspace;
+    view->chroma_siting = parent->chroma_siting;
+
+    for (k = 0; k < 3; k++) {
+        view->planes[k] = planes[k];
+        view->strides[k] = strides[k];
+    }
+
+    return 1;
+}
+
+
+uint8_t create_reversed_image_view (const Image_t * parent, Image_t * view)
+{
+    uint8_t k = 0;
+    uint16_t plane_height = 0;
+    uint8_t * planes[3] = { NULL, NULL, NULL };
+    int32_t strides[3] = { 0, 0, 0 };
+
+    if (!parent) return 0;
+    if (!parent->data) return 0;
+    if (!view) return 0;
+
+    for (k = 0; k < get_image_plane_count(parent->format); k++) {
+        plane_height = get_image_plane_height(parent->height, parent->format, k);
+
+        strides[k] = -get_image_stride(parent, k);
+        planes[k] = get_image_row(parent, k, plane_height ? plane_height - 1 : 0);
+    }
+
+    // The parent image may be the view itself, so it is only written to once everything has been computed
+    view->width = parent->width;
+    view->height = parent->height;
+    view->format = parent->format;
+    view->data = planes[0];
+    view->colorspace = parent->colorspace;
+    view->chroma_siting = parent->chroma_siting;
+
+    for (k = 0; k < 3; k++) {
+        view->planes[k] = planes[k];
+        view->strides[k] = strides[k];
+    }
+
+    return 1;
+}
+
+
+Image_t * create_image (uint16_t width, uint16_t height, PixelFormat_t format)
+{
+    uint32_t data_size = 0;
+
+    // Create new image
+    Image_t * new_image = calloc(1, sizeof(Image_t));
+    if (!new_image) return NULL;
+
+    // Fill in width, height and pixel format
+    new_image->width = width;
+    new_image->height = height;
+    new_image->format = format;
+    new_image->data = NULL;
+
+    // Get data size based on format
+    data_size = get_image_data_size(width, height, format);
+    if (!data_size && width && height) {
+        free(new_image);
+        return NULL;
+    }
+
     // Allocate the calculated size
     new_image->data = calloc(1, sizeof(uint8_t) * data_size);
     if (!new_image->data) {
@@ -55,3 +338,111 @@ void destroy_image (Image_t * img)
     if (img->data) free(img->data);
     if (img) free(img);
 }
+
+
+// Map memory for an image, on huge pages if possible; return NULL if the memory should be allocated normally
+static void * map_image_memory (size_t * size, uint8_t flags)
+{
+    void * memory = NULL;
+
+#ifdef LIBUIMG_HAS_MMAP
+    if (!(flags & IMAGE_HUGE_PAGES) || *size < HUGE_PAGE_SIZE) return NULL;
+
+    *size = ALIGN_UP(*size, HUGE_PAGE_SIZE);
+
+#ifdef MAP_HUGETLB
+    // Reserved huge pages are only available if the system has been configured for them
+    memory = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (memory != MAP_FAILED) return memory;
+#endif
+
+    memory = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return NULL;
+
+#ifdef MADV_HUGEPAGE
+    // Fall back on transparent huge pages (this is only a hint)
+    madvise(memory, *size, MADV_HUGEPAGE);
+#endif
+#else
+    (void) size;
+    (void) flags;
+#endif
+
+    return memory;
+}
+
+
+Image_t * create_aligned_image (uint16_t width, uint16_t height, PixelFormat_t format, uint32_t alignment, uint8_t flags)
+{
+    uint8_t k = 0;
+    size_t size = 0;
+    size_t offsets[3] = { 0, 0, 0 };
+    int32_t strides[3] = { 0, 0, 0 };
+    uint8_t * memory = NULL;
+    uint8_t * data = NULL;
+    AlignedImage_t * aligned_img = NULL;
+
+    if (!alignment) alignment = IMAGE_DEFAULT_ALIGNMENT;
+    if (alignment & (alignment - 1)) return NULL;
+
+    // Every plane starts on an aligned offset from the (aligned) start of the pixel data
+    for (k = 0; k < get_image_plane_count(format); k++) {
+        strides[k] = get_image_row_size(width, format, k);
+        if (flags & IMAGE_ALIGN_ROWS) strides[k] = ALIGN_UP((size_t) strides[k], alignment);
+
+        offsets[k] = size;
+        size = ALIGN_UP(size + (size_t) strides[k] * get_image_plane_height(height, format, k), alignment);
+    }
+
+    // Room for the image struct, and for aligning the start of the pixel data
+    size += sizeof(AlignedImage_t) + alignment - 1;
+
+    memory = map_image_memory(&size, flags);
+    if (!memory) {
+        memory = calloc(1, size);
+        if (!memory) return NULL;
+        size = 0;
+    }
+
+    aligned_img = (AlignedImage_t *) memory;
+    aligned_img->mapped_size = size;
+    data = (uint8_t *) ALIGN_UP((uintptr_t) (memory + sizeof(AlignedImage_t)), alignment);
+
+    init_image(&aligned_img->img, width, height, format, data, (flags & IMAGE_ALIGN_ROWS) ? strides : NULL);
+    for (k = 0; k < get_image_plane_count(format); k++) {
+        aligned_img->img.planes[k] = data + offsets[k];
+    }
+
+    return &aligned_img->img;
+}
+
+
+void destroy_aligned_image (Image_t * img)
+{
+    AlignedImage_t * aligned_img = (AlignedImage_t *) img;
+
+    if (!img) return;
+
+#ifdef LIBUIMG_HAS_MMAP
+    if (aligned_img->mapped_size) {
+        munmap(aligned_img, aligned_img->mapped_size);
+        return;
+    }
+#endif
+
+    free(aligned_img);
+}
+
+
+uint8_t * create_buffer (size_t size)
+{
+    if (!size) return NULL;
+
+    return calloc(1, size);
+}
+
+
+void destroy_buffer (uint8_t * buffer)
+{
+    free(buffer);
+}
@@ -18,6 +18,12 @@
 #define UROUND_UP(x) (((uint32_t) (x)) < ((float) x) ? ((uint32_t) (x)) + 1 : ((uint32_t) (x)))
 
 
+#define IMAGE_DEFAULT_ALIGNMENT 64 /**< The default alignment of `create_aligned_image()` (one cache line). */
+
+#define IMAGE_ALIGN_ROWS 0x01  /**< Pad the rows of aligned images, so that every row starts aligned. */
+#define IMAGE_HUGE_PAGES 0x02  /**< Back large aligned images with huge pages, where the OS supports it. */
+
+
 /**
  * @brief Enumeration of the currently supported pixel formats.
  * 
@@ -30,6 +36,15 @@
  * RGB565, packed, 16bpp
  * RGB8, packed, 8bpp
  * GRAYSCALE, packed/planar, 8bpp
+ * NV12, semi-planar, 12bpp (a Y plane, followed by a plane of interleaved U and V samples covering 2x2 pixels)
+ * NV21, semi-planar, 12bpp (same as NV12, with V before U)
+ * YUYV, packed, 16bpp (Y0 U Y1 V macropixels covering 2 pixels of a row)
+ * UYVY, packed, 16bpp (U Y0 V Y1 macropixels covering 2 pixels of a row)
+ * BGR24, packed, 24bpp (same as RGB24, with B first)
+ * RGBA8888, packed, 32bpp ([MSB] 8R 8G 8B 8A [LSB], stored little-endian like RGB565: A, B, G, R bytes)
+ * BGRA8888, packed, 32bpp ([MSB] 8B 8G 8R 8A [LSB]: A, R, G, B bytes)
+ * XRGB8888, packed, 32bpp ([MSB] 8X 8R 8G 8B [LSB]: B, G, R, X bytes, as used by most framebuffers; X is written as
+ *           0xff, so that the pixels are also opaque ARGB8888 pixels)
  */
 typedef enum {
     YUV444,
@@ -39,10 +54,35 @@ typedef enum {
     RGB565,
     RGB8,
     GRAYSCALE,
+    NV12,
+    NV21,
+    YUYV,
+    UYVY,
+    BGR24,
+    RGBA8888,
+    BGRA8888,
+    XRGB8888,
     ASCII
 } PixelFormat_t;
 
 
+/**
+ * @brief Enumeration of the locations of the chroma samples of YUV420p images, relative to the 2x2 blocks of pixels
+ * they cover.
+ *
+ * The location sets how the U and V values of each block are computed when downsampling to YUV420p.
+ */
+typedef enum {
+    CHROMA_SITING_CENTER,  /**< Center of the block (JPEG, MPEG-1): average of the 4 pixels. */
+    CHROMA_SITING_LEFT,    /**< Left edge, between the rows (MPEG-2, H.264, most video): average of the 2 left pixels. */
+    CHROMA_SITING_TOP_LEFT /**< Top-left pixel (HEVC type 2): that pixel alone, which is the fastest. */
+} ChromaSiting_t;
+
+
+/** A YUV color space (see `libuimg_colorspace.h`). */
+typedef struct Colorspace Colorspace_t;
+
+
 /**
  * @brief The Image structure.
  * 
@@ -57,9 +97,161 @@ typedef struct {
     PixelFormat_t format;
     /** The pixel data of the image. */
     uint8_t * data;
+    /**
+     * The first row of each plane (only the first one is used for packed formats).
+     * NULL entries mean that the plane directly follows the previous one (or starts at `data` for the first plane).
+     */
+    uint8_t * planes[3];
+    /**
+     * The distance (in bytes) between the starts of two consecutive rows of each plane.
+     * 0 entries mean that the rows are tightly packed; negative strides are allowed if the plane pointer is set.
+     */
+    int32_t strides[3];
+    /**
+     * The color space of the YUV (or GRAYSCALE) values of the image, used when converting it from or to RGB.
+     * NULL means BT.601 limited range (as produced by most cameras and video codecs).
+     */
+    const Colorspace_t * colorspace;
+    /** The location of the chroma samples of the image, used when downsampling to YUV420p (centered by default). */
+    ChromaSiting_t chroma_siting;
 } Image_t;
 
 
+/**
+ * @brief      Get the size of the pixel data of an image.
+ *
+ * @param[in]  width   The width of the image (in pixels).
+ * @param[in]  height  The height of the image (in pixels).
+ * @param[in]  format  The pixel format of the image.
+ *
+ * @return     The size of the pixel data (in bytes), or 0 if it does not fit in 32 bits.
+ */
+uint32_t get_image_data_size (uint16_t width, uint16_t height, PixelFormat_t format);
+
+/**
+ * @brief      Get the number of planes of a pixel format.
+ *
+ * @param[in]  format  The pixel format.
+ *
+ * @return     3 for planar formats (one plane per component), 1 for packed formats.
+ */
+uint8_t get_image_plane_count (PixelFormat_t format);
+
+/**
+ * @brief      Get the size of a tightly packed row of a plane.
+ *
+ * @param[in]  width   The width of the image (in pixels).
+ * @param[in]  format  The pixel format of the image.
+ * @param[in]  plane   The index of the plane.
+ *
+ * @return     The size of a row of the plane (in bytes).
+ */
+uint32_t get_image_row_size (uint16_t width, PixelFormat_t format, uint8_t plane);
+
+/**
+ * @brief      Get the number of rows of a plane.
+ *
+ * @param[in]  height  The height of the image (in pixels).
+ * @param[in]  format  The pixel format of the image.
+ * @param[in]  plane   The index of the plane.
+ *
+ * @return     The number of rows of the plane.
+ */
+uint16_t get_image_plane_height (uint16_t height, PixelFormat_t format, uint8_t plane);
+
+/**
+ * @brief      Get the stride of a plane of an image.
+ *
+ * @param[in]  img    The image.
+ * @param[in]  plane  The index of the plane.
+ *
+ * @return     The stride of the plane (in bytes), which is the packed row size if the image does not specify one.
+ */
+int32_t get_image_stride (const Image_t * img, uint8_t plane);
+
+/**
+ * @brief      Get the first row of a plane of an image.
+ *
+ * @param[in]  img    The image.
+ * @param[in]  plane  The index of the plane.
+ *
+ * @return     A pointer to the first row of the plane.
+ */
+uint8_t * get_image_plane (const Image_t * img, uint8_t plane);
+
+/**
+ * @brief      Get a row of a plane of an image.
+ *
+ * @param[in]  img    The image.
+ * @param[in]  plane  The index of the plane.
+ * @param[in]  row    The index of the row (within the plane; the chroma planes of YUV420p, NV12 and NV21 images have
+ *                    half as many rows).
+ *
+ * @return     A pointer to the row.
+ */
+uint8_t * get_image_row (const Image_t * img, uint8_t plane, uint16_t row);
+
+/**
+ * @brief      Initialize an image over existing pixel data.
+ *
+ * Nothing is allocated, so this can be used to wrap frames handed out by capture drivers (which often pad their rows)
+ * without copying them. The planes of planar formats are assumed to follow one another in `data`; if they do not, the
+ * `planes` field can be set after initialization.
+ *
+ * @param      img      The image to initialize.
+ * @param[in]  width    The width of the image (in pixels).
+ * @param[in]  height   The height of the image (in pixels).
+ * @param[in]  format   The pixel format of the image.
+ * @param      data     The pixel data of the image.
+ * @param[in]  strides  The stride (in bytes) of each plane, or NULL if the rows are tightly packed.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t init_image (Image_t * img,
+                    uint16_t width,
+                    uint16_t height,
+                    PixelFormat_t format,
+                    uint8_t * data,
+                    const int32_t * strides);
+
+/**
+ * @brief      Create a view on a rectangular region of an image.
+ *
+ * The view shares the pixel data of the parent image (nothing is copied or allocated), so any change made through the
+ * view is visible in the parent image; it must not be passed to `destroy_image()`.
+ *
+ * For YUV420p, NV12 and NV21 images, `x` and `y` must be even, so that the view starts on a chroma sample boundary
+ * (for YUYV and UYVY images, only `x` must be even).
+ *
+ * @param[in]  parent  The parent image.
+ * @param[in]  x       The horizontal position of the region (in pixels).
+ * @param[in]  y       The vertical position of the region (in pixels).
+ * @param[in]  width   The width of the region (in pixels).
+ * @param[in]  height  The height of the region (in pixels).
+ * @param      view    The resulting view.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t create_image_view (const Image_t * parent,
+                           uint16_t x,
+                           uint16_t y,
+                           uint16_t width,
+                           uint16_t height,
+                           Image_t * view);
+
+/**
+ * @brief      Create a view on an image, with its rows in reverse order.
+ *
+ * The view shares the pixel data of the image (its planes start on their last row, with negative strides): writing
+ * to the view writes the image flipped along the X axis, without any extra pass over the data.
+ *
+ * @param[in]  parent  The parent image.
+ * @param      view    The resulting view.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t create_reversed_image_view (const Image_t * parent, Image_t * view);
+
 /**
  * @brief      Create an image.
  * 
@@ -69,7 +261,8 @@ typedef struct {
  * @param[in]  height  The height of the image (in pixels).
  * @param[in]  format  The pixel format of the image.
  *
- * @return     The created image.
+ * @return     The created image, or NULL if the allocation failed or if the size of the pixel data does not fit in 32
+ *             bits.
  */
 Image_t * create_image (uint16_t width, uint16_t height, PixelFormat_t format);
 
@@ -82,5 +275,52 @@ Image_t * create_image (uint16_t width, uint16_t height, PixelFormat_t format);
  */
 void destroy_image (Image_t * img);
 
+/**
+ * @brief      Create an image whose planes start on aligned addresses.
+ *
+ * The image struct and its pixel data are allocated together, with the start of every plane aligned (and, with
+ * `IMAGE_ALIGN_ROWS`, every row, using padded strides). The planes are set explicitly, since they do not directly
+ * follow one another.
+ *
+ * With `IMAGE_HUGE_PAGES`, images of 2 MiB or more are mapped on huge pages on Linux (reserved huge pages if there
+ * are any, transparent huge pages otherwise), which cuts down TLB misses on large frames; the flag is ignored on
+ * other platforms.
+ *
+ * @param[in]  width      The width of the image (in pixels).
+ * @param[in]  height     The height of the image (in pixels).
+ * @param[in]  format     The pixel format of the image.
+ * @param[in]  alignment  The alignment (in bytes, a power of 2), or 0 for `IMAGE_DEFAULT_ALIGNMENT`.
+ * @param[in]  flags      A combination of `IMAGE_ALIGN_ROWS` and `IMAGE_HUGE_PAGES` (or 0).
+ *
+ * @return     The created image, or NULL if the allocation failed or the alignment is not a power of 2.
+ */
+Image_t * create_aligned_image (uint16_t width, uint16_t height, PixelFormat_t format, uint32_t alignment, uint8_t flags);
+
+/**
+ * @brief      Destroy an image created with `create_aligned_image()`.
+ *
+ * @param      img   The image to destroy.
+ */
+void destroy_aligned_image (Image_t * img);
+
+/**
+ * @brief      Create a zeroed buffer.
+ *
+ * Meant for the workspaces of the functions taking caller-provided memory (sized with `get_png_decoder_memory_size()`,
+ * `get_scale_buffer_size()`, ...), for users who do not keep them in static memory.
+ *
+ * @param[in]  size  The size of the buffer (in bytes).
+ *
+ * @return     The created buffer, or NULL if the allocation failed or the size is 0.
+ */
+uint8_t * create_buffer (size_t size);
+
+/**
+ * @brief      Destroy a buffer created with `create_buffer()`.
+ *
+ * @param      buffer  The buffer to destroy (NULL is ignored).
+ */
+void destroy_buffer (uint8_t * buffer);
+
 
 #endif
@@ -0,0 +1,1036 @@
+#include "libuimg_jpeg.h"
+#include "libuimg_simd.h"
+
+#include <string.h>
+
+
+#define JPEG_HUFFMAN_LOOKAHEAD 9   /**< Codes of up to this many bits are decoded with a single table lookup. */
+#define JPEG_MAX_COMPONENTS 3      /**< Maximum number of components of a supported image. */
+#define JPEG_MAX_TABLES 4          /**< Number of quantization (and of DC and AC Huffman) table slots. */
+#define JPEG_BLOCK_SIZE 8          /**< Size (in samples) of a full-size DCT block. */
+
+#define JPEG_MARKER_SOF0 0xc0      /**< Start of frame, baseline DCT. */
+#define JPEG_MARKER_SOF1 0xc1      /**< Start of frame, extended sequential DCT (Huffman coding). */
+#define JPEG_MARKER_DHT 0xc4       /**< Define Huffman tables. */
+#define JPEG_MARKER_SOF15 0xcf     /**< Last start of frame marker (SOF2 to SOF15 are not supported). */
+#define JPEG_MARKER_RST0 0xd0      /**< First restart marker. */
+#define JPEG_MARKER_RST7 0xd7      /**< Last restart marker. */
+#define JPEG_MARKER_SOI 0xd8       /**< Start of image. */
+#define JPEG_MARKER_EOI 0xd9       /**< End of image. */
+#define JPEG_MARKER_SOS 0xda       /**< Start of scan. */
+#define JPEG_MARKER_DQT 0xdb       /**< Define quantization tables. */
+#define JPEG_MARKER_DRI 0xdd       /**< Define restart interval. */
+#define JPEG_MARKER_TEM 0x01       /**< Temporary marker (no length). */
+
+
+/**
+ * @brief A Huffman decoding table.
+ */
+typedef struct {
+    /** The length of the code starting with each `JPEG_HUFFMAN_LOOKAHEAD`-bit pattern (0 if it is any longer). */
+    uint8_t lookup_lengths[1 << JPEG_HUFFMAN_LOOKAHEAD];
+    /** The symbol of the code starting with each `JPEG_HUFFMAN_LOOKAHEAD`-bit pattern. */
+    uint8_t lookup_symbols[1 << JPEG_HUFFMAN_LOOKAHEAD];
+    /**
+     * The length of the code and of the coefficient that follows it, if both fit in each `JPEG_HUFFMAN_LOOKAHEAD`-bit
+     * pattern (0 otherwise, or if the symbol has no coefficient).
+     */
+    uint8_t lookup_coef_lengths[1 << JPEG_HUFFMAN_LOOKAHEAD];
+    /** The run of zero coefficients preceding the coefficient of each `JPEG_HUFFMAN_LOOKAHEAD`-bit pattern. */
+    uint8_t lookup_coef_runs[1 << JPEG_HUFFMAN_LOOKAHEAD];
+    /** The (sign-extended) coefficient of each `JPEG_HUFFMAN_LOOKAHEAD`-bit pattern. */
+    int16_t lookup_coefs[1 << JPEG_HUFFMAN_LOOKAHEAD];
+    /** The largest code of each length (-1 if there is none), for codes longer than the lookahead. */
+    int32_t max_codes[17];
+    /** The offset from a code of each length to the index of its symbol in `values`. */
+    int32_t value_offsets[17];
+    /** The symbols, in increasing code order. */
+    uint8_t values[256];
+    /** Set once the table has been defined. */
+    uint8_t defined;
+} JpegHuffmanTable_t;
+
+/**
+ * @brief A component of a JPEG image, and where its blocks go in the decoded image.
+ */
+typedef struct {
+    /** The identifier of the component. */
+    uint8_t id;
+    /** The number of blocks of the component in a row of an MCU. */
+    uint8_t h_sampling;
+    /** The number of blocks of the component in a column of an MCU. */
+    uint8_t v_sampling;
+    /** The quantization table of the component. */
+    uint8_t quant_table;
+    /** The DC Huffman table of the component. */
+    uint8_t dc_table;
+    /** The AC Huffman table of the component. */
+    uint8_t ac_table;
+    /** The width of a decoded block (in samples). */
+    uint8_t block_width;
+    /** The height of a decoded block (in samples). */
+    uint8_t block_height;
+    /** Set if only the blocks of even rows are written (4:2:2 chroma, decoded at 1/8 into a 4:2:0 plane). */
+    uint8_t skip_odd_rows;
+    /** The first row of the plane the component is decoded into. */
+    uint8_t * plane;
+    /** The stride of the plane (in bytes). */
+    int32_t stride;
+    /** The width of the plane (in samples). */
+    uint32_t plane_width;
+    /** The height of the plane (in samples). */
+    uint16_t plane_height;
+} JpegComponent_t;
+
+/**
+ * @brief The state of a JPEG decoder, once the headers of the image have been parsed.
+ */
+typedef struct {
+    /** The width of the image (in pixels). */
+    uint16_t width;
+    /** The height of the image (in pixels). */
+    uint16_t height;
+    /** The pixel format the image decodes to. */
+    PixelFormat_t format;
+    /** Set for 4:2:2 images, whose chroma blocks are averaged vertically. */
+    uint8_t vertical_chroma_average;
+    /** The number of components of the image. */
+    uint8_t component_count;
+    /** The components of the image, in scan order. */
+    JpegComponent_t components[JPEG_MAX_COMPONENTS];
+    /** The number of MCUs in a row of the image. */
+    uint16_t mcu_columns;
+    /** The number of MCUs in a column of the image. */
+    uint16_t mcu_rows;
+    /** The number of MCUs between restart markers (0 if there are none). */
+    uint16_t restart_interval;
+    /** The quantization tables, in zigzag order. */
+    uint16_t quant_tables[JPEG_MAX_TABLES][64];
+    /** One bit per defined quantization table. */
+    uint8_t defined_quant_tables;
+    /** The DC Huffman tables. */
+    JpegHuffmanTable_t dc_tables[JPEG_MAX_TABLES];
+    /** The AC Huffman tables. */
+    JpegHuffmanTable_t ac_tables[JPEG_MAX_TABLES];
+    /** Set once the frame header has been parsed. */
+    uint8_t frame_found;
+    /** The entropy-coded data of the scan (up to the end of the image). */
+    const uint8_t * scan_data;
+    /** The size of the entropy-coded data (in bytes). */
+    size_t scan_size;
+} JpegDecoder_t;
+
+/**
+ * @brief A bit reader over a restart interval of entropy-coded data.
+ */
+typedef struct {
+    /** The entropy-coded data. */
+    const uint8_t * data;
+    /** The size of the entropy-coded data (in bytes). */
+    size_t size;
+    /** The offset of the next byte to read. */
+    size_t offset;
+    /** The buffered bits, left-aligned. */
+    uint64_t bits;
+    /** The number of buffered bits (not a `uint8_t`, which could alias any other store). */
+    uint32_t count;
+    /** The number of zero bits buffered past the end of the data (or a marker). */
+    uint32_t padded_bits;
+} JpegBitReader_t;
+
+/**
+ * @brief A parallel decoding job: the restart intervals of an image, spread over the bands.
+ */
+typedef struct {
+    /** The decoder, with its output set up. */
+    const JpegDecoder_t * decoder;
+    /** The offset of the first restart interval of each band in the entropy-coded data. */
+    size_t band_starts[LIBUIMG_MAX_THREADS];
+    /** The number of restart intervals. */
+    uint32_t segment_count;
+    /** The number of bands the job is split into. */
+    uint16_t band_count;
+    /** The result of each band. */
+    uint8_t results[LIBUIMG_MAX_THREADS];
+} JpegJob_t;
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * TABLES
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+/** The natural (row-major) index of each coefficient, in zigzag order. */
+static const uint8_t jpeg_zigzag_order[64] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/*
+ * The Huffman tables suggested by the JPEG standard (annex K.3), for luminance (0) and chrominance (1); Motion-JPEG
+ * frames leave them out and expect the decoder to use them.
+ */
+
+static const uint8_t jpeg_default_dc_lengths[2][16] = {
+    { 0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0 },
+    { 0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0 }
+};
+
+static const uint8_t jpeg_default_dc_values[12] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b
+};
+
+static const uint8_t jpeg_default_ac_lengths[2][16] = {
+    { 0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 125 },
+    { 0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 119 }
+};
+
+static const uint8_t jpeg_default_ac_values[2][162] = {
+    {
+        0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71,
+        0x14, 0x32, 0x81, 0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72,
+        0x82, 0x09, 0x0a, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37,
+        0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59,
+        0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83,
+        0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3,
+        0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3,
+        0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2,
+        0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa
+    },
+    {
+        0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22,
+        0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1,
+        0x0a, 0x16, 0x24, 0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36,
+        0x37, 0x38, 0x39, 0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58,
+        0x59, 0x5a, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a,
+        0x82, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a,
+        0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba,
+        0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda,
+        0xe2, 0xe3, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa
+    }
+};
+
+
+static uint8_t build_huffman_table (JpegHuffmanTable_t * table,
+                                    const uint8_t * lengths,
+                                    const uint8_t * values,
+                                    uint16_t value_count)
+{
+    uint8_t length = 0;
+    uint16_t i = 0;
+    uint16_t k = 0;
+    uint32_t code = 0;
+    uint32_t pattern = 0;
+    uint32_t shift = 0;
+    uint8_t size = 0;
+    int32_t value = 0;
+
+    for (length = 1; length <= 16; length++) k += lengths[length - 1];
+    if (k != value_count || value_count > 256) return 0;
+
+    memset(table, 0, sizeof(JpegHuffmanTable_t));
+    memcpy(table->values, values, value_count);
+
+    // Codes are assigned in increasing order, one length after the other (JPEG standard, annex C)
+    k = 0;
+    for (length = 1; length <= 16; length++) {
+        table->value_offsets[length] = (int32_t) k - (int32_t) code;
+
+        for (i = 0; i < lengths[length - 1]; i++, code++, k++) {
+            // Over-subscribed tables cannot be decoded
+            if (code >= (1U << length)) return 0;
+            if (length > JPEG_HUFFMAN_LOOKAHEAD) continue;
+
+            // Every bit pattern starting with the code decodes to its symbol
+            shift = JPEG_HUFFMAN_LOOKAHEAD - length;
+            for (pattern = code << shift; pattern < (code + 1) << shift; pattern++) {
+                table->lookup_lengths[pattern] = length;
+                table->lookup_symbols[pattern] = values[k];
+            }
+        }
+
+        table->max_codes[length] = lengths[length - 1] ? (int32_t) code - 1 : -1;
+        code <<= 1;
+    }
+
+    // Most codes are short enough for the coefficient that follows them to be decoded by the same lookup
+    for (pattern = 0; pattern < (1 << JPEG_HUFFMAN_LOOKAHEAD); pattern++) {
+        length = table->lookup_lengths[pattern];
+        size = table->lookup_symbols[pattern] & 0x0f;
+        if (!length || !size || length + size > JPEG_HUFFMAN_LOOKAHEAD) continue;
+
+        value = (pattern >> (JPEG_HUFFMAN_LOOKAHEAD - length - size)) & ((1 << size) - 1);
+        table->lookup_coef_lengths[pattern] = length + size;
+        table->lookup_coef_runs[pattern] = table->lookup_symbols[pattern] >> 4;
+        table->lookup_coefs[pattern] = (value < (1 << (size - 1))) ? value - (1 << size) + 1 : value;
+    }
+
+    table->defined = 1;
+
+    return 1;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * HEADER PARSING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static uint16_t read_jpeg_u16 (const uint8_t * data)
+{
+    return (uint16_t) (data[0] << 8 | data[1]);
+}
+
+
+static uint8_t parse_jpeg_frame (JpegDecoder_t * decoder, const uint8_t * segment, size_t size)
+{
+    uint8_t i = 0;
+    uint8_t j = 0;
+    uint8_t mcu_size = JPEG_BLOCK_SIZE;
+    JpegComponent_t * component = NULL;
+
+    // Only one frame is supported, with 8-bit samples
+    if (decoder->frame_found) return 0;
+    if (size < 6 || segment[0] != 8) return 0;
+
+    decoder->height = read_jpeg_u16(segment + 1);
+    decoder->width = read_jpeg_u16(segment + 3);
+    decoder->component_count = segment[5];
+    // A zero height would have to be read from a DNL segment after the scan
+    if (!decoder->width || !decoder->height) return 0;
+    if (decoder->component_count != 1 && decoder->component_count != JPEG_MAX_COMPONENTS) return 0;
+    if (size != 6 + 3 * (size_t) decoder->component_count) return 0;
+
+    for (i = 0; i < decoder->component_count; i++) {
+        component = &decoder->components[i];
+        component->id = segment[6 + 3 * i];
+        component->h_sampling = segment[7 + 3 * i] >> 4;
+        component->v_sampling = segment[7 + 3 * i] & 0x0f;
+        component->quant_table = segment[8 + 3 * i];
+        if (component->quant_table >= JPEG_MAX_TABLES) return 0;
+
+        for (j = 0; j < i; j++) {
+            if (decoder->components[j].id == component->id) return 0;
+        }
+    }
+
+    if (decoder->component_count == 1) {
+        // A single component is never interleaved, so its MCUs are single blocks whatever its sampling factors
+        decoder->components[0].h_sampling = 1;
+        decoder->components[0].v_sampling = 1;
+        decoder->format = GRAYSCALE;
+    } else {
+        // Chroma must not be subsampled more than once, and luma at most twice in each direction (never vertically
+        // only): this covers 4:4:4, 4:2:2 and 4:2:0
+        for (i = 1; i < JPEG_MAX_COMPONENTS; i++) {
+            if (decoder->components[i].h_sampling != 1 || decoder->components[i].v_sampling != 1) return 0;
+        }
+
+        component = &decoder->components[0];
+        if (component->h_sampling == 1 && component->v_sampling == 1) {
+            decoder->format = YUV444p;
+        } else if (component->h_sampling == 2 && component->v_sampling == 2) {
+            decoder->format = YUV420p;
+        } else if (component->h_sampling == 2 && component->v_sampling == 1) {
+            decoder->format = YUV420p;
+            decoder->vertical_chroma_average = 1;
+        } else {
+            return 0;
+        }
+        mcu_size = JPEG_BLOCK_SIZE * component->h_sampling;
+    }
+
+    decoder->mcu_columns = (decoder->width + mcu_size - 1) / mcu_size;
+    mcu_size = JPEG_BLOCK_SIZE * decoder->components[0].v_sampling;
+    decoder->mcu_rows = (decoder->height + mcu_size - 1) / mcu_size;
+    decoder->frame_found = 1;
+
+    return 1;
+}
+
+
+static uint8_t parse_jpeg_quant_tables (JpegDecoder_t * decoder, const uint8_t * segment, size_t size)
+{
+    size_t offset = 0;
+    uint8_t precision = 0;
+    uint8_t index = 0;
+    uint8_t k = 0;
+
+    while (offset < size) {
+        precision = segment[offset] >> 4;
+        index = segment[offset] & 0x0f;
+        offset++;
+        if (precision > 1 || index >= JPEG_MAX_TABLES) return 0;
+        if (size - offset < 64 * ((size_t) precision + 1)) return 0;
+
+        for (k = 0; k < 64; k++) {
+            if (precision) {
+                decoder->quant_tables[index][k] = read_jpeg_u16(segment + offset);
+                offset += 2;
+            } else {
+                decoder->quant_tables[index][k] = segment[offset++];
+            }
+        }
+        decoder->defined_quant_tables |= 1 << index;
+    }
+
+    return 1;
+}
+
+
+static uint8_t parse_jpeg_huffman_tables (JpegDecoder_t * decoder, const uint8_t * segment, size_t size)
+{
+    size_t offset = 0;
+    uint8_t table_class = 0;
+    uint8_t index = 0;
+    uint16_t value_count = 0;
+    uint8_t i = 0;
+    JpegHuffmanTable_t * table = NULL;
+
+    while (offset < size) {
+        if (size - offset < 17) return 0;
+        table_class = segment[offset] >> 4;
+        index = segment[offset] & 0x0f;
+        if (table_class > 1 || index >= JPEG_MAX_TABLES) return 0;
+
+        value_count = 0;
+        for (i = 0; i < 16; i++) value_count += segment[offset + 1 + i];
+        if (size - offset - 17 < value_count) return 0;
+
+        table = table_class ? &decoder->ac_tables[index] : &decoder->dc_tables[index];
+        if (!build_huffman_table(table, segment + offset + 1, segment + offset + 17, value_count)) return 0;
+        offset += 17 + value_count;
+    }
+
+    return 1;
+}
+
+
+static uint8_t parse_jpeg_scan (JpegDecoder_t * decoder, const uint8_t * segment, size_t size)
+{
+    uint8_t i = 0;
+    JpegComponent_t * component = NULL;
+
+    // Only single-scan images are supported: the scan must hold every component, in frame order
+    if (!decoder->frame_found) return 0;
+    if (size < 1 || segment[0] != decoder->component_count) return 0;
+    if (size != 4 + 2 * (size_t) decoder->component_count) return 0;
+
+    for (i = 0; i < decoder->component_count; i++) {
+        component = &decoder->components[i];
+        if (segment[1 + 2 * i] != component->id) return 0;
+        component->dc_table = segment[2 + 2 * i] >> 4;
+        component->ac_table = segment[2 + 2 * i] & 0x0f;
+        if (component->dc_table >= JPEG_MAX_TABLES || component->ac_table >= JPEG_MAX_TABLES) return 0;
+        if (!(decoder->defined_quant_tables & (1 << component->quant_table))) return 0;
+
+        // Tables 0 and 1 default to the standard luminance and chrominance tables
+        if (!decoder->dc_tables[component->dc_table].defined) {
+            if (component->dc_table > 1) return 0;
+            build_huffman_table(&decoder->dc_tables[component->dc_table],
+                                jpeg_default_dc_lengths[component->dc_table],
+                                jpeg_default_dc_values,
+                                sizeof(jpeg_default_dc_values));
+        }
+        if (!decoder->ac_tables[component->ac_table].defined) {
+            if (component->ac_table > 1) return 0;
+            build_huffman_table(&decoder->ac_tables[component->ac_table],
+                                jpeg_default_ac_lengths[component->ac_table],
+                                jpeg_default_ac_values[component->ac_table],
+                                sizeof(jpeg_default_ac_values[0]));
+        }
+    }
+
+    // Sequential scans cover the whole spectrum at full precision
+    i = 1 + 2 * decoder->component_count;
+    if (segment[i] != 0 || segment[i + 1] != 63 || segment[i + 2] != 0) return 0;
+
+    return 1;
+}
+
+
+// Parse the markers up to the start of the scan; return 0 if the image is malformed or unsupported
+static uint8_t parse_jpeg_headers (JpegDecoder_t * decoder, const uint8_t * data, size_t size)
+{
+    size_t offset = 2;
+    size_t length = 0;
+    uint8_t marker = 0;
+    uint8_t result = 1;
+
+    memset(decoder, 0, sizeof(JpegDecoder_t));
+
+    if (!data || size < 4 || data[0] != 0xff || data[1] != JPEG_MARKER_SOI) return 0;
+
+    while (result) {
+        // Markers may be preceded by any number of fill bytes
+        if (offset >= size || data[offset] != 0xff) return 0;
+        while (offset < size && data[offset] == 0xff) offset++;
+        if (offset >= size) return 0;
+        marker = data[offset++];
+
+        // Standalone markers have no length
+        if (marker == JPEG_MARKER_TEM || (marker >= JPEG_MARKER_RST0 && marker <= JPEG_MARKER_RST7)) continue;
+        if (marker == JPEG_MARKER_SOI || marker == JPEG_MARKER_EOI) return 0;
+
+        if (size - offset < 2) return 0;
+        length = read_jpeg_u16(data + offset);
+        if (length < 2 || size - offset < length) return 0;
+
+        switch (marker) {
+            case JPEG_MARKER_SOF0:
+            case JPEG_MARKER_SOF1:
+                result = parse_jpeg_frame(decoder, data + offset + 2, length - 2);
+                break;
+            case JPEG_MARKER_DHT:
+                result = parse_jpeg_huffman_tables(decoder, data + offset + 2, length - 2);
+                break;
+            case JPEG_MARKER_DQT:
+                result = parse_jpeg_quant_tables(decoder, data + offset + 2, length - 2);
+                break;
+            case JPEG_MARKER_DRI:
+                result = (length == 4);
+                decoder->restart_interval = read_jpeg_u16(data + offset + 2);
+                break;
+            case JPEG_MARKER_SOS:
+                if (!parse_jpeg_scan(decoder, data + offset + 2, length - 2)) return 0;
+                decoder->scan_data = data + offset + length;
+                decoder->scan_size = size - offset - length;
+                return 1;
+            default:
+                // Progressive, lossless and arithmetic-coded frames are not supported; APPn, COM, etc. are skipped
+                if (marker > JPEG_MARKER_SOF1 && marker <= JPEG_MARKER_SOF15) return 0;
+                break;
+        }
+
+        offset += length;
+    }
+
+    return 0;
+}
+
+
+// Get the size of the image decoded at a given scale; return 0 if the scale is not supported, or if the size of the
+// decoded pixel data does not fit in 32 bits (callers size their buffers from these dimensions)
+static uint8_t get_jpeg_scaled_size (const JpegDecoder_t * decoder,
+                                     uint8_t scale_denom,
+                                     uint16_t * width,
+                                     uint16_t * height)
+{
+    uint16_t scaled_width = 0;
+    uint16_t scaled_height = 0;
+
+    if (scale_denom != 1 && scale_denom != 2 && scale_denom != 4 && scale_denom != 8) return 0;
+
+    scaled_width = (decoder->width + scale_denom - 1) / scale_denom;
+    scaled_height = (decoder->height + scale_denom - 1) / scale_denom;
+    if (!get_image_data_size(scaled_width, scaled_height, decoder->format)) return 0;
+
+    *width = scaled_width;
+    *height = scaled_height;
+
+    return 1;
+}
+
+
+// Point every component to its plane of the decoded image, with its scaled block size
+static uint8_t setup_jpeg_output (JpegDecoder_t * decoder, uint8_t scale_denom, const Image_t * img)
+{
+    uint8_t i = 0;
+    uint8_t block_size = JPEG_BLOCK_SIZE / scale_denom;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    JpegComponent_t * component = NULL;
+
+    if (!img) return 0;
+    if (!get_jpeg_scaled_size(decoder, scale_denom, &width, &height)) return 0;
+    if (img->width != width || img->height != height || img->format != decoder->format) return 0;
+
+    for (i = 0; i < decoder->component_count; i++) {
+        component = &decoder->components[i];
+        component->block_width = block_size;
+        component->block_height = block_size;
+        component->skip_odd_rows = 0;
+
+        // 4:2:2 chroma blocks cover twice as many rows as 4:2:0 ones, so they are decoded at half height (at 1/8, a
+        // single sample cannot be halved, so every other block row is dropped)
+        if (decoder->vertical_chroma_average && i > 0) {
+            if (block_size > 1) component->block_height = block_size / 2;
+            else component->skip_odd_rows = 1;
+        }
+
+        component->plane = get_image_plane(img, i);
+        component->stride = get_image_stride(img, i);
+        component->plane_width = get_image_row_size(img->width, img->format, i);
+        component->plane_height = get_image_plane_height(img->height, img->format, i);
+    }
+
+    return 1;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * ENTROPY DECODING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Buffer at least 57 bits, feeding zeros once the end of the data (or a marker) is reached
+static void fill_jpeg_bits (JpegBitReader_t * reader)
+{
+    const uint8_t * next = reader->data + reader->offset;
+    uint64_t word = 0;
+    uint8_t length = 0;
+    uint8_t byte = 0;
+
+    // Fast path: as long as the next 8 bytes hold no 0xFF byte (stuffed or marker), whole bytes can be taken at once
+    if (reader->count <= 56 && reader->size - reader->offset >= 8) {
+        word = (uint64_t) next[0] << 56 | (uint64_t) next[1] << 48 | (uint64_t) next[2] << 40 |
+               (uint64_t) next[3] << 32 | (uint64_t) next[4] << 24 | (uint64_t) next[5] << 16 |
+               (uint64_t) next[6] << 8 | (uint64_t) next[7];
+
+        if (!((~word - 0x0101010101010101ULL) & word & 0x8080808080808080ULL)) {
+            length = (64 - reader->count) >> 3;
+            reader->bits |= (word & (~0ULL << (64 - 8 * length))) >> reader->count;
+            reader->count += 8 * length;
+            reader->offset += length;
+            return;
+        }
+    }
+
+    while (reader->count <= 56) {
+        byte = 0;
+
+        if (reader->offset < reader->size) {
+            byte = reader->data[reader->offset++];
+
+            // 0xFF data bytes are followed by a stuffed zero byte; anything else is a marker, which ends the data
+            if (byte == 0xff) {
+                if (reader->offset < reader->size && reader->data[reader->offset] == 0x00) {
+                    reader->offset++;
+                } else {
+                    reader->offset = reader->size;
+                    byte = 0;
+                    reader->padded_bits += 8;
+                }
+            }
+        } else {
+            reader->padded_bits += 8;
+        }
+
+        reader->bits |= (uint64_t) byte << (56 - reader->count);
+        reader->count += 8;
+    }
+}
+
+
+// Decode a Huffman-coded symbol; return -1 if the code is invalid. At least 16 bits are left buffered afterwards.
+static inline int32_t decode_huffman_symbol (JpegBitReader_t * reader, const JpegHuffmanTable_t * table)
+{
+    uint32_t code = 0;
+    uint8_t length = 0;
+
+    if (reader->count < 32) fill_jpeg_bits(reader);
+
+    code = (uint32_t) (reader->bits >> (64 - JPEG_HUFFMAN_LOOKAHEAD));
+    length = table->lookup_lengths[code];
+    if (length) {
+        reader->bits <<= length;
+        reader->count -= length;
+        return table->lookup_symbols[code];
+    }
+
+    // Longer codes are compared against the largest code of each length
+    for (length = JPEG_HUFFMAN_LOOKAHEAD + 1; length <= 16; length++) {
+        code = (uint32_t) (reader->bits >> (64 - length));
+        if ((int32_t) code <= table->max_codes[length]) {
+            reader->bits <<= length;
+            reader->count -= length;
+            return table->values[(int32_t) code + table->value_offsets[length]];
+        }
+    }
+
+    return -1;
+}
+
+
+// Read a coefficient of `size` bits (1 to 15) and extend its sign
+static inline int32_t read_jpeg_coefficient (JpegBitReader_t * reader, uint8_t size)
+{
+    int32_t value = (int32_t) (reader->bits >> (64 - size));
+
+    reader->bits <<= size;
+    reader->count -= size;
+
+    return (value < (1 << (size - 1))) ? value - (1 << size) + 1 : value;
+}
+
+
+static inline int16_t saturate_jpeg_coefficient (int32_t value)
+{
+    return (value < INT16_MIN) ? INT16_MIN : ((value > INT16_MAX) ? INT16_MAX : value);
+}
+
+
+// Decode and dequantize a block into `coefs` (which must be zeroed); return 0 if the data is corrupt, 1 if the block
+// only has a DC coefficient, 2 otherwise
+static uint8_t decode_jpeg_block (JpegBitReader_t * reader,
+                                  const JpegHuffmanTable_t * dc_table,
+                                  const JpegHuffmanTable_t * ac_table,
+                                  const uint16_t * quant_table,
+                                  int32_t * dc_prediction,
+                                  int16_t * coefs)
+{
+    int32_t symbol = 0;
+    uint32_t lookup = 0;
+    uint8_t k = 0;
+    uint8_t size = 0;
+    uint8_t result = 1;
+
+    symbol = decode_huffman_symbol(reader, dc_table);
+    if (symbol < 0 || symbol > 15) return 0;
+
+    // The prediction cannot leave the range of valid coefficients, however corrupt the data
+    if (symbol) *dc_prediction += read_jpeg_coefficient(reader, symbol);
+    *dc_prediction = saturate_jpeg_coefficient(*dc_prediction);
+    coefs[0] = saturate_jpeg_coefficient(*dc_prediction * quant_table[0]);
+
+    for (k = 1; k < 64; k++) {
+        if (reader->count < 32) fill_jpeg_bits(reader);
+
+        // Fast path: the code and its coefficient are decoded by a single lookup
+        lookup = (uint32_t) (reader->bits >> (64 - JPEG_HUFFMAN_LOOKAHEAD));
+        if (ac_table->lookup_coef_lengths[lookup]) {
+            reader->bits <<= ac_table->lookup_coef_lengths[lookup];
+            reader->count -= ac_table->lookup_coef_lengths[lookup];
+            k += ac_table->lookup_coef_runs[lookup];
+            if (k > 63) return 0;
+
+            coefs[jpeg_zigzag_order[k]] = saturate_jpeg_coefficient(ac_table->lookup_coefs[lookup] * quant_table[k]);
+            result = 2;
+            continue;
+        }
+
+        symbol = decode_huffman_symbol(reader, ac_table);
+        if (symbol < 0) return 0;
+
+        // Symbols hold a run of zero coefficients (high nibble) and the size of the next coefficient (low nibble)
+        size = symbol & 0x0f;
+        if (!size) {
+            // Either a run of 16 zeros, or the end of the block
+            if (symbol != 0xf0) break;
+            k += 15;
+            continue;
+        }
+
+        k += symbol >> 4;
+        if (k > 63) return 0;
+
+        coefs[jpeg_zigzag_order[k]] = saturate_jpeg_coefficient(read_jpeg_coefficient(reader, size) * quant_table[k]);
+        result = 2;
+    }
+
+    return result;
+}
+
+
+// Write a block at (column, row) of the block grid of its component, clipped to the plane
+static void write_jpeg_block (const JpegComponent_t * component,
+                              const int16_t * coefs,
+                              uint8_t has_ac,
+                              uint32_t column,
+                              uint32_t row)
+{
+    uint8_t block[JPEG_BLOCK_SIZE * JPEG_BLOCK_SIZE];
+    uint8_t * out = NULL;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t i = 0;
+    int32_t value = 0;
+
+    if (component->skip_odd_rows) {
+        if (row & 1) return;
+        row >>= 1;
+    }
+
+    // Blocks past the edges of the image only pad the last MCUs
+    x = column * component->block_width;
+    y = row * component->block_height;
+    if (x >= component->plane_width || y >= component->plane_height) return;
+
+    width = component->plane_width - x;
+    if (width > component->block_width) width = component->block_width;
+    height = component->plane_height - y;
+    if (height > component->block_height) height = component->block_height;
+    out = component->plane + (int32_t) y * component->stride + x;
+
+    if (!has_ac) {
+        // Flat blocks are common enough to be worth a shortcut, computed exactly like `idct_block()` would
+        value = (coefs[0] * SIMD_IDCT_DC_COEF + (1 << (SIMD_IDCT_BITS - SIMD_IDCT_PASS1_BITS - 1))) >>
+                (SIMD_IDCT_BITS - SIMD_IDCT_PASS1_BITS);
+        value = saturate_jpeg_coefficient(value) * SIMD_IDCT_DC_COEF;
+        value = (value + (1 << (SIMD_IDCT_BITS + SIMD_IDCT_PASS1_BITS - 1))) >> (SIMD_IDCT_BITS + SIMD_IDCT_PASS1_BITS);
+        value += 128;
+        value = (value < 0) ? 0 : ((value > 255) ? 255 : value);
+
+        for (i = 0; i < height; i++) memset(out + (int32_t) i * component->stride, value, width);
+        return;
+    }
+
+    if (width == component->block_width && height == component->block_height) {
+        idct_block(coefs, component->block_width, component->block_height, out, component->stride);
+        return;
+    }
+
+    idct_block(coefs, component->block_width, component->block_height, block, JPEG_BLOCK_SIZE);
+    for (i = 0; i < height; i++) memcpy(out + (int32_t) i * component->stride, block + i * JPEG_BLOCK_SIZE, width);
+}
+
+
+// Decode the MCUs of a restart interval; return 0 if the data is corrupt or truncated
+static uint8_t decode_jpeg_segment (const JpegDecoder_t * decoder,
+                                    const uint8_t * data,
+                                    size_t size,
+                                    uint32_t first_mcu,
+                                    uint32_t mcu_count)
+{
+    JpegBitReader_t reader = { data, size, 0, 0, 0, 0 };
+    const JpegComponent_t * component = NULL;
+    int32_t dc_predictions[JPEG_MAX_COMPONENTS] = { 0 };
+    int16_t coefs[JPEG_BLOCK_SIZE * JPEG_BLOCK_SIZE];
+    uint32_t mcu = 0;
+    uint32_t mcu_x = 0;
+    uint32_t mcu_y = 0;
+    uint8_t c = 0;
+    uint8_t h = 0;
+    uint8_t v = 0;
+    uint8_t result = 0;
+
+    for (mcu = first_mcu; mcu < first_mcu + mcu_count; mcu++) {
+        mcu_x = mcu % decoder->mcu_columns;
+        mcu_y = mcu / decoder->mcu_columns;
+
+        for (c = 0; c < decoder->component_count; c++) {
+            component = &decoder->components[c];
+
+            for (v = 0; v < component->v_sampling; v++) {
+                for (h = 0; h < component->h_sampling; h++) {
+                    memset(coefs, 0, sizeof(coefs));
+                    result = decode_jpeg_block(&reader,
+                                               &decoder->dc_tables[component->dc_table],
+                                               &decoder->ac_tables[component->ac_table],
+                                               decoder->quant_tables[component->quant_table],
+                                               &dc_predictions[c],
+                                               coefs);
+                    if (!result) return 0;
+
+                    write_jpeg_block(component,
+                                     coefs,
+                                     result > 1,
+                                     mcu_x * component->h_sampling + h,
+                                     mcu_y * component->v_sampling + v);
+                }
+            }
+        }
+
+        // Bits read past the end of the data mean that it was truncated
+        if (reader.padded_bits > reader.count) return 0;
+    }
+
+    return 1;
+}
+
+
+// Find the end of the restart interval starting at `start` in the entropy-coded data; return 1 if it ends with a
+// restart marker (the next interval then starts right after it), 0 if it is the last one
+static uint8_t find_jpeg_segment (const uint8_t * data, size_t size, size_t start, size_t * end)
+{
+    const uint8_t * marker = NULL;
+    size_t offset = start;
+
+    while (offset + 1 < size) {
+        marker = memchr(data + offset, 0xff, size - offset - 1);
+        if (!marker) break;
+        offset = marker - data;
+
+        // Stuffed zero bytes and fill bytes are part of the data
+        if (data[offset + 1] == 0x00) {
+            offset += 2;
+        } else if (data[offset + 1] == 0xff) {
+            offset++;
+        } else {
+            // Any other marker ends the scan
+            *end = offset;
+            return data[offset + 1] >= JPEG_MARKER_RST0 && data[offset + 1] <= JPEG_MARKER_RST7;
+        }
+    }
+
+    *end = size;
+
+    return 0;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * DECODING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static void decode_jpeg_band (void * arg, uint16_t band)
+{
+    JpegJob_t * job = (JpegJob_t *) arg;
+    const JpegDecoder_t * decoder = job->decoder;
+    uint32_t total_mcus = (uint32_t) decoder->mcu_columns * decoder->mcu_rows;
+    uint32_t interval = decoder->restart_interval ? decoder->restart_interval : total_mcus;
+    uint32_t first = (uint32_t) ((uint64_t) band * job->segment_count / job->band_count);
+    uint32_t last = (uint32_t) ((uint64_t) (band + 1) * job->segment_count / job->band_count);
+    uint32_t segment = 0;
+    uint32_t first_mcu = 0;
+    size_t start = job->band_starts[band];
+    size_t end = 0;
+    uint8_t result = 1;
+
+    for (segment = first; segment < last && result; segment++) {
+        find_jpeg_segment(decoder->scan_data, decoder->scan_size, start, &end);
+        first_mcu = segment * interval;
+        result = decode_jpeg_segment(decoder,
+                                     decoder->scan_data + start,
+                                     end - start,
+                                     first_mcu,
+                                     (total_mcus - first_mcu < interval) ? total_mcus - first_mcu : interval);
+        start = end + 2;
+    }
+
+    job->results[band] = result;
+}
+
+
+// Get the decoder stored in caller-provided memory, aligned to 8 bytes
+static JpegDecoder_t * get_jpeg_decoder (uint8_t * memory)
+{
+    return (JpegDecoder_t *) (memory + (8 - (uintptr_t) memory % 8) % 8);
+}
+
+
+static uint8_t decode_jpeg (const uint8_t * data,
+                            size_t size,
+                            uint8_t scale_denom,
+                            Image_t * img,
+                            const Colorspace_t * colorspace,
+                            uint8_t * memory,
+                            ThreadPool_t * pool)
+{
+    JpegDecoder_t * decoder = NULL;
+    JpegJob_t job = { NULL, { 0 }, 0, 1, { 0 } };
+    uint32_t total_mcus = 0;
+    uint32_t segment = 0;
+    size_t offset = 0;
+    size_t end = 0;
+    uint16_t band = 0;
+    uint8_t result = 0;
+
+    if (!memory) return 0;
+    // JPEG/JFIF samples are BT.601 full range
+    if (colorspace && (colorspace->standard != COLOR_BT601 || colorspace->range != COLOR_FULL_RANGE)) return 0;
+
+    decoder = get_jpeg_decoder(memory);
+    if (!parse_jpeg_headers(decoder, data, size) || !setup_jpeg_output(decoder, scale_denom, img)) return 0;
+
+    total_mcus = (uint32_t) decoder->mcu_columns * decoder->mcu_rows;
+    job.decoder = decoder;
+    job.segment_count = decoder->restart_interval ?
+                        (total_mcus + decoder->restart_interval - 1) / decoder->restart_interval : 1;
+
+    // Every restart marker takes 2 bytes, so the data cannot hold more intervals than that
+    if (job.segment_count > decoder->scan_size / 2 + 1) return 0;
+
+    // Restart intervals are spread over the bands, like rows are by `run_band_job()`
+    if (pool && pool->run) job.band_count = pool->thread_count;
+    if (job.band_count > LIBUIMG_MAX_THREADS) job.band_count = LIBUIMG_MAX_THREADS;
+    if (job.band_count > job.segment_count) job.band_count = job.segment_count;
+    if (job.band_count < 1) job.band_count = 1;
+
+    // Only the first restart interval of every band is located up front: bands find their other ones themselves
+    for (segment = 0; segment < job.segment_count; segment++) {
+        if (band < job.band_count && segment == (uint32_t) ((uint64_t) band * job.segment_count / job.band_count)) {
+            job.band_starts[band++] = offset;
+        }
+        if (!find_jpeg_segment(decoder->scan_data, decoder->scan_size, offset, &end)) break;
+        offset = end + 2;
+    }
+
+    // Missing restart intervals mean that the data was truncated
+    if (segment + 1 < job.segment_count) return 0;
+
+    if (job.band_count > 1) {
+        pool->run(pool->context, decode_jpeg_band, &job, job.band_count);
+    } else {
+        decode_jpeg_band(&job, 0);
+    }
+
+    result = 1;
+    for (band = 0; band < job.band_count; band++) {
+        if (!job.results[band]) result = 0;
+    }
+
+    if (result && colorspace) img->colorspace = colorspace;
+
+    return result;
+}
+
+
+uint32_t get_jpeg_decoder_memory_size (void)
+{
+    // Room for aligning the start of the memory
+    return sizeof(JpegDecoder_t) + 8;
+}
+
+
+uint8_t get_jpeg_info (const uint8_t * data,
+                       size_t size,
+                       uint8_t scale_denom,
+                       uint16_t * width,
+                       uint16_t * height,
+                       PixelFormat_t * format,
+                       uint8_t * memory)
+{
+    JpegDecoder_t * decoder = NULL;
+
+    if (!width || !height || !format) return 0;
+    if (!memory) return 0;
+
+    decoder = get_jpeg_decoder(memory);
+    if (!parse_jpeg_headers(decoder, data, size)) return 0;
+    if (!get_jpeg_scaled_size(decoder, scale_denom, width, height)) return 0;
+
+    *format = decoder->format;
+
+    return 1;
+}
+
+
+uint8_t decode_jpeg_image (const uint8_t * data,
+                           size_t size,
+                           uint8_t scale_denom,
+                           Image_t * img,
+                           const Colorspace_t * colorspace,
+                           uint8_t * memory)
+{
+    return decode_jpeg(data, size, scale_denom, img, colorspace, memory, NULL);
+}
+
+
+uint8_t decode_jpeg_image_parallel (const uint8_t * data,
+                                    size_t size,
+                                    uint8_t scale_denom,
+                                    Image_t * img,
+                                    const Colorspace_t * colorspace,
+                                    uint8_t * memory,
+                                    ThreadPool_t * pool)
+{
+    if (!pool) pool = get_thread_pool();
+
+    return decode_jpeg(data, size, scale_denom, img, colorspace, memory, pool);
+}
@@ -0,0 +1,103 @@
+#ifndef __LIB_UIMG_JPEG_H__
+#define __LIB_UIMG_JPEG_H__
+
+
+#include "libuimg_img.h"
+#include "libuimg_colorspace.h"
+#include "libuimg_threads.h"
+
+#include <stddef.h>
+
+
+/**
+ * @brief      Get the size of the memory needed by the JPEG decoder (about 28 KB, whatever the image).
+ *
+ * @return     The size of the memory (in bytes).
+ */
+uint32_t get_jpeg_decoder_memory_size (void);
+
+/**
+ * @brief      Get the size and pixel format a JPEG image decodes to.
+ *
+ * Only baseline (and extended sequential, 8-bit) Huffman JPEG images are supported, with a single scan: grayscale
+ * images decode to GRAYSCALE, and YCbCr images to YUV444p (4:4:4 sampling) or YUV420p (4:2:0 sampling, and 4:2:2
+ * sampling, whose chroma is averaged vertically while decoding). Other samplings are not supported.
+ *
+ * With a scale denominator of 2, 4 or 8, the image is downscaled while decoding (each output pixel is close to the
+ * average of the pixels it covers, see `idct_block()`), which is much faster than a full decode followed by
+ * `scale_image()`.
+ *
+ * @param[in]  data         The encoded image.
+ * @param[in]  size         The size of the encoded image (in bytes).
+ * @param[in]  scale_denom  The scale denominator of the decoded image (1, 2, 4 or 8).
+ * @param      width        The width of the decoded image, rounded up (in pixels).
+ * @param      height       The height of the decoded image, rounded up (in pixels).
+ * @param      format       The pixel format of the decoded image.
+ * @param      memory       The workspace of the decoder, of at least `get_jpeg_decoder_memory_size()` bytes.
+ *
+ * @return     1 if successful, 0 if the image is malformed or unsupported.
+ */
+uint8_t get_jpeg_info (const uint8_t * data,
+                       size_t size,
+                       uint8_t scale_denom,
+                       uint16_t * width,
+                       uint16_t * height,
+                       PixelFormat_t * format,
+                       uint8_t * memory);
+
+/**
+ * @brief      Decode a JPEG image straight into a planar image.
+ *
+ * The image must have the size and pixel format given by `get_jpeg_info()` (strides and views are honored, so frames
+ * can be decoded into pooled or aligned images). Huffman tables that the image does not define default to the ones
+ * suggested by the JPEG standard, as Motion-JPEG frames expect.
+ *
+ * JPEG/JFIF samples are BT.601 full range, whereas images without a color space are read as BT.601 limited range: the
+ * given color space is attached to the decoded image, so that converting it to RGB gives the right colors. Passing
+ * NULL leaves the color space of the image untouched, in which case the caller must attach one before converting it.
+ *
+ * @param[in]  data         The encoded image.
+ * @param[in]  size         The size of the encoded image (in bytes).
+ * @param[in]  scale_denom  The scale denominator of the decoded image (1, 2, 4 or 8).
+ * @param      img          The decoded image.
+ * @param[in]  colorspace   A BT.601 full-range color space (see `init_colorspace()`), or NULL.
+ * @param      memory       The workspace of the decoder, of at least `get_jpeg_decoder_memory_size()` bytes.
+ *
+ * @return     1 if successful, 0 if the image is malformed, truncated or unsupported, or if the color space is not
+ *             BT.601 full range (the image may then have been partially written).
+ */
+uint8_t decode_jpeg_image (const uint8_t * data,
+                           size_t size,
+                           uint8_t scale_denom,
+                           Image_t * img,
+                           const Colorspace_t * colorspace,
+                           uint8_t * memory);
+
+/**
+ * @brief      Decode a JPEG image straight into a planar image, using multiple threads.
+ *
+ * The entropy-coded data can only be split at restart markers, so images without any (no DRI segment) are decoded on
+ * the calling thread; otherwise, the restart intervals are spread over the bands. The result is identical to that of
+ * `decode_jpeg_image()`.
+ *
+ * @param[in]  data         The encoded image.
+ * @param[in]  size         The size of the encoded image (in bytes).
+ * @param[in]  scale_denom  The scale denominator of the decoded image (1, 2, 4 or 8).
+ * @param      img          The decoded image.
+ * @param[in]  colorspace   A BT.601 full-range color space (see `decode_jpeg_image()`), or NULL.
+ * @param      memory       The workspace of the decoder, of at least `get_jpeg_decoder_memory_size()` bytes (the
+ *                          threads share it).
+ * @param      pool         The thread pool to use, or NULL to use the internal one (see `convert_image_parallel()`).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t decode_jpeg_image_parallel (const uint8_t * data,
+                                    size_t size,
+                                    uint8_t scale_denom,
+                                    Image_t * img,
+                                    const Colorspace_t * colorspace,
+                                    uint8_t * memory,
+                                    ThreadPool_t * pool);
+
+
+#endif
@@ -0,0 +1,167 @@
+#include "libuimg_plan.h"
+#include "libuimg_conversions.h"
+
+
+/**
+ * @brief The execution of a conversion plan on a frame, shared by all of its bands.
+ */
+typedef struct {
+    /** The conversion plan. */
+    const ConversionPlan_t * plan;
+    /** The data of the base frame. */
+    uint8_t * base_data;
+    /** The data of the converted frame. */
+    uint8_t * converted_data;
+    /** The result of each band (1 if successful, 0 otherwise). */
+    uint8_t results[LIBUIMG_MAX_THREADS];
+} PlanJob_t;
+
+
+// Get the location of every plane of an image relative to the start of its data, with its actual stride
+static void get_plan_layout (const Image_t * img, intptr_t * offsets, int32_t * strides)
+{
+    uint8_t k = 0;
+
+    for (k = 0; k < 3; k++) {
+        offsets[k] = 0;
+        strides[k] = 0;
+    }
+
+    for (k = 0; k < get_image_plane_count(img->format); k++) {
+        offsets[k] = get_image_plane(img, k) - img->data;
+        strides[k] = get_image_stride(img, k);
+    }
+}
+
+
+// Set up an image covering some rows of a frame, with all of its planes and strides resolved (so that the kernels
+// never have to locate them again)
+static void init_plan_image (Image_t * img,
+                             uint16_t width,
+                             uint16_t first_row,
+                             uint16_t height,
+                             PixelFormat_t format,
+                             uint8_t * data,
+                             const intptr_t * offsets,
+                             const int32_t * strides,
+                             const Colorspace_t * colorspace,
+                             ChromaSiting_t chroma_siting)
+{
+    uint8_t k = 0;
+    uint16_t plane_row = 0;
+
+    img->width = width;
+    img->height = height;
+    img->format = format;
+
+    for (k = 0; k < 3; k++) {
+        if (k >= get_image_plane_count(format)) {
+            img->planes[k] = NULL;
+            img->strides[k] = 0;
+            continue;
+        }
+
+        // Bands start on even rows, so chroma rows covering two rows of pixels are never split
+        plane_row = get_image_plane_height(first_row, format, k);
+        img->planes[k] = data + offsets[k] + (intptr_t) strides[k] * plane_row;
+        img->strides[k] = strides[k];
+    }
+
+    img->data = img->planes[0];
+    img->colorspace = colorspace;
+    img->chroma_siting = chroma_siting;
+}
+
+
+static void convert_plan_band (void * arg, uint16_t band)
+{
+    PlanJob_t * job = arg;
+    const ConversionPlan_t * plan = job->plan;
+    uint16_t first_row = plan->band_rows[band];
+    uint16_t height = plan->band_rows[band + 1] - first_row;
+    Image_t base_img;
+    Image_t converted_img;
+
+    // Chroma is only ever downsampled into the converted frames, so the siting of the base frames does not matter
+    init_plan_image(&base_img, plan->width, first_row, height, plan->base_format, job->base_data, plan->base_offsets,
+                    plan->base_strides, plan->base_colorspace, CHROMA_SITING_CENTER);
+    init_plan_image(&converted_img, plan->width, first_row, height, plan->converted_format, job->converted_data,
+                    plan->converted_offsets, plan->converted_strides, plan->converted_colorspace,
+                    plan->converted_chroma_siting);
+
+    job->results[band] = plan->convert(&base_img, &converted_img);
+}
+
+
+uint8_t init_conversion_plan (ConversionPlan_t * plan,
+                              const Image_t * base_img,
+                              const Image_t * converted_img,
+                              ThreadPool_t * pool)
+{
+    uint16_t band = 0;
+    uint32_t row_pairs = 0;
+
+    if (!plan) return 0;
+    if (!base_img || !base_img->data) return 0;
+    if (!converted_img || !converted_img->data) return 0;
+    if (base_img->width != converted_img->width || base_img->height != converted_img->height) return 0;
+    // Conversions from ASCII are forbidden, and same-format "conversions" would not write anything
+    if (base_img->format >= ASCII || converted_img->format > ASCII) return 0;
+    if (!conversion_function_LUT[base_img->format][converted_img->format]) return 0;
+
+    plan->width = base_img->width;
+    plan->height = base_img->height;
+    plan->base_format = base_img->format;
+    plan->converted_format = converted_img->format;
+    plan->convert = conversion_function_LUT[base_img->format][converted_img->format];
+    get_plan_layout(base_img, plan->base_offsets, plan->base_strides);
+    get_plan_layout(converted_img, plan->converted_offsets, plan->converted_strides);
+    plan->base_colorspace = base_img->colorspace;
+    plan->converted_colorspace = converted_img->colorspace;
+    plan->converted_chroma_siting = converted_img->chroma_siting;
+
+    if (!pool) pool = get_thread_pool();
+    plan->pool = pool;
+
+    // Bands are made of whole pairs of rows, as with `convert_image_parallel()`
+    row_pairs = UROUND_UP(plan->height / 2);
+    plan->band_count = (pool && pool->run) ? pool->thread_count : 1;
+    if (plan->band_count > LIBUIMG_MAX_THREADS) plan->band_count = LIBUIMG_MAX_THREADS;
+    if (plan->band_count > row_pairs) plan->band_count = row_pairs;
+    if (plan->band_count < 1) plan->band_count = 1;
+
+    for (band = 0; band < plan->band_count; band++) {
+        plan->band_rows[band] = (row_pairs * band / plan->band_count) * 2;
+    }
+    plan->band_rows[plan->band_count] = plan->height;
+
+    return 1;
+}
+
+
+uint8_t execute_conversion_plan (const ConversionPlan_t * plan, uint8_t * base_data, uint8_t * converted_data)
+{
+    uint16_t band = 0;
+    PlanJob_t job;
+
+    if (!plan) return 0;
+    if (!base_data) return 0;
+    if (!converted_data) return 0;
+
+    job.plan = plan;
+    job.base_data = base_data;
+    job.converted_data = converted_data;
+
+    if (plan->band_count == 1) {
+        convert_plan_band(&job, 0);
+        return job.results[0];
+    }
+
+    plan->pool->run(plan->pool->context, convert_plan_band, &job, plan->band_count);
+
+    for (band = 0; band < plan->band_count; band++) {
+        if (!job.results[band]) return 0;
+    }
+
+    return 1;
+}
@@ -0,0 +1,87 @@
+#ifndef __LIB_UIMG_PLAN_H__
+#define __LIB_UIMG_PLAN_H__
+
+
+#include "libuimg_img.h"
+#include "libuimg_threads.h"
+
+
+/**
+ * @brief A conversion plan: everything about converting frames of a given layout that does not depend on the pixels.
+ *
+ * When many frames of the same size, formats and strides are converted (typically, the frames of a video stream), the
+ * checks of `convert_image()`, the lookup of the conversion function, the location of every plane and the split into
+ * bands of rows are done once, when the plan is initialized, instead of for every frame.
+ */
+typedef struct {
+    /** The width of the frames (in pixels). */
+    uint16_t width;
+    /** The height of the frames (in pixels). */
+    uint16_t height;
+    /** The pixel format of the base frames. */
+    PixelFormat_t base_format;
+    /** The pixel format of the converted frames. */
+    PixelFormat_t converted_format;
+    /** The conversion function, from `conversion_function_LUT`. */
+    uint8_t (* convert) (Image_t * base_img, Image_t * converted_img);
+    /** The offset of every plane of the base frames, from the start of their data. */
+    intptr_t base_offsets[3];
+    /** The stride of every plane of the base frames (never 0). */
+    int32_t base_strides[3];
+    /** The offset of every plane of the converted frames, from the start of their data. */
+    intptr_t converted_offsets[3];
+    /** The stride of every plane of the converted frames (never 0). */
+    int32_t converted_strides[3];
+    /** The color space of the base frames. */
+    const Colorspace_t * base_colorspace;
+    /** The color space of the converted frames. */
+    const Colorspace_t * converted_colorspace;
+    /** The location of the chroma samples of the converted frames. */
+    ChromaSiting_t converted_chroma_siting;
+    /** The thread pool to run the bands on (only used if there are several bands). */
+    ThreadPool_t * pool;
+    /** The number of bands the frames are split into. */
+    uint16_t band_count;
+    /** The first row of every band, followed by the height of the frames. */
+    uint16_t band_rows[LIBUIMG_MAX_THREADS + 1];
+} ConversionPlan_t;
+
+
+/**
+ * @brief      Initialize a conversion plan.
+ *
+ * The layout (size, format, strides and plane locations relative to the start of the data), the color space and the
+ * chroma siting of the frames to convert are taken from two template images; views and images with padded rows or
+ * separate planes are supported. SIMD kernels are selected once and for all, and frames are split into as many bands
+ * of rows as the pool has threads.
+ *
+ * @param      plan            The conversion plan.
+ * @param[in]  base_img        An image with the layout of the base frames (its pixels are not used).
+ * @param[in]  converted_img   An image with the layout of the converted frames (its pixels are not used).
+ * @param      pool            The thread pool to use, or NULL to use the internal one if it has been started (see
+ *                             `convert_image_parallel()`); the pool must outlive the plan.
+ *
+ * @return     1 if successful, 0 otherwise (same checks as `convert_image()`; converting to the same format is not
+ *             supported).
+ */
+uint8_t init_conversion_plan (ConversionPlan_t * plan,
+                              const Image_t * base_img,
+                              const Image_t * converted_img,
+                              ThreadPool_t * pool);
+
+/**
+ * @brief      Convert a frame with a conversion plan.
+ *
+ * Nothing is checked beyond the pointers: the frames must have the layout of the template images the plan was
+ * initialized with. The result is identical to that of `convert_image()`.
+ *
+ * @param[in]  plan            The conversion plan.
+ * @param      base_data       The data of the base frame.
+ * @param      converted_data  The data of the converted frame.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t execute_conversion_plan (const ConversionPlan_t * plan, uint8_t * base_data, uint8_t * converted_data);
+
+
+#endif
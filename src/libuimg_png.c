@@ -0,0 +1,1979 @@
+#include "libuimg_png.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#if defined(__linux__) || defined(__APPLE__)
+#define LIBUIMG_HAS_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+// Round a size up to a multiple of 8 bytes
+#define PNG_ALIGN_SIZE(size) (((size) + 7u) & ~((size_t) 7u))
+
+#define PNG_SIGNATURE_SIZE 8            /**< The size of the signature every PNG image starts with. */
+#define PNG_CHUNK_OVERHEAD 12           /**< The size of the length, type and CRC of a chunk. */
+#define PNG_IHDR_SIZE 13                /**< The size of the data of the IHDR chunk. */
+#define PNG_MAX_CHUNK_SIZE 0x7fffffffU  /**< The maximum size of the data of a chunk. */
+
+#define PNG_GRAYSCALE 0                 /**< Color type of grayscale images. */
+#define PNG_TRUECOLOR 2                 /**< Color type of RGB images. */
+#define PNG_PALETTE 3                   /**< Color type of palette images. */
+#define PNG_GRAYSCALE_ALPHA 4           /**< Color type of grayscale images with an alpha channel. */
+#define PNG_TRUECOLOR_ALPHA 6           /**< Color type of RGB images with an alpha channel. */
+
+#define PNG_FILTER_NONE 0
+#define PNG_FILTER_SUB 1
+#define PNG_FILTER_UP 2
+#define PNG_FILTER_AVERAGE 3
+#define PNG_FILTER_PAETH 4
+#define PNG_FILTER_COUNT 5
+
+#define DEFLATE_WINDOW_SIZE 32768       /**< The maximum distance of a match. */
+#define DEFLATE_MIN_MATCH 4             /**< The minimum length of the matches looked for (hashed bytes). */
+#define DEFLATE_MAX_MATCH 258           /**< The maximum length of a match. */
+#define DEFLATE_MAX_CODE_LENGTH 15      /**< The maximum length of a Huffman code. */
+#define DEFLATE_MAX_CL_CODE_LENGTH 7    /**< The maximum length of a Huffman code of the code-length alphabet. */
+#define DEFLATE_LITLEN_CODES 288        /**< The size of the literal/length alphabet (286 and 287 are never used). */
+#define DEFLATE_DISTANCE_CODES 32       /**< The size of the distance alphabet (30 and 31 are never used). */
+#define DEFLATE_CL_CODES 19             /**< The size of the code-length alphabet. */
+#define DEFLATE_END_OF_BLOCK 256        /**< The end-of-block symbol of the literal/length alphabet. */
+#define DEFLATE_BLOCK_SYMBOLS 16384     /**< The maximum number of symbols in a block written by the encoder. */
+#define DEFLATE_HASH_BITS 15            /**< The size (in bits) of the hash table of the encoder. */
+#define DEFLATE_MAX_CHAIN 32            /**< The number of candidates tried for every match (default compression). */
+#define DEFLATE_NICE_MATCH 128          /**< The length of a match good enough to stop looking (default compression). */
+#define DEFLATE_TOO_FAR 256             /**< The maximum distance of a match of the minimum length. */
+
+#define INFLATE_LITLEN_LOOKAHEAD 10     /**< The number of bits decoded at once for literal/length codes. */
+#define INFLATE_DISTANCE_LOOKAHEAD 8    /**< The number of bits decoded at once for distance codes. */
+#define INFLATE_BATCH_SIZE 131072       /**< The minimum amount of data inflated between two slides of the window. */
+
+// Kinds of the entries of the inflate tables
+#define INFLATE_LITERAL 0
+#define INFLATE_MATCH 1
+#define INFLATE_END 2
+#define INFLATE_INVALID 3
+
+// Alphabets of the inflate tables
+#define INFLATE_LITLEN 0
+#define INFLATE_DISTANCE 1
+#define INFLATE_CODE_LENGTH 2
+
+// States of the inflater, between two blocks or inside one
+#define INFLATE_BLOCK_HEADER 0
+#define INFLATE_STORED_BLOCK 1
+#define INFLATE_HUFFMAN_BLOCK 2
+#define INFLATE_DONE 3
+
+
+/**
+ * @brief The information of a PNG image needed to decode it.
+ */
+typedef struct {
+    /** The width of the image (in pixels). */
+    uint16_t width;
+    /** The height of the image (in pixels). */
+    uint16_t height;
+    /** The number of bits of every sample (1, 2, 4, 8 or 16). */
+    uint8_t bit_depth;
+    /** The color type of the image (`PNG_GRAYSCALE`, ...). */
+    uint8_t color_type;
+    /** The number of samples of every pixel. */
+    uint8_t channels;
+    /** The distance (in bytes) between the bytes compared by the filters: the size of a pixel, at least 1. */
+    uint8_t pixel_size;
+    /** The size of an unfiltered row (in bytes). */
+    uint32_t row_size;
+    /** GRAYSCALE or RGB24. */
+    PixelFormat_t format;
+    /** The colors of palette images (entries missing from the PLTE chunk are black). */
+    uint8_t palette[256][3];
+    /** The data of the first IDAT chunk. */
+    const uint8_t * image_data;
+    /** The size of the data of the first IDAT chunk (in bytes). */
+    uint32_t image_data_size;
+} PngHeader_t;
+
+
+/**
+ * @brief The canonical description of a Huffman code, used to decode the codes too long for the lookup tables.
+ */
+typedef struct {
+    /** The number of codes of every length. */
+    uint16_t counts[DEFLATE_MAX_CODE_LENGTH + 1];
+    /** The symbols, sorted by code length, then value. */
+    uint16_t symbols[DEFLATE_LITLEN_CODES];
+} InflateCode_t;
+
+
+/**
+ * @brief The state of a zlib stream being inflated.
+ *
+ * The entries of the lookup tables pack the value of a symbol (a literal, or the base of a length or distance) in
+ * bits 16-31, its kind (`INFLATE_LITERAL`, ...) in bits 8-11, its number of extra bits in bits 4-7 and the length of its
+ * code in bits 0-3; entries with a null length are either the prefix of a longer code, or invalid.
+ */
+typedef struct {
+    /** The bits read ahead; the next one is the least significant one. */
+    uint64_t bits;
+    /** The number of valid bits in `bits`. */
+    uint32_t count;
+    /** The number of zero bits appended past the end of the image data. */
+    uint32_t padded_bits;
+    /** The next byte of the current IDAT chunk. */
+    const uint8_t * next;
+    /** The end of the data of the current IDAT chunk. */
+    const uint8_t * end;
+    /** The end of the encoded image. */
+    const uint8_t * data_end;
+    /** `INFLATE_BLOCK_HEADER`, ... */
+    uint8_t state;
+    /** Whether the current block is the last one. */
+    uint8_t final_block;
+    /** The number of bytes left in the current stored block. */
+    uint16_t stored_size;
+    /** The lookup table of literal/length codes. */
+    uint32_t litlen_table[1 << INFLATE_LITLEN_LOOKAHEAD];
+    /** The lookup table of distance codes. */
+    uint32_t distance_table[1 << INFLATE_DISTANCE_LOOKAHEAD];
+    /** The literal/length code of the current block. */
+    InflateCode_t litlen_code;
+    /** The distance code of the current block. */
+    InflateCode_t distance_code;
+} Inflater_t;
+
+
+/**
+ * @brief The state of a PNG encoder.
+ */
+typedef struct {
+    /** The encoded image. */
+    uint8_t * out;
+    /** The size of the encoded image so far (in bytes). */
+    size_t out_size;
+    /** The bits not written yet; the first one is the least significant one. */
+    uint64_t bits;
+    /** The number of valid bits in `bits`. */
+    uint32_t count;
+    /** The literals (with a null distance) and matches of the current block. */
+    uint16_t values[DEFLATE_BLOCK_SYMBOLS];
+    /** The distances of the matches of the current block. */
+    uint16_t distances[DEFLATE_BLOCK_SYMBOLS];
+    /** The number of symbols of the current block. */
+    uint32_t symbol_count;
+    /** The frequencies of the literal/length symbols of the current block. */
+    uint32_t litlen_freqs[DEFLATE_LITLEN_CODES];
+    /** The frequencies of the distance symbols of the current block. */
+    uint32_t distance_freqs[DEFLATE_DISTANCE_CODES];
+    /** The offset of the current block in the filtered data. */
+    size_t block_start;
+    /** The amount of filtered data covered by the symbols so far. */
+    size_t covered;
+    /** The length symbol of every match length (minus 257). */
+    uint8_t length_slots[DEFLATE_MAX_MATCH + 1];
+    /** The distance symbol of every distance (see `get_distance_slot()`). */
+    uint8_t distance_slots[512];
+    /** The code lengths of the fixed literal/length code. */
+    uint8_t fixed_litlen_lengths[DEFLATE_LITLEN_CODES];
+    /** The (bit-reversed) codes of the fixed literal/length code. */
+    uint16_t fixed_litlen_codes[DEFLATE_LITLEN_CODES];
+    /** The code lengths of the fixed distance code (all 5). */
+    uint8_t fixed_distance_lengths[DEFLATE_DISTANCE_CODES];
+    /** The (bit-reversed) codes of the fixed distance code. */
+    uint16_t fixed_distance_codes[DEFLATE_DISTANCE_CODES];
+    /** The last position (plus one) of every hash (default compression). */
+    uint32_t head[1 << DEFLATE_HASH_BITS];
+    /** The previous position (plus one) with the same hash as every position of the window (default compression). */
+    uint32_t previous[DEFLATE_WINDOW_SIZE];
+    /** The tables of the slicing-by-8 CRC computation. */
+    uint32_t crc_tables[8][256];
+} PngEncoder_t;
+
+
+static const uint8_t png_signature[PNG_SIGNATURE_SIZE] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+
+static const uint16_t length_bases[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint8_t length_extra_bits[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const uint16_t distance_bases[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+
+static const uint8_t distance_extra_bits[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+// The order in which the code lengths of the code-length alphabet are stored
+static const uint8_t code_length_order[DEFLATE_CL_CODES] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * HELPERS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static inline uint32_t load_be32 (const uint8_t * data)
+{
+    return (uint32_t) data[0] << 24 | (uint32_t) data[1] << 16 | (uint32_t) data[2] << 8 | data[3];
+}
+
+
+static inline void store_be32 (uint8_t * data, uint32_t value)
+{
+    data[0] = value >> 24;
+    data[1] = value >> 16;
+    data[2] = value >> 8;
+    data[3] = value;
+}
+
+
+static inline uint64_t load_le64 (const uint8_t * data)
+{
+    uint64_t value = 0;
+
+    memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    value = __builtin_bswap64(value);
+#endif
+
+    return value;
+}
+
+
+static inline uint32_t reverse_bits (uint32_t code, uint8_t length)
+{
+    uint32_t reversed = 0;
+
+    while (length--) {
+        reversed = (reversed << 1) | (code & 1);
+        code >>= 1;
+    }
+
+    return reversed;
+}
+
+
+static uint32_t update_adler32 (uint32_t adler, const uint8_t * data, size_t size)
+{
+    uint32_t a = adler & 0xffff;
+    uint32_t b = adler >> 16;
+    uint32_t block = 0;
+    uint32_t i = 0;
+
+    while (size) {
+        // 5552 bytes is the most that can be summed before b may overflow
+        block = (size < 5552) ? size : 5552;
+        size -= block;
+
+        // Four bytes at a time: their contributions to b only depend on a before them
+        for (i = 0; i + 4 <= block; i += 4) {
+            b += 4 * a + 4 * data[i] + 3 * data[i + 1] + 2 * data[i + 2] + data[i + 3];
+            a += data[i] + data[i + 1] + data[i + 2] + data[i + 3];
+        }
+        for (; i < block; i++) {
+            a += data[i];
+            b += a;
+        }
+
+        data += block;
+        a %= 65521;
+        b %= 65521;
+    }
+
+    return b << 16 | a;
+}
+
+
+// Written without branches, so that the filtering loops of the encoder can be vectorized
+static inline uint8_t paeth_predictor (int16_t a, int16_t b, int16_t c)
+{
+    int16_t pa = (b > c) ? b - c : c - b;
+    int16_t pb = (a > c) ? a - c : c - a;
+    int16_t pc = (a + b > 2 * c) ? a + b - 2 * c : 2 * c - a - b;
+
+    return (pa <= pb && pa <= pc) ? a : ((pb <= pc) ? b : c);
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * HEADER PARSING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static uint8_t parse_png_ihdr (const uint8_t * data, PngHeader_t * header)
+{
+    uint32_t width = load_be32(data);
+    uint32_t height = load_be32(data + 4);
+
+    if (!width || width > UINT16_MAX || !height || height > UINT16_MAX) return 0;
+    header->width = width;
+    header->height = height;
+    header->bit_depth = data[8];
+    header->color_type = data[9];
+
+    // Compression and filter methods, and interlacing (Adam7 images cannot be decoded row by row)
+    if (data[10] || data[11] || data[12]) return 0;
+
+    switch (header->color_type) {
+        case PNG_GRAYSCALE:
+            if (header->bit_depth != 1 && header->bit_depth != 2 && header->bit_depth != 4 && header->bit_depth != 8 &&
+                header->bit_depth != 16) return 0;
+            header->channels = 1;
+            break;
+        case PNG_PALETTE:
+            if (header->bit_depth != 1 && header->bit_depth != 2 && header->bit_depth != 4 && header->bit_depth != 8) {
+                return 0;
+            }
+            header->channels = 1;
+            break;
+        case PNG_TRUECOLOR:
+        case PNG_GRAYSCALE_ALPHA:
+        case PNG_TRUECOLOR_ALPHA:
+            if (header->bit_depth != 8 && header->bit_depth != 16) return 0;
+            header->channels = (header->color_type == PNG_TRUECOLOR) ? 3 :
+                               ((header->color_type == PNG_GRAYSCALE_ALPHA) ? 2 : 4);
+            break;
+        default:
+            return 0;
+    }
+
+    header->format = (header->color_type == PNG_GRAYSCALE || header->color_type == PNG_GRAYSCALE_ALPHA) ? GRAYSCALE :
+                                                                                                         RGB24;
+    header->row_size = ((uint32_t) width * header->channels * header->bit_depth + 7) / 8;
+    header->pixel_size = (header->channels * header->bit_depth + 7) / 8;
+
+    // The decoded image must have a size that fits in 32 bits (callers size their buffers from these dimensions)
+    if (!get_image_data_size(header->width, header->height, header->format)) return 0;
+
+    return 1;
+}
+
+
+// Parse the chunks up to the first IDAT one
+static uint8_t parse_png_header (const uint8_t * data, size_t size, PngHeader_t * header)
+{
+    size_t offset = PNG_SIGNATURE_SIZE;
+    uint32_t length = 0;
+    const uint8_t * type = NULL;
+    uint8_t has_palette = 0;
+
+    memset(header, 0, sizeof(PngHeader_t));
+    if (size < PNG_SIGNATURE_SIZE || memcmp(data, png_signature, PNG_SIGNATURE_SIZE)) return 0;
+
+    while (size - offset >= PNG_CHUNK_OVERHEAD) {
+        length = load_be32(data + offset);
+        type = data + offset + 4;
+        if (length > size - offset - PNG_CHUNK_OVERHEAD) return 0;
+
+        // IHDR must come first, and only once
+        if ((offset == PNG_SIGNATURE_SIZE) != !memcmp(type, "IHDR", 4)) return 0;
+
+        if (!memcmp(type, "IHDR", 4)) {
+            if (length != PNG_IHDR_SIZE || !parse_png_ihdr(type + 4, header)) return 0;
+        } else if (!memcmp(type, "PLTE", 4)) {
+            if (!length || length % 3 || length > sizeof(header->palette)) return 0;
+            memcpy(header->palette, type + 4, length);
+            has_palette = 1;
+        } else if (!memcmp(type, "IDAT", 4)) {
+            if (header->color_type == PNG_PALETTE && !has_palette) return 0;
+            header->image_data = type + 4;
+            header->image_data_size = length;
+            return 1;
+        } else if (!(type[0] & 0x20)) {
+            // Unknown critical chunks (and IEND, with no image data before it)
+            return 0;
+        }
+
+        offset += PNG_CHUNK_OVERHEAD + length;
+    }
+
+    return 0;
+}
+
+
+uint8_t get_png_info (const uint8_t * data, size_t size, uint16_t * width, uint16_t * height, PixelFormat_t * format)
+{
+    PngHeader_t header;
+
+    if (!data) return 0;
+    if (!width || !height || !format) return 0;
+    if (!parse_png_header(data, size, &header)) return 0;
+
+    *width = header.width;
+    *height = header.height;
+    *format = header.format;
+
+    return 1;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * INFLATE
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Get the lookup table entry of a symbol (without the length of its code)
+static uint32_t get_inflate_entry (uint16_t symbol, uint8_t alphabet)
+{
+    if (alphabet == INFLATE_CODE_LENGTH) return (uint32_t) symbol << 16 | INFLATE_LITERAL << 8;
+
+    if (alphabet == INFLATE_DISTANCE) {
+        if (symbol >= 30) return INFLATE_INVALID << 8;
+        return (uint32_t) distance_bases[symbol] << 16 | INFLATE_MATCH << 8 | distance_extra_bits[symbol] << 4;
+    }
+
+    if (symbol < DEFLATE_END_OF_BLOCK) return (uint32_t) symbol << 16 | INFLATE_LITERAL << 8;
+    if (symbol == DEFLATE_END_OF_BLOCK) return INFLATE_END << 8;
+    if (symbol >= 286) return INFLATE_INVALID << 8;
+    symbol -= DEFLATE_END_OF_BLOCK + 1;
+
+    return (uint32_t) length_bases[symbol] << 16 | INFLATE_MATCH << 8 | length_extra_bits[symbol] << 4;
+}
+
+
+static uint8_t build_inflate_code (const uint8_t * lengths,
+                                   uint16_t symbol_count,
+                                   uint8_t alphabet,
+                                   uint8_t lookahead,
+                                   uint32_t * table,
+                                   InflateCode_t * code)
+{
+    uint16_t offsets[DEFLATE_MAX_CODE_LENGTH + 1];
+    int32_t left = 1;
+    uint32_t next_code = 0;
+    uint32_t reversed = 0;
+    uint32_t entry = 0;
+    uint16_t symbol = 0;
+    uint16_t index = 0;
+    uint16_t i = 0;
+    uint8_t length = 0;
+
+    memset(code->counts, 0, sizeof(code->counts));
+    for (symbol = 0; symbol < symbol_count; symbol++) code->counts[lengths[symbol]]++;
+    code->counts[0] = 0;
+
+    // Over-subscribed codes cannot be decoded (incomplete ones can, as long as the missing codes never show up)
+    for (length = 1; length <= DEFLATE_MAX_CODE_LENGTH; length++) {
+        left = (left << 1) - code->counts[length];
+        if (left < 0) return 0;
+    }
+
+    offsets[1] = 0;
+    for (length = 1; length < DEFLATE_MAX_CODE_LENGTH; length++) {
+        offsets[length + 1] = offsets[length] + code->counts[length];
+    }
+    for (symbol = 0; symbol < symbol_count; symbol++) {
+        if (lengths[symbol]) code->symbols[offsets[lengths[symbol]]++] = symbol;
+    }
+
+    // Canonical codes are assigned in the order of the symbols; they are stored with their first bit as the least
+    // significant one, and fill every entry they are a prefix of
+    memset(table, 0, sizeof(uint32_t) << lookahead);
+    for (length = 1; length <= lookahead; length++) {
+        for (i = 0; i < code->counts[length]; i++, index++, next_code++) {
+            entry = get_inflate_entry(code->symbols[index], alphabet) | length;
+            for (reversed = reverse_bits(next_code, length); reversed < (1U << lookahead); reversed += 1U << length) {
+                table[reversed] = entry;
+            }
+        }
+        next_code <<= 1;
+    }
+
+    return 1;
+}
+
+
+// Decode a code longer than the lookahead of its table, one bit at a time
+static uint32_t decode_long_inflate_symbol (uint64_t bits, const InflateCode_t * code, uint8_t alphabet)
+{
+    int32_t value = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    uint8_t length = 0;
+
+    for (length = 1; length <= DEFLATE_MAX_CODE_LENGTH; length++) {
+        value |= (bits >> (length - 1)) & 1;
+        if (value - first < code->counts[length]) {
+            return get_inflate_entry(code->symbols[index + value - first], alphabet) | length;
+        }
+
+        index += code->counts[length];
+        first = (first + code->counts[length]) << 1;
+        value <<= 1;
+    }
+
+    return INFLATE_INVALID << 8;
+}
+
+
+// Move on to the data of the next IDAT chunk, if the current one is directly followed by one
+static uint8_t next_png_image_data (Inflater_t * inflater)
+{
+    const uint8_t * chunk = NULL;
+    uint32_t length = 0;
+
+    // Empty IDAT chunks are allowed
+    do {
+        if ((size_t) (inflater->data_end - inflater->end) < 4 + PNG_CHUNK_OVERHEAD) return 0;
+
+        chunk = inflater->end + 4;
+        length = load_be32(chunk);
+        if (memcmp(chunk + 4, "IDAT", 4)) return 0;
+        if (length > (size_t) (inflater->data_end - chunk) - PNG_CHUNK_OVERHEAD) return 0;
+
+        inflater->next = chunk + 8;
+        inflater->end = inflater->next + length;
+    } while (!length);
+
+    return 1;
+}
+
+
+// Read ahead at least 56 bits (zero bits past the end of the image data)
+static void refill_inflate_bits (Inflater_t * inflater)
+{
+    // Fast path: bytes that do not fit (or were already read ahead) are loaded again later, at the same place
+    if (inflater->end - inflater->next >= 8) {
+        inflater->bits |= load_le64(inflater->next) << inflater->count;
+        inflater->next += (63 - inflater->count) >> 3;
+        inflater->count |= 56;
+        return;
+    }
+
+    while (inflater->count < 56) {
+        if (inflater->next == inflater->end && !next_png_image_data(inflater)) {
+            inflater->padded_bits += 8;
+        } else {
+            inflater->bits |= (uint64_t) *inflater->next++ << inflater->count;
+        }
+        inflater->count += 8;
+    }
+}
+
+
+static uint32_t read_inflate_bits (Inflater_t * inflater, uint8_t count)
+{
+    uint32_t value = 0;
+
+    if (inflater->count < count) refill_inflate_bits(inflater);
+    value = inflater->bits & ((1ULL << count) - 1);
+    inflater->bits >>= count;
+    inflater->count -= count;
+
+    return value;
+}
+
+
+static void align_inflate_bits (Inflater_t * inflater)
+{
+    inflater->bits >>= inflater->count & 7;
+    inflater->count &= ~7U;
+}
+
+
+static uint8_t read_inflate_dynamic_codes (Inflater_t * inflater)
+{
+    uint8_t lengths[DEFLATE_LITLEN_CODES + DEFLATE_DISTANCE_CODES];
+    uint8_t code_lengths[DEFLATE_CL_CODES];
+    uint32_t code_length_table[1 << DEFLATE_MAX_CL_CODE_LENGTH];
+    InflateCode_t code_length_code;
+    uint16_t litlen_count = 0;
+    uint16_t distance_count = 0;
+    uint16_t total = 0;
+    uint16_t repeat = 0;
+    uint16_t i = 0;
+    uint8_t code_length_count = 0;
+    uint8_t value = 0;
+    uint32_t entry = 0;
+
+    litlen_count = read_inflate_bits(inflater, 5) + 257;
+    distance_count = read_inflate_bits(inflater, 5) + 1;
+    code_length_count = read_inflate_bits(inflater, 4) + 4;
+    if (litlen_count > 286 || distance_count > 30) return 0;
+
+    memset(code_lengths, 0, sizeof(code_lengths));
+    for (i = 0; i < code_length_count; i++) code_lengths[code_length_order[i]] = read_inflate_bits(inflater, 3);
+    if (!build_inflate_code(code_lengths, DEFLATE_CL_CODES, INFLATE_CODE_LENGTH, DEFLATE_MAX_CL_CODE_LENGTH,
+                            code_length_table, &code_length_code)) return 0;
+
+    total = litlen_count + distance_count;
+    for (i = 0; i < total; ) {
+        if (inflater->count < 16) refill_inflate_bits(inflater);
+        entry = code_length_table[inflater->bits & ((1 << DEFLATE_MAX_CL_CODE_LENGTH) - 1)];
+        // The lookahead covers all the codes of the alphabet, so any other entry is missing from the code
+        if (!(entry & 0xf)) return 0;
+        inflater->bits >>= entry & 0xf;
+        inflater->count -= entry & 0xf;
+
+        value = entry >> 16;
+        if (value < 16) {
+            lengths[i++] = value;
+            continue;
+        }
+
+        if (value == 16) {
+            if (!i) return 0;
+            value = lengths[i - 1];
+            repeat = 3 + read_inflate_bits(inflater, 2);
+        } else {
+            repeat = (value == 17) ? 3 + read_inflate_bits(inflater, 3) : 11 + read_inflate_bits(inflater, 7);
+            value = 0;
+        }
+
+        if (repeat > total - i) return 0;
+        memset(lengths + i, value, repeat);
+        i += repeat;
+    }
+
+    // Blocks without an end-of-block code could never end
+    if (!lengths[DEFLATE_END_OF_BLOCK]) return 0;
+
+    return build_inflate_code(lengths, litlen_count, INFLATE_LITLEN, INFLATE_LITLEN_LOOKAHEAD, inflater->litlen_table,
+                              &inflater->litlen_code) &&
+           build_inflate_code(lengths + litlen_count, distance_count, INFLATE_DISTANCE, INFLATE_DISTANCE_LOOKAHEAD,
+                              inflater->distance_table, &inflater->distance_code);
+}
+
+
+static uint8_t read_inflate_block_header (Inflater_t * inflater)
+{
+    uint8_t lengths[DEFLATE_LITLEN_CODES];
+    uint32_t stored_sizes = 0;
+    uint16_t i = 0;
+
+    inflater->final_block = read_inflate_bits(inflater, 1);
+
+    switch (read_inflate_bits(inflater, 2)) {
+        case 0:
+            align_inflate_bits(inflater);
+            stored_sizes = read_inflate_bits(inflater, 32);
+            if ((stored_sizes & 0xffff) != (~stored_sizes >> 16)) return 0;
+            inflater->stored_size = stored_sizes & 0xffff;
+            inflater->state = INFLATE_STORED_BLOCK;
+            return 1;
+
+        case 1:
+            for (i = 0; i < DEFLATE_LITLEN_CODES; i++) lengths[i] = (i < 144) ? 8 : ((i < 256) ? 9 : ((i < 280) ? 7 : 8));
+            build_inflate_code(lengths, DEFLATE_LITLEN_CODES, INFLATE_LITLEN, INFLATE_LITLEN_LOOKAHEAD,
+                               inflater->litlen_table, &inflater->litlen_code);
+            memset(lengths, 5, DEFLATE_DISTANCE_CODES);
+            build_inflate_code(lengths, DEFLATE_DISTANCE_CODES, INFLATE_DISTANCE, INFLATE_DISTANCE_LOOKAHEAD,
+                               inflater->distance_table, &inflater->distance_code);
+            inflater->state = INFLATE_HUFFMAN_BLOCK;
+            return 1;
+
+        case 2:
+            if (!read_inflate_dynamic_codes(inflater)) return 0;
+            inflater->state = INFLATE_HUFFMAN_BLOCK;
+            return 1;
+
+        default:
+            return 0;
+    }
+}
+
+
+static uint8_t inflate_stored_block (Inflater_t * inflater, uint8_t * out, uint32_t * out_size, uint32_t limit)
+{
+    uint32_t size = 0;
+
+    while (inflater->stored_size && *out_size < limit) {
+        // Bytes read ahead come first (the stream is byte-aligned here)
+        if (inflater->count) {
+            out[(*out_size)++] = inflater->bits;
+            inflater->bits >>= 8;
+            inflater->count -= 8;
+            inflater->stored_size--;
+            continue;
+        }
+
+        inflater->bits = 0;
+        if (inflater->next == inflater->end && !next_png_image_data(inflater)) return 0;
+
+        size = inflater->end - inflater->next;
+        if (size > inflater->stored_size) size = inflater->stored_size;
+        if (size > limit - *out_size) size = limit - *out_size;
+        memcpy(out + *out_size, inflater->next, size);
+        inflater->next += size;
+        inflater->stored_size -= size;
+        *out_size += size;
+    }
+
+    if (!inflater->stored_size) inflater->state = inflater->final_block ? INFLATE_DONE : INFLATE_BLOCK_HEADER;
+
+    return 1;
+}
+
+
+static uint8_t inflate_huffman_block (Inflater_t * inflater, uint8_t * out, uint32_t * out_size, uint32_t limit)
+{
+    // The state is kept in locals, which stores to `out` could otherwise alias
+    uint64_t bits = inflater->bits;
+    uint32_t count = inflater->count;
+    const uint8_t * next = inflater->next;
+    uint32_t position = *out_size;
+    uint32_t entry = 0;
+    uint32_t length = 0;
+    uint32_t distance = 0;
+    uint64_t chunk = 0;
+    const uint8_t * source = NULL;
+    uint8_t * destination = NULL;
+    uint8_t * destination_end = NULL;
+    uint8_t result = 0;
+
+    while (position < limit) {
+        // A match takes at most 48 bits (15 + 5 for its length, 15 + 13 for its distance)
+        if (count < 48) {
+            if (inflater->end - next >= 8) {
+                bits |= load_le64(next) << count;
+                next += (63 - count) >> 3;
+                count |= 56;
+            } else {
+                inflater->bits = bits;
+                inflater->count = count;
+                inflater->next = next;
+                refill_inflate_bits(inflater);
+                bits = inflater->bits;
+                count = inflater->count;
+                next = inflater->next;
+            }
+        }
+
+        entry = inflater->litlen_table[bits & ((1 << INFLATE_LITLEN_LOOKAHEAD) - 1)];
+        if (!(entry & 0xf)) entry = decode_long_inflate_symbol(bits, &inflater->litlen_code, INFLATE_LITLEN);
+        bits >>= entry & 0xf;
+        count -= entry & 0xf;
+
+        if (((entry >> 8) & 0xf) == INFLATE_LITERAL) {
+            out[position++] = entry >> 16;
+            continue;
+        }
+
+        if (((entry >> 8) & 0xf) != INFLATE_MATCH) {
+            if (((entry >> 8) & 0xf) == INFLATE_END) {
+                inflater->state = inflater->final_block ? INFLATE_DONE : INFLATE_BLOCK_HEADER;
+                result = 1;
+            }
+            break;
+        }
+
+        length = (entry >> 16) + (bits & ((1U << ((entry >> 4) & 0xf)) - 1));
+        bits >>= (entry >> 4) & 0xf;
+        count -= (entry >> 4) & 0xf;
+
+        entry = inflater->distance_table[bits & ((1 << INFLATE_DISTANCE_LOOKAHEAD) - 1)];
+        if (!(entry & 0xf)) entry = decode_long_inflate_symbol(bits, &inflater->distance_code, INFLATE_DISTANCE);
+        bits >>= entry & 0xf;
+        count -= entry & 0xf;
+        if (((entry >> 8) & 0xf) != INFLATE_MATCH) break;
+
+        distance = (entry >> 16) + (bits & ((1U << ((entry >> 4) & 0xf)) - 1));
+        bits >>= (entry >> 4) & 0xf;
+        count -= (entry >> 4) & 0xf;
+        // The window always holds the last 32 KB of data (or all of it)
+        if (distance > position) break;
+
+        source = out + position - distance;
+        destination = out + position;
+        destination_end = destination + length;
+        position += length;
+
+        if (distance >= 8) {
+            // The window has room for the last chunk to overrun the match
+            do {
+                memcpy(&chunk, source, 8);
+                memcpy(destination, &chunk, 8);
+                source += 8;
+                destination += 8;
+            } while (destination < destination_end);
+        } else if (distance == 1) {
+            memset(destination, *source, length);
+        } else {
+            while (destination < destination_end) *destination++ = *source++;
+        }
+    }
+
+    if (position >= limit) result = 1;
+
+    inflater->bits = bits;
+    inflater->count = count;
+    inflater->next = next;
+    *out_size = position;
+
+    return result;
+}
+
+
+// Inflate the stream until the window holds at least `limit` bytes, or the stream ends
+static uint8_t inflate_png_data (Inflater_t * inflater, uint8_t * out, uint32_t * out_size, uint32_t limit)
+{
+    uint8_t result = 1;
+
+    while (result && *out_size < limit && inflater->state != INFLATE_DONE) {
+        if (inflater->state == INFLATE_BLOCK_HEADER) {
+            result = read_inflate_block_header(inflater);
+        } else if (inflater->state == INFLATE_STORED_BLOCK) {
+            result = inflate_stored_block(inflater, out, out_size, limit);
+        } else {
+            result = inflate_huffman_block(inflater, out, out_size, limit);
+        }
+    }
+
+    // Padding bits must never be used: the image data is truncated
+    return result && inflater->padded_bits <= inflater->count;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * DECODING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static uint8_t unfilter_png_row (const PngHeader_t * header,
+                                 const uint8_t * filtered,
+                                 const uint8_t * previous,
+                                 uint8_t * row)
+{
+    const uint8_t * raw = filtered + 1;
+    uint32_t size = header->row_size;
+    uint32_t step = header->pixel_size;
+    uint32_t i = 0;
+
+    switch (filtered[0]) {
+        case PNG_FILTER_NONE:
+            memcpy(row, raw, size);
+            break;
+        case PNG_FILTER_SUB:
+            for (i = 0; i < step; i++) row[i] = raw[i];
+            for (; i < size; i++) row[i] = raw[i] + row[i - step];
+            break;
+        case PNG_FILTER_UP:
+            for (i = 0; i < size; i++) row[i] = raw[i] + previous[i];
+            break;
+        case PNG_FILTER_AVERAGE:
+            for (i = 0; i < step; i++) row[i] = raw[i] + (previous[i] >> 1);
+            for (; i < size; i++) row[i] = raw[i] + ((row[i - step] + previous[i]) >> 1);
+            break;
+        case PNG_FILTER_PAETH:
+            for (i = 0; i < step; i++) row[i] = raw[i] + previous[i];
+            for (; i < size; i++) row[i] = raw[i] + paeth_predictor(row[i - step], previous[i], previous[i - step]);
+            break;
+        default:
+            return 0;
+    }
+
+    return 1;
+}
+
+
+// Convert an unfiltered row to GRAYSCALE or RGB24 (alpha samples are dropped)
+static void convert_png_row (const PngHeader_t * header, const uint8_t * raw, uint8_t * out)
+{
+    uint8_t out_channels = (header->format == RGB24) ? 3 : 1;
+    uint8_t mask = (1 << header->bit_depth) - 1;
+    uint32_t bit_offset = 0;
+    uint32_t sample = 0;
+    uint16_t x = 0;
+    uint8_t c = 0;
+
+    if (header->bit_depth == 16) {
+        for (x = 0; x < header->width; x++) {
+            for (c = 0; c < out_channels; c++) {
+                sample = (uint32_t) raw[2 * (x * header->channels + c)] << 8 | raw[2 * (x * header->channels + c) + 1];
+                // Rounded, rather than truncated to the most significant byte
+                out[x * out_channels + c] = (sample * 255 + 32895) >> 16;
+            }
+        }
+    } else if (header->bit_depth == 8 && header->color_type == PNG_PALETTE) {
+        for (x = 0; x < header->width; x++) memcpy(out + 3 * x, header->palette[raw[x]], 3);
+    } else if (header->bit_depth == 8 && header->channels == out_channels) {
+        memcpy(out, raw, (uint32_t) header->width * out_channels);
+    } else if (header->bit_depth == 8) {
+        for (x = 0; x < header->width; x++) {
+            for (c = 0; c < out_channels; c++) out[x * out_channels + c] = raw[x * header->channels + c];
+        }
+    } else {
+        // Samples of 1, 2 or 4 bits, packed from the most significant bit
+        for (x = 0; x < header->width; x++, bit_offset += header->bit_depth) {
+            sample = (raw[bit_offset >> 3] >> (8 - header->bit_depth - (bit_offset & 7))) & mask;
+            if (header->color_type == PNG_PALETTE) {
+                memcpy(out + 3 * x, header->palette[sample], 3);
+            } else {
+                out[x] = sample * (255 / mask);
+            }
+        }
+    }
+}
+
+
+// Get the size of the inflate window of an image (the last 32 KB of filtered data, plus room for a row and a batch)
+static uint32_t get_png_window_capacity (const PngHeader_t * header)
+{
+    return DEFLATE_WINDOW_SIZE + header->row_size + 1 + INFLATE_BATCH_SIZE;
+}
+
+
+// Get the size of the workspace of the decoder once aligned: the inflater, the window, then the rows
+static uint32_t get_png_workspace_size (const PngHeader_t * header)
+{
+    return PNG_ALIGN_SIZE(sizeof(Inflater_t)) +
+           PNG_ALIGN_SIZE(get_png_window_capacity(header) + DEFLATE_MAX_MATCH + 8) +
+           2 * header->row_size + get_image_row_size(header->width, header->format, 0);
+}
+
+
+uint32_t get_png_decoder_memory_size (const uint8_t * data, size_t size)
+{
+    PngHeader_t header;
+
+    if (!data) return 0;
+    if (!parse_png_header(data, size, &header)) return 0;
+
+    // Room for aligning the start of the memory
+    return get_png_workspace_size(&header) + 8;
+}
+
+
+// Decode the rows of an image into `img` if set, or through `callback` otherwise
+static uint8_t decode_png (const uint8_t * data,
+                           size_t size,
+                           Image_t * img,
+                           PngRowCallback_t callback,
+                           void * arg,
+                           uint8_t * memory)
+{
+    PngHeader_t header;
+    Inflater_t * inflater = NULL;
+    uint8_t * window = NULL;
+    uint8_t * rows = NULL;
+    uint8_t * previous = NULL;
+    uint8_t * current = NULL;
+    uint8_t * swap = NULL;
+    uint8_t * out_row = NULL;
+    uint32_t filtered_row_size = 0;
+    uint32_t window_capacity = 0;
+    uint32_t window_size = 0;
+    uint32_t row_offset = 0;
+    uint32_t checked_size = 0;
+    uint32_t shift = 0;
+    uint32_t adler = 1;
+    uint32_t checksum = 0;
+    uint16_t row = 0;
+
+    if (!parse_png_header(data, size, &header)) return 0;
+    if (img && (img->width != header.width || img->height != header.height || img->format != header.format)) return 0;
+
+    filtered_row_size = header.row_size + 1;
+    window_capacity = get_png_window_capacity(&header);
+
+    memory += (8 - (uintptr_t) memory % 8) % 8;
+    inflater = (Inflater_t *) memory;
+    window = memory + PNG_ALIGN_SIZE(sizeof(Inflater_t));
+    rows = window + PNG_ALIGN_SIZE(window_capacity + DEFLATE_MAX_MATCH + 8);
+
+    // The row before the first one is made of zeros for the filters
+    memset(rows, 0, 2 * header.row_size);
+
+    previous = rows;
+    current = rows + header.row_size;
+    out_row = rows + 2 * header.row_size;
+
+    memset(inflater, 0, sizeof(Inflater_t));
+    inflater->next = header.image_data;
+    inflater->end = header.image_data + header.image_data_size;
+    inflater->data_end = data + size;
+    inflater->state = INFLATE_BLOCK_HEADER;
+
+    // zlib header: deflate with a window of at most 32 KB, and no preset dictionary
+    checksum = read_inflate_bits(inflater, 16);
+    if ((checksum & 0x0f) != 8 || (checksum & 0xf0) > 0x70 || (checksum & 0x2000) ||
+        ((checksum & 0xff) << 8 | checksum >> 8) % 31) return 0;
+
+    do {
+        if (!inflate_png_data(inflater, window, &window_size, window_capacity)) return 0;
+        adler = update_adler32(adler, window + checked_size, window_size - checked_size);
+        checked_size = window_size;
+
+        for (; row < header.height && window_size - row_offset >= filtered_row_size; row++) {
+            if (!unfilter_png_row(&header, window + row_offset, previous, current)) return 0;
+
+            if (img) {
+                convert_png_row(&header, current, get_image_row(img, 0, row));
+            } else {
+                convert_png_row(&header, current, out_row);
+                if (!callback(arg, out_row, row)) return 0;
+            }
+
+            swap = previous;
+            previous = current;
+            current = swap;
+            row_offset += filtered_row_size;
+        }
+
+        // Any data past the last row is ignored
+        if (row == header.height) row_offset = window_size;
+
+        if (window_size > DEFLATE_WINDOW_SIZE) {
+            shift = window_size - DEFLATE_WINDOW_SIZE;
+            if (shift > row_offset) shift = row_offset;
+            memmove(window, window + shift, window_size - shift);
+            window_size -= shift;
+            row_offset -= shift;
+            checked_size -= shift;
+        }
+    } while (inflater->state != INFLATE_DONE);
+
+    if (row < header.height) return 0;
+
+    // zlib trailer: the Adler-32 checksum of the filtered data, in big-endian order
+    align_inflate_bits(inflater);
+    checksum = read_inflate_bits(inflater, 8) << 24;
+    checksum |= read_inflate_bits(inflater, 8) << 16;
+    checksum |= read_inflate_bits(inflater, 8) << 8;
+    checksum |= read_inflate_bits(inflater, 8);
+
+    return (checksum == adler) && inflater->padded_bits <= inflater->count;
+}
+
+
+uint8_t decode_png_rows (const uint8_t * data, size_t size, PngRowCallback_t callback, void * arg, uint8_t * memory)
+{
+    if (!data) return 0;
+    if (!callback) return 0;
+    if (!memory) return 0;
+
+    return decode_png(data, size, NULL, callback, arg, memory);
+}
+
+
+uint8_t decode_png_image (const uint8_t * data, size_t size, Image_t * img, uint8_t * memory)
+{
+    if (!data) return 0;
+    if (!img) return 0;
+    if (!img->data) return 0;
+    if (!memory) return 0;
+
+    return decode_png(data, size, img, NULL, NULL, memory);
+}
+
+
+// Decode an image into a new image, with a new workspace
+static Image_t * create_png_image (const uint8_t * data, size_t size)
+{
+    uint16_t width = 0;
+    uint16_t height = 0;
+    PixelFormat_t format = GRAYSCALE;
+    uint8_t * memory = NULL;
+    Image_t * img = NULL;
+
+    if (!get_png_info(data, size, &width, &height, &format)) return NULL;
+
+    memory = create_buffer(get_png_decoder_memory_size(data, size));
+    if (!memory) return NULL;
+
+    img = create_image(width, height, format);
+    if (img && !decode_png(data, size, img, NULL, NULL, memory)) {
+        destroy_image(img);
+        img = NULL;
+    }
+
+    destroy_buffer(memory);
+
+    return img;
+}
+
+
+Image_t * load_png_image (const char * path)
+{
+    Image_t * img = NULL;
+#ifdef LIBUIMG_HAS_MMAP
+    int32_t fd = -1;
+    void * memory = NULL;
+    struct stat file_stat;
+
+    if (!path) return NULL;
+
+    fd = (int32_t) open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    if (fstat(fd, &file_stat) || file_stat.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+
+    memory = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return NULL;
+
+    img = create_png_image(memory, file_stat.st_size);
+    munmap(memory, file_stat.st_size);
+#else
+    FILE * file = NULL;
+    int64_t size = 0;
+    uint8_t * data = NULL;
+
+    if (!path) return NULL;
+
+    file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    if (!fseek(file, 0, SEEK_END) && (size = (int64_t) ftell(file)) > 0 && !fseek(file, 0, SEEK_SET)) {
+        data = create_buffer(size);
+        if (data && fread(data, 1, size, file) == (size_t) size) img = create_png_image(data, size);
+        destroy_buffer(data);
+    }
+
+    fclose(file);
+#endif
+
+    return img;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * DEFLATE
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static inline uint8_t get_distance_slot (const PngEncoder_t * encoder, uint16_t distance)
+{
+    return (distance <= 256) ? encoder->distance_slots[distance - 1] :
+                               encoder->distance_slots[256 + ((distance - 1) >> 7)];
+}
+
+
+// Append up to 56 bits to the output; whole bytes are stored right away, 8 at a time (past the end of the output)
+static inline void put_deflate_bits (uint64_t * bits, uint32_t * count, uint8_t ** out, uint64_t value, uint8_t length)
+{
+    uint64_t word = 0;
+
+    *bits |= value << *count;
+    *count += length;
+
+    word = *bits;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    memcpy(*out, &word, sizeof(word));
+    *out += *count >> 3;
+    *bits >>= *count & ~7U;
+    *count &= 7;
+}
+
+
+static void write_deflate_bits (PngEncoder_t * encoder, uint32_t value, uint8_t length)
+{
+    uint8_t * out = encoder->out + encoder->out_size;
+
+    put_deflate_bits(&encoder->bits, &encoder->count, &out, value, length);
+    encoder->out_size = out - encoder->out;
+}
+
+
+// Write the pending bits, padded to a whole byte
+static void flush_deflate_bits (PngEncoder_t * encoder)
+{
+    if (encoder->count) encoder->out[encoder->out_size++] = encoder->bits;
+    encoder->bits = 0;
+    encoder->count = 0;
+}
+
+
+// Compute the lengths of a Huffman code (of at most `max_length` bits) from the frequencies of its symbols
+static void build_huffman_lengths (const uint32_t * freqs, uint16_t symbol_count, uint8_t max_length, uint8_t * lengths)
+{
+    uint16_t sorted[DEFLATE_LITLEN_CODES];
+    uint32_t weights[2 * DEFLATE_LITLEN_CODES];
+    uint16_t parents[2 * DEFLATE_LITLEN_CODES];
+    uint16_t depths[2 * DEFLATE_LITLEN_CODES];
+    uint16_t counts[DEFLATE_MAX_CODE_LENGTH + 1];
+    uint32_t total = 0;
+    uint16_t used = 0;
+    uint16_t leaf = 0;
+    uint16_t node = 0;
+    uint16_t next = 0;
+    uint16_t child = 0;
+    uint16_t symbol = 0;
+    int32_t i = 0;
+    uint8_t length = 0;
+    uint8_t k = 0;
+
+    memset(lengths, 0, symbol_count);
+
+    // Used symbols, by increasing frequency
+    for (symbol = 0; symbol < symbol_count; symbol++) {
+        if (!freqs[symbol]) continue;
+        for (i = used; i > 0 && freqs[sorted[i - 1]] > freqs[symbol]; i--) sorted[i] = sorted[i - 1];
+        sorted[i] = symbol;
+        used++;
+    }
+
+    // Codes must be complete: a single code (or none) still takes two 1-bit codes
+    if (used < 2) {
+        symbol = used ? sorted[0] : 0;
+        lengths[symbol] = 1;
+        lengths[symbol ? 0 : 1] = 1;
+        return;
+    }
+
+    // Huffman tree: leaves and internal nodes are both created by increasing weight, so two queues are enough
+    for (i = 0; i < used; i++) weights[i] = freqs[sorted[i]];
+    for (next = used, node = used; next < 2 * used - 1; next++) {
+        weights[next] = 0;
+        for (k = 0; k < 2; k++) {
+            if (leaf < used && (node >= next || weights[leaf] <= weights[node])) child = leaf++;
+            else child = node++;
+            parents[child] = next;
+            weights[next] += weights[child];
+        }
+    }
+
+    depths[2 * used - 2] = 0;
+    for (i = 2 * used - 3; i >= 0; i--) depths[i] = depths[parents[i]] + 1;
+
+    // Codes that are too long are all cut to the maximum length; this over-subscribes the code, so codes of the
+    // maximum length are then removed, each time splitting a shorter one in two
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < used; i++) counts[(depths[i] > max_length) ? max_length : depths[i]]++;
+    for (length = 1; length <= max_length; length++) total += (uint32_t) counts[length] << (max_length - length);
+    while (total > (1U << max_length)) {
+        counts[max_length]--;
+        for (length = max_length - 1; length > 0; length--) {
+            if (counts[length]) {
+                counts[length]--;
+                counts[length + 1] += 2;
+                break;
+            }
+        }
+        total--;
+    }
+
+    // The least frequent symbols get the longest codes
+    for (i = 0, length = max_length; length > 0; length--) {
+        for (k = 0; k < counts[length]; k++) lengths[sorted[i++]] = length;
+    }
+}
+
+
+// Compute the canonical codes of a Huffman code (bit-reversed, as they are written from their first bit)
+static void build_huffman_codes (const uint8_t * lengths, uint16_t symbol_count, uint16_t * codes)
+{
+    uint16_t counts[DEFLATE_MAX_CODE_LENGTH + 1];
+    uint16_t next_codes[DEFLATE_MAX_CODE_LENGTH + 1];
+    uint16_t code = 0;
+    uint16_t symbol = 0;
+    uint8_t length = 0;
+
+    memset(counts, 0, sizeof(counts));
+    for (symbol = 0; symbol < symbol_count; symbol++) counts[lengths[symbol]]++;
+    counts[0] = 0;
+
+    for (length = 1; length <= DEFLATE_MAX_CODE_LENGTH; length++) {
+        code = (code + counts[length - 1]) << 1;
+        next_codes[length] = code;
+    }
+
+    for (symbol = 0; symbol < symbol_count; symbol++) {
+        if (lengths[symbol]) codes[symbol] = reverse_bits(next_codes[lengths[symbol]]++, lengths[symbol]);
+    }
+}
+
+
+static void init_png_encoder (PngEncoder_t * encoder)
+{
+    uint32_t crc = 0;
+    uint16_t i = 0;
+    uint16_t value = 0;
+    uint8_t slot = 0;
+    uint8_t k = 0;
+
+    // Symbols of the lengths and distances (the longest lengths of slot 27 are taken over by slot 28)
+    for (slot = 0; slot < 29; slot++) {
+        for (value = length_bases[slot]; value < length_bases[slot] + (1 << length_extra_bits[slot]); value++) {
+            if (value <= DEFLATE_MAX_MATCH) encoder->length_slots[value] = slot;
+        }
+    }
+    for (slot = 0; slot < 30; slot++) {
+        for (i = 0; i < (1 << distance_extra_bits[slot]); i++) {
+            value = distance_bases[slot] - 1 + i;
+            if (value < 256) encoder->distance_slots[value] = slot;
+            else encoder->distance_slots[256 + (value >> 7)] = slot;
+        }
+    }
+
+    for (i = 0; i < DEFLATE_LITLEN_CODES; i++) {
+        encoder->fixed_litlen_lengths[i] = (i < 144) ? 8 : ((i < 256) ? 9 : ((i < 280) ? 7 : 8));
+    }
+    memset(encoder->fixed_distance_lengths, 5, DEFLATE_DISTANCE_CODES);
+    build_huffman_codes(encoder->fixed_litlen_lengths, DEFLATE_LITLEN_CODES, encoder->fixed_litlen_codes);
+    build_huffman_codes(encoder->fixed_distance_lengths, DEFLATE_DISTANCE_CODES, encoder->fixed_distance_codes);
+
+    // Slicing-by-8 CRC tables
+    for (i = 0; i < 256; i++) {
+        crc = i;
+        for (k = 0; k < 8; k++) crc = (crc & 1) ? 0xedb88320 ^ (crc >> 1) : crc >> 1;
+        encoder->crc_tables[0][i] = crc;
+    }
+    for (i = 0; i < 256; i++) {
+        for (k = 1; k < 8; k++) {
+            crc = encoder->crc_tables[k - 1][i];
+            encoder->crc_tables[k][i] = (crc >> 8) ^ encoder->crc_tables[0][crc & 0xff];
+        }
+    }
+}
+
+
+static uint32_t update_crc32 (const PngEncoder_t * encoder, uint32_t crc, const uint8_t * data, size_t size)
+{
+    const uint32_t (* tables)[256] = encoder->crc_tables;
+    uint32_t low = 0;
+    uint32_t high = 0;
+
+    crc = ~crc;
+
+    for (; size >= 8; data += 8, size -= 8) {
+        low = crc ^ ((uint32_t) data[0] | (uint32_t) data[1] << 8 | (uint32_t) data[2] << 16 | (uint32_t) data[3] << 24);
+        high = (uint32_t) data[4] | (uint32_t) data[5] << 8 | (uint32_t) data[6] << 16 | (uint32_t) data[7] << 24;
+        crc = tables[7][low & 0xff] ^ tables[6][(low >> 8) & 0xff] ^ tables[5][(low >> 16) & 0xff] ^
+              tables[4][low >> 24] ^ tables[3][high & 0xff] ^ tables[2][(high >> 8) & 0xff] ^
+              tables[1][(high >> 16) & 0xff] ^ tables[0][high >> 24];
+    }
+    for (; size; data++, size--) crc = tables[0][(crc ^ *data) & 0xff] ^ (crc >> 8);
+
+    return ~crc;
+}
+
+
+// Run-length encode code lengths into code-length symbols (with their extra bits from bit 8)
+static uint16_t encode_code_lengths (const uint8_t * lengths, uint16_t count, uint16_t * symbols, uint32_t * freqs)
+{
+    uint16_t symbol_count = 0;
+    uint16_t run = 0;
+    uint16_t part = 0;
+    uint16_t i = 0;
+    uint8_t value = 0;
+
+    while (i < count) {
+        value = lengths[i];
+        for (run = 1; i + run < count && lengths[i + run] == value; run++);
+        i += run;
+
+        if (!value) {
+            for (; run >= 11; run -= part) {
+                part = (run > 138) ? 138 : run;
+                symbols[symbol_count++] = 18 | (part - 11) << 8;
+                freqs[18]++;
+            }
+            if (run >= 3) {
+                symbols[symbol_count++] = 17 | (run - 3) << 8;
+                freqs[17]++;
+                run = 0;
+            }
+        } else {
+            symbols[symbol_count++] = value;
+            freqs[value]++;
+            for (run--; run >= 3; run -= part) {
+                part = (run > 6) ? 6 : run;
+                symbols[symbol_count++] = 16 | (part - 3) << 8;
+                freqs[16]++;
+            }
+        }
+
+        for (; run; run--) {
+            symbols[symbol_count++] = value;
+            freqs[value]++;
+        }
+    }
+
+    return symbol_count;
+}
+
+
+static void write_deflate_symbols (PngEncoder_t * encoder,
+                                   const uint16_t * litlen_codes,
+                                   const uint8_t * litlen_lengths,
+                                   const uint16_t * distance_codes,
+                                   const uint8_t * distance_lengths)
+{
+    // The output is kept in locals, which stores to the output could otherwise alias
+    uint64_t bits = encoder->bits;
+    uint32_t count = encoder->count;
+    uint8_t * out = encoder->out + encoder->out_size;
+    uint64_t value = 0;
+    uint32_t i = 0;
+    uint16_t length = 0;
+    uint16_t distance = 0;
+    uint8_t slot = 0;
+    uint8_t size = 0;
+
+    for (i = 0; i < encoder->symbol_count; i++) {
+        length = encoder->values[i];
+        distance = encoder->distances[i];
+
+        if (!distance) {
+            put_deflate_bits(&bits, &count, &out, litlen_codes[length], litlen_lengths[length]);
+            continue;
+        }
+
+        // A whole match takes at most 48 bits
+        slot = encoder->length_slots[length];
+        value = litlen_codes[257 + slot] | (uint32_t) (length - length_bases[slot]) << litlen_lengths[257 + slot];
+        size = litlen_lengths[257 + slot] + length_extra_bits[slot];
+        slot = get_distance_slot(encoder, distance);
+        value |= (uint64_t) (distance_codes[slot] | (uint32_t) (distance - distance_bases[slot]) << distance_lengths[slot])
+                 << size;
+        size += distance_lengths[slot] + distance_extra_bits[slot];
+        put_deflate_bits(&bits, &count, &out, value, size);
+    }
+
+    put_deflate_bits(&bits, &count, &out, litlen_codes[DEFLATE_END_OF_BLOCK], litlen_lengths[DEFLATE_END_OF_BLOCK]);
+
+    encoder->bits = bits;
+    encoder->count = count;
+    encoder->out_size = out - encoder->out;
+}
+
+
+static void write_stored_blocks (PngEncoder_t * encoder, const uint8_t * data, size_t size, uint8_t final)
+{
+    uint16_t length = 0;
+
+    do {
+        length = (size > 0xffff) ? 0xffff : size;
+        size -= length;
+
+        write_deflate_bits(encoder, final && !size, 3);
+        flush_deflate_bits(encoder);
+        encoder->out[encoder->out_size++] = length;
+        encoder->out[encoder->out_size++] = length >> 8;
+        encoder->out[encoder->out_size++] = ~length;
+        encoder->out[encoder->out_size++] = ~length >> 8;
+        memcpy(encoder->out + encoder->out_size, data, length);
+        encoder->out_size += length;
+        data += length;
+    } while (size);
+}
+
+
+// Write the symbols gathered so far as a block, with whichever of the dynamic, fixed or stored encodings is smallest
+static void write_deflate_block (PngEncoder_t * encoder, const uint8_t * data, uint8_t final)
+{
+    uint8_t litlen_lengths[DEFLATE_LITLEN_CODES];
+    uint8_t distance_lengths[DEFLATE_DISTANCE_CODES];
+    uint8_t all_lengths[DEFLATE_LITLEN_CODES + DEFLATE_DISTANCE_CODES];
+    uint8_t cl_lengths[DEFLATE_CL_CODES];
+    uint16_t litlen_codes[DEFLATE_LITLEN_CODES];
+    uint16_t distance_codes[DEFLATE_DISTANCE_CODES];
+    uint16_t cl_codes[DEFLATE_CL_CODES];
+    uint16_t cl_symbols[DEFLATE_LITLEN_CODES + DEFLATE_DISTANCE_CODES];
+    uint32_t cl_freqs[DEFLATE_CL_CODES];
+    size_t raw_size = encoder->covered - encoder->block_start;
+    uint64_t extra_bits = 0;
+    uint64_t dynamic_bits = 0;
+    uint64_t fixed_bits = 0;
+    uint64_t stored_bits = 0;
+    uint16_t litlen_count = 0;
+    uint16_t distance_count = 0;
+    uint16_t cl_symbol_count = 0;
+    uint16_t i = 0;
+    uint8_t cl_count = 0;
+
+    encoder->litlen_freqs[DEFLATE_END_OF_BLOCK]++;
+
+    build_huffman_lengths(encoder->litlen_freqs, 286, DEFLATE_MAX_CODE_LENGTH, litlen_lengths);
+    build_huffman_lengths(encoder->distance_freqs, 30, DEFLATE_MAX_CODE_LENGTH, distance_lengths);
+    for (litlen_count = 286; litlen_count > 257 && !litlen_lengths[litlen_count - 1]; litlen_count--);
+    for (distance_count = 30; distance_count > 1 && !distance_lengths[distance_count - 1]; distance_count--);
+
+    memcpy(all_lengths, litlen_lengths, litlen_count);
+    memcpy(all_lengths + litlen_count, distance_lengths, distance_count);
+    memset(cl_freqs, 0, sizeof(cl_freqs));
+    cl_symbol_count = encode_code_lengths(all_lengths, litlen_count + distance_count, cl_symbols, cl_freqs);
+    build_huffman_lengths(cl_freqs, DEFLATE_CL_CODES, DEFLATE_MAX_CL_CODE_LENGTH, cl_lengths);
+    for (cl_count = DEFLATE_CL_CODES; cl_count > 4 && !cl_lengths[code_length_order[cl_count - 1]]; cl_count--);
+
+    // Sizes of the block with each encoding (in bits)
+    for (i = 0; i < 29; i++) extra_bits += (uint64_t) encoder->litlen_freqs[257 + i] * length_extra_bits[i];
+    for (i = 0; i < 30; i++) {
+        extra_bits += (uint64_t) encoder->distance_freqs[i] * distance_extra_bits[i];
+        dynamic_bits += (uint64_t) encoder->distance_freqs[i] * distance_lengths[i];
+        fixed_bits += (uint64_t) encoder->distance_freqs[i] * 5;
+    }
+    for (i = 0; i < 286; i++) {
+        dynamic_bits += (uint64_t) encoder->litlen_freqs[i] * litlen_lengths[i];
+        fixed_bits += (uint64_t) encoder->litlen_freqs[i] * encoder->fixed_litlen_lengths[i];
+    }
+    for (i = 0; i < DEFLATE_CL_CODES; i++) dynamic_bits += (uint64_t) cl_freqs[i] * cl_lengths[i];
+    dynamic_bits += 3 + 14 + 3 * cl_count + 2 * cl_freqs[16] + 3 * cl_freqs[17] + 7 * cl_freqs[18] + extra_bits;
+    fixed_bits += 3 + extra_bits;
+    stored_bits = 8 * (raw_size + 5 * (raw_size / 0xffff + 1) + 1);
+
+    if (stored_bits <= dynamic_bits && stored_bits <= fixed_bits) {
+        write_stored_blocks(encoder, data + encoder->block_start, raw_size, final);
+    } else if (fixed_bits <= dynamic_bits) {
+        write_deflate_bits(encoder, final | 1 << 1, 3);
+        write_deflate_symbols(encoder, encoder->fixed_litlen_codes, encoder->fixed_litlen_lengths,
+                              encoder->fixed_distance_codes, encoder->fixed_distance_lengths);
+    } else {
+        build_huffman_codes(litlen_lengths, 286, litlen_codes);
+        build_huffman_codes(distance_lengths, 30, distance_codes);
+        build_huffman_codes(cl_lengths, DEFLATE_CL_CODES, cl_codes);
+
+        write_deflate_bits(encoder, final | 2 << 1, 3);
+        write_deflate_bits(encoder, litlen_count - 257, 5);
+        write_deflate_bits(encoder, distance_count - 1, 5);
+        write_deflate_bits(encoder, cl_count - 4, 4);
+        for (i = 0; i < cl_count; i++) write_deflate_bits(encoder, cl_lengths[code_length_order[i]], 3);
+        for (i = 0; i < cl_symbol_count; i++) {
+            write_deflate_bits(encoder, cl_codes[cl_symbols[i] & 0x1f], cl_lengths[cl_symbols[i] & 0x1f]);
+            if ((cl_symbols[i] & 0x1f) >= 16) {
+                write_deflate_bits(encoder, cl_symbols[i] >> 8, (cl_symbols[i] & 0x1f) == 16 ? 2 :
+                                                                 ((cl_symbols[i] & 0x1f) == 17 ? 3 : 7));
+            }
+        }
+
+        write_deflate_symbols(encoder, litlen_codes, litlen_lengths, distance_codes, distance_lengths);
+    }
+
+    memset(encoder->litlen_freqs, 0, sizeof(encoder->litlen_freqs));
+    memset(encoder->distance_freqs, 0, sizeof(encoder->distance_freqs));
+    encoder->symbol_count = 0;
+    encoder->block_start = encoder->covered;
+}
+
+
+static inline void add_deflate_literal (PngEncoder_t * encoder, uint8_t value)
+{
+    encoder->values[encoder->symbol_count] = value;
+    encoder->distances[encoder->symbol_count] = 0;
+    encoder->symbol_count++;
+    encoder->litlen_freqs[value]++;
+    encoder->covered++;
+}
+
+
+static inline void add_deflate_match (PngEncoder_t * encoder, uint16_t length, uint16_t distance)
+{
+    encoder->values[encoder->symbol_count] = length;
+    encoder->distances[encoder->symbol_count] = distance;
+    encoder->symbol_count++;
+    encoder->litlen_freqs[257 + encoder->length_slots[length]]++;
+    encoder->distance_freqs[get_distance_slot(encoder, distance)]++;
+    encoder->covered += length;
+}
+
+
+static inline uint32_t hash_deflate_bytes (const uint8_t * data)
+{
+    uint32_t value = 0;
+
+    memcpy(&value, data, sizeof(value));
+
+    return (value * 2654435761U) >> (32 - DEFLATE_HASH_BITS);
+}
+
+
+static inline uint16_t get_match_length (const uint8_t * a, const uint8_t * b, uint16_t limit)
+{
+    uint64_t x = 0;
+    uint64_t y = 0;
+    uint16_t length = 0;
+
+    for (; length + 8 <= limit; length += 8) {
+        memcpy(&x, a + length, 8);
+        memcpy(&y, b + length, 8);
+        if (x != y) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            return length + (__builtin_clzll(x ^ y) >> 3);
+#else
+            return length + (__builtin_ctzll(x ^ y) >> 3);
+#endif
+        }
+    }
+
+    while (length < limit && a[length] == b[length]) length++;
+
+    return length;
+}
+
+
+// Run-length matching only (matches at a distance of one byte): on filtered camera frames, this compresses about as
+// well as searching the whole window, at a fraction of the cost
+static void deflate_fast (PngEncoder_t * encoder, const uint8_t * data, size_t size)
+{
+    size_t position = 0;
+    uint16_t limit = 0;
+    uint16_t length = 0;
+
+    while (position < size) {
+        length = 0;
+        if (position && data[position] == data[position - 1]) {
+            limit = (size - position < DEFLATE_MAX_MATCH) ? size - position : DEFLATE_MAX_MATCH;
+            length = get_match_length(data + position - 1, data + position, limit);
+        }
+
+        if (length >= DEFLATE_MIN_MATCH) {
+            add_deflate_match(encoder, length, 1);
+            position += length;
+        } else {
+            add_deflate_literal(encoder, data[position]);
+            position++;
+        }
+
+        if (encoder->symbol_count == DEFLATE_BLOCK_SYMBOLS) write_deflate_block(encoder, data, 0);
+    }
+
+    write_deflate_block(encoder, data, 1);
+}
+
+
+// Index a position, and find the longest match for it along the chain of its hash
+static uint16_t find_deflate_match (PngEncoder_t * encoder, const uint8_t * data, size_t position, size_t size,
+                                    uint16_t * distance)
+{
+    uint32_t hash = hash_deflate_bytes(data + position);
+    size_t candidate = encoder->head[hash];
+    uint16_t limit = (size - position < DEFLATE_MAX_MATCH) ? size - position : DEFLATE_MAX_MATCH;
+    uint16_t best = DEFLATE_MIN_MATCH - 1;
+    uint16_t length = 0;
+    uint8_t chain = DEFLATE_MAX_CHAIN;
+
+    encoder->previous[position & (DEFLATE_WINDOW_SIZE - 1)] = candidate;
+    encoder->head[hash] = position + 1;
+
+    for (; candidate && position + 1 - candidate <= DEFLATE_WINDOW_SIZE && chain; chain--) {
+        // Candidates that cannot beat the best match are skipped by comparing the byte past it first
+        if (data[candidate - 1 + best] == data[position + best]) {
+            length = get_match_length(data + candidate - 1, data + position, limit);
+            if (length > best) {
+                best = length;
+                *distance = position + 1 - candidate;
+                if (length >= DEFLATE_NICE_MATCH || length == limit) break;
+            }
+        }
+        candidate = encoder->previous[(candidate - 1) & (DEFLATE_WINDOW_SIZE - 1)];
+    }
+
+    // Short matches far away take more bits than their literals
+    if (best == DEFLATE_MIN_MATCH && *distance > DEFLATE_TOO_FAR) return 0;
+
+    return (best >= DEFLATE_MIN_MATCH) ? best : 0;
+}
+
+
+static void insert_deflate_position (PngEncoder_t * encoder, const uint8_t * data, size_t position)
+{
+    uint32_t hash = hash_deflate_bytes(data + position);
+
+    encoder->previous[position & (DEFLATE_WINDOW_SIZE - 1)] = encoder->head[hash];
+    encoder->head[hash] = position + 1;
+}
+
+
+// Hash-chain matching, with a match only taken if the next position does not start a longer one (lazy matching)
+static void deflate_default (PngEncoder_t * encoder, const uint8_t * data, size_t size)
+{
+    size_t position = 0;
+    size_t end = 0;
+    uint16_t length = 0;
+    uint16_t distance = 0;
+    uint16_t previous_length = 0;
+    uint16_t previous_distance = 0;
+
+    while (position < size) {
+        length = 0;
+        if (position + DEFLATE_MIN_MATCH <= size) length = find_deflate_match(encoder, data, position, size, &distance);
+
+        if (previous_length) {
+            if (length > previous_length) {
+                add_deflate_literal(encoder, data[position - 1]);
+            } else {
+                add_deflate_match(encoder, previous_length, previous_distance);
+                // The current position is already indexed
+                end = position - 1 + previous_length;
+                for (position++; position < end; position++) {
+                    if (position + DEFLATE_MIN_MATCH <= size) insert_deflate_position(encoder, data, position);
+                }
+                previous_length = 0;
+                if (encoder->symbol_count >= DEFLATE_BLOCK_SYMBOLS - 1) write_deflate_block(encoder, data, 0);
+                continue;
+            }
+        }
+
+        if (length >= DEFLATE_NICE_MATCH) {
+            add_deflate_match(encoder, length, distance);
+            end = position + length;
+            for (position++; position < end; position++) {
+                if (position + DEFLATE_MIN_MATCH <= size) insert_deflate_position(encoder, data, position);
+            }
+            previous_length = 0;
+        } else if (length) {
+            previous_length = length;
+            previous_distance = distance;
+            position++;
+        } else {
+            previous_length = 0;
+            add_deflate_literal(encoder, data[position]);
+            position++;
+        }
+
+        if (encoder->symbol_count >= DEFLATE_BLOCK_SYMBOLS - 1) write_deflate_block(encoder, data, 0);
+    }
+
+    write_deflate_block(encoder, data, 1);
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * ENCODING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Filter a row with a given filter (whose type is written first)
+static void filter_png_row (uint8_t filter,
+                            const uint8_t * row,
+                            const uint8_t * previous,
+                            uint32_t size,
+                            uint8_t step,
+                            uint8_t * out)
+{
+    // Indexing the left and upper-left bytes from their own pointers lets the compiler vectorize the loops
+    const uint8_t * left = row - step;
+    const uint8_t * corner = previous - step;
+    uint32_t i = 0;
+
+    out[0] = filter;
+    out++;
+
+    switch (filter) {
+        case PNG_FILTER_NONE:
+            memcpy(out, row, size);
+            break;
+        case PNG_FILTER_SUB:
+            for (i = 0; i < step; i++) out[i] = row[i];
+            for (; i < size; i++) out[i] = row[i] - left[i];
+            break;
+        case PNG_FILTER_UP:
+            for (i = 0; i < size; i++) out[i] = row[i] - previous[i];
+            break;
+        case PNG_FILTER_AVERAGE:
+            for (i = 0; i < step; i++) out[i] = row[i] - (previous[i] >> 1);
+            for (; i < size; i++) out[i] = row[i] - ((left[i] + previous[i]) >> 1);
+            break;
+        default:
+            for (i = 0; i < step; i++) out[i] = row[i] - previous[i];
+            for (; i < size; i++) out[i] = row[i] - paeth_predictor(left[i], previous[i], corner[i]);
+            break;
+    }
+}
+
+
+// Sum the absolute values of a filtered row (seen as signed: small differences either way cost the same)
+static uint32_t get_filtered_row_cost (const uint8_t * filtered, uint32_t size)
+{
+    uint32_t cost = 0;
+    uint32_t i = 0;
+
+    for (i = 1; i <= size; i++) cost += (filtered[i] < 128) ? filtered[i] : 256 - filtered[i];
+
+    return cost;
+}
+
+
+static void write_png_chunk_start (uint8_t * out, const char * type, uint32_t length)
+{
+    store_be32(out, length);
+    memcpy(out + 4, type, 4);
+}
+
+
+// Get the size of the filtered data of an image, or 0 if it cannot be encoded
+static uint64_t get_png_filtered_size (uint16_t width, uint16_t height, PixelFormat_t format)
+{
+    uint64_t filtered_size = 0;
+
+    if (format != RGB24 && format != GRAYSCALE) return 0;
+    // Empty images cannot be represented
+    if (!width || !height) return 0;
+
+    filtered_size = (uint64_t) (get_image_row_size(width, format, 0) + 1) * height;
+    if (filtered_size >= PNG_MAX_CHUNK_SIZE) return 0;
+
+    return filtered_size;
+}
+
+
+// Get the maximum size of an encoded image: blocks are never larger than when stored, which bounds the image data
+static uint64_t get_png_encoded_capacity (uint64_t filtered_size)
+{
+    return PNG_SIGNATURE_SIZE + 3 * PNG_CHUNK_OVERHEAD + PNG_IHDR_SIZE + 6 + filtered_size + filtered_size / 1024 + 64;
+}
+
+
+size_t get_png_encoder_memory_size (uint16_t width, uint16_t height, PixelFormat_t format)
+{
+    uint64_t filtered_size = get_png_filtered_size(width, height, format);
+    uint32_t row_size = get_image_row_size(width, format, 0);
+    uint64_t size = 0;
+
+    if (!filtered_size) return 0;
+
+    // The encoder, the filtered data, the candidate rows and the encoded image, plus room for aligning the memory
+    size = PNG_ALIGN_SIZE(sizeof(PngEncoder_t)) + PNG_ALIGN_SIZE(filtered_size) +
+           PNG_ALIGN_SIZE(2 * (row_size + 1) + row_size) + get_png_encoded_capacity(filtered_size) + 8;
+    if (size > SIZE_MAX) return 0;
+
+    return size;
+}
+
+
+uint8_t * encode_png_image (const Image_t * img, PngCompression_t compression, uint8_t * memory, size_t * size)
+{
+    PngEncoder_t * encoder = NULL;
+    uint8_t * filtered = NULL;
+    uint8_t * candidates = NULL;
+    uint8_t * zero_row = NULL;
+    const uint8_t * previous = NULL;
+    uint8_t * out = NULL;
+    uint32_t row_size = 0;
+    uint32_t cost = 0;
+    uint32_t best_cost = 0;
+    uint64_t filtered_size = 0;
+    size_t idat_start = 0;
+    uint32_t adler = 0;
+    uint16_t row = 0;
+    uint8_t step = 0;
+    uint8_t filter = 0;
+    uint8_t best_slot = 0;
+
+    if (!img) return NULL;
+    if (!img->data) return NULL;
+    if (!memory) return NULL;
+    if (!size) return NULL;
+    if (compression != PNG_COMPRESSION_FAST && compression != PNG_COMPRESSION_DEFAULT) return NULL;
+
+    filtered_size = get_png_filtered_size(img->width, img->height, img->format);
+    if (!filtered_size) return NULL;
+
+    step = (img->format == RGB24) ? 3 : 1;
+    row_size = get_image_row_size(img->width, img->format, 0);
+
+    memory += (8 - (uintptr_t) memory % 8) % 8;
+    encoder = (PngEncoder_t *) memory;
+    filtered = memory + PNG_ALIGN_SIZE(sizeof(PngEncoder_t));
+    candidates = filtered + PNG_ALIGN_SIZE(filtered_size);
+    out = candidates + PNG_ALIGN_SIZE(2 * (row_size + 1) + row_size);
+
+    zero_row = candidates + 2 * (row_size + 1);
+    memset(zero_row, 0, row_size);
+
+    // Fast compression sticks to the Paeth filter, the best on camera frames; otherwise, every row takes the filter
+    // that gives the smallest values
+    for (row = 0; row < img->height; row++) {
+        previous = row ? get_image_row(img, 0, row - 1) : zero_row;
+
+        if (compression == PNG_COMPRESSION_FAST) {
+            filter_png_row(PNG_FILTER_PAETH, get_image_row(img, 0, row), previous, row_size, step,
+                           filtered + (size_t) row * (row_size + 1));
+            continue;
+        }
+
+        // Candidates are filtered next to the best one so far
+        best_cost = UINT32_MAX;
+        for (filter = 0; filter < PNG_FILTER_COUNT; filter++) {
+            filter_png_row(filter, get_image_row(img, 0, row), previous, row_size, step,
+                           candidates + !best_slot * (row_size + 1));
+            cost = get_filtered_row_cost(candidates + !best_slot * (row_size + 1), row_size);
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_slot = !best_slot;
+            }
+        }
+        memcpy(filtered + (size_t) row * (row_size + 1), candidates + best_slot * (row_size + 1), row_size + 1);
+    }
+
+    memset(encoder, 0, sizeof(PngEncoder_t));
+    init_png_encoder(encoder);
+    encoder->out = out;
+
+    memcpy(out, png_signature, PNG_SIGNATURE_SIZE);
+    write_png_chunk_start(out + PNG_SIGNATURE_SIZE, "IHDR", PNG_IHDR_SIZE);
+    store_be32(out + PNG_SIGNATURE_SIZE + 8, img->width);
+    store_be32(out + PNG_SIGNATURE_SIZE + 12, img->height);
+    out[PNG_SIGNATURE_SIZE + 16] = 8;
+    out[PNG_SIGNATURE_SIZE + 17] = (img->format == RGB24) ? PNG_TRUECOLOR : PNG_GRAYSCALE;
+    memset(out + PNG_SIGNATURE_SIZE + 18, 0, 3);
+    store_be32(out + PNG_SIGNATURE_SIZE + 21, update_crc32(encoder, 0, out + PNG_SIGNATURE_SIZE + 4,
+                                                           4 + PNG_IHDR_SIZE));
+
+    idat_start = PNG_SIGNATURE_SIZE + PNG_CHUNK_OVERHEAD + PNG_IHDR_SIZE;
+    encoder->out_size = idat_start + 8;
+
+    // zlib header (32 KB window, and the compression level as a hint)
+    out[encoder->out_size++] = 0x78;
+    out[encoder->out_size++] = (compression == PNG_COMPRESSION_FAST) ? 0x01 : 0x9c;
+
+    if (compression == PNG_COMPRESSION_FAST) deflate_fast(encoder, filtered, filtered_size);
+    else deflate_default(encoder, filtered, filtered_size);
+    flush_deflate_bits(encoder);
+
+    adler = update_adler32(1, filtered, filtered_size);
+    store_be32(out + encoder->out_size, adler);
+    encoder->out_size += 4;
+
+    write_png_chunk_start(out + idat_start, "IDAT", encoder->out_size - idat_start - 8);
+    store_be32(out + encoder->out_size, update_crc32(encoder, 0, out + idat_start + 4,
+                                                     encoder->out_size - idat_start - 4));
+    encoder->out_size += 4;
+
+    write_png_chunk_start(out + encoder->out_size, "IEND", 0);
+    store_be32(out + encoder->out_size + 8, update_crc32(encoder, 0, (const uint8_t *) "IEND", 4));
+    encoder->out_size += PNG_CHUNK_OVERHEAD;
+
+    *size = encoder->out_size;
+
+    return out;
+}
+
+
+uint8_t save_png_image (const Image_t * img, const char * path, PngCompression_t compression)
+{
+    FILE * file = NULL;
+    uint8_t * memory = NULL;
+    uint8_t * data = NULL;
+    size_t size = 0;
+    uint8_t result = 0;
+
+    if (!img) return 0;
+    if (!path) return 0;
+
+    memory = create_buffer(get_png_encoder_memory_size(img->width, img->height, img->format));
+    if (!memory) return 0;
+
+    data = encode_png_image(img, compression, memory, &size);
+    if (data) {
+        file = fopen(path, "wb");
+        if (file) {
+            result = fwrite(data, 1, size, file) == size;
+            if (fclose(file)) result = 0;
+        }
+    }
+
+    destroy_buffer(memory);
+
+    return result;
+}
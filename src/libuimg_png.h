@@ -0,0 +1,147 @@
+#ifndef __LIB_UIMG_PNG_H__
+#define __LIB_UIMG_PNG_H__
+
+
+#include "libuimg_img.h"
+
+#include <stddef.h>
+
+
+/**
+ * @brief The compression effort of the PNG encoder.
+ */
+typedef enum {
+    /** The Paeth filter and run-length matching only: for dumping frames quickly, at the cost of larger files. */
+    PNG_COMPRESSION_FAST,
+    /** Per-row adaptive filters and hash-chain matching: smaller files, several times slower. */
+    PNG_COMPRESSION_DEFAULT
+} PngCompression_t;
+
+
+/**
+ * @brief      A row callback, as called by `decode_png_rows()`.
+ *
+ * @param      arg    The argument passed to `decode_png_rows()`.
+ * @param[in]  row    The decoded row, in the pixel format given by `get_png_info()` (only valid during the call).
+ * @param[in]  index  The index of the row (rows are decoded from top to bottom).
+ *
+ * @return     1 to go on decoding, 0 to stop (the decoding then fails).
+ */
+typedef uint8_t (* PngRowCallback_t) (void * arg, const uint8_t * row, uint16_t index);
+
+
+/**
+ * @brief      Get the size and pixel format a PNG image decodes to.
+ *
+ * Non-interlaced images of every color type and bit depth are supported: grayscale images (with or without alpha)
+ * decode to GRAYSCALE, and truecolor and palette images to RGB24. 16-bit samples are rounded to 8 bits, lower bit
+ * depths are rescaled to the full 8-bit range, and alpha channels (and tRNS chunks) are ignored.
+ *
+ * @param[in]  data    The encoded image.
+ * @param[in]  size    The size of the encoded image (in bytes).
+ * @param      width   The width of the image (in pixels).
+ * @param      height  The height of the image (in pixels).
+ * @param      format  The pixel format of the decoded image.
+ *
+ * @return     1 if successful, 0 if the image is malformed or unsupported.
+ */
+uint8_t get_png_info (const uint8_t * data, size_t size, uint16_t * width, uint16_t * height, PixelFormat_t * format);
+
+/**
+ * @brief      Get the size of the memory needed to decode a PNG image (see `decode_png_rows()`).
+ *
+ * It only depends on the width and pixel format of the image, and is about 160 KB for common frame sizes.
+ *
+ * @param[in]  data  The encoded image.
+ * @param[in]  size  The size of the encoded image (in bytes).
+ *
+ * @return     The size of the memory (in bytes), or 0 if the image is malformed or unsupported.
+ */
+uint32_t get_png_decoder_memory_size (const uint8_t * data, size_t size);
+
+/**
+ * @brief      Decode a PNG image row by row.
+ *
+ * Only a window of the compressed stream and two rows are held in memory, whatever the size of the image, so rows can
+ * be processed (or sent out) as they are decoded. The Adler-32 checksum of the image data is verified once the last
+ * row has been decoded (chunk CRCs are not).
+ *
+ * @param[in]  data      The encoded image.
+ * @param[in]  size      The size of the encoded image (in bytes).
+ * @param[in]  callback  The function called with every decoded row.
+ * @param      arg       Passed as-is to `callback`.
+ * @param      memory    The workspace of the decoder, of at least `get_png_decoder_memory_size()` bytes.
+ *
+ * @return     1 if successful, 0 if the image is malformed, truncated or unsupported, or the callback stopped the
+ *             decoding.
+ */
+uint8_t decode_png_rows (const uint8_t * data, size_t size, PngRowCallback_t callback, void * arg, uint8_t * memory);
+
+/**
+ * @brief      Decode a PNG image from memory (see `get_png_info()` for the supported images).
+ *
+ * @param[in]  data    The encoded image.
+ * @param[in]  size    The size of the encoded image (in bytes).
+ * @param      img     The decoded image, with the size and pixel format given by `get_png_info()` (strides and views
+ *                     are honored).
+ * @param      memory  The workspace of the decoder, of at least `get_png_decoder_memory_size()` bytes.
+ *
+ * @return     1 if successful, 0 if the image is malformed, truncated or unsupported, or does not match `img`.
+ */
+uint8_t decode_png_image (const uint8_t * data, size_t size, Image_t * img, uint8_t * memory);
+
+/**
+ * @brief      Load a PNG image from a file (see `decode_png_image()`).
+ *
+ * The file is memory-mapped where the OS supports it. The image and the workspace of the decoder are created with
+ * `create_image()` and `create_buffer()`.
+ *
+ * @param[in]  path  The path of the file.
+ *
+ * @return     The loaded image (to be destroyed with `destroy_image()`), or NULL if it could not be loaded.
+ */
+Image_t * load_png_image (const char * path);
+
+/**
+ * @brief      Get the size of the memory needed to encode an image (see `encode_png_image()`).
+ *
+ * It covers the state of the encoder, the filtered image and the largest possible encoded image.
+ *
+ * @param[in]  width   The width of the image (in pixels).
+ * @param[in]  height  The height of the image (in pixels).
+ * @param[in]  format  The pixel format of the image (RGB24 or GRAYSCALE).
+ *
+ * @return     The size of the memory (in bytes), or 0 if the image cannot be encoded.
+ */
+size_t get_png_encoder_memory_size (uint16_t width, uint16_t height, PixelFormat_t format);
+
+/**
+ * @brief      Encode an RGB24 or GRAYSCALE image as an 8-bit PNG image.
+ *
+ * Images of other formats must be converted first.
+ *
+ * @param[in]  img          The image to encode (strides and views are honored).
+ * @param[in]  compression  The compression effort.
+ * @param      memory       The workspace of the encoder, of at least `get_png_encoder_memory_size()` bytes.
+ * @param      size         The size of the encoded image (in bytes).
+ *
+ * @return     The encoded image, stored in `memory` (and valid until it is reused), or NULL if the image could not be
+ *             encoded.
+ */
+uint8_t * encode_png_image (const Image_t * img, PngCompression_t compression, uint8_t * memory, size_t * size);
+
+/**
+ * @brief      Save an RGB24 or GRAYSCALE image as an 8-bit PNG file (see `encode_png_image()`).
+ *
+ * The workspace of the encoder is created with `create_buffer()`.
+ *
+ * @param[in]  img          The image to save (strides and views are honored).
+ * @param[in]  path         The path of the file (any existing file is overwritten).
+ * @param[in]  compression  The compression effort.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t save_png_image (const Image_t * img, const char * path, PngCompression_t compression);
+
+
+#endif
@@ -0,0 +1,259 @@
+#include "libuimg_pnm.h"
+
+#include <string.h>
+
+
+#if defined(__linux__) || defined(__APPLE__)
+#define LIBUIMG_HAS_MMAP 1
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#endif
+
+
+#define PNM_MAX_HEADER_SIZE 64 /**< The size of the buffer the header of saved images is written to. */
+
+#ifdef LIBUIMG_HAS_MMAP
+#ifdef IOV_MAX
+#define PNM_MAX_IOVECS (IOV_MAX < 1024 ? IOV_MAX : 1024) /**< The number of buffers written by a single `writev()`. */
+#else
+#define PNM_MAX_IOVECS 16
+#endif
+#endif
+
+
+/**
+ * @brief The header of a PNM image.
+ */
+typedef struct {
+    /** The width of the image (in pixels). */
+    uint16_t width;
+    /** The height of the image (in pixels). */
+    uint16_t height;
+    /** RGB24 for PPM images, GRAYSCALE for PGM images. */
+    PixelFormat_t format;
+    /** The value of a full-intensity sample. */
+    uint16_t max_value;
+    /** The size of the header, which the pixel data directly follows (in bytes). */
+    size_t size;
+} PnmHeader_t;
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * DECODING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static uint8_t is_pnm_whitespace (uint8_t c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+
+// Skip whitespace and comments, then parse a positive number of at most `max_value`; return 0 if there is none
+static uint32_t parse_pnm_number (const uint8_t * data, size_t size, size_t * offset, uint32_t max_value)
+{
+    uint32_t value = 0;
+    uint8_t digits = 0;
+
+    while (*offset < size && (is_pnm_whitespace(data[*offset]) || data[*offset] == '#')) {
+        // Comments run up to the end of the line
+        if (data[*offset] == '#') {
+            while (*offset < size && data[*offset] != '\n' && data[*offset] != '\r') (*offset)++;
+        } else {
+            (*offset)++;
+        }
+    }
+
+    while (*offset < size && data[*offset] >= '0' && data[*offset] <= '9') {
+        value = value * 10 + (data[*offset] - '0');
+        if (value > max_value) return 0;
+        digits++;
+        (*offset)++;
+    }
+
+    return digits ? value : 0;
+}
+
+
+static uint8_t parse_pnm_header (const uint8_t * data, size_t size, PnmHeader_t * header)
+{
+    size_t offset = 2;
+    uint32_t data_size = 0;
+
+    if (size < 2 || data[0] != 'P') return 0;
+    if (data[1] == '6') header->format = RGB24;
+    else if (data[1] == '5') header->format = GRAYSCALE;
+    else return 0;
+
+    header->width = parse_pnm_number(data, size, &offset, UINT16_MAX);
+    if (!header->width) return 0;
+    header->height = parse_pnm_number(data, size, &offset, UINT16_MAX);
+    if (!header->height) return 0;
+    header->max_value = parse_pnm_number(data, size, &offset, 255);
+    if (!header->max_value) return 0;
+
+    // A single whitespace character separates the header from the pixel data
+    if (offset >= size || !is_pnm_whitespace(data[offset])) return 0;
+    header->size = offset + 1;
+
+    // Images whose pixel data does not fit in 32 bits are rejected rather than read into a wrapped-around buffer
+    data_size = get_image_data_size(header->width, header->height, header->format);
+    if (!data_size) return 0;
+
+    return size - header->size >= data_size;
+}
+
+
+Image_t * decode_pnm_image (const uint8_t * data, size_t size)
+{
+    uint32_t i = 0;
+    uint32_t data_size = 0;
+    uint8_t rescale_LUT[256];
+    PnmHeader_t header;
+    Image_t * img = NULL;
+
+    if (!data) return NULL;
+    if (!parse_pnm_header(data, size, &header)) return NULL;
+
+    img = create_image(header.width, header.height, header.format);
+    if (!img) return NULL;
+
+    data_size = get_image_data_size(header.width, header.height, header.format);
+    memcpy(img->data, data + header.size, data_size);
+
+    if (header.max_value != 255) {
+        for (i = 0; i < 256; i++) {
+            // Out-of-range samples are clamped
+            rescale_LUT[i] = (i >= header.max_value) ? 255 : (i * 255 + header.max_value / 2) / header.max_value;
+        }
+
+        for (i = 0; i < data_size; i++) {
+            img->data[i] = rescale_LUT[img->data[i]];
+        }
+    }
+
+    return img;
+}
+
+
+Image_t * load_pnm_image (const char * path)
+{
+    Image_t * img = NULL;
+#ifdef LIBUIMG_HAS_MMAP
+    int32_t fd = -1;
+    void * memory = NULL;
+    struct stat file_stat;
+
+    if (!path) return NULL;
+
+    fd = (int32_t) open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    if (fstat(fd, &file_stat) || file_stat.st_size <= 0) {
+        close(fd);
+        return NULL;
+    }
+
+    memory = mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return NULL;
+
+    img = decode_pnm_image(memory, file_stat.st_size);
+    munmap(memory, file_stat.st_size);
+#else
+    FILE * file = NULL;
+    int64_t size = 0;
+    uint8_t * data = NULL;
+
+    if (!path) return NULL;
+
+    file = fopen(path, "rb");
+    if (!file) return NULL;
+
+    if (!fseek(file, 0, SEEK_END) && (size = (int64_t) ftell(file)) > 0 && !fseek(file, 0, SEEK_SET)) {
+        data = create_buffer(size);
+        if (data && fread(data, 1, size, file) == (size_t) size) img = decode_pnm_image(data, size);
+        destroy_buffer(data);
+    }
+
+    fclose(file);
+#endif
+
+    return img;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * ENCODING
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+uint8_t save_pnm_image (const Image_t * img, const char * path)
+{
+    char header[PNM_MAX_HEADER_SIZE];
+    int32_t header_size = 0;
+    uint16_t row = 0;
+    uint32_t row_size = 0;
+    uint8_t result = 1;
+#ifdef LIBUIMG_HAS_MMAP
+    int32_t fd = -1;
+    uint16_t count = 0;
+    ssize_t expected_size = 0;
+    struct iovec buffers[PNM_MAX_IOVECS];
+#else
+    FILE * file = NULL;
+#endif
+
+    if (!img) return 0;
+    if (!img->data) return 0;
+    if (!path) return 0;
+    if (img->format != RGB24 && img->format != GRAYSCALE) return 0;
+    // Empty images cannot be represented
+    if (!img->width || !img->height) return 0;
+
+    header_size = (int32_t) snprintf(header, sizeof(header), "P%c\n%u %u\n255\n", (img->format == RGB24) ? '6' : '5',
+                                     img->width, img->height);
+    row_size = get_image_row_size(img->width, img->format, 0);
+
+#ifdef LIBUIMG_HAS_MMAP
+    fd = (int32_t) open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return 0;
+
+    // The header and the rows are gathered into as few writes as possible
+    buffers[0].iov_base = header;
+    buffers[0].iov_len = header_size;
+    expected_size = header_size;
+    count = 1;
+
+    for (row = 0; row < img->height && result; row++) {
+        buffers[count].iov_base = get_image_row(img, 0, row);
+        buffers[count].iov_len = row_size;
+        expected_size += row_size;
+        count++;
+
+        if (count == PNM_MAX_IOVECS || row == img->height - 1) {
+            result = writev(fd, buffers, count) == expected_size;
+            expected_size = 0;
+            count = 0;
+        }
+    }
+
+    if (close(fd)) result = 0;
+#else
+    file = fopen(path, "wb");
+    if (!file) return 0;
+
+    result = fwrite(header, 1, header_size, file) == (size_t) header_size;
+    for (row = 0; row < img->height && result; row++) {
+        result = fwrite(get_image_row(img, 0, row), 1, row_size, file) == row_size;
+    }
+
+    if (fclose(file)) result = 0;
+#endif
+
+    return result;
+}
@@ -0,0 +1,48 @@
+#ifndef __LIB_UIMG_PNM_H__
+#define __LIB_UIMG_PNM_H__
+
+
+#include "libuimg_img.h"
+
+#include <stddef.h>
+
+
+/**
+ * @brief      Decode a binary PPM (P6) or PGM (P5) image from memory.
+ *
+ * PPM images are decoded as RGB24, and PGM images as GRAYSCALE. Maximum values below 255 are rescaled to the full
+ * 8-bit range; 16-bit images (maximum values above 255) are not supported.
+ *
+ * @param[in]  data  The encoded image.
+ * @param[in]  size  The size of the encoded image (in bytes).
+ *
+ * @return     The decoded image (to be destroyed with `destroy_image()`), or NULL if the image is malformed or
+ *             unsupported.
+ */
+Image_t * decode_pnm_image (const uint8_t * data, size_t size);
+
+/**
+ * @brief      Load a binary PPM (P6) or PGM (P5) image from a file (see `decode_pnm_image()`).
+ *
+ * The file is memory-mapped where the OS supports it, so its pixel data is copied only once.
+ *
+ * @param[in]  path  The path of the file.
+ *
+ * @return     The loaded image (to be destroyed with `destroy_image()`), or NULL if it could not be loaded.
+ */
+Image_t * load_pnm_image (const char * path);
+
+/**
+ * @brief      Save an RGB24 image as a binary PPM (P6), or a GRAYSCALE image as a binary PGM (P5).
+ *
+ * Images of other formats must be converted first.
+ *
+ * @param[in]  img   The image to save (strides and views are honored).
+ * @param[in]  path  The path of the file (any existing file is overwritten).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t save_pnm_image (const Image_t * img, const char * path);
+
+
+#endif
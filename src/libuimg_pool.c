@@ -0,0 +1,120 @@
+#include "libuimg_pool.h"
+
+
+// Round a size up to a multiple of 8 bytes, so that every header and pixel buffer of the pool is aligned
+#define POOL_ALIGN_SIZE(size) (((size) + 7u) & ~7u)
+
+
+// Get the size of an image header and its pixel buffer; return 0 if the pixel data size does not fit in 32 bits
+static uint64_t get_image_pool_slot_size (uint16_t width, uint16_t height, PixelFormat_t format)
+{
+    uint64_t data_size = get_image_data_size(width, height, format);
+
+    if (!data_size && width && height) return 0;
+
+    return POOL_ALIGN_SIZE(sizeof(Image_t)) + POOL_ALIGN_SIZE(data_size);
+}
+
+
+uint32_t get_image_pool_memory_size (uint16_t width, uint16_t height, PixelFormat_t format, uint16_t capacity)
+{
+    uint64_t slot_size = get_image_pool_slot_size(width, height, format);
+    uint64_t size = 0;
+
+    if (!slot_size) return 0;
+
+    // Leave room to align the start of the memory
+    size = slot_size * capacity + 8;
+
+    return (size > UINT32_MAX) ? 0 : size;
+}
+
+
+uint8_t init_image_pool (ImagePool_t * pool,
+                         uint16_t width,
+                         uint16_t height,
+                         PixelFormat_t format,
+                         uint16_t capacity,
+                         uint8_t * memory)
+{
+    uint16_t i = 0;
+    Image_t * img = NULL;
+
+    if (!pool) return 0;
+    if (!memory) return 0;
+    if (!capacity) return 0;
+    // Free images are marked by a null width
+    if (!width || !height) return 0;
+    if (!get_image_pool_memory_size(width, height, format, capacity)) return 0;
+
+    pool->width = width;
+    pool->height = height;
+    pool->format = format;
+    pool->capacity = capacity;
+    pool->free_count = capacity;
+    pool->slot_size = get_image_pool_slot_size(width, height, format);
+    pool->slots = memory + (8 - (uintptr_t) memory % 8) % 8;
+    pool->free_list = NULL;
+
+    // Link every image in order, so that they are handed out from the start of the memory
+    for (i = capacity; i > 0; i--) {
+        img = (Image_t *) (pool->slots + (uint32_t) (i - 1) * pool->slot_size);
+        img->width = 0;
+        img->data = (uint8_t *) pool->free_list;
+        pool->free_list = img;
+    }
+
+    return 1;
+}
+
+
+Image_t * acquire_pooled_image (ImagePool_t * pool)
+{
+    Image_t * img = NULL;
+
+    if (!pool) return NULL;
+    if (!pool->free_list) return NULL;
+
+    img = pool->free_list;
+    pool->free_list = (Image_t *) img->data;
+    pool->free_count--;
+
+    init_image(img, pool->width, pool->height, pool->format, (uint8_t *) img + POOL_ALIGN_SIZE(sizeof(Image_t)),
+               NULL);
+
+    return img;
+}
+
+
+uint8_t release_pooled_image (ImagePool_t * pool, Image_t * img)
+{
+    uint32_t offset = 0;
+
+    if (!pool) return 0;
+    if (!img) return 0;
+    // The image must be the header of one of the slots of the pool
+    if ((uint8_t *) img < pool->slots) return 0;
+    offset = (uint8_t *) img - pool->slots;
+    if (offset % pool->slot_size || offset / pool->slot_size >= pool->capacity) return 0;
+
+    // Releasing an image twice would corrupt the free list
+    if (!img->width) return 0;
+
+    img->width = 0;
+    img->data = (uint8_t *) pool->free_list;
+    pool->free_list = img;
+    pool->free_count++;
+
+    return 1;
+}
+
+
+void destroy_image_pool (ImagePool_t * pool)
+{
+    if (!pool) return;
+
+    pool->slots = NULL;
+    pool->free_list = NULL;
+    pool->free_count = 0;
+    pool->capacity = 0;
+}
@@ -0,0 +1,104 @@
+#ifndef __LIB_UIMG_POOL_H__
+#define __LIB_UIMG_POOL_H__
+
+
+#include "libuimg_img.h"
+
+
+/**
+ * @brief A pool of images of the same dimensions and format.
+ *
+ * Every image of the pool lives in a single block of memory, with its pixel data right after its header; images are
+ * handed out and given back in constant time, and their pixel data is never zeroed (conversions overwrite all of it
+ * anyway). The block of memory is supplied by the caller: a static array (e.g. on bare-metal targets), or a buffer
+ * created with `create_buffer()`.
+ *
+ * Pools are not thread-safe: images should be acquired and released from a single thread.
+ */
+typedef struct {
+    /** The width of the images of the pool (in pixels). */
+    uint16_t width;
+    /** The height of the images of the pool (in pixels). */
+    uint16_t height;
+    /** The pixel format of the images of the pool. */
+    PixelFormat_t format;
+    /** The number of images of the pool. */
+    uint16_t capacity;
+    /** The number of images that can currently be acquired. */
+    uint16_t free_count;
+    /** The size of the header and pixel data of an image (in bytes). */
+    uint32_t slot_size;
+    /** The (aligned) start of the images. */
+    uint8_t * slots;
+    /**
+     * The first image that can be acquired (NULL if none).
+     * Free images have a null width, and are linked through their `data` field.
+     */
+    Image_t * free_list;
+} ImagePool_t;
+
+
+/**
+ * @brief      Get the size of the memory needed by an image pool.
+ *
+ * @param[in]  width     The width of the images (in pixels).
+ * @param[in]  height    The height of the images (in pixels).
+ * @param[in]  format    The pixel format of the images.
+ * @param[in]  capacity  The number of images.
+ *
+ * @return     The size of the memory (in bytes), or 0 if it does not fit in 32 bits.
+ */
+uint32_t get_image_pool_memory_size (uint16_t width, uint16_t height, PixelFormat_t format, uint16_t capacity);
+
+/**
+ * @brief      Initialize an image pool.
+ *
+ * @param      pool      The pool to initialize.
+ * @param[in]  width     The width of the images (in pixels, not null).
+ * @param[in]  height    The height of the images (in pixels, not null).
+ * @param[in]  format    The pixel format of the images.
+ * @param[in]  capacity  The number of images.
+ * @param      memory    A block of `get_image_pool_memory_size()` bytes that will hold the images.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t init_image_pool (ImagePool_t * pool,
+                         uint16_t width,
+                         uint16_t height,
+                         PixelFormat_t format,
+                         uint16_t capacity,
+                         uint8_t * memory);
+
+/**
+ * @brief      Take an image out of a pool.
+ *
+ * The pixel data of the image is left as it was when the image was last released (it is not zeroed).
+ *
+ * @param      pool  The pool.
+ *
+ * @return     The image, or NULL if every image of the pool is in use.
+ */
+Image_t * acquire_pooled_image (ImagePool_t * pool);
+
+/**
+ * @brief      Give an image back to the pool it was taken from.
+ *
+ * The image must not be used after it has been released, and must never be passed to `destroy_image()`.
+ *
+ * @param      pool  The pool.
+ * @param      img   The image, as returned by `acquire_pooled_image()`.
+ *
+ * @return     1 if successful, 0 otherwise (the image does not belong to the pool, or was already released).
+ */
+uint8_t release_pooled_image (ImagePool_t * pool, Image_t * img);
+
+/**
+ * @brief      Destroy an image pool (its memory stays owned by the caller, and can be reused once the pool is
+ *             destroyed).
+ *
+ * @param      pool  The pool.
+ */
+void destroy_image_pool (ImagePool_t * pool);
+
+
+#endif
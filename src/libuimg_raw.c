@@ -0,0 +1,223 @@
+#include "libuimg_raw.h"
+
+#include <string.h>
+
+
+#if defined(__linux__) || defined(__APPLE__)
+#define LIBUIMG_HAS_MMAP 1
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+// Copy every row of every plane of an image into another image of the same dimensions and format
+static void copy_image_rows (const Image_t * src_img, Image_t * dst_img)
+{
+    uint8_t plane = 0;
+    uint16_t row = 0;
+
+    for (plane = 0; plane < get_image_plane_count(src_img->format); plane++) {
+        for (row = 0; row < get_image_plane_height(src_img->height, src_img->format, plane); row++) {
+            memcpy(get_image_row(dst_img, plane, row), get_image_row(src_img, plane, row),
+                   get_image_row_size(src_img->width, src_img->format, plane));
+        }
+    }
+}
+
+
+#ifdef LIBUIMG_HAS_MMAP
+
+// Map an open file, and fill in the fields of the raw file
+static uint8_t map_raw_file (RawFile_t * file,
+                             int32_t fd,
+                             size_t size,
+                             uint16_t width,
+                             uint16_t height,
+                             PixelFormat_t format,
+                             uint8_t mode)
+{
+    void * memory = NULL;
+    int32_t protection = (mode == RAW_FILE_READ_ONLY) ? PROT_READ : PROT_READ | PROT_WRITE;
+    int32_t flags = (mode == RAW_FILE_WRITE) ? MAP_SHARED : MAP_PRIVATE;
+
+    memory = mmap(NULL, size, protection, flags, fd, 0);
+    if (memory == MAP_FAILED) return 0;
+
+#ifdef MADV_SEQUENTIAL
+    // Files are usually processed frame after frame, so the OS may read ahead aggressively
+    madvise(memory, size, MADV_SEQUENTIAL);
+#endif
+
+    file->width = width;
+    file->height = height;
+    file->format = format;
+    file->frame_size = get_image_data_size(width, height, format);
+    file->frame_count = size / file->frame_size;
+    file->mode = mode;
+    file->memory = memory;
+    file->size = size;
+
+    return 1;
+}
+
+
+uint8_t open_raw_file (RawFile_t * file,
+                       const char * path,
+                       uint16_t width,
+                       uint16_t height,
+                       PixelFormat_t format,
+                       uint8_t mode)
+{
+    int32_t fd = -1;
+    uint8_t result = 0;
+    struct stat file_stat;
+
+    if (!file) return 0;
+    file->memory = NULL;
+    if (!path) return 0;
+    if (mode > RAW_FILE_WRITE) return 0;
+    if (!get_image_data_size(width, height, format)) return 0;
+
+    fd = (int32_t) open(path, (mode == RAW_FILE_WRITE) ? O_RDWR : O_RDONLY);
+    if (fd < 0) return 0;
+
+    // The mapping keeps the file alive, so the descriptor can be closed right away
+    if (!fstat(fd, &file_stat) && (uint64_t) file_stat.st_size >= get_image_data_size(width, height, format)) {
+        result = map_raw_file(file, fd, file_stat.st_size, width, height, format, mode);
+    }
+
+    close(fd);
+
+    return result;
+}
+
+
+uint8_t create_raw_file (RawFile_t * file,
+                         const char * path,
+                         uint16_t width,
+                         uint16_t height,
+                         PixelFormat_t format,
+                         uint32_t frame_count)
+{
+    int32_t fd = -1;
+    uint8_t result = 0;
+    uint64_t size = (uint64_t) get_image_data_size(width, height, format) * frame_count;
+
+    if (!file) return 0;
+    file->memory = NULL;
+    if (!path) return 0;
+    if (!size || size != (size_t) size) return 0;
+
+    fd = (int32_t) open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return 0;
+
+    if (!ftruncate(fd, size)) result = map_raw_file(file, fd, size, width, height, format, RAW_FILE_WRITE);
+
+    close(fd);
+
+    return result;
+}
+
+
+void close_raw_file (RawFile_t * file)
+{
+    if (!file) return;
+    if (!file->memory) return;
+
+    munmap(file->memory, file->size);
+    file->memory = NULL;
+    file->size = 0;
+    file->frame_count = 0;
+}
+
+#else
+
+// Bare-metal targets have no file system
+
+uint8_t open_raw_file (RawFile_t * file,
+                       const char * path,
+                       uint16_t width,
+                       uint16_t height,
+                       PixelFormat_t format,
+                       uint8_t mode)
+{
+    (void) file;
+    (void) path;
+    (void) width;
+    (void) height;
+    (void) format;
+    (void) mode;
+
+    return 0;
+}
+
+
+uint8_t create_raw_file (RawFile_t * file,
+                         const char * path,
+                         uint16_t width,
+                         uint16_t height,
+                         PixelFormat_t format,
+                         uint32_t frame_count)
+{
+    (void) file;
+    (void) path;
+    (void) width;
+    (void) height;
+    (void) format;
+    (void) frame_count;
+
+    return 0;
+}
+
+
+void close_raw_file (RawFile_t * file)
+{
+    (void) file;
+}
+
+#endif
+
+
+uint8_t get_raw_file_frame (const RawFile_t * file, uint32_t index, Image_t * frame)
+{
+    if (!file) return 0;
+    if (!file->memory) return 0;
+    if (index >= file->frame_count) return 0;
+
+    return init_image(frame, file->width, file->height, file->format,
+                      file->memory + (size_t) index * file->frame_size, NULL);
+}
+
+
+uint8_t load_raw_image (const char * path, Image_t * img)
+{
+    RawFile_t file;
+    Image_t frame;
+
+    if (!img) return 0;
+    if (!open_raw_file(&file, path, img->width, img->height, img->format, RAW_FILE_READ_ONLY)) return 0;
+
+    get_raw_file_frame(&file, 0, &frame);
+    copy_image_rows(&frame, img);
+    close_raw_file(&file);
+
+    return 1;
+}
+
+
+uint8_t save_raw_image (const Image_t * img, const char * path)
+{
+    RawFile_t file;
+    Image_t frame;
+
+    if (!img) return 0;
+    if (!create_raw_file(&file, path, img->width, img->height, img->format, 1)) return 0;
+
+    get_raw_file_frame(&file, 0, &frame);
+    copy_image_rows(img, &frame);
+    close_raw_file(&file);
+
+    return 1;
+}
@@ -0,0 +1,127 @@
+#ifndef __LIB_UIMG_RAW_H__
+#define __LIB_UIMG_RAW_H__
+
+
+#include "libuimg_img.h"
+
+#include <stddef.h>
+
+
+#define RAW_FILE_READ_ONLY 0      /**< Map the file read-only (writing to its frames crashes). */
+#define RAW_FILE_COPY_ON_WRITE 1  /**< Map the file privately: its frames can be modified, but the file is not. */
+#define RAW_FILE_WRITE 2          /**< Map the file shared: modifying its frames modifies the file. */
+
+
+/**
+ * @brief A memory-mapped raw video file (headerless frames of the same dimensions and format, one after the other,
+ *        such as `.yuv` or `.rgb` dumps).
+ *
+ * The frames of the file are accessed through views pointing directly into the mapping, so nothing is copied; the
+ * OS only reads the pages of the file that are actually accessed.
+ */
+typedef struct {
+    /** The width of the frames (in pixels). */
+    uint16_t width;
+    /** The height of the frames (in pixels). */
+    uint16_t height;
+    /** The pixel format of the frames. */
+    PixelFormat_t format;
+    /** The size of a frame (in bytes). */
+    uint32_t frame_size;
+    /** The number of (complete) frames of the file. */
+    uint32_t frame_count;
+    /** How the file is mapped (`RAW_FILE_READ_ONLY`, `RAW_FILE_COPY_ON_WRITE` or `RAW_FILE_WRITE`). */
+    uint8_t mode;
+    /** The mapping of the file. */
+    uint8_t * memory;
+    /** The size of the mapping (in bytes). */
+    size_t size;
+} RawFile_t;
+
+
+/**
+ * @brief      Open a raw video file, and map it into memory.
+ *
+ * Trailing bytes that do not make up a complete frame are ignored.
+ *
+ * @param      file    The file to open.
+ * @param[in]  path    The path of the file.
+ * @param[in]  width   The width of the frames (in pixels).
+ * @param[in]  height  The height of the frames (in pixels).
+ * @param[in]  format  The pixel format of the frames.
+ * @param[in]  mode    How the file is mapped (`RAW_FILE_READ_ONLY`, `RAW_FILE_COPY_ON_WRITE` or `RAW_FILE_WRITE`).
+ *
+ * @return     1 if successful, 0 otherwise (including if the file does not hold a single frame).
+ */
+uint8_t open_raw_file (RawFile_t * file,
+                       const char * path,
+                       uint16_t width,
+                       uint16_t height,
+                       PixelFormat_t format,
+                       uint8_t mode);
+
+/**
+ * @brief      Create a raw video file of a given number of frames, and map it into memory (with `RAW_FILE_WRITE`).
+ *
+ * Frames are written by writing to their views (for example, by converting images into them); any existing file is
+ * overwritten.
+ *
+ * @param      file         The file to create.
+ * @param[in]  path         The path of the file.
+ * @param[in]  width        The width of the frames (in pixels).
+ * @param[in]  height       The height of the frames (in pixels).
+ * @param[in]  format       The pixel format of the frames.
+ * @param[in]  frame_count  The number of frames.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t create_raw_file (RawFile_t * file,
+                         const char * path,
+                         uint16_t width,
+                         uint16_t height,
+                         PixelFormat_t format,
+                         uint32_t frame_count);
+
+/**
+ * @brief      Get a view on a frame of a raw video file.
+ *
+ * The view points directly into the mapping of the file, so it is only valid until the file is closed; it must not be
+ * passed to `destroy_image()`.
+ *
+ * @param[in]  file   The file.
+ * @param[in]  index  The index of the frame.
+ * @param      frame  The resulting view.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t get_raw_file_frame (const RawFile_t * file, uint32_t index, Image_t * frame);
+
+/**
+ * @brief      Close a raw video file, unmapping it (modified frames of `RAW_FILE_WRITE` files are written back).
+ *
+ * @param      file  The file.
+ */
+void close_raw_file (RawFile_t * file);
+
+/**
+ * @brief      Load an image from a raw file (its first frame), copying it into an image of the same dimensions.
+ *
+ * @param[in]  path  The path of the file.
+ * @param      img   The image to load into (its dimensions and format tell how to read the file).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t load_raw_image (const char * path, Image_t * img);
+
+/**
+ * @brief      Save an image to a raw file (tightly packed, whatever the strides of the image).
+ *
+ * @param[in]  img   The image to save.
+ * @param[in]  path  The path of the file (any existing file is overwritten).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t save_raw_image (const Image_t * img, const char * path);
+
+
+#endif
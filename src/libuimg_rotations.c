@@ -0,0 +1,348 @@
+#include "libuimg_rotations.h"
+#include "libuimg_flips.h"
+#include "libuimg_simd.h"
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * HIGH-LEVEL ROTATION FUNCTIONS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Size (in bytes) of a pixel of a plane of a format
+static uint8_t get_pixel_size (PixelFormat_t format, uint8_t plane)
+{
+    switch (format) {
+        case YUV444:
+        case RGB24:
+        case BGR24:
+            return 3;
+
+        case RGBA8888:
+        case BGRA8888:
+        case XRGB8888:
+            return 4;
+
+        case RGB565:
+            return 2;
+
+        case NV12:
+        case NV21:
+            // U, V pairs are moved together
+            return plane ? 2 : 1;
+
+        default:
+            return 1;
+    }
+}
+
+
+// Rotate a YUYV or UYVY image by 180 degrees: rows are swapped, then mirrored (see `flipY_422()`)
+static uint8_t rotate180_422 (const Image_t * base_img, Image_t * rotated_img)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint16_t height = 0;
+    uint32_t row_size = 0;
+    uint8_t temp_data = 0;
+    const uint8_t * src_top = NULL;
+    const uint8_t * src_bottom = NULL;
+    uint8_t * dst_top = NULL;
+    uint8_t * dst_bottom = NULL;
+
+    if (base_img->width != rotated_img->width || base_img->height != rotated_img->height) return 0;
+
+    height = base_img->height;
+    row_size = get_image_row_size(base_img->width, base_img->format, 0);
+
+    // Both rows are read before being written, so this works in place
+    for (i = 0; i < (height + 1) / 2u; i++) {
+        src_top = get_image_row(base_img, 0, i);
+        src_bottom = get_image_row(base_img, 0, height - 1 - i);
+        dst_top = get_image_row(rotated_img, 0, i);
+        dst_bottom = get_image_row(rotated_img, 0, height - 1 - i);
+
+        for (j = 0; j < row_size; j++) {
+            temp_data = src_top[j];
+            dst_top[j] = src_bottom[j];
+            dst_bottom[j] = temp_data;
+        }
+    }
+
+    return flipY_422(rotated_img, base_img->format == UYVY);
+}
+
+
+uint8_t rotate_image (Image_t * base_img, Image_t * rotated_img, uint16_t degrees)
+{
+    uint8_t plane = 0;
+    uint8_t (* rotate_plane) (const Image_t * base_img, Image_t * rotated_img, uint8_t plane, uint8_t pixel_size);
+
+    // Check image pointers
+    if (!base_img) return 0;
+    if (!rotated_img) return 0;
+    // Rotations never change the format
+    if (base_img->format != rotated_img->format) return 0;
+
+    switch (degrees) {
+        case 90:
+            rotate_plane = rotate90_plane;
+            break;
+
+        case 180:
+            rotate_plane = rotate180_plane;
+            break;
+
+        case 270:
+            rotate_plane = rotate270_plane;
+            break;
+
+        default:
+            return 0;
+    }
+
+    if (base_img->format == YUYV || base_img->format == UYVY) {
+        // Macropixels cover two pixels of a row, so they would have to be resampled to cover two pixels of a column
+        if (degrees != 180) return 0;
+        return rotate180_422(base_img, rotated_img);
+    }
+
+    if (degrees == 180) {
+        if (base_img->width != rotated_img->width || base_img->height != rotated_img->height) return 0;
+    } else {
+        if (base_img->width != rotated_img->height || base_img->height != rotated_img->width) return 0;
+        // Transposes cannot be done in place
+        if (base_img == rotated_img || base_img->data == rotated_img->data) return 0;
+    }
+
+    for (plane = 0; plane < get_image_plane_count(base_img->format); plane++) {
+        if (!rotate_plane(base_img, rotated_img, plane, get_pixel_size(base_img->format, plane))) return 0;
+    }
+
+    return 1;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * LOW-LEVEL ROTATION FUNCTIONS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Transpose a tile of pixels of any size: the pixel at (x, y) of `src` goes to (y, x) of `dst`
+static inline void transpose_tile (const uint8_t * src,
+                                   int32_t src_stride,
+                                   uint8_t * dst,
+                                   int32_t dst_stride,
+                                   uint16_t width,
+                                   uint16_t height,
+                                   uint8_t pixel_size)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint8_t k = 0;
+    const uint8_t * src_row = NULL;
+    uint8_t * dst_pixel = NULL;
+
+    for (i = 0; i < height; i++) {
+        src_row = src + (int32_t) i * src_stride;
+
+        for (j = 0; j < width; j++) {
+            dst_pixel = dst + (int32_t) j * dst_stride + i * pixel_size;
+
+            for (k = 0; k < pixel_size; k++) {
+                dst_pixel[k] = src_row[j * pixel_size + k];
+            }
+        }
+    }
+}
+
+
+// Transpose a whole plane, one tile at a time, so that the rows of both planes being walked through stay in the cache
+static void transpose_plane (const uint8_t * src,
+                             int32_t src_stride,
+                             uint8_t * dst,
+                             int32_t dst_stride,
+                             uint16_t width,
+                             uint16_t height,
+                             uint8_t pixel_size)
+{
+    uint32_t tile_x = 0;
+    uint32_t tile_y = 0;
+    uint16_t tile_width = 0;
+    uint16_t tile_height = 0;
+    const uint8_t * src_tile = NULL;
+    uint8_t * dst_tile = NULL;
+
+    for (tile_y = 0; tile_y < height; tile_y += ROTATION_TILE_SIZE) {
+        tile_height = (height - tile_y < ROTATION_TILE_SIZE) ? height - tile_y : ROTATION_TILE_SIZE;
+
+        for (tile_x = 0; tile_x < width; tile_x += ROTATION_TILE_SIZE) {
+            tile_width = (width - tile_x < ROTATION_TILE_SIZE) ? width - tile_x : ROTATION_TILE_SIZE;
+
+            src_tile = src + (int32_t) tile_y * src_stride + tile_x * pixel_size;
+            dst_tile = dst + (int32_t) tile_x * dst_stride + tile_y * pixel_size;
+
+            // Constant pixel sizes let the compiler unroll the copy of each pixel
+            switch (pixel_size) {
+                case 1:
+                    transpose_8bpp_block(src_tile, src_stride, dst_tile, dst_stride, tile_width, tile_height);
+                    break;
+
+                case 2:
+                    transpose_tile(src_tile, src_stride, dst_tile, dst_stride, tile_width, tile_height, 2);
+                    break;
+
+                case 3:
+                    transpose_tile(src_tile, src_stride, dst_tile, dst_stride, tile_width, tile_height, 3);
+                    break;
+
+                case 4:
+                    transpose_tile(src_tile, src_stride, dst_tile, dst_stride, tile_width, tile_height, 4);
+                    break;
+
+                default:
+                    transpose_tile(src_tile, src_stride, dst_tile, dst_stride, tile_width, tile_height, pixel_size);
+                    break;
+            }
+        }
+    }
+}
+
+
+// Check that a plane of the rotated image has the dimensions of the transposed plane of the base image
+static uint8_t check_transposed_plane (const Image_t * base_img,
+                                       const Image_t * rotated_img,
+                                       uint8_t plane,
+                                       uint8_t pixel_size)
+{
+    if (!base_img) return 0;
+    if (!rotated_img) return 0;
+    if (plane >= get_image_plane_count(base_img->format)) return 0;
+    if (!pixel_size) return 0;
+
+    return get_image_row_size(base_img->width, base_img->format, plane) / pixel_size ==
+               get_image_plane_height(rotated_img->height, rotated_img->format, plane) &&
+           get_image_row_size(rotated_img->width, rotated_img->format, plane) / pixel_size ==
+               get_image_plane_height(base_img->height, base_img->format, plane);
+}
+
+
+uint8_t rotate90_plane (const Image_t * base_img, Image_t * rotated_img, uint8_t plane, uint8_t pixel_size)
+{
+    uint16_t height = 0;
+
+    if (!check_transposed_plane(base_img, rotated_img, plane, pixel_size)) return 0;
+
+    height = get_image_plane_height(base_img->height, base_img->format, plane);
+    if (!height) return 1;
+
+    // Rotating clockwise is transposing the base plane with its rows in reverse order
+    transpose_plane(get_image_row(base_img, plane, height - 1),
+                    -get_image_stride(base_img, plane),
+                    get_image_plane(rotated_img, plane),
+                    get_image_stride(rotated_img, plane),
+                    get_image_row_size(base_img->width, base_img->format, plane) / pixel_size,
+                    height,
+                    pixel_size);
+
+    return 1;
+}
+
+
+// Row `src_top` becomes row `dst_bottom`, reversed, and row `src_bottom` becomes row `dst_top`, reversed (only the
+// first `count` pixels of `src_top` are gone through, so that the middle row of a plane can be reversed in place)
+static inline void reverse_row_pair (const uint8_t * src_top,
+                                     const uint8_t * src_bottom,
+                                     uint8_t * dst_top,
+                                     uint8_t * dst_bottom,
+                                     uint16_t width,
+                                     uint16_t count,
+                                     uint8_t pixel_size)
+{
+    uint32_t j = 0;
+    uint8_t k = 0;
+    uint8_t temp_data = 0;
+
+    for (j = 0; j < count; j++) {
+        for (k = 0; k < pixel_size; k++) {
+            temp_data = src_top[j * pixel_size + k];
+            dst_top[j * pixel_size + k] = src_bottom[(width - 1 - j) * pixel_size + k];
+            dst_bottom[(width - 1 - j) * pixel_size + k] = temp_data;
+        }
+    }
+}
+
+
+uint8_t rotate180_plane (const Image_t * base_img, Image_t * rotated_img, uint8_t plane, uint8_t pixel_size)
+{
+    uint32_t i = 0;
+    uint16_t count = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    const uint8_t * src_top = NULL;
+    const uint8_t * src_bottom = NULL;
+    uint8_t * dst_top = NULL;
+    uint8_t * dst_bottom = NULL;
+
+    if (!base_img) return 0;
+    if (!rotated_img) return 0;
+    if (plane >= get_image_plane_count(base_img->format)) return 0;
+    if (!pixel_size) return 0;
+    if (base_img->width != rotated_img->width || base_img->height != rotated_img->height) return 0;
+
+    width = get_image_row_size(base_img->width, base_img->format, plane) / pixel_size;
+    height = get_image_plane_height(base_img->height, base_img->format, plane);
+
+    // Row i becomes row height - 1 - i, reversed (and vice versa), so both rows are done at once; this works in place
+    for (i = 0; i < (height + 1) / 2u; i++) {
+        src_top = get_image_row(base_img, plane, i);
+        src_bottom = get_image_row(base_img, plane, height - 1 - i);
+        dst_top = get_image_row(rotated_img, plane, i);
+        dst_bottom = get_image_row(rotated_img, plane, height - 1 - i);
+
+        // The middle row of a plane with an odd height is simply reversed
+        count = (i == height - 1u - i) ? (width + 1) / 2 : width;
+
+        // Constant pixel sizes let the compiler unroll the swap of each pixel
+        switch (pixel_size) {
+            case 1:
+                reverse_row_pair(src_top, src_bottom, dst_top, dst_bottom, width, count, 1);
+                break;
+
+            case 2:
+                reverse_row_pair(src_top, src_bottom, dst_top, dst_bottom, width, count, 2);
+                break;
+
+            case 3:
+                reverse_row_pair(src_top, src_bottom, dst_top, dst_bottom, width, count, 3);
+                break;
+
+            default:
+                reverse_row_pair(src_top, src_bottom, dst_top, dst_bottom, width, count, pixel_size);
+                break;
+        }
+    }
+
+    return 1;
+}
+
+
+uint8_t rotate270_plane (const Image_t * base_img, Image_t * rotated_img, uint8_t plane, uint8_t pixel_size)
+{
+    uint16_t height = 0;
+
+    if (!check_transposed_plane(base_img, rotated_img, plane, pixel_size)) return 0;
+
+    height = get_image_plane_height(rotated_img->height, rotated_img->format, plane);
+    if (!height) return 1;
+
+    // Rotating counterclockwise is transposing the base plane into the rotated plane with its rows in reverse order
+    transpose_plane(get_image_plane(base_img, plane),
+                    get_image_stride(base_img, plane),
+                    get_image_row(rotated_img, plane, height - 1),
+                    -get_image_stride(rotated_img, plane),
+                    get_image_row_size(base_img->width, base_img->format, plane) / pixel_size,
+                    get_image_plane_height(base_img->height, base_img->format, plane),
+                    pixel_size);
+
+    return 1;
+}
@@ -0,0 +1,69 @@
+#ifndef __LIB_UIMG_ROTATIONS_H__
+#define __LIB_UIMG_ROTATIONS_H__
+
+
+#include "libuimg_img.h"
+
+
+#define ROTATION_TILE_SIZE 32 /**< Size (in pixels) of the square tiles that 90 and 270 degree rotations work on. */
+
+
+/**
+ * @brief      Rotate an image clockwise.
+ *
+ * For 90 and 270 degree rotations, the rotated image must be as wide as the base image is high (and vice versa), and
+ * must not share any pixel data with it; the planes are transposed tile by tile, so that both images are walked
+ * through in cache-sized chunks even for large frames.
+ *
+ * For 180 degree rotations, both images must have the same dimensions, and may be the same image (in which case the
+ * image is rotated in place); each pair of rows is swapped and reversed in a single pass.
+ *
+ * YUYV and UYVY images can only be rotated by 180 degrees, since their chroma samples cover two pixels of a row.
+ *
+ * @param      base_img     The image to rotate.
+ * @param      rotated_img  The rotated image (of the same format).
+ * @param[in]  degrees      The angle of the rotation: 90, 180 or 270.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t rotate_image (Image_t * base_img, Image_t * rotated_img, uint16_t degrees);
+
+
+/**
+ * @brief      Rotate a plane of an image clockwise by 90 degrees.
+ *
+ * @param[in]  base_img     The image to rotate.
+ * @param      rotated_img  The rotated image.
+ * @param[in]  plane        The index of the plane to rotate.
+ * @param[in]  pixel_size   The size of a pixel of the plane (in bytes).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t rotate90_plane (const Image_t * base_img, Image_t * rotated_img, uint8_t plane, uint8_t pixel_size);
+
+/**
+ * @brief      Rotate a plane of an image by 180 degrees.
+ *
+ * @param[in]  base_img     The image to rotate.
+ * @param      rotated_img  The rotated image (which may be the base image itself).
+ * @param[in]  plane        The index of the plane to rotate.
+ * @param[in]  pixel_size   The size of a pixel of the plane (in bytes).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t rotate180_plane (const Image_t * base_img, Image_t * rotated_img, uint8_t plane, uint8_t pixel_size);
+
+/**
+ * @brief      Rotate a plane of an image clockwise by 270 degrees.
+ *
+ * @param[in]  base_img     The image to rotate.
+ * @param      rotated_img  The rotated image.
+ * @param[in]  plane        The index of the plane to rotate.
+ * @param[in]  pixel_size   The size of a pixel of the plane (in bytes).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t rotate270_plane (const Image_t * base_img, Image_t * rotated_img, uint8_t plane, uint8_t pixel_size);
+
+
+#endif
@@ -0,0 +1,556 @@
+#include "libuimg_scaling.h"
+#include "libuimg_simd.h"
+
+
+#define FILTER_ONE (1 << SIMD_FILTER_BITS) /**< The sum of the weights of a filter. */
+
+/**
+ * @brief      Round a size up to a multiple of 8 bytes, so that every array of the scaling buffer is aligned.
+ */
+#define ALIGN_SIZE(size) (((size) + 7u) & ~7u)
+
+
+/**
+ * @brief The dimensions of a plane, before and after scaling, and how it is filtered.
+ */
+typedef struct {
+    /** The width of the base plane (in pixels). */
+    uint16_t base_width;
+    /** The height of the base plane (in pixels). */
+    uint16_t base_height;
+    /** The width of the scaled plane (in pixels). */
+    uint16_t scaled_width;
+    /** The height of the scaled plane (in pixels). */
+    uint16_t scaled_height;
+    /** The size of a pixel of the plane (in bytes). */
+    uint8_t pixel_size;
+    /** The number of channels of a pixel, once unpacked. */
+    uint8_t channels;
+    /** Set if the channels of the pixels are packed into bit fields (RGB565 and RGB8), or into macropixels (YUYV and
+        UYVY), and must be unpacked to be filtered. */
+    uint8_t packed;
+    /** The number of base pixels that every scaled pixel is computed from, horizontally. */
+    uint16_t taps_x;
+    /** The number of base pixels that every scaled pixel is computed from, vertically. */
+    uint16_t taps_y;
+} PlaneGeometry_t;
+
+
+/**
+ * @brief The arrays carved out of the scaling buffer for a plane.
+ */
+typedef struct {
+    /** The horizontally filtered rows that the current scaled row is computed from. */
+    const uint16_t ** rows;
+    /** The base row held by each slot of the ring (-1 if none). */
+    int32_t * ring_rows;
+    /** The vertical weights of the current scaled row. */
+    int16_t * row_weights;
+    /** The first base pixel of every scaled pixel. */
+    uint16_t * starts;
+    /** The horizontal weights of every scaled pixel. */
+    int16_t * weights;
+    /** The ring of horizontally filtered rows (`taps_y` rows, with `SIMD_FILTER_EXTRA_BITS` extra bits). */
+    uint16_t * ring;
+    /** The current base row, with its channels unpacked (packed formats only). */
+    uint8_t * unpacked_row;
+    /** The current scaled row, with its channels unpacked (packed formats only). */
+    uint8_t * filtered_row;
+} ScaleBuffers_t;
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * FILTER COEFFICIENTS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static uint16_t get_filter_taps (ScaleFilter_t filter, uint16_t base_size, uint16_t scaled_size)
+{
+    uint32_t taps = 1;
+
+    if (!base_size || !scaled_size) return 1;
+
+    if (filter == SCALE_BILINEAR) {
+        taps = 2;
+    } else if (filter == SCALE_AREA) {
+        // A scaled pixel covers at most ceil(base_size / scaled_size) + 1 base pixels (2 when upscaling)
+        taps = (scaled_size >= base_size) ? 2 : (base_size + scaled_size - 1) / scaled_size + 1;
+    }
+
+    return (taps > base_size) ? base_size : taps;
+}
+
+
+// Compute the weights of the `taps` base pixels that scaled pixel `index` is computed from, and return the first one
+static uint16_t compute_filter_weights (ScaleFilter_t filter,
+                                        uint16_t base_size,
+                                        uint16_t scaled_size,
+                                        uint16_t index,
+                                        uint16_t taps,
+                                        int16_t * weights)
+{
+    uint16_t t = 0;
+    uint16_t largest = 0;
+    uint32_t first = 0;
+    int32_t total = 0;
+    int64_t position = 0;
+    uint64_t low = 0;
+    uint64_t high = 0;
+    uint64_t pixel_low = 0;
+    uint64_t pixel_high = 0;
+
+    switch (filter) {
+        default:
+        case SCALE_NEAREST:
+            // The center of scaled pixel i is at (i + 0.5) * base_size / scaled_size
+            weights[0] = FILTER_ONE;
+            return ((2 * (uint64_t) index + 1) * base_size) / (2 * (uint64_t) scaled_size);
+
+        case SCALE_BILINEAR:
+            // Position of the center of the scaled pixel, in base pixels (centers aligned), in fixed point
+            position = ((2 * (int64_t) index + 1) * base_size - scaled_size) * FILTER_ONE / (2 * (int64_t) scaled_size);
+            if (position < 0) position = 0;
+            first = position >> SIMD_FILTER_BITS;
+
+            if (taps == 1) {
+                weights[0] = FILTER_ONE;
+                return 0;
+            }
+            // Past the center of the last base pixel, the last base pixel is used as is
+            if (first >= base_size - 1u) {
+                weights[0] = 0;
+                weights[1] = FILTER_ONE;
+                return base_size - 2;
+            }
+
+            weights[1] = position & (FILTER_ONE - 1);
+            weights[0] = FILTER_ONE - weights[1];
+            return first;
+
+        case SCALE_AREA:
+            // Base pixel j covers [j * scaled_size, (j + 1) * scaled_size), and scaled pixel i covers
+            // [i * base_size, (i + 1) * base_size); the weights are the overlaps of both
+            low = (uint64_t) index * base_size;
+            high = low + base_size;
+            first = low / scaled_size;
+            if (first + taps > base_size) first = base_size - taps;
+
+            for (t = 0; t < taps; t++) {
+                pixel_low = (uint64_t) (first + t) * scaled_size;
+                pixel_high = pixel_low + scaled_size;
+                if (pixel_low < low) pixel_low = low;
+                if (pixel_high > high) pixel_high = high;
+
+                weights[t] = (pixel_high > pixel_low) ? (pixel_high - pixel_low) * FILTER_ONE / base_size : 0;
+                total += weights[t];
+                if (weights[t] > weights[largest]) largest = t;
+            }
+
+            // Make up for the rounding errors, so that the weights still add up to 1
+            weights[largest] += FILTER_ONE - total;
+            return first;
+    }
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * BUFFER LAYOUT
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static void get_plane_geometry (uint16_t base_width,
+                                uint16_t base_height,
+                                uint16_t scaled_width,
+                                uint16_t scaled_height,
+                                PixelFormat_t format,
+                                uint8_t plane,
+                                ScaleFilter_t filter,
+                                PlaneGeometry_t * geometry)
+{
+    switch (format) {
+        case YUV444:
+        case RGB24:
+        case BGR24:
+            geometry->pixel_size = 3;
+            geometry->channels = 3;
+            geometry->packed = 0;
+            break;
+
+        case RGBA8888:
+        case BGRA8888:
+        case XRGB8888:
+            // Alpha (or unused) values are filtered like the other channels
+            geometry->pixel_size = 4;
+            geometry->channels = 4;
+            geometry->packed = 0;
+            break;
+
+        case RGB565:
+            geometry->pixel_size = 2;
+            geometry->channels = 3;
+            geometry->packed = 1;
+            break;
+
+        case RGB8:
+            geometry->pixel_size = 1;
+            geometry->channels = 3;
+            geometry->packed = 1;
+            break;
+
+        case NV12:
+        case NV21:
+            // The U, V pairs of the chroma plane are filtered like two-channel pixels
+            geometry->pixel_size = plane ? 2 : 1;
+            geometry->channels = plane ? 2 : 1;
+            geometry->packed = 0;
+            break;
+
+        case YUYV:
+        case UYVY:
+            geometry->pixel_size = 2;
+            geometry->channels = 3;
+            geometry->packed = 1;
+            break;
+
+        default:
+            geometry->pixel_size = 1;
+            geometry->channels = 1;
+            geometry->packed = 0;
+            break;
+    }
+
+    geometry->base_width = get_image_row_size(base_width, format, plane) / geometry->pixel_size;
+    geometry->base_height = get_image_plane_height(base_height, format, plane);
+    geometry->scaled_width = get_image_row_size(scaled_width, format, plane) / geometry->pixel_size;
+    geometry->scaled_height = get_image_plane_height(scaled_height, format, plane);
+    if (format == YUYV || format == UYVY) {
+        // Rows are padded to a whole macropixel, but the padding pixel is not part of the image
+        geometry->base_width = base_width;
+        geometry->scaled_width = scaled_width;
+    }
+    geometry->taps_x = get_filter_taps(filter, geometry->base_width, geometry->scaled_width);
+    geometry->taps_y = get_filter_taps(filter, geometry->base_height, geometry->scaled_height);
+}
+
+
+// Carve the arrays needed to scale a plane out of the buffer (if any), and return the size they take up
+static uint32_t layout_scale_buffer (uint8_t * buffer, const PlaneGeometry_t * geometry, ScaleBuffers_t * buffers)
+{
+    uint32_t ring_row_size = (uint32_t) geometry->scaled_width * geometry->channels;
+    uint32_t ring_rows_offset = ALIGN_SIZE(sizeof(uint16_t *) * geometry->taps_y);
+    uint32_t row_weights_offset = ring_rows_offset + ALIGN_SIZE(sizeof(int32_t) * geometry->taps_y);
+    uint32_t starts_offset = row_weights_offset + ALIGN_SIZE(sizeof(int16_t) * geometry->taps_y);
+    uint32_t weights_offset = starts_offset + ALIGN_SIZE(sizeof(uint16_t) * geometry->scaled_width);
+    uint32_t ring_offset = weights_offset +
+                           ALIGN_SIZE(sizeof(int16_t) * geometry->scaled_width * geometry->taps_x);
+    uint32_t unpacked_row_offset = ring_offset + ALIGN_SIZE(sizeof(uint16_t) * ring_row_size * geometry->taps_y);
+    uint32_t filtered_row_offset = unpacked_row_offset +
+                                   ALIGN_SIZE(geometry->packed ? geometry->base_width * geometry->channels : 0);
+    uint32_t size = filtered_row_offset + ALIGN_SIZE(geometry->packed ? ring_row_size : 0);
+
+    if (buffer) {
+        buffers->rows = (const uint16_t **) buffer;
+        buffers->ring_rows = (int32_t *) (buffer + ring_rows_offset);
+        buffers->row_weights = (int16_t *) (buffer + row_weights_offset);
+        buffers->starts = (uint16_t *) (buffer + starts_offset);
+        buffers->weights = (int16_t *) (buffer + weights_offset);
+        buffers->ring = (uint16_t *) (buffer + ring_offset);
+        buffers->unpacked_row = buffer + unpacked_row_offset;
+        buffers->filtered_row = buffer + filtered_row_offset;
+    }
+
+    return size;
+}
+
+
+uint32_t get_scale_buffer_size (uint16_t base_width,
+                                uint16_t base_height,
+                                uint16_t scaled_width,
+                                uint16_t scaled_height,
+                                PixelFormat_t format,
+                                ScaleFilter_t filter)
+{
+    uint8_t plane = 0;
+    uint32_t size = 0;
+    uint32_t max_size = 0;
+    PlaneGeometry_t geometry;
+
+    if (format == ASCII) filter = SCALE_NEAREST;
+
+    for (plane = 0; plane < get_image_plane_count(format); plane++) {
+        get_plane_geometry(base_width, base_height, scaled_width, scaled_height, format, plane, filter, &geometry);
+
+        size = layout_scale_buffer(NULL, &geometry, NULL);
+        if (size > max_size) max_size = size;
+    }
+
+    // Leave room to align the start of the buffer
+    return max_size + 8;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * ROW FILTERS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static void unpack_row (const uint8_t * row, uint8_t * unpacked_row, uint16_t width, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint8_t luma_offset = (format == UYVY);
+
+    // Same layouts as in `libuimg_conversions.c`, with the channels stored as R, G, B (or Y, U, V, with the U and V
+    // values of every macropixel duplicated)
+    if (format == YUYV || format == UYVY) {
+        for (i = 0; i < width; i++) {
+            unpacked_row[i * 3] = row[i * 2 + luma_offset];
+            unpacked_row[i * 3 + 1] = row[(i / 2) * 4 + 1 - luma_offset];
+            unpacked_row[i * 3 + 2] = row[(i / 2) * 4 + 3 - luma_offset];
+        }
+    } else if (format == RGB565) {
+        for (i = 0; i < width; i++) {
+            unpacked_row[i * 3] = (row[i * 2 + 1] & 0xf8) >> 3;
+            unpacked_row[i * 3 + 1] = ((row[i * 2] & 0xe0) >> 5) | ((row[i * 2 + 1] & 0x07) << 3);
+            unpacked_row[i * 3 + 2] = row[i * 2] & 0x1f;
+        }
+    } else {
+        for (i = 0; i < width; i++) {
+            unpacked_row[i * 3] = (row[i] >> 5) & 0x07;
+            unpacked_row[i * 3 + 1] = (row[i] >> 2) & 0x07;
+            unpacked_row[i * 3 + 2] = row[i] & 0x03;
+        }
+    }
+}
+
+
+static void pack_row (const uint8_t * unpacked_row, uint8_t * row, uint16_t width, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint32_t last = 0;
+    uint8_t luma_offset = (format == UYVY);
+
+    if (format == YUYV || format == UYVY) {
+        for (i = 0; i < width; i++) {
+            row[i * 2 + luma_offset] = unpacked_row[i * 3];
+        }
+        // The padding pixel of odd-width rows repeats the last pixel
+        if (width % 2) row[width * 2 + luma_offset] = unpacked_row[(width - 1) * 3];
+
+        // The last pixel of each pair determines the U and V values, as in `libuimg_conversions.c`
+        for (i = 0; i < width; i += 2) {
+            last = (i + 1 < width) ? i + 1 : i;
+            row[i * 2 + 1 - luma_offset] = unpacked_row[last * 3 + 1];
+            row[i * 2 + 3 - luma_offset] = unpacked_row[last * 3 + 2];
+        }
+    } else if (format == RGB565) {
+        for (i = 0; i < width; i++) {
+            row[i * 2] = (unpacked_row[i * 3 + 2] & 0x1f) | ((unpacked_row[i * 3 + 1] & 0x07) << 5);
+            row[i * 2 + 1] = ((unpacked_row[i * 3 + 1] & 0x38) >> 3) | ((unpacked_row[i * 3] & 0x1f) << 3);
+        }
+    } else {
+        for (i = 0; i < width; i++) {
+            row[i] = (unpacked_row[i * 3 + 2] & 0x03) |
+                     ((unpacked_row[i * 3 + 1] & 0x07) << 2) |
+                     ((unpacked_row[i * 3] & 0x07) << 5);
+        }
+    }
+}
+
+
+// Filter a row horizontally, keeping `SIMD_FILTER_EXTRA_BITS` extra bits of precision for the vertical filter
+static inline void filter_row (const uint8_t * row,
+                               uint16_t * filtered_row,
+                               const uint16_t * starts,
+                               const int16_t * weights,
+                               uint16_t width,
+                               uint16_t taps,
+                               uint8_t channels)
+{
+    uint32_t i = 0;
+    uint32_t t = 0;
+    uint32_t c = 0;
+    uint32_t value = 0;
+    const uint8_t * pixels = NULL;
+
+    for (i = 0; i < width; i++) {
+        pixels = row + starts[i] * channels;
+
+        for (c = 0; c < channels; c++) {
+            value = 1 << (SIMD_FILTER_BITS - SIMD_FILTER_EXTRA_BITS - 1);
+            for (t = 0; t < taps; t++) {
+                value += weights[t] * pixels[t * channels + c];
+            }
+
+            filtered_row[i * channels + c] = value >> (SIMD_FILTER_BITS - SIMD_FILTER_EXTRA_BITS);
+        }
+
+        weights += taps;
+    }
+}
+
+
+// Copy the nearest pixel of every scaled pixel of a row
+static inline void pick_row (const uint8_t * row,
+                             uint8_t * scaled_row,
+                             const uint16_t * starts,
+                             uint16_t width,
+                             uint8_t pixel_size)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+
+    for (i = 0; i < width; i++) {
+        for (k = 0; k < pixel_size; k++) {
+            scaled_row[i * pixel_size + k] = row[starts[i] * pixel_size + k];
+        }
+    }
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * SCALING FUNCTIONS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static void scale_plane (const Image_t * base_img,
+                         Image_t * scaled_img,
+                         uint8_t plane,
+                         ScaleFilter_t filter,
+                         const PlaneGeometry_t * geometry,
+                         uint8_t * buffer)
+{
+    uint32_t i = 0;
+    uint16_t t = 0;
+    uint16_t first_row = 0;
+    uint32_t row = 0;
+    uint16_t slot = 0;
+    uint32_t ring_row_size = (uint32_t) geometry->scaled_width * geometry->channels;
+    const uint8_t * base_row = NULL;
+    uint8_t * scaled_row = NULL;
+    uint16_t * filtered_row = NULL;
+    ScaleBuffers_t buffers;
+
+    layout_scale_buffer(buffer, geometry, &buffers);
+
+    for (i = 0; i < geometry->scaled_width; i++) {
+        buffers.starts[i] = compute_filter_weights(filter, geometry->base_width, geometry->scaled_width, i,
+                                                   geometry->taps_x, &buffers.weights[i * geometry->taps_x]);
+    }
+
+    if (filter == SCALE_NEAREST) {
+        for (i = 0; i < geometry->scaled_height; i++) {
+            row = compute_filter_weights(filter, geometry->base_height, geometry->scaled_height, i, 1,
+                                         buffers.row_weights);
+            base_row = get_image_row(base_img, plane, row);
+            scaled_row = get_image_row(scaled_img, plane, i);
+
+            // Macropixels cannot be picked apart without being unpacked first
+            if (base_img->format == YUYV || base_img->format == UYVY) {
+                unpack_row(base_row, buffers.unpacked_row, geometry->base_width, base_img->format);
+                pick_row(buffers.unpacked_row, buffers.filtered_row, buffers.starts, geometry->scaled_width, 3);
+                pack_row(buffers.filtered_row, scaled_row, geometry->scaled_width, scaled_img->format);
+                continue;
+            }
+
+            // Constant pixel sizes let the compiler unroll the copy of each pixel
+            if (geometry->pixel_size == 1) {
+                pick_row(base_row, scaled_row, buffers.starts, geometry->scaled_width, 1);
+            } else if (geometry->pixel_size == 2) {
+                pick_row(base_row, scaled_row, buffers.starts, geometry->scaled_width, 2);
+            } else if (geometry->pixel_size == 3) {
+                pick_row(base_row, scaled_row, buffers.starts, geometry->scaled_width, 3);
+            } else {
+                pick_row(base_row, scaled_row, buffers.starts, geometry->scaled_width, 4);
+            }
+        }
+
+        return;
+    }
+
+    for (t = 0; t < geometry->taps_y; t++) {
+        buffers.ring_rows[t] = -1;
+    }
+
+    for (i = 0; i < geometry->scaled_height; i++) {
+        first_row = compute_filter_weights(filter, geometry->base_height, geometry->scaled_height, i,
+                                           geometry->taps_y, buffers.row_weights);
+
+        // The base rows of consecutive scaled rows overlap, so each one is only filtered horizontally once, into the
+        // slot of the ring given by its index
+        for (t = 0; t < geometry->taps_y; t++) {
+            row = first_row + t;
+            slot = row % geometry->taps_y;
+
+            if (buffers.ring_rows[slot] != (int32_t) row) {
+                base_row = get_image_row(base_img, plane, row);
+                if (geometry->packed) {
+                    unpack_row(base_row, buffers.unpacked_row, geometry->base_width, base_img->format);
+                    base_row = buffers.unpacked_row;
+                }
+
+                // Constant tap and channel counts let the compiler unroll the common cases
+                filtered_row = &buffers.ring[slot * ring_row_size];
+                if (geometry->taps_x == 2 && geometry->channels == 1) {
+                    filter_row(base_row, filtered_row, buffers.starts, buffers.weights, geometry->scaled_width, 2, 1);
+                } else if (geometry->taps_x == 2 && geometry->channels == 3) {
+                    filter_row(base_row, filtered_row, buffers.starts, buffers.weights, geometry->scaled_width, 2, 3);
+                } else if (geometry->channels == 1) {
+                    filter_row(base_row, filtered_row, buffers.starts, buffers.weights, geometry->scaled_width,
+                               geometry->taps_x, 1);
+                } else {
+                    filter_row(base_row, filtered_row, buffers.starts, buffers.weights, geometry->scaled_width,
+                               geometry->taps_x, geometry->channels);
+                }
+                buffers.ring_rows[slot] = row;
+            }
+
+            buffers.rows[t] = &buffers.ring[slot * ring_row_size];
+        }
+
+        scaled_row = get_image_row(scaled_img, plane, i);
+        if (geometry->packed) {
+            filter_rows_block(buffers.rows, buffers.row_weights, geometry->taps_y, buffers.filtered_row,
+                              ring_row_size);
+            pack_row(buffers.filtered_row, scaled_row, geometry->scaled_width, scaled_img->format);
+        } else {
+            filter_rows_block(buffers.rows, buffers.row_weights, geometry->taps_y, scaled_row, ring_row_size);
+        }
+    }
+}
+
+
+uint8_t scale_image (Image_t * base_img, Image_t * scaled_img, ScaleFilter_t filter, uint8_t * buffer)
+{
+    uint8_t plane = 0;
+    PlaneGeometry_t geometries[3];
+
+    // Check image pointers
+    if (!base_img) return 0;
+    if (!scaled_img) return 0;
+    if (!buffer) return 0;
+    // Scaling never changes the format
+    if (base_img->format != scaled_img->format) return 0;
+    if (filter > SCALE_AREA) return 0;
+    // Filtering ASCII characters makes no sense
+    if (base_img->format == ASCII) filter = SCALE_NEAREST;
+
+    for (plane = 0; plane < get_image_plane_count(base_img->format); plane++) {
+        get_plane_geometry(base_img->width, base_img->height, scaled_img->width, scaled_img->height,
+                           base_img->format, plane, filter, &geometries[plane]);
+
+        // Scaled pixels cannot be computed from nothing
+        if (geometries[plane].scaled_width && geometries[plane].scaled_height &&
+            (!geometries[plane].base_width || !geometries[plane].base_height)) return 0;
+    }
+
+    // Align the start of the buffer, so that every array carved out of it is aligned
+    buffer += (8 - (uintptr_t) buffer % 8) % 8;
+
+    for (plane = 0; plane < get_image_plane_count(base_img->format); plane++) {
+        if (!geometries[plane].scaled_width || !geometries[plane].scaled_height) continue;
+
+        scale_plane(base_img, scaled_img, plane, filter, &geometries[plane], buffer);
+    }
+
+    return 1;
+}
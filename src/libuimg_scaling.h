@@ -0,0 +1,61 @@
+#ifndef __LIB_UIMG_SCALING_H__
+#define __LIB_UIMG_SCALING_H__
+
+
+#include "libuimg_img.h"
+
+
+/**
+ * @brief Enumeration of the scaling filters.
+ *
+ * SCALE_NEAREST, picks the nearest pixel (fastest, blocky)
+ * SCALE_BILINEAR, interpolates between the 2x2 nearest pixels (smooth upscaling, aliased downscaling past 2:1)
+ * SCALE_AREA, averages every pixel covered by the scaled pixel (best for downscaling)
+ */
+typedef enum {
+    SCALE_NEAREST,
+    SCALE_BILINEAR,
+    SCALE_AREA
+} ScaleFilter_t;
+
+
+/**
+ * @brief      Get the size of the buffer needed to scale an image.
+ *
+ * @param[in]  base_width     The width of the base image (in pixels).
+ * @param[in]  base_height    The height of the base image (in pixels).
+ * @param[in]  scaled_width   The width of the scaled image (in pixels).
+ * @param[in]  scaled_height  The height of the scaled image (in pixels).
+ * @param[in]  format         The pixel format of both images.
+ * @param[in]  filter         The scaling filter.
+ *
+ * @return     The size of the buffer (in bytes).
+ */
+uint32_t get_scale_buffer_size (uint16_t base_width,
+                                uint16_t base_height,
+                                uint16_t scaled_width,
+                                uint16_t scaled_height,
+                                PixelFormat_t format,
+                                ScaleFilter_t filter);
+
+/**
+ * @brief      Scale an image.
+ *
+ * The image is filtered horizontally then vertically, with fixed-point weights computed once per call; each row of
+ * the base image is filtered horizontally at most once. Planar formats are scaled plane by plane, and the color
+ * channels of RGB565 and RGB8 images are filtered separately. ASCII images are always scaled with `SCALE_NEAREST`.
+ *
+ * Empty base images can only be scaled to empty images.
+ *
+ * @param      base_img    The image to scale.
+ * @param      scaled_img  The scaled image (of the same format).
+ * @param[in]  filter      The scaling filter.
+ * @param      buffer      A buffer of `get_scale_buffer_size()` bytes, which can be reused from one frame to the
+ *                         next.
+ *
+ * @return     1 if successful, 0 otherwise (including if the buffer is NULL).
+ */
+uint8_t scale_image (Image_t * base_img, Image_t * scaled_img, ScaleFilter_t filter, uint8_t * buffer);
+
+
+#endif
@@ -0,0 +1,2464 @@
+#include "libuimg_simd.h"
+#include "libuimg_conversions.h"
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define LIBUIMG_HAS_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define LIBUIMG_HAS_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef LIBUIMG_THREADS
+#include <pthread.h>
+#endif
+
+
+/**
+ * @brief      Pack two 16-bit coefficients into a 32-bit word, as expected by `_mm_madd_epi16()`.
+ */
+#define COEF_PAIR(lo, hi) ((int32_t) (((uint32_t) (uint16_t) (hi) << 16) | (uint16_t) (lo)))
+
+
+const ColorMatrix_t yuv_to_rgb_matrix = {
+    .in_offset = { 16, 128, 128 },
+    .coef = {
+        { 298, 0, 409 },
+        { 298, -100, -208 },
+        { 298, 516, 0 }
+    },
+    .out_offset = { 0, 0, 0 }
+};
+
+const ColorMatrix_t rgb_to_yuv_matrix = {
+    .in_offset = { 0, 0, 0 },
+    .coef = {
+        { 66, 129, 25 },
+        { -38, -74, 112 },
+        { 112, -94, -18 }
+    },
+    .out_offset = { 16, 128, 128 }
+};
+
+
+#define SIMD_FEATURE_SETS 32 /**< The number of combinations of the `SIMD_*` flags. */
+
+
+/**
+ * @brief The SIMD kernels selected for a combination of instruction sets (NULL kernels fall back on the scalar ones).
+ *
+ * Unless stated otherwise, a SIMD kernel processes as many pixels as it can in full vectors and returns that number of
+ * pixels.
+ */
+typedef struct {
+    /** The instruction sets the kernels may use (see `set_simd_features()`). */
+    uint8_t features;
+    /** The color matrix kernel; see `convert_color_block()`. */
+    uint32_t (* color_matrix) (const ColorMatrix_t * matrix,
+                               const uint8_t * in0,
+                               const uint8_t * in1,
+                               const uint8_t * in2,
+                               uint8_t * out0,
+                               uint8_t * out1,
+                               uint8_t * out2,
+                               uint32_t count);
+    /** The YUV420p -> RGB565 kernel (always processes an even number of pixels). */
+    uint32_t (* yuv420p_to_rgb565) (const ColorMatrix_t * matrix,
+                                    const uint8_t * y_row0,
+                                    const uint8_t * y_row1,
+                                    const uint8_t * u_row,
+                                    const uint8_t * v_row,
+                                    uint8_t * rgb565_row0,
+                                    uint8_t * rgb565_row1,
+                                    uint32_t count,
+                                    uint8_t swap_bytes);
+    /** The kernel transposing a square block of `SIMD_TRANSPOSE_SIZE` 8-bit pixels. */
+    void (* transpose_8bpp) (const uint8_t * src, int32_t src_stride, uint8_t * dst, int32_t dst_stride);
+    /** The kernel filtering rows vertically; see `filter_rows_block()`. */
+    uint32_t (* filter_rows) (const uint16_t * const * rows,
+                              const int16_t * weights,
+                              uint16_t taps,
+                              uint8_t * out,
+                              uint32_t count);
+    /** The kernel computing the inverse DCT of a full 8x8 block; see `idct_block()`. */
+    void (* idct_8x8) (const int16_t * coefs, uint8_t * out, int32_t out_stride);
+    /** The kernel splitting 24-bit pixels into channels; see `deinterleave_24bpp_block()`. */
+    uint32_t (* deinterleave_24bpp) (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint8_t * c2, uint32_t count);
+    /** The kernel merging channels into 24-bit pixels; see `interleave_24bpp_block()`. */
+    uint32_t (* interleave_24bpp) (const uint8_t * c0,
+                                   const uint8_t * c1,
+                                   const uint8_t * c2,
+                                   uint8_t * dst,
+                                   uint32_t count);
+    /** The kernel splitting byte pairs into channels; see `deinterleave_16bpp_block()`. */
+    uint32_t (* deinterleave_16bpp) (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint32_t count);
+    /** The kernel merging two channels into byte pairs; see `interleave_16bpp_block()`. */
+    uint32_t (* interleave_16bpp) (const uint8_t * c0, const uint8_t * c1, uint8_t * dst, uint32_t count);
+    /** The kernel splitting 32-bit pixels into channels; see `deinterleave_32bpp_block()`. */
+    uint32_t (* deinterleave_32bpp) (const uint8_t * src,
+                                     uint8_t * c0,
+                                     uint8_t * c1,
+                                     uint8_t * c2,
+                                     uint8_t * c3,
+                                     uint32_t count);
+    /** The kernel merging channels into 32-bit pixels; see `interleave_32bpp_block()`. */
+    uint32_t (* interleave_32bpp) (const uint8_t * c0,
+                                   const uint8_t * c1,
+                                   const uint8_t * c2,
+                                   const uint8_t * c3,
+                                   uint8_t * dst,
+                                   uint32_t count);
+    /** The kernel premultiplying colors by alpha values; see `premultiply_8bpp_block()`. */
+    uint32_t (* premultiply_8bpp) (const uint8_t * in, const uint8_t * alpha, uint8_t * out, uint32_t count);
+    /** The kernel compositing premultiplied colors; see `blend_8bpp_block()`. */
+    uint32_t (* blend_8bpp) (const uint8_t * src, const uint8_t * alpha, uint8_t * dst, uint32_t count);
+    /** The kernel downsampling chroma values; see `downsample_chroma_block()`. */
+    uint32_t (* downsample_chroma) (const uint8_t * row0,
+                                    const uint8_t * row1,
+                                    uint8_t * out,
+                                    uint32_t count,
+                                    ChromaSiting_t siting);
+} SimdKernels_t;
+
+
+/** The instruction sets supported by the CPU (and by the build). */
+static uint8_t detected_features = SIMD_NONE;
+
+/**
+ * @brief The kernels of every combination of instruction sets, indexed by their `SIMD_*` flags.
+ *
+ * They are filled once (see `init_simd()`) and never written again, so that switching kernels only takes swapping a
+ * pointer.
+ */
+static SimdKernels_t kernel_sets[SIMD_FEATURE_SETS];
+
+/** The kernels in use, among `kernel_sets` (NULL until `init_simd()` has run). */
+static const SimdKernels_t * active_kernels = NULL;
+
+#ifdef LIBUIMG_THREADS
+/** Runs `init_simd()` once, even if several threads make their first call at the same time. */
+static pthread_once_t simd_once = PTHREAD_ONCE_INIT;
+
+// The kernels in use can be switched by `set_simd_features()` while other threads read them
+#define LOAD_ACTIVE_KERNELS() __atomic_load_n(&active_kernels, __ATOMIC_ACQUIRE)
+#define STORE_ACTIVE_KERNELS(kernels) __atomic_store_n(&active_kernels, (kernels), __ATOMIC_RELEASE)
+#else
+#define LOAD_ACTIVE_KERNELS() (active_kernels)
+#define STORE_ACTIVE_KERNELS(kernels) (active_kernels = (kernels))
+#endif
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * RGB565 TABLES
+ * --------------------------------------------------------------------------------------------------------------------
+ *
+ * The YUV->RGB transformations give values from (298 * -16 + 548 * -128 + 128) >> 8 = -293 to
+ * (298 * 239 + 548 * 127 + 128) >> 8 = 550 (both for B, with the BT.2020 limited-range matrix; the other matrices of
+ * `libuimg_colorspace.h` stay within these bounds). These tables map every such value (offset by `RGB565_LUT_OFFSET`)
+ * to its clamped and quantized RGB565 field, so that the scalar kernel needs no clamp at all.
+ */
+
+#define RGB565_LUT_OFFSET 320 /**< Offset of the value 0 in the RGB565 tables. */
+#define RGB565_LUT_SIZE 896   /**< Size of the RGB565 tables (covers values from -320 to 575). */
+
+/** Clamped R or B value, equivalent to `rescale_8bit_to_5bit_LUT` (truncated to 5 bits, as in packed pixels). */
+static uint8_t clamp_to_5bit_LUT[RGB565_LUT_SIZE];
+/** Clamped G value, equivalent to `rescale_8bit_to_6bit_LUT` (truncated to 6 bits, as in packed pixels). */
+static uint8_t clamp_to_6bit_LUT[RGB565_LUT_SIZE];
+
+
+static void init_rgb565_tables (void)
+{
+    int32_t i = 0;
+    int32_t value = 0;
+
+    for (i = 0; i < RGB565_LUT_SIZE; i++) {
+        value = i - RGB565_LUT_OFFSET;
+        if (value < 0) value = 0;
+        if (value > 255) value = 255;
+
+        clamp_to_5bit_LUT[i] = rescale_8bit_to_5bit_LUT[value] & 0x1f;
+        clamp_to_6bit_LUT[i] = rescale_8bit_to_6bit_LUT[value] & 0x3f;
+    }
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * IDCT TABLES
+ * --------------------------------------------------------------------------------------------------------------------
+ *
+ * Row u of the N x N matrix holds the weights of frequency u for each of the N output samples, scaled by 2^14:
+ *
+ *     A[u][x] = C(u) / 2 * D(u) * cos((2x + 1) * u * pi / 2N)
+ *
+ * with C(0) = 1 / sqrt(2) and C(u) = 1 otherwise. D(u) = sin(s * u * pi / 16) / (s * sin(u * pi / 16)), with s = 8 / N,
+ * turns the point samples of the reduced transform into the averages of the s full-size samples they replace (it is 1
+ * for N = 8). Each row of the 8x8 matrix adds up (in absolute value) to less than 43300, so neither pass can overflow.
+ */
+
+#define IDCT_PASS1_SHIFT (SIMD_IDCT_BITS - SIMD_IDCT_PASS1_BITS) /**< Shift of the first (vertical) IDCT pass. */
+#define IDCT_PASS2_SHIFT (SIMD_IDCT_BITS + SIMD_IDCT_PASS1_BITS) /**< Shift of the second (horizontal) IDCT pass. */
+#define IDCT_PASS1_BIAS (1 << (IDCT_PASS1_SHIFT - 1))            /**< Rounding term of the first IDCT pass. */
+#define IDCT_PASS2_BIAS ((128 << IDCT_PASS2_SHIFT) + (1 << (IDCT_PASS2_SHIFT - 1))) /**< Rounding and level shift. */
+
+static const int16_t idct_matrix_8[8 * 8] = {
+    5793,  5793,  5793,  5793,  5793,  5793,  5793,  5793,
+    8035,  6811,  4551,  1598, -1598, -4551, -6811, -8035,
+    7568,  3135, -3135, -7568, -7568, -3135,  3135,  7568,
+    6811, -1598, -8035, -4551,  4551,  8035,  1598, -6811,
+    5793, -5793, -5793,  5793,  5793, -5793, -5793,  5793,
+    4551, -8035,  1598,  6811, -6811, -1598,  8035, -4551,
+    3135, -7568,  7568, -3135, -3135,  7568, -7568,  3135,
+    1598, -4551,  6811, -8035,  8035, -6811,  4551, -1598
+};
+
+static const int16_t idct_matrix_4[4 * 4] = {
+    5793,  5793,  5793,  5793,
+    7423,  3075, -3075, -7423,
+    5352, -5352, -5352,  5352,
+    2607, -6293,  6293, -2607
+};
+
+static const int16_t idct_matrix_2[2 * 2] = {
+    5793,  5793,
+    5249, -5249
+};
+
+static const int16_t idct_matrix_1[1] = {
+    SIMD_IDCT_DC_COEF
+};
+
+
+static const int16_t * get_idct_matrix (uint8_t size)
+{
+    switch (size) {
+        case 8: return idct_matrix_8;
+        case 4: return idct_matrix_4;
+        case 2: return idct_matrix_2;
+        default: return idct_matrix_1;
+    }
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * SCALAR KERNEL
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static uint8_t apply_matrix_row (const ColorMatrix_t * matrix, uint8_t row, uint8_t in0, uint8_t in1, uint8_t in2)
+{
+    int32_t value = 0;
+
+    value = matrix->coef[row][0] * (in0 - matrix->in_offset[0]) +
+            matrix->coef[row][1] * (in1 - matrix->in_offset[1]) +
+            matrix->coef[row][2] * (in2 - matrix->in_offset[2]) + 128;
+    value = (value >> 8) + matrix->out_offset[row];
+
+    if (value < 0) return 0;
+    if (value > 255) return 255;
+    return (uint8_t) value;
+}
+
+
+// Clamp a sum of precomputed contributions (see `init_color_terms()`)
+static inline uint8_t clamp_terms (int32_t value)
+{
+    value >>= 8;
+
+    if (value < 0) return 0;
+    if (value > 255) return 255;
+    return (uint8_t) value;
+}
+
+
+static void color_matrix_scalar (const ColorMatrix_t * matrix,
+                                 const uint8_t * in0,
+                                 const uint8_t * in1,
+                                 const uint8_t * in2,
+                                 uint8_t * out0,
+                                 uint8_t * out1,
+                                 uint8_t * out2,
+                                 uint32_t count)
+{
+    uint32_t i = 0;
+    const int32_t (* terms)[3][256] = matrix->terms;
+
+    // Three lookups per output value instead of three multiplications
+    if (terms) {
+        for (i = 0; i < count; i++) {
+            out0[i] = clamp_terms(terms[0][0][in0[i]] + terms[0][1][in1[i]] + terms[0][2][in2[i]]);
+            if (out1) out1[i] = clamp_terms(terms[1][0][in0[i]] + terms[1][1][in1[i]] + terms[1][2][in2[i]]);
+            if (out2) out2[i] = clamp_terms(terms[2][0][in0[i]] + terms[2][1][in1[i]] + terms[2][2][in2[i]]);
+        }
+        return;
+    }
+
+    for (i = 0; i < count; i++) {
+        out0[i] = apply_matrix_row(matrix, 0, in0[i], in1[i], in2[i]);
+        if (out1) out1[i] = apply_matrix_row(matrix, 1, in0[i], in1[i], in2[i]);
+        if (out2) out2[i] = apply_matrix_row(matrix, 2, in0[i], in1[i], in2[i]);
+    }
+}
+
+
+static inline void store_rgb565_pixel (uint8_t * dst,
+                                       int32_t luma,
+                                       int32_t r_chroma,
+                                       int32_t g_chroma,
+                                       int32_t b_chroma,
+                                       uint8_t swap_bytes)
+{
+    uint16_t pixel = (clamp_to_5bit_LUT[((luma + r_chroma) >> 8) + RGB565_LUT_OFFSET] << 11) |
+                     (clamp_to_6bit_LUT[((luma + g_chroma) >> 8) + RGB565_LUT_OFFSET] << 5) |
+                     clamp_to_5bit_LUT[((luma + b_chroma) >> 8) + RGB565_LUT_OFFSET];
+
+    dst[swap_bytes] = pixel & 0xff;
+    dst[!swap_bytes] = pixel >> 8;
+}
+
+
+// Contribution of a Y value to the three channels of a YUV -> RGB matrix (the rounding term and the output offset are
+// part of it when the matrix has contribution tables, and part of the chroma contributions otherwise)
+static inline int32_t luma_term (const ColorMatrix_t * matrix, uint8_t y)
+{
+    if (matrix->terms) return matrix->terms[0][0][y];
+    return matrix->coef[0][0] * (y - matrix->in_offset[0]);
+}
+
+
+static void yuv420p_to_rgb565_scalar (const ColorMatrix_t * matrix,
+                                      const uint8_t * y_row0,
+                                      const uint8_t * y_row1,
+                                      const uint8_t * u_row,
+                                      const uint8_t * v_row,
+                                      uint8_t * rgb565_row0,
+                                      uint8_t * rgb565_row1,
+                                      uint32_t count,
+                                      uint8_t swap_bytes)
+{
+    uint32_t i = 0;
+    int32_t u = 0;
+    int32_t v = 0;
+    int32_t r_chroma = 0;
+    int32_t g_chroma = 0;
+    int32_t b_chroma = 0;
+    const int32_t (* terms)[3][256] = matrix->terms;
+
+    for (i = 0; i < count; i++) {
+        // The chroma contributions are shared by a 2x2 block of pixels
+        if (!(i & 1) && terms) {
+            r_chroma = terms[0][1][u_row[i / 2]] + terms[0][2][v_row[i / 2]];
+            g_chroma = terms[1][1][u_row[i / 2]] + terms[1][2][v_row[i / 2]];
+            b_chroma = terms[2][1][u_row[i / 2]] + terms[2][2][v_row[i / 2]];
+        } else if (!(i & 1)) {
+            u = u_row[i / 2] - matrix->in_offset[1];
+            v = v_row[i / 2] - matrix->in_offset[2];
+            r_chroma = matrix->coef[0][1] * u + matrix->coef[0][2] * v + 128 + matrix->out_offset[0] * 256;
+            g_chroma = matrix->coef[1][1] * u + matrix->coef[1][2] * v + 128 + matrix->out_offset[1] * 256;
+            b_chroma = matrix->coef[2][1] * u + matrix->coef[2][2] * v + 128 + matrix->out_offset[2] * 256;
+        }
+
+        store_rgb565_pixel(&rgb565_row0[i * 2], luma_term(matrix, y_row0[i]), r_chroma, g_chroma, b_chroma,
+                           swap_bytes);
+        if (y_row1) {
+            store_rgb565_pixel(&rgb565_row1[i * 2], luma_term(matrix, y_row1[i]), r_chroma, g_chroma, b_chroma,
+                               swap_bytes);
+        }
+    }
+}
+
+
+static void transpose_8bpp_scalar (const uint8_t * src,
+                                   int32_t src_stride,
+                                   uint8_t * dst,
+                                   int32_t dst_stride,
+                                   uint32_t width,
+                                   uint32_t height)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+
+    for (i = 0; i < height; i++) {
+        for (j = 0; j < width; j++) {
+            // Strides may be negative, so the row offsets must not be mixed with the (unsigned) column offsets
+            *(dst + (int32_t) j * dst_stride + i) = *(src + (int32_t) i * src_stride + j);
+        }
+    }
+}
+
+
+static void deinterleave_24bpp_scalar (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint8_t * c2, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        c0[i] = src[i * 3];
+        c1[i] = src[i * 3 + 1];
+        c2[i] = src[i * 3 + 2];
+    }
+}
+
+
+static void interleave_24bpp_scalar (const uint8_t * c0,
+                                     const uint8_t * c1,
+                                     const uint8_t * c2,
+                                     uint8_t * dst,
+                                     uint32_t count)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        dst[i * 3] = c0[i];
+        dst[i * 3 + 1] = c1[i];
+        dst[i * 3 + 2] = c2[i];
+    }
+}
+
+
+static void deinterleave_16bpp_scalar (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        c0[i] = src[i * 2];
+        c1[i] = src[i * 2 + 1];
+    }
+}
+
+
+static void interleave_16bpp_scalar (const uint8_t * c0, const uint8_t * c1, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        dst[i * 2] = c0[i];
+        dst[i * 2 + 1] = c1[i];
+    }
+}
+
+
+// Load a little-endian 32-bit word (a single, possibly unaligned, load on little-endian CPUs)
+static inline uint32_t load_le32 (const uint8_t * src)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint32_t word = 0;
+
+    memcpy(&word, src, 4);
+    return word;
+#else
+    return src[0] | ((uint32_t) src[1] << 8) | ((uint32_t) src[2] << 16) | ((uint32_t) src[3] << 24);
+#endif
+}
+
+
+// Store a little-endian 32-bit word (a single, possibly unaligned, store on little-endian CPUs)
+static inline void store_le32 (uint8_t * dst, uint32_t word)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    memcpy(dst, &word, 4);
+#else
+    dst[0] = word;
+    dst[1] = word >> 8;
+    dst[2] = word >> 16;
+    dst[3] = word >> 24;
+#endif
+}
+
+
+static void deinterleave_32bpp_scalar (const uint8_t * src,
+                                       uint8_t * c0,
+                                       uint8_t * c1,
+                                       uint8_t * c2,
+                                       uint8_t * c3,
+                                       uint32_t count)
+{
+    uint32_t i = 0;
+    uint32_t pixel = 0;
+
+    // Every pixel is read as a whole word, rather than byte by byte
+    for (i = 0; i < count; i++) {
+        pixel = load_le32(src + i * 4);
+        c0[i] = pixel;
+        c1[i] = pixel >> 8;
+        c2[i] = pixel >> 16;
+        c3[i] = pixel >> 24;
+    }
+}
+
+
+static void interleave_32bpp_scalar (const uint8_t * c0,
+                                     const uint8_t * c1,
+                                     const uint8_t * c2,
+                                     const uint8_t * c3,
+                                     uint8_t * dst,
+                                     uint32_t count)
+{
+    uint32_t i = 0;
+
+    // Every pixel is written as a whole word, rather than byte by byte
+    for (i = 0; i < count; i++) {
+        store_le32(dst + i * 4,
+                   c0[i] | ((uint32_t) c1[i] << 8) | ((uint32_t) c2[i] << 16) | ((uint32_t) c3[i] << 24));
+    }
+}
+
+
+// Divide the product of two 8-bit values by 255, rounded to the nearest (exact for every such product)
+static inline uint8_t div255 (uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+
+static void premultiply_8bpp_scalar (const uint8_t * in, const uint8_t * alpha, uint8_t * out, uint32_t count)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < count; i++) {
+        out[i] = div255(in[i] * alpha[i]);
+    }
+}
+
+
+static void blend_8bpp_scalar (const uint8_t * src, const uint8_t * alpha, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    uint32_t value = 0;
+
+    // Properly premultiplied colors never overflow, but the SIMD kernels saturate anyway
+    for (i = 0; i < count; i++) {
+        value = src[i] + div255(dst[i] * (255 - alpha[i]));
+        dst[i] = (value > 255) ? 255 : value;
+    }
+}
+
+
+static void downsample_chroma_scalar (const uint8_t * row0,
+                                      const uint8_t * row1,
+                                      uint8_t * out,
+                                      uint32_t count,
+                                      ChromaSiting_t siting)
+{
+    uint32_t i = 0;
+    uint32_t right = 0;
+
+    for (i = 0; i < count; i += 2) {
+        // The last pixel of odd-width rows stands for the missing right column
+        right = (i + 1 < count) ? i + 1 : i;
+
+        if (siting == CHROMA_SITING_TOP_LEFT || (siting == CHROMA_SITING_LEFT && !row1)) {
+            out[i / 2] = row0[i];
+        } else if (siting == CHROMA_SITING_LEFT) {
+            out[i / 2] = (row0[i] + row1[i] + 1) >> 1;
+        } else if (!row1) {
+            out[i / 2] = (row0[i] + row0[right] + 1) >> 1;
+        } else {
+            out[i / 2] = (row0[i] + row0[right] + row1[i] + row1[right] + 2) >> 2;
+        }
+    }
+}
+
+
+static void filter_rows_scalar (const uint16_t * const * rows,
+                                const int16_t * weights,
+                                uint16_t taps,
+                                uint8_t * out,
+                                uint32_t offset,
+                                uint32_t count)
+{
+    uint32_t i = 0;
+    uint16_t t = 0;
+    uint32_t value = 0;
+
+    for (i = offset; i < offset + count; i++) {
+        value = 1 << (SIMD_FILTER_BITS + SIMD_FILTER_EXTRA_BITS - 1);
+        for (t = 0; t < taps; t++) {
+            value += weights[t] * rows[t][i];
+        }
+        value >>= SIMD_FILTER_BITS + SIMD_FILTER_EXTRA_BITS;
+
+        out[i] = (value > 255) ? 255 : value;
+    }
+}
+
+
+static inline void idct_block_scalar (const int16_t * coefs,
+                                      uint8_t size_x,
+                                      uint8_t size_y,
+                                      uint8_t * out,
+                                      int32_t out_stride)
+{
+    const int16_t * matrix_x = get_idct_matrix(size_x);
+    const int16_t * matrix_y = get_idct_matrix(size_y);
+    int16_t temp[8 * 8];
+    uint8_t x = 0;
+    uint8_t y = 0;
+    uint8_t k = 0;
+    int32_t value = 0;
+
+    // Vertical pass: only the lowest `size_y` frequencies of the lowest `size_x` columns are needed
+    for (y = 0; y < size_y; y++) {
+        for (x = 0; x < size_x; x++) {
+            value = IDCT_PASS1_BIAS;
+            for (k = 0; k < size_y; k++) {
+                value += matrix_y[k * size_y + y] * coefs[k * 8 + x];
+            }
+            value >>= IDCT_PASS1_SHIFT;
+
+            temp[y * 8 + x] = (value < INT16_MIN) ? INT16_MIN : ((value > INT16_MAX) ? INT16_MAX : value);
+        }
+    }
+
+    // Horizontal pass
+    for (y = 0; y < size_y; y++) {
+        for (x = 0; x < size_x; x++) {
+            value = IDCT_PASS2_BIAS;
+            for (k = 0; k < size_x; k++) {
+                value += temp[y * 8 + k] * matrix_x[k * size_x + x];
+            }
+            value >>= IDCT_PASS2_SHIFT;
+
+            *(out + (int32_t) y * out_stride + x) = (value < 0) ? 0 : ((value > 255) ? 255 : value);
+        }
+    }
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * x86 KERNELS (SSE2, SSSE3, AVX2 & AVX-512)
+ * --------------------------------------------------------------------------------------------------------------------
+ *
+ * Each input channel is widened to 16 bits and offset, then (in0, in1) and (in2, 1) are interleaved so that a pair of
+ * `madd` instructions computes `c0 * in0 + c1 * in1 + c2 * in2 + 128` in 32 bits, exactly like the scalar kernel.
+ * The results are shifted, narrowed back to 16 bits with signed saturation, offset, then narrowed to 8 bits with
+ * unsigned saturation, which performs the [0, 255] clamp.
+ *
+ * The 256-bit unpack/pack instructions work within 128-bit lanes; since every unpack is undone by a pack in the same
+ * lane, the AVX2 kernel needs no cross-lane permutations.
+ */
+
+#ifdef LIBUIMG_HAS_X86_SIMD
+
+__attribute__((target("sse2")))
+static inline __m128i matrix_row_sse2 (__m128i a, __m128i b, __m128i c, __m128i coef_ab, __m128i coef_c1)
+{
+    __m128i ones = _mm_set1_epi16(1);
+    __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(a, b), coef_ab),
+                               _mm_madd_epi16(_mm_unpacklo_epi16(c, ones), coef_c1));
+    __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(a, b), coef_ab),
+                               _mm_madd_epi16(_mm_unpackhi_epi16(c, ones), coef_c1));
+
+    return _mm_packs_epi32(_mm_srai_epi32(lo, 8), _mm_srai_epi32(hi, 8));
+}
+
+
+__attribute__((target("sse2")))
+static uint32_t color_matrix_sse2 (const ColorMatrix_t * matrix,
+                                   const uint8_t * in0,
+                                   const uint8_t * in1,
+                                   const uint8_t * in2,
+                                   uint8_t * out0,
+                                   uint8_t * out1,
+                                   uint8_t * out2,
+                                   uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+    uint8_t * out[3] = { out0, out1, out2 };
+    __m128i zero = _mm_setzero_si128();
+    __m128i in_offset[3];
+    __m128i out_offset[3];
+    __m128i coef_ab[3];
+    __m128i coef_c1[3];
+    __m128i x0, x1, x2;
+    __m128i a_lo, b_lo, c_lo, a_hi, b_hi, c_hi;
+    __m128i res_lo, res_hi;
+
+    for (k = 0; k < 3; k++) {
+        in_offset[k] = _mm_set1_epi16(matrix->in_offset[k]);
+        out_offset[k] = _mm_set1_epi16(matrix->out_offset[k]);
+        coef_ab[k] = _mm_set1_epi32(COEF_PAIR(matrix->coef[k][0], matrix->coef[k][1]));
+        coef_c1[k] = _mm_set1_epi32(COEF_PAIR(matrix->coef[k][2], 128));
+    }
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        x0 = _mm_loadu_si128((const __m128i *) (in0 + i));
+        x1 = _mm_loadu_si128((const __m128i *) (in1 + i));
+        x2 = _mm_loadu_si128((const __m128i *) (in2 + i));
+
+        a_lo = _mm_sub_epi16(_mm_unpacklo_epi8(x0, zero), in_offset[0]);
+        b_lo = _mm_sub_epi16(_mm_unpacklo_epi8(x1, zero), in_offset[1]);
+        c_lo = _mm_sub_epi16(_mm_unpacklo_epi8(x2, zero), in_offset[2]);
+        a_hi = _mm_sub_epi16(_mm_unpackhi_epi8(x0, zero), in_offset[0]);
+        b_hi = _mm_sub_epi16(_mm_unpackhi_epi8(x1, zero), in_offset[1]);
+        c_hi = _mm_sub_epi16(_mm_unpackhi_epi8(x2, zero), in_offset[2]);
+
+        for (k = 0; k < 3; k++) {
+            if (!out[k]) continue;
+
+            res_lo = _mm_adds_epi16(matrix_row_sse2(a_lo, b_lo, c_lo, coef_ab[k], coef_c1[k]), out_offset[k]);
+            res_hi = _mm_adds_epi16(matrix_row_sse2(a_hi, b_hi, c_hi, coef_ab[k], coef_c1[k]), out_offset[k]);
+            _mm_storeu_si128((__m128i *) (out[k] + i), _mm_packus_epi16(res_lo, res_hi));
+        }
+    }
+
+    return i;
+}
+
+
+// Clamp and quantize one channel of 8 pixels to `bits` bits; (x * 2^bits * 257) >> 16 matches the quantization tables
+// for every value but 255, which they map to 2^bits (truncated to 0 once packed)
+__attribute__((target("sse2")))
+static inline __m128i rgb565_channel_sse2 (__m128i luma_lo, __m128i luma_hi, __m128i chroma, uint8_t bits)
+{
+    __m128i max = _mm_set1_epi16(255);
+    __m128i value = _mm_packs_epi32(_mm_srai_epi32(_mm_add_epi32(luma_lo, _mm_unpacklo_epi32(chroma, chroma)), 8),
+                                    _mm_srai_epi32(_mm_add_epi32(luma_hi, _mm_unpackhi_epi32(chroma, chroma)), 8));
+
+    value = _mm_min_epi16(_mm_max_epi16(value, _mm_setzero_si128()), max);
+
+    return _mm_andnot_si128(_mm_cmpeq_epi16(value, max), _mm_mulhi_epu16(value, _mm_set1_epi16((1 << bits) * 257)));
+}
+
+
+// Convert 8 pixels (Y values minus their offset, as 16-bit integers) sharing 4 chroma contributions of each channel
+__attribute__((target("sse2")))
+static inline __m128i rgb565_pixels_sse2 (__m128i y, __m128i coef_y, __m128i r_chroma, __m128i g_chroma,
+                                          __m128i b_chroma, uint8_t swap_bytes)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i luma_lo = _mm_madd_epi16(_mm_unpacklo_epi16(y, zero), coef_y);
+    __m128i luma_hi = _mm_madd_epi16(_mm_unpackhi_epi16(y, zero), coef_y);
+    __m128i pixels = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(rgb565_channel_sse2(luma_lo, luma_hi, r_chroma, 5), 11),
+                                               _mm_slli_epi16(rgb565_channel_sse2(luma_lo, luma_hi, g_chroma, 6), 5)),
+                                  rgb565_channel_sse2(luma_lo, luma_hi, b_chroma, 5));
+
+    if (swap_bytes) pixels = _mm_or_si128(_mm_slli_epi16(pixels, 8), _mm_srli_epi16(pixels, 8));
+
+    return pixels;
+}
+
+
+__attribute__((target("sse2")))
+static uint32_t yuv420p_to_rgb565_sse2 (const ColorMatrix_t * matrix,
+                                        const uint8_t * y_row0,
+                                        const uint8_t * y_row1,
+                                        const uint8_t * u_row,
+                                        const uint8_t * v_row,
+                                        uint8_t * rgb565_row0,
+                                        uint8_t * rgb565_row1,
+                                        uint32_t count,
+                                        uint8_t swap_bytes)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+    const uint8_t * y_rows[2] = { y_row0, y_row1 };
+    uint8_t * rgb565_rows[2] = { rgb565_row0, rgb565_row1 };
+    __m128i zero = _mm_setzero_si128();
+    __m128i offset_y = _mm_set1_epi16(matrix->in_offset[0]);
+    __m128i offset_u = _mm_set1_epi16(matrix->in_offset[1]);
+    __m128i offset_v = _mm_set1_epi16(matrix->in_offset[2]);
+    __m128i coef_y = _mm_set1_epi32(matrix->coef[0][0]);
+    __m128i coef_r = _mm_set1_epi32(COEF_PAIR(matrix->coef[0][1], matrix->coef[0][2]));
+    __m128i coef_g = _mm_set1_epi32(COEF_PAIR(matrix->coef[1][1], matrix->coef[1][2]));
+    __m128i coef_b = _mm_set1_epi32(COEF_PAIR(matrix->coef[2][1], matrix->coef[2][2]));
+    __m128i bias_r = _mm_set1_epi32(128 + matrix->out_offset[0] * 256);
+    __m128i bias_g = _mm_set1_epi32(128 + matrix->out_offset[1] * 256);
+    __m128i bias_b = _mm_set1_epi32(128 + matrix->out_offset[2] * 256);
+    __m128i u, v, uv_lo, uv_hi, x;
+    __m128i r_lo, g_lo, b_lo, r_hi, g_hi, b_hi;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        // 8 (U, V) pairs, whose contributions are shared by the 16 pixels of both rows
+        u = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (u_row + i / 2)), zero), offset_u);
+        v = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (v_row + i / 2)), zero), offset_v);
+        uv_lo = _mm_unpacklo_epi16(u, v);
+        uv_hi = _mm_unpackhi_epi16(u, v);
+
+        r_lo = _mm_add_epi32(_mm_madd_epi16(uv_lo, coef_r), bias_r);
+        g_lo = _mm_add_epi32(_mm_madd_epi16(uv_lo, coef_g), bias_g);
+        b_lo = _mm_add_epi32(_mm_madd_epi16(uv_lo, coef_b), bias_b);
+        r_hi = _mm_add_epi32(_mm_madd_epi16(uv_hi, coef_r), bias_r);
+        g_hi = _mm_add_epi32(_mm_madd_epi16(uv_hi, coef_g), bias_g);
+        b_hi = _mm_add_epi32(_mm_madd_epi16(uv_hi, coef_b), bias_b);
+
+        for (k = 0; k < 2; k++) {
+            if (!y_rows[k]) continue;
+
+            x = _mm_loadu_si128((const __m128i *) (y_rows[k] + i));
+            _mm_storeu_si128((__m128i *) (rgb565_rows[k] + i * 2),
+                             rgb565_pixels_sse2(_mm_sub_epi16(_mm_unpacklo_epi8(x, zero), offset_y), coef_y,
+                                                r_lo, g_lo, b_lo, swap_bytes));
+            _mm_storeu_si128((__m128i *) (rgb565_rows[k] + i * 2 + 16),
+                             rgb565_pixels_sse2(_mm_sub_epi16(_mm_unpackhi_epi8(x, zero), offset_y), coef_y,
+                                                r_hi, g_hi, b_hi, swap_bytes));
+        }
+    }
+
+    return i;
+}
+
+
+__attribute__((target("sse2")))
+static void transpose_8bpp_sse2 (const uint8_t * src, int32_t src_stride, uint8_t * dst, int32_t dst_stride)
+{
+    __m128i a0, a1, a2, a3, b0, b1, b2, b3, c0, c1, c2, c3;
+
+    // Interleave pairs of rows, then pairs of pairs, then quadruples: each 64-bit half then holds a column
+    a0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) src),
+                           _mm_loadl_epi64((const __m128i *) (src + src_stride)));
+    a1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (src + 2 * src_stride)),
+                           _mm_loadl_epi64((const __m128i *) (src + 3 * src_stride)));
+    a2 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (src + 4 * src_stride)),
+                           _mm_loadl_epi64((const __m128i *) (src + 5 * src_stride)));
+    a3 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (src + 6 * src_stride)),
+                           _mm_loadl_epi64((const __m128i *) (src + 7 * src_stride)));
+
+    b0 = _mm_unpacklo_epi16(a0, a1);
+    b1 = _mm_unpackhi_epi16(a0, a1);
+    b2 = _mm_unpacklo_epi16(a2, a3);
+    b3 = _mm_unpackhi_epi16(a2, a3);
+
+    c0 = _mm_unpacklo_epi32(b0, b2);
+    c1 = _mm_unpackhi_epi32(b0, b2);
+    c2 = _mm_unpacklo_epi32(b1, b3);
+    c3 = _mm_unpackhi_epi32(b1, b3);
+
+    _mm_storel_epi64((__m128i *) dst, c0);
+    _mm_storel_epi64((__m128i *) (dst + dst_stride), _mm_srli_si128(c0, 8));
+    _mm_storel_epi64((__m128i *) (dst + 2 * dst_stride), c1);
+    _mm_storel_epi64((__m128i *) (dst + 3 * dst_stride), _mm_srli_si128(c1, 8));
+    _mm_storel_epi64((__m128i *) (dst + 4 * dst_stride), c2);
+    _mm_storel_epi64((__m128i *) (dst + 5 * dst_stride), _mm_srli_si128(c2, 8));
+    _mm_storel_epi64((__m128i *) (dst + 6 * dst_stride), c3);
+    _mm_storel_epi64((__m128i *) (dst + 7 * dst_stride), _mm_srli_si128(c3, 8));
+}
+
+
+// Rows are taken two at a time, so that a single `madd` instruction weighs and adds them up
+__attribute__((target("sse2")))
+static uint32_t filter_rows_sse2 (const uint16_t * const * rows,
+                                  const int16_t * weights,
+                                  uint16_t taps,
+                                  uint8_t * out,
+                                  uint32_t count)
+{
+    uint32_t i = 0;
+    uint16_t t = 0;
+    __m128i zero = _mm_setzero_si128();
+    __m128i bias = _mm_set1_epi32(1 << (SIMD_FILTER_BITS + SIMD_FILTER_EXTRA_BITS - 1));
+    __m128i a, b, w;
+    __m128i acc_lo, acc_hi;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        acc_lo = bias;
+        acc_hi = bias;
+
+        for (t = 0; t < taps; t += 2) {
+            a = _mm_loadu_si128((const __m128i *) (rows[t] + i));
+            if (t + 1 < taps) {
+                b = _mm_loadu_si128((const __m128i *) (rows[t + 1] + i));
+                w = _mm_set1_epi32(COEF_PAIR(weights[t], weights[t + 1]));
+            } else {
+                b = zero;
+                w = _mm_set1_epi32(COEF_PAIR(weights[t], 0));
+            }
+
+            acc_lo = _mm_add_epi32(acc_lo, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), w));
+            acc_hi = _mm_add_epi32(acc_hi, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), w));
+        }
+
+        acc_lo = _mm_srai_epi32(acc_lo, SIMD_FILTER_BITS + SIMD_FILTER_EXTRA_BITS);
+        acc_hi = _mm_srai_epi32(acc_hi, SIMD_FILTER_BITS + SIMD_FILTER_EXTRA_BITS);
+        a = _mm_packs_epi32(acc_lo, acc_hi);
+        _mm_storel_epi64((__m128i *) (out + i), _mm_packus_epi16(a, a));
+    }
+
+    return i;
+}
+
+
+// The vertical pass weighs pairs of coefficient rows with a single `madd` instruction, like `filter_rows_sse2()`; the
+// horizontal pass broadcasts pairs of intermediate values against interleaved pairs of matrix rows
+__attribute__((target("sse2")))
+static void idct_8x8_sse2 (const int16_t * coefs, uint8_t * out, int32_t out_stride)
+{
+    uint8_t k = 0;
+    uint8_t y = 0;
+    __m128i bias1 = _mm_set1_epi32(IDCT_PASS1_BIAS);
+    __m128i bias2 = _mm_set1_epi32(IDCT_PASS2_BIAS);
+    __m128i coef_lo[4], coef_hi[4], matrix_lo[4], matrix_hi[4], temp[8];
+    __m128i a, b, w, acc_lo, acc_hi;
+
+    for (k = 0; k < 4; k++) {
+        a = _mm_loadu_si128((const __m128i *) (coefs + 16 * k));
+        b = _mm_loadu_si128((const __m128i *) (coefs + 16 * k + 8));
+        coef_lo[k] = _mm_unpacklo_epi16(a, b);
+        coef_hi[k] = _mm_unpackhi_epi16(a, b);
+
+        a = _mm_loadu_si128((const __m128i *) (idct_matrix_8 + 16 * k));
+        b = _mm_loadu_si128((const __m128i *) (idct_matrix_8 + 16 * k + 8));
+        matrix_lo[k] = _mm_unpacklo_epi16(a, b);
+        matrix_hi[k] = _mm_unpackhi_epi16(a, b);
+    }
+
+    for (y = 0; y < 8; y++) {
+        acc_lo = bias1;
+        acc_hi = bias1;
+
+        for (k = 0; k < 4; k++) {
+            w = _mm_set1_epi32(COEF_PAIR(idct_matrix_8[16 * k + y], idct_matrix_8[16 * k + 8 + y]));
+            acc_lo = _mm_add_epi32(acc_lo, _mm_madd_epi16(coef_lo[k], w));
+            acc_hi = _mm_add_epi32(acc_hi, _mm_madd_epi16(coef_hi[k], w));
+        }
+
+        temp[y] = _mm_packs_epi32(_mm_srai_epi32(acc_lo, IDCT_PASS1_SHIFT), _mm_srai_epi32(acc_hi, IDCT_PASS1_SHIFT));
+    }
+
+    for (y = 0; y < 8; y++) {
+        // The shuffle control must be an immediate, so the four pairs are spelled out
+        a = _mm_shuffle_epi32(temp[y], 0x00);
+        acc_lo = _mm_add_epi32(bias2, _mm_madd_epi16(a, matrix_lo[0]));
+        acc_hi = _mm_add_epi32(bias2, _mm_madd_epi16(a, matrix_hi[0]));
+        a = _mm_shuffle_epi32(temp[y], 0x55);
+        acc_lo = _mm_add_epi32(acc_lo, _mm_madd_epi16(a, matrix_lo[1]));
+        acc_hi = _mm_add_epi32(acc_hi, _mm_madd_epi16(a, matrix_hi[1]));
+        a = _mm_shuffle_epi32(temp[y], 0xaa);
+        acc_lo = _mm_add_epi32(acc_lo, _mm_madd_epi16(a, matrix_lo[2]));
+        acc_hi = _mm_add_epi32(acc_hi, _mm_madd_epi16(a, matrix_hi[2]));
+        a = _mm_shuffle_epi32(temp[y], 0xff);
+        acc_lo = _mm_add_epi32(acc_lo, _mm_madd_epi16(a, matrix_lo[3]));
+        acc_hi = _mm_add_epi32(acc_hi, _mm_madd_epi16(a, matrix_hi[3]));
+
+        a = _mm_packs_epi32(_mm_srai_epi32(acc_lo, IDCT_PASS2_SHIFT), _mm_srai_epi32(acc_hi, IDCT_PASS2_SHIFT));
+        _mm_storel_epi64((__m128i *) (out + (int32_t) y * out_stride), _mm_packus_epi16(a, a));
+    }
+}
+
+
+__attribute__((target("sse2")))
+static uint32_t deinterleave_16bpp_sse2 (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint32_t count)
+{
+    uint32_t i = 0;
+    __m128i x0, x1;
+    const __m128i low_bytes = _mm_set1_epi16(0x00ff);
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        x0 = _mm_loadu_si128((const __m128i *) (src + i * 2));
+        x1 = _mm_loadu_si128((const __m128i *) (src + i * 2 + 16));
+
+        // Even bytes are the low halves of the 16-bit lanes, odd bytes their high halves
+        _mm_storeu_si128((__m128i *) (c0 + i),
+                         _mm_packus_epi16(_mm_and_si128(x0, low_bytes), _mm_and_si128(x1, low_bytes)));
+        _mm_storeu_si128((__m128i *) (c1 + i), _mm_packus_epi16(_mm_srli_epi16(x0, 8), _mm_srli_epi16(x1, 8)));
+    }
+
+    return i;
+}
+
+
+__attribute__((target("sse2")))
+static uint32_t interleave_16bpp_sse2 (const uint8_t * c0, const uint8_t * c1, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    __m128i x0, x1;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        x0 = _mm_loadu_si128((const __m128i *) (c0 + i));
+        x1 = _mm_loadu_si128((const __m128i *) (c1 + i));
+
+        _mm_storeu_si128((__m128i *) (dst + i * 2), _mm_unpacklo_epi8(x0, x1));
+        _mm_storeu_si128((__m128i *) (dst + i * 2 + 16), _mm_unpackhi_epi8(x0, x1));
+    }
+
+    return i;
+}
+
+
+// Gather the byte at `shift` of every 32-bit lane of four vectors (16 pixels)
+__attribute__((target("sse2")))
+static inline __m128i gather_channel_sse2 (__m128i x0, __m128i x1, __m128i x2, __m128i x3, int32_t shift)
+{
+    const __m128i low_byte = _mm_set1_epi32(0xff);
+
+    x0 = _mm_and_si128(_mm_srli_epi32(x0, shift), low_byte);
+    x1 = _mm_and_si128(_mm_srli_epi32(x1, shift), low_byte);
+    x2 = _mm_and_si128(_mm_srli_epi32(x2, shift), low_byte);
+    x3 = _mm_and_si128(_mm_srli_epi32(x3, shift), low_byte);
+
+    // Lanes hold values below 256, so neither pack saturates
+    return _mm_packus_epi16(_mm_packs_epi32(x0, x1), _mm_packs_epi32(x2, x3));
+}
+
+
+__attribute__((target("sse2")))
+static uint32_t deinterleave_32bpp_sse2 (const uint8_t * src,
+                                         uint8_t * c0,
+                                         uint8_t * c1,
+                                         uint8_t * c2,
+                                         uint8_t * c3,
+                                         uint32_t count)
+{
+    uint32_t i = 0;
+    __m128i x0, x1, x2, x3;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        x0 = _mm_loadu_si128((const __m128i *) (src + i * 4));
+        x1 = _mm_loadu_si128((const __m128i *) (src + i * 4 + 16));
+        x2 = _mm_loadu_si128((const __m128i *) (src + i * 4 + 32));
+        x3 = _mm_loadu_si128((const __m128i *) (src + i * 4 + 48));
+
+        _mm_storeu_si128((__m128i *) (c0 + i), gather_channel_sse2(x0, x1, x2, x3, 0));
+        _mm_storeu_si128((__m128i *) (c1 + i), gather_channel_sse2(x0, x1, x2, x3, 8));
+        _mm_storeu_si128((__m128i *) (c2 + i), gather_channel_sse2(x0, x1, x2, x3, 16));
+        _mm_storeu_si128((__m128i *) (c3 + i), gather_channel_sse2(x0, x1, x2, x3, 24));
+    }
+
+    return i;
+}
+
+
+__attribute__((target("sse2")))
+static uint32_t interleave_32bpp_sse2 (const uint8_t * c0,
+                                       const uint8_t * c1,
+                                       const uint8_t * c2,
+                                       const uint8_t * c3,
+                                       uint8_t * dst,
+                                       uint32_t count)
+{
+    uint32_t i = 0;
+    __m128i x0, x1, x2, x3, lo01, hi01, lo23, hi23;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        x0 = _mm_loadu_si128((const __m128i *) (c0 + i));
+        x1 = _mm_loadu_si128((const __m128i *) (c1 + i));
+        x2 = _mm_loadu_si128((const __m128i *) (c2 + i));
+        x3 = _mm_loadu_si128((const __m128i *) (c3 + i));
+
+        // Byte pairs first (c0, c1 and c2, c3), then pairs of pairs
+        lo01 = _mm_unpacklo_epi8(x0, x1);
+        hi01 = _mm_unpackhi_epi8(x0, x1);
+        lo23 = _mm_unpacklo_epi8(x2, x3);
+        hi23 = _mm_unpackhi_epi8(x2, x3);
+        _mm_storeu_si128((__m128i *) (dst + i * 4), _mm_unpacklo_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i *) (dst + i * 4 + 16), _mm_unpackhi_epi16(lo01, lo23));
+        _mm_storeu_si128((__m128i *) (dst + i * 4 + 32), _mm_unpacklo_epi16(hi01, hi23));
+        _mm_storeu_si128((__m128i *) (dst + i * 4 + 48), _mm_unpackhi_epi16(hi01, hi23));
+    }
+
+    return i;
+}
+
+
+// Divide the products of two 8-bit values held in 16-bit lanes by 255, rounded to the nearest (as `div255()`)
+__attribute__((target("sse2")))
+static inline __m128i div255_sse2 (__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+
+__attribute__((target("sse2")))
+static uint32_t premultiply_8bpp_sse2 (const uint8_t * in, const uint8_t * alpha, uint8_t * out, uint32_t count)
+{
+    uint32_t i = 0;
+    __m128i c, a, lo, hi;
+    const __m128i zero = _mm_setzero_si128();
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        c = _mm_loadu_si128((const __m128i *) (in + i));
+        a = _mm_loadu_si128((const __m128i *) (alpha + i));
+
+        lo = div255_sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(c, zero), _mm_unpacklo_epi8(a, zero)));
+        hi = div255_sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(c, zero), _mm_unpackhi_epi8(a, zero)));
+        _mm_storeu_si128((__m128i *) (out + i), _mm_packus_epi16(lo, hi));
+    }
+
+    return i;
+}
+
+
+__attribute__((target("sse2")))
+static uint32_t blend_8bpp_sse2 (const uint8_t * src, const uint8_t * alpha, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    __m128i s, d, inv, lo, hi;
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi8(-1);
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        s = _mm_loadu_si128((const __m128i *) (src + i));
+        d = _mm_loadu_si128((const __m128i *) (dst + i));
+        // 255 - alpha
+        inv = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (alpha + i)), ones);
+
+        lo = div255_sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(inv, zero)));
+        hi = div255_sse2(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(inv, zero)));
+        _mm_storeu_si128((__m128i *) (dst + i), _mm_adds_epu8(s, _mm_packus_epi16(lo, hi)));
+    }
+
+    return i;
+}
+
+
+// Downsample 16 pixels of one or two rows to 8 chroma values, as 16-bit integers (see `downsample_chroma_scalar()`)
+__attribute__((target("sse2")))
+static inline __m128i downsample_chroma_vector_sse2 (__m128i a, __m128i b, uint8_t has_row1, ChromaSiting_t siting)
+{
+    const __m128i even = _mm_set1_epi16(0x00ff);
+    __m128i sum;
+
+    if (siting == CHROMA_SITING_TOP_LEFT || (siting == CHROMA_SITING_LEFT && !has_row1)) return _mm_and_si128(a, even);
+    // The rounded average of two bytes is exact
+    if (siting == CHROMA_SITING_LEFT) return _mm_and_si128(_mm_avg_epu8(a, b), even);
+
+    sum = _mm_add_epi16(_mm_and_si128(a, even), _mm_srli_epi16(a, 8));
+    if (!has_row1) return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(1)), 1);
+
+    sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_and_si128(b, even), _mm_srli_epi16(b, 8)));
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+}
+
+
+__attribute__((target("sse2")))
+static uint32_t downsample_chroma_sse2 (const uint8_t * row0,
+                                        const uint8_t * row1,
+                                        uint8_t * out,
+                                        uint32_t count,
+                                        ChromaSiting_t siting)
+{
+    uint32_t i = 0;
+    __m128i b_lo = _mm_setzero_si128();
+    __m128i b_hi = _mm_setzero_si128();
+    __m128i lo, hi;
+
+    for (i = 0; i + 32 <= count; i += 32) {
+        if (row1) {
+            b_lo = _mm_loadu_si128((const __m128i *) (row1 + i));
+            b_hi = _mm_loadu_si128((const __m128i *) (row1 + i + 16));
+        }
+
+        lo = downsample_chroma_vector_sse2(_mm_loadu_si128((const __m128i *) (row0 + i)), b_lo, row1 != NULL, siting);
+        hi = downsample_chroma_vector_sse2(_mm_loadu_si128((const __m128i *) (row0 + i + 16)), b_hi, row1 != NULL,
+                                           siting);
+        _mm_storeu_si128((__m128i *) (out + i / 2), _mm_packus_epi16(lo, hi));
+    }
+
+    return i;
+}
+
+
+__attribute__((target("avx2")))
+static inline __m256i matrix_row_avx2 (__m256i a, __m256i b, __m256i c, __m256i coef_ab, __m256i coef_c1)
+{
+    __m256i ones = _mm256_set1_epi16(1);
+    __m256i lo = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpacklo_epi16(a, b), coef_ab),
+                                  _mm256_madd_epi16(_mm256_unpacklo_epi16(c, ones), coef_c1));
+    __m256i hi = _mm256_add_epi32(_mm256_madd_epi16(_mm256_unpackhi_epi16(a, b), coef_ab),
+                                  _mm256_madd_epi16(_mm256_unpackhi_epi16(c, ones), coef_c1));
+
+    return _mm256_packs_epi32(_mm256_srai_epi32(lo, 8), _mm256_srai_epi32(hi, 8));
+}
+
+
+__attribute__((target("avx2")))
+static uint32_t color_matrix_avx2 (const ColorMatrix_t * matrix,
+                                   const uint8_t * in0,
+                                   const uint8_t * in1,
+                                   const uint8_t * in2,
+                                   uint8_t * out0,
+                                   uint8_t * out1,
+                                   uint8_t * out2,
+                                   uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+    uint8_t * out[3] = { out0, out1, out2 };
+    __m256i zero = _mm256_setzero_si256();
+    __m256i in_offset[3];
+    __m256i out_offset[3];
+    __m256i coef_ab[3];
+    __m256i coef_c1[3];
+    __m256i x0, x1, x2;
+    __m256i a_lo, b_lo, c_lo, a_hi, b_hi, c_hi;
+    __m256i res_lo, res_hi;
+
+    for (k = 0; k < 3; k++) {
+        in_offset[k] = _mm256_set1_epi16(matrix->in_offset[k]);
+        out_offset[k] = _mm256_set1_epi16(matrix->out_offset[k]);
+        coef_ab[k] = _mm256_set1_epi32(COEF_PAIR(matrix->coef[k][0], matrix->coef[k][1]));
+        coef_c1[k] = _mm256_set1_epi32(COEF_PAIR(matrix->coef[k][2], 128));
+    }
+
+    for (i = 0; i + 32 <= count; i += 32) {
+        x0 = _mm256_loadu_si256((const __m256i *) (in0 + i));
+        x1 = _mm256_loadu_si256((const __m256i *) (in1 + i));
+        x2 = _mm256_loadu_si256((const __m256i *) (in2 + i));
+
+        a_lo = _mm256_sub_epi16(_mm256_unpacklo_epi8(x0, zero), in_offset[0]);
+        b_lo = _mm256_sub_epi16(_mm256_unpacklo_epi8(x1, zero), in_offset[1]);
+        c_lo = _mm256_sub_epi16(_mm256_unpacklo_epi8(x2, zero), in_offset[2]);
+        a_hi = _mm256_sub_epi16(_mm256_unpackhi_epi8(x0, zero), in_offset[0]);
+        b_hi = _mm256_sub_epi16(_mm256_unpackhi_epi8(x1, zero), in_offset[1]);
+        c_hi = _mm256_sub_epi16(_mm256_unpackhi_epi8(x2, zero), in_offset[2]);
+
+        for (k = 0; k < 3; k++) {
+            if (!out[k]) continue;
+
+            res_lo = _mm256_adds_epi16(matrix_row_avx2(a_lo, b_lo, c_lo, coef_ab[k], coef_c1[k]), out_offset[k]);
+            res_hi = _mm256_adds_epi16(matrix_row_avx2(a_hi, b_hi, c_hi, coef_ab[k], coef_c1[k]), out_offset[k]);
+            _mm256_storeu_si256((__m256i *) (out[k] + i), _mm256_packus_epi16(res_lo, res_hi));
+        }
+    }
+
+    return i;
+}
+
+
+__attribute__((target("avx2")))
+static uint32_t deinterleave_16bpp_avx2 (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint32_t count)
+{
+    uint32_t i = 0;
+    __m256i x0, x1;
+    const __m256i low_bytes = _mm256_set1_epi16(0x00ff);
+
+    for (i = 0; i + 32 <= count; i += 32) {
+        x0 = _mm256_loadu_si256((const __m256i *) (src + i * 2));
+        x1 = _mm256_loadu_si256((const __m256i *) (src + i * 2 + 32));
+
+        // Packing works within 128-bit lanes, so the 64-bit quarters come out as 0, 2, 1, 3
+        _mm256_storeu_si256((__m256i *) (c0 + i),
+                            _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_and_si256(x0, low_bytes),
+                                                                         _mm256_and_si256(x1, low_bytes)), 0xd8));
+        _mm256_storeu_si256((__m256i *) (c1 + i),
+                            _mm256_permute4x64_epi64(_mm256_packus_epi16(_mm256_srli_epi16(x0, 8),
+                                                                         _mm256_srli_epi16(x1, 8)), 0xd8));
+    }
+
+    return i;
+}
+
+
+__attribute__((target("avx2")))
+static uint32_t interleave_16bpp_avx2 (const uint8_t * c0, const uint8_t * c1, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    __m256i x0, x1, lo, hi;
+
+    for (i = 0; i + 32 <= count; i += 32) {
+        x0 = _mm256_loadu_si256((const __m256i *) (c0 + i));
+        x1 = _mm256_loadu_si256((const __m256i *) (c1 + i));
+
+        // Unpacking works within 128-bit lanes: `lo` holds pairs 0-7 and 16-23, `hi` pairs 8-15 and 24-31
+        lo = _mm256_unpacklo_epi8(x0, x1);
+        hi = _mm256_unpackhi_epi8(x0, x1);
+        _mm256_storeu_si256((__m256i *) (dst + i * 2), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i *) (dst + i * 2 + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    return i;
+}
+
+
+// Gather the byte at `shift` of every 32-bit lane of four vectors (32 pixels)
+__attribute__((target("avx2")))
+static inline __m256i gather_channel_avx2 (__m256i x0, __m256i x1, __m256i x2, __m256i x3, int32_t shift)
+{
+    const __m256i low_byte = _mm256_set1_epi32(0xff);
+    // Packing works within 128-bit lanes, so groups of 4 pixels come out as 0, 2, 4, 6, 1, 3, 5, 7
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+
+    x0 = _mm256_and_si256(_mm256_srli_epi32(x0, shift), low_byte);
+    x1 = _mm256_and_si256(_mm256_srli_epi32(x1, shift), low_byte);
+    x2 = _mm256_and_si256(_mm256_srli_epi32(x2, shift), low_byte);
+    x3 = _mm256_and_si256(_mm256_srli_epi32(x3, shift), low_byte);
+
+    return _mm256_permutevar8x32_epi32(_mm256_packus_epi16(_mm256_packs_epi32(x0, x1), _mm256_packs_epi32(x2, x3)),
+                                       order);
+}
+
+
+__attribute__((target("avx2")))
+static uint32_t deinterleave_32bpp_avx2 (const uint8_t * src,
+                                         uint8_t * c0,
+                                         uint8_t * c1,
+                                         uint8_t * c2,
+                                         uint8_t * c3,
+                                         uint32_t count)
+{
+    uint32_t i = 0;
+    __m256i x0, x1, x2, x3;
+
+    for (i = 0; i + 32 <= count; i += 32) {
+        x0 = _mm256_loadu_si256((const __m256i *) (src + i * 4));
+        x1 = _mm256_loadu_si256((const __m256i *) (src + i * 4 + 32));
+        x2 = _mm256_loadu_si256((const __m256i *) (src + i * 4 + 64));
+        x3 = _mm256_loadu_si256((const __m256i *) (src + i * 4 + 96));
+
+        _mm256_storeu_si256((__m256i *) (c0 + i), gather_channel_avx2(x0, x1, x2, x3, 0));
+        _mm256_storeu_si256((__m256i *) (c1 + i), gather_channel_avx2(x0, x1, x2, x3, 8));
+        _mm256_storeu_si256((__m256i *) (c2 + i), gather_channel_avx2(x0, x1, x2, x3, 16));
+        _mm256_storeu_si256((__m256i *) (c3 + i), gather_channel_avx2(x0, x1, x2, x3, 24));
+    }
+
+    return i;
+}
+
+
+__attribute__((target("avx2")))
+static uint32_t interleave_32bpp_avx2 (const uint8_t * c0,
+                                       const uint8_t * c1,
+                                       const uint8_t * c2,
+                                       const uint8_t * c3,
+                                       uint8_t * dst,
+                                       uint32_t count)
+{
+    uint32_t i = 0;
+    __m256i x0, x1, x2, x3, lo01, hi01, lo23, hi23, p0, p1, p2, p3;
+
+    for (i = 0; i + 32 <= count; i += 32) {
+        x0 = _mm256_loadu_si256((const __m256i *) (c0 + i));
+        x1 = _mm256_loadu_si256((const __m256i *) (c1 + i));
+        x2 = _mm256_loadu_si256((const __m256i *) (c2 + i));
+        x3 = _mm256_loadu_si256((const __m256i *) (c3 + i));
+
+        // Unpacking works within 128-bit lanes: `p0` holds pixels 0-3 and 16-19, `p1` pixels 4-7 and 20-23, `p2`
+        // pixels 8-11 and 24-27, and `p3` pixels 12-15 and 28-31
+        lo01 = _mm256_unpacklo_epi8(x0, x1);
+        hi01 = _mm256_unpackhi_epi8(x0, x1);
+        lo23 = _mm256_unpacklo_epi8(x2, x3);
+        hi23 = _mm256_unpackhi_epi8(x2, x3);
+        p0 = _mm256_unpacklo_epi16(lo01, lo23);
+        p1 = _mm256_unpackhi_epi16(lo01, lo23);
+        p2 = _mm256_unpacklo_epi16(hi01, hi23);
+        p3 = _mm256_unpackhi_epi16(hi01, hi23);
+        _mm256_storeu_si256((__m256i *) (dst + i * 4), _mm256_permute2x128_si256(p0, p1, 0x20));
+        _mm256_storeu_si256((__m256i *) (dst + i * 4 + 32), _mm256_permute2x128_si256(p2, p3, 0x20));
+        _mm256_storeu_si256((__m256i *) (dst + i * 4 + 64), _mm256_permute2x128_si256(p0, p1, 0x31));
+        _mm256_storeu_si256((__m256i *) (dst + i * 4 + 96), _mm256_permute2x128_si256(p2, p3, 0x31));
+    }
+
+    return i;
+}
+
+
+// Divide the products of two 8-bit values held in 16-bit lanes by 255, rounded to the nearest (as `div255()`)
+__attribute__((target("avx2")))
+static inline __m256i div255_avx2 (__m256i x)
+{
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+
+__attribute__((target("avx2")))
+static uint32_t premultiply_8bpp_avx2 (const uint8_t * in, const uint8_t * alpha, uint8_t * out, uint32_t count)
+{
+    uint32_t i = 0;
+    __m256i c, a, lo, hi;
+    const __m256i zero = _mm256_setzero_si256();
+
+    // Unpacking and packing both work within 128-bit lanes, so the pixels come out in order
+    for (i = 0; i + 32 <= count; i += 32) {
+        c = _mm256_loadu_si256((const __m256i *) (in + i));
+        a = _mm256_loadu_si256((const __m256i *) (alpha + i));
+
+        lo = div255_avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(c, zero), _mm256_unpacklo_epi8(a, zero)));
+        hi = div255_avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(c, zero), _mm256_unpackhi_epi8(a, zero)));
+        _mm256_storeu_si256((__m256i *) (out + i), _mm256_packus_epi16(lo, hi));
+    }
+
+    return i;
+}
+
+
+__attribute__((target("avx2")))
+static uint32_t blend_8bpp_avx2 (const uint8_t * src, const uint8_t * alpha, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    __m256i s, d, inv, lo, hi;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi8(-1);
+
+    for (i = 0; i + 32 <= count; i += 32) {
+        s = _mm256_loadu_si256((const __m256i *) (src + i));
+        d = _mm256_loadu_si256((const __m256i *) (dst + i));
+        // 255 - alpha
+        inv = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (alpha + i)), ones);
+
+        lo = div255_avx2(_mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi8(inv, zero)));
+        hi = div255_avx2(_mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi8(inv, zero)));
+        _mm256_storeu_si256((__m256i *) (dst + i), _mm256_adds_epu8(s, _mm256_packus_epi16(lo, hi)));
+    }
+
+    return i;
+}
+
+/**
+ * @brief Byte shuffles gathering one channel of 16 24-bit pixels: `deinterleave_masks[k][v]` picks the bytes of
+ *        channel k found in the v-th vector of the 48 bytes of the pixels (0x80 clears a byte).
+ */
+static const uint8_t deinterleave_masks[3][3][16] = {
+    {
+        { 0x00, 0x03, 0x06, 0x09, 0x0c, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 0x05, 0x08, 0x0b, 0x0e, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x04, 0x07, 0x0a, 0x0d }
+    },
+    {
+        { 0x01, 0x04, 0x07, 0x0a, 0x0d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x03, 0x06, 0x09, 0x0c, 0x0f, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x02, 0x05, 0x08, 0x0b, 0x0e }
+    },
+    {
+        { 0x02, 0x05, 0x08, 0x0b, 0x0e, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x04, 0x07, 0x0a, 0x0d, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 },
+        { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0x03, 0x06, 0x09, 0x0c, 0x0f }
+    }
+};
+
+/**
+ * @brief Byte shuffles scattering three channels into 16 24-bit pixels: `interleave_masks[v][k]` places the bytes of
+ *        channel k that belong to the v-th vector of the 48 bytes of the pixels (0x80 clears a byte).
+ */
+static const uint8_t interleave_masks[3][3][16] = {
+    {
+        { 0x00, 0x80, 0x80, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80, 0x05 },
+        { 0x80, 0x00, 0x80, 0x80, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x04, 0x80, 0x80 },
+        { 0x80, 0x80, 0x00, 0x80, 0x80, 0x01, 0x80, 0x80, 0x02, 0x80, 0x80, 0x03, 0x80, 0x80, 0x04, 0x80 }
+    },
+    {
+        { 0x80, 0x80, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80, 0x0a, 0x80 },
+        { 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80, 0x0a },
+        { 0x80, 0x05, 0x80, 0x80, 0x06, 0x80, 0x80, 0x07, 0x80, 0x80, 0x08, 0x80, 0x80, 0x09, 0x80, 0x80 }
+    },
+    {
+        { 0x80, 0x0b, 0x80, 0x80, 0x0c, 0x80, 0x80, 0x0d, 0x80, 0x80, 0x0e, 0x80, 0x80, 0x0f, 0x80, 0x80 },
+        { 0x80, 0x80, 0x0b, 0x80, 0x80, 0x0c, 0x80, 0x80, 0x0d, 0x80, 0x80, 0x0e, 0x80, 0x80, 0x0f, 0x80 },
+        { 0x0a, 0x80, 0x80, 0x0b, 0x80, 0x80, 0x0c, 0x80, 0x80, 0x0d, 0x80, 0x80, 0x0e, 0x80, 0x80, 0x0f }
+    }
+};
+
+
+__attribute__((target("ssse3")))
+static uint32_t deinterleave_24bpp_ssse3 (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint8_t * c2, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+    uint8_t v = 0;
+    uint8_t * out[3] = { c0, c1, c2 };
+    __m128i masks[3][3];
+    __m128i x0, x1, x2;
+
+    for (k = 0; k < 3; k++) {
+        for (v = 0; v < 3; v++) masks[k][v] = _mm_loadu_si128((const __m128i *) deinterleave_masks[k][v]);
+    }
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        x0 = _mm_loadu_si128((const __m128i *) (src + i * 3));
+        x1 = _mm_loadu_si128((const __m128i *) (src + i * 3 + 16));
+        x2 = _mm_loadu_si128((const __m128i *) (src + i * 3 + 32));
+
+        for (k = 0; k < 3; k++) {
+            _mm_storeu_si128((__m128i *) (out[k] + i),
+                             _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(x0, masks[k][0]),
+                                                       _mm_shuffle_epi8(x1, masks[k][1])),
+                                          _mm_shuffle_epi8(x2, masks[k][2])));
+        }
+    }
+
+    return i;
+}
+
+
+__attribute__((target("ssse3")))
+static uint32_t interleave_24bpp_ssse3 (const uint8_t * c0,
+                                        const uint8_t * c1,
+                                        const uint8_t * c2,
+                                        uint8_t * dst,
+                                        uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+    uint8_t v = 0;
+    __m128i masks[3][3];
+    __m128i x0, x1, x2;
+
+    for (v = 0; v < 3; v++) {
+        for (k = 0; k < 3; k++) masks[v][k] = _mm_loadu_si128((const __m128i *) interleave_masks[v][k]);
+    }
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        x0 = _mm_loadu_si128((const __m128i *) (c0 + i));
+        x1 = _mm_loadu_si128((const __m128i *) (c1 + i));
+        x2 = _mm_loadu_si128((const __m128i *) (c2 + i));
+
+        for (v = 0; v < 3; v++) {
+            _mm_storeu_si128((__m128i *) (dst + i * 3 + v * 16),
+                             _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(x0, masks[v][0]),
+                                                       _mm_shuffle_epi8(x1, masks[v][1])),
+                                          _mm_shuffle_epi8(x2, masks[v][2])));
+        }
+    }
+
+    return i;
+}
+
+
+__attribute__((target("avx512bw")))
+static inline __m512i matrix_row_avx512 (__m512i a, __m512i b, __m512i c, __m512i coef_ab, __m512i coef_c1)
+{
+    __m512i ones = _mm512_set1_epi16(1);
+    __m512i lo = _mm512_add_epi32(_mm512_madd_epi16(_mm512_unpacklo_epi16(a, b), coef_ab),
+                                  _mm512_madd_epi16(_mm512_unpacklo_epi16(c, ones), coef_c1));
+    __m512i hi = _mm512_add_epi32(_mm512_madd_epi16(_mm512_unpackhi_epi16(a, b), coef_ab),
+                                  _mm512_madd_epi16(_mm512_unpackhi_epi16(c, ones), coef_c1));
+
+    return _mm512_packs_epi32(_mm512_srai_epi32(lo, 8), _mm512_srai_epi32(hi, 8));
+}
+
+
+// Same as the AVX2 kernel, on 64 pixels at a time (a whole `SIMD_BLOCK_SIZE` block)
+__attribute__((target("avx512bw")))
+static uint32_t color_matrix_avx512 (const ColorMatrix_t * matrix,
+                                     const uint8_t * in0,
+                                     const uint8_t * in1,
+                                     const uint8_t * in2,
+                                     uint8_t * out0,
+                                     uint8_t * out1,
+                                     uint8_t * out2,
+                                     uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+    uint8_t * out[3] = { out0, out1, out2 };
+    __m512i zero = _mm512_setzero_si512();
+    __m512i in_offset[3];
+    __m512i out_offset[3];
+    __m512i coef_ab[3];
+    __m512i coef_c1[3];
+    __m512i x0, x1, x2;
+    __m512i a_lo, b_lo, c_lo, a_hi, b_hi, c_hi;
+    __m512i res_lo, res_hi;
+
+    for (k = 0; k < 3; k++) {
+        in_offset[k] = _mm512_set1_epi16(matrix->in_offset[k]);
+        out_offset[k] = _mm512_set1_epi16(matrix->out_offset[k]);
+        coef_ab[k] = _mm512_set1_epi32(COEF_PAIR(matrix->coef[k][0], matrix->coef[k][1]));
+        coef_c1[k] = _mm512_set1_epi32(COEF_PAIR(matrix->coef[k][2], 128));
+    }
+
+    for (i = 0; i + 64 <= count; i += 64) {
+        x0 = _mm512_loadu_si512((const void *) (in0 + i));
+        x1 = _mm512_loadu_si512((const void *) (in1 + i));
+        x2 = _mm512_loadu_si512((const void *) (in2 + i));
+
+        a_lo = _mm512_sub_epi16(_mm512_unpacklo_epi8(x0, zero), in_offset[0]);
+        b_lo = _mm512_sub_epi16(_mm512_unpacklo_epi8(x1, zero), in_offset[1]);
+        c_lo = _mm512_sub_epi16(_mm512_unpacklo_epi8(x2, zero), in_offset[2]);
+        a_hi = _mm512_sub_epi16(_mm512_unpackhi_epi8(x0, zero), in_offset[0]);
+        b_hi = _mm512_sub_epi16(_mm512_unpackhi_epi8(x1, zero), in_offset[1]);
+        c_hi = _mm512_sub_epi16(_mm512_unpackhi_epi8(x2, zero), in_offset[2]);
+
+        for (k = 0; k < 3; k++) {
+            if (!out[k]) continue;
+
+            res_lo = _mm512_adds_epi16(matrix_row_avx512(a_lo, b_lo, c_lo, coef_ab[k], coef_c1[k]), out_offset[k]);
+            res_hi = _mm512_adds_epi16(matrix_row_avx512(a_hi, b_hi, c_hi, coef_ab[k], coef_c1[k]), out_offset[k]);
+            _mm512_storeu_si512((void *) (out[k] + i), _mm512_packus_epi16(res_lo, res_hi));
+        }
+    }
+
+    return i;
+}
+
+#endif
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * ARM KERNELS (NEON)
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifdef LIBUIMG_HAS_NEON
+
+static inline int16x8_t matrix_row_neon (int16x8_t a, int16x8_t b, int16x8_t c, const int16_t * coef)
+{
+    int32x4_t bias = vdupq_n_s32(128);
+    int32x4_t lo = vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(bias, vget_low_s16(a), coef[0]),
+                                           vget_low_s16(b), coef[1]),
+                               vget_low_s16(c), coef[2]);
+    int32x4_t hi = vmlal_n_s16(vmlal_n_s16(vmlal_n_s16(bias, vget_high_s16(a), coef[0]),
+                                           vget_high_s16(b), coef[1]),
+                               vget_high_s16(c), coef[2]);
+
+    return vcombine_s16(vqmovn_s32(vshrq_n_s32(lo, 8)), vqmovn_s32(vshrq_n_s32(hi, 8)));
+}
+
+
+static uint32_t color_matrix_neon (const ColorMatrix_t * matrix,
+                                   const uint8_t * in0,
+                                   const uint8_t * in1,
+                                   const uint8_t * in2,
+                                   uint8_t * out0,
+                                   uint8_t * out1,
+                                   uint8_t * out2,
+                                   uint32_t count)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+    uint8_t * out[3] = { out0, out1, out2 };
+    int16x8_t in_offset[3];
+    int16x8_t out_offset[3];
+    uint8x16_t x0, x1, x2;
+    int16x8_t a_lo, b_lo, c_lo, a_hi, b_hi, c_hi;
+    int16x8_t res_lo, res_hi;
+
+    for (k = 0; k < 3; k++) {
+        in_offset[k] = vdupq_n_s16(matrix->in_offset[k]);
+        out_offset[k] = vdupq_n_s16(matrix->out_offset[k]);
+    }
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        x0 = vld1q_u8(in0 + i);
+        x1 = vld1q_u8(in1 + i);
+        x2 = vld1q_u8(in2 + i);
+
+        a_lo = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(x0))), in_offset[0]);
+        b_lo = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(x1))), in_offset[1]);
+        c_lo = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(x2))), in_offset[2]);
+        a_hi = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(x0))), in_offset[0]);
+        b_hi = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(x1))), in_offset[1]);
+        c_hi = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(x2))), in_offset[2]);
+
+        for (k = 0; k < 3; k++) {
+            if (!out[k]) continue;
+
+            res_lo = vqaddq_s16(matrix_row_neon(a_lo, b_lo, c_lo, matrix->coef[k]), out_offset[k]);
+            res_hi = vqaddq_s16(matrix_row_neon(a_hi, b_hi, c_hi, matrix->coef[k]), out_offset[k]);
+            vst1q_u8(out[k] + i, vcombine_u8(vqmovun_s16(res_lo), vqmovun_s16(res_hi)));
+        }
+    }
+
+    return i;
+}
+
+// Clamp and quantize one channel of 8 pixels to `bits` bits (see `rgb565_channel_sse2()`)
+static inline uint16x8_t rgb565_channel_neon (int32x4_t luma_lo, int32x4_t luma_hi, int32x4x2_t chroma, uint8_t bits)
+{
+    uint16x8_t value = vmovl_u8(vqmovun_s16(vcombine_s16(vqmovn_s32(vshrq_n_s32(vaddq_s32(luma_lo, chroma.val[0]), 8)),
+                                                         vqmovn_s32(vshrq_n_s32(vaddq_s32(luma_hi, chroma.val[1]), 8)))));
+    uint16_t mul = (1 << bits) * 257;
+    uint16x8_t quantized = vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(value), mul), 16),
+                                        vshrn_n_u32(vmull_n_u16(vget_high_u16(value), mul), 16));
+
+    return vbicq_u16(quantized, vceqq_u16(value, vdupq_n_u16(255)));
+}
+
+
+// Convert 8 pixels (Y values minus their offset, as 16-bit integers) sharing 4 chroma contributions of each channel
+static inline uint8x16_t rgb565_pixels_neon (int16x8_t y,
+                                             int16_t coef_y,
+                                             int32x4_t r_chroma,
+                                             int32x4_t g_chroma,
+                                             int32x4_t b_chroma,
+                                             uint8_t swap_bytes)
+{
+    int32x4_t luma_lo = vmull_n_s16(vget_low_s16(y), coef_y);
+    int32x4_t luma_hi = vmull_n_s16(vget_high_s16(y), coef_y);
+    uint16x8_t pixels = vorrq_u16(vorrq_u16(vshlq_n_u16(rgb565_channel_neon(luma_lo, luma_hi,
+                                                                            vzipq_s32(r_chroma, r_chroma), 5), 11),
+                                            vshlq_n_u16(rgb565_channel_neon(luma_lo, luma_hi,
+                                                                            vzipq_s32(g_chroma, g_chroma), 6), 5)),
+                                  rgb565_channel_neon(luma_lo, luma_hi, vzipq_s32(b_chroma, b_chroma), 5));
+
+    if (swap_bytes) return vrev16q_u8(vreinterpretq_u8_u16(pixels));
+
+    return vreinterpretq_u8_u16(pixels);
+}
+
+
+static uint32_t yuv420p_to_rgb565_neon (const ColorMatrix_t * matrix,
+                                        const uint8_t * y_row0,
+                                        const uint8_t * y_row1,
+                                        const uint8_t * u_row,
+                                        const uint8_t * v_row,
+                                        uint8_t * rgb565_row0,
+                                        uint8_t * rgb565_row1,
+                                        uint32_t count,
+                                        uint8_t swap_bytes)
+{
+    uint32_t i = 0;
+    uint8_t k = 0;
+    const uint8_t * y_rows[2] = { y_row0, y_row1 };
+    uint8_t * rgb565_rows[2] = { rgb565_row0, rgb565_row1 };
+    const int16_t (* coef)[3] = matrix->coef;
+    int32x4_t bias_r = vdupq_n_s32(128 + matrix->out_offset[0] * 256);
+    int32x4_t bias_g = vdupq_n_s32(128 + matrix->out_offset[1] * 256);
+    int32x4_t bias_b = vdupq_n_s32(128 + matrix->out_offset[2] * 256);
+    int16x8_t offset_y = vdupq_n_s16(matrix->in_offset[0]);
+    int16x8_t offset_u = vdupq_n_s16(matrix->in_offset[1]);
+    int16x8_t offset_v = vdupq_n_s16(matrix->in_offset[2]);
+    int16x8_t u, v;
+    uint8x16_t x;
+    int32x4_t r_lo, g_lo, b_lo, r_hi, g_hi, b_hi;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        // 8 (U, V) pairs, whose contributions are shared by the 16 pixels of both rows
+        u = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(u_row + i / 2))), offset_u);
+        v = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(v_row + i / 2))), offset_v);
+
+        r_lo = vmlal_n_s16(vmlal_n_s16(bias_r, vget_low_s16(u), coef[0][1]), vget_low_s16(v), coef[0][2]);
+        g_lo = vmlal_n_s16(vmlal_n_s16(bias_g, vget_low_s16(u), coef[1][1]), vget_low_s16(v), coef[1][2]);
+        b_lo = vmlal_n_s16(vmlal_n_s16(bias_b, vget_low_s16(u), coef[2][1]), vget_low_s16(v), coef[2][2]);
+        r_hi = vmlal_n_s16(vmlal_n_s16(bias_r, vget_high_s16(u), coef[0][1]), vget_high_s16(v), coef[0][2]);
+        g_hi = vmlal_n_s16(vmlal_n_s16(bias_g, vget_high_s16(u), coef[1][1]), vget_high_s16(v), coef[1][2]);
+        b_hi = vmlal_n_s16(vmlal_n_s16(bias_b, vget_high_s16(u), coef[2][1]), vget_high_s16(v), coef[2][2]);
+
+        for (k = 0; k < 2; k++) {
+            if (!y_rows[k]) continue;
+
+            x = vld1q_u8(y_rows[k] + i);
+            vst1q_u8(rgb565_rows[k] + i * 2,
+                     rgb565_pixels_neon(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(x))), offset_y),
+                                        coef[0][0], r_lo, g_lo, b_lo, swap_bytes));
+            vst1q_u8(rgb565_rows[k] + i * 2 + 16,
+                     rgb565_pixels_neon(vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(x))), offset_y),
+                                        coef[0][0], r_hi, g_hi, b_hi, swap_bytes));
+        }
+    }
+
+    return i;
+}
+
+static void transpose_8bpp_neon (const uint8_t * src, int32_t src_stride, uint8_t * dst, int32_t dst_stride)
+{
+    uint8x8x2_t t0, t1, t2, t3;
+    uint16x4x2_t u0, u1, u2, u3;
+    uint32x2x2_t v0, v1, v2, v3;
+
+    // Transpose 2x2 blocks of pixels, then of pairs of pixels, then of quadruples of pixels
+    t0 = vtrn_u8(vld1_u8(src), vld1_u8(src + src_stride));
+    t1 = vtrn_u8(vld1_u8(src + 2 * src_stride), vld1_u8(src + 3 * src_stride));
+    t2 = vtrn_u8(vld1_u8(src + 4 * src_stride), vld1_u8(src + 5 * src_stride));
+    t3 = vtrn_u8(vld1_u8(src + 6 * src_stride), vld1_u8(src + 7 * src_stride));
+
+    u0 = vtrn_u16(vreinterpret_u16_u8(t0.val[0]), vreinterpret_u16_u8(t1.val[0]));
+    u1 = vtrn_u16(vreinterpret_u16_u8(t0.val[1]), vreinterpret_u16_u8(t1.val[1]));
+    u2 = vtrn_u16(vreinterpret_u16_u8(t2.val[0]), vreinterpret_u16_u8(t3.val[0]));
+    u3 = vtrn_u16(vreinterpret_u16_u8(t2.val[1]), vreinterpret_u16_u8(t3.val[1]));
+
+    v0 = vtrn_u32(vreinterpret_u32_u16(u0.val[0]), vreinterpret_u32_u16(u2.val[0]));
+    v1 = vtrn_u32(vreinterpret_u32_u16(u1.val[0]), vreinterpret_u32_u16(u3.val[0]));
+    v2 = vtrn_u32(vreinterpret_u32_u16(u0.val[1]), vreinterpret_u32_u16(u2.val[1]));
+    v3 = vtrn_u32(vreinterpret_u32_u16(u1.val[1]), vreinterpret_u32_u16(u3.val[1]));
+
+    vst1_u8(dst, vreinterpret_u8_u32(v0.val[0]));
+    vst1_u8(dst + dst_stride, vreinterpret_u8_u32(v1.val[0]));
+    vst1_u8(dst + 2 * dst_stride, vreinterpret_u8_u32(v2.val[0]));
+    vst1_u8(dst + 3 * dst_stride, vreinterpret_u8_u32(v3.val[0]));
+    vst1_u8(dst + 4 * dst_stride, vreinterpret_u8_u32(v0.val[1]));
+    vst1_u8(dst + 5 * dst_stride, vreinterpret_u8_u32(v1.val[1]));
+    vst1_u8(dst + 6 * dst_stride, vreinterpret_u8_u32(v2.val[1]));
+    vst1_u8(dst + 7 * dst_stride, vreinterpret_u8_u32(v3.val[1]));
+}
+
+static uint32_t filter_rows_neon (const uint16_t * const * rows,
+                                  const int16_t * weights,
+                                  uint16_t taps,
+                                  uint8_t * out,
+                                  uint32_t count)
+{
+    uint32_t i = 0;
+    uint16_t t = 0;
+    uint32x4_t bias = vdupq_n_u32(1 << (SIMD_FILTER_BITS + SIMD_FILTER_EXTRA_BITS - 1));
+    uint32x4_t acc_lo, acc_hi;
+    uint16x8_t x;
+
+    for (i = 0; i + 8 <= count; i += 8) {
+        acc_lo = bias;
+        acc_hi = bias;
+
+        for (t = 0; t < taps; t++) {
+            x = vld1q_u16(rows[t] + i);
+            acc_lo = vmlal_n_u16(acc_lo, vget_low_u16(x), weights[t]);
+            acc_hi = vmlal_n_u16(acc_hi, vget_high_u16(x), weights[t]);
+        }
+
+        x = vcombine_u16(vmovn_u32(vshrq_n_u32(acc_lo, SIMD_FILTER_BITS + SIMD_FILTER_EXTRA_BITS)),
+                         vmovn_u32(vshrq_n_u32(acc_hi, SIMD_FILTER_BITS + SIMD_FILTER_EXTRA_BITS)));
+        vst1_u8(out + i, vqmovn_u16(x));
+    }
+
+    return i;
+}
+
+static void idct_8x8_neon (const int16_t * coefs, uint8_t * out, int32_t out_stride)
+{
+    uint8_t k = 0;
+    uint8_t y = 0;
+    int16_t temp[8 * 8];
+    int16x8_t rows[8], matrix[8];
+    int32x4_t acc_lo, acc_hi;
+
+    for (k = 0; k < 8; k++) {
+        rows[k] = vld1q_s16(coefs + 8 * k);
+        matrix[k] = vld1q_s16(idct_matrix_8 + 8 * k);
+    }
+
+    for (y = 0; y < 8; y++) {
+        acc_lo = vdupq_n_s32(IDCT_PASS1_BIAS);
+        acc_hi = vdupq_n_s32(IDCT_PASS1_BIAS);
+
+        for (k = 0; k < 8; k++) {
+            acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(rows[k]), idct_matrix_8[8 * k + y]);
+            acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(rows[k]), idct_matrix_8[8 * k + y]);
+        }
+
+        vst1q_s16(temp + 8 * y, vcombine_s16(vqshrn_n_s32(acc_lo, IDCT_PASS1_SHIFT),
+                                             vqshrn_n_s32(acc_hi, IDCT_PASS1_SHIFT)));
+    }
+
+    for (y = 0; y < 8; y++) {
+        acc_lo = vdupq_n_s32(IDCT_PASS2_BIAS);
+        acc_hi = vdupq_n_s32(IDCT_PASS2_BIAS);
+
+        for (k = 0; k < 8; k++) {
+            acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(matrix[k]), temp[8 * y + k]);
+            acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(matrix[k]), temp[8 * y + k]);
+        }
+
+        vst1_u8(out + (int32_t) y * out_stride,
+                vqmovun_s16(vcombine_s16(vqshrn_n_s32(acc_lo, IDCT_PASS2_SHIFT),
+                                         vqshrn_n_s32(acc_hi, IDCT_PASS2_SHIFT))));
+    }
+}
+
+static uint32_t deinterleave_24bpp_neon (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint8_t * c2, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8x16x3_t pixels;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        pixels = vld3q_u8(src + i * 3);
+        vst1q_u8(c0 + i, pixels.val[0]);
+        vst1q_u8(c1 + i, pixels.val[1]);
+        vst1q_u8(c2 + i, pixels.val[2]);
+    }
+
+    return i;
+}
+
+
+static uint32_t interleave_24bpp_neon (const uint8_t * c0,
+                                       const uint8_t * c1,
+                                       const uint8_t * c2,
+                                       uint8_t * dst,
+                                       uint32_t count)
+{
+    uint32_t i = 0;
+    uint8x16x3_t pixels;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        pixels.val[0] = vld1q_u8(c0 + i);
+        pixels.val[1] = vld1q_u8(c1 + i);
+        pixels.val[2] = vld1q_u8(c2 + i);
+        vst3q_u8(dst + i * 3, pixels);
+    }
+
+    return i;
+}
+
+
+static uint32_t deinterleave_16bpp_neon (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8x16x2_t pairs;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        pairs = vld2q_u8(src + i * 2);
+        vst1q_u8(c0 + i, pairs.val[0]);
+        vst1q_u8(c1 + i, pairs.val[1]);
+    }
+
+    return i;
+}
+
+
+static uint32_t interleave_16bpp_neon (const uint8_t * c0, const uint8_t * c1, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8x16x2_t pairs;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        pairs.val[0] = vld1q_u8(c0 + i);
+        pairs.val[1] = vld1q_u8(c1 + i);
+        vst2q_u8(dst + i * 2, pairs);
+    }
+
+    return i;
+}
+
+
+static uint32_t deinterleave_32bpp_neon (const uint8_t * src,
+                                         uint8_t * c0,
+                                         uint8_t * c1,
+                                         uint8_t * c2,
+                                         uint8_t * c3,
+                                         uint32_t count)
+{
+    uint32_t i = 0;
+    uint8x16x4_t pixels;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        pixels = vld4q_u8(src + i * 4);
+        vst1q_u8(c0 + i, pixels.val[0]);
+        vst1q_u8(c1 + i, pixels.val[1]);
+        vst1q_u8(c2 + i, pixels.val[2]);
+        vst1q_u8(c3 + i, pixels.val[3]);
+    }
+
+    return i;
+}
+
+
+static uint32_t interleave_32bpp_neon (const uint8_t * c0,
+                                       const uint8_t * c1,
+                                       const uint8_t * c2,
+                                       const uint8_t * c3,
+                                       uint8_t * dst,
+                                       uint32_t count)
+{
+    uint32_t i = 0;
+    uint8x16x4_t pixels;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        pixels.val[0] = vld1q_u8(c0 + i);
+        pixels.val[1] = vld1q_u8(c1 + i);
+        pixels.val[2] = vld1q_u8(c2 + i);
+        pixels.val[3] = vld1q_u8(c3 + i);
+        vst4q_u8(dst + i * 4, pixels);
+    }
+
+    return i;
+}
+
+
+// Divide the products of two 8-bit values by 255, rounded to the nearest (as `div255()`), and narrow them
+static inline uint8x8_t div255_neon (uint16x8_t x)
+{
+    return vraddhn_u16(x, vrshrq_n_u16(x, 8));
+}
+
+
+static uint32_t premultiply_8bpp_neon (const uint8_t * in, const uint8_t * alpha, uint8_t * out, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8x16_t c, a;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        c = vld1q_u8(in + i);
+        a = vld1q_u8(alpha + i);
+        vst1q_u8(out + i, vcombine_u8(div255_neon(vmull_u8(vget_low_u8(c), vget_low_u8(a))),
+                                      div255_neon(vmull_u8(vget_high_u8(c), vget_high_u8(a)))));
+    }
+
+    return i;
+}
+
+
+static uint32_t blend_8bpp_neon (const uint8_t * src, const uint8_t * alpha, uint8_t * dst, uint32_t count)
+{
+    uint32_t i = 0;
+    uint8x16_t d, inv;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        d = vld1q_u8(dst + i);
+        // 255 - alpha
+        inv = vmvnq_u8(vld1q_u8(alpha + i));
+        vst1q_u8(dst + i, vqaddq_u8(vld1q_u8(src + i),
+                                    vcombine_u8(div255_neon(vmull_u8(vget_low_u8(d), vget_low_u8(inv))),
+                                                div255_neon(vmull_u8(vget_high_u8(d), vget_high_u8(inv))))));
+    }
+
+    return i;
+}
+
+
+// Downsample 16 pixels of one or two rows to 8 chroma values (see `downsample_chroma_scalar()`); narrowing 16-bit
+// lanes keeps their first (even) byte
+static inline uint8x8_t downsample_chroma_vector_neon (uint8x16_t a,
+                                                       uint8x16_t b,
+                                                       uint8_t has_row1,
+                                                       ChromaSiting_t siting)
+{
+    if (siting == CHROMA_SITING_TOP_LEFT || (siting == CHROMA_SITING_LEFT && !has_row1)) {
+        return vmovn_u16(vreinterpretq_u16_u8(a));
+    }
+    if (siting == CHROMA_SITING_LEFT) return vmovn_u16(vreinterpretq_u16_u8(vrhaddq_u8(a, b)));
+    if (!has_row1) return vrshrn_n_u16(vpaddlq_u8(a), 1);
+
+    return vrshrn_n_u16(vpadalq_u8(vpaddlq_u8(a), b), 2);
+}
+
+
+static uint32_t downsample_chroma_neon (const uint8_t * row0,
+                                        const uint8_t * row1,
+                                        uint8_t * out,
+                                        uint32_t count,
+                                        ChromaSiting_t siting)
+{
+    uint32_t i = 0;
+    uint8x16_t a, b;
+
+    for (i = 0; i + 16 <= count; i += 16) {
+        a = vld1q_u8(row0 + i);
+        b = row1 ? vld1q_u8(row1 + i) : a;
+        vst1_u8(out + i / 2, downsample_chroma_vector_neon(a, b, row1 != NULL, siting));
+    }
+
+    return i;
+}
+
+#endif
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * KERNEL SELECTION
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+// Instruction set levels, as accepted by the LIBUIMG_SIMD environment variable (each includes the levels below it)
+static const struct {
+    const char * name;
+    uint8_t features;
+} simd_levels[] = {
+    { "none", SIMD_NONE },
+    { "sse2", SIMD_SSE2 },
+    { "ssse3", SIMD_SSE2 | SIMD_SSSE3 },
+    { "avx2", SIMD_SSE2 | SIMD_SSSE3 | SIMD_AVX2 },
+    { "avx512", SIMD_SSE2 | SIMD_SSSE3 | SIMD_AVX2 | SIMD_AVX512 },
+    { "neon", SIMD_NEON }
+};
+
+
+static void detect_simd_features (void)
+{
+#ifdef LIBUIMG_HAS_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse2")) detected_features |= SIMD_SSE2;
+    if (__builtin_cpu_supports("ssse3")) detected_features |= SIMD_SSSE3;
+    if (__builtin_cpu_supports("avx2")) detected_features |= SIMD_AVX2;
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) detected_features |= SIMD_AVX512;
+#endif
+
+#ifdef LIBUIMG_HAS_NEON
+    // NEON support is decided at compile time (always present on AArch64, enabled by -mfpu=neon on 32-bit ARM)
+    detected_features |= SIMD_NEON;
+#endif
+}
+
+
+static void select_kernels (uint8_t features, SimdKernels_t * kernels)
+{
+    // Unset kernels are NULL, which makes the entry points use their scalar code
+    memset(kernels, 0, sizeof(SimdKernels_t));
+    kernels->features = features;
+
+#ifdef LIBUIMG_HAS_X86_SIMD
+    if (features & SIMD_AVX512) kernels->color_matrix = color_matrix_avx512;
+    else if (features & SIMD_AVX2) kernels->color_matrix = color_matrix_avx2;
+    else if (features & SIMD_SSE2) kernels->color_matrix = color_matrix_sse2;
+    // The YUV420p -> RGB565 kernel is bound by its stores, so AVX2 CPUs use the SSE2 kernel as well
+    if (features & SIMD_SSE2) {
+        kernels->yuv420p_to_rgb565 = yuv420p_to_rgb565_sse2;
+        kernels->transpose_8bpp = transpose_8bpp_sse2;
+        kernels->filter_rows = filter_rows_sse2;
+        kernels->idct_8x8 = idct_8x8_sse2;
+        kernels->deinterleave_16bpp = deinterleave_16bpp_sse2;
+        kernels->interleave_16bpp = interleave_16bpp_sse2;
+        kernels->deinterleave_32bpp = deinterleave_32bpp_sse2;
+        kernels->interleave_32bpp = interleave_32bpp_sse2;
+        kernels->premultiply_8bpp = premultiply_8bpp_sse2;
+        kernels->blend_8bpp = blend_8bpp_sse2;
+        kernels->downsample_chroma = downsample_chroma_sse2;
+    }
+    if (features & SIMD_AVX2) {
+        kernels->deinterleave_16bpp = deinterleave_16bpp_avx2;
+        kernels->interleave_16bpp = interleave_16bpp_avx2;
+        kernels->deinterleave_32bpp = deinterleave_32bpp_avx2;
+        kernels->interleave_32bpp = interleave_32bpp_avx2;
+        kernels->premultiply_8bpp = premultiply_8bpp_avx2;
+        kernels->blend_8bpp = blend_8bpp_avx2;
+    }
+    if (features & SIMD_SSSE3) {
+        kernels->deinterleave_24bpp = deinterleave_24bpp_ssse3;
+        kernels->interleave_24bpp = interleave_24bpp_ssse3;
+    }
+#endif
+
+#ifdef LIBUIMG_HAS_NEON
+    if (features & SIMD_NEON) {
+        kernels->color_matrix = color_matrix_neon;
+        kernels->yuv420p_to_rgb565 = yuv420p_to_rgb565_neon;
+        kernels->transpose_8bpp = transpose_8bpp_neon;
+        kernels->filter_rows = filter_rows_neon;
+        kernels->idct_8x8 = idct_8x8_neon;
+        kernels->deinterleave_24bpp = deinterleave_24bpp_neon;
+        kernels->interleave_24bpp = interleave_24bpp_neon;
+        kernels->deinterleave_16bpp = deinterleave_16bpp_neon;
+        kernels->interleave_16bpp = interleave_16bpp_neon;
+        kernels->deinterleave_32bpp = deinterleave_32bpp_neon;
+        kernels->interleave_32bpp = interleave_32bpp_neon;
+        kernels->premultiply_8bpp = premultiply_8bpp_neon;
+        kernels->blend_8bpp = blend_8bpp_neon;
+        kernels->downsample_chroma = downsample_chroma_neon;
+    }
+#endif
+}
+
+
+// Fills every table and kernel set, then publishes the kernels of the enabled instruction sets
+static void init_simd (void)
+{
+    uint8_t k = 0;
+    uint8_t features = 0;
+    const char * level = NULL;
+
+    detect_simd_features();
+    init_rgb565_tables();
+
+    for (k = 0; k < SIMD_FEATURE_SETS; k++) {
+        select_kernels(k, &kernel_sets[k]);
+    }
+
+    // Unknown levels are ignored
+    features = detected_features;
+    level = getenv("LIBUIMG_SIMD");
+    for (k = 0; level && k < sizeof(simd_levels) / sizeof(simd_levels[0]); k++) {
+        if (!strcmp(level, simd_levels[k].name)) features &= simd_levels[k].features;
+    }
+
+    STORE_ACTIVE_KERNELS(&kernel_sets[features]);
+}
+
+
+static const SimdKernels_t * get_simd_kernels (void)
+{
+    const SimdKernels_t * kernels = LOAD_ACTIVE_KERNELS();
+
+    if (kernels) return kernels;
+
+#ifdef LIBUIMG_THREADS
+    pthread_once(&simd_once, init_simd);
+#else
+    init_simd();
+#endif
+
+    return LOAD_ACTIVE_KERNELS();
+}
+
+
+uint8_t get_simd_features (void)
+{
+    return get_simd_kernels()->features;
+}
+
+
+uint8_t set_simd_features (uint8_t features)
+{
+    get_simd_kernels();
+
+    // Kernel sets are never modified, so threads still using the previous one are not disturbed
+    STORE_ACTIVE_KERNELS(&kernel_sets[detected_features & features]);
+
+    return detected_features & features;
+}
+
+
+void select_simd_kernels (void)
+{
+    get_simd_kernels();
+}
+
+
+void init_color_terms (const ColorMatrix_t * matrix, int32_t terms[3][3][256])
+{
+    uint8_t k = 0;
+    uint8_t c = 0;
+    int32_t v = 0;
+
+    for (k = 0; k < 3; k++) {
+        for (c = 0; c < 3; c++) {
+            for (v = 0; v < 256; v++) {
+                terms[k][c][v] = matrix->coef[k][c] * (v - matrix->in_offset[c]);
+            }
+        }
+
+        // (x >> 8) + offset is (x + offset * 256) >> 8, so the output offset can join the rounding term
+        for (v = 0; v < 256; v++) {
+            terms[k][0][v] += 128 + matrix->out_offset[k] * 256;
+        }
+    }
+}
+
+
+void convert_color_block (const ColorMatrix_t * matrix,
+                          const uint8_t * in0,
+                          const uint8_t * in1,
+                          const uint8_t * in2,
+                          uint8_t * out0,
+                          uint8_t * out1,
+                          uint8_t * out2,
+                          uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->color_matrix) done = kernels->color_matrix(matrix, in0, in1, in2, out0, out1, out2, count);
+
+    color_matrix_scalar(matrix,
+                        in0 + done,
+                        in1 + done,
+                        in2 + done,
+                        out0 + done,
+                        out1 ? out1 + done : NULL,
+                        out2 ? out2 + done : NULL,
+                        count - done);
+}
+
+
+void convert_YUV420p_to_RGB565_block (const ColorMatrix_t * matrix,
+                                      const uint8_t * y_row0,
+                                      const uint8_t * y_row1,
+                                      const uint8_t * u_row,
+                                      const uint8_t * v_row,
+                                      uint8_t * rgb565_row0,
+                                      uint8_t * rgb565_row1,
+                                      uint32_t count,
+                                      uint8_t swap_bytes)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->yuv420p_to_rgb565) {
+        done = kernels->yuv420p_to_rgb565(matrix, y_row0, y_row1, u_row, v_row, rgb565_row0, rgb565_row1, count,
+                                          swap_bytes);
+    }
+
+    yuv420p_to_rgb565_scalar(matrix,
+                             y_row0 + done,
+                             y_row1 ? y_row1 + done : NULL,
+                             u_row + done / 2,
+                             v_row + done / 2,
+                             rgb565_row0 + done * 2,
+                             rgb565_row1 ? rgb565_row1 + done * 2 : NULL,
+                             count - done,
+                             swap_bytes);
+}
+
+
+void deinterleave_24bpp_block (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint8_t * c2, uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->deinterleave_24bpp) done = kernels->deinterleave_24bpp(src, c0, c1, c2, count);
+
+    deinterleave_24bpp_scalar(src + done * 3, c0 + done, c1 + done, c2 + done, count - done);
+}
+
+
+void interleave_24bpp_block (const uint8_t * c0, const uint8_t * c1, const uint8_t * c2, uint8_t * dst, uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->interleave_24bpp) done = kernels->interleave_24bpp(c0, c1, c2, dst, count);
+
+    interleave_24bpp_scalar(c0 + done, c1 + done, c2 + done, dst + done * 3, count - done);
+}
+
+
+void deinterleave_16bpp_block (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->deinterleave_16bpp) done = kernels->deinterleave_16bpp(src, c0, c1, count);
+
+    deinterleave_16bpp_scalar(src + done * 2, c0 + done, c1 + done, count - done);
+}
+
+
+void interleave_16bpp_block (const uint8_t * c0, const uint8_t * c1, uint8_t * dst, uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->interleave_16bpp) done = kernels->interleave_16bpp(c0, c1, dst, count);
+
+    interleave_16bpp_scalar(c0 + done, c1 + done, dst + done * 2, count - done);
+}
+
+
+void deinterleave_32bpp_block (const uint8_t * src,
+                               uint8_t * c0,
+                               uint8_t * c1,
+                               uint8_t * c2,
+                               uint8_t * c3,
+                               uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->deinterleave_32bpp) done = kernels->deinterleave_32bpp(src, c0, c1, c2, c3, count);
+
+    deinterleave_32bpp_scalar(src + done * 4, c0 + done, c1 + done, c2 + done, c3 + done, count - done);
+}
+
+
+void interleave_32bpp_block (const uint8_t * c0,
+                             const uint8_t * c1,
+                             const uint8_t * c2,
+                             const uint8_t * c3,
+                             uint8_t * dst,
+                             uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->interleave_32bpp) done = kernels->interleave_32bpp(c0, c1, c2, c3, dst, count);
+
+    interleave_32bpp_scalar(c0 + done, c1 + done, c2 + done, c3 + done, dst + done * 4, count - done);
+}
+
+
+void premultiply_8bpp_block (const uint8_t * in, const uint8_t * alpha, uint8_t * out, uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->premultiply_8bpp) done = kernels->premultiply_8bpp(in, alpha, out, count);
+
+    premultiply_8bpp_scalar(in + done, alpha + done, out + done, count - done);
+}
+
+
+void blend_8bpp_block (const uint8_t * src, const uint8_t * alpha, uint8_t * dst, uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->blend_8bpp) done = kernels->blend_8bpp(src, alpha, dst, count);
+
+    blend_8bpp_scalar(src + done, alpha + done, dst + done, count - done);
+}
+
+
+void downsample_chroma_block (const uint8_t * row0,
+                              const uint8_t * row1,
+                              uint8_t * out,
+                              uint32_t count,
+                              ChromaSiting_t siting)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->downsample_chroma) done = kernels->downsample_chroma(row0, row1, out, count, siting);
+
+    downsample_chroma_scalar(row0 + done, row1 ? row1 + done : NULL, out + done / 2, count - done, siting);
+}
+
+
+void transpose_8bpp_block (const uint8_t * src,
+                           int32_t src_stride,
+                           uint8_t * dst,
+                           int32_t dst_stride,
+                           uint32_t width,
+                           uint32_t height)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t done_rows = 0;
+    uint32_t done_columns = 0;
+
+    // Transpose full square sub-blocks with the SIMD kernel (if any)
+    if (kernels->transpose_8bpp) {
+        done_rows = height - height % SIMD_TRANSPOSE_SIZE;
+        done_columns = width - width % SIMD_TRANSPOSE_SIZE;
+
+        for (i = 0; i < done_rows; i += SIMD_TRANSPOSE_SIZE) {
+            for (j = 0; j < done_columns; j += SIMD_TRANSPOSE_SIZE) {
+                kernels->transpose_8bpp(src + (int32_t) i * src_stride + j,
+                                        src_stride,
+                                        dst + (int32_t) j * dst_stride + i,
+                                        dst_stride);
+            }
+        }
+    }
+
+    // Transpose the rest with the scalar kernel: the right edge of the rows done so far, then the remaining rows
+    transpose_8bpp_scalar(src + done_columns,
+                          src_stride,
+                          dst + (int32_t) done_columns * dst_stride,
+                          dst_stride,
+                          width - done_columns,
+                          done_rows);
+    transpose_8bpp_scalar(src + (int32_t) done_rows * src_stride,
+                          src_stride,
+                          dst + done_rows,
+                          dst_stride,
+                          width,
+                          height - done_rows);
+}
+
+
+void filter_rows_block (const uint16_t * const * rows,
+                        const int16_t * weights,
+                        uint16_t taps,
+                        uint8_t * out,
+                        uint32_t count)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    uint32_t done = 0;
+
+    // Process full vectors with the SIMD kernel (if any), and the rest with the scalar kernel
+    if (kernels->filter_rows) done = kernels->filter_rows(rows, weights, taps, out, count);
+
+    filter_rows_scalar(rows, weights, taps, out, done, count - done);
+}
+
+
+void idct_block (const int16_t * coefs, uint8_t size_x, uint8_t size_y, uint8_t * out, int32_t out_stride)
+{
+    const SimdKernels_t * kernels = get_simd_kernels();
+    if (size_x == 8 && size_y == 8 && kernels->idct_8x8) {
+        kernels->idct_8x8(coefs, out, out_stride);
+        return;
+    }
+
+    // Constant sizes let the compiler unroll the scalar kernel for the common (square) cases
+    switch (size_x == size_y ? size_x : 0) {
+        case 8: idct_block_scalar(coefs, 8, 8, out, out_stride); break;
+        case 4: idct_block_scalar(coefs, 4, 4, out, out_stride); break;
+        case 2: idct_block_scalar(coefs, 2, 2, out, out_stride); break;
+        default: idct_block_scalar(coefs, size_x, size_y, out, out_stride); break;
+    }
+}
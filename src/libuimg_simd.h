@@ -0,0 +1,351 @@
+#ifndef __LIB_UIMG_SIMD_H__
+#define __LIB_UIMG_SIMD_H__
+
+
+#include "libuimg_img.h"
+
+
+#define SIMD_NONE 0x00 /**< No SIMD instruction set available; only the scalar kernels will be used. */
+#define SIMD_SSE2 0x01 /**< x86 SSE2 instruction set. */
+#define SIMD_AVX2 0x02 /**< x86 AVX2 instruction set. */
+#define SIMD_NEON 0x04 /**< ARM NEON (Advanced SIMD) instruction set. */
+#define SIMD_SSSE3 0x08 /**< x86 SSSE3 instruction set. */
+#define SIMD_AVX512 0x10 /**< x86 AVX-512 instruction set (Foundation and Byte/Word instructions). */
+
+#define SIMD_BLOCK_SIZE 64 /**< Maximum number of pixels in a block passed to `convert_color_block()`. */
+#define SIMD_TRANSPOSE_SIZE 8 /**< Size (in pixels) of the square blocks transposed by the SIMD kernels. */
+
+
+/**
+ * @brief A fixed-point 3x3 color transformation matrix.
+ *
+ * Every output channel is computed as:
+ *
+ *     out[k] = clamp(((coef[k][0] * (in[0] - in_offset[0]) +
+ *                      coef[k][1] * (in[1] - in_offset[1]) +
+ *                      coef[k][2] * (in[2] - in_offset[2]) + 128) >> 8) + out_offset[k], 0, 255)
+ *
+ * which covers both the YUV->RGB and the RGB->YUV transformations of libuimg.
+ */
+typedef struct {
+    /** Offsets subtracted from the input channels. */
+    int16_t in_offset[3];
+    /** Coefficients (8-bit fixed point), indexed by output channel then input channel. */
+    int16_t coef[3][3];
+    /** Offsets added to the output channels. */
+    int16_t out_offset[3];
+    /** Contributions of every input value to the sums (see `init_color_terms()`), or NULL to compute them. */
+    const int32_t (* terms)[3][256];
+} ColorMatrix_t;
+
+
+/** YUV -> RGB matrix, equivalent to `yuv_to_rgb_r()`, `yuv_to_rgb_g()` and `yuv_to_rgb_b()`. */
+extern const ColorMatrix_t yuv_to_rgb_matrix;
+
+/** RGB -> YUV matrix, equivalent to `rgb_to_yuv_y()`, `rgb_to_yuv_u()` and `rgb_to_yuv_v()`. */
+extern const ColorMatrix_t rgb_to_yuv_matrix;
+
+
+/**
+ * @brief      Get the SIMD instruction sets usable on the current CPU.
+ *
+ * Detection happens at runtime (and only once); instruction sets that libuimg was not compiled with support for are
+ * never reported. The `LIBUIMG_SIMD` environment variable, read along with the detection, caps the instruction sets
+ * used to a level (`none`, `sse2`, `ssse3`, `avx2`, `avx512` or `neon`), so that every kernel can be tested (or ruled
+ * out) on a single machine.
+ *
+ * @return     A combination of the `SIMD_*` flags.
+ */
+uint8_t get_simd_features (void);
+
+/**
+ * @brief      Restrict the SIMD instruction sets used by the kernels, and select the kernels again.
+ *
+ * Instruction sets that the CPU does not support are left out, so `SIMD_NONE` forces the scalar kernels and 0xff
+ * enables everything the CPU supports (whatever `LIBUIMG_SIMD` says). Results are bit-identical whatever the kernels,
+ * so this can be called while other threads are running operations: their blocks use either the previous kernels or
+ * the new ones.
+ *
+ * @param[in]  features  A combination of the `SIMD_*` flags.
+ *
+ * @return     The instruction sets that are now used (see `get_simd_features()`).
+ */
+uint8_t set_simd_features (uint8_t features);
+
+/**
+ * @brief      Select the fastest kernels for the current CPU.
+ *
+ * This happens automatically, and only once, on first use (even if several threads make their first call at the same
+ * time); calling it beforehand only moves the detection out of the first operation.
+ */
+void select_simd_kernels (void);
+
+/**
+ * @brief      Precompute the contributions of every input value to the sums of a color matrix.
+ *
+ * `terms[k][c][v]` is `coef[k][c] * (v - in_offset[c])`; the rounding bias and the output offset of channel k are
+ * folded into `terms[k][0]`, so that every output value is the sum of three table entries, shifted and clamped. The
+ * scalar kernels use the tables of a matrix when its `terms` field points to them, which saves the multiplications
+ * on cores without SIMD units; the results are identical either way.
+ *
+ * @param[in]  matrix  The color matrix (its `terms` field is ignored).
+ * @param      terms   The contribution tables to fill.
+ */
+void init_color_terms (const ColorMatrix_t * matrix, int32_t terms[3][3][256]);
+
+/**
+ * @brief      Apply a color matrix to a block of planar pixels.
+ *
+ * The bulk of the block is processed by the fastest SIMD kernel available on the current CPU, and the remaining
+ * pixels by the scalar kernel; the result is bit-identical either way.
+ *
+ * @param[in]  matrix  The color matrix to apply.
+ * @param[in]  in0     The first input channel (Y or R).
+ * @param[in]  in1     The second input channel (U or G).
+ * @param[in]  in2     The third input channel (V or B).
+ * @param      out0    The first output channel (R or Y).
+ * @param      out1    The second output channel (G or U), or NULL if it is not needed.
+ * @param      out2    The third output channel (B or V), or NULL if it is not needed.
+ * @param[in]  count   The number of pixels in the block.
+ */
+void convert_color_block (const ColorMatrix_t * matrix,
+                          const uint8_t * in0,
+                          const uint8_t * in1,
+                          const uint8_t * in2,
+                          uint8_t * out0,
+                          uint8_t * out1,
+                          uint8_t * out2,
+                          uint32_t count);
+
+/**
+ * @brief      Convert a block of YUV420p pixels directly to RGB565.
+ *
+ * The block covers one or two rows of pixels sharing the same chroma row, and must start on an even column. The
+ * chroma contributions are computed once per 2x2 block of pixels, and every pixel is clamped, quantized and packed
+ * into a 16-bit word in a single step; the result is bit-identical to converting to RGB24 (with the same matrix) and
+ * then to RGB565.
+ *
+ * The luma coefficient (`coef[k][0]`) and the output offset must be the same for the three output channels, as in
+ * every YUV -> RGB matrix of libuimg.
+ *
+ * @param[in]  matrix       The YUV -> RGB color matrix.
+ * @param[in]  y_row0       The Y values of the first row.
+ * @param[in]  y_row1       The Y values of the second row, or NULL if there is only one row.
+ * @param[in]  u_row        The U values shared by both rows.
+ * @param[in]  v_row        The V values shared by both rows.
+ * @param      rgb565_row0  The RGB565 pixels of the first row.
+ * @param      rgb565_row1  The RGB565 pixels of the second row, or NULL if there is only one row.
+ * @param[in]  count        The number of pixels in each row of the block.
+ * @param[in]  swap_bytes   0 to store the pixels in little-endian byte order (as libuimg does), 1 to store them in
+ *                          big-endian byte order (as expected by most SPI displays).
+ */
+void convert_YUV420p_to_RGB565_block (const ColorMatrix_t * matrix,
+                                      const uint8_t * y_row0,
+                                      const uint8_t * y_row1,
+                                      const uint8_t * u_row,
+                                      const uint8_t * v_row,
+                                      uint8_t * rgb565_row0,
+                                      uint8_t * rgb565_row1,
+                                      uint32_t count,
+                                      uint8_t swap_bytes);
+
+/**
+ * @brief      Split a block of 24-bit pixels (such as RGB24 or YUV444 pixels) into their three channels.
+ *
+ * @param[in]  src    The pixels.
+ * @param      c0     The first channel of every pixel.
+ * @param      c1     The second channel of every pixel.
+ * @param      c2     The third channel of every pixel.
+ * @param[in]  count  The number of pixels in the block.
+ */
+void deinterleave_24bpp_block (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint8_t * c2, uint32_t count);
+
+/**
+ * @brief      Merge three channels into a block of 24-bit pixels (the reverse of `deinterleave_24bpp_block()`).
+ *
+ * @param[in]  c0     The first channel of every pixel.
+ * @param[in]  c1     The second channel of every pixel.
+ * @param[in]  c2     The third channel of every pixel.
+ * @param      dst    The pixels.
+ * @param[in]  count  The number of pixels in the block.
+ */
+void interleave_24bpp_block (const uint8_t * c0, const uint8_t * c1, const uint8_t * c2, uint8_t * dst, uint32_t count);
+
+/**
+ * @brief      Split a block of byte pairs (such as NV12 chroma samples or YUYV pixels) into their two channels.
+ *
+ * @param[in]  src    The pairs.
+ * @param      c0     The first byte of every pair.
+ * @param      c1     The second byte of every pair.
+ * @param[in]  count  The number of pairs in the block.
+ */
+void deinterleave_16bpp_block (const uint8_t * src, uint8_t * c0, uint8_t * c1, uint32_t count);
+
+/**
+ * @brief      Merge two channels into a block of byte pairs (the reverse of `deinterleave_16bpp_block()`).
+ *
+ * @param[in]  c0     The first byte of every pair.
+ * @param[in]  c1     The second byte of every pair.
+ * @param      dst    The pairs.
+ * @param[in]  count  The number of pairs in the block.
+ */
+void interleave_16bpp_block (const uint8_t * c0, const uint8_t * c1, uint8_t * dst, uint32_t count);
+
+/**
+ * @brief      Split a block of 32-bit pixels (such as XRGB8888 pixels) into their four channels.
+ *
+ * Channels are numbered in memory order, so c0 is the least significant byte of the little-endian pixels.
+ *
+ * @param[in]  src    The pixels.
+ * @param      c0     The first byte of every pixel.
+ * @param      c1     The second byte of every pixel.
+ * @param      c2     The third byte of every pixel.
+ * @param      c3     The fourth byte of every pixel.
+ * @param[in]  count  The number of pixels in the block.
+ */
+void deinterleave_32bpp_block (const uint8_t * src,
+                               uint8_t * c0,
+                               uint8_t * c1,
+                               uint8_t * c2,
+                               uint8_t * c3,
+                               uint32_t count);
+
+/**
+ * @brief      Merge four channels into a block of 32-bit pixels (the reverse of `deinterleave_32bpp_block()`).
+ *
+ * @param[in]  c0     The first byte of every pixel.
+ * @param[in]  c1     The second byte of every pixel.
+ * @param[in]  c2     The third byte of every pixel.
+ * @param[in]  c3     The fourth byte of every pixel.
+ * @param      dst    The pixels.
+ * @param[in]  count  The number of pixels in the block.
+ */
+void interleave_32bpp_block (const uint8_t * c0,
+                             const uint8_t * c1,
+                             const uint8_t * c2,
+                             const uint8_t * c3,
+                             uint8_t * dst,
+                             uint32_t count);
+
+/**
+ * @brief      Premultiply a block of color values by their alpha values.
+ *
+ * Every output value is computed as `round(in * alpha / 255)`, exactly.
+ *
+ * @param[in]  in     The color values (straight alpha).
+ * @param[in]  alpha  The alpha values.
+ * @param      out    The premultiplied color values (may be `in`).
+ * @param[in]  count  The number of pixels in the block.
+ */
+void premultiply_8bpp_block (const uint8_t * in, const uint8_t * alpha, uint8_t * out, uint32_t count);
+
+/**
+ * @brief      Composite a block of premultiplied color values over another one (the "over" operator).
+ *
+ * Every output value is computed as `min(src + round(dst * (255 - alpha) / 255), 255)`, so a transparent source
+ * leaves the destination untouched and an opaque one replaces it.
+ *
+ * @param[in]  src    The color values to composite (premultiplied by `alpha`, see `premultiply_8bpp_block()`).
+ * @param[in]  alpha  The alpha values of the colors to composite.
+ * @param      dst    The color values to composite onto, overwritten by the result.
+ * @param[in]  count  The number of pixels in the block.
+ */
+void blend_8bpp_block (const uint8_t * src, const uint8_t * alpha, uint8_t * dst, uint32_t count);
+
+/**
+ * @brief      Downsample the chroma values of one or two rows by 2 in both directions.
+ *
+ * Every output value covers a 2x2 block of input values, and is computed according to the siting of the chroma
+ * samples: the average of the 4 values (`CHROMA_SITING_CENTER`), of the 2 left values (`CHROMA_SITING_LEFT`), or the
+ * top-left value alone (`CHROMA_SITING_TOP_LEFT`), rounded to the nearest. The last output value of an odd number of
+ * values only covers the last column, and a single row is downsampled horizontally only.
+ *
+ * @param[in]  row0    The values of the first row.
+ * @param[in]  row1    The values of the second row, or NULL if there is only one row (never read for
+ *                     `CHROMA_SITING_TOP_LEFT`).
+ * @param      out     The downsampled values ((count + 1) / 2 of them).
+ * @param[in]  count   The number of values in each row.
+ * @param[in]  siting  The location of the output samples.
+ */
+void downsample_chroma_block (const uint8_t * row0,
+                              const uint8_t * row1,
+                              uint8_t * out,
+                              uint32_t count,
+                              ChromaSiting_t siting);
+
+#define SIMD_FILTER_BITS 14         /**< Precision (in bits) of the weights passed to `filter_rows_block()`. */
+#define SIMD_FILTER_EXTRA_BITS 7    /**< Extra precision (in bits) of the rows passed to `filter_rows_block()`. */
+
+/**
+ * @brief      Filter rows vertically: compute the weighted sum of several rows, down to 8-bit values.
+ *
+ * Every output value is computed as:
+ *
+ *     out[i] = min((sum(weights[t] * rows[t][i]) + 2^(b - 1)) >> b, 255)
+ *
+ * with b = `SIMD_FILTER_BITS` + `SIMD_FILTER_EXTRA_BITS`. The values of the rows must be lower than 2^15, and the
+ * weights (which should add up to 2^`SIMD_FILTER_BITS`) must be positive.
+ *
+ * @param[in]  rows     The rows to filter (with `SIMD_FILTER_EXTRA_BITS` bits of extra precision).
+ * @param[in]  weights  The weight of each row.
+ * @param[in]  taps     The number of rows.
+ * @param      out      The filtered row.
+ * @param[in]  count    The number of values in each row.
+ */
+void filter_rows_block (const uint16_t * const * rows,
+                        const int16_t * weights,
+                        uint16_t taps,
+                        uint8_t * out,
+                        uint32_t count);
+
+/**
+ * @brief      Transpose a block of 8-bit pixels.
+ *
+ * The pixel at (x, y) of the source block goes to (y, x) of the destination block. Square sub-blocks of
+ * `SIMD_TRANSPOSE_SIZE` pixels are transposed by the fastest SIMD kernel available on the current CPU, and the
+ * remaining pixels by the scalar kernel.
+ *
+ * @param[in]  src         The first row of the source block.
+ * @param[in]  src_stride  The distance (in bytes) between two rows of the source block (may be negative).
+ * @param      dst         The first row of the destination block.
+ * @param[in]  dst_stride  The distance (in bytes) between two rows of the destination block (may be negative).
+ * @param[in]  width       The width of the source block (in pixels).
+ * @param[in]  height      The height of the source block (in pixels).
+ */
+void transpose_8bpp_block (const uint8_t * src,
+                           int32_t src_stride,
+                           uint8_t * dst,
+                           int32_t dst_stride,
+                           uint32_t width,
+                           uint32_t height);
+
+#define SIMD_IDCT_BITS 14        /**< Precision (in bits) of the IDCT matrices used by `idct_block()`. */
+#define SIMD_IDCT_PASS1_BITS 2   /**< Extra precision (in bits) kept between the two passes of `idct_block()`. */
+#define SIMD_IDCT_DC_COEF 5793   /**< The (DC) coefficient of the first row of every IDCT matrix: 2^14 / sqrt(8). */
+
+/**
+ * @brief      Compute the inverse DCT of a block of dequantized JPEG coefficients, down to 8-bit samples.
+ *
+ * The block is transformed by two matrix passes (columns, then rows), in fixed point:
+ *
+ *     t[y][u] = sat16((sum(A[v][y] * coefs[v][u]) + 2^(b1 - 1)) >> b1)
+ *     out[y][x] = clamp((sum(t[y][u] * A[u][x]) + 2^(b2 - 1)) >> b2 + 128, 0, 255)
+ *
+ * with b1 = `SIMD_IDCT_BITS` - `SIMD_IDCT_PASS1_BITS` and b2 = `SIMD_IDCT_BITS` + `SIMD_IDCT_PASS1_BITS`.
+ *
+ * Sizes lower than 8 give a downscaled block: only the lowest frequencies are used, with their weights corrected so
+ * that each output sample is the average of the full-size samples it covers (exactly so for 1/8 blocks, which boil
+ * down to the DC term; up to the dropped frequencies otherwise, which only matter on fine details).
+ * Full 8x8 blocks are transformed by the fastest SIMD kernel available on the current CPU, other sizes by the scalar
+ * kernel.
+ *
+ * @param[in]  coefs       The 64 coefficients of the block, in natural (row-major) order.
+ * @param[in]  size_x      The width of the output block (1, 2, 4 or 8).
+ * @param[in]  size_y      The height of the output block (1, 2, 4 or 8).
+ * @param      out         The first row of the output block.
+ * @param[in]  out_stride  The distance (in bytes) between two rows of the output block (may be negative).
+ */
+void idct_block (const int16_t * coefs, uint8_t size_x, uint8_t size_y, uint8_t * out, int32_t out_stride);
+
+
+#endif
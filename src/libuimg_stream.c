@@ -0,0 +1,84 @@
+#include "libuimg_stream.h"
+#include "libuimg_conversions.h"
+#include "libuimg_flips.h"
+
+
+uint8_t init_conversion_stream (ConversionStream_t * stream,
+                                uint16_t width,
+                                uint16_t height,
+                                PixelFormat_t base_format,
+                                PixelFormat_t converted_format,
+                                uint8_t flip_flags)
+{
+    if (!stream) return 0;
+    // Conversions from ASCII are forbidden, and same-format "conversions" would not write anything to the slices
+    if (base_format >= ASCII || converted_format > ASCII) return 0;
+    if (!conversion_function_LUT[base_format][converted_format]) return 0;
+    // Slices are only ever seen once and in order, so they cannot be flipped along the X axis
+    if (flip_flags & ~FLIP_Y_AXIS) return 0;
+
+    stream->width = width;
+    stream->height = height;
+    stream->base_format = base_format;
+    stream->converted_format = converted_format;
+    stream->flip_flags = flip_flags;
+    stream->convert = conversion_function_LUT[base_format][converted_format];
+    stream->next_row = 0;
+
+    return 1;
+}
+
+
+uint8_t reset_conversion_stream (ConversionStream_t * stream)
+{
+    if (!stream) return 0;
+
+    stream->next_row = 0;
+
+    return 1;
+}
+
+
+uint8_t get_conversion_stream_granularity (const ConversionStream_t * stream)
+{
+    if (!stream) return 0;
+
+    // The chroma rows of YUV420p, NV12 and NV21 cover two rows of pixels
+    return (get_image_plane_height(2, stream->base_format, 1) == 1 ||
+            get_image_plane_height(2, stream->converted_format, 1) == 1) ? 2 : 1;
+}
+
+
+uint8_t convert_stream_slice (ConversionStream_t * stream, Image_t * base_slice, Image_t * converted_slice)
+{
+    uint16_t rows = 0;
+
+    if (!stream) return 0;
+    if (!base_slice) return 0;
+    if (!converted_slice) return 0;
+    // Check the slices against the stream
+    if (base_slice->format != stream->base_format || converted_slice->format != stream->converted_format) return 0;
+    if (base_slice->width != stream->width || converted_slice->width != stream->width) return 0;
+    if (base_slice->height != converted_slice->height) return 0;
+
+    rows = base_slice->height;
+    if (!rows) return 0;
+    if ((uint32_t) stream->next_row + rows > stream->height) return 0;
+    // Only the last slice of a frame may be cut short
+    if (rows % get_conversion_stream_granularity(stream) && stream->next_row + rows != stream->height) return 0;
+
+    if (!stream->convert(base_slice, converted_slice)) return 0;
+    if ((stream->flip_flags & FLIP_Y_AXIS) && !flipY_image(converted_slice)) return 0;
+
+    stream->next_row += rows;
+
+    return 1;
+}
+
+
+uint8_t is_conversion_stream_done (const ConversionStream_t * stream)
+{
+    if (!stream) return 1;
+
+    return stream->next_row >= stream->height;
+}
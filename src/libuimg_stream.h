@@ -0,0 +1,97 @@
+#ifndef __LIB_UIMG_STREAM_H__
+#define __LIB_UIMG_STREAM_H__
+
+
+#include "libuimg_img.h"
+
+
+/**
+ * @brief The state of a streaming conversion.
+ *
+ * A streaming conversion converts a frame a few rows (a slice) at a time, so that neither the base frame nor the
+ * converted frame has to be held in memory as a whole: slices can be converted as soon as they are captured, and sent
+ * out (to a display, for example) as soon as they are converted.
+ */
+typedef struct {
+    /** The width of the frame (in pixels). */
+    uint16_t width;
+    /** The height of the frame (in pixels). */
+    uint16_t height;
+    /** The pixel format of the base frame. */
+    PixelFormat_t base_format;
+    /** The pixel format of the converted frame. */
+    PixelFormat_t converted_format;
+    /** The axes to flip the converted slices along (only `FLIP_Y_AXIS` is supported, since slices come in order). */
+    uint8_t flip_flags;
+    /** The conversion function, from `conversion_function_LUT`. */
+    uint8_t (* convert) (Image_t * base_img, Image_t * converted_img);
+    /** The first row of the next slice. */
+    uint16_t next_row;
+} ConversionStream_t;
+
+
+/**
+ * @brief      Start a streaming conversion.
+ *
+ * @param      stream            The state of the streaming conversion.
+ * @param[in]  width             The width of the frame (in pixels).
+ * @param[in]  height            The height of the frame (in pixels).
+ * @param[in]  base_format       The pixel format of the base frame.
+ * @param[in]  converted_format  The pixel format of the converted frame.
+ * @param[in]  flip_flags        0, or `FLIP_Y_AXIS` to flip the converted slices along the Y axis.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t init_conversion_stream (ConversionStream_t * stream,
+                                uint16_t width,
+                                uint16_t height,
+                                PixelFormat_t base_format,
+                                PixelFormat_t converted_format,
+                                uint8_t flip_flags);
+
+/**
+ * @brief      Restart a streaming conversion from the first row (for the next frame).
+ *
+ * @param      stream  The state of the streaming conversion.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t reset_conversion_stream (ConversionStream_t * stream);
+
+/**
+ * @brief      Get the number of rows that every slice of a streaming conversion must be a multiple of.
+ *
+ * This is 2 if either format is YUV420p, NV12 or NV21 (since chroma rows cover two rows of pixels), 1 otherwise. The
+ * last slice of a frame may be shorter, if the height of the frame is not a multiple of it.
+ *
+ * @param[in]  stream  The state of the streaming conversion.
+ *
+ * @return     The row granularity of the slices, or 0 if the stream is NULL.
+ */
+uint8_t get_conversion_stream_granularity (const ConversionStream_t * stream);
+
+/**
+ * @brief      Convert the next slice of a frame.
+ *
+ * Both slices are images of the width of the frame and of the height of the slice (`get_image_data_size()` gives the
+ * size of their buffers); views (see `create_image_view()`) can be used to convert slices from or to a full frame.
+ *
+ * @param      stream           The state of the streaming conversion.
+ * @param      base_slice       The next rows of the base frame.
+ * @param      converted_slice  The corresponding rows of the converted frame.
+ *
+ * @return     1 if successful, 0 otherwise (in which case the stream does not move forward).
+ */
+uint8_t convert_stream_slice (ConversionStream_t * stream, Image_t * base_slice, Image_t * converted_slice);
+
+/**
+ * @brief      Check whether every row of the current frame of a streaming conversion has been converted.
+ *
+ * @param[in]  stream  The state of the streaming conversion.
+ *
+ * @return     1 if the frame is done (or the stream is NULL), 0 otherwise.
+ */
+uint8_t is_conversion_stream_done (const ConversionStream_t * stream);
+
+
+#endif
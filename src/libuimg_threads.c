@@ -0,0 +1,555 @@
+#include "libuimg_threads.h"
+#include "libuimg_conversions.h"
+#include "libuimg_flips.h"
+
+#ifdef LIBUIMG_THREADS
+#include <pthread.h>
+#endif
+
+
+/**
+ * @brief A parallel operation, shared by all of its bands.
+ */
+typedef struct {
+    /** The (base) image. */
+    Image_t * img;
+    /** The converted image (conversions only). */
+    Image_t * converted_img;
+    /** The axes to flip the converted image along (conversions only; X flips are done through a reversed view). */
+    uint8_t flip_flags;
+    /** The number of bands the operation is split into. */
+    uint16_t band_count;
+    /** The result of each band (1 if successful, 0 otherwise). */
+    uint8_t results[LIBUIMG_MAX_THREADS];
+} BandJob_t;
+
+
+/**
+ * @brief A batch conversion, shared by all of its bands (each of which converts a range of frames).
+ */
+typedef struct {
+    /** The frames to be converted, or NULL if they are stored one after the other in `base_data`. */
+    Image_t * const * base_imgs;
+    /** The converted frames, or NULL if they are stored one after the other in `converted_data`. */
+    Image_t * const * converted_imgs;
+    /** The contiguous frames (when there are no frame arrays). */
+    uint8_t * base_data;
+    uint8_t * converted_data;
+    /** The dimensions and formats of the contiguous frames. */
+    uint16_t width;
+    uint16_t height;
+    PixelFormat_t base_format;
+    PixelFormat_t format;
+    /** The conversion function, looked up once for the whole batch. */
+    uint8_t (* convert) (Image_t * img1, Image_t * img2);
+    /** The number of frames. */
+    uint32_t count;
+    /** The number of bands the batch is split into. */
+    uint16_t band_count;
+    /** The result of each band (1 if successful, 0 otherwise). */
+    uint8_t results[LIBUIMG_MAX_THREADS * LIBUIMG_BATCH_BANDS_PER_THREAD];
+} BatchJob_t;
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * INTERNAL THREAD POOL
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifdef LIBUIMG_THREADS
+
+static void internal_pool_run (void * context, BandTask_t task, void * arg, uint16_t band_count);
+
+
+static struct {
+    /** The worker threads (the thread calling `internal_pool_run()` is not one of them). */
+    pthread_t workers[LIBUIMG_MAX_THREADS];
+    /** The number of worker threads. */
+    uint16_t worker_count;
+    /** Set to ask the worker threads to exit. */
+    uint8_t stopping;
+    /** Protects everything below. */
+    pthread_mutex_t lock;
+    /** Signaled when a new operation is available (or when stopping). */
+    pthread_cond_t work_ready;
+    /** Signaled when the last band of the current operation is done. */
+    pthread_cond_t work_done;
+    /** Serializes operations (and resizing) on the pool. */
+    pthread_mutex_t dispatch_lock;
+    /** The current operation. */
+    BandTask_t task;
+    void * arg;
+    uint16_t band_count;
+    /** The next band to be picked up. */
+    uint16_t next_band;
+    /** The number of bands that are not done yet. */
+    uint16_t remaining_bands;
+    /** Incremented for every new operation. */
+    uint32_t generation;
+} internal_pool = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+    .work_ready = PTHREAD_COND_INITIALIZER,
+    .work_done = PTHREAD_COND_INITIALIZER,
+    .dispatch_lock = PTHREAD_MUTEX_INITIALIZER
+};
+
+
+static ThreadPool_t internal_thread_pool = { 0, internal_pool_run, NULL };
+
+
+// Must be called with the pool lock held
+static void run_available_bands (void)
+{
+    uint16_t band = 0;
+
+    while (internal_pool.next_band < internal_pool.band_count) {
+        band = internal_pool.next_band++;
+
+        pthread_mutex_unlock(&internal_pool.lock);
+        internal_pool.task(internal_pool.arg, band);
+        pthread_mutex_lock(&internal_pool.lock);
+
+        if (--internal_pool.remaining_bands == 0) pthread_cond_broadcast(&internal_pool.work_done);
+    }
+}
+
+
+static void * internal_pool_worker (void * start_generation)
+{
+    // Operations started after the worker was created (even if it was not running yet) must be picked up
+    uint32_t generation = (uint32_t) (uintptr_t) start_generation;
+
+    pthread_mutex_lock(&internal_pool.lock);
+
+    while (1) {
+        while (!internal_pool.stopping && internal_pool.generation == generation) {
+            pthread_cond_wait(&internal_pool.work_ready, &internal_pool.lock);
+        }
+        if (internal_pool.stopping) break;
+
+        generation = internal_pool.generation;
+        run_available_bands();
+    }
+
+    pthread_mutex_unlock(&internal_pool.lock);
+
+    return NULL;
+}
+
+
+static void internal_pool_run (void * context, BandTask_t task, void * arg, uint16_t band_count)
+{
+    (void) context;
+
+    pthread_mutex_lock(&internal_pool.dispatch_lock);
+    pthread_mutex_lock(&internal_pool.lock);
+
+    internal_pool.task = task;
+    internal_pool.arg = arg;
+    internal_pool.band_count = band_count;
+    internal_pool.next_band = 0;
+    internal_pool.remaining_bands = band_count;
+    internal_pool.generation++;
+    pthread_cond_broadcast(&internal_pool.work_ready);
+
+    // The calling thread processes bands as well, instead of just waiting for the workers
+    run_available_bands();
+    while (internal_pool.remaining_bands) pthread_cond_wait(&internal_pool.work_done, &internal_pool.lock);
+
+    pthread_mutex_unlock(&internal_pool.lock);
+    pthread_mutex_unlock(&internal_pool.dispatch_lock);
+}
+
+
+// Must be called with the dispatch lock held
+static void stop_workers (void)
+{
+    uint16_t i = 0;
+
+    pthread_mutex_lock(&internal_pool.lock);
+    internal_pool.stopping = 1;
+    pthread_cond_broadcast(&internal_pool.work_ready);
+    pthread_mutex_unlock(&internal_pool.lock);
+
+    for (i = 0; i < internal_pool.worker_count; i++) {
+        pthread_join(internal_pool.workers[i], NULL);
+    }
+
+    internal_pool.worker_count = 0;
+    internal_pool.stopping = 0;
+    internal_thread_pool.thread_count = 0;
+}
+
+
+uint8_t init_thread_pool (uint16_t thread_count)
+{
+    uint16_t i = 0;
+
+    if (thread_count < 1 || thread_count > LIBUIMG_MAX_THREADS) return 0;
+
+    pthread_mutex_lock(&internal_pool.dispatch_lock);
+
+    stop_workers();
+
+    for (i = 0; i < thread_count - 1; i++) {
+        if (pthread_create(&internal_pool.workers[i],
+                           NULL,
+                           internal_pool_worker,
+                           (void *) (uintptr_t) internal_pool.generation)) {
+            stop_workers();
+            pthread_mutex_unlock(&internal_pool.dispatch_lock);
+            return 0;
+        }
+        internal_pool.worker_count++;
+    }
+
+    internal_thread_pool.thread_count = thread_count;
+
+    pthread_mutex_unlock(&internal_pool.dispatch_lock);
+
+    return 1;
+}
+
+
+void shutdown_thread_pool (void)
+{
+    pthread_mutex_lock(&internal_pool.dispatch_lock);
+    stop_workers();
+    pthread_mutex_unlock(&internal_pool.dispatch_lock);
+}
+
+
+ThreadPool_t * get_thread_pool (void)
+{
+    if (!internal_thread_pool.thread_count) return NULL;
+
+    return &internal_thread_pool;
+}
+
+#else
+
+uint8_t init_thread_pool (uint16_t thread_count)
+{
+    // No threads without an OS; parallel operations run on the calling thread
+    (void) thread_count;
+
+    return 0;
+}
+
+
+void shutdown_thread_pool (void)
+{
+}
+
+
+ThreadPool_t * get_thread_pool (void)
+{
+    return NULL;
+}
+
+#endif
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * BAND TASKS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+static void get_band_rows (uint16_t height,
+                           uint16_t band,
+                           uint16_t band_count,
+                           uint16_t * first_row,
+                           uint16_t * last_row)
+{
+    // Bands are made of whole pairs of rows, so that YUV420p (or NV12, NV21) chroma rows are never shared between bands
+    uint32_t row_pairs = UROUND_UP(height / 2);
+
+    *first_row = (row_pairs * band / band_count) * 2;
+    *last_row = (row_pairs * (band + 1) / band_count) * 2;
+    if (*last_row > height) *last_row = height;
+}
+
+
+static void convert_band (void * arg, uint16_t band)
+{
+    BandJob_t * job = arg;
+    uint16_t first_row = 0;
+    uint16_t last_row = 0;
+    Image_t base_view;
+    Image_t converted_view;
+
+    get_band_rows(job->img->height, band, job->band_count, &first_row, &last_row);
+
+    job->results[band] = create_image_view(job->img, 0, first_row, job->img->width, last_row - first_row,
+                                           &base_view) &&
+                         create_image_view(job->converted_img, 0, first_row, job->img->width, last_row - first_row,
+                                           &converted_view) &&
+                         convert_and_flip_image(&base_view, &converted_view, job->flip_flags);
+}
+
+
+static void flipX_band (void * arg, uint16_t band)
+{
+    BandJob_t * job = arg;
+    uint8_t plane = 0;
+    uint32_t row_pairs = 0;
+
+    job->results[band] = 1;
+
+    // Each plane is split on its own, since rows are swapped with their mirror rows (not with neighbouring ones)
+    for (plane = 0; plane < get_image_plane_count(job->img->format); plane++) {
+        row_pairs = get_image_plane_height(job->img->height, job->img->format, plane) / 2;
+
+        job->results[band] &= flipX_plane_rows(job->img,
+                                               plane,
+                                               row_pairs * band / job->band_count,
+                                               row_pairs * (band + 1) / job->band_count);
+    }
+}
+
+
+static void flipY_band (void * arg, uint16_t band)
+{
+    BandJob_t * job = arg;
+    uint16_t first_row = 0;
+    uint16_t last_row = 0;
+    Image_t view;
+
+    get_band_rows(job->img->height, band, job->band_count, &first_row, &last_row);
+
+    job->results[band] = create_image_view(job->img, 0, first_row, job->img->width, last_row - first_row, &view) &&
+                         flipY_image(&view);
+}
+
+
+static void convert_batch_band (void * arg, uint16_t band)
+{
+    BatchJob_t * job = arg;
+    uint32_t frame = (uint64_t) job->count * band / job->band_count;
+    uint32_t last_frame = (uint64_t) job->count * (band + 1) / job->band_count;
+    uint32_t base_size = 0;
+    uint32_t converted_size = 0;
+    Image_t base_frame;
+    Image_t converted_frame;
+
+    job->results[band] = 1;
+
+    if (job->base_imgs) {
+        for (; frame < last_frame; frame++) {
+            job->results[band] &= job->convert(job->base_imgs[frame], job->converted_imgs[frame]);
+        }
+        return;
+    }
+
+    base_size = get_image_data_size(job->width, job->height, job->base_format);
+    converted_size = get_image_data_size(job->width, job->height, job->format);
+
+    for (; frame < last_frame; frame++) {
+        init_image(&base_frame, job->width, job->height, job->base_format,
+                   job->base_data + (size_t) base_size * frame, NULL);
+        init_image(&converted_frame, job->width, job->height, job->format,
+                   job->converted_data + (size_t) converted_size * frame, NULL);
+        job->results[band] &= job->convert(&base_frame, &converted_frame);
+    }
+}
+
+
+static uint8_t run_band_job (ThreadPool_t * pool, BandTask_t task, BandJob_t * job)
+{
+    uint16_t band = 0;
+    uint16_t max_bands = UROUND_UP(job->img->height / 2);
+
+    if (!pool) pool = get_thread_pool();
+
+    job->band_count = (pool && pool->run) ? pool->thread_count : 1;
+    if (job->band_count > LIBUIMG_MAX_THREADS) job->band_count = LIBUIMG_MAX_THREADS;
+    if (job->band_count > max_bands) job->band_count = max_bands;
+    if (job->band_count < 1) job->band_count = 1;
+
+    if (job->band_count > 1) {
+        pool->run(pool->context, task, job, job->band_count);
+    } else {
+        task(job, 0);
+    }
+
+    for (band = 0; band < job->band_count; band++) {
+        if (!job->results[band]) return 0;
+    }
+
+    return 1;
+}
+
+
+static uint8_t run_batch_job (ThreadPool_t * pool, BatchJob_t * job)
+{
+    uint16_t band = 0;
+    uint16_t thread_count = 1;
+    uint32_t max_bands = job->count;
+
+    if (!pool) pool = get_thread_pool();
+
+    // More bands than threads: the bands are handed out one at a time, so a thread done with its frames early picks up
+    // the next band instead of waiting for the slowest one
+    if (max_bands > LIBUIMG_MAX_THREADS * LIBUIMG_BATCH_BANDS_PER_THREAD) {
+        max_bands = LIBUIMG_MAX_THREADS * LIBUIMG_BATCH_BANDS_PER_THREAD;
+    }
+    // Thread counts are capped before being multiplied, so that the band count cannot wrap around
+    if (pool && pool->run) thread_count = pool->thread_count;
+    if (thread_count > LIBUIMG_MAX_THREADS) thread_count = LIBUIMG_MAX_THREADS;
+    job->band_count = (thread_count > 1) ? thread_count * LIBUIMG_BATCH_BANDS_PER_THREAD : 1;
+    if (job->band_count > max_bands) job->band_count = max_bands;
+    if (job->band_count < 1) job->band_count = 1;
+
+    if (job->band_count > 1) {
+        pool->run(pool->context, convert_batch_band, job, job->band_count);
+    } else {
+        convert_batch_band(job, 0);
+    }
+
+    for (band = 0; band < job->band_count; band++) {
+        if (!job->results[band]) return 0;
+    }
+
+    return 1;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * PARALLEL OPERATIONS
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+uint8_t convert_image_parallel (Image_t * base_img, Image_t * converted_img, ThreadPool_t * pool)
+{
+    BandJob_t job = { base_img, converted_img, 0, 0, { 0 } };
+
+    // Same checks as `convert_image()`, so that they are not repeated for every band
+    if (!base_img) return 0;
+    if (!converted_img) return 0;
+    if (base_img->width != converted_img->width || base_img->height != converted_img->height) return 0;
+    if (base_img->format == converted_img->format) return 1;
+    if (base_img->format == ASCII) return 0;
+
+    return run_band_job(pool, convert_band, &job);
+}
+
+
+uint8_t convert_and_flip_image_parallel (Image_t * base_img,
+                                         Image_t * converted_img,
+                                         uint8_t flip_flags,
+                                         ThreadPool_t * pool)
+{
+    Image_t reversed_view;
+    BandJob_t job = { base_img, converted_img, flip_flags & FLIP_Y_AXIS, 0, { 0 } };
+
+    // Same checks as `convert_and_flip_image()`, so that they are not repeated for every band
+    if (!base_img) return 0;
+    if (!converted_img) return 0;
+    if (base_img->width != converted_img->width || base_img->height != converted_img->height) return 0;
+    if (flip_flags & ~(FLIP_X_AXIS | FLIP_Y_AXIS)) return 0;
+    if (base_img->format == converted_img->format) {
+        if ((flip_flags & FLIP_X_AXIS) && !flipX_image_parallel(converted_img, pool)) return 0;
+        if ((flip_flags & FLIP_Y_AXIS) && !flipY_image_parallel(converted_img, pool)) return 0;
+        return 1;
+    }
+    if (base_img->format == ASCII) return 0;
+
+    // Every band of the base image is written to the mirrored band of the converted image
+    if (flip_flags & FLIP_X_AXIS) {
+        if (!create_reversed_image_view(converted_img, &reversed_view)) return 0;
+        job.converted_img = &reversed_view;
+    }
+
+    return run_band_job(pool, convert_band, &job);
+}
+
+
+uint8_t convert_images_batch (Image_t * const * base_imgs,
+                              Image_t * const * converted_imgs,
+                              uint32_t count,
+                              ThreadPool_t * pool)
+{
+    uint32_t i = 0;
+    BatchJob_t job;
+
+    if (!base_imgs) return 0;
+    if (!converted_imgs) return 0;
+    if (!count) return 1;
+    if (!base_imgs[0] || !converted_imgs[0]) return 0;
+
+    // Same checks as `convert_image()`, done once for the whole batch: every frame must match the first one
+    for (i = 0; i < count; i++) {
+        if (!base_imgs[i] || !converted_imgs[i]) return 0;
+        if (base_imgs[i]->format != base_imgs[0]->format || converted_imgs[i]->format != converted_imgs[0]->format) {
+            return 0;
+        }
+        if (base_imgs[i]->width != base_imgs[0]->width || base_imgs[i]->height != base_imgs[0]->height) return 0;
+        if (converted_imgs[i]->width != base_imgs[0]->width || converted_imgs[i]->height != base_imgs[0]->height) {
+            return 0;
+        }
+    }
+    if (base_imgs[0]->format > ASCII || converted_imgs[0]->format > ASCII) return 0;
+    if (base_imgs[0]->format == converted_imgs[0]->format) return 1;
+    if (base_imgs[0]->format == ASCII) return 0;
+
+    memset(&job, 0, sizeof(job));
+    job.base_imgs = base_imgs;
+    job.converted_imgs = converted_imgs;
+    job.convert = conversion_function_LUT[base_imgs[0]->format][converted_imgs[0]->format];
+    job.count = count;
+
+    return run_batch_job(pool, &job);
+}
+
+
+uint8_t convert_frames_batch (uint8_t * base_data,
+                              uint8_t * converted_data,
+                              uint32_t count,
+                              uint16_t width,
+                              uint16_t height,
+                              PixelFormat_t base_format,
+                              PixelFormat_t format,
+                              ThreadPool_t * pool)
+{
+    BatchJob_t job;
+
+    if (!base_data) return 0;
+    if (!converted_data) return 0;
+    if (base_format > ASCII || format > ASCII) return 0;
+    if (!count || base_format == format) return 1;
+    if (base_format == ASCII) return 0;
+
+    memset(&job, 0, sizeof(job));
+    job.base_data = base_data;
+    job.converted_data = converted_data;
+    job.width = width;
+    job.height = height;
+    job.base_format = base_format;
+    job.format = format;
+    job.convert = conversion_function_LUT[base_format][format];
+    job.count = count;
+
+    return run_batch_job(pool, &job);
+}
+
+
+uint8_t flipX_image_parallel (Image_t * img, ThreadPool_t * pool)
+{
+    BandJob_t job = { img, NULL, 0, 0, { 0 } };
+
+    if (!img) return 0;
+    if (img->format > ASCII) return 0;
+
+    return run_band_job(pool, flipX_band, &job);
+}
+
+
+uint8_t flipY_image_parallel (Image_t * img, ThreadPool_t * pool)
+{
+    BandJob_t job = { img, NULL, 0, 0, { 0 } };
+
+    if (!img) return 0;
+    if (img->format > ASCII) return 0;
+
+    return run_band_job(pool, flipY_band, &job);
+}
@@ -0,0 +1,166 @@
+#ifndef __LIB_UIMG_THREADS_H__
+#define __LIB_UIMG_THREADS_H__
+
+
+#include "libuimg_img.h"
+
+
+#define LIBUIMG_MAX_THREADS 64 /**< Maximum number of threads of the internal thread pool. */
+#define LIBUIMG_BATCH_BANDS_PER_THREAD 4 /**< Number of bands per thread the frames of a batch are split into. */
+
+
+/**
+ * @brief      A band task, as run by a thread pool.
+ *
+ * @param      arg   The argument of the task (shared by all of its bands).
+ * @param[in]  band  The index of the band to process.
+ */
+typedef void (* BandTask_t) (void * arg, uint16_t band);
+
+
+/**
+ * @brief A thread pool, used to run the bands of an operation in parallel.
+ *
+ * The internal thread pool of libuimg (see `init_thread_pool()`) is based on pthreads, but any pool can be plugged in
+ * by the caller through the `run` function.
+ */
+typedef struct {
+    /** The number of bands an operation should be split into (typically, the number of threads of the pool). */
+    uint16_t thread_count;
+    /**
+     * Run `task(arg, band)` for every band in [0, band_count), in any order and on any thread; must only return once
+     * every band is done.
+     */
+    void (* run) (void * context, BandTask_t task, void * arg, uint16_t band_count);
+    /** Passed as-is to `run`. */
+    void * context;
+} ThreadPool_t;
+
+
+/**
+ * @brief      Start the internal thread pool.
+ *
+ * The calling thread takes part in the work, so `thread_count - 1` worker threads are created. Calling this function
+ * again resizes the pool.
+ *
+ * The internal thread pool is only available if libuimg was built with `LIBUIMG_THREADS` (the default for targets with
+ * an OS); otherwise, this function fails and parallel operations run on the calling thread.
+ *
+ * @param[in]  thread_count  The total number of threads (between 1 and `LIBUIMG_MAX_THREADS`).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t init_thread_pool (uint16_t thread_count);
+
+/**
+ * @brief      Stop the internal thread pool, joining all of its worker threads.
+ */
+void shutdown_thread_pool (void);
+
+/**
+ * @brief      Get the internal thread pool.
+ *
+ * @return     The internal thread pool, or NULL if it has not been started.
+ */
+ThreadPool_t * get_thread_pool (void);
+
+/**
+ * @brief      Convert a base image to a different format, using multiple threads.
+ *
+ * The image is split into bands of rows (of even height, so that YUV420p chroma rows are never shared between bands),
+ * each of which is converted by `convert_image()`; the result is identical to that of `convert_image()`.
+ *
+ * @param      base_img       The base image to be converted.
+ * @param      converted_img  The converted image.
+ * @param      pool           The thread pool to use, or NULL to use the internal one (if it has not been started, the
+ *                            conversion runs on the calling thread).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_image_parallel (Image_t * base_img, Image_t * converted_img, ThreadPool_t * pool);
+
+/**
+ * @brief      Convert a base image to a different format and flip it in a single pass, using multiple threads.
+ *
+ * The result is identical to that of `convert_and_flip_image()`.
+ *
+ * @param      base_img       The base image to be converted.
+ * @param      converted_img  The converted (and flipped) image.
+ * @param[in]  flip_flags     The axes to flip the converted image along (`FLIP_X_AXIS` and/or `FLIP_Y_AXIS`).
+ * @param      pool           The thread pool to use, or NULL to use the internal one (see `convert_image_parallel()`).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t convert_and_flip_image_parallel (Image_t * base_img,
+                                         Image_t * converted_img,
+                                         uint8_t flip_flags,
+                                         ThreadPool_t * pool);
+
+/**
+ * @brief      Convert a batch of same-sized frames to a different format, using multiple threads.
+ *
+ * Formats and dimensions are checked once for the whole batch, and the conversion function is looked up once. Frames
+ * (not bands of rows) are spread over the threads: the batch is split into several bands of consecutive frames per
+ * thread, which idle threads pick up as they go, so that frames taking longer than others (cache misses, preemption)
+ * do not hold up the whole batch. The result is identical to calling `convert_image()` on every frame.
+ *
+ * @param      base_imgs       The frames to be converted (all of the same format and size).
+ * @param      converted_imgs  The converted frames (all of the same format, and of the size of the base frames).
+ * @param[in]  count           The number of frames.
+ * @param      pool            The thread pool to use, or NULL to use the internal one (see `convert_image_parallel()`).
+ *
+ * @return     1 if successful, 0 otherwise (some frames may then have been converted).
+ */
+uint8_t convert_images_batch (Image_t * const * base_imgs,
+                              Image_t * const * converted_imgs,
+                              uint32_t count,
+                              ThreadPool_t * pool);
+
+/**
+ * @brief      Convert a batch of frames stored one after the other in a single buffer, using multiple threads.
+ *
+ * Frames are tightly packed (as in raw video files, see `get_image_data_size()`), in both the base and the converted
+ * buffers; see `convert_images_batch()`.
+ *
+ * @param      base_data       The frames to be converted.
+ * @param      converted_data  The converted frames.
+ * @param[in]  count           The number of frames.
+ * @param[in]  width           The width of the frames (in pixels).
+ * @param[in]  height          The height of the frames (in pixels).
+ * @param[in]  base_format     The pixel format of the frames to be converted.
+ * @param[in]  format          The pixel format to convert to.
+ * @param      pool            The thread pool to use, or NULL to use the internal one (see `convert_image_parallel()`).
+ *
+ * @return     1 if successful, 0 otherwise (some frames may then have been converted).
+ */
+uint8_t convert_frames_batch (uint8_t * base_data,
+                              uint8_t * converted_data,
+                              uint32_t count,
+                              uint16_t width,
+                              uint16_t height,
+                              PixelFormat_t base_format,
+                              PixelFormat_t format,
+                              ThreadPool_t * pool);
+
+/**
+ * @brief      Flip an image along the X axis, using multiple threads.
+ *
+ * @param      img   The image to flip.
+ * @param      pool  The thread pool to use, or NULL to use the internal one (see `convert_image_parallel()`).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipX_image_parallel (Image_t * img, ThreadPool_t * pool);
+
+/**
+ * @brief      Flip an image along the Y axis, using multiple threads.
+ *
+ * @param      img   The image to flip.
+ * @param      pool  The thread pool to use, or NULL to use the internal one (see `convert_image_parallel()`).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t flipY_image_parallel (Image_t * img, ThreadPool_t * pool);
+
+
+#endif
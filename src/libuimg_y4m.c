@@ -0,0 +1,427 @@
+#include "libuimg_y4m.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#ifdef LIBUIMG_THREADS
+#include <pthread.h>
+#endif
+
+
+#define Y4M_STREAM_MAGIC "YUV4MPEG2 " /**< The start of the stream header. */
+#define Y4M_FRAME_MAGIC "FRAME"       /**< The start of every frame header. */
+
+// Round a size up to a multiple of 8 bytes
+#define Y4M_ALIGN_SIZE(size) (((size) + 7u) & ~((uint64_t) 7u))
+
+
+// Read a header line (without its newline), and return its length (0 at the end of the stream, or if it is too long)
+static uint32_t read_header_line (FILE * file, char * line)
+{
+    int32_t c = 0;
+    uint32_t length = 0;
+
+    while ((c = (int32_t) fgetc(file)) != EOF && c != '\n') {
+        if (length == Y4M_MAX_HEADER_SIZE - 1) return 0;
+        line[length++] = c;
+    }
+
+    line[length] = '\0';
+
+    return (c == '\n') ? length : 0;
+}
+
+
+// Read the header and the pixel data of the next frame
+static uint8_t read_frame_data (Y4MReader_t * reader, uint8_t * buffer)
+{
+    char line[Y4M_MAX_HEADER_SIZE];
+
+    // Frame parameters (if any) are ignored
+    if (!read_header_line(reader->file, line)) return 0;
+    if (strncmp(line, Y4M_FRAME_MAGIC, strlen(Y4M_FRAME_MAGIC))) return 0;
+    if (line[strlen(Y4M_FRAME_MAGIC)] != '\0' && line[strlen(Y4M_FRAME_MAGIC)] != ' ') return 0;
+
+    return fread(buffer, 1, reader->frame_size, reader->file) == reader->frame_size;
+}
+
+
+uint8_t get_y4m_colorspace_format (const char * colorspace, PixelFormat_t * format)
+{
+    if (!colorspace) return 0;
+    if (!format) return 0;
+
+    if (!strcmp(colorspace, "420jpeg") || !strcmp(colorspace, "420paldv") || !strcmp(colorspace, "420mpeg2") ||
+        !strcmp(colorspace, "420")) {
+        *format = YUV420p;
+    } else if (!strcmp(colorspace, "444")) {
+        *format = YUV444p;
+    } else if (!strcmp(colorspace, "mono")) {
+        *format = GRAYSCALE;
+    } else {
+        return 0;
+    }
+
+    return 1;
+}
+
+
+static const char * get_format_y4m_colorspace (PixelFormat_t format)
+{
+    switch (format) {
+        case YUV420p:
+            return "420jpeg";
+
+        case YUV444p:
+            return "444";
+
+        case GRAYSCALE:
+            return "mono";
+
+        default:
+            return NULL;
+    }
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * READ-AHEAD THREAD
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifdef LIBUIMG_THREADS
+
+#define FRAME_EMPTY 0 /**< The buffer can be filled by the read-ahead thread. */
+#define FRAME_READY 1 /**< The buffer holds the next frame to hand out. */
+#define FRAME_END 2   /**< The stream ended (or failed) where the buffer should have been filled. */
+
+
+/**
+ * @brief The state of the read-ahead thread of a reader, which fills both frame buffers in turn.
+ */
+typedef struct {
+    /** The read-ahead thread. */
+    pthread_t thread;
+    /** Protects everything below. */
+    pthread_mutex_t lock;
+    /** Signaled whenever the state of a buffer changes (or when stopping). */
+    pthread_cond_t changed;
+    /** The state of each buffer. */
+    uint8_t states[2];
+    /** The buffer holding the next frame to hand out. */
+    uint8_t next;
+    /** Set while the other buffer is being used by the caller. */
+    uint8_t handed_out;
+    /** Set to ask the read-ahead thread to exit. */
+    uint8_t stopping;
+} Y4MPrefetch_t;
+
+
+static void * read_ahead (void * arg)
+{
+    Y4MReader_t * reader = arg;
+    Y4MPrefetch_t * prefetch = reader->prefetch;
+    uint8_t buffer = 0;
+    uint8_t result = 0;
+
+    pthread_mutex_lock(&prefetch->lock);
+
+    while (1) {
+        while (!prefetch->stopping && prefetch->states[buffer] != FRAME_EMPTY) {
+            pthread_cond_wait(&prefetch->changed, &prefetch->lock);
+        }
+        if (prefetch->stopping) break;
+
+        // The buffer belongs to this thread until it is marked as ready
+        pthread_mutex_unlock(&prefetch->lock);
+        result = read_frame_data(reader, reader->buffers[buffer]);
+        pthread_mutex_lock(&prefetch->lock);
+
+        prefetch->states[buffer] = result ? FRAME_READY : FRAME_END;
+        pthread_cond_broadcast(&prefetch->changed);
+        if (!result) break;
+
+        buffer ^= 1;
+    }
+
+    pthread_mutex_unlock(&prefetch->lock);
+
+    return NULL;
+}
+
+
+// Start the read-ahead thread, with its state at the start of `memory` (aligned), followed by the second buffer
+static uint8_t start_read_ahead (Y4MReader_t * reader, uint8_t * memory)
+{
+    Y4MPrefetch_t * prefetch = (Y4MPrefetch_t *) memory;
+
+    memset(prefetch, 0, sizeof(Y4MPrefetch_t));
+    reader->buffers[1] = memory + Y4M_ALIGN_SIZE(sizeof(Y4MPrefetch_t));
+
+    pthread_mutex_init(&prefetch->lock, NULL);
+    pthread_cond_init(&prefetch->changed, NULL);
+    reader->prefetch = prefetch;
+
+    if (pthread_create(&prefetch->thread, NULL, read_ahead, reader)) {
+        pthread_mutex_destroy(&prefetch->lock);
+        pthread_cond_destroy(&prefetch->changed);
+        reader->buffers[1] = NULL;
+        reader->prefetch = NULL;
+        return 0;
+    }
+
+    return 1;
+}
+
+
+static uint8_t * get_read_ahead_frame (Y4MReader_t * reader)
+{
+    Y4MPrefetch_t * prefetch = reader->prefetch;
+    uint8_t * buffer = NULL;
+
+    pthread_mutex_lock(&prefetch->lock);
+
+    // The frame handed out last time is not used anymore, so its buffer can be filled again
+    if (prefetch->handed_out) {
+        prefetch->states[prefetch->next ^ 1] = FRAME_EMPTY;
+        prefetch->handed_out = 0;
+        pthread_cond_broadcast(&prefetch->changed);
+    }
+
+    while (prefetch->states[prefetch->next] == FRAME_EMPTY) {
+        pthread_cond_wait(&prefetch->changed, &prefetch->lock);
+    }
+
+    if (prefetch->states[prefetch->next] == FRAME_READY) {
+        buffer = reader->buffers[prefetch->next];
+        prefetch->handed_out = 1;
+        prefetch->next ^= 1;
+    }
+
+    pthread_mutex_unlock(&prefetch->lock);
+
+    return buffer;
+}
+
+
+static void stop_read_ahead (Y4MReader_t * reader)
+{
+    Y4MPrefetch_t * prefetch = reader->prefetch;
+
+    pthread_mutex_lock(&prefetch->lock);
+    prefetch->stopping = 1;
+    pthread_cond_broadcast(&prefetch->changed);
+    pthread_mutex_unlock(&prefetch->lock);
+
+    pthread_join(prefetch->thread, NULL);
+
+    pthread_mutex_destroy(&prefetch->lock);
+    pthread_cond_destroy(&prefetch->changed);
+    reader->prefetch = NULL;
+}
+
+#endif
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * READER
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+uint8_t open_y4m_reader (Y4MReader_t * reader, FILE * file)
+{
+    char line[Y4M_MAX_HEADER_SIZE];
+    char * token = NULL;
+    char * next_token = NULL;
+    uint64_t width = 0;
+    uint64_t height = 0;
+    uint32_t frame_rate_num = 0;
+    uint32_t frame_rate_den = 0;
+    PixelFormat_t format = YUV420p;
+
+    if (!reader) return 0;
+    if (!file) return 0;
+
+    if (!read_header_line(file, line)) return 0;
+    if (strncmp(line, Y4M_STREAM_MAGIC, strlen(Y4M_STREAM_MAGIC))) return 0;
+
+    // Parameters are single-letter tags followed by their value; unknown ones (interlacing, aspect ratio, X
+    // extensions...) are ignored
+    for (token = strtok_r(line + strlen(Y4M_STREAM_MAGIC), " ", &next_token);
+         token;
+         token = strtok_r(NULL, " ", &next_token)) {
+        switch (token[0]) {
+            case 'W':
+                width = (uint64_t) strtoull(token + 1, NULL, 10);
+                break;
+
+            case 'H':
+                height = (uint64_t) strtoull(token + 1, NULL, 10);
+                break;
+
+            case 'F':
+                if (sscanf(token + 1, "%" SCNu32 ":%" SCNu32, &frame_rate_num, &frame_rate_den) != 2) return 0;
+                break;
+
+            case 'C':
+                if (!get_y4m_colorspace_format(token + 1, &format)) return 0;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    if (!width || width > UINT16_MAX) return 0;
+    if (!height || height > UINT16_MAX) return 0;
+    // Frames whose size does not fit in 32 bits would be read into a wrapped-around buffer
+    if (!get_image_data_size(width, height, format)) return 0;
+
+    reader->file = file;
+    reader->width = width;
+    reader->height = height;
+    reader->format = format;
+    reader->frame_rate_num = frame_rate_num;
+    reader->frame_rate_den = frame_rate_den;
+    reader->frame_size = get_image_data_size(width, height, format);
+    reader->buffers[0] = NULL;
+    reader->buffers[1] = NULL;
+    reader->prefetch = NULL;
+
+    return 1;
+}
+
+
+size_t get_y4m_reader_memory_size (const Y4MReader_t * reader)
+{
+    uint64_t size = 0;
+
+    if (!reader) return 0;
+    if (!reader->frame_size) return 0;
+
+    // Room for aligning the start of the memory, and the first frame buffer
+    size = 8 + Y4M_ALIGN_SIZE(reader->frame_size);
+#ifdef LIBUIMG_THREADS
+    // The state of the read-ahead thread, and the second frame buffer
+    size += Y4M_ALIGN_SIZE(sizeof(Y4MPrefetch_t)) + reader->frame_size;
+#endif
+    if (size > SIZE_MAX) return 0;
+
+    return size;
+}
+
+
+uint8_t start_y4m_reader (Y4MReader_t * reader, uint8_t * memory)
+{
+    if (!reader) return 0;
+    if (!reader->file) return 0;
+    if (!memory) return 0;
+    if (reader->buffers[0]) return 0;
+
+    memory += (8 - (uintptr_t) memory % 8) % 8;
+    reader->buffers[0] = memory;
+
+#ifdef LIBUIMG_THREADS
+    // Without a read-ahead thread, frames are simply read on the calling thread
+    start_read_ahead(reader, memory + Y4M_ALIGN_SIZE(reader->frame_size));
+#endif
+
+    return 1;
+}
+
+
+uint8_t read_y4m_frame (Y4MReader_t * reader, Image_t * frame)
+{
+    uint8_t * buffer = NULL;
+
+    if (!reader) return 0;
+    if (!reader->buffers[0]) return 0;
+    if (!frame) return 0;
+
+#ifdef LIBUIMG_THREADS
+    if (reader->prefetch) buffer = get_read_ahead_frame(reader);
+#endif
+    if (!reader->prefetch && read_frame_data(reader, reader->buffers[0])) buffer = reader->buffers[0];
+
+    if (!buffer) return 0;
+
+    return init_image(frame, reader->width, reader->height, reader->format, buffer, NULL);
+}
+
+
+void close_y4m_reader (Y4MReader_t * reader)
+{
+    if (!reader) return;
+
+#ifdef LIBUIMG_THREADS
+    if (reader->prefetch) stop_read_ahead(reader);
+#endif
+
+    reader->buffers[0] = NULL;
+    reader->buffers[1] = NULL;
+}
+
+
+/* --------------------------------------------------------------------------------------------------------------------
+ * WRITER
+ * --------------------------------------------------------------------------------------------------------------------
+ */
+
+uint8_t open_y4m_writer (Y4MWriter_t * writer,
+                         FILE * file,
+                         uint16_t width,
+                         uint16_t height,
+                         PixelFormat_t format,
+                         uint32_t frame_rate_num,
+                         uint32_t frame_rate_den)
+{
+    if (!writer) return 0;
+    if (!file) return 0;
+    if (!width || !height) return 0;
+    if (!get_format_y4m_colorspace(format)) return 0;
+    if (!frame_rate_num || !frame_rate_den) return 0;
+
+    if (fprintf(file, "%sW%u H%u F%" PRIu32 ":%" PRIu32 " Ip A0:0 C%s\n", Y4M_STREAM_MAGIC, width, height,
+                frame_rate_num, frame_rate_den, get_format_y4m_colorspace(format)) < 0) return 0;
+
+    writer->file = file;
+    writer->width = width;
+    writer->height = height;
+    writer->format = format;
+
+    return 1;
+}
+
+
+uint8_t write_y4m_frame (Y4MWriter_t * writer, const Image_t * frame)
+{
+    uint8_t plane = 0;
+    uint16_t row = 0;
+    uint16_t plane_height = 0;
+    uint32_t row_size = 0;
+
+    if (!writer) return 0;
+    if (!writer->file) return 0;
+    if (!frame) return 0;
+    if (!frame->data) return 0;
+    if (frame->width != writer->width || frame->height != writer->height || frame->format != writer->format) return 0;
+
+    if (fputs(Y4M_FRAME_MAGIC "\n", writer->file) < 0) return 0;
+
+    for (plane = 0; plane < get_image_plane_count(frame->format); plane++) {
+        plane_height = get_image_plane_height(frame->height, frame->format, plane);
+        row_size = get_image_row_size(frame->width, frame->format, plane);
+
+        // Tightly packed planes are written all at once
+        if (get_image_stride(frame, plane) == (int32_t) row_size) {
+            if (fwrite(get_image_plane(frame, plane), row_size, plane_height, writer->file) != plane_height) return 0;
+            continue;
+        }
+
+        for (row = 0; row < plane_height; row++) {
+            if (fwrite(get_image_row(frame, plane, row), 1, row_size, writer->file) != row_size) return 0;
+        }
+    }
+
+    return 1;
+}
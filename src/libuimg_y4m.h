@@ -0,0 +1,154 @@
+#ifndef __LIB_UIMG_Y4M_H__
+#define __LIB_UIMG_Y4M_H__
+
+
+#include "libuimg_img.h"
+
+
+#define Y4M_MAX_HEADER_SIZE 256 /**< The maximum size of the stream header of a Y4M file (including the newline). */
+
+
+/**
+ * @brief A Y4M (YUV4MPEG2) stream being read.
+ *
+ * Frames are read into caller-provided memory (see `start_y4m_reader()`), so reading never allocates memory. If
+ * libuimg was built with `LIBUIMG_THREADS`, a background thread reads frame N+1 while frame N is being processed.
+ */
+typedef struct {
+    /** The stream. */
+    FILE * file;
+    /** The width of the frames (in pixels). */
+    uint16_t width;
+    /** The height of the frames (in pixels). */
+    uint16_t height;
+    /** The pixel format of the frames (YUV420p, YUV444p or GRAYSCALE). */
+    PixelFormat_t format;
+    /** The numerator of the frame rate (0 if unspecified). */
+    uint32_t frame_rate_num;
+    /** The denominator of the frame rate (0 if unspecified). */
+    uint32_t frame_rate_den;
+    /** The size of the pixel data of a frame (in bytes). */
+    uint32_t frame_size;
+    /** The frame buffers (two when frames are read ahead, one otherwise), in the memory of the reader. */
+    uint8_t * buffers[2];
+    /** The internal state of the read-ahead thread (NULL if frames are read on the calling thread). */
+    void * prefetch;
+} Y4MReader_t;
+
+
+/**
+ * @brief A Y4M (YUV4MPEG2) stream being written.
+ */
+typedef struct {
+    /** The stream. */
+    FILE * file;
+    /** The width of the frames (in pixels). */
+    uint16_t width;
+    /** The height of the frames (in pixels). */
+    uint16_t height;
+    /** The pixel format of the frames (YUV420p, YUV444p or GRAYSCALE). */
+    PixelFormat_t format;
+} Y4MWriter_t;
+
+
+/**
+ * @brief      Get the pixel format of a Y4M colorspace.
+ *
+ * @param[in]  colorspace  The colorspace, as found in the `C` parameter of the stream header (e.g. "420jpeg").
+ * @param      format      The pixel format (YUV420p for every 4:2:0 chroma siting, YUV444p for "444", GRAYSCALE for
+ *                         "mono").
+ *
+ * @return     1 if successful, 0 otherwise (colorspaces with other subsamplings, bit depths, or alpha).
+ */
+uint8_t get_y4m_colorspace_format (const char * colorspace, PixelFormat_t * format);
+
+/**
+ * @brief      Open a Y4M stream, parsing its stream header.
+ *
+ * The stream stays owned by the caller, who closes it after `close_y4m_reader()`; it does not need to be seekable
+ * (e.g. pipes and `stdin`). Frames can be read once the reader has been given its memory with `start_y4m_reader()`.
+ *
+ * @param      reader  The reader.
+ * @param      file    The stream (positioned on the stream header).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t open_y4m_reader (Y4MReader_t * reader, FILE * file);
+
+/**
+ * @brief      Get the size of the memory needed by an open reader (see `start_y4m_reader()`).
+ *
+ * It holds one frame, or two frames and the state of the read-ahead thread if libuimg was built with
+ * `LIBUIMG_THREADS`.
+ *
+ * @param[in]  reader  The reader, opened with `open_y4m_reader()`.
+ *
+ * @return     The size of the memory (in bytes), or 0 if the reader is not open.
+ */
+size_t get_y4m_reader_memory_size (const Y4MReader_t * reader);
+
+/**
+ * @brief      Give an open reader the memory its frames are read into, and start reading ahead (if possible).
+ *
+ * The memory stays owned by the caller, and must not be reused before `close_y4m_reader()`.
+ *
+ * @param      reader  The reader, opened with `open_y4m_reader()`.
+ * @param      memory  The memory of the reader, of at least `get_y4m_reader_memory_size()` bytes.
+ *
+ * @return     1 if successful, 0 otherwise (including if the reader was already started).
+ */
+uint8_t start_y4m_reader (Y4MReader_t * reader, uint8_t * memory);
+
+/**
+ * @brief      Read the next frame of a Y4M stream.
+ *
+ * The frame is a view on the memory of the reader; it stays valid until the next call, or until the reader is
+ * closed, and must not be passed to `destroy_image()`.
+ *
+ * @param      reader  The reader, started with `start_y4m_reader()`.
+ * @param      frame   The resulting view.
+ *
+ * @return     1 if successful, 0 otherwise (including at the end of the stream).
+ */
+uint8_t read_y4m_frame (Y4MReader_t * reader, Image_t * frame);
+
+/**
+ * @brief      Stop reading a Y4M stream (neither the stream nor the memory of the reader are released).
+ *
+ * @param      reader  The reader.
+ */
+void close_y4m_reader (Y4MReader_t * reader);
+
+/**
+ * @brief      Start writing a Y4M stream, writing its stream header.
+ *
+ * @param      writer          The writer.
+ * @param      file            The stream.
+ * @param[in]  width           The width of the frames (in pixels).
+ * @param[in]  height          The height of the frames (in pixels).
+ * @param[in]  format          The pixel format of the frames (YUV420p, YUV444p or GRAYSCALE).
+ * @param[in]  frame_rate_num  The numerator of the frame rate.
+ * @param[in]  frame_rate_den  The denominator of the frame rate.
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t open_y4m_writer (Y4MWriter_t * writer,
+                         FILE * file,
+                         uint16_t width,
+                         uint16_t height,
+                         PixelFormat_t format,
+                         uint32_t frame_rate_num,
+                         uint32_t frame_rate_den);
+
+/**
+ * @brief      Write a frame to a Y4M stream.
+ *
+ * @param      writer  The writer.
+ * @param[in]  frame   The frame (of the dimensions and format of the stream; strides and views are honored).
+ *
+ * @return     1 if successful, 0 otherwise.
+ */
+uint8_t write_y4m_frame (Y4MWriter_t * writer, const Image_t * frame);
+
+
+#endif
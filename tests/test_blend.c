@@ -0,0 +1,396 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 150
+#define TEST_HEIGHT 23
+#define OVERLAY_WIDTH 101
+#define OVERLAY_HEIGHT 9
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+// Copy the pixels of an image into another one of the same size and format (which may be a view)
+static uint8_t copy_pixels (const Image_t * src_img, Image_t * dst_img)
+{
+    uint8_t plane = 0;
+    uint16_t row = 0;
+
+    for (plane = 0; plane < get_image_plane_count(src_img->format); plane++) {
+        for (row = 0; row < get_image_plane_height(src_img->height, src_img->format, plane); row++) {
+            memcpy(get_image_row(dst_img, plane, row), get_image_row(src_img, plane, row),
+                   get_image_row_size(src_img->width, src_img->format, plane));
+        }
+    }
+
+    return 1;
+}
+
+
+// Make the alpha values of an overlay sparse: only a diagonal band on the left and a single pixel are left visible, so
+// that whole tiles are transparent
+static void make_sparse (Image_t * overlay_img, Image_t * mask_img)
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint8_t * alpha = NULL;
+
+    for (y = 0; y < overlay_img->height; y++) {
+        for (x = 0; x < overlay_img->width; x++) {
+            alpha = mask_img ? get_image_row(mask_img, 0, y) + x : get_image_row(overlay_img, 0, y) + x * 4;
+            if (((x + 3 * y) % 37 < 5 && x < 30) || (x == 50 && y == 4)) continue;
+            *alpha = 0;
+        }
+    }
+}
+
+
+// round(x / 255), computed independently from the kernels
+static uint32_t round_div255 (uint32_t x)
+{
+    return (2 * x + 255) / 510;
+}
+
+
+// Get the RGB values and alpha value of an overlay pixel, or 0 if it lies outside of the overlay
+static uint8_t get_overlay_pixel (const Image_t * overlay_img,
+                                  const Image_t * mask_img,
+                                  int32_t x,
+                                  int32_t y,
+                                  uint8_t * rgb)
+{
+    const uint8_t * pixel = NULL;
+
+    if (x < 0 || y < 0 || x >= overlay_img->width || y >= overlay_img->height) return 0;
+
+    if (mask_img) {
+        pixel = get_image_row(overlay_img, 0, y) + x;
+        rgb[0] = rgb[1] = rgb[2] = *pixel;
+        return get_image_row(mask_img, 0, y)[x];
+    }
+
+    // RGBA8888 pixels are stored as A, B, G, R
+    pixel = get_image_row(overlay_img, 0, y) + x * 4;
+    rgb[0] = pixel[3];
+    rgb[1] = pixel[2];
+    rgb[2] = pixel[1];
+
+    return pixel[0];
+}
+
+
+static uint8_t blend_value (uint8_t color, uint8_t alpha, uint8_t dst)
+{
+    return round_div255(color * alpha) + round_div255(dst * (255 - alpha));
+}
+
+
+// Check an RGB24 or RGB565 image against a per-pixel reference
+static char * check_rgb_blend (const Image_t * img,
+                               const Image_t * original_img,
+                               const Image_t * overlay_img,
+                               const Image_t * mask_img,
+                               int32_t x,
+                               int32_t y)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint8_t k = 0;
+    uint8_t alpha = 0;
+    uint8_t rgb[3] = { 0 };
+    uint8_t dst[3] = { 0 };
+    uint8_t expected[3] = { 0 };
+    const uint8_t * original = NULL;
+    const uint8_t * pixel = NULL;
+
+    for (i = 0; i < img->height; i++) {
+        for (j = 0; j < img->width; j++) {
+            alpha = get_overlay_pixel(overlay_img, mask_img, (int32_t) j - x, (int32_t) i - y, rgb);
+
+            if (img->format == RGB24) {
+                original = get_image_row(original_img, 0, i) + j * 3;
+                pixel = get_image_row(img, 0, i) + j * 3;
+                for (k = 0; k < 3; k++) {
+                    expected[k] = blend_value(rgb[k], alpha, original[k]);
+                    CUTS_ASSERT(pixel[k] == expected[k], "Wrong RGB24 pixel (%u, %u) at offset (%d, %d)", j, i, x, y);
+                }
+                continue;
+            }
+
+            // RGB565 channels are expanded by bit replication, and truncated back
+            original = get_image_row(original_img, 0, i) + j * 2;
+            pixel = get_image_row(img, 0, i) + j * 2;
+            dst[0] = original[1] >> 3;
+            dst[1] = ((original[1] & 0x07) << 3) | (original[0] >> 5);
+            dst[2] = original[0] & 0x1f;
+            dst[0] = (dst[0] << 3) | (dst[0] >> 2);
+            dst[1] = (dst[1] << 2) | (dst[1] >> 4);
+            dst[2] = (dst[2] << 3) | (dst[2] >> 2);
+            for (k = 0; k < 3; k++) {
+                expected[k] = blend_value(rgb[k], alpha, dst[k]);
+            }
+            CUTS_ASSERT(pixel[1] == ((expected[0] & 0xf8) | (expected[1] >> 5)) &&
+                        pixel[0] == (((expected[1] << 3) & 0xe0) | (expected[2] >> 3)),
+                        "Wrong RGB565 pixel (%u, %u) at offset (%d, %d)", j, i, x, y);
+        }
+    }
+
+    return NULL;
+}
+
+
+// Check a YUV420p image against a per-pixel reference (overlay colors being converted like RGB24 pixels are)
+static char * check_YUV420p_blend (const Image_t * img,
+                                   const Image_t * original_img,
+                                   const Image_t * overlay_img,
+                                   const Image_t * mask_img,
+                                   int32_t x,
+                                   int32_t y)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t n = 0;
+    uint8_t k = 0;
+    uint8_t c = 0;
+    uint8_t alpha = 0;
+    uint32_t sums[3] = { 0 };
+    uint8_t rgb[3] = { 0 };
+    uint8_t yuv[3] = { 0 };
+
+    for (i = 0; i < img->height; i++) {
+        for (j = 0; j < img->width; j++) {
+            alpha = get_overlay_pixel(overlay_img, mask_img, (int32_t) j - x, (int32_t) i - y, rgb);
+            convert_color_block(&rgb_to_yuv_matrix, &rgb[0], &rgb[1], &rgb[2], &yuv[0], &yuv[1], &yuv[2], 1);
+            CUTS_ASSERT(get_image_row(img, 0, i)[j] == blend_value(yuv[0], alpha, get_image_row(original_img, 0, i)[j]),
+                        "Wrong Y value (%u, %u) at offset (%d, %d)", j, i, x, y);
+        }
+    }
+
+    // Chroma values are composited with the average premultiplied values of the 2x2 blocks
+    for (i = 0; i < img->height; i += 2) {
+        for (j = 0; j < img->width; j += 2) {
+            n = 0;
+            sums[0] = sums[1] = sums[2] = 0;
+            for (k = 0; k < 4; k++) {
+                if (i + k / 2 >= img->height || j + k % 2 >= img->width) continue;
+
+                alpha = get_overlay_pixel(overlay_img, mask_img, (int32_t) (j + k % 2) - x, (int32_t) (i + k / 2) - y,
+                                          rgb);
+                convert_color_block(&rgb_to_yuv_matrix, &rgb[0], &rgb[1], &rgb[2], &yuv[0], &yuv[1], &yuv[2], 1);
+                sums[0] += round_div255(yuv[1] * alpha);
+                sums[1] += round_div255(yuv[2] * alpha);
+                sums[2] += alpha;
+                n++;
+            }
+
+            alpha = (sums[2] + n / 2) / n;
+            for (c = 0; c < 2; c++) {
+                CUTS_ASSERT(get_image_row(img, c + 1, i / 2)[j / 2] ==
+                            (sums[c] + n / 2) / n + round_div255(get_image_row(original_img, c + 1, i / 2)[j / 2] *
+                                                                 (255 - alpha)),
+                            "Wrong chroma value (%u, %u) of plane %d at offset (%d, %d)", j / 2, i / 2, c + 1, x, y);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+
+static char * check_blends (const Image_t * overlay_img, const Image_t * mask_img)
+{
+    uint8_t f = 0;
+    uint8_t k = 0;
+    char * result = NULL;
+    PixelFormat_t formats[3] = { RGB24, RGB565, YUV420p };
+    // Inside, odd offsets, and clipped on every side
+    int32_t offsets[6][2] = { { 10, 4 }, { 3, 7 }, { -20, -3 }, { TEST_WIDTH - 40, TEST_HEIGHT - 5 }, { 0, 0 },
+                              { -OVERLAY_WIDTH + 1, TEST_HEIGHT - 1 } };
+    Image_t * padded_img = NULL;
+    Image_t * original_img = NULL;
+    Image_t img;
+
+    for (f = 0; f < 3; f++) {
+        // Images are views with padded rows, so that strides are taken into account
+        padded_img = create_image(TEST_WIDTH + 6, TEST_HEIGHT + 2, formats[f]);
+        original_img = create_image(TEST_WIDTH, TEST_HEIGHT, formats[f]);
+        CUTS_ASSERT(create_image_view(padded_img, 2, 2, TEST_WIDTH, TEST_HEIGHT, &img), "Could not create view");
+
+        for (k = 0; k < 6; k++) {
+            fill_pseudo_random(original_img, f * 7 + k);
+            CUTS_ASSERT(copy_pixels(original_img, &img), "Could not copy image");
+
+            CUTS_ASSERT(blend_image(&img, overlay_img, mask_img, offsets[k][0], offsets[k][1]),
+                        "Blending onto format %d failed", formats[f]);
+            if (formats[f] == YUV420p) {
+                result = check_YUV420p_blend(&img, original_img, overlay_img, mask_img, offsets[k][0], offsets[k][1]);
+            }
+            else {
+                result = check_rgb_blend(&img, original_img, overlay_img, mask_img, offsets[k][0], offsets[k][1]);
+            }
+            if (result) return result;
+        }
+
+        destroy_image(padded_img);
+        destroy_image(original_img);
+    }
+
+    return NULL;
+}
+
+
+char * test_rgba_blends ()
+{
+    char * result = NULL;
+    Image_t * overlay_img = create_image(OVERLAY_WIDTH, OVERLAY_HEIGHT, RGBA8888);
+
+    fill_pseudo_random(overlay_img, 1);
+    result = check_blends(overlay_img, NULL);
+
+    if (!result) {
+        make_sparse(overlay_img, NULL);
+        result = check_blends(overlay_img, NULL);
+    }
+
+    destroy_image(overlay_img);
+
+    return result;
+}
+
+
+char * test_masked_blends ()
+{
+    char * result = NULL;
+    Image_t * overlay_img = create_image(OVERLAY_WIDTH, OVERLAY_HEIGHT, GRAYSCALE);
+    Image_t * mask_img = create_image(OVERLAY_WIDTH, OVERLAY_HEIGHT, GRAYSCALE);
+
+    fill_pseudo_random(overlay_img, 2);
+    fill_pseudo_random(mask_img, 3);
+    result = check_blends(overlay_img, mask_img);
+
+    if (!result) {
+        make_sparse(overlay_img, mask_img);
+        result = check_blends(overlay_img, mask_img);
+    }
+
+    destroy_image(overlay_img);
+    destroy_image(mask_img);
+
+    return result;
+}
+
+
+char * test_transparent_and_opaque_blends ()
+{
+    uint8_t f = 0;
+    uint32_t i = 0;
+    PixelFormat_t formats[3] = { RGB24, RGB565, YUV420p };
+    Image_t * img = NULL;
+    Image_t * original_img = NULL;
+    Image_t * overlay_img = create_image(TEST_WIDTH, TEST_HEIGHT, GRAYSCALE);
+    Image_t * mask_img = create_image(TEST_WIDTH, TEST_HEIGHT, GRAYSCALE);
+
+    memset(overlay_img->data, 0xc0, TEST_WIDTH * TEST_HEIGHT);
+
+    for (f = 0; f < 3; f++) {
+        img = create_image(TEST_WIDTH, TEST_HEIGHT, formats[f]);
+        original_img = create_image(TEST_WIDTH, TEST_HEIGHT, formats[f]);
+        fill_pseudo_random(original_img, f);
+        CUTS_ASSERT(copy_pixels(original_img, img), "Could not copy image");
+
+        // A transparent overlay leaves the image untouched...
+        memset(mask_img->data, 0, TEST_WIDTH * TEST_HEIGHT);
+        CUTS_ASSERT(blend_image(img, overlay_img, mask_img, 0, 0), "Transparent blend failed");
+        CUTS_ASSERT(!memcmp(img->data, original_img->data, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, formats[f])),
+                    "Transparent overlay changed format %d", formats[f]);
+
+        // ... and an opaque one replaces it
+        memset(mask_img->data, 0xff, TEST_WIDTH * TEST_HEIGHT);
+        CUTS_ASSERT(blend_image(img, overlay_img, mask_img, 0, 0), "Opaque blend failed");
+        for (i = 0; i < get_image_data_size(TEST_WIDTH, TEST_HEIGHT, formats[f]); i++) {
+            if (formats[f] == RGB24) CUTS_ASSERT(img->data[i] == 0xc0, "Opaque overlay did not replace RGB24 pixels");
+            // 0xc0 truncated to 5 and 6 bits
+            if (formats[f] == RGB565) CUTS_ASSERT(img->data[i] == ((i % 2) ? 0xc6 : 0x18), "Opaque overlay did not "
+                                                  "replace RGB565 pixels");
+        }
+        if (formats[f] == YUV420p) {
+            // Gray overlays have neutral chroma
+            CUTS_ASSERT(img->data[0] == 181 && img->data[TEST_WIDTH * TEST_HEIGHT] == 128,
+                        "Opaque overlay did not replace YUV420p pixels");
+        }
+
+        destroy_image(img);
+        destroy_image(original_img);
+    }
+
+    destroy_image(overlay_img);
+    destroy_image(mask_img);
+
+    return NULL;
+}
+
+
+char * test_incorrect_blends ()
+{
+    Image_t * img = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * original_img = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * rgba_img = create_image(OVERLAY_WIDTH, OVERLAY_HEIGHT, RGBA8888);
+    Image_t * gray_img = create_image(OVERLAY_WIDTH, OVERLAY_HEIGHT, GRAYSCALE);
+    Image_t * small_mask_img = create_image(OVERLAY_WIDTH - 1, OVERLAY_HEIGHT, GRAYSCALE);
+    Image_t * yuv444p_img = create_image(TEST_WIDTH, TEST_HEIGHT, YUV444p);
+
+    fill_pseudo_random(original_img, 4);
+    fill_pseudo_random(rgba_img, 5);
+    CUTS_ASSERT(copy_pixels(original_img, img), "Could not copy image");
+
+    CUTS_ASSERT(!blend_image(NULL, rgba_img, NULL, 0, 0), "NULL image should be rejected");
+    CUTS_ASSERT(!blend_image(img, NULL, NULL, 0, 0), "NULL overlay should be rejected");
+    CUTS_ASSERT(!blend_image(yuv444p_img, rgba_img, NULL, 0, 0), "YUV444p images should be rejected");
+    CUTS_ASSERT(!blend_image(img, yuv444p_img, NULL, 0, 0), "YUV444p overlays should be rejected");
+    CUTS_ASSERT(!blend_image(img, rgba_img, gray_img, 0, 0), "Masks of RGBA8888 overlays should be rejected");
+    CUTS_ASSERT(!blend_image(img, gray_img, NULL, 0, 0), "GRAYSCALE overlays without masks should be rejected");
+    CUTS_ASSERT(!blend_image(img, gray_img, rgba_img, 0, 0), "RGBA8888 masks should be rejected");
+    CUTS_ASSERT(!blend_image(img, gray_img, small_mask_img, 0, 0), "Masks of a different size should be rejected");
+
+    // Overlays lying outside of the image are not an error
+    CUTS_ASSERT(blend_image(img, rgba_img, NULL, TEST_WIDTH, 0), "Overlay on the right should be accepted");
+    CUTS_ASSERT(blend_image(img, rgba_img, NULL, 0, -OVERLAY_HEIGHT), "Overlay above should be accepted");
+    CUTS_ASSERT(blend_image(img, rgba_img, NULL, INT32_MIN, INT32_MAX), "Far away overlay should be accepted");
+    CUTS_ASSERT(!memcmp(img->data, original_img->data, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, RGB24)),
+                "Overlays outside of the image changed it");
+
+    destroy_image(img);
+    destroy_image(original_img);
+    destroy_image(rgba_img);
+    destroy_image(gray_img);
+    destroy_image(small_mask_img);
+    destroy_image(yuv444p_img);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_rgba_blends);
+    CUTS_RUN_TEST(test_masked_blends);
+    CUTS_RUN_TEST(test_transparent_and_opaque_blends);
+    CUTS_RUN_TEST(test_incorrect_blends);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
@@ -0,0 +1,266 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+static uint8_t same_images (const Image_t * img1, const Image_t * img2)
+{
+    return !memcmp(img1->data, img2->data, get_image_data_size(img1->width, img1->height, img1->format));
+}
+
+
+char * test_capture_format_layouts ()
+{
+    Image_t view;
+    Image_t * img_nv12 = create_image(TEST_WIDTH, TEST_HEIGHT, NV12);
+    Image_t * img_yuyv = create_image(TEST_WIDTH, TEST_HEIGHT, YUYV);
+
+    CUTS_ASSERT(get_image_data_size(TEST_WIDTH, TEST_HEIGHT, NV12) ==
+                get_image_data_size(TEST_WIDTH, TEST_HEIGHT, YUV420p), "NV12 should be as large as YUV420p");
+    CUTS_ASSERT(get_image_plane_count(NV12) == 2 && get_image_plane_count(NV21) == 2, "NV12 and NV21 have 2 planes");
+    CUTS_ASSERT(get_image_row_size(TEST_WIDTH, NV12, 0) == TEST_WIDTH, "Wrong size of NV12 Y rows");
+    CUTS_ASSERT(get_image_row_size(TEST_WIDTH, NV12, 1) == TEST_WIDTH + 1, "Wrong size of NV12 chroma rows");
+    CUTS_ASSERT(get_image_plane_height(TEST_HEIGHT, NV21, 1) == (TEST_HEIGHT + 1) / 2, "Wrong height of NV21 chroma");
+    CUTS_ASSERT(get_image_plane(img_nv12, 1) == img_nv12->data + TEST_WIDTH * TEST_HEIGHT,
+                "NV12 chroma plane should follow the Y plane");
+
+    // Odd widths are padded to a whole macropixel
+    CUTS_ASSERT(get_image_plane_count(YUYV) == 1 && get_image_plane_count(UYVY) == 1, "YUYV and UYVY are packed");
+    CUTS_ASSERT(get_image_row_size(TEST_WIDTH, UYVY, 0) == (TEST_WIDTH + 1) * 2, "Wrong size of UYVY rows");
+    CUTS_ASSERT(get_image_data_size(TEST_WIDTH, TEST_HEIGHT, YUYV) == (TEST_WIDTH + 1) * 2 * TEST_HEIGHT,
+                "Wrong size of YUYV images");
+
+    // Views must start on a chroma sample
+    CUTS_ASSERT(!create_image_view(img_nv12, 1, 2, 8, 8, &view), "NV12 views should start on an even column");
+    CUTS_ASSERT(!create_image_view(img_nv12, 2, 1, 8, 8, &view), "NV12 views should start on an even row");
+    CUTS_ASSERT(create_image_view(img_nv12, 4, 2, 8, 8, &view), "Could not create NV12 view");
+    CUTS_ASSERT(get_image_row(&view, 1, 0) == get_image_row(img_nv12, 1, 1) + 4, "Wrong NV12 view chroma plane");
+    CUTS_ASSERT(!create_image_view(img_yuyv, 1, 2, 8, 8, &view), "YUYV views should start on an even column");
+    CUTS_ASSERT(create_image_view(img_yuyv, 4, 1, 8, 8, &view), "Could not create YUYV view");
+    CUTS_ASSERT(view.data == get_image_row(img_yuyv, 0, 1) + 8, "Wrong YUYV view");
+
+    destroy_image(img_nv12);
+    destroy_image(img_yuyv);
+
+    return NULL;
+}
+
+
+char * test_semiplanar_conversions ()
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint8_t * uv_row = NULL;
+    Image_t * img_yuv420p = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t * img_nv12 = create_image(TEST_WIDTH, TEST_HEIGHT, NV12);
+    Image_t * img_nv21 = create_image(TEST_WIDTH, TEST_HEIGHT, NV21);
+    Image_t * img_back = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t * img_rgb24 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img_reference = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+
+    fill_pseudo_random(img_yuv420p, 1);
+
+    CUTS_ASSERT(convert_image(img_yuv420p, img_nv12), "YUV420p -> NV12 failed");
+    for (i = 0; i < get_image_plane_height(TEST_HEIGHT, NV12, 1); i++) {
+        uv_row = get_image_row(img_nv12, 1, i);
+
+        for (j = 0; j < (TEST_WIDTH + 1) / 2; j++) {
+            CUTS_ASSERT(uv_row[j * 2] == get_image_row(img_yuv420p, 1, i)[j] &&
+                        uv_row[j * 2 + 1] == get_image_row(img_yuv420p, 2, i)[j],
+                        "Wrong U, V pair (%d, %d) of NV12 image", j, i);
+        }
+    }
+
+    // Both semi-planar formats hold the same samples as YUV420p, so conversions between them are lossless
+    CUTS_ASSERT(convert_image(img_nv12, img_nv21), "NV12 -> NV21 failed");
+    CUTS_ASSERT(convert_image(img_nv21, img_back), "NV21 -> YUV420p failed");
+    CUTS_ASSERT(same_images(img_yuv420p, img_back), "YUV420p -> NV12 -> NV21 -> YUV420p is not lossless");
+    memset(img_nv12->data, 0, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, NV12));
+    CUTS_ASSERT(convert_image(img_nv21, img_nv12), "NV21 -> NV12 failed");
+    CUTS_ASSERT(convert_image(img_nv12, img_back), "NV12 -> YUV420p failed");
+    CUTS_ASSERT(same_images(img_yuv420p, img_back), "NV21 -> NV12 -> YUV420p is not lossless");
+
+    // The dedicated kernels match the YUV420p ones
+    CUTS_ASSERT(convert_image(img_yuv420p, img_reference), "YUV420p -> RGB24 failed");
+    CUTS_ASSERT(convert_image(img_nv12, img_rgb24), "NV12 -> RGB24 failed");
+    CUTS_ASSERT(same_images(img_rgb24, img_reference), "NV12 -> RGB24 differs from YUV420p -> RGB24");
+    memset(img_rgb24->data, 0, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, RGB24));
+    CUTS_ASSERT(convert_image(img_nv21, img_rgb24), "NV21 -> RGB24 failed");
+    CUTS_ASSERT(same_images(img_rgb24, img_reference), "NV21 -> RGB24 differs from YUV420p -> RGB24");
+
+    destroy_image(img_yuv420p);
+    destroy_image(img_nv12);
+    destroy_image(img_nv21);
+    destroy_image(img_back);
+    destroy_image(img_rgb24);
+    destroy_image(img_reference);
+
+    return NULL;
+}
+
+
+static char * check_packed_422_conversions (uint16_t width, PixelFormat_t format)
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t last = 0;
+    uint8_t luma_offset = (format == UYVY);
+    uint8_t * row = NULL;
+    Image_t * img_yuv444p = create_image(width, TEST_HEIGHT, YUV444p);
+    Image_t * img_422 = create_image(width, TEST_HEIGHT, format);
+    Image_t * img_back = create_image(width, TEST_HEIGHT, YUV444p);
+    Image_t * img_rgb565 = create_image(width, TEST_HEIGHT, RGB565);
+    Image_t * img_reference = create_image(width, TEST_HEIGHT, RGB565);
+
+    fill_pseudo_random(img_yuv444p, width + format);
+
+    CUTS_ASSERT(convert_image(img_yuv444p, img_422), "YUV444p -> %d failed", format);
+    for (i = 0; i < TEST_HEIGHT; i++) {
+        row = get_image_row(img_422, 0, i);
+
+        for (j = 0; j < width; j++) {
+            // The last pixel of each pair determines the U and V values, as with YUV420p
+            last = (j % 2 || j + 1 == width) ? j : j + 1;
+            CUTS_ASSERT(row[j * 2 + luma_offset] == get_image_row(img_yuv444p, 0, i)[j] &&
+                        row[(j / 2) * 4 + 1 - luma_offset] == get_image_row(img_yuv444p, 1, i)[last] &&
+                        row[(j / 2) * 4 + 3 - luma_offset] == get_image_row(img_yuv444p, 2, i)[last],
+                        "Wrong pixel (%d, %d) of format %d", j, i, format);
+        }
+    }
+
+    CUTS_ASSERT(convert_image(img_422, img_back), "%d -> YUV444p failed", format);
+    for (i = 0; i < TEST_HEIGHT; i++) {
+        for (j = 0; j < width; j++) {
+            CUTS_ASSERT(get_image_row(img_back, 0, i)[j] == get_image_row(img_yuv444p, 0, i)[j] &&
+                        get_image_row(img_back, 1, i)[j] == get_image_row(img_422, 0, i)[(j / 2) * 4 + 1 - luma_offset],
+                        "Wrong pixel (%d, %d) converted back from format %d", j, i, format);
+        }
+    }
+
+    // The dedicated kernel matches the path through YUV444p
+    CUTS_ASSERT(convert_image(img_back, img_reference), "YUV444p -> RGB565 failed");
+    CUTS_ASSERT(convert_image(img_422, img_rgb565), "%d -> RGB565 failed", format);
+    CUTS_ASSERT(same_images(img_rgb565, img_reference), "%d -> RGB565 differs (width %d)", format, width);
+
+    destroy_image(img_yuv444p);
+    destroy_image(img_422);
+    destroy_image(img_back);
+    destroy_image(img_rgb565);
+    destroy_image(img_reference);
+
+    return NULL;
+}
+
+
+char * test_packed_422_conversions ()
+{
+    char * result = NULL;
+
+    result = check_packed_422_conversions(TEST_WIDTH, YUYV);
+    if (!result) result = check_packed_422_conversions(TEST_WIDTH, UYVY);
+    // Several SIMD blocks per row, with a partial one at the end
+    if (!result) result = check_packed_422_conversions(3 * SIMD_BLOCK_SIZE + 6, YUYV);
+    if (!result) result = check_packed_422_conversions(1, UYVY);
+
+    return result;
+}
+
+
+char * test_packed_422_swaps ()
+{
+    uint32_t i = 0;
+    uint32_t j = 0;
+    Image_t * img_yuyv = create_image(TEST_WIDTH, TEST_HEIGHT, YUYV);
+    Image_t * img_uyvy = create_image(TEST_WIDTH, TEST_HEIGHT, UYVY);
+    Image_t * img_back = create_image(TEST_WIDTH, TEST_HEIGHT, YUYV);
+
+    fill_pseudo_random(img_yuyv, 2);
+
+    CUTS_ASSERT(convert_image(img_yuyv, img_uyvy), "YUYV -> UYVY failed");
+    for (i = 0; i < TEST_HEIGHT; i++) {
+        for (j = 0; j < get_image_row_size(TEST_WIDTH, YUYV, 0); j++) {
+            CUTS_ASSERT(get_image_row(img_uyvy, 0, i)[j] == get_image_row(img_yuyv, 0, i)[j ^ 1],
+                        "Wrong byte %d of row %d of UYVY image", j, i);
+        }
+    }
+
+    CUTS_ASSERT(convert_image(img_uyvy, img_back), "UYVY -> YUYV failed");
+    CUTS_ASSERT(same_images(img_yuyv, img_back), "YUYV -> UYVY -> YUYV is not lossless");
+
+    destroy_image(img_yuyv);
+    destroy_image(img_uyvy);
+    destroy_image(img_back);
+
+    return NULL;
+}
+
+
+char * test_capture_format_flips ()
+{
+    int format = 0;
+    uint16_t width = 0;
+    Image_t * img = NULL;
+    Image_t * copy_img = NULL;
+    Image_t * img_yuv444p = NULL;
+    Image_t * img_flipped = NULL;
+
+    for (format = NV12; format <= UYVY; format++) {
+        for (width = TEST_WIDTH; width <= TEST_WIDTH + 1; width++) {
+            img = create_image(width, TEST_HEIGHT, format);
+            copy_img = create_image(width, TEST_HEIGHT, format);
+            img_yuv444p = create_image(width, TEST_HEIGHT, YUV444p);
+            img_flipped = create_image(width, TEST_HEIGHT, YUV444p);
+            fill_pseudo_random(img, format);
+            memcpy(copy_img->data, img->data, get_image_data_size(width, TEST_HEIGHT, format));
+
+            CUTS_ASSERT(flipY_image(img) && flipY_image(img), "Flip of format %d failed", format);
+            CUTS_ASSERT(same_images(img, copy_img), "Flipping format %d twice changed it (width %d)", format, width);
+
+            // With even widths, chroma samples are mirrored as a whole, so flipping commutes with upsampling
+            if (width % 2 == 0) {
+                CUTS_ASSERT(convert_image(img, img_flipped) && flipY_image(img_flipped), "Reference flip failed");
+                CUTS_ASSERT(flipY_image(img) && convert_image(img, img_yuv444p), "Flip of format %d failed", format);
+                CUTS_ASSERT(same_images(img_yuv444p, img_flipped), "Flip of format %d is wrong", format);
+            }
+
+            destroy_image(img);
+            destroy_image(copy_img);
+            destroy_image(img_yuv444p);
+            destroy_image(img_flipped);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_capture_format_layouts);
+    CUTS_RUN_TEST(test_semiplanar_conversions);
+    CUTS_RUN_TEST(test_packed_422_conversions);
+    CUTS_RUN_TEST(test_packed_422_swaps);
+    CUTS_RUN_TEST(test_capture_format_flips);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
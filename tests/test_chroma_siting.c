@@ -0,0 +1,194 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 133
+#define TEST_HEIGHT 9
+#define TEST_LEVELS 3
+#define TEST_FORMATS 6
+
+
+static const uint8_t simd_levels[TEST_LEVELS] = { SIMD_NONE, SIMD_SSE2, SIMD_NEON };
+
+static const ChromaSiting_t sitings[3] = { CHROMA_SITING_CENTER, CHROMA_SITING_LEFT, CHROMA_SITING_TOP_LEFT };
+
+static const PixelFormat_t formats[TEST_FORMATS] = { YUV444, YUV444p, RGB24, RGB565, RGB8, BGRA8888 };
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+static uint8_t same_images (const Image_t * img1, const Image_t * img2)
+{
+    return !memcmp(img1->data, img2->data, get_image_data_size(img1->width, img1->height, img1->format));
+}
+
+
+// Downsample the chroma planes of a YUV444p image into a YUV420p image, computed independently from the kernels
+static void reference_downsample (Image_t * img_yuv444p, Image_t * img_yuv420p, ChromaSiting_t siting)
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t right = 0;
+    uint32_t bottom = 0;
+    uint8_t k = 0;
+    uint8_t * row0 = NULL;
+    uint8_t * row1 = NULL;
+    uint8_t * out = NULL;
+
+    for (y = 0; y < img_yuv444p->height; y++) {
+        memcpy(get_image_row(img_yuv420p, 0, y), get_image_row(img_yuv444p, 0, y), img_yuv444p->width);
+    }
+
+    for (k = 1; k < 3; k++) {
+        for (y = 0; y < img_yuv444p->height; y += 2) {
+            bottom = (y + 1 < img_yuv444p->height) ? y + 1 : y;
+            row0 = get_image_row(img_yuv444p, k, y);
+            row1 = get_image_row(img_yuv444p, k, bottom);
+            out = get_image_row(img_yuv420p, k, y / 2);
+
+            for (x = 0; x < img_yuv444p->width; x += 2) {
+                right = (x + 1 < img_yuv444p->width) ? x + 1 : x;
+
+                if (siting == CHROMA_SITING_TOP_LEFT) {
+                    out[x / 2] = row0[x];
+                } else if (siting == CHROMA_SITING_LEFT) {
+                    out[x / 2] = (row0[x] + row1[x] + 1) / 2;
+                } else {
+                    out[x / 2] = (row0[x] + row0[right] + row1[x] + row1[right] + 2) / 4;
+                }
+            }
+        }
+    }
+}
+
+
+char * test_chroma_siting_defaults ()
+{
+    Image_t view;
+    Image_t * img = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+
+    CUTS_ASSERT(img->chroma_siting == CHROMA_SITING_CENTER, "New images are not centered");
+
+    img->chroma_siting = CHROMA_SITING_LEFT;
+    CUTS_ASSERT(create_image_view(img, 2, 2, 16, 4, &view) && view.chroma_siting == CHROMA_SITING_LEFT,
+                "View lost its chroma siting");
+
+    destroy_image(img);
+
+    return NULL;
+}
+
+
+char * test_chroma_siting_conversions ()
+{
+    uint8_t f = 0;
+    uint8_t s = 0;
+    uint8_t level = 0;
+    uint8_t all_features = set_simd_features(0xff);
+    Image_t * img_base = NULL;
+    Image_t * img_yuv444p = create_image(TEST_WIDTH, TEST_HEIGHT, YUV444p);
+    Image_t * img_yuv420p = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t * img_reference = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+
+    for (f = 0; f < TEST_FORMATS; f++) {
+        img_base = create_image(TEST_WIDTH, TEST_HEIGHT, formats[f]);
+        fill_pseudo_random(img_base, f + 1);
+
+        // Full-resolution U and V values, downsampled by the reference (converting to the same format does nothing)
+        if (formats[f] == YUV444p) {
+            memcpy(img_yuv444p->data, img_base->data, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, YUV444p));
+        } else {
+            CUTS_ASSERT(convert_image(img_base, img_yuv444p), "Format %d -> YUV444p failed", formats[f]);
+        }
+
+        for (s = 0; s < 3; s++) {
+            reference_downsample(img_yuv444p, img_reference, sitings[s]);
+            img_yuv420p->chroma_siting = sitings[s];
+
+            for (level = 0; level < TEST_LEVELS; level++) {
+                set_simd_features(simd_levels[level]);
+                memset(img_yuv420p->data, 0, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, YUV420p));
+
+                CUTS_ASSERT(convert_image(img_base, img_yuv420p), "Format %d -> YUV420p failed", formats[f]);
+                CUTS_ASSERT(same_images(img_yuv420p, img_reference), "Format %d -> YUV420p with siting %u differs at "
+                            "level 0x%02x", formats[f], sitings[s], simd_levels[level]);
+            }
+        }
+
+        destroy_image(img_base);
+    }
+
+    set_simd_features(all_features);
+
+    destroy_image(img_yuv444p);
+    destroy_image(img_yuv420p);
+    destroy_image(img_reference);
+
+    return NULL;
+}
+
+
+char * test_chroma_siting_propagation ()
+{
+    uint8_t s = 0;
+    ConversionPlan_t plan;
+    Image_t * img_rgb24 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img_yuv420p = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t * img_reference = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t * img_nv12 = create_image(TEST_WIDTH, TEST_HEIGHT, NV12);
+    Image_t * img_nv12_reference = create_image(TEST_WIDTH, TEST_HEIGHT, NV12);
+
+    fill_pseudo_random(img_rgb24, 7);
+
+    for (s = 0; s < 3; s++) {
+        img_reference->chroma_siting = sitings[s];
+        CUTS_ASSERT(convert_image(img_rgb24, img_reference), "RGB24 -> YUV420p failed");
+
+        // Plans take the siting from their template
+        memset(img_yuv420p->data, 0, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, YUV420p));
+        img_yuv420p->chroma_siting = sitings[s];
+        CUTS_ASSERT(init_conversion_plan(&plan, img_rgb24, img_yuv420p, NULL) &&
+                    execute_conversion_plan(&plan, img_rgb24->data, img_yuv420p->data),
+                    "Plan RGB24 -> YUV420p failed");
+        CUTS_ASSERT(same_images(img_yuv420p, img_reference), "Plan with siting %u differs", sitings[s]);
+
+        // Conversions through an intermediate YUV420p format downsample with the siting of the YUV side
+        img_nv12->chroma_siting = sitings[s];
+        CUTS_ASSERT(convert_image(img_reference, img_nv12_reference) && convert_image(img_rgb24, img_nv12),
+                    "RGB24 -> NV12 failed");
+        CUTS_ASSERT(same_images(img_nv12, img_nv12_reference), "RGB24 -> NV12 with siting %u differs", sitings[s]);
+    }
+
+    destroy_image(img_rgb24);
+    destroy_image(img_yuv420p);
+    destroy_image(img_reference);
+    destroy_image(img_nv12);
+    destroy_image(img_nv12_reference);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_chroma_siting_defaults);
+    CUTS_RUN_TEST(test_chroma_siting_conversions);
+    CUTS_RUN_TEST(test_chroma_siting_propagation);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
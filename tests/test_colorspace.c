@@ -0,0 +1,267 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 133
+#define TEST_HEIGHT 9
+#define TEST_LEVELS 4
+
+
+static Colorspace_t colorspaces[3][2];
+
+static const uint8_t simd_levels[TEST_LEVELS] = { SIMD_NONE, SIMD_SSE2, SIMD_SSE2 | SIMD_AVX2, SIMD_NEON };
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+static uint8_t same_images (const Image_t * img1, const Image_t * img2)
+{
+    return !memcmp(img1->data, img2->data, get_image_data_size(img1->width, img1->height, img1->format));
+}
+
+
+char * test_colorspace_init ()
+{
+    int standard = 0;
+    int range = 0;
+    Colorspace_t colorspace;
+
+    for (standard = COLOR_BT601; standard <= COLOR_BT2020; standard++) {
+        for (range = COLOR_LIMITED_RANGE; range <= COLOR_FULL_RANGE; range++) {
+            CUTS_ASSERT(init_colorspace(&colorspaces[standard][range], standard, range),
+                        "Could not initialize color space (%d, %d)", standard, range);
+        }
+    }
+
+    CUTS_ASSERT(!init_colorspace(NULL, COLOR_BT601, COLOR_LIMITED_RANGE), "NULL color space was initialized");
+    CUTS_ASSERT(!init_colorspace(&colorspace, COLOR_BT2020 + 1, COLOR_LIMITED_RANGE), "Unknown standard was accepted");
+    CUTS_ASSERT(!init_colorspace(&colorspace, COLOR_BT601, COLOR_FULL_RANGE + 1), "Unknown range was accepted");
+
+    // No color space is BT.601 limited range
+    CUTS_ASSERT(get_yuv_to_rgb_matrix(NULL) == &yuv_to_rgb_matrix && get_rgb_to_yuv_matrix(NULL) == &rgb_to_yuv_matrix,
+                "Default matrices are not BT.601 limited range");
+    CUTS_ASSERT(!memcmp(colorspaces[COLOR_BT601][COLOR_LIMITED_RANGE].yuv_to_rgb.coef, yuv_to_rgb_matrix.coef,
+                        sizeof(yuv_to_rgb_matrix.coef)) &&
+                !memcmp(colorspaces[COLOR_BT601][COLOR_LIMITED_RANGE].rgb_to_yuv.coef, rgb_to_yuv_matrix.coef,
+                        sizeof(rgb_to_yuv_matrix.coef)),
+                "BT.601 limited range differs from the default matrices");
+
+    return NULL;
+}
+
+
+char * test_colorspace_tables ()
+{
+    int standard = 0;
+    int range = 0;
+    uint8_t direction = 0;
+    uint8_t level = 0;
+    uint8_t all_features = set_simd_features(0xff);
+    uint32_t a = 0;
+    uint32_t b = 0;
+    uint32_t c = 0;
+    uint32_t k = 0;
+    uint8_t in[3][SIMD_BLOCK_SIZE];
+    uint8_t expected[3][SIMD_BLOCK_SIZE];
+    uint8_t out[3][SIMD_BLOCK_SIZE];
+    ColorMatrix_t matrix;
+    const ColorMatrix_t * table_matrix = NULL;
+
+    for (standard = COLOR_BT601; standard <= COLOR_BT2020; standard++) {
+        for (range = COLOR_LIMITED_RANGE; range <= COLOR_FULL_RANGE; range++) {
+            for (direction = 0; direction < 2; direction++) {
+                table_matrix = direction ? &colorspaces[standard][range].rgb_to_yuv
+                                         : &colorspaces[standard][range].yuv_to_rgb;
+                CUTS_ASSERT(table_matrix->terms, "Color space (%d, %d) has no tables", standard, range);
+
+                // Same matrix, computed with multiplications
+                matrix = *table_matrix;
+                matrix.terms = NULL;
+
+                for (a = 0; a < 256; a += 3) {
+                    for (b = 0; b < 256; b += 5) {
+                        for (c = 0; c < 256; c += SIMD_BLOCK_SIZE) {
+                            for (k = 0; k < SIMD_BLOCK_SIZE; k++) {
+                                in[0][k] = a;
+                                in[1][k] = b;
+                                in[2][k] = c + k;
+                            }
+
+                            set_simd_features(SIMD_NONE);
+                            convert_color_block(&matrix, in[0], in[1], in[2], expected[0], expected[1], expected[2],
+                                                SIMD_BLOCK_SIZE);
+
+                            // The tables give the same results as the multiplications, and as every SIMD kernel
+                            for (level = 0; level < TEST_LEVELS; level++) {
+                                set_simd_features(simd_levels[level]);
+                                convert_color_block(table_matrix, in[0], in[1], in[2], out[0], out[1], out[2],
+                                                    SIMD_BLOCK_SIZE);
+                                CUTS_ASSERT(!memcmp(out, expected, sizeof(out)),
+                                            "Tables of (%d, %d, %d) differ for (%d, %d, %d..) at level 0x%02x",
+                                            standard, range, direction, a, b, c, simd_levels[level]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    set_simd_features(all_features);
+
+    return NULL;
+}
+
+
+char * test_colorspace_values ()
+{
+    int standard = 0;
+    int range = 0;
+    uint32_t x = 0;
+    int32_t diff = 0;
+    uint8_t * rgb = NULL;
+    uint8_t * back = NULL;
+    uint8_t gray = 0;
+    uint8_t max_y = 0;
+    Image_t * img_rgb24 = create_image(256, 1, RGB24);
+    Image_t * img_yuv444p = create_image(256, 1, YUV444p);
+    Image_t * img_back = create_image(256, 1, RGB24);
+
+    for (standard = COLOR_BT601; standard <= COLOR_BT2020; standard++) {
+        for (range = COLOR_LIMITED_RANGE; range <= COLOR_FULL_RANGE; range++) {
+            img_yuv444p->colorspace = &colorspaces[standard][range];
+            max_y = (range == COLOR_FULL_RANGE) ? 255 : 235;
+
+            // Grays map to neutral chroma values, and white to the highest Y value
+            for (x = 0; x < 256; x++) {
+                memset(get_image_row(img_rgb24, 0, 0) + x * 3, x, 3);
+            }
+            CUTS_ASSERT(convert_image(img_rgb24, img_yuv444p), "RGB24 -> YUV444p failed");
+            for (x = 0; x < 256; x++) {
+                CUTS_ASSERT(get_image_row(img_yuv444p, 1, 0)[x] == 128 && get_image_row(img_yuv444p, 2, 0)[x] == 128,
+                            "Gray %d is not neutral in (%d, %d)", x, standard, range);
+            }
+            CUTS_ASSERT(get_image_row(img_yuv444p, 0, 0)[255] == max_y, "White has Y value %d in (%d, %d)",
+                        get_image_row(img_yuv444p, 0, 0)[255], standard, range);
+
+            // Round trips of arbitrary colors stay close to the original colors
+            fill_pseudo_random(img_rgb24, standard * 2 + range + 1);
+            CUTS_ASSERT(convert_image(img_rgb24, img_yuv444p) && convert_image(img_yuv444p, img_back),
+                        "RGB24 -> YUV444p -> RGB24 failed");
+            rgb = get_image_row(img_rgb24, 0, 0);
+            back = get_image_row(img_back, 0, 0);
+            for (x = 0; x < 256 * 3; x++) {
+                diff = rgb[x] - back[x];
+                CUTS_ASSERT(diff >= -4 && diff <= 4, "Round trip of (%d, %d) is off by %d", standard, range, diff);
+            }
+        }
+    }
+
+    // Y values are read according to the range: full-range mid-gray is not limited-range mid-gray
+    gray = 128;
+    memset(img_yuv444p->data, gray, get_image_data_size(256, 1, YUV444p));
+    img_yuv444p->colorspace = &colorspaces[COLOR_BT709][COLOR_FULL_RANGE];
+    CUTS_ASSERT(convert_image(img_yuv444p, img_back) && get_image_row(img_back, 0, 0)[0] == gray,
+                "Full-range gray is not preserved");
+    img_yuv444p->colorspace = &colorspaces[COLOR_BT709][COLOR_LIMITED_RANGE];
+    CUTS_ASSERT(convert_image(img_yuv444p, img_back) && get_image_row(img_back, 0, 0)[0] == 130,
+                "Limited-range gray is not expanded");
+
+    destroy_image(img_rgb24);
+    destroy_image(img_yuv444p);
+    destroy_image(img_back);
+
+    return NULL;
+}
+
+
+char * test_colorspace_conversions ()
+{
+    int standard = 0;
+    int range = 0;
+    uint8_t level = 0;
+    uint8_t all_features = set_simd_features(0xff);
+    ConversionPlan_t plan;
+    Image_t view;
+    Image_t * img_yuv420p = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t * img_rgb24 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img_rgb565 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB565);
+    Image_t * img_reference = create_image(TEST_WIDTH, TEST_HEIGHT, RGB565);
+    Image_t * img_nv12 = create_image(TEST_WIDTH, TEST_HEIGHT, NV12);
+
+    fill_pseudo_random(img_yuv420p, 1);
+
+    // No color space gives the same results as BT.601 limited range
+    CUTS_ASSERT(convert_image(img_yuv420p, img_reference), "YUV420p -> RGB565 failed");
+    img_yuv420p->colorspace = &colorspaces[COLOR_BT601][COLOR_LIMITED_RANGE];
+    CUTS_ASSERT(convert_image(img_yuv420p, img_rgb565) && same_images(img_rgb565, img_reference),
+                "BT.601 limited range differs from no color space");
+
+    for (standard = COLOR_BT601; standard <= COLOR_BT2020; standard++) {
+        for (range = COLOR_LIMITED_RANGE; range <= COLOR_FULL_RANGE; range++) {
+            img_yuv420p->colorspace = &colorspaces[standard][range];
+
+            // The direct YUV420p -> RGB565 kernels match the conversion through RGB24, whatever the SIMD level
+            for (level = 0; level < TEST_LEVELS; level++) {
+                set_simd_features(simd_levels[level]);
+                CUTS_ASSERT(convert_image(img_yuv420p, img_rgb24) && convert_image(img_rgb24, img_reference),
+                            "YUV420p -> RGB24 -> RGB565 failed");
+                CUTS_ASSERT(convert_image(img_yuv420p, img_rgb565), "YUV420p -> RGB565 failed");
+                CUTS_ASSERT(same_images(img_rgb565, img_reference),
+                            "YUV420p -> RGB565 of (%d, %d) differs at level 0x%02x", standard, range,
+                            simd_levels[level]);
+            }
+
+            // Views, intermediate formats and plans keep the color space
+            CUTS_ASSERT(create_image_view(img_yuv420p, 0, 0, TEST_WIDTH, TEST_HEIGHT, &view) &&
+                        view.colorspace == img_yuv420p->colorspace, "View lost its color space");
+
+            img_nv12->colorspace = img_yuv420p->colorspace;
+            CUTS_ASSERT(convert_image(img_yuv420p, img_nv12) && convert_image(img_nv12, img_rgb565),
+                        "YUV420p -> NV12 -> RGB565 failed");
+            CUTS_ASSERT(same_images(img_rgb565, img_reference), "NV12 -> RGB565 of (%d, %d) differs", standard, range);
+
+            memset(img_rgb565->data, 0, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, RGB565));
+            CUTS_ASSERT(init_conversion_plan(&plan, img_yuv420p, img_rgb565, NULL) &&
+                        execute_conversion_plan(&plan, img_yuv420p->data, img_rgb565->data),
+                        "Plan YUV420p -> RGB565 failed");
+            CUTS_ASSERT(same_images(img_rgb565, img_reference), "Plan of (%d, %d) differs", standard, range);
+        }
+    }
+
+    set_simd_features(all_features);
+
+    destroy_image(img_yuv420p);
+    destroy_image(img_rgb24);
+    destroy_image(img_rgb565);
+    destroy_image(img_reference);
+    destroy_image(img_nv12);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_colorspace_init);
+    CUTS_RUN_TEST(test_colorspace_tables);
+    CUTS_RUN_TEST(test_colorspace_values);
+    CUTS_RUN_TEST(test_colorspace_conversions);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
@@ -0,0 +1,175 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+// Compare `convert_and_flip_image()` (or its parallel version) against a conversion followed by separate flips
+static char * check_fused_conversions (uint16_t width, uint16_t height, uint8_t flip_flags, uint8_t parallel)
+{
+    int base = 0;
+    int target = 0;
+    uint8_t result = 0;
+    Image_t * base_img = NULL;
+    Image_t * separate_img = NULL;
+    Image_t * fused_img = NULL;
+
+    for (base = 0; base < ASCII; base++) {
+        for (target = 0; target <= ASCII; target++) {
+            base_img = create_image(width, height, base);
+            separate_img = create_image(width, height, target);
+            fused_img = create_image(width, height, target);
+            fill_pseudo_random(base_img, base * 11 + target);
+            // Same-format conversions leave the converted image untouched, so both images must start out identical
+            fill_pseudo_random(separate_img, target);
+            fill_pseudo_random(fused_img, target);
+
+            CUTS_ASSERT(convert_image(base_img, separate_img), "Conversion %d -> %d failed", base, target);
+            if (flip_flags & FLIP_X_AXIS) CUTS_ASSERT(flipX_image(separate_img), "X flip of format %d failed", target);
+            if (flip_flags & FLIP_Y_AXIS) CUTS_ASSERT(flipY_image(separate_img), "Y flip of format %d failed", target);
+
+            result = parallel ? convert_and_flip_image_parallel(base_img, fused_img, flip_flags, NULL)
+                              : convert_and_flip_image(base_img, fused_img, flip_flags);
+            CUTS_ASSERT(result, "Fused conversion %d -> %d (flags 0x%x) failed", base, target, flip_flags);
+            CUTS_ASSERT(!memcmp(separate_img->data, fused_img->data, get_image_data_size(width, height, target)),
+                        "Fused conversion %d -> %d (%dx%d, flags 0x%x) differs", base, target, width, height,
+                        flip_flags);
+
+            destroy_image(base_img);
+            destroy_image(separate_img);
+            destroy_image(fused_img);
+        }
+    }
+
+    return NULL;
+}
+
+
+static char * check_all_flags (uint16_t width, uint16_t height, uint8_t parallel)
+{
+    uint8_t flip_flags = 0;
+    char * result = NULL;
+
+    for (flip_flags = 0; flip_flags <= (FLIP_X_AXIS | FLIP_Y_AXIS) && !result; flip_flags++) {
+        result = check_fused_conversions(width, height, flip_flags, parallel);
+    }
+
+    return result;
+}
+
+
+char * test_reversed_image_view ()
+{
+    int format = 0;
+    int plane = 0;
+    int i = 0;
+    Image_t * img = NULL;
+    Image_t view;
+    Image_t twice_reversed_view;
+
+    CUTS_ASSERT(!create_reversed_image_view(NULL, &view), "NULL parent should be rejected");
+
+    for (format = 0; format <= ASCII; format++) {
+        img = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+        CUTS_ASSERT(!create_reversed_image_view(img, NULL), "NULL view should be rejected");
+        CUTS_ASSERT(create_reversed_image_view(img, &view), "Could not create reversed view of format %d", format);
+        CUTS_ASSERT(create_reversed_image_view(&view, &twice_reversed_view),
+                    "Could not reverse reversed view of format %d", format);
+
+        for (plane = 0; plane < get_image_plane_count(format); plane++) {
+            for (i = 0; i < get_image_plane_height(TEST_HEIGHT, format, plane); i++) {
+                CUTS_ASSERT(get_image_row(&view, plane, i) ==
+                            get_image_row(img, plane, get_image_plane_height(TEST_HEIGHT, format, plane) - 1 - i),
+                            "Wrong row %d of plane %d of reversed view of format %d", i, plane, format);
+                CUTS_ASSERT(get_image_row(&twice_reversed_view, plane, i) == get_image_row(img, plane, i),
+                            "Wrong row %d of plane %d of twice reversed view of format %d", i, plane, format);
+            }
+        }
+
+        destroy_image(img);
+    }
+
+    return NULL;
+}
+
+
+char * test_fused_conversions ()
+{
+    char * result = NULL;
+
+    result = check_all_flags(TEST_WIDTH, TEST_HEIGHT, 0);
+    if (!result) result = check_all_flags(TEST_WIDTH + 1, TEST_HEIGHT + 1, 0);
+    if (!result) result = check_all_flags(5, 1, 0);
+
+    return result;
+}
+
+
+char * test_parallel_fused_conversions ()
+{
+    char * result = NULL;
+
+    // Without LIBUIMG_THREADS, the pool cannot be started and the operations run on the calling thread
+    init_thread_pool(4);
+
+    result = check_all_flags(TEST_WIDTH, TEST_HEIGHT, 1);
+    if (!result) result = check_all_flags(TEST_WIDTH + 1, TEST_HEIGHT + 1, 1);
+    if (!result) result = check_all_flags(5, 1, 1);
+
+    shutdown_thread_pool();
+
+    return result;
+}
+
+
+char * test_incorrect_fused_conversions ()
+{
+    Image_t * img1 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img2 = create_image(TEST_WIDTH, TEST_HEIGHT + 1, YUV420p);
+    Image_t * img3 = create_image(TEST_WIDTH, TEST_HEIGHT, ASCII);
+
+    CUTS_ASSERT(!convert_and_flip_image(NULL, img1, FLIP_X_AXIS), "NULL base image should be rejected");
+    CUTS_ASSERT(!convert_and_flip_image(img1, NULL, FLIP_X_AXIS), "NULL converted image should be rejected");
+    CUTS_ASSERT(!convert_and_flip_image(img1, img2, FLIP_X_AXIS), "Different dimensions should be rejected");
+    CUTS_ASSERT(!convert_and_flip_image(img3, img1, FLIP_X_AXIS), "Conversions from ASCII should be rejected");
+    CUTS_ASSERT(!convert_and_flip_image(img1, img3, 0x04), "Unknown flags should be rejected");
+    CUTS_ASSERT(!convert_and_flip_image_parallel(img1, img2, FLIP_Y_AXIS, NULL),
+                "Different dimensions should be rejected");
+    CUTS_ASSERT(!convert_and_flip_image_parallel(img1, img3, 0x04, NULL), "Unknown flags should be rejected");
+
+    destroy_image(img1);
+    destroy_image(img2);
+    destroy_image(img3);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_reversed_image_view);
+    CUTS_RUN_TEST(test_fused_conversions);
+    CUTS_RUN_TEST(test_parallel_fused_conversions);
+    CUTS_RUN_TEST(test_incorrect_fused_conversions);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
@@ -2751,10 +2751,37 @@ char * test_image_conversion_GRAYSCALE_to_ASCII ()
 }
 
 
+char * test_quantization_LUTs ()
+{
+    int i = 0;
+    const char * levels = " .,-+:/=$%#@";
+
+    for (i = 0; i < 256; i++) {
+        CUTS_ASSERT(rescale_8bit_to_5bit_LUT[i] == rescale_color(i, 0, 255, 0, 32), "Wrong 5-bit value for %d", i);
+        CUTS_ASSERT(rescale_8bit_to_6bit_LUT[i] == rescale_color(i, 0, 255, 0, 64), "Wrong 6-bit value for %d", i);
+        CUTS_ASSERT(rescale_8bit_to_3bit_LUT[i] == rescale_color(i, 0, 255, 0, 8), "Wrong 3-bit value for %d", i);
+        CUTS_ASSERT(rescale_8bit_to_2bit_LUT[i] == rescale_color(i, 0, 255, 0, 4), "Wrong 2-bit value for %d", i);
+        CUTS_ASSERT(y_to_ascii(i) == levels[rescale_color(i, 0, 255, 0, 11)], "Wrong ASCII value for %d", i);
+    }
+
+    for (i = 0; i < 32; i++) {
+        CUTS_ASSERT(rescale_5bit_to_3bit_LUT[i] == rescale_color(i, 0, 32, 0, 8), "Wrong 5->3-bit value for %d", i);
+        CUTS_ASSERT(rescale_5bit_to_2bit_LUT[i] == rescale_color(i, 0, 32, 0, 4), "Wrong 5->2-bit value for %d", i);
+    }
+
+    for (i = 0; i < 64; i++) {
+        CUTS_ASSERT(rescale_6bit_to_3bit_LUT[i] == rescale_color(i, 0, 64, 0, 8), "Wrong 6->3-bit value for %d", i);
+    }
+
+    return NULL;
+}
+
+
 char * all_tests ()
 {
     CUTS_START();
 
+    CUTS_RUN_TEST(test_quantization_LUTs);
     CUTS_RUN_TEST(test_image_conversion_YUV444_to_YUV444p);
     CUTS_RUN_TEST(test_image_conversion_YUV444_to_YUV420p);
     CUTS_RUN_TEST(test_image_conversion_YUV444_to_RGB24);
@@ -155,6 +155,83 @@ char * test_ASCII_image_creation ()
 }
 
 
+char * test_aligned_image_creation ()
+{
+    int format = 0;
+    uint8_t k = 0;
+    uint8_t flags = 0;
+    uint16_t width = 250;
+    uint16_t height = 127;
+    uint32_t alignment = 0;
+    Image_t * img = NULL;
+    Image_t * converted_img = NULL;
+    Image_t * reference_img = NULL;
+
+    for (format = 0; format <= ASCII; format++) {
+        for (flags = 0; flags <= (IMAGE_ALIGN_ROWS | IMAGE_HUGE_PAGES); flags++) {
+            for (alignment = 16; alignment <= 4096; alignment *= 4) {
+                img = create_aligned_image(width, height, format, alignment, flags);
+                CUTS_ASSERT(img, "Aligned image creation failed (format %d, flags %d)", format, flags);
+                CUTS_ASSERT(img->width == width && img->height == height && img->format == (PixelFormat_t) format,
+                            "Aligned image has wrong dimensions or format");
+
+                for (k = 0; k < get_image_plane_count(format); k++) {
+                    CUTS_ASSERT((uintptr_t) get_image_plane(img, k) % alignment == 0,
+                                "Plane %d is not aligned on %d bytes (format %d)", k, alignment, format);
+                    CUTS_ASSERT(!(flags & IMAGE_ALIGN_ROWS) || get_image_stride(img, k) % alignment == 0,
+                                "Rows of plane %d are not aligned on %d bytes (format %d)", k, alignment, format);
+                    // The last row of every plane must be writable
+                    memset(get_image_row(img, k, get_image_plane_height(height, format, k) - 1), 0xff,
+                           get_image_row_size(width, format, k));
+                }
+
+                destroy_aligned_image(img);
+            }
+        }
+    }
+
+    // Aligned images work like any other image, and default to IMAGE_DEFAULT_ALIGNMENT
+    img = create_aligned_image(width, height, YUV420p, 0, IMAGE_ALIGN_ROWS);
+    converted_img = create_aligned_image(width, height, RGB24, 0, IMAGE_ALIGN_ROWS);
+    reference_img = create_image(width, height, RGB24);
+    CUTS_ASSERT((uintptr_t) get_image_plane(img, 2) % IMAGE_DEFAULT_ALIGNMENT == 0, "Plane is not aligned");
+
+    for (k = 0; k < 3; k++) {
+        memset(get_image_plane(img, k), 0x40 * (k + 1),
+               (uint32_t) get_image_stride(img, k) * get_image_plane_height(height, YUV420p, k));
+    }
+    CUTS_ASSERT(convert_image(img, converted_img), "Conversion of aligned image failed");
+    CUTS_ASSERT(convert_image(img, reference_img), "Conversion of aligned image failed");
+    for (k = 0; k < height; k++) {
+        CUTS_ASSERT(!memcmp(get_image_row(converted_img, 0, k), get_image_row(reference_img, 0, k), width * 3),
+                    "Conversion into an aligned image differs on row %d", k);
+    }
+
+    destroy_aligned_image(img);
+    destroy_aligned_image(converted_img);
+    destroy_image(reference_img);
+
+    CUTS_ASSERT(!create_aligned_image(width, height, RGB24, 48, 0), "Alignments must be powers of 2");
+
+    return NULL;
+}
+
+
+char * test_huge_page_image_creation ()
+{
+    // Large enough for huge pages (whether the system actually provides them or not)
+    Image_t * img = create_aligned_image(3840, 2160, YUV420p, 0, IMAGE_HUGE_PAGES);
+
+    CUTS_ASSERT(img, "Huge page image creation failed");
+    memset(img->data, 0x80, get_image_data_size(3840, 2160, YUV420p));
+    CUTS_ASSERT(img->data[get_image_data_size(3840, 2160, YUV420p) - 1] == 0x80, "Huge page image is not writable");
+
+    destroy_aligned_image(img);
+
+    return NULL;
+}
+
+
 char * all_tests ()
 {
     CUTS_START();
@@ -167,6 +244,8 @@ char * all_tests ()
     CUTS_RUN_TEST(test_RGB8_image_creation);
     CUTS_RUN_TEST(test_GRAYSCALE_image_creation);
     CUTS_RUN_TEST(test_ASCII_image_creation);
+    CUTS_RUN_TEST(test_aligned_image_creation);
+    CUTS_RUN_TEST(test_huge_page_image_creation);
 
     return NULL;
 }
@@ -0,0 +1,151 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+#define TEST_CAPACITY 4
+#define TEST_ARENA_SIZE (256 * 1024)
+
+
+// The memory of the pools
+static uint8_t arena[TEST_ARENA_SIZE];
+static uint8_t other_arena[TEST_ARENA_SIZE];
+
+
+char * test_pool_acquire_release ()
+{
+    int format = 0;
+    uint16_t i = 0;
+    uint16_t j = 0;
+    ImagePool_t pool;
+    Image_t * images[TEST_CAPACITY] = { NULL };
+
+    for (format = 0; format <= ASCII; format++) {
+        CUTS_ASSERT(init_image_pool(&pool, TEST_WIDTH, TEST_HEIGHT, format, TEST_CAPACITY, arena),
+                    "Could not create pool of format %d", format);
+        CUTS_ASSERT(pool.free_count == TEST_CAPACITY, "Expected %d free images, got %d", TEST_CAPACITY,
+                    pool.free_count);
+
+        for (i = 0; i < TEST_CAPACITY; i++) {
+            images[i] = acquire_pooled_image(&pool);
+            CUTS_ASSERT(images[i], "Could not acquire image %d", i);
+            CUTS_ASSERT(images[i]->width == TEST_WIDTH && images[i]->height == TEST_HEIGHT &&
+                        images[i]->format == (PixelFormat_t) format,
+                        "Wrong image dimensions or format");
+            CUTS_ASSERT((uintptr_t) images[i] % 8 == 0 && (uintptr_t) images[i]->data % 8 == 0,
+                        "Pooled images should be aligned on 8 bytes");
+
+            // Pixel data of different images must not overlap
+            memset(images[i]->data, i, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, format));
+        }
+
+        CUTS_ASSERT(!acquire_pooled_image(&pool), "Empty pool should not hand out images");
+        CUTS_ASSERT(pool.free_count == 0, "Expected no free images, got %d", pool.free_count);
+
+        for (i = 0; i < TEST_CAPACITY; i++) {
+            for (j = 0; j < get_image_data_size(TEST_WIDTH, TEST_HEIGHT, format); j++) {
+                CUTS_ASSERT(images[i]->data[j] == i, "Pixel data of image %d was overwritten", i);
+            }
+        }
+
+        // Released images are handed out again, without their pixel data being cleared
+        CUTS_ASSERT(release_pooled_image(&pool, images[2]), "Could not release image");
+        CUTS_ASSERT(acquire_pooled_image(&pool) == images[2], "Released image should be handed out again");
+        CUTS_ASSERT(images[2]->data[0] == 2, "Pixel data should not be cleared");
+
+        for (i = 0; i < TEST_CAPACITY; i++) {
+            CUTS_ASSERT(release_pooled_image(&pool, images[i]), "Could not release image %d", i);
+        }
+        CUTS_ASSERT(pool.free_count == TEST_CAPACITY, "Expected %d free images, got %d", TEST_CAPACITY,
+                    pool.free_count);
+
+        destroy_image_pool(&pool);
+    }
+
+    return NULL;
+}
+
+
+char * test_pool_static_memory ()
+{
+    static uint8_t memory[4096];
+    uint32_t memory_size = get_image_pool_memory_size(16, 8, YUV420p, 3);
+    ImagePool_t pool;
+    Image_t * img = NULL;
+    Image_t * rgb_img = create_image(16, 8, RGB24);
+
+    CUTS_ASSERT(memory_size > 0 && memory_size <= sizeof(memory), "Unexpected pool memory size %d", memory_size);
+
+    // Unaligned memory supplied by the caller
+    CUTS_ASSERT(init_image_pool(&pool, 16, 8, YUV420p, 3, memory + 1), "Could not create pool");
+    img = acquire_pooled_image(&pool);
+    CUTS_ASSERT(img, "Could not acquire image");
+    CUTS_ASSERT((uint8_t *) img >= memory + 1 && img->data + get_image_data_size(16, 8, YUV420p) <=
+                memory + 1 + memory_size, "Pooled image lies outside of the supplied memory");
+
+    // Pooled images work like any other image
+    memset(img->data, 0x80, get_image_data_size(16, 8, YUV420p));
+    CUTS_ASSERT(convert_image(img, rgb_img), "Conversion of pooled image failed");
+    CUTS_ASSERT(release_pooled_image(&pool, img), "Could not release image");
+
+    destroy_image_pool(&pool);
+    destroy_image(rgb_img);
+
+    return NULL;
+}
+
+
+char * test_incorrect_pools ()
+{
+    ImagePool_t pool;
+    ImagePool_t other_pool;
+    Image_t * img = NULL;
+    Image_t * other_img = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+
+    CUTS_ASSERT(!init_image_pool(NULL, TEST_WIDTH, TEST_HEIGHT, RGB24, 2, arena), "NULL pool should be rejected");
+    CUTS_ASSERT(!init_image_pool(&pool, TEST_WIDTH, TEST_HEIGHT, RGB24, 2, NULL), "NULL memory should be rejected");
+    CUTS_ASSERT(!init_image_pool(&pool, TEST_WIDTH, TEST_HEIGHT, RGB24, 0, arena), "Empty pool should be rejected");
+    CUTS_ASSERT(!init_image_pool(&pool, 0, TEST_HEIGHT, RGB24, 2, arena), "Null width should be rejected");
+    CUTS_ASSERT(!init_image_pool(&pool, 4096, 4096, RGB24, 100, arena), "Oversized pool should be rejected");
+    CUTS_ASSERT(!get_image_pool_memory_size(4096, 4096, RGB24, 100), "Oversized pool should have no size");
+    // A single 65535x21846 RGB24 image takes more than 4 GB, which must not wrap around to a small size
+    CUTS_ASSERT(!get_image_pool_memory_size(65535, 21846, RGB24, 2), "Oversized images should have no size");
+    CUTS_ASSERT(!init_image_pool(&pool, 65535, 21846, RGB24, 2, arena), "Oversized images should be rejected");
+
+    CUTS_ASSERT(init_image_pool(&pool, TEST_WIDTH, TEST_HEIGHT, RGB24, 2, arena), "Could not create pool");
+    CUTS_ASSERT(init_image_pool(&other_pool, TEST_WIDTH, TEST_HEIGHT, RGB24, 2, other_arena), "Could not create pool");
+    img = acquire_pooled_image(&pool);
+
+    CUTS_ASSERT(!release_pooled_image(&pool, NULL), "NULL image should be rejected");
+    CUTS_ASSERT(!release_pooled_image(&pool, other_img), "Image from outside the pool should be rejected");
+    CUTS_ASSERT(!release_pooled_image(&other_pool, img), "Image from another pool should be rejected");
+    CUTS_ASSERT(!release_pooled_image(&pool, (Image_t *) ((uint8_t *) img + 8)),
+                "Pointer inside of a pooled image should be rejected");
+    CUTS_ASSERT(release_pooled_image(&pool, img), "Could not release image");
+    CUTS_ASSERT(!release_pooled_image(&pool, img), "Image released twice should be rejected");
+    CUTS_ASSERT(pool.free_count == 2, "Expected 2 free images, got %d", pool.free_count);
+    CUTS_ASSERT(!acquire_pooled_image(NULL), "NULL pool should not hand out images");
+
+    destroy_image_pool(&pool);
+    destroy_image_pool(&other_pool);
+    destroy_image(other_img);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_pool_acquire_release);
+    CUTS_RUN_TEST(test_pool_static_memory);
+    CUTS_RUN_TEST(test_incorrect_pools);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
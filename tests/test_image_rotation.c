@@ -0,0 +1,274 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+static uint8_t get_test_pixel_size (PixelFormat_t format, uint8_t plane)
+{
+    if (format == YUV444 || format == RGB24 || format == BGR24) return 3;
+    if (format == RGBA8888 || format == BGRA8888 || format == XRGB8888) return 4;
+    if (format == RGB565) return 2;
+    if ((format == NV12 || format == NV21) && plane) return 2;
+    return 1;
+}
+
+
+// Compare a YUYV or UYVY image rotated by 180 degrees against the base image: Y values are mirrored one pixel at a
+// time, and U, V values one macropixel at a time
+static char * check_rotated_422_pixels (const Image_t * base_img, const Image_t * rotated_img)
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint8_t luma_offset = (base_img->format == UYVY);
+    uint32_t width = base_img->width;
+    uint32_t height = base_img->height;
+    uint32_t macropixels = (width + 1) / 2;
+    const uint8_t * row = NULL;
+    const uint8_t * base_row = NULL;
+
+    for (y = 0; y < height; y++) {
+        row = get_image_row(rotated_img, 0, y);
+        base_row = get_image_row(base_img, 0, height - 1 - y);
+
+        for (x = 0; x < width; x++) {
+            CUTS_ASSERT(row[x * 2 + luma_offset] == base_row[(width - 1 - x) * 2 + luma_offset],
+                        "Wrong Y value (%d, %d) (format %d, 180 degrees)", x, y, base_img->format);
+        }
+
+        for (x = 0; x < macropixels; x++) {
+            CUTS_ASSERT(row[x * 4 + 1 - luma_offset] == base_row[(macropixels - 1 - x) * 4 + 1 - luma_offset] &&
+                        row[x * 4 + 3 - luma_offset] == base_row[(macropixels - 1 - x) * 4 + 3 - luma_offset],
+                        "Wrong U, V values (%d, %d) (format %d, 180 degrees)", x, y, base_img->format);
+        }
+    }
+
+    return NULL;
+}
+
+
+// Compare a rotated image against the base image, pixel by pixel
+static char * check_rotated_pixels (const Image_t * base_img, const Image_t * rotated_img, uint16_t degrees)
+{
+    uint8_t plane = 0;
+    uint8_t pixel_size = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t src_x = 0;
+    uint32_t src_y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t base_width = 0;
+    uint32_t base_height = 0;
+
+    if (base_img->format == YUYV || base_img->format == UYVY) return check_rotated_422_pixels(base_img, rotated_img);
+
+    for (plane = 0; plane < get_image_plane_count(base_img->format); plane++) {
+        pixel_size = get_test_pixel_size(base_img->format, plane);
+        width = get_image_row_size(rotated_img->width, rotated_img->format, plane) / pixel_size;
+        height = get_image_plane_height(rotated_img->height, rotated_img->format, plane);
+        base_width = get_image_row_size(base_img->width, base_img->format, plane) / pixel_size;
+        base_height = get_image_plane_height(base_img->height, base_img->format, plane);
+
+        for (y = 0; y < height; y++) {
+            for (x = 0; x < width; x++) {
+                if (degrees == 90) {
+                    src_x = y;
+                    src_y = base_height - 1 - x;
+                } else if (degrees == 180) {
+                    src_x = base_width - 1 - x;
+                    src_y = base_height - 1 - y;
+                } else {
+                    src_x = base_width - 1 - y;
+                    src_y = x;
+                }
+
+                CUTS_ASSERT(!memcmp(get_image_row(rotated_img, plane, y) + x * pixel_size,
+                                    get_image_row(base_img, plane, src_y) + src_x * pixel_size,
+                                    pixel_size),
+                            "Wrong pixel (%d, %d) of plane %d (format %d, %d degrees)",
+                            x, y, plane, base_img->format, degrees);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+
+static char * check_rotations (uint16_t width, uint16_t height)
+{
+    int format = 0;
+    uint16_t degrees = 0;
+    char * result = NULL;
+    Image_t * base_img = NULL;
+    Image_t * rotated_img = NULL;
+
+    for (format = 0; format <= ASCII; format++) {
+        for (degrees = 90; degrees <= 270; degrees += 90) {
+            base_img = create_image(width, height, format);
+            rotated_img = (degrees == 180) ? create_image(width, height, format)
+                                           : create_image(height, width, format);
+            fill_pseudo_random(base_img, format * 360 + degrees);
+
+            if ((format == YUYV || format == UYVY) && degrees != 180) {
+                CUTS_ASSERT(!rotate_image(base_img, rotated_img, degrees),
+                            "Rotation of format %d by %d degrees should be rejected", format, degrees);
+                destroy_image(base_img);
+                destroy_image(rotated_img);
+                continue;
+            }
+
+            CUTS_ASSERT(rotate_image(base_img, rotated_img, degrees),
+                        "Rotation of format %d by %d degrees (%dx%d) failed", format, degrees, width, height);
+            result = check_rotated_pixels(base_img, rotated_img, degrees);
+            if (result) return result;
+
+            destroy_image(base_img);
+            destroy_image(rotated_img);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_image_rotations ()
+{
+    char * result = NULL;
+
+    result = check_rotations(TEST_WIDTH, TEST_HEIGHT);
+    // Several tiles, with partial tiles and partial SIMD blocks on the edges
+    if (!result) result = check_rotations(4 * ROTATION_TILE_SIZE + 5, 2 * ROTATION_TILE_SIZE + 3);
+    if (!result) result = check_rotations(64, 48);
+    if (!result) result = check_rotations(1, 7);
+
+    return result;
+}
+
+
+char * test_in_place_rotation ()
+{
+    int format = 0;
+    Image_t * img = NULL;
+    Image_t * copy_img = NULL;
+    char * result = NULL;
+
+    for (format = 0; format <= ASCII; format++) {
+        img = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+        copy_img = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+        fill_pseudo_random(img, format);
+        memcpy(copy_img->data, img->data, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, format));
+
+        CUTS_ASSERT(rotate_image(img, img, 180), "In-place rotation of format %d failed", format);
+        result = check_rotated_pixels(copy_img, img, 180);
+        if (result) return result;
+
+        destroy_image(img);
+        destroy_image(copy_img);
+    }
+
+    return NULL;
+}
+
+
+char * test_view_rotation ()
+{
+    Image_t * parent_img = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t * rotated_parent_img = create_image(TEST_HEIGHT, TEST_WIDTH, YUV420p);
+    Image_t base_view;
+    Image_t rotated_view;
+    char * result = NULL;
+
+    fill_pseudo_random(parent_img, 7);
+    memset(rotated_parent_img->data, 0, get_image_data_size(TEST_HEIGHT, TEST_WIDTH, YUV420p));
+
+    // Rotate a region of an image into a region of another image (both with padded rows)
+    CUTS_ASSERT(create_image_view(parent_img, 4, 2, 20, 16, &base_view), "Could not create base view");
+    CUTS_ASSERT(create_image_view(rotated_parent_img, 2, 6, 16, 20, &rotated_view), "Could not create rotated view");
+    CUTS_ASSERT(rotate_image(&base_view, &rotated_view, 90), "Rotation of view failed");
+    result = check_rotated_pixels(&base_view, &rotated_view, 90);
+    if (result) return result;
+    CUTS_ASSERT(rotated_parent_img->data[0] == 0, "Rotation wrote outside of the view");
+
+    destroy_image(parent_img);
+    destroy_image(rotated_parent_img);
+
+    return NULL;
+}
+
+
+char * test_full_turn ()
+{
+    Image_t * img = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * copy_img = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * rotated_img = create_image(TEST_HEIGHT, TEST_WIDTH, RGB24);
+
+    fill_pseudo_random(img, 1);
+    memcpy(copy_img->data, img->data, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, RGB24));
+
+    CUTS_ASSERT(rotate_image(img, rotated_img, 90), "Rotation by 90 degrees failed");
+    CUTS_ASSERT(rotate_image(rotated_img, img, 270), "Rotation by 270 degrees failed");
+    CUTS_ASSERT(!memcmp(img->data, copy_img->data, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, RGB24)),
+                "Rotations by 90 then 270 degrees should give back the original image");
+
+    destroy_image(img);
+    destroy_image(copy_img);
+    destroy_image(rotated_img);
+
+    return NULL;
+}
+
+
+char * test_incorrect_rotations ()
+{
+    Image_t * img1 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img2 = create_image(TEST_HEIGHT, TEST_WIDTH, RGB24);
+    Image_t * img3 = create_image(TEST_HEIGHT, TEST_WIDTH, GRAYSCALE);
+
+    CUTS_ASSERT(!rotate_image(NULL, img2, 90), "NULL base image should be rejected");
+    CUTS_ASSERT(!rotate_image(img1, NULL, 90), "NULL rotated image should be rejected");
+    CUTS_ASSERT(!rotate_image(img1, img3, 90), "Different formats should be rejected");
+    CUTS_ASSERT(!rotate_image(img1, img2, 45), "Angles other than 90, 180 and 270 degrees should be rejected");
+    CUTS_ASSERT(!rotate_image(img1, img2, 180), "Different dimensions should be rejected for 180 degrees");
+    CUTS_ASSERT(!rotate_image(img1, img1, 270), "Different dimensions should be rejected for 270 degrees");
+    CUTS_ASSERT(!rotate90_plane(img1, img2, 1, 3), "Out-of-range planes should be rejected");
+    CUTS_ASSERT(!rotate180_plane(img1, img1, 0, 0), "Null pixel sizes should be rejected");
+
+    destroy_image(img1);
+    destroy_image(img2);
+    destroy_image(img3);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_image_rotations);
+    CUTS_RUN_TEST(test_in_place_rotation);
+    CUTS_RUN_TEST(test_view_rotation);
+    CUTS_RUN_TEST(test_full_turn);
+    CUTS_RUN_TEST(test_incorrect_rotations);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
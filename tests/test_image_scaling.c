@@ -0,0 +1,438 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+
+#define ABS(x) ((x) < 0 ? -(x) : (x))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+
+// Scale an image with a buffer of the right size
+static uint8_t scale_test_image (Image_t * base_img, Image_t * scaled_img, ScaleFilter_t filter)
+{
+    uint8_t * buffer = create_buffer(get_scale_buffer_size(base_img->width, base_img->height, scaled_img->width,
+                                                           scaled_img->height, base_img->format, filter));
+    uint8_t result = 0;
+
+    if (!buffer) return 0;
+    result = scale_image(base_img, scaled_img, filter, buffer);
+    destroy_buffer(buffer);
+
+    return result;
+}
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+    uint8_t * row = NULL;
+    uint8_t luma_offset = (img->format == UYVY);
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+
+    // The padding pixel of odd-width YUYV and UYVY rows repeats the last pixel, as written by libuimg
+    if ((img->format == YUYV || img->format == UYVY) && img->width % 2) {
+        for (i = 0; i < img->height; i++) {
+            row = get_image_row(img, 0, i);
+            row[img->width * 2 + luma_offset] = row[(img->width - 1) * 2 + luma_offset];
+        }
+    }
+}
+
+
+// Check a YUYV or UYVY image scaled with `SCALE_NEAREST`: every Y value is that of the base pixel under its center, and
+// every pair of pixels has the U and V values of the base pixel under the center of its last pixel
+static char * check_nearest_422_pixels (const Image_t * base_img, const Image_t * scaled_img)
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t src_x = 0;
+    uint32_t last = 0;
+    uint8_t luma_offset = (base_img->format == UYVY);
+    const uint8_t * row = NULL;
+    const uint8_t * base_row = NULL;
+
+    for (y = 0; y < scaled_img->height; y++) {
+        row = get_image_row(scaled_img, 0, y);
+        base_row = get_image_row(base_img, 0, (2 * y + 1) * base_img->height / (2 * scaled_img->height));
+
+        for (x = 0; x < scaled_img->width; x++) {
+            src_x = (2 * x + 1) * base_img->width / (2 * scaled_img->width);
+            CUTS_ASSERT(row[x * 2 + luma_offset] == base_row[src_x * 2 + luma_offset],
+                        "Wrong Y value (%d, %d) (format %d)", x, y, base_img->format);
+        }
+
+        for (x = 0; x < scaled_img->width; x += 2) {
+            last = (x + 1 < scaled_img->width) ? x + 1 : x;
+            src_x = (2 * last + 1) * base_img->width / (2 * scaled_img->width);
+            CUTS_ASSERT(row[x * 2 + 1 - luma_offset] == base_row[(src_x / 2) * 4 + 1 - luma_offset] &&
+                        row[x * 2 + 3 - luma_offset] == base_row[(src_x / 2) * 4 + 3 - luma_offset],
+                        "Wrong U, V values (%d, %d) (format %d)", x, y, base_img->format);
+        }
+    }
+
+    return NULL;
+}
+
+
+// Weight of base pixel `j` in scaled pixel `i`, computed in floating point
+static double get_reference_weight (ScaleFilter_t filter, uint16_t base_size, uint16_t scaled_size, int i, int j)
+{
+    double position = 0;
+    double low = 0;
+    double high = 0;
+
+    if (filter == SCALE_BILINEAR) {
+        position = (i + 0.5) * base_size / scaled_size - 0.5;
+        if (position < 0) position = 0;
+        if (position > base_size - 1) position = base_size - 1;
+
+        return (ABS(position - j) < 1) ? 1 - ABS(position - j) : 0;
+    }
+
+    // Overlap of both pixels, relative to the size of the scaled pixel
+    low = MAX((double) i * base_size, (double) j * scaled_size);
+    high = MIN((double) (i + 1) * base_size, (double) (j + 1) * scaled_size);
+
+    return (high > low) ? (high - low) / base_size : 0;
+}
+
+
+// Compare a scaled grayscale image against a floating-point reference, allowing off-by-one differences
+static char * check_scaled_pixels (const Image_t * base_img, const Image_t * scaled_img, ScaleFilter_t filter)
+{
+    int x = 0;
+    int y = 0;
+    int i = 0;
+    int j = 0;
+    double weight = 0;
+    double expected = 0;
+    uint8_t value = 0;
+
+    for (y = 0; y < scaled_img->height; y++) {
+        for (x = 0; x < scaled_img->width; x++) {
+            expected = 0;
+
+            for (j = 0; j < base_img->height; j++) {
+                weight = get_reference_weight(filter, base_img->height, scaled_img->height, y, j);
+                if (!weight) continue;
+
+                for (i = 0; i < base_img->width; i++) {
+                    expected += weight * get_reference_weight(filter, base_img->width, scaled_img->width, x, i) *
+                                get_image_row(base_img, 0, j)[i];
+                }
+            }
+
+            value = get_image_row(scaled_img, 0, y)[x];
+            CUTS_ASSERT(ABS(value - expected) <= 1,
+                        "Wrong pixel (%d, %d) (filter %d, %dx%d -> %dx%d): expected %.2f, got %d",
+                        x, y, filter, base_img->width, base_img->height, scaled_img->width, scaled_img->height,
+                        expected, value);
+        }
+    }
+
+    return NULL;
+}
+
+
+static char * check_scaling (uint16_t base_width, uint16_t base_height, uint16_t scaled_width, uint16_t scaled_height)
+{
+    ScaleFilter_t filter = SCALE_BILINEAR;
+    char * result = NULL;
+    Image_t * base_img = create_image(base_width, base_height, GRAYSCALE);
+    Image_t * scaled_img = create_image(scaled_width, scaled_height, GRAYSCALE);
+
+    fill_pseudo_random(base_img, base_width * base_height + scaled_width);
+
+    for (filter = SCALE_BILINEAR; filter <= SCALE_AREA; filter++) {
+        CUTS_ASSERT(scale_test_image(base_img, scaled_img, filter), "Scaling with filter %d failed", filter);
+        result = check_scaled_pixels(base_img, scaled_img, filter);
+        if (result) return result;
+    }
+
+    destroy_image(base_img);
+    destroy_image(scaled_img);
+
+    return NULL;
+}
+
+
+char * test_filtered_scaling ()
+{
+    char * result = NULL;
+
+    result = check_scaling(TEST_WIDTH, TEST_HEIGHT, 16, 9);
+    if (!result) result = check_scaling(TEST_WIDTH, TEST_HEIGHT, 80, 50);
+    if (!result) result = check_scaling(TEST_WIDTH, TEST_HEIGHT, 12, 40);
+    if (!result) result = check_scaling(64, 48, 7, 5);
+    if (!result) result = check_scaling(5, 3, 1, 1);
+    if (!result) result = check_scaling(1, 1, 9, 4);
+
+    return result;
+}
+
+
+char * test_nearest_scaling ()
+{
+    int format = 0;
+    uint8_t plane = 0;
+    uint8_t pixel_size = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t base_width = 0;
+    uint32_t base_height = 0;
+    char * result = NULL;
+    Image_t * base_img = NULL;
+    Image_t * scaled_img = NULL;
+
+    // Every scaled pixel is a copy of the base pixel under its center
+    for (format = 0; format <= ASCII; format++) {
+        base_img = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+        scaled_img = create_image(50, 12, format);
+        fill_pseudo_random(base_img, format);
+
+        CUTS_ASSERT(scale_test_image(base_img, scaled_img, SCALE_NEAREST), "Scaling of format %d failed", format);
+
+        if (format == YUYV || format == UYVY) {
+            result = check_nearest_422_pixels(base_img, scaled_img);
+            if (result) return result;
+        }
+
+        for (plane = 0; plane < get_image_plane_count(format) && format != YUYV && format != UYVY; plane++) {
+            // The U, V pairs of NV12 and NV21 are picked together
+            pixel_size = ((format == NV12 || format == NV21) && plane) ? 2 : get_image_row_size(1, format, 0);
+            width = get_image_row_size(scaled_img->width, format, plane) / pixel_size;
+            height = get_image_plane_height(scaled_img->height, format, plane);
+            base_width = get_image_row_size(base_img->width, format, plane) / pixel_size;
+            base_height = get_image_plane_height(base_img->height, format, plane);
+
+            for (y = 0; y < height; y++) {
+                for (x = 0; x < width; x++) {
+                    CUTS_ASSERT(!memcmp(get_image_row(scaled_img, plane, y) + x * pixel_size,
+                                        get_image_row(base_img, plane, (2 * y + 1) * base_height / (2 * height)) +
+                                        (2 * x + 1) * base_width / (2 * width) * pixel_size,
+                                        pixel_size),
+                                "Wrong pixel (%d, %d) of plane %d (format %d)", x, y, plane, format);
+                }
+            }
+        }
+
+        destroy_image(base_img);
+        destroy_image(scaled_img);
+    }
+
+    return NULL;
+}
+
+
+char * test_identity_scaling ()
+{
+    int format = 0;
+    ScaleFilter_t filter = SCALE_NEAREST;
+    uint32_t data_size = 0;
+    Image_t * base_img = NULL;
+    Image_t * scaled_img = NULL;
+
+    // Scaling to the same dimensions leaves every pixel as is, whatever the format and filter
+    for (format = 0; format <= ASCII; format++) {
+        for (filter = SCALE_NEAREST; filter <= SCALE_AREA; filter++) {
+            data_size = get_image_data_size(TEST_WIDTH, TEST_HEIGHT, format);
+            base_img = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+            scaled_img = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+            fill_pseudo_random(base_img, format + filter);
+
+            CUTS_ASSERT(scale_test_image(base_img, scaled_img, filter), "Scaling of format %d failed", format);
+            CUTS_ASSERT(!memcmp(base_img->data, scaled_img->data, data_size),
+                        "Identity scaling changed the pixels (format %d, filter %d)", format, filter);
+
+            destroy_image(base_img);
+            destroy_image(scaled_img);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_constant_scaling ()
+{
+    int format = 0;
+    ScaleFilter_t filter = SCALE_NEAREST;
+    uint32_t i = 0;
+    Image_t * base_img = NULL;
+    Image_t * scaled_img = NULL;
+    uint8_t value = 0;
+
+    // A uniform image stays uniform, including packed formats (0xb5 is a valid pixel in every format)
+    for (format = 0; format <= ASCII; format++) {
+        for (filter = SCALE_NEAREST; filter <= SCALE_AREA; filter++) {
+            base_img = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+            scaled_img = create_image(TEST_HEIGHT, 11, format);
+            value = 0xb5;
+            memset(base_img->data, value, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, format));
+
+            CUTS_ASSERT(scale_test_image(base_img, scaled_img, filter), "Scaling of format %d failed", format);
+            for (i = 0; i < get_image_data_size(TEST_HEIGHT, 11, format); i++) {
+                CUTS_ASSERT(scaled_img->data[i] == value, "Uniform image changed (format %d, filter %d)",
+                            format, filter);
+            }
+
+            destroy_image(base_img);
+            destroy_image(scaled_img);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_area_downscaling ()
+{
+    uint8_t base_data[4 * 2] = { 0, 10, 20, 30, 40, 50, 60, 70 };
+    uint8_t scaled_data[2 * 1] = { 0 };
+    Image_t base_img;
+    Image_t scaled_img;
+
+    init_image(&base_img, 4, 2, GRAYSCALE, base_data, NULL);
+    init_image(&scaled_img, 2, 1, GRAYSCALE, scaled_data, NULL);
+
+    // Every scaled pixel is the average of the 2x2 block of base pixels it covers
+    CUTS_ASSERT(scale_test_image(&base_img, &scaled_img, SCALE_AREA), "Area scaling failed");
+    CUTS_ASSERT(scaled_data[0] == 25 && scaled_data[1] == 45,
+                "Expected averages 25 and 45, got %d and %d", scaled_data[0], scaled_data[1]);
+
+    return NULL;
+}
+
+
+char * test_scaling_buffer ()
+{
+    int format = 0;
+    uint32_t buffer_size = 0;
+    uint32_t data_size = 0;
+    uint8_t * buffer = NULL;
+    Image_t * base_img = NULL;
+    Image_t * scaled_img = NULL;
+    Image_t * reference_img = NULL;
+
+    // An uninitialized buffer gives the same result as a zeroed one, and can be reused across frames
+    for (format = 0; format <= ASCII; format++) {
+        base_img = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+        scaled_img = create_image(20, 30, format);
+        reference_img = create_image(20, 30, format);
+        data_size = get_image_data_size(20, 30, format);
+        buffer_size = get_scale_buffer_size(TEST_WIDTH, TEST_HEIGHT, 20, 30, format, SCALE_AREA);
+        buffer = malloc(buffer_size);
+        CUTS_ASSERT(buffer_size > 0 && buffer, "Could not allocate scaling buffer");
+
+        fill_pseudo_random(base_img, format);
+        CUTS_ASSERT(scale_test_image(base_img, reference_img, SCALE_AREA), "Scaling of format %d failed", format);
+        CUTS_ASSERT(scale_image(base_img, scaled_img, SCALE_AREA, buffer), "Scaling of format %d failed", format);
+        CUTS_ASSERT(!memcmp(scaled_img->data, reference_img->data, data_size),
+                    "Scaling with an uninitialized buffer differs (format %d)", format);
+
+        fill_pseudo_random(base_img, format + 1);
+        CUTS_ASSERT(scale_test_image(base_img, reference_img, SCALE_AREA), "Scaling of format %d failed", format);
+        CUTS_ASSERT(scale_image(base_img, scaled_img, SCALE_AREA, buffer), "Scaling of format %d failed", format);
+        CUTS_ASSERT(!memcmp(scaled_img->data, reference_img->data, data_size),
+                    "Scaling with a reused buffer differs (format %d)", format);
+
+        free(buffer);
+        destroy_image(base_img);
+        destroy_image(scaled_img);
+        destroy_image(reference_img);
+    }
+
+    return NULL;
+}
+
+
+char * test_view_scaling ()
+{
+    Image_t * parent_img = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t * copy_img = create_image(20, 16, YUV420p);
+    Image_t * scaled_img = create_image(9, 7, YUV420p);
+    Image_t * reference_img = create_image(9, 7, YUV420p);
+    Image_t view;
+    uint8_t plane = 0;
+    uint16_t y = 0;
+
+    fill_pseudo_random(parent_img, 3);
+    CUTS_ASSERT(create_image_view(parent_img, 4, 2, 20, 16, &view), "Could not create view");
+
+    // Scaling a view gives the same result as scaling a copy of it
+    for (plane = 0; plane < 3; plane++) {
+        for (y = 0; y < get_image_plane_height(16, YUV420p, plane); y++) {
+            memcpy(get_image_row(copy_img, plane, y), get_image_row(&view, plane, y),
+                   get_image_row_size(20, YUV420p, plane));
+        }
+    }
+
+    CUTS_ASSERT(scale_test_image(&view, scaled_img, SCALE_BILINEAR), "Scaling of view failed");
+    CUTS_ASSERT(scale_test_image(copy_img, reference_img, SCALE_BILINEAR), "Scaling of copy failed");
+    CUTS_ASSERT(!memcmp(scaled_img->data, reference_img->data, get_image_data_size(9, 7, YUV420p)),
+                "Scaling a view differs from scaling a copy of it");
+
+    destroy_image(parent_img);
+    destroy_image(copy_img);
+    destroy_image(scaled_img);
+    destroy_image(reference_img);
+
+    return NULL;
+}
+
+
+char * test_incorrect_scaling ()
+{
+    Image_t * img1 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img2 = create_image(10, 10, RGB24);
+    Image_t * img3 = create_image(10, 10, GRAYSCALE);
+    uint8_t empty_data[1] = { 0 };
+    Image_t empty_img;
+    static uint8_t buffer[65536];
+
+    init_image(&empty_img, 0, 0, GRAYSCALE, empty_data, NULL);
+
+    CUTS_ASSERT(!scale_image(NULL, img2, SCALE_BILINEAR, buffer), "NULL base image should be rejected");
+    CUTS_ASSERT(!scale_image(img1, NULL, SCALE_BILINEAR, buffer), "NULL scaled image should be rejected");
+    CUTS_ASSERT(!scale_image(img1, img2, SCALE_BILINEAR, NULL), "NULL buffer should be rejected");
+    CUTS_ASSERT(!scale_image(img1, img3, SCALE_BILINEAR, buffer), "Different formats should be rejected");
+    CUTS_ASSERT(!scale_image(img1, img2, SCALE_AREA + 1, buffer), "Unknown filters should be rejected");
+    CUTS_ASSERT(!scale_image(&empty_img, img3, SCALE_BILINEAR, buffer), "Empty base images should be rejected");
+    CUTS_ASSERT(scale_image(img3, &empty_img, SCALE_BILINEAR, buffer), "Empty scaled images should be accepted");
+
+    destroy_image(img1);
+    destroy_image(img2);
+    destroy_image(img3);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_filtered_scaling);
+    CUTS_RUN_TEST(test_nearest_scaling);
+    CUTS_RUN_TEST(test_identity_scaling);
+    CUTS_RUN_TEST(test_constant_scaling);
+    CUTS_RUN_TEST(test_area_downscaling);
+    CUTS_RUN_TEST(test_scaling_buffer);
+    CUTS_RUN_TEST(test_view_scaling);
+    CUTS_RUN_TEST(test_incorrect_scaling);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
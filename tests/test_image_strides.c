@@ -0,0 +1,301 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+// Extra bytes at the end of every row of the padded images
+#define TEST_PADDING 11
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    int plane = 0;
+    int i = 0;
+    int j = 0;
+    uint8_t * row = NULL;
+
+    for (plane = 0; plane < get_image_plane_count(img->format); plane++) {
+        for (i = 0; i < get_image_plane_height(img->height, img->format, plane); i++) {
+            row = get_image_row(img, plane, i);
+            for (j = 0; j < (int) get_image_row_size(img->width, img->format, plane); j++) {
+                seed = seed * 1103515245 + 12345;
+                row[j] = seed >> 16;
+            }
+        }
+    }
+}
+
+
+static void copy_pixels (Image_t * src, Image_t * dst)
+{
+    int plane = 0;
+    int i = 0;
+
+    for (plane = 0; plane < get_image_plane_count(src->format); plane++) {
+        for (i = 0; i < get_image_plane_height(src->height, src->format, plane); i++) {
+            memcpy(get_image_row(dst, plane, i),
+                   get_image_row(src, plane, i),
+                   get_image_row_size(src->width, src->format, plane));
+        }
+    }
+}
+
+
+static int same_pixels (Image_t * img1, Image_t * img2)
+{
+    int plane = 0;
+    int i = 0;
+
+    for (plane = 0; plane < get_image_plane_count(img1->format); plane++) {
+        for (i = 0; i < get_image_plane_height(img1->height, img1->format, plane); i++) {
+            if (memcmp(get_image_row(img1, plane, i),
+                       get_image_row(img2, plane, i),
+                       get_image_row_size(img1->width, img1->format, plane))) return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+// Create an image whose rows are padded, with planes stored in reverse order to make sure plane pointers are honored
+static Image_t * create_padded_image (uint16_t width, uint16_t height, PixelFormat_t format, uint8_t ** buffer)
+{
+    int plane = 0;
+    int planes = get_image_plane_count(format);
+    int32_t strides[3] = { 0, 0, 0 };
+    uint32_t offset = 0;
+    uint32_t size = 0;
+    Image_t * img = calloc(1, sizeof(Image_t));
+
+    for (plane = 0; plane < planes; plane++) {
+        strides[plane] = get_image_row_size(width, format, plane) + TEST_PADDING;
+        size += strides[plane] * get_image_plane_height(height, format, plane);
+    }
+
+    *buffer = malloc(size);
+    memset(*buffer, 0xcd, size);
+
+    init_image(img, width, height, format, *buffer, strides);
+
+    for (plane = planes - 1; plane >= 0; plane--) {
+        img->planes[plane] = *buffer + offset;
+        offset += strides[plane] * get_image_plane_height(height, format, plane);
+    }
+    img->data = img->planes[0];
+
+    return img;
+}
+
+
+char * test_init_image ()
+{
+    uint8_t data[TEST_WIDTH * TEST_HEIGHT * 3] = { 0 };
+    int32_t strides[3] = { 64, 32, 32 };
+    int32_t bad_strides[3] = { TEST_WIDTH - 1, 0, 0 };
+    Image_t img;
+
+    CUTS_ASSERT(!init_image(NULL, TEST_WIDTH, TEST_HEIGHT, RGB24, data, NULL), "NULL image should be rejected");
+    CUTS_ASSERT(!init_image(&img, TEST_WIDTH, TEST_HEIGHT, RGB24, NULL, NULL), "NULL data should be rejected");
+    CUTS_ASSERT(!init_image(&img, TEST_WIDTH, TEST_HEIGHT, GRAYSCALE, data, bad_strides),
+                "Stride smaller than a row should be rejected");
+
+    // Packed image
+    CUTS_ASSERT(init_image(&img, TEST_WIDTH, TEST_HEIGHT, YUV444p, data, NULL), "Packed YUV444p init failed");
+    CUTS_ASSERT(get_image_stride(&img, 1) == TEST_WIDTH, "Wrong packed YUV444p stride");
+    CUTS_ASSERT(get_image_plane(&img, 2) == &data[TEST_WIDTH * TEST_HEIGHT * 2], "Wrong packed YUV444p V plane");
+
+    CUTS_ASSERT(init_image(&img, TEST_WIDTH, TEST_HEIGHT, YUV420p, data, NULL), "Packed YUV420p init failed");
+    CUTS_ASSERT(get_image_stride(&img, 1) == (TEST_WIDTH + 1) / 2, "Wrong packed YUV420p chroma stride");
+    CUTS_ASSERT(get_image_plane(&img, 2) == &data[TEST_WIDTH * TEST_HEIGHT +
+                                                  ((TEST_WIDTH + 1) / 2) * ((TEST_HEIGHT + 1) / 2)],
+                "Wrong packed YUV420p V plane");
+    CUTS_ASSERT(get_image_row(&img, 1, 3) == get_image_plane(&img, 1) + 3 * ((TEST_WIDTH + 1) / 2),
+                "Wrong packed YUV420p U row");
+
+    // Padded image
+    CUTS_ASSERT(init_image(&img, 20, 10, YUV420p, data, strides), "Padded YUV420p init failed");
+    CUTS_ASSERT(get_image_stride(&img, 0) == 64, "Wrong padded Y stride");
+    CUTS_ASSERT(get_image_plane(&img, 1) == &data[64 * 10], "Wrong padded U plane");
+    CUTS_ASSERT(get_image_plane(&img, 2) == &data[64 * 10 + 32 * 5], "Wrong padded V plane");
+    CUTS_ASSERT(get_image_row(&img, 0, 2) == &data[128], "Wrong padded Y row");
+
+    return NULL;
+}
+
+
+char * test_image_view ()
+{
+    Image_t * parent = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t view;
+    Image_t nested_view;
+
+    CUTS_ASSERT(parent, "Could not create parent image");
+
+    CUTS_ASSERT(!create_image_view(NULL, 0, 0, 1, 1, &view), "NULL parent should be rejected");
+    CUTS_ASSERT(!create_image_view(parent, 0, 0, 1, 1, NULL), "NULL view should be rejected");
+    CUTS_ASSERT(!create_image_view(parent, 2, 0, TEST_WIDTH - 1, 1, &view), "Out-of-bounds view should be rejected");
+    CUTS_ASSERT(!create_image_view(parent, 0, 2, 1, TEST_HEIGHT - 1, &view), "Out-of-bounds view should be rejected");
+    CUTS_ASSERT(!create_image_view(parent, 1, 0, 2, 2, &view), "Odd YUV420p view position should be rejected");
+
+    CUTS_ASSERT(create_image_view(parent, 4, 6, 9, 7, &view), "Could not create view");
+    CUTS_ASSERT(view.width == 9 && view.height == 7 && view.format == YUV420p, "Wrong view geometry");
+    CUTS_ASSERT(get_image_row(&view, 0, 0) == get_image_row(parent, 0, 6) + 4, "Wrong view Y plane");
+    CUTS_ASSERT(get_image_row(&view, 1, 1) == get_image_row(parent, 1, 4) + 2, "Wrong view U plane");
+    CUTS_ASSERT(get_image_row(&view, 2, 0) == get_image_row(parent, 2, 3) + 2, "Wrong view V plane");
+    CUTS_ASSERT(get_image_stride(&view, 0) == TEST_WIDTH, "Wrong view stride");
+
+    // Views of views are relative to their parent view
+    CUTS_ASSERT(create_image_view(&view, 2, 2, 4, 4, &nested_view), "Could not create nested view");
+    CUTS_ASSERT(get_image_row(&nested_view, 0, 0) == get_image_row(parent, 0, 8) + 6, "Wrong nested view Y plane");
+
+    destroy_image(parent);
+
+    return NULL;
+}
+
+
+char * test_strided_conversions ()
+{
+    int base = 0;
+    int target = 0;
+    uint8_t * base_buffer = NULL;
+    uint8_t * target_buffer = NULL;
+    Image_t * packed_base = NULL;
+    Image_t * packed_target = NULL;
+    Image_t * padded_base = NULL;
+    Image_t * padded_target = NULL;
+
+    for (base = 0; base < ASCII; base++) {
+        for (target = 0; target <= ASCII; target++) {
+            if (!conversion_function_LUT[base][target]) continue;
+
+            packed_base = create_image(TEST_WIDTH, TEST_HEIGHT, base);
+            packed_target = create_image(TEST_WIDTH, TEST_HEIGHT, target);
+            padded_base = create_padded_image(TEST_WIDTH, TEST_HEIGHT, base, &base_buffer);
+            padded_target = create_padded_image(TEST_WIDTH, TEST_HEIGHT, target, &target_buffer);
+
+            fill_pseudo_random(packed_base, base * 31 + target);
+            copy_pixels(packed_base, padded_base);
+
+            CUTS_ASSERT(convert_image(packed_base, packed_target), "Packed conversion %d -> %d failed", base, target);
+            CUTS_ASSERT(convert_image(padded_base, padded_target), "Padded conversion %d -> %d failed", base, target);
+            CUTS_ASSERT(same_pixels(packed_target, padded_target), "Padded conversion %d -> %d differs", base, target);
+
+            destroy_image(packed_base);
+            destroy_image(packed_target);
+            free(padded_base);
+            free(padded_target);
+            free(base_buffer);
+            free(target_buffer);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_view_conversions ()
+{
+    int base = 0;
+    int target = 0;
+    uint16_t x = 6;
+    uint16_t y = 4;
+    uint16_t width = TEST_WIDTH - 6 - 5;
+    uint16_t height = TEST_HEIGHT - 4 - 6;
+    Image_t * parent = NULL;
+    Image_t * packed_base = NULL;
+    Image_t * packed_target = NULL;
+    Image_t * target_parent = NULL;
+    Image_t base_view;
+    Image_t target_view;
+
+    for (base = 0; base < ASCII; base++) {
+        for (target = 0; target <= ASCII; target++) {
+            if (!conversion_function_LUT[base][target]) continue;
+
+            parent = create_image(TEST_WIDTH, TEST_HEIGHT, base);
+            target_parent = create_image(TEST_WIDTH, TEST_HEIGHT, target);
+            packed_base = create_image(width, height, base);
+            packed_target = create_image(width, height, target);
+
+            fill_pseudo_random(parent, base * 17 + target);
+            CUTS_ASSERT(create_image_view(parent, x, y, width, height, &base_view), "Could not create base view");
+            CUTS_ASSERT(create_image_view(target_parent, x, y, width, height, &target_view),
+                        "Could not create target view");
+            copy_pixels(&base_view, packed_base);
+
+            CUTS_ASSERT(convert_image(packed_base, packed_target), "Packed conversion %d -> %d failed", base, target);
+            CUTS_ASSERT(convert_image(&base_view, &target_view), "View conversion %d -> %d failed", base, target);
+            CUTS_ASSERT(same_pixels(packed_target, &target_view), "View conversion %d -> %d differs", base, target);
+
+            destroy_image(parent);
+            destroy_image(target_parent);
+            destroy_image(packed_base);
+            destroy_image(packed_target);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_strided_flips ()
+{
+    int axis = 0;
+    int format = 0;
+    uint8_t * buffer = NULL;
+    Image_t * packed = NULL;
+    Image_t * padded = NULL;
+    Image_t * parent = NULL;
+    Image_t view;
+
+    for (axis = 0; axis < 2; axis++) {
+        for (format = 0; format <= ASCII; format++) {
+            packed = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+            padded = create_padded_image(TEST_WIDTH, TEST_HEIGHT, format, &buffer);
+
+            fill_pseudo_random(packed, axis * 13 + format);
+            copy_pixels(packed, padded);
+
+            CUTS_ASSERT(flip_function_LUT[axis][format](packed), "Packed flip %d of format %d failed", axis, format);
+            CUTS_ASSERT(flip_function_LUT[axis][format](padded), "Padded flip %d of format %d failed", axis, format);
+            CUTS_ASSERT(same_pixels(packed, padded), "Padded flip %d of format %d differs", axis, format);
+
+            // Flipping a view must leave the rest of the parent image untouched
+            parent = create_image(TEST_WIDTH + 4, TEST_HEIGHT + 4, format);
+            CUTS_ASSERT(create_image_view(parent, 2, 2, TEST_WIDTH, TEST_HEIGHT, &view), "Could not create view");
+            fill_pseudo_random(&view, axis * 13 + format);
+            CUTS_ASSERT(flip_function_LUT[axis][format](&view), "View flip %d of format %d failed", axis, format);
+            CUTS_ASSERT(same_pixels(packed, &view), "View flip %d of format %d differs", axis, format);
+            CUTS_ASSERT(parent->data[0] == 0 && parent->data[get_image_row_size(TEST_WIDTH + 4, format, 0) - 1] == 0,
+                        "View flip %d of format %d wrote outside of the view", axis, format);
+
+            destroy_image(packed);
+            destroy_image(parent);
+            free(padded);
+            free(buffer);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_init_image);
+    CUTS_RUN_TEST(test_image_view);
+    CUTS_RUN_TEST(test_strided_conversions);
+    CUTS_RUN_TEST(test_view_conversions);
+    CUTS_RUN_TEST(test_strided_flips);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
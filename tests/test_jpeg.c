@@ -0,0 +1,510 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_TOLERANCE 4          // Maximum error of decoded samples (quality 95)
+#define TEST_SCALE_TOLERANCE 3    // Maximum error of downscaled samples, against averaged full-size samples
+#define TEST_FUZZ_ITERATIONS 2000
+#define TEST_DECODER_MEMORY_SIZE 32768
+
+
+// The workspace of the decoder, in static memory
+static uint8_t workspace[TEST_DECODER_MEMORY_SIZE];
+
+
+/*
+ * Test images, encoded with libjpeg (quality 95): Y is a horizontal ramp, Cb a vertical ramp, and Cr is flat (128).
+ *
+ * The 4:2:0 image is 21x13, with a restart marker after every MCU. The other ones are 11x9 and leave out their Huffman
+ * tables (like Motion-JPEG frames do), so that the standard ones are used.
+ */
+
+static const uint8_t jpeg_420[709] = {
+    0xff, 0xd8, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x04, 0x03, 0x02, 0x02, 0x02, 0x02, 0x05, 0x04, 0x04, 0x03, 0x04, 0x06, 0x05, 0x06,
+    0x06, 0x06, 0x05, 0x06, 0x06, 0x06, 0x07, 0x09, 0x08, 0x06, 0x07, 0x09, 0x07, 0x06, 0x06, 0x08, 0x0b, 0x08,
+    0x09, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x08, 0x0b, 0x0c, 0x0b, 0x0a, 0x0c, 0x09, 0x0a, 0x0a, 0x0a, 0xff,
+    0xdb, 0x00, 0x43, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x05, 0x03, 0x03, 0x05, 0x0a, 0x07, 0x06, 0x07,
+    0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+    0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+    0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0xff, 0xc0, 0x00, 0x11,
+    0x08, 0x00, 0x0d, 0x00, 0x15, 0x03, 0x01, 0x22, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xff, 0xc4, 0x00,
+    0x1f, 0x00, 0x00, 0x01, 0x05, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0xb5, 0x10, 0x00,
+    0x02, 0x01, 0x03, 0x03, 0x02, 0x04, 0x03, 0x05, 0x05, 0x04, 0x04, 0x00, 0x00, 0x01, 0x7d, 0x01, 0x02, 0x03,
+    0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07, 0x22, 0x71, 0x14, 0x32, 0x81,
+    0x91, 0xa1, 0x08, 0x23, 0x42, 0xb1, 0xc1, 0x15, 0x52, 0xd1, 0xf0, 0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0a,
+    0x16, 0x17, 0x18, 0x19, 0x1a, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a,
+    0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63, 0x64,
+    0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x83, 0x84, 0x85, 0x86,
+    0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6,
+    0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6,
+    0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe1, 0xe2, 0xe3, 0xe4, 0xe5,
+    0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xff, 0xc4, 0x00,
+    0x1f, 0x01, 0x00, 0x03, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0xff, 0xc4, 0x00, 0xb5, 0x11, 0x00,
+    0x02, 0x01, 0x02, 0x04, 0x04, 0x03, 0x04, 0x07, 0x05, 0x04, 0x04, 0x00, 0x01, 0x02, 0x77, 0x00, 0x01, 0x02,
+    0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71, 0x13, 0x22, 0x32, 0x81, 0x08,
+    0x14, 0x42, 0x91, 0xa1, 0xb1, 0xc1, 0x09, 0x23, 0x33, 0x52, 0xf0, 0x15, 0x62, 0x72, 0xd1, 0x0a, 0x16, 0x24,
+    0x34, 0xe1, 0x25, 0xf1, 0x17, 0x18, 0x19, 0x1a, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x35, 0x36, 0x37, 0x38, 0x39,
+    0x3a, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x63,
+    0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6a, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x82, 0x83, 0x84,
+    0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0xa2, 0xa3, 0xa4,
+    0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xb2, 0xb3, 0xb4, 0xb5, 0xb6, 0xb7, 0xb8, 0xb9, 0xba, 0xc2, 0xc3, 0xc4,
+    0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xd2, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xd9, 0xda, 0xe2, 0xe3, 0xe4,
+    0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0xf8, 0xf9, 0xfa, 0xff, 0xdd, 0x00,
+    0x04, 0x00, 0x01, 0xff, 0xda, 0x00, 0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00, 0xfc,
+    0xb2, 0xfd, 0x85, 0xff, 0x00, 0xe5, 0xcf, 0xe8, 0xb5, 0xfb, 0x31, 0xfb, 0x0b, 0xff, 0x00, 0xcb, 0x9f, 0xd1,
+    0x6b, 0xf1, 0x9f, 0xf6, 0x17, 0xff, 0x00, 0x97, 0x3f, 0xa2, 0xd7, 0xec, 0xc7, 0xec, 0x2f, 0xff, 0x00, 0x2e,
+    0x7f, 0x45, 0xaf, 0xd7, 0xbf, 0xe2, 0x94, 0xfc, 0x33, 0xff, 0x00, 0x3e, 0xe9, 0xff, 0x00, 0xe4, 0xa0, 0x7f,
+    0xff, 0xd0, 0xfd, 0xbd, 0xfd, 0x9d, 0x3f, 0xe4, 0x46, 0x5f, 0xa2, 0xff, 0x00, 0x23, 0x45, 0x1f, 0xb3, 0xa7,
+    0xfc, 0x88, 0xcb, 0xf4, 0x5f, 0xe4, 0x68, 0xaf, 0xd7, 0xbf, 0xe2, 0x94, 0xfc, 0x33, 0xff, 0x00, 0x3e, 0xe9,
+    0xff, 0x00, 0xe4, 0xa0, 0x7f, 0xff, 0xd9
+};
+
+static const uint8_t jpeg_422[249] = {
+    0xff, 0xd8, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x04, 0x03, 0x02, 0x02, 0x02, 0x02, 0x05, 0x04, 0x04, 0x03, 0x04, 0x06, 0x05, 0x06,
+    0x06, 0x06, 0x05, 0x06, 0x06, 0x06, 0x07, 0x09, 0x08, 0x06, 0x07, 0x09, 0x07, 0x06, 0x06, 0x08, 0x0b, 0x08,
+    0x09, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x08, 0x0b, 0x0c, 0x0b, 0x0a, 0x0c, 0x09, 0x0a, 0x0a, 0x0a, 0xff,
+    0xdb, 0x00, 0x43, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x05, 0x03, 0x03, 0x05, 0x0a, 0x07, 0x06, 0x07,
+    0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+    0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+    0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0xff, 0xc0, 0x00, 0x11,
+    0x08, 0x00, 0x09, 0x00, 0x0b, 0x03, 0x01, 0x21, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xff, 0xda, 0x00,
+    0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00, 0xf9, 0x97, 0xfe, 0x08, 0x5d, 0xff, 0x00,
+    0x30, 0x6f, 0xfb, 0x67, 0xfd, 0x2b, 0xfa, 0x70, 0xf8, 0x37, 0xff, 0x00, 0x24, 0xbf, 0x44, 0xff, 0x00, 0xaf,
+    0x21, 0xfc, 0xcd, 0x7e, 0x7b, 0xff, 0x00, 0x14, 0xdd, 0x5f, 0xf4, 0x07, 0xff, 0x00, 0x92, 0x81, 0xfc, 0xc7,
+    0xff, 0x00, 0xc1, 0x0b, 0xbf, 0xe6, 0x0d, 0xff, 0x00, 0x6c, 0xff, 0x00, 0xa5, 0x7f, 0x4e, 0x1f, 0x06, 0xff,
+    0x00, 0xe4, 0x97, 0xe8, 0x9f, 0xf5, 0xe4, 0x3f, 0x99, 0xaf, 0xfa, 0x3e, 0x03, 0xff, 0xd9
+};
+
+static const uint8_t jpeg_444[255] = {
+    0xff, 0xd8, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x04, 0x03, 0x02, 0x02, 0x02, 0x02, 0x05, 0x04, 0x04, 0x03, 0x04, 0x06, 0x05, 0x06,
+    0x06, 0x06, 0x05, 0x06, 0x06, 0x06, 0x07, 0x09, 0x08, 0x06, 0x07, 0x09, 0x07, 0x06, 0x06, 0x08, 0x0b, 0x08,
+    0x09, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x08, 0x0b, 0x0c, 0x0b, 0x0a, 0x0c, 0x09, 0x0a, 0x0a, 0x0a, 0xff,
+    0xdb, 0x00, 0x43, 0x01, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x05, 0x03, 0x03, 0x05, 0x0a, 0x07, 0x06, 0x07,
+    0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+    0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a,
+    0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0xff, 0xc0, 0x00, 0x11,
+    0x08, 0x00, 0x09, 0x00, 0x0b, 0x03, 0x01, 0x11, 0x00, 0x02, 0x11, 0x01, 0x03, 0x11, 0x01, 0xff, 0xda, 0x00,
+    0x0c, 0x03, 0x01, 0x00, 0x02, 0x11, 0x03, 0x11, 0x00, 0x3f, 0x00, 0xf9, 0x97, 0xfe, 0x08, 0x5d, 0xff, 0x00,
+    0x30, 0x6f, 0xfb, 0x67, 0xfd, 0x2b, 0xf3, 0xdf, 0xf8, 0xa6, 0xea, 0xff, 0x00, 0xa0, 0x3f, 0xfc, 0x94, 0x0f,
+    0xe9, 0xc3, 0xe0, 0xdf, 0xfc, 0x92, 0xfd, 0x13, 0xfe, 0xbc, 0x87, 0xf3, 0x34, 0x7f, 0xc5, 0x37, 0x57, 0xfd,
+    0x01, 0xff, 0x00, 0xe4, 0xa0, 0x7f, 0x31, 0xff, 0x00, 0xf0, 0x42, 0xef, 0xf9, 0x83, 0x7f, 0xdb, 0x3f, 0xe9,
+    0x5f, 0xf4, 0x7c, 0x07, 0xf4, 0xe1, 0xf0, 0x6f, 0xfe, 0x49, 0x7e, 0x89, 0xff, 0x00, 0x5e, 0x43, 0xf9, 0x9a,
+    0x00, 0xff, 0xd9
+};
+
+static const uint8_t jpeg_grayscale[151] = {
+    0xff, 0xd8, 0xff, 0xdb, 0x00, 0x43, 0x00, 0x02, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x01, 0x01, 0x01, 0x02,
+    0x02, 0x02, 0x02, 0x02, 0x04, 0x03, 0x02, 0x02, 0x02, 0x02, 0x05, 0x04, 0x04, 0x03, 0x04, 0x06, 0x05, 0x06,
+    0x06, 0x06, 0x05, 0x06, 0x06, 0x06, 0x07, 0x09, 0x08, 0x06, 0x07, 0x09, 0x07, 0x06, 0x06, 0x08, 0x0b, 0x08,
+    0x09, 0x0a, 0x0a, 0x0a, 0x0a, 0x0a, 0x06, 0x08, 0x0b, 0x0c, 0x0b, 0x0a, 0x0c, 0x09, 0x0a, 0x0a, 0x0a, 0xff,
+    0xc0, 0x00, 0x0b, 0x08, 0x00, 0x09, 0x00, 0x0b, 0x01, 0x01, 0x11, 0x00, 0xff, 0xda, 0x00, 0x08, 0x01, 0x01,
+    0x00, 0x00, 0x3f, 0x00, 0xf9, 0x97, 0xfe, 0x08, 0x5d, 0xff, 0x00, 0x30, 0x6f, 0xfb, 0x67, 0xfd, 0x2b, 0xfa,
+    0x70, 0xf8, 0x37, 0xff, 0x00, 0x24, 0xbf, 0x44, 0xff, 0x00, 0xaf, 0x21, 0xfc, 0xcd, 0x7f, 0x31, 0xff, 0x00,
+    0xf0, 0x42, 0xef, 0xf9, 0x83, 0x7f, 0xdb, 0x3f, 0xe9, 0x5f, 0xd3, 0x87, 0xc1, 0xbf, 0xf9, 0x25, 0xfa, 0x27,
+    0xfd, 0x79, 0x0f, 0xe6, 0x6b, 0xff, 0xd9
+};
+
+
+static const struct {
+    const uint8_t * data;
+    size_t size;
+    uint16_t width;
+    uint16_t height;
+    PixelFormat_t format;
+} test_images[4] = {
+    { jpeg_420, sizeof(jpeg_420), 21, 13, YUV420p },
+    { jpeg_422, sizeof(jpeg_422), 11, 9, YUV420p },
+    { jpeg_444, sizeof(jpeg_444), 11, 9, YUV444p },
+    { jpeg_grayscale, sizeof(jpeg_grayscale), 11, 9, GRAYSCALE }
+};
+
+
+// Caller-supplied pool running the bands on the calling thread, in reverse order
+static void reverse_run (void * context, BandTask_t task, void * arg, uint16_t band_count)
+{
+    int band = 0;
+
+    (*(int *) context)++;
+
+    for (band = band_count - 1; band >= 0; band--) {
+        task(arg, band);
+    }
+}
+
+
+// The value of the test pattern, averaged over the pixels a (possibly subsampled) sample covers
+static int expected_sample (const Image_t * img, uint8_t plane, uint32_t x, uint32_t y)
+{
+    uint32_t step = (img->format == YUV420p && plane > 0) ? 2 : 1;
+    uint32_t i = 0;
+    uint32_t sum = 0;
+    uint32_t count = 0;
+
+    if (plane == 2) return 128;
+
+    for (i = 0; i < step * step; i++) {
+        if (x * step + i % step >= img->width || y * step + i / step >= img->height) continue;
+        sum += plane ? (y * step + i / step) * 255 / (img->height - 1) : (x * step + i % step) * 255 / (img->width - 1);
+        count++;
+    }
+
+    return (sum + count / 2) / count;
+}
+
+
+// The average of the samples of a full-size plane covered by a sample of a downscaled plane (the encoder pads the
+// edges of the image by replicating its last samples, which the downscaled samples include)
+static int averaged_sample (const Image_t * img, uint8_t plane, uint32_t x, uint32_t y, uint8_t scale)
+{
+    uint32_t width = get_image_row_size(img->width, img->format, plane);
+    uint32_t height = get_image_plane_height(img->height, img->format, plane);
+    uint32_t i = 0;
+    uint32_t j = 0;
+    uint32_t sum = 0;
+
+    for (i = y * scale; i < (y + 1) * scale; i++) {
+        for (j = x * scale; j < (x + 1) * scale; j++) {
+            sum += get_image_row(img, plane, (i < height) ? i : height - 1)[(j < width) ? j : width - 1];
+        }
+    }
+
+    return (sum + scale * scale / 2) / (scale * scale);
+}
+
+
+char * test_jpeg_info ()
+{
+    uint8_t k = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    PixelFormat_t format = ASCII;
+
+    for (k = 0; k < 4; k++) {
+        CUTS_ASSERT(get_jpeg_info(test_images[k].data, test_images[k].size, 1, &width, &height, &format, workspace),
+                    "Image %d should be parsed", k);
+        CUTS_ASSERT(width == test_images[k].width && height == test_images[k].height, "Wrong size of image %d", k);
+        CUTS_ASSERT(format == test_images[k].format, "Wrong format of image %d", k);
+    }
+
+    // Downscaled sizes are rounded up
+    CUTS_ASSERT(get_jpeg_info(jpeg_420, sizeof(jpeg_420), 2, &width, &height, &format, workspace) && width == 11 &&
+                height == 7,
+                "Wrong 1/2 size: %dx%d", width, height);
+    CUTS_ASSERT(get_jpeg_info(jpeg_420, sizeof(jpeg_420), 8, &width, &height, &format, workspace) && width == 3 &&
+                height == 2,
+                "Wrong 1/8 size: %dx%d", width, height);
+    CUTS_ASSERT(!get_jpeg_info(jpeg_420, sizeof(jpeg_420), 3, &width, &height, &format, workspace),
+                "Unsupported scales should be rejected");
+    CUTS_ASSERT(!get_jpeg_info(jpeg_420, sizeof(jpeg_420), 1, NULL, &height, &format, workspace),
+                "NULL size should be rejected");
+    CUTS_ASSERT(!get_jpeg_info(jpeg_420, sizeof(jpeg_420), 1, &width, &height, &format, NULL),
+                "NULL memory should be rejected");
+    CUTS_ASSERT(get_jpeg_decoder_memory_size() <= TEST_DECODER_MEMORY_SIZE, "The decoder needs %u bytes",
+                get_jpeg_decoder_memory_size());
+
+    return NULL;
+}
+
+
+char * test_jpeg_decoding ()
+{
+    uint8_t k = 0;
+    uint8_t plane = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    int error = 0;
+    Image_t * img = NULL;
+    Image_t * flipped_img = NULL;
+    Image_t reversed_view;
+
+    for (k = 0; k < 4; k++) {
+        img = create_image(test_images[k].width, test_images[k].height, test_images[k].format);
+        CUTS_ASSERT(decode_jpeg_image(test_images[k].data, test_images[k].size, 1, img, NULL, workspace),
+                    "Image %d should be decoded", k);
+
+        for (plane = 0; plane < get_image_plane_count(img->format); plane++) {
+            for (y = 0; y < get_image_plane_height(img->height, img->format, plane); y++) {
+                for (x = 0; x < get_image_row_size(img->width, img->format, plane); x++) {
+                    error = get_image_row(img, plane, y)[x] - expected_sample(img, plane, x, y);
+                    CUTS_ASSERT(abs(error) <= TEST_TOLERANCE, "Wrong sample (%u, %u) of plane %d of image %d: %d",
+                                x, y, plane, k, get_image_row(img, plane, y)[x]);
+                }
+            }
+        }
+
+        // Strides are honored: decoding through a reversed view flips the image
+        flipped_img = create_image(img->width, img->height, img->format);
+        CUTS_ASSERT(create_reversed_image_view(flipped_img, &reversed_view), "Reversed view should be created");
+        CUTS_ASSERT(decode_jpeg_image(test_images[k].data, test_images[k].size, 1, &reversed_view, NULL, workspace),
+                    "Image %d should be decoded through a view", k);
+        CUTS_ASSERT(flipX_image(flipped_img) && !memcmp(flipped_img->data, img->data,
+                    get_image_data_size(img->width, img->height, img->format)),
+                    "Image %d decoded through a reversed view should be flipped", k);
+
+        destroy_image(flipped_img);
+        destroy_image(img);
+    }
+
+    return NULL;
+}
+
+
+char * test_scaled_jpeg_decoding ()
+{
+    uint8_t k = 0;
+    uint8_t scale = 0;
+    uint8_t plane = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    int error = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    PixelFormat_t format = ASCII;
+    Image_t * img = NULL;
+    Image_t * scaled_img = NULL;
+
+    // Downscaled samples are averages of the full-size ones
+    for (k = 0; k < 4; k++) {
+        img = create_image(test_images[k].width, test_images[k].height, test_images[k].format);
+        CUTS_ASSERT(decode_jpeg_image(test_images[k].data, test_images[k].size, 1, img, NULL, workspace),
+                    "Image %d should be decoded", k);
+
+        for (scale = 2; scale <= 8; scale *= 2) {
+            get_jpeg_info(test_images[k].data, test_images[k].size, scale, &width, &height, &format, workspace);
+            scaled_img = create_image(width, height, format);
+            CUTS_ASSERT(decode_jpeg_image(test_images[k].data, test_images[k].size, scale, scaled_img, NULL, workspace),
+                        "Image %d should be decoded at 1/%d", k, scale);
+
+            for (plane = 0; plane < get_image_plane_count(format); plane++) {
+                // At 1/8, 4:2:2 chroma samples are taken from every other block row, rather than averaged
+                if (k == 1 && scale == 8 && plane > 0) continue;
+
+                for (y = 0; y < get_image_plane_height(height, format, plane); y++) {
+                    for (x = 0; x < get_image_row_size(width, format, plane); x++) {
+                        error = get_image_row(scaled_img, plane, y)[x] - averaged_sample(img, plane, x, y, scale);
+                        CUTS_ASSERT(abs(error) <= TEST_SCALE_TOLERANCE,
+                                    "Wrong sample (%u, %u) of plane %d of image %d at 1/%d: %d (expected %d)", x, y,
+                                    plane, k, scale, get_image_row(scaled_img, plane, y)[x],
+                                    averaged_sample(img, plane, x, y, scale));
+                    }
+                }
+            }
+
+            destroy_image(scaled_img);
+        }
+
+        destroy_image(img);
+    }
+
+    return NULL;
+}
+
+
+char * test_parallel_jpeg_decoding ()
+{
+    int runs = 0;
+    uint8_t k = 0;
+    uint8_t scale = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    PixelFormat_t format = ASCII;
+    ThreadPool_t pool = { 3, reverse_run, &runs };
+    Image_t * img = NULL;
+    Image_t * parallel_img = NULL;
+
+    for (k = 0; k < 4; k++) {
+        for (scale = 1; scale <= 8; scale *= 2) {
+            get_jpeg_info(test_images[k].data, test_images[k].size, scale, &width, &height, &format, workspace);
+            img = create_image(width, height, format);
+            parallel_img = create_image(width, height, format);
+
+            CUTS_ASSERT(decode_jpeg_image(test_images[k].data, test_images[k].size, scale, img, NULL, workspace),
+                        "Image %d should be decoded", k);
+            CUTS_ASSERT(decode_jpeg_image_parallel(test_images[k].data, test_images[k].size, scale, parallel_img, NULL,
+                                                   workspace, &pool), "Image %d should be decoded in parallel", k);
+            CUTS_ASSERT(!memcmp(img->data, parallel_img->data, get_image_data_size(width, height, format)),
+                        "Parallel decoding of image %d at 1/%d differs", k, scale);
+
+            destroy_image(parallel_img);
+            destroy_image(img);
+        }
+    }
+
+    // Only the image with restart markers can be split into bands
+    CUTS_ASSERT(runs == 4, "The pool should have been used for each scale of the 4:2:0 image, not %d times", runs);
+
+    return NULL;
+}
+
+
+char * test_jpeg_colorspace ()
+{
+    static Colorspace_t jfif_colorspace;
+    static Colorspace_t limited_colorspace;
+    Image_t * img = create_image(11, 9, YUV444p);
+    Image_t * img_rgb24 = create_image(11, 9, RGB24);
+    uint8_t * top_row = NULL;
+    uint8_t * bottom_row = NULL;
+
+    init_colorspace(&jfif_colorspace, COLOR_BT601, COLOR_FULL_RANGE);
+    init_colorspace(&limited_colorspace, COLOR_BT601, COLOR_LIMITED_RANGE);
+
+    CUTS_ASSERT(!decode_jpeg_image(jpeg_444, sizeof(jpeg_444), 1, img, &limited_colorspace, workspace),
+                "Color spaces other than BT.601 full range should be rejected");
+    CUTS_ASSERT(decode_jpeg_image(jpeg_444, sizeof(jpeg_444), 1, img, &jfif_colorspace, workspace),
+                "Image should be decoded");
+    CUTS_ASSERT(img->colorspace == &jfif_colorspace, "Decoded image should be BT.601 full range");
+    CUTS_ASSERT(convert_image(img, img_rgb24), "Decoded image should be converted to RGB24");
+
+    // Y = 0 and Cr = 128 on the left column, and Cb goes from 0 (top) to 255 (bottom): full range gives (0, 44, 0) and
+    // (0, 0, 225), where limited range would give (0, 31, 0) and (0, 0, 237)
+    top_row = get_image_row(img_rgb24, 0, 0);
+    bottom_row = get_image_row(img_rgb24, 0, 8);
+    CUTS_ASSERT(top_row[0] <= TEST_TOLERANCE && abs(top_row[1] - 44) <= TEST_TOLERANCE && top_row[2] <= TEST_TOLERANCE,
+                "Wrong top-left color (%d, %d, %d)", top_row[0], top_row[1], top_row[2]);
+    CUTS_ASSERT(bottom_row[0] <= TEST_TOLERANCE && bottom_row[1] <= TEST_TOLERANCE &&
+                abs(bottom_row[2] - 225) <= TEST_TOLERANCE, "Wrong bottom-left color (%d, %d, %d)", bottom_row[0],
+                bottom_row[1], bottom_row[2]);
+
+    destroy_image(img);
+    destroy_image(img_rgb24);
+
+    return NULL;
+}
+
+
+char * test_truncated_jpeg_images ()
+{
+    size_t size = 0;
+    uint8_t k = 0;
+    Image_t * img = NULL;
+
+    for (k = 0; k < 4; k++) {
+        img = create_image(test_images[k].width, test_images[k].height, test_images[k].format);
+
+        // The end of image marker is not needed, but any missing entropy-coded data is
+        CUTS_ASSERT(decode_jpeg_image(test_images[k].data, test_images[k].size - 2, 1, img, NULL, workspace),
+                    "Image %d without its end marker should be decoded", k);
+        for (size = 0; size < test_images[k].size - 4; size++) {
+            CUTS_ASSERT(!decode_jpeg_image(test_images[k].data, size, 1, img, NULL, workspace),
+                        "Image %d truncated to %zu bytes should be rejected", k, size);
+        }
+
+        destroy_image(img);
+    }
+
+    return NULL;
+}
+
+
+char * test_incorrect_jpeg_images ()
+{
+    uint8_t data[sizeof(jpeg_444)];
+    uint16_t width = 0;
+    uint16_t height = 0;
+    PixelFormat_t format = RGB24;
+    Image_t * img = create_image(11, 9, YUV444p);
+    Image_t * wrong_img = create_image(11, 9, YUV420p);
+    // Offset of the frame header segment (after the two quantization tables)
+    size_t frame = 2 + 2 * 69;
+
+    CUTS_ASSERT(jpeg_444[frame] == 0xff && jpeg_444[frame + 1] == 0xc0, "Unexpected test image layout");
+
+    CUTS_ASSERT(!decode_jpeg_image(NULL, 10, 1, img, NULL, workspace), "NULL data should be rejected");
+    CUTS_ASSERT(!decode_jpeg_image(jpeg_444, sizeof(jpeg_444), 1, NULL, NULL, workspace),
+                "NULL image should be rejected");
+    CUTS_ASSERT(!decode_jpeg_image(jpeg_444, sizeof(jpeg_444), 1, img, NULL, NULL), "NULL memory should be rejected");
+    CUTS_ASSERT(!decode_jpeg_image(jpeg_444, sizeof(jpeg_444), 1, wrong_img, NULL, workspace),
+                "Wrong format should be rejected");
+    CUTS_ASSERT(!decode_jpeg_image(jpeg_444, sizeof(jpeg_444), 2, img, NULL, workspace),
+                "Wrong size should be rejected");
+
+    memcpy(data, jpeg_444, sizeof(data));
+    data[frame + 1] = 0xc2;
+    CUTS_ASSERT(!decode_jpeg_image(data, sizeof(data), 1, img, NULL, workspace),
+                "Progressive images should be rejected");
+
+    memcpy(data, jpeg_444, sizeof(data));
+    data[frame + 4] = 12;
+    CUTS_ASSERT(!decode_jpeg_image(data, sizeof(data), 1, img, NULL, workspace), "12-bit images should be rejected");
+
+    memcpy(data, jpeg_444, sizeof(data));
+    data[frame + 11] = 0x41;
+    CUTS_ASSERT(!decode_jpeg_image(data, sizeof(data), 1, img, NULL, workspace), "4:1:1 images should be rejected");
+
+    memcpy(data, jpeg_444, sizeof(data));
+    data[frame + 12] = 2;
+    CUTS_ASSERT(!decode_jpeg_image(data, sizeof(data), 1, img, NULL, workspace),
+                "Undefined quantization tables should be rejected");
+
+    memcpy(data, jpeg_444, sizeof(data));
+    data[0] = 0;
+    CUTS_ASSERT(!decode_jpeg_image(data, sizeof(data), 1, img, NULL, workspace),
+                "Missing start of image should be rejected");
+
+    // 65535x21846 YUV444p images take more than 4 GB, which must not wrap around to a small buffer
+    memcpy(data, jpeg_444, sizeof(data));
+    memcpy(data + frame + 5, "\x55\x56\xff\xff", 4);
+    CUTS_ASSERT(!get_jpeg_info(data, sizeof(data), 1, &width, &height, &format, workspace),
+                "Oversized images should be rejected");
+    // Down-scaled, they fit
+    CUTS_ASSERT(get_jpeg_info(data, sizeof(data), 2, &width, &height, &format, workspace) && width == 32768 &&
+                height == 10923,
+                "Oversized images should be accepted once scaled down");
+
+    destroy_image(wrong_img);
+    destroy_image(img);
+
+    return NULL;
+}
+
+
+char * test_jpeg_fuzzing ()
+{
+    uint32_t i = 0;
+    uint32_t seed = 1;
+    uint8_t data[sizeof(jpeg_420)];
+    Image_t * img = create_image(21, 13, YUV420p);
+
+    // Corrupt images must be decoded or rejected without reading or writing out of bounds
+    for (i = 0; i < TEST_FUZZ_ITERATIONS; i++) {
+        memcpy(data, jpeg_420, sizeof(data));
+
+        seed = seed * 1103515245 + 12345;
+        data[(seed >> 16) % sizeof(data)] = seed >> 8;
+        seed = seed * 1103515245 + 12345;
+        if (seed & 0x100) data[(seed >> 16) % sizeof(data)] = 0xff;
+
+        decode_jpeg_image(data, sizeof(data), 1 << (i % 4), img, NULL, workspace);
+    }
+
+    destroy_image(img);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_jpeg_info);
+    CUTS_RUN_TEST(test_jpeg_decoding);
+    CUTS_RUN_TEST(test_scaled_jpeg_decoding);
+    CUTS_RUN_TEST(test_parallel_jpeg_decoding);
+    CUTS_RUN_TEST(test_jpeg_colorspace);
+    CUTS_RUN_TEST(test_truncated_jpeg_images);
+    CUTS_RUN_TEST(test_incorrect_jpeg_images);
+    CUTS_RUN_TEST(test_jpeg_fuzzing);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
@@ -0,0 +1,186 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+#define TEST_THREADS 4
+#define TEST_FRAMES 3
+
+
+// Caller-supplied pool running the bands on the calling thread, in reverse order
+static void reverse_run (void * context, BandTask_t task, void * arg, uint16_t band_count)
+{
+    int band = 0;
+
+    (*(int *) context)++;
+
+    for (band = band_count - 1; band >= 0; band--) {
+        task(arg, band);
+    }
+}
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+static char * check_plans (uint16_t width, uint16_t height, ThreadPool_t * pool)
+{
+    int base = 0;
+    int target = 0;
+    uint8_t k = 0;
+    uint16_t row = 0;
+    uint8_t plane = 0;
+    ConversionPlan_t plan;
+    Image_t * base_imgs[TEST_FRAMES] = { NULL };
+    Image_t * serial_img = NULL;
+    Image_t * plan_img = NULL;
+    Image_t * padded_img = NULL;
+    Image_t padded_view;
+
+    for (base = 0; base < ASCII; base++) {
+        for (target = 0; target <= ASCII; target++) {
+            if (!conversion_function_LUT[base][target]) continue;
+
+            serial_img = create_image(width, height, target);
+            plan_img = create_image(width, height, target);
+            // The converted frames are views with padded rows, so that the strides of the plan are used
+            padded_img = create_image(width + 6, height + 2, target);
+            CUTS_ASSERT(create_image_view(padded_img, 2, 2, width, height, &padded_view), "Could not create view");
+
+            for (k = 0; k < TEST_FRAMES; k++) {
+                base_imgs[k] = create_image(width, height, base);
+                fill_pseudo_random(base_imgs[k], base * 7 + target + k);
+            }
+
+            CUTS_ASSERT(init_conversion_plan(&plan, base_imgs[0], plan_img, pool),
+                        "Could not initialize plan %d -> %d", base, target);
+            for (k = 0; k < TEST_FRAMES; k++) {
+                CUTS_ASSERT(convert_image(base_imgs[k], serial_img), "Serial conversion %d -> %d failed", base,
+                            target);
+                CUTS_ASSERT(execute_conversion_plan(&plan, base_imgs[k]->data, plan_img->data),
+                            "Plan %d -> %d failed on frame %d", base, target, k);
+                CUTS_ASSERT(!memcmp(serial_img->data, plan_img->data, get_image_data_size(width, height, target)),
+                            "Plan %d -> %d (%dx%d) differs on frame %d", base, target, width, height, k);
+            }
+
+            CUTS_ASSERT(init_conversion_plan(&plan, base_imgs[0], &padded_view, pool),
+                        "Could not initialize plan %d -> %d (view)", base, target);
+            CUTS_ASSERT(execute_conversion_plan(&plan, base_imgs[TEST_FRAMES - 1]->data, padded_view.data),
+                        "Plan %d -> %d failed on view", base, target);
+            for (plane = 0; plane < get_image_plane_count(target); plane++) {
+                for (row = 0; row < get_image_plane_height(height, target, plane); row++) {
+                    CUTS_ASSERT(!memcmp(get_image_row(serial_img, plane, row), get_image_row(&padded_view, plane, row),
+                                        get_image_row_size(width, target, plane)),
+                                "Plan %d -> %d differs on row %d of plane %d of view", base, target, row, plane);
+                }
+            }
+
+            for (k = 0; k < TEST_FRAMES; k++) {
+                destroy_image(base_imgs[k]);
+            }
+            destroy_image(serial_img);
+            destroy_image(plan_img);
+            destroy_image(padded_img);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_serial_plans ()
+{
+    char * result = NULL;
+
+    result = check_plans(TEST_WIDTH, TEST_HEIGHT, NULL);
+    if (!result) result = check_plans(5, 1, NULL);
+
+    return result;
+}
+
+
+char * test_parallel_plans ()
+{
+    char * result = NULL;
+
+#ifdef LIBUIMG_THREADS
+    CUTS_ASSERT(init_thread_pool(TEST_THREADS), "Could not start thread pool");
+#endif
+
+    result = check_plans(TEST_WIDTH, TEST_HEIGHT, NULL);
+    if (!result) result = check_plans(TEST_WIDTH, 3, NULL);
+
+    shutdown_thread_pool();
+
+    return result;
+}
+
+
+char * test_caller_supplied_pool_plans ()
+{
+    int runs = 0;
+    char * result = NULL;
+    ThreadPool_t pool = { 7, reverse_run, &runs };
+
+    result = check_plans(TEST_WIDTH, TEST_HEIGHT, &pool);
+    if (result) return result;
+
+    CUTS_ASSERT(runs > 0, "Caller-supplied pool was not used");
+
+    return NULL;
+}
+
+
+char * test_incorrect_plans ()
+{
+    ConversionPlan_t plan;
+    Image_t * img1 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img2 = create_image(TEST_WIDTH, TEST_HEIGHT + 1, YUV420p);
+    Image_t * img3 = create_image(TEST_WIDTH, TEST_HEIGHT, ASCII);
+    Image_t * img4 = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+
+    CUTS_ASSERT(!init_conversion_plan(NULL, img1, img4, NULL), "NULL plan should be rejected");
+    CUTS_ASSERT(!init_conversion_plan(&plan, NULL, img4, NULL), "NULL base image should be rejected");
+    CUTS_ASSERT(!init_conversion_plan(&plan, img1, NULL, NULL), "NULL converted image should be rejected");
+    CUTS_ASSERT(!init_conversion_plan(&plan, img1, img2, NULL), "Different dimensions should be rejected");
+    CUTS_ASSERT(!init_conversion_plan(&plan, img3, img1, NULL), "Conversions from ASCII should be rejected");
+    CUTS_ASSERT(!init_conversion_plan(&plan, img1, img1, NULL), "Same-format plans should be rejected");
+
+    CUTS_ASSERT(init_conversion_plan(&plan, img1, img4, NULL), "Could not initialize plan");
+    CUTS_ASSERT(!execute_conversion_plan(NULL, img1->data, img4->data), "NULL plan should be rejected");
+    CUTS_ASSERT(!execute_conversion_plan(&plan, NULL, img4->data), "NULL base data should be rejected");
+    CUTS_ASSERT(!execute_conversion_plan(&plan, img1->data, NULL), "NULL converted data should be rejected");
+
+    destroy_image(img1);
+    destroy_image(img2);
+    destroy_image(img3);
+    destroy_image(img4);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_serial_plans);
+    CUTS_RUN_TEST(test_parallel_plans);
+    CUTS_RUN_TEST(test_caller_supplied_pool_plans);
+    CUTS_RUN_TEST(test_incorrect_plans);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
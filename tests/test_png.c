@@ -0,0 +1,520 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+#include <unistd.h>
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+#define TEST_FUZZ_ITERATIONS 5000
+#define TEST_DECODER_MEMORY_SIZE 262144
+
+
+// The workspace of the decoder, in static memory
+static uint8_t decoder_memory[TEST_DECODER_MEMORY_SIZE];
+
+
+/*
+ * Test images, encoded with zlib: every row uses a different filter (the row index modulo 5), and every sample is
+ * taken from the most significant bits of `test_sample()`.
+ *
+ * The RGBA image is stored (not compressed) and its image data split over three IDAT chunks; the grayscale + alpha
+ * image has a tEXt chunk before its image data.
+ */
+
+static const uint8_t png_palette[150] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00,
+    0x00, 0x07, 0x00, 0x00, 0x00, 0x05, 0x04, 0x03, 0x00, 0x00, 0x00, 0x7b, 0xb4, 0xeb, 0xeb, 0x00, 0x00, 0x00,
+    0x30, 0x50, 0x4c, 0x54, 0x45, 0x00, 0xff, 0x00, 0x11, 0xef, 0x07, 0x22, 0xdf, 0x1c, 0x33, 0xcf, 0x3f, 0x44,
+    0xbf, 0x70, 0x55, 0xaf, 0xaf, 0x66, 0x9f, 0xfc, 0x77, 0x8f, 0x57, 0x88, 0x7f, 0xc0, 0x99, 0x6f, 0x37, 0xaa,
+    0x5f, 0xbc, 0xbb, 0x4f, 0x4f, 0xcc, 0x3f, 0xf0, 0xdd, 0x2f, 0x9f, 0xee, 0x1f, 0x5c, 0xff, 0x0f, 0x27, 0x2d,
+    0xdd, 0x65, 0x2e, 0x00, 0x00, 0x00, 0x21, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x60, 0x54, 0x76, 0x2b,
+    0x60, 0x14, 0x36, 0x36, 0xd2, 0x60, 0x52, 0x52, 0x52, 0x56, 0x60, 0xb6, 0xb5, 0x36, 0xd1, 0x64, 0x51, 0x52,
+    0x16, 0x32, 0x00, 0x00, 0x2b, 0xfd, 0x03, 0x68, 0x35, 0x38, 0x38, 0x27, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45,
+    0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+static const uint8_t png_rgb16[239] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00,
+    0x00, 0x07, 0x00, 0x00, 0x00, 0x05, 0x10, 0x02, 0x00, 0x00, 0x00, 0x56, 0x68, 0xbd, 0xcc, 0x00, 0x00, 0x00,
+    0xb6, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x60, 0x60, 0x28, 0xb5, 0x7e, 0x55, 0x26, 0xdc, 0xde, 0x71,
+    0xe8, 0xef, 0x5f, 0x75, 0xbe, 0x39, 0x9e, 0x82, 0x2d, 0x56, 0x53, 0xd7, 0x5f, 0x50, 0xe5, 0xf6, 0x93, 0x39,
+    0x1c, 0x6e, 0x31, 0x29, 0x71, 0xf1, 0xb5, 0x7b, 0x3e, 0x92, 0xa5, 0x5a, 0xaf, 0x52, 0xe3, 0x17, 0x30, 0xca,
+    0xbd, 0x9f, 0xa2, 0xc5, 0x99, 0x2a, 0x76, 0x42, 0xf4, 0x84, 0x18, 0x18, 0xc2, 0x68, 0x54, 0x1e, 0x88, 0x66,
+    0x92, 0x7f, 0x0f, 0x82, 0x8a, 0x06, 0x4a, 0x06, 0x8a, 0x06, 0xca, 0x85, 0x2a, 0x40, 0xa8, 0xba, 0x49, 0x0d,
+    0x08, 0x35, 0x3e, 0x83, 0xa0, 0xb6, 0x89, 0x16, 0x10, 0xea, 0x96, 0xea, 0x96, 0xea, 0x94, 0x32, 0xdb, 0xc5,
+    0x55, 0xfe, 0x31, 0x96, 0x94, 0xb7, 0x95, 0x03, 0x42, 0xf9, 0x7b, 0xf2, 0x71, 0xf2, 0x71, 0x0a, 0xff, 0x16,
+    0xd4, 0x29, 0xd6, 0x29, 0xce, 0x57, 0x9a, 0xaf, 0x28, 0xaf, 0xbc, 0x5f, 0xc9, 0x5e, 0xc9, 0x5e, 0x39, 0x01,
+    0x04, 0x59, 0xe4, 0xdf, 0xcb, 0x01, 0x4d, 0x95, 0x35, 0x90, 0xed, 0x96, 0x31, 0x90, 0x01, 0x9a, 0x29, 0x5b,
+    0x08, 0x64, 0xfd, 0x91, 0xd9, 0x24, 0x63, 0x2b, 0xfb, 0x59, 0xb6, 0x5b, 0xd6, 0x44, 0x06, 0x04, 0x4b, 0x65,
+    0x81, 0x10, 0x00, 0x1d, 0x4a, 0x4d, 0x91, 0xef, 0xdf, 0x0f, 0x83, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e,
+    0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+static const uint8_t png_gray2[90] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00,
+    0x00, 0x0d, 0x00, 0x00, 0x00, 0x05, 0x02, 0x00, 0x00, 0x00, 0x00, 0xf1, 0x63, 0x21, 0x6c, 0x00, 0x00, 0x00,
+    0x21, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x60, 0x08, 0x5b, 0x7f, 0x80, 0x91, 0x35, 0x75, 0x12, 0x0b,
+    0x93, 0xa0, 0xeb, 0x51, 0x07, 0x66, 0xff, 0x0a, 0xf3, 0x30, 0x16, 0xc1, 0xa3, 0xae, 0x0e, 0x00, 0x56, 0x40,
+    0x06, 0xda, 0x75, 0xcb, 0x3c, 0x3e, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+static const uint8_t png_gray_alpha[159] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00,
+    0x00, 0x07, 0x00, 0x00, 0x00, 0x05, 0x08, 0x04, 0x00, 0x00, 0x00, 0x23, 0x93, 0x3e, 0x53, 0x00, 0x00, 0x00,
+    0x0f, 0x74, 0x45, 0x58, 0x74, 0x43, 0x6f, 0x6d, 0x6d, 0x65, 0x6e, 0x74, 0x00, 0x6c, 0x69, 0x62, 0x75, 0x69,
+    0x6d, 0x67, 0x97, 0xfb, 0x44, 0xf6, 0x00, 0x00, 0x00, 0x4b, 0x49, 0x44, 0x41, 0x54, 0x78, 0xda, 0x63, 0x60,
+    0x28, 0x15, 0xee, 0x50, 0x9f, 0x63, 0xb5, 0xde, 0xef, 0x70, 0xe2, 0xb5, 0xd2, 0x57, 0x8c, 0x72, 0x53, 0xc4,
+    0x44, 0xc5, 0xc0, 0x00, 0x48, 0x89, 0x32, 0xc9, 0xcb, 0x2b, 0x2a, 0x29, 0xab, 0xa8, 0xaa, 0x69, 0x68, 0x68,
+    0x6b, 0xe9, 0xea, 0x32, 0xdb, 0x55, 0xca, 0xcb, 0xc9, 0xcb, 0x2b, 0x2c, 0x00, 0x0a, 0x2a, 0x29, 0x2b, 0xb3,
+    0xc8, 0xcb, 0xc9, 0xca, 0xca, 0xa8, 0xc8, 0xca, 0xc8, 0xc8, 0x82, 0x30, 0x00, 0x9c, 0x55, 0x0e, 0x92, 0x28,
+    0x9e, 0xa7, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae, 0x42, 0x60, 0x82
+};
+
+static const uint8_t png_rgba_stored[237] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52, 0x00, 0x00,
+    0x00, 0x07, 0x00, 0x00, 0x00, 0x05, 0x08, 0x06, 0x00, 0x00, 0x00, 0x89, 0x9a, 0xf6, 0xd8, 0x00, 0x00, 0x00,
+    0x34, 0x49, 0x44, 0x41, 0x54, 0x78, 0x01, 0x01, 0x91, 0x00, 0x6e, 0xff, 0x00, 0x00, 0x75, 0xea, 0x5f, 0x13,
+    0x88, 0xfd, 0x73, 0x27, 0x9c, 0x11, 0x86, 0x3a, 0xaf, 0x25, 0x9a, 0x4e, 0xc3, 0x38, 0xad, 0x61, 0xd6, 0x4c,
+    0xc1, 0x75, 0xea, 0x5f, 0xd4, 0x01, 0x1e, 0x94, 0x09, 0x7e, 0x16, 0x15, 0x16, 0x16, 0x16, 0x16, 0x15, 0x16,
+    0x16, 0x16, 0x16, 0x9a, 0x30, 0x9b, 0xc0, 0x00, 0x00, 0x00, 0x34, 0x49, 0x44, 0x41, 0x54, 0x15, 0x16, 0x16,
+    0x16, 0x16, 0x15, 0x16, 0x16, 0x16, 0x16, 0x15, 0x16, 0x16, 0x02, 0x1f, 0x1f, 0x1f, 0x1f, 0x21, 0x22, 0x21,
+    0x21, 0x23, 0x24, 0x24, 0x23, 0x25, 0x26, 0x26, 0x26, 0x28, 0x28, 0x28, 0x28, 0x2b, 0x2a, 0x2a, 0x2a, 0x2d,
+    0x2d, 0x2c, 0x2c, 0x03, 0x3e, 0x79, 0x33, 0x6e, 0x1f, 0x1e, 0x1e, 0x1e, 0x1f, 0x65, 0x31, 0xb1, 0x99, 0x00,
+    0x00, 0x00, 0x34, 0x49, 0x44, 0x41, 0x54, 0x1f, 0x1f, 0x20, 0x20, 0xa0, 0x21, 0x20, 0x21, 0x22, 0x21, 0xa1,
+    0x23, 0x22, 0x22, 0x22, 0x23, 0x23, 0x23, 0x24, 0x04, 0x1f, 0x1e, 0x1f, 0x1f, 0x1d, 0x1d, 0x1c, 0x1c, 0x1c,
+    0x24, 0x1d, 0x1d, 0x1d, 0x1c, 0x1c, 0x26, 0x1c, 0x1d, 0x1d, 0x1c, 0x1d, 0x1c, 0x1c, 0x1d, 0x1c, 0x1d, 0x1d,
+    0x1c, 0x7d, 0xd2, 0x1d, 0xa9, 0xbf, 0x28, 0x7e, 0xbb, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae,
+    0x42, 0x60, 0x82
+};
+
+
+static const struct {
+    const uint8_t * data;
+    size_t size;
+    uint16_t width;
+    uint16_t height;
+    PixelFormat_t format;
+} test_images[5] = {
+    { png_palette, sizeof(png_palette), 7, 5, RGB24 },
+    { png_rgb16, sizeof(png_rgb16), 7, 5, RGB24 },
+    { png_gray2, sizeof(png_gray2), 13, 5, GRAYSCALE },
+    { png_gray_alpha, sizeof(png_gray_alpha), 7, 5, GRAYSCALE },
+    { png_rgba_stored, sizeof(png_rgba_stored), 7, 5, RGB24 }
+};
+
+
+// The 16-bit value the samples of the test images are taken from
+static uint16_t test_sample (uint16_t x, uint16_t y, uint8_t channel)
+{
+    return x * 4999 + y * 7919 + channel * 30011 + x * y * 577;
+}
+
+
+// The expected decoded sample of a test image
+static uint8_t expected_sample (uint8_t k, uint16_t x, uint16_t y, uint8_t channel)
+{
+    uint8_t index = test_sample(x, y, 0) >> 12;
+
+    switch (k) {
+        case 0:
+            // 4-bit palette image, whose palette is (17 i, 255 - 16 i, 7 i^2)
+            if (channel == 0) return index * 17;
+            if (channel == 1) return 255 - index * 16;
+            return index * index * 7;
+        case 1:
+            // 16-bit samples are rounded
+            return (test_sample(x, y, channel) * 255 + 32895) >> 16;
+        case 2:
+            // 2-bit samples are rescaled
+            return (test_sample(x, y, channel) >> 14) * 85;
+        default:
+            return test_sample(x, y, channel) >> 8;
+    }
+}
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+// Smooth gradients with a few flat areas, which compress well (unlike pseudo-random pixels)
+static void fill_gradient (Image_t * img)
+{
+    uint32_t i = 0;
+    uint32_t size = get_image_data_size(img->width, img->height, img->format);
+
+    for (i = 0; i < size; i++) {
+        img->data[i] = ((i / 3) % img->width < img->width / 4) ? 0x80 : (i * 7 / img->width + i % 5);
+    }
+}
+
+
+static char * get_temporary_path ()
+{
+    static char path[32];
+    int fd = -1;
+
+    strcpy(path, "/tmp/libuimg_test_XXXXXX");
+    fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    close(fd);
+
+    return path;
+}
+
+
+// Decode an image into a new image, or return NULL if it is rejected
+static Image_t * decode_test_image (const uint8_t * data, size_t size)
+{
+    uint16_t width = 0;
+    uint16_t height = 0;
+    PixelFormat_t format = GRAYSCALE;
+    Image_t * img = NULL;
+
+    if (!get_png_info(data, size, &width, &height, &format)) return NULL;
+    if (get_png_decoder_memory_size(data, size) > TEST_DECODER_MEMORY_SIZE) return NULL;
+
+    img = create_image(width, height, format);
+    if (!decode_png_image(data, size, img, decoder_memory)) {
+        destroy_image(img);
+        return NULL;
+    }
+
+    return img;
+}
+
+
+// Copies the decoded rows into an image, and stops the decoding after a given row
+typedef struct {
+    Image_t * img;
+    uint16_t row_count;
+    uint16_t stop_row;
+} RowCollector_t;
+
+
+static uint8_t collect_row (void * arg, const uint8_t * row, uint16_t index)
+{
+    RowCollector_t * collector = arg;
+
+    if (index != collector->row_count) return 0;
+    memcpy(get_image_row(collector->img, 0, index), row, get_image_row_size(collector->img->width,
+                                                                              collector->img->format, 0));
+    collector->row_count++;
+
+    return index != collector->stop_row;
+}
+
+
+char * test_png_info ()
+{
+    uint16_t width = 0;
+    uint16_t height = 0;
+    PixelFormat_t format = YUV420p;
+    uint8_t k = 0;
+
+    for (k = 0; k < 5; k++) {
+        CUTS_ASSERT(get_png_info(test_images[k].data, test_images[k].size, &width, &height, &format),
+                    "Could not get the info of image %d", k);
+        CUTS_ASSERT(width == test_images[k].width && height == test_images[k].height, "Wrong size of image %d", k);
+        CUTS_ASSERT(format == test_images[k].format, "Wrong format of image %d", k);
+    }
+
+    CUTS_ASSERT(!get_png_info(png_rgb16, sizeof(png_rgb16), NULL, &height, &format), "NULL size should be rejected");
+
+    return NULL;
+}
+
+
+char * test_png_decoding ()
+{
+    uint8_t k = 0;
+    uint8_t channel = 0;
+    uint8_t channels = 0;
+    uint16_t x = 0;
+    uint16_t y = 0;
+    uint8_t * row = NULL;
+    Image_t * img = NULL;
+
+    for (k = 0; k < 5; k++) {
+        img = decode_test_image(test_images[k].data, test_images[k].size);
+        CUTS_ASSERT(img, "Image %d should be decoded", k);
+        CUTS_ASSERT(img->width == test_images[k].width && img->height == test_images[k].height &&
+                    img->format == test_images[k].format, "Wrong dimensions or format of image %d", k);
+
+        channels = (img->format == RGB24) ? 3 : 1;
+        for (y = 0; y < img->height; y++) {
+            row = get_image_row(img, 0, y);
+            for (x = 0; x < img->width; x++) {
+                for (channel = 0; channel < channels; channel++) {
+                    CUTS_ASSERT(row[x * channels + channel] == expected_sample(k, x, y, channel),
+                                "Wrong sample (%u, %u, %u) of image %d: %d instead of %d", x, y, channel, k,
+                                row[x * channels + channel], expected_sample(k, x, y, channel));
+                }
+            }
+        }
+
+        destroy_image(img);
+    }
+
+    return NULL;
+}
+
+
+char * test_png_row_decoding ()
+{
+    uint8_t k = 0;
+    Image_t * img = NULL;
+    RowCollector_t collector;
+
+    for (k = 0; k < 5; k++) {
+        img = decode_test_image(test_images[k].data, test_images[k].size);
+        collector.img = create_image(test_images[k].width, test_images[k].height, test_images[k].format);
+        collector.row_count = 0;
+        collector.stop_row = test_images[k].height;
+
+        CUTS_ASSERT(decode_png_rows(test_images[k].data, test_images[k].size, collect_row, &collector,
+                                    decoder_memory),
+                    "Rows of image %d should be decoded", k);
+        CUTS_ASSERT(collector.row_count == img->height, "Only %d rows of image %d were decoded", collector.row_count,
+                    k);
+        CUTS_ASSERT(!memcmp(collector.img->data, img->data, get_image_data_size(img->width, img->height, img->format)),
+                    "Rows of image %d differ from the decoded image", k);
+
+        // The callback can stop the decoding
+        collector.row_count = 0;
+        collector.stop_row = 2;
+        CUTS_ASSERT(!decode_png_rows(test_images[k].data, test_images[k].size, collect_row, &collector,
+                                    decoder_memory),
+                    "Stopped decoding of image %d should fail", k);
+        CUTS_ASSERT(collector.row_count == 3, "The decoding of image %d should have stopped after 3 rows", k);
+
+        destroy_image(collector.img);
+        destroy_image(img);
+    }
+
+    CUTS_ASSERT(!decode_png_rows(png_rgb16, sizeof(png_rgb16), NULL, NULL, decoder_memory), "NULL callback should be "
+                "rejected");
+    CUTS_ASSERT(!decode_png_rows(png_rgb16, sizeof(png_rgb16), collect_row, &collector, NULL), "NULL memory should be "
+                "rejected");
+
+    return NULL;
+}
+
+
+char * test_png_round_trip ()
+{
+    PixelFormat_t formats[2] = { RGB24, GRAYSCALE };
+    PngCompression_t compressions[2] = { PNG_COMPRESSION_FAST, PNG_COMPRESSION_DEFAULT };
+    uint8_t k = 0;
+    uint8_t c = 0;
+    uint8_t pattern = 0;
+    uint16_t row = 0;
+    size_t size = 0;
+    uint8_t * data = NULL;
+    uint8_t * memory = NULL;
+    char * path = get_temporary_path();
+    Image_t * parent_img = NULL;
+    Image_t * img = NULL;
+    Image_t view;
+
+    CUTS_ASSERT(path, "Could not create temporary file");
+
+    for (k = 0; k < 2; k++) {
+        for (pattern = 0; pattern < 2; pattern++) {
+            // Pseudo-random pixels end up in stored blocks, gradients in compressed ones
+            parent_img = create_image(pattern ? 301 : TEST_WIDTH, pattern ? 97 : TEST_HEIGHT, formats[k]);
+            if (pattern) fill_gradient(parent_img);
+            else fill_pseudo_random(parent_img, k);
+
+            memory = create_buffer(get_png_encoder_memory_size(parent_img->width, parent_img->height, formats[k]));
+            CUTS_ASSERT(memory, "Could not create the workspace of the encoder (format %d)", formats[k]);
+
+            for (c = 0; c < 2; c++) {
+                // Whole image
+                data = encode_png_image(parent_img, compressions[c], memory, &size);
+                CUTS_ASSERT(data, "Could not encode image (format %d, compression %d)", formats[k], c);
+                img = decode_test_image(data, size);
+                CUTS_ASSERT(img, "Could not decode image (format %d, compression %d)", formats[k], c);
+                CUTS_ASSERT(img->width == parent_img->width && img->height == parent_img->height &&
+                            img->format == formats[k], "Wrong dimensions or format");
+                CUTS_ASSERT(!memcmp(img->data, parent_img->data,
+                                    get_image_data_size(img->width, img->height, formats[k])),
+                            "Pixel data differs (format %d, pattern %d, compression %d)", formats[k], pattern, c);
+                CUTS_ASSERT(!pattern || size < get_image_data_size(img->width, img->height, formats[k]) / 4,
+                            "Gradient compressed to %zu bytes only (format %d, compression %d)", size, formats[k], c);
+                destroy_image(img);
+
+                // View (with padded rows), through a file
+                CUTS_ASSERT(create_image_view(parent_img, 3, 5, 20, 11, &view), "Could not create view");
+                CUTS_ASSERT(save_png_image(&view, path, compressions[c]), "Could not save view (format %d)",
+                            formats[k]);
+                img = load_png_image(path);
+                CUTS_ASSERT(img && img->width == 20 && img->height == 11, "Could not load view (format %d)",
+                            formats[k]);
+                for (row = 0; row < 11; row++) {
+                    CUTS_ASSERT(!memcmp(get_image_row(img, 0, row), get_image_row(&view, 0, row),
+                                        get_image_row_size(20, formats[k], 0)),
+                                "Row %d of view differs (format %d)", row, formats[k]);
+                }
+                destroy_image(img);
+            }
+
+            destroy_buffer(memory);
+            destroy_image(parent_img);
+        }
+    }
+
+    remove(path);
+
+    return NULL;
+}
+
+
+char * test_truncated_png_images ()
+{
+    size_t size = 0;
+    uint8_t k = 0;
+    Image_t * img = NULL;
+
+    for (k = 0; k < 5; k++) {
+        // The IEND chunk is not needed, but any missing image data is
+        img = decode_test_image(test_images[k].data, test_images[k].size - 12);
+        CUTS_ASSERT(img, "Image %d without its IEND chunk should be decoded", k);
+        destroy_image(img);
+        for (size = 0; size < test_images[k].size - 20; size++) {
+            CUTS_ASSERT(!decode_test_image(test_images[k].data, size),
+                        "Image %d truncated to %zu bytes should be rejected", k, size);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_incorrect_png_images ()
+{
+    uint8_t data[sizeof(png_gray_alpha)];
+    uint8_t rgb_data[sizeof(png_rgb16)];
+    uint16_t width = 0;
+    uint16_t height = 0;
+    PixelFormat_t format = RGB24;
+    Image_t * img = create_image(4, 4, YUV420p);
+    size_t size = sizeof(data);
+    // Offsets of the IHDR data, of the chunk after it and of the Adler-32 checksum (before the CRC and the IEND chunk)
+    size_t header = 16;
+    size_t chunk = 33;
+    size_t checksum = size - 12 - 4 - 4;
+
+    CUTS_ASSERT(!memcmp(png_gray_alpha + chunk + 4, "tEXt", 4), "Unexpected test image layout");
+
+    CUTS_ASSERT(!decode_png_image(NULL, 10, img, decoder_memory), "NULL data should be rejected");
+    CUTS_ASSERT(!decode_png_image(png_gray_alpha, size, img, NULL), "NULL memory should be rejected");
+    CUTS_ASSERT(!decode_png_image(png_gray_alpha, size, img, decoder_memory), "Images of another size or format should "
+                "be rejected");
+    CUTS_ASSERT(!load_png_image("/nonexistent/image.png"), "Missing files should be rejected");
+    CUTS_ASSERT(!get_png_encoder_memory_size(4, 4, YUV420p), "Formats other than RGB24/GRAYSCALE should be rejected");
+    CUTS_ASSERT(!encode_png_image(img, PNG_COMPRESSION_FAST, decoder_memory, &size), "Formats other than "
+                "RGB24/GRAYSCALE should be rejected");
+    CUTS_ASSERT(!save_png_image(img, "/tmp/libuimg_test.png", PNG_COMPRESSION_FAST), "Formats other than "
+                "RGB24/GRAYSCALE should be rejected");
+
+    memcpy(data, png_gray_alpha, size);
+    data[1] = 'B';
+    CUTS_ASSERT(!decode_test_image(data, size), "Wrong signature should be rejected");
+
+    memcpy(data, png_gray_alpha, size);
+    data[header + 3] = 0;
+    CUTS_ASSERT(!decode_test_image(data, size), "Empty images should be rejected");
+
+    memcpy(data, png_gray_alpha, size);
+    data[header + 1] = 1;
+    CUTS_ASSERT(!decode_test_image(data, size), "Too wide images should be rejected");
+
+    memcpy(data, png_gray_alpha, size);
+    data[header + 8] = 4;
+    CUTS_ASSERT(!decode_test_image(data, size), "Invalid bit depths should be rejected");
+
+    memcpy(data, png_gray_alpha, size);
+    data[header + 12] = 1;
+    CUTS_ASSERT(!decode_test_image(data, size), "Interlaced images should be rejected");
+
+    memcpy(data, png_gray_alpha, size);
+    data[chunk + 4] = 'T';
+    CUTS_ASSERT(!decode_test_image(data, size), "Unknown critical chunks should be rejected");
+
+    memcpy(data, png_gray_alpha, size);
+    data[checksum + 3] ^= 1;
+    CUTS_ASSERT(!decode_test_image(data, size), "Wrong checksums should be rejected");
+
+    memcpy(data, png_gray_alpha, size);
+    data[header + 9] = 3;
+    CUTS_ASSERT(!decode_test_image(data, size), "Palette images without a palette should be rejected");
+
+    // 65535x21846 RGB24 images take more than 4 GB, which must not wrap around to a small buffer
+    memcpy(rgb_data, png_rgb16, sizeof(rgb_data));
+    memcpy(rgb_data + header, "\x00\x00\xff\xff\x00\x00\x55\x56", 8);
+    CUTS_ASSERT(!get_png_info(rgb_data, sizeof(rgb_data), &width, &height, &format), "Oversized images should be "
+                "rejected");
+    CUTS_ASSERT(!get_png_decoder_memory_size(rgb_data, sizeof(rgb_data)), "Oversized images should not be decoded");
+    rgb_data[header + 7] = 0x55;
+    CUTS_ASSERT(get_png_info(rgb_data, sizeof(rgb_data), &width, &height, &format) && width == 65535 &&
+                height == 21845, "The largest images should be accepted");
+
+    destroy_image(img);
+
+    return NULL;
+}
+
+
+char * test_png_fuzzing ()
+{
+    uint32_t i = 0;
+    uint32_t seed = 1;
+    uint8_t k = 0;
+    uint8_t data[sizeof(png_rgb16)];
+    Image_t * img = NULL;
+
+    // Corrupt images must be decoded or rejected without reading or writing out of bounds
+    for (i = 0; i < TEST_FUZZ_ITERATIONS; i++) {
+        k = i % 4;
+        memcpy(data, test_images[k].data, test_images[k].size);
+
+        seed = seed * 1103515245 + 12345;
+        data[33 + (seed >> 16) % (test_images[k].size - 33)] = seed >> 8;
+        seed = seed * 1103515245 + 12345;
+        if (seed & 0x100) data[33 + (seed >> 16) % (test_images[k].size - 33)] ^= 1 << ((seed >> 9) % 8);
+
+        img = decode_test_image(data, test_images[k].size);
+        if (img) destroy_image(img);
+    }
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_png_info);
+    CUTS_RUN_TEST(test_png_decoding);
+    CUTS_RUN_TEST(test_png_row_decoding);
+    CUTS_RUN_TEST(test_png_round_trip);
+    CUTS_RUN_TEST(test_truncated_png_images);
+    CUTS_RUN_TEST(test_incorrect_png_images);
+    CUTS_RUN_TEST(test_png_fuzzing);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
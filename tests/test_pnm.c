@@ -0,0 +1,199 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+#include <unistd.h>
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+#define TEST_FUZZ_ITERATIONS 20000
+
+// A string literal, along with its size (they may contain null bytes)
+#define PNM_TEST_IMAGE(literal) { literal, sizeof(literal) - 1 }
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+static char * get_temporary_path ()
+{
+    static char path[32];
+    int fd = -1;
+
+    strcpy(path, "/tmp/libuimg_test_XXXXXX");
+    fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    close(fd);
+
+    return path;
+}
+
+
+char * test_pnm_round_trip ()
+{
+    PixelFormat_t formats[2] = { RGB24, GRAYSCALE };
+    uint8_t k = 0;
+    uint16_t row = 0;
+    char * path = get_temporary_path();
+    Image_t * parent_img = NULL;
+    Image_t * img = NULL;
+    Image_t view;
+
+    CUTS_ASSERT(path, "Could not create temporary file");
+
+    for (k = 0; k < 2; k++) {
+        parent_img = create_image(TEST_WIDTH, TEST_HEIGHT, formats[k]);
+        fill_pseudo_random(parent_img, k);
+
+        // Whole image
+        CUTS_ASSERT(save_pnm_image(parent_img, path), "Could not save image (format %d)", formats[k]);
+        img = load_pnm_image(path);
+        CUTS_ASSERT(img, "Could not load image (format %d)", formats[k]);
+        CUTS_ASSERT(img->width == TEST_WIDTH && img->height == TEST_HEIGHT && img->format == formats[k],
+                    "Wrong dimensions or format");
+        CUTS_ASSERT(!memcmp(img->data, parent_img->data, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, formats[k])),
+                    "Pixel data differs (format %d)", formats[k]);
+        destroy_image(img);
+
+        // View (with padded rows)
+        CUTS_ASSERT(create_image_view(parent_img, 3, 5, 20, 11, &view), "Could not create view");
+        CUTS_ASSERT(save_pnm_image(&view, path), "Could not save view (format %d)", formats[k]);
+        img = load_pnm_image(path);
+        CUTS_ASSERT(img && img->width == 20 && img->height == 11, "Could not load view (format %d)", formats[k]);
+        for (row = 0; row < 11; row++) {
+            CUTS_ASSERT(!memcmp(get_image_row(img, 0, row), get_image_row(&view, 0, row),
+                                get_image_row_size(20, formats[k], 0)),
+                        "Row %d of view differs (format %d)", row, formats[k]);
+        }
+        destroy_image(img);
+
+        destroy_image(parent_img);
+    }
+
+    remove(path);
+
+    return NULL;
+}
+
+
+char * test_pnm_header_parsing ()
+{
+    const char * commented = "P5 # comment\n# another comment\n3\t2\r\n255 abcdef";
+    const char * rescaled = "P5\n4 1\n15\n\x00\x05\x0f\x10";
+    Image_t * img = NULL;
+
+    img = decode_pnm_image((const uint8_t *) commented, strlen(commented));
+    CUTS_ASSERT(img, "Comments and mixed whitespace should be accepted");
+    CUTS_ASSERT(img->width == 3 && img->height == 2 && img->format == GRAYSCALE, "Wrong dimensions or format");
+    CUTS_ASSERT(!memcmp(img->data, "abcdef", 6), "Wrong pixel data");
+    destroy_image(img);
+
+    // Samples are rescaled to the full 8-bit range (and clamped)
+    img = decode_pnm_image((const uint8_t *) rescaled, 14);
+    CUTS_ASSERT(img, "Maximum values below 255 should be accepted");
+    CUTS_ASSERT(img->data[0] == 0 && img->data[1] == 85 && img->data[2] == 255 && img->data[3] == 255,
+                "Wrong rescaled samples: %d %d %d %d", img->data[0], img->data[1], img->data[2], img->data[3]);
+    destroy_image(img);
+
+    return NULL;
+}
+
+
+char * test_incorrect_pnm_images ()
+{
+    struct {
+        const char * data;
+        size_t size;
+    } images[10] = {
+        PNM_TEST_IMAGE("P4\n1 1\n255\n\x00\x00\x00"),      // Bitmaps are not supported
+        PNM_TEST_IMAGE("P3\n1 1\n255\n0 0 0"),             // Neither are plain images
+        PNM_TEST_IMAGE("P6\n1 1\n65535\n\x00\x00\x00"),    // Nor 16-bit images
+        PNM_TEST_IMAGE("P6\n0 1\n255\n\x00\x00\x00"),      // Empty image
+        PNM_TEST_IMAGE("P6\n1 1\n0\n\x00\x00\x00"),        // Null maximum value
+        PNM_TEST_IMAGE("P6\n1 1\n255\x00\x00\x00"),        // Missing whitespace after the header
+        PNM_TEST_IMAGE("P6\n1 1\n255\n\x00\x00"),          // Truncated pixel data
+        PNM_TEST_IMAGE("P6\n70000 1\n255\n\x00\x00\x00"),  // Too wide
+        PNM_TEST_IMAGE("P6\n1\n"),                         // Truncated header
+        PNM_TEST_IMAGE("P6 -1 1 255\n\x00\x00\x00")        // Negative dimension
+    };
+    const char oversized_header[] = "P6\n65535 21846\n255\n";
+    uint8_t k = 0;
+    uint8_t * oversized = calloc(1, sizeof(oversized_header) - 1 + 65534);
+    Image_t * img = create_image(4, 4, YUV420p);
+
+    for (k = 0; k < 10; k++) {
+        CUTS_ASSERT(!decode_pnm_image((const uint8_t *) images[k].data, images[k].size),
+                    "Image %d should be rejected", k);
+    }
+    CUTS_ASSERT(!decode_pnm_image(NULL, 10), "NULL data should be rejected");
+    CUTS_ASSERT(!load_pnm_image("/nonexistent/image.ppm"), "Missing files should be rejected");
+    CUTS_ASSERT(!save_pnm_image(img, "/tmp/libuimg_test.ppm"), "Formats other than RGB24/GRAYSCALE should be rejected");
+
+    // 65535x21846 RGB24 images take more than 4 GB, whose size wraps around to 65,534 bytes in 32 bits
+    memcpy(oversized, oversized_header, sizeof(oversized_header) - 1);
+    CUTS_ASSERT(!decode_pnm_image(oversized, sizeof(oversized_header) - 1 + 65534), "Oversized images should be "
+                "rejected");
+
+    free(oversized);
+    destroy_image(img);
+
+    return NULL;
+}
+
+
+char * test_pnm_fuzzing ()
+{
+    uint32_t i = 0;
+    uint32_t seed = 1;
+    uint32_t size = 0;
+    uint8_t data[64];
+    Image_t * img = NULL;
+
+    // Mutated headers must either be rejected, or give an image whose pixel data fits in the input
+    for (i = 0; i < TEST_FUZZ_ITERATIONS; i++) {
+        size = snprintf((char *) data, sizeof(data), "P%c\n# c\n%u %u\n%u\n", (i % 2) ? '6' : '5', 1 + i % 5,
+                        1 + i % 3, 255 - i % 7);
+        memset(data + size, 0x55, sizeof(data) - size);
+
+        seed = seed * 1103515245 + 12345;
+        data[(seed >> 16) % size] = seed >> 8;
+        seed = seed * 1103515245 + 12345;
+        if (seed & 0x100) data[(seed >> 16) % size] = "P56 #\n0123456789"[(seed >> 9) % 16];
+        seed = seed * 1103515245 + 12345;
+
+        size = (seed & 0x200) ? (seed >> 16) % sizeof(data) : sizeof(data);
+        img = decode_pnm_image(data, size);
+        if (!img) continue;
+
+        CUTS_ASSERT(get_image_data_size(img->width, img->height, img->format) < size,
+                    "Image larger than its input was decoded");
+        destroy_image(img);
+    }
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_pnm_round_trip);
+    CUTS_RUN_TEST(test_pnm_header_parsing);
+    CUTS_RUN_TEST(test_incorrect_pnm_images);
+    CUTS_RUN_TEST(test_pnm_fuzzing);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
@@ -0,0 +1,213 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+#include <unistd.h>
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+#define TEST_FRAME_COUNT 5
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+// Write raw data to a new temporary file, and return its path
+static char * write_temporary_file (const uint8_t * data, uint32_t size)
+{
+    static char path[32];
+    FILE * f = NULL;
+    int fd = -1;
+
+    strcpy(path, "/tmp/libuimg_test_XXXXXX");
+    fd = mkstemp(path);
+    if (fd < 0) return NULL;
+    close(fd);
+
+    f = fopen(path, "wb");
+    if (!f) return NULL;
+    if (size) fwrite(data, 1, size, f);
+    fclose(f);
+
+    return path;
+}
+
+
+char * test_raw_file_frames ()
+{
+    uint32_t i = 0;
+    uint32_t frame_size = get_image_data_size(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    uint8_t * data = malloc(frame_size * TEST_FRAME_COUNT + 10);
+    char * path = NULL;
+    RawFile_t file;
+    Image_t frame;
+
+    for (i = 0; i < frame_size * TEST_FRAME_COUNT + 10; i++) {
+        data[i] = i * 7;
+    }
+    // Trailing bytes that do not make up a whole frame
+    path = write_temporary_file(data, frame_size * TEST_FRAME_COUNT + 10);
+    CUTS_ASSERT(path, "Could not write temporary file");
+
+    CUTS_ASSERT(open_raw_file(&file, path, TEST_WIDTH, TEST_HEIGHT, YUV420p, RAW_FILE_READ_ONLY),
+                "Could not open raw file");
+    CUTS_ASSERT(file.frame_count == TEST_FRAME_COUNT, "Expected %d frames, got %d", TEST_FRAME_COUNT,
+                file.frame_count);
+
+    // Frames are views into the file
+    for (i = 0; i < TEST_FRAME_COUNT; i++) {
+        CUTS_ASSERT(get_raw_file_frame(&file, i, &frame), "Could not get frame %d", i);
+        CUTS_ASSERT(frame.width == TEST_WIDTH && frame.height == TEST_HEIGHT && frame.format == YUV420p,
+                    "Frame %d has wrong dimensions or format", i);
+        CUTS_ASSERT(!memcmp(frame.data, data + i * frame_size, frame_size), "Frame %d has wrong data", i);
+    }
+    CUTS_ASSERT(!get_raw_file_frame(&file, TEST_FRAME_COUNT, &frame), "Out-of-range frames should be rejected");
+
+    close_raw_file(&file);
+
+    // Copy-on-write frames can be modified without modifying the file
+    CUTS_ASSERT(open_raw_file(&file, path, TEST_WIDTH, TEST_HEIGHT, YUV420p, RAW_FILE_COPY_ON_WRITE),
+                "Could not open raw file");
+    get_raw_file_frame(&file, 2, &frame);
+    CUTS_ASSERT(flipX_image(&frame), "Could not flip copy-on-write frame");
+    close_raw_file(&file);
+
+    CUTS_ASSERT(open_raw_file(&file, path, TEST_WIDTH, TEST_HEIGHT, YUV420p, RAW_FILE_READ_ONLY),
+                "Could not open raw file");
+    get_raw_file_frame(&file, 2, &frame);
+    CUTS_ASSERT(!memcmp(frame.data, data + 2 * frame_size, frame_size), "Copy-on-write frame modified the file");
+    close_raw_file(&file);
+
+    remove(path);
+    free(data);
+
+    return NULL;
+}
+
+
+char * test_raw_file_creation ()
+{
+    uint32_t i = 0;
+    char * path = write_temporary_file(NULL, 0);
+    Image_t * img = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * converted_img = create_image(TEST_WIDTH, TEST_HEIGHT, YUV444p);
+    RawFile_t file;
+    Image_t frame;
+
+    CUTS_ASSERT(path, "Could not create temporary file");
+    CUTS_ASSERT(create_raw_file(&file, path, TEST_WIDTH, TEST_HEIGHT, YUV444p, TEST_FRAME_COUNT),
+                "Could not create raw file");
+
+    // Convert straight into the frames of the file
+    for (i = 0; i < TEST_FRAME_COUNT; i++) {
+        fill_pseudo_random(img, i);
+        CUTS_ASSERT(get_raw_file_frame(&file, i, &frame), "Could not get frame %d", i);
+        CUTS_ASSERT(convert_image(img, &frame), "Could not convert into frame %d", i);
+    }
+    close_raw_file(&file);
+
+    CUTS_ASSERT(open_raw_file(&file, path, TEST_WIDTH, TEST_HEIGHT, YUV444p, RAW_FILE_READ_ONLY),
+                "Could not open raw file");
+    CUTS_ASSERT(file.frame_count == TEST_FRAME_COUNT, "Expected %d frames, got %d", TEST_FRAME_COUNT,
+                file.frame_count);
+
+    for (i = 0; i < TEST_FRAME_COUNT; i++) {
+        fill_pseudo_random(img, i);
+        convert_image(img, converted_img);
+        get_raw_file_frame(&file, i, &frame);
+        CUTS_ASSERT(!memcmp(frame.data, converted_img->data, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, YUV444p)),
+                    "Frame %d was not written to the file", i);
+    }
+    close_raw_file(&file);
+
+    remove(path);
+    destroy_image(img);
+    destroy_image(converted_img);
+
+    return NULL;
+}
+
+
+char * test_raw_image_load_save ()
+{
+    uint8_t plane = 0;
+    uint16_t row = 0;
+    char * path = write_temporary_file(NULL, 0);
+    Image_t * parent_img = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t * img = create_image(20, 16, YUV420p);
+    Image_t view;
+
+    CUTS_ASSERT(path, "Could not create temporary file");
+    fill_pseudo_random(parent_img, 1);
+    CUTS_ASSERT(create_image_view(parent_img, 4, 2, 20, 16, &view), "Could not create view");
+
+    // Views are saved tightly packed
+    CUTS_ASSERT(save_raw_image(&view, path), "Could not save image");
+    CUTS_ASSERT(load_raw_image(path, img), "Could not load image");
+
+    for (plane = 0; plane < 3; plane++) {
+        for (row = 0; row < get_image_plane_height(16, YUV420p, plane); row++) {
+            CUTS_ASSERT(!memcmp(get_image_row(img, plane, row), get_image_row(&view, plane, row),
+                                get_image_row_size(20, YUV420p, plane)),
+                        "Row %d of plane %d differs after saving and loading", row, plane);
+        }
+    }
+
+    remove(path);
+    destroy_image(parent_img);
+    destroy_image(img);
+
+    return NULL;
+}
+
+
+char * test_incorrect_raw_files ()
+{
+    uint8_t data[16] = { 0 };
+    char * path = write_temporary_file(data, sizeof(data));
+    RawFile_t file;
+    Image_t frame;
+    Image_t * img = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+
+    CUTS_ASSERT(path, "Could not write temporary file");
+    CUTS_ASSERT(!open_raw_file(&file, path, TEST_WIDTH, TEST_HEIGHT, RGB24, RAW_FILE_READ_ONLY),
+                "Files smaller than a frame should be rejected");
+    CUTS_ASSERT(!open_raw_file(&file, path, 2, 2, RGB24, 3), "Unknown modes should be rejected");
+    CUTS_ASSERT(!open_raw_file(&file, "/nonexistent/file.yuv", 2, 2, RGB24, RAW_FILE_READ_ONLY),
+                "Missing files should be rejected");
+    CUTS_ASSERT(!open_raw_file(NULL, path, 2, 2, RGB24, RAW_FILE_READ_ONLY), "NULL file should be rejected");
+    CUTS_ASSERT(!get_raw_file_frame(&file, 0, &frame), "Frames of unopened files should be rejected");
+    CUTS_ASSERT(!load_raw_image(path, img), "Loading from a file smaller than a frame should fail");
+    CUTS_ASSERT(!create_raw_file(&file, path, TEST_WIDTH, TEST_HEIGHT, RGB24, 0), "Empty files should be rejected");
+    CUTS_ASSERT(!save_raw_image(img, "/nonexistent/file.rgb"), "Saving to a missing directory should fail");
+
+    remove(path);
+    destroy_image(img);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_raw_file_frames);
+    CUTS_RUN_TEST(test_raw_file_creation);
+    CUTS_RUN_TEST(test_raw_image_load_save);
+    CUTS_RUN_TEST(test_incorrect_raw_files);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
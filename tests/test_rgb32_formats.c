@@ -0,0 +1,239 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+static uint8_t same_images (const Image_t * img1, const Image_t * img2)
+{
+    return !memcmp(img1->data, img2->data, get_image_data_size(img1->width, img1->height, img1->format));
+}
+
+
+// Read a pixel of a 32-bit image as a little-endian word
+static uint32_t get_word (const Image_t * img, uint32_t x, uint32_t y)
+{
+    const uint8_t * pixel = get_image_row(img, 0, y) + x * 4;
+
+    return pixel[0] | ((uint32_t) pixel[1] << 8) | ((uint32_t) pixel[2] << 16) | ((uint32_t) pixel[3] << 24);
+}
+
+
+// Build the 32-bit word of an RGB24 pixel, with the given alpha value
+static uint32_t make_word (PixelFormat_t format, const uint8_t * rgb, uint8_t alpha)
+{
+    if (format == RGBA8888) return ((uint32_t) rgb[0] << 24) | ((uint32_t) rgb[1] << 16) | (rgb[2] << 8) | alpha;
+    if (format == BGRA8888) return ((uint32_t) rgb[2] << 24) | ((uint32_t) rgb[1] << 16) | (rgb[0] << 8) | alpha;
+
+    return ((uint32_t) alpha << 24) | ((uint32_t) rgb[0] << 16) | (rgb[1] << 8) | rgb[2];
+}
+
+
+char * test_rgb32_layouts ()
+{
+    int format = 0;
+    uint32_t x = 0;
+    uint32_t y = 0;
+    const uint8_t * rgb = NULL;
+    const uint8_t * bgr = NULL;
+    Image_t * img_rgb24 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img_bgr24 = create_image(TEST_WIDTH, TEST_HEIGHT, BGR24);
+    Image_t * img_rgb32 = NULL;
+    Image_t * img_back = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+
+    CUTS_ASSERT(get_image_data_size(TEST_WIDTH, TEST_HEIGHT, XRGB8888) == TEST_WIDTH * TEST_HEIGHT * 4,
+                "Wrong size of XRGB8888 images");
+    CUTS_ASSERT(get_image_row_size(TEST_WIDTH, RGBA8888, 0) == TEST_WIDTH * 4, "Wrong size of RGBA8888 rows");
+    CUTS_ASSERT(get_image_row_size(TEST_WIDTH, BGR24, 0) == TEST_WIDTH * 3, "Wrong size of BGR24 rows");
+
+    fill_pseudo_random(img_rgb24, 1);
+
+    CUTS_ASSERT(convert_image(img_rgb24, img_bgr24), "RGB24 -> BGR24 failed");
+    for (y = 0; y < TEST_HEIGHT; y++) {
+        for (x = 0; x < TEST_WIDTH; x++) {
+            rgb = get_image_row(img_rgb24, 0, y) + x * 3;
+            bgr = get_image_row(img_bgr24, 0, y) + x * 3;
+            CUTS_ASSERT(bgr[0] == rgb[2] && bgr[1] == rgb[1] && bgr[2] == rgb[0], "Wrong BGR24 pixel (%d, %d)", x, y);
+        }
+    }
+    CUTS_ASSERT(convert_image(img_bgr24, img_back) && same_images(img_back, img_rgb24),
+                "RGB24 -> BGR24 -> RGB24 is not lossless");
+
+    for (format = RGBA8888; format <= XRGB8888; format++) {
+        img_rgb32 = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+
+        // Pixels are little-endian words, and are made opaque
+        CUTS_ASSERT(convert_image(img_rgb24, img_rgb32), "RGB24 -> %d failed", format);
+        for (y = 0; y < TEST_HEIGHT; y++) {
+            for (x = 0; x < TEST_WIDTH; x++) {
+                rgb = get_image_row(img_rgb24, 0, y) + x * 3;
+                CUTS_ASSERT(get_word(img_rgb32, x, y) == make_word(format, rgb, 0xff),
+                            "Wrong pixel (%d, %d) of format %d", x, y, format);
+            }
+        }
+
+        memset(img_back->data, 0, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, RGB24));
+        CUTS_ASSERT(convert_image(img_rgb32, img_back), "%d -> RGB24 failed", format);
+        CUTS_ASSERT(same_images(img_back, img_rgb24), "RGB24 -> %d -> RGB24 is not lossless", format);
+
+        memset(img_back->data, 0, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, RGB24));
+        CUTS_ASSERT(convert_image(img_bgr24, img_rgb32) && convert_image(img_rgb32, img_back),
+                    "BGR24 -> %d -> RGB24 failed", format);
+        CUTS_ASSERT(same_images(img_back, img_rgb24), "BGR24 -> %d -> RGB24 is not lossless", format);
+
+        destroy_image(img_rgb32);
+    }
+
+    destroy_image(img_rgb24);
+    destroy_image(img_bgr24);
+    destroy_image(img_back);
+
+    return NULL;
+}
+
+
+char * test_rgb32_alpha ()
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t word = 0;
+    Image_t * img_rgba = create_image(TEST_WIDTH, TEST_HEIGHT, RGBA8888);
+    Image_t * img_bgra = create_image(TEST_WIDTH, TEST_HEIGHT, BGRA8888);
+    Image_t * img_xrgb = create_image(TEST_WIDTH, TEST_HEIGHT, XRGB8888);
+
+    fill_pseudo_random(img_rgba, 2);
+
+    // Alpha values are kept between formats that have them...
+    CUTS_ASSERT(convert_image(img_rgba, img_bgra), "RGBA8888 -> BGRA8888 failed");
+    for (y = 0; y < TEST_HEIGHT; y++) {
+        for (x = 0; x < TEST_WIDTH; x++) {
+            word = get_word(img_rgba, x, y);
+            // R and B swap places, G and alpha stay in place
+            CUTS_ASSERT(get_word(img_bgra, x, y) == ((((word >> 8) & 0xff) << 24) | (word & 0x00ff00ff) |
+                                                     ((word >> 24) << 8)), "Wrong BGRA8888 pixel (%d, %d)", x, y);
+        }
+    }
+
+    // ... and the unused byte of XRGB8888 pixels is always 0xff
+    CUTS_ASSERT(convert_image(img_rgba, img_xrgb), "RGBA8888 -> XRGB8888 failed");
+    for (y = 0; y < TEST_HEIGHT; y++) {
+        for (x = 0; x < TEST_WIDTH; x++) {
+            word = get_word(img_rgba, x, y);
+            CUTS_ASSERT(get_word(img_xrgb, x, y) == (0xff000000 | (word >> 8)), "Wrong XRGB8888 pixel (%d, %d)", x, y);
+        }
+    }
+    CUTS_ASSERT(convert_image(img_xrgb, img_rgba), "XRGB8888 -> RGBA8888 failed");
+    for (y = 0; y < TEST_HEIGHT; y++) {
+        for (x = 0; x < TEST_WIDTH; x++) {
+            CUTS_ASSERT((get_word(img_rgba, x, y) & 0xff) == 0xff, "RGBA8888 pixel (%d, %d) is not opaque", x, y);
+        }
+    }
+
+    destroy_image(img_rgba);
+    destroy_image(img_bgra);
+    destroy_image(img_xrgb);
+
+    return NULL;
+}
+
+
+char * test_rgb32_yuv420p_conversions ()
+{
+    int format = 0;
+    uint16_t width = 0;
+    Image_t * img_yuv420p = NULL;
+    Image_t * img_rgb24 = NULL;
+    Image_t * img_converted = NULL;
+    Image_t * img_reference = NULL;
+    Image_t * img_yuv_reference = NULL;
+
+    // Several SIMD blocks per row, with a partial one at the end
+    for (width = TEST_WIDTH; width <= 3 * SIMD_BLOCK_SIZE + 6; width += 2 * SIMD_BLOCK_SIZE + 7) {
+        for (format = BGR24; format <= XRGB8888; format++) {
+            img_yuv420p = create_image(width, TEST_HEIGHT, YUV420p);
+            img_rgb24 = create_image(width, TEST_HEIGHT, RGB24);
+            img_converted = create_image(width, TEST_HEIGHT, format);
+            img_reference = create_image(width, TEST_HEIGHT, format);
+            img_yuv_reference = create_image(width, TEST_HEIGHT, YUV420p);
+            fill_pseudo_random(img_yuv420p, width + format);
+
+            // The dedicated kernels match the conversions through RGB24
+            CUTS_ASSERT(convert_image(img_yuv420p, img_rgb24) && convert_image(img_rgb24, img_reference),
+                        "YUV420p -> RGB24 -> %d failed", format);
+            CUTS_ASSERT(convert_image(img_yuv420p, img_converted), "YUV420p -> %d failed", format);
+            CUTS_ASSERT(same_images(img_converted, img_reference), "YUV420p -> %d differs (width %d)", format, width);
+
+            CUTS_ASSERT(convert_image(img_rgb24, img_yuv_reference), "RGB24 -> YUV420p failed");
+            CUTS_ASSERT(convert_image(img_converted, img_yuv420p), "%d -> YUV420p failed", format);
+            CUTS_ASSERT(same_images(img_yuv420p, img_yuv_reference), "%d -> YUV420p differs (width %d)", format,
+                        width);
+
+            destroy_image(img_yuv420p);
+            destroy_image(img_rgb24);
+            destroy_image(img_converted);
+            destroy_image(img_reference);
+            destroy_image(img_yuv_reference);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_rgb32_flips ()
+{
+    int format = 0;
+    Image_t * img_rgb24 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img_rgb32 = NULL;
+    Image_t * img_reference = NULL;
+
+    fill_pseudo_random(img_rgb24, 3);
+
+    for (format = BGR24; format <= XRGB8888; format++) {
+        img_rgb32 = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+        img_reference = create_image(TEST_WIDTH, TEST_HEIGHT, format);
+
+        CUTS_ASSERT(convert_image(img_rgb24, img_rgb32), "RGB24 -> %d failed", format);
+        CUTS_ASSERT(flipY_image(img_rgb24) && convert_image(img_rgb24, img_reference), "Reference flip failed");
+        CUTS_ASSERT(flipY_image(img_rgb32), "Flip of format %d failed", format);
+        CUTS_ASSERT(same_images(img_rgb32, img_reference), "Flip of format %d is wrong", format);
+        CUTS_ASSERT(flipY_image(img_rgb24), "Reference flip failed");
+
+        destroy_image(img_rgb32);
+        destroy_image(img_reference);
+    }
+
+    destroy_image(img_rgb24);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_rgb32_layouts);
+    CUTS_RUN_TEST(test_rgb32_alpha);
+    CUTS_RUN_TEST(test_rgb32_yuv420p_conversions);
+    CUTS_RUN_TEST(test_rgb32_flips);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
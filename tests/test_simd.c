@@ -0,0 +1,644 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+// Odd block size, so that both the SIMD kernels and the scalar tail get exercised
+#define TEST_BLOCK_SIZE (SIMD_BLOCK_SIZE - 1)
+
+
+char * test_simd_features ()
+{
+    uint8_t features = get_simd_features();
+
+    CUTS_ASSERT((features & ~(SIMD_SSE2 | SIMD_SSSE3 | SIMD_AVX2 | SIMD_AVX512 | SIMD_NEON)) == 0,
+                "Unknown SIMD features reported: 0x%02x", features);
+    CUTS_ASSERT(get_simd_features() == features, "SIMD features changed between calls");
+
+    return NULL;
+}
+
+
+char * test_forced_simd_features ()
+{
+    uint8_t levels[6] = {
+        SIMD_SSE2,
+        SIMD_SSE2 | SIMD_SSSE3,
+        SIMD_SSE2 | SIMD_SSSE3 | SIMD_AVX2,
+        SIMD_SSE2 | SIMD_SSSE3 | SIMD_AVX2 | SIMD_AVX512,
+        SIMD_NEON,
+        0xff
+    };
+    uint8_t all_features = set_simd_features(0xff);
+    uint8_t features = 0;
+    uint8_t k = 0;
+    uint32_t i = 0;
+    uint32_t seed = 1;
+    uint8_t in[3][SIMD_BLOCK_SIZE];
+    uint8_t pixels[SIMD_BLOCK_SIZE * 3];
+    uint8_t scalar_out[3][SIMD_BLOCK_SIZE];
+    uint8_t scalar_pixels[SIMD_BLOCK_SIZE * 3];
+    uint8_t out[3][SIMD_BLOCK_SIZE];
+
+    for (i = 0; i < SIMD_BLOCK_SIZE * 3; i++) {
+        seed = seed * 1103515245 + 12345;
+        in[i % 3][i / 3] = seed >> 16;
+        pixels[i] = seed >> 8;
+    }
+
+    CUTS_ASSERT(set_simd_features(SIMD_NONE) == SIMD_NONE && get_simd_features() == SIMD_NONE,
+                "SIMD features could not be turned off");
+    convert_color_block(&yuv_to_rgb_matrix, in[0], in[1], in[2], scalar_out[0], scalar_out[1], scalar_out[2],
+                        SIMD_BLOCK_SIZE);
+    interleave_24bpp_block(in[0], in[1], in[2], scalar_pixels, SIMD_BLOCK_SIZE);
+
+    // Every level the CPU supports (at least in part) must give the same results as the scalar kernels
+    for (k = 0; k < 6; k++) {
+        features = set_simd_features(levels[k]);
+        CUTS_ASSERT(features == (levels[k] & all_features), "Level 0x%02x gave features 0x%02x", levels[k], features);
+
+        convert_color_block(&yuv_to_rgb_matrix, in[0], in[1], in[2], out[0], out[1], out[2], SIMD_BLOCK_SIZE);
+        CUTS_ASSERT(!memcmp(out, scalar_out, sizeof(out)), "Color block differs with features 0x%02x", features);
+
+        memset(pixels, 0, sizeof(pixels));
+        interleave_24bpp_block(in[0], in[1], in[2], pixels, SIMD_BLOCK_SIZE);
+        CUTS_ASSERT(!memcmp(pixels, scalar_pixels, sizeof(pixels)), "Interleaved block differs with features 0x%02x",
+                    features);
+
+        memset(out, 0, sizeof(out));
+        deinterleave_24bpp_block(pixels, out[0], out[1], out[2], SIMD_BLOCK_SIZE);
+        CUTS_ASSERT(!memcmp(out, in, sizeof(out)), "Deinterleaved block differs with features 0x%02x", features);
+    }
+
+    CUTS_ASSERT(get_simd_features() == all_features, "SIMD features were not restored");
+
+    return NULL;
+}
+
+
+char * test_24bpp_blocks ()
+{
+    uint32_t i = 0;
+    uint32_t count = 0;
+    uint8_t pixels[SIMD_BLOCK_SIZE * 3 + 1];
+    uint8_t channels[3][SIMD_BLOCK_SIZE + 1];
+
+    // Every size, so that both the SIMD kernels and the scalar tail get exercised
+    for (count = 0; count <= SIMD_BLOCK_SIZE; count++) {
+        for (i = 0; i < SIMD_BLOCK_SIZE * 3; i++) {
+            pixels[i] = i * 7 + count;
+        }
+        memset(channels, 0xaa, sizeof(channels));
+
+        deinterleave_24bpp_block(pixels, channels[0], channels[1], channels[2], count);
+        for (i = 0; i < count; i++) {
+            CUTS_ASSERT(channels[0][i] == pixels[i * 3] && channels[1][i] == pixels[i * 3 + 1] &&
+                        channels[2][i] == pixels[i * 3 + 2], "Pixel %u of a block of %u was not split", i, count);
+        }
+        CUTS_ASSERT(channels[0][count] == 0xaa && channels[1][count] == 0xaa && channels[2][count] == 0xaa,
+                    "Splitting a block of %u wrote past its end", count);
+
+        memset(pixels, 0xaa, sizeof(pixels));
+        interleave_24bpp_block(channels[0], channels[1], channels[2], pixels, count);
+        for (i = 0; i < count; i++) {
+            CUTS_ASSERT(pixels[i * 3] == channels[0][i] && pixels[i * 3 + 1] == channels[1][i] &&
+                        pixels[i * 3 + 2] == channels[2][i], "Pixel %u of a block of %u was not merged", i, count);
+        }
+        CUTS_ASSERT(pixels[count * 3] == 0xaa, "Merging a block of %u wrote past its end", count);
+    }
+
+    return NULL;
+}
+
+
+char * test_16bpp_blocks ()
+{
+    uint8_t levels[4] = { SIMD_NONE, SIMD_SSE2, SIMD_SSE2 | SIMD_AVX2, SIMD_NEON };
+    uint8_t all_features = set_simd_features(0xff);
+    uint8_t k = 0;
+    uint32_t i = 0;
+    uint32_t count = 0;
+    uint8_t pairs[SIMD_BLOCK_SIZE * 2 + 1];
+    uint8_t channels[2][SIMD_BLOCK_SIZE + 1];
+
+    // Every size with every kernel, so that both the SIMD kernels and the scalar tail get exercised
+    for (k = 0; k < 4; k++) {
+        set_simd_features(levels[k]);
+
+        for (count = 0; count <= SIMD_BLOCK_SIZE; count++) {
+            for (i = 0; i < SIMD_BLOCK_SIZE * 2; i++) {
+                pairs[i] = i * 7 + count;
+            }
+            memset(channels, 0xaa, sizeof(channels));
+
+            deinterleave_16bpp_block(pairs, channels[0], channels[1], count);
+            for (i = 0; i < count; i++) {
+                CUTS_ASSERT(channels[0][i] == pairs[i * 2] && channels[1][i] == pairs[i * 2 + 1],
+                            "Pair %u of a block of %u was not split (level 0x%02x)", i, count, levels[k]);
+            }
+            CUTS_ASSERT(channels[0][count] == 0xaa && channels[1][count] == 0xaa,
+                        "Splitting a block of %u wrote past its end (level 0x%02x)", count, levels[k]);
+
+            memset(pairs, 0xaa, sizeof(pairs));
+            interleave_16bpp_block(channels[0], channels[1], pairs, count);
+            for (i = 0; i < count; i++) {
+                CUTS_ASSERT(pairs[i * 2] == channels[0][i] && pairs[i * 2 + 1] == channels[1][i],
+                            "Pair %u of a block of %u was not merged (level 0x%02x)", i, count, levels[k]);
+            }
+            CUTS_ASSERT(pairs[count * 2] == 0xaa, "Merging a block of %u wrote past its end (level 0x%02x)", count,
+                        levels[k]);
+        }
+    }
+
+    set_simd_features(all_features);
+
+    return NULL;
+}
+
+
+char * test_32bpp_blocks ()
+{
+    uint8_t levels[4] = { SIMD_NONE, SIMD_SSE2, SIMD_SSE2 | SIMD_AVX2, SIMD_NEON };
+    uint8_t all_features = set_simd_features(0xff);
+    uint8_t k = 0;
+    uint8_t c = 0;
+    uint32_t i = 0;
+    uint32_t count = 0;
+    uint8_t pixels[SIMD_BLOCK_SIZE * 4 + 1];
+    uint8_t channels[4][SIMD_BLOCK_SIZE + 1];
+
+    // Every size with every kernel, so that both the SIMD kernels and the scalar tail get exercised
+    for (k = 0; k < 4; k++) {
+        set_simd_features(levels[k]);
+
+        for (count = 0; count <= SIMD_BLOCK_SIZE; count++) {
+            for (i = 0; i < SIMD_BLOCK_SIZE * 4; i++) {
+                pixels[i] = i * 7 + count;
+            }
+            memset(channels, 0xaa, sizeof(channels));
+
+            deinterleave_32bpp_block(pixels, channels[0], channels[1], channels[2], channels[3], count);
+            for (i = 0; i < count; i++) {
+                for (c = 0; c < 4; c++) {
+                    CUTS_ASSERT(channels[c][i] == pixels[i * 4 + c],
+                                "Pixel %u of a block of %u was not split (level 0x%02x)", i, count, levels[k]);
+                }
+            }
+            for (c = 0; c < 4; c++) {
+                CUTS_ASSERT(channels[c][count] == 0xaa, "Splitting a block of %u wrote past its end (level 0x%02x)",
+                            count, levels[k]);
+            }
+
+            memset(pixels, 0xaa, sizeof(pixels));
+            interleave_32bpp_block(channels[0], channels[1], channels[2], channels[3], pixels, count);
+            for (i = 0; i < count; i++) {
+                for (c = 0; c < 4; c++) {
+                    CUTS_ASSERT(pixels[i * 4 + c] == channels[c][i],
+                                "Pixel %u of a block of %u was not merged (level 0x%02x)", i, count, levels[k]);
+                }
+            }
+            CUTS_ASSERT(pixels[count * 4] == 0xaa, "Merging a block of %u wrote past its end (level 0x%02x)", count,
+                        levels[k]);
+        }
+    }
+
+    set_simd_features(all_features);
+
+    return NULL;
+}
+
+
+// round(x / 255), computed independently from the kernels
+static uint32_t round_div255 (uint32_t x)
+{
+    return (2 * x + 255) / 510;
+}
+
+
+char * test_blend_blocks ()
+{
+    uint8_t levels[4] = { SIMD_NONE, SIMD_SSE2, SIMD_SSE2 | SIMD_AVX2, SIMD_NEON };
+    uint8_t all_features = set_simd_features(0xff);
+    uint8_t k = 0;
+    uint32_t i = 0;
+    uint32_t a = 0;
+    uint32_t d = 0;
+    uint32_t expected = 0;
+    uint8_t colors[256 + 1];
+    uint8_t alpha[256 + 1];
+    uint8_t premultiplied[256 + 1];
+    uint8_t dst[256 + 1];
+
+    // Every color, alpha and destination value with every kernel; blocks of 255 pixels exercise the scalar tail too
+    for (k = 0; k < 4; k++) {
+        set_simd_features(levels[k]);
+
+        for (a = 0; a < 256; a++) {
+            for (i = 0; i < 256; i++) {
+                colors[i] = i;
+                alpha[i] = a;
+            }
+            memset(premultiplied, 0xaa, sizeof(premultiplied));
+
+            premultiply_8bpp_block(colors, alpha, premultiplied, 255);
+            for (i = 0; i < 255; i++) {
+                CUTS_ASSERT(premultiplied[i] == round_div255(i * a),
+                            "%u premultiplied by %u gave %u (level 0x%02x)", i, a, premultiplied[i], levels[k]);
+            }
+            CUTS_ASSERT(premultiplied[255] == 0xaa, "Premultiplying wrote past the end of the block (level 0x%02x)",
+                        levels[k]);
+
+            // In place, as `blend_image()` does
+            premultiply_8bpp_block(colors, alpha, colors, 256);
+            CUTS_ASSERT(colors[255] == round_div255(255 * a), "In-place premultiplication failed (level 0x%02x)",
+                        levels[k]);
+
+            for (d = 0; d < 256; d++) {
+                for (i = 0; i < 256; i++) {
+                    dst[i] = d;
+                }
+                dst[256] = 0xaa;
+
+                blend_8bpp_block(colors, alpha, dst, 256);
+                for (i = 0; i < 256; i++) {
+                    expected = colors[i] + round_div255(d * (255 - a));
+                    CUTS_ASSERT(dst[i] == expected, "%u over %u with alpha %u gave %u (level 0x%02x)", colors[i], d, a,
+                                dst[i], levels[k]);
+                }
+                CUTS_ASSERT(dst[256] == 0xaa, "Blending wrote past the end of the block (level 0x%02x)", levels[k]);
+            }
+        }
+    }
+
+    set_simd_features(all_features);
+
+    return NULL;
+}
+
+
+// Downsampled value of a pair of chroma values of one or two rows, computed independently from the kernels
+static uint8_t reference_chroma_sample (const uint8_t * row0, const uint8_t * row1, uint32_t x, uint32_t count,
+                                        ChromaSiting_t siting)
+{
+    uint32_t right = (2 * x + 1 < count) ? 2 * x + 1 : 2 * x;
+
+    if (siting == CHROMA_SITING_TOP_LEFT || (siting == CHROMA_SITING_LEFT && !row1)) return row0[2 * x];
+    if (siting == CHROMA_SITING_LEFT) return (row0[2 * x] + row1[2 * x] + 1) / 2;
+    if (!row1) return (row0[2 * x] + row0[right] + 1) / 2;
+
+    return (row0[2 * x] + row0[right] + row1[2 * x] + row1[right] + 2) / 4;
+}
+
+
+char * test_downsample_chroma_blocks ()
+{
+    uint8_t levels[3] = { SIMD_NONE, SIMD_SSE2, SIMD_NEON };
+    ChromaSiting_t sitings[3] = { CHROMA_SITING_CENTER, CHROMA_SITING_LEFT, CHROMA_SITING_TOP_LEFT };
+    uint8_t all_features = set_simd_features(0xff);
+    uint8_t k = 0;
+    uint8_t s = 0;
+    uint8_t r = 0;
+    uint32_t i = 0;
+    uint32_t count = 0;
+    uint8_t expected = 0;
+    uint8_t row0[TEST_BLOCK_SIZE];
+    uint8_t row1[TEST_BLOCK_SIZE];
+    uint8_t out[TEST_BLOCK_SIZE / 2 + 2];
+
+    for (i = 0; i < TEST_BLOCK_SIZE; i++) {
+        row0[i] = (i * 73 + 11) & 0xff;
+        row1[i] = (i * 151 + 200) & 0xff;
+    }
+
+    // Every siting with every kernel, with one or two rows, and with odd and even pixel counts
+    for (k = 0; k < 3; k++) {
+        set_simd_features(levels[k]);
+
+        for (s = 0; s < 3; s++) {
+            for (r = 1; r <= 2; r++) {
+                for (count = TEST_BLOCK_SIZE - 1; count <= TEST_BLOCK_SIZE; count++) {
+                    memset(out, 0xaa, sizeof(out));
+
+                    downsample_chroma_block(row0, (r > 1) ? row1 : NULL, out, count, sitings[s]);
+                    for (i = 0; i < (count + 1) / 2; i++) {
+                        expected = reference_chroma_sample(row0, (r > 1) ? row1 : NULL, i, count, sitings[s]);
+                        CUTS_ASSERT(out[i] == expected, "Sample %u of %u rows with siting %u gave %u instead of %u "
+                                    "(level 0x%02x)", i, r, sitings[s], out[i], expected, levels[k]);
+                    }
+                    CUTS_ASSERT(out[(count + 1) / 2] == 0xaa, "Downsampling wrote past the end of the block "
+                                "(level 0x%02x)", levels[k]);
+                }
+            }
+        }
+    }
+
+    set_simd_features(all_features);
+
+    return NULL;
+}
+
+
+char * test_yuv_to_rgb_color_block ()
+{
+    int y = 0;
+    int u = 0;
+    int v = 0;
+    int k = 0;
+    int count = 0;
+    uint8_t y_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t u_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t v_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t r_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t g_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t b_block[TEST_BLOCK_SIZE] = { 0 };
+
+    // Exhaustively compare the block conversion against the per-pixel functions
+    for (y = 0; y < 256; y++) {
+        for (u = 0; u < 256; u++) {
+            for (v = 0; v < 256; v += count) {
+                count = (256 - v < TEST_BLOCK_SIZE) ? 256 - v : TEST_BLOCK_SIZE;
+
+                for (k = 0; k < count; k++) {
+                    y_block[k] = y;
+                    u_block[k] = u;
+                    v_block[k] = v + k;
+                }
+
+                convert_color_block(&yuv_to_rgb_matrix, y_block, u_block, v_block, r_block, g_block, b_block, count);
+
+                for (k = 0; k < count; k++) {
+                    CUTS_ASSERT(r_block[k] == yuv_to_rgb_r(y, u, v + k),
+                                "R mismatch for (%d, %d, %d): expected %d, got %d",
+                                y, u, v + k, yuv_to_rgb_r(y, u, v + k), r_block[k]);
+                    CUTS_ASSERT(g_block[k] == yuv_to_rgb_g(y, u, v + k),
+                                "G mismatch for (%d, %d, %d): expected %d, got %d",
+                                y, u, v + k, yuv_to_rgb_g(y, u, v + k), g_block[k]);
+                    CUTS_ASSERT(b_block[k] == yuv_to_rgb_b(y, u, v + k),
+                                "B mismatch for (%d, %d, %d): expected %d, got %d",
+                                y, u, v + k, yuv_to_rgb_b(y, u, v + k), b_block[k]);
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_rgb_to_yuv_color_block ()
+{
+    int r = 0;
+    int g = 0;
+    int b = 0;
+    int k = 0;
+    int count = 0;
+    uint8_t r_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t g_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t b_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t y_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t u_block[TEST_BLOCK_SIZE] = { 0 };
+    uint8_t v_block[TEST_BLOCK_SIZE] = { 0 };
+
+    // Exhaustively compare the block conversion against the per-pixel functions
+    for (r = 0; r < 256; r++) {
+        for (g = 0; g < 256; g++) {
+            for (b = 0; b < 256; b += count) {
+                count = (256 - b < TEST_BLOCK_SIZE) ? 256 - b : TEST_BLOCK_SIZE;
+
+                for (k = 0; k < count; k++) {
+                    r_block[k] = r;
+                    g_block[k] = g;
+                    b_block[k] = b + k;
+                }
+
+                convert_color_block(&rgb_to_yuv_matrix, r_block, g_block, b_block, y_block, u_block, v_block, count);
+
+                for (k = 0; k < count; k++) {
+                    CUTS_ASSERT(y_block[k] == rgb_to_yuv_y(r, g, b + k),
+                                "Y mismatch for (%d, %d, %d): expected %d, got %d",
+                                r, g, b + k, rgb_to_yuv_y(r, g, b + k), y_block[k]);
+                    CUTS_ASSERT(u_block[k] == rgb_to_yuv_u(r, g, b + k),
+                                "U mismatch for (%d, %d, %d): expected %d, got %d",
+                                r, g, b + k, rgb_to_yuv_u(r, g, b + k), u_block[k]);
+                    CUTS_ASSERT(v_block[k] == rgb_to_yuv_v(r, g, b + k),
+                                "V mismatch for (%d, %d, %d): expected %d, got %d",
+                                r, g, b + k, rgb_to_yuv_v(r, g, b + k), v_block[k]);
+                }
+            }
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_partial_color_block ()
+{
+    int k = 0;
+    uint8_t r_block[SIMD_BLOCK_SIZE] = { 0 };
+    uint8_t g_block[SIMD_BLOCK_SIZE] = { 0 };
+    uint8_t b_block[SIMD_BLOCK_SIZE] = { 0 };
+    uint8_t y_block[SIMD_BLOCK_SIZE + 1] = { 0 };
+
+    for (k = 0; k < SIMD_BLOCK_SIZE; k++) {
+        r_block[k] = k * 4;
+        g_block[k] = 255 - k;
+        b_block[k] = k * 3;
+    }
+    y_block[SIMD_BLOCK_SIZE] = 0xaa;
+
+    // Only the first output channel is requested
+    convert_color_block(&rgb_to_yuv_matrix, r_block, g_block, b_block, y_block, NULL, NULL, SIMD_BLOCK_SIZE);
+
+    for (k = 0; k < SIMD_BLOCK_SIZE; k++) {
+        CUTS_ASSERT(y_block[k] == rgb_to_yuv_y(r_block[k], g_block[k], b_block[k]), "Y mismatch at index %d", k);
+    }
+    CUTS_ASSERT(y_block[SIMD_BLOCK_SIZE] == 0xaa, "Block conversion wrote past the end of the block");
+
+    return NULL;
+}
+
+
+// Pack a pixel the way `convert_YUV420p_to_RGB24()` followed by `convert_RGB24_to_RGB565()` would
+static uint16_t reference_rgb565_pixel (uint8_t y, uint8_t u, uint8_t v)
+{
+    return ((rescale_8bit_to_5bit_LUT[yuv_to_rgb_r(y, u, v)] & 0x1f) << 11) |
+           ((rescale_8bit_to_6bit_LUT[yuv_to_rgb_g(y, u, v)] & 0x3f) << 5) |
+           (rescale_8bit_to_5bit_LUT[yuv_to_rgb_b(y, u, v)] & 0x1f);
+}
+
+
+char * test_yuv420p_to_rgb565_block ()
+{
+    int y = 0;
+    int u = 0;
+    int v = 0;
+    int k = 0;
+    int count = 0;
+    uint8_t swap = 0;
+    uint16_t expected = 0;
+    uint8_t y_rows[2][TEST_BLOCK_SIZE] = { { 0 } };
+    uint8_t u_row[TEST_BLOCK_SIZE / 2 + 1] = { 0 };
+    uint8_t v_row[TEST_BLOCK_SIZE / 2 + 1] = { 0 };
+    uint8_t rgb565_rows[2][TEST_BLOCK_SIZE * 2 + 1] = { { 0 } };
+
+    rgb565_rows[0][TEST_BLOCK_SIZE * 2] = 0xaa;
+    rgb565_rows[1][TEST_BLOCK_SIZE * 2] = 0xaa;
+
+    // Exhaustively compare the direct kernel against the per-pixel functions; the second row has other Y values, and
+    // every pair of pixels has other V values
+    for (swap = 0; swap < 2; swap++) {
+        for (y = 0; y < 256; y++) {
+            for (u = 0; u < 256; u++) {
+                for (v = 0; v < 256; v += (count + 1) / 2) {
+                    count = (2 * (256 - v) < TEST_BLOCK_SIZE) ? 2 * (256 - v) : TEST_BLOCK_SIZE;
+
+                    for (k = 0; k < count; k++) {
+                        y_rows[0][k] = y;
+                        y_rows[1][k] = 255 - y;
+                        u_row[k / 2] = u;
+                        v_row[k / 2] = v + k / 2;
+                    }
+
+                    convert_YUV420p_to_RGB565_block(&yuv_to_rgb_matrix, y_rows[0], y_rows[1], u_row, v_row,
+                                                    rgb565_rows[0], rgb565_rows[1], count, swap);
+
+                    for (k = 0; k < count; k++) {
+                        expected = reference_rgb565_pixel(y, u, v + k / 2);
+                        CUTS_ASSERT(rgb565_rows[0][k * 2 + swap] == (expected & 0xff) &&
+                                    rgb565_rows[0][k * 2 + !swap] == (expected >> 8),
+                                    "RGB565 mismatch for (%d, %d, %d) (swap %d)", y, u, v + k / 2, swap);
+                        expected = reference_rgb565_pixel(255 - y, u, v + k / 2);
+                        CUTS_ASSERT(rgb565_rows[1][k * 2 + swap] == (expected & 0xff) &&
+                                    rgb565_rows[1][k * 2 + !swap] == (expected >> 8),
+                                    "RGB565 mismatch for (%d, %d, %d) (swap %d)", 255 - y, u, v + k / 2, swap);
+                    }
+                }
+            }
+        }
+    }
+    CUTS_ASSERT(rgb565_rows[0][TEST_BLOCK_SIZE * 2] == 0xaa && rgb565_rows[1][TEST_BLOCK_SIZE * 2] == 0xaa,
+                "Block conversion wrote past the end of the block");
+
+    // A single row must leave the second one untouched
+    memset(rgb565_rows[1], 0xaa, TEST_BLOCK_SIZE * 2);
+    convert_YUV420p_to_RGB565_block(&yuv_to_rgb_matrix, y_rows[0], NULL, u_row, v_row, rgb565_rows[0], NULL,
+                                    TEST_BLOCK_SIZE, 0);
+    for (k = 0; k < TEST_BLOCK_SIZE * 2; k++) {
+        CUTS_ASSERT(rgb565_rows[1][k] == 0xaa, "Single-row block conversion wrote to the second row");
+    }
+
+    return NULL;
+}
+
+
+// Basis functions of the reference IDCT, averaged over the full-size samples each output sample covers (indexed by
+// frequency, then sample), for output blocks of 8, 4, 2 and 1 samples
+static const double reference_basis_8[8][8] = {
+    {  0.353553391,  0.353553391,  0.353553391,  0.353553391,  0.353553391,  0.353553391,  0.353553391,  0.353553391 },
+    {  0.490392640,  0.415734806,  0.277785117,  0.097545161, -0.097545161, -0.277785117, -0.415734806, -0.490392640 },
+    {  0.461939766,  0.191341716, -0.191341716, -0.461939766, -0.461939766, -0.191341716,  0.191341716,  0.461939766 },
+    {  0.415734806, -0.097545161, -0.490392640, -0.277785117,  0.277785117,  0.490392640,  0.097545161, -0.415734806 },
+    {  0.353553391, -0.353553391, -0.353553391,  0.353553391,  0.353553391, -0.353553391, -0.353553391,  0.353553391 },
+    {  0.277785117, -0.490392640,  0.097545161,  0.415734806, -0.415734806, -0.097545161,  0.490392640, -0.277785117 },
+    {  0.191341716, -0.461939766,  0.461939766, -0.191341716, -0.191341716,  0.461939766, -0.461939766,  0.191341716 },
+    {  0.097545161, -0.277785117,  0.415734806, -0.490392640,  0.490392640, -0.415734806,  0.277785117, -0.097545161 }
+};
+
+static const double reference_basis_4[4][4] = {
+    {  0.353553391,  0.353553391,  0.353553391,  0.353553391 },
+    {  0.453063723,  0.187665139, -0.187665139, -0.453063723 },
+    {  0.326640741, -0.326640741, -0.326640741,  0.326640741 },
+    {  0.159094823, -0.384088878,  0.384088878, -0.159094823 }
+};
+
+static const double reference_basis_2[2][2] = {
+    {  0.353553391,  0.353553391 },
+    {  0.320364431, -0.320364431 }
+};
+
+static const double reference_basis_1[1][1] = {
+    {  0.353553391 }
+};
+
+
+// Floating-point reference of `idct_block()`, for an output block of `size` x `size` samples
+static int reference_idct_sample (const int16_t * coefs, uint8_t size, uint8_t x, uint8_t y)
+{
+    const double * basis = (size == 8) ? &reference_basis_8[0][0] : (size == 4) ? &reference_basis_4[0][0] :
+                           (size == 2) ? &reference_basis_2[0][0] : &reference_basis_1[0][0];
+    uint8_t u = 0;
+    uint8_t v = 0;
+    double value = 128.5;
+
+    for (v = 0; v < size; v++) {
+        for (u = 0; u < size; u++) {
+            value += basis[u * size + x] * basis[v * size + y] * coefs[v * 8 + u];
+        }
+    }
+
+    return (value < 0) ? 0 : ((value > 255) ? 255 : (int) value);
+}
+
+
+char * test_idct_block ()
+{
+    int i = 0;
+    int k = 0;
+    int error = 0;
+    uint8_t size = 0;
+    uint8_t x = 0;
+    uint8_t y = 0;
+    uint32_t seed = 1;
+    int16_t coefs[64] = { 0 };
+    uint8_t out[8 * 10] = { 0 };
+
+    for (i = 0; i < 1000; i++) {
+        // Random blocks, with fewer (and smaller) high-frequency coefficients, like actual images
+        for (k = 0; k < 64; k++) {
+            seed = seed * 1103515245 + 12345;
+            coefs[k] = ((seed >> 16) % 4 == 0 || k == 0) ? (int16_t) ((seed >> 8) % 1024) - 512 : 0;
+            coefs[k] /= 1 + k / 8 + k % 8;
+        }
+
+        for (size = 8; size >= 1; size /= 2) {
+            memset(out, 0xaa, sizeof(out));
+            idct_block(coefs, size, size, out + 8, 8);
+
+            for (y = 0; y < size; y++) {
+                for (x = 0; x < size; x++) {
+                    error = out[8 + y * 8 + x] - reference_idct_sample(coefs, size, x, y);
+                    CUTS_ASSERT(abs(error) <= 1, "IDCT mismatch at (%d, %d) of a %dx%d block: %d (expected %d)", x,
+                                y, size, size, out[8 + y * 8 + x], reference_idct_sample(coefs, size, x, y));
+                }
+            }
+            CUTS_ASSERT(out[0] == 0xaa && out[8 * 9] == 0xaa, "IDCT wrote outside of the block");
+        }
+    }
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_simd_features);
+    CUTS_RUN_TEST(test_forced_simd_features);
+    CUTS_RUN_TEST(test_24bpp_blocks);
+    CUTS_RUN_TEST(test_16bpp_blocks);
+    CUTS_RUN_TEST(test_32bpp_blocks);
+    CUTS_RUN_TEST(test_blend_blocks);
+    CUTS_RUN_TEST(test_downsample_chroma_blocks);
+    CUTS_RUN_TEST(test_yuv_to_rgb_color_block);
+    CUTS_RUN_TEST(test_rgb_to_yuv_color_block);
+    CUTS_RUN_TEST(test_partial_color_block);
+    CUTS_RUN_TEST(test_yuv420p_to_rgb565_block);
+    CUTS_RUN_TEST(test_idct_block);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
@@ -0,0 +1,228 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+// Copy the pixels of an image (or view) into another one of the same dimensions and format
+static void copy_image (const Image_t * src, Image_t * dst)
+{
+    uint8_t plane = 0;
+    uint16_t row = 0;
+
+    for (plane = 0; plane < get_image_plane_count(src->format); plane++) {
+        for (row = 0; row < get_image_plane_height(src->height, src->format, plane); row++) {
+            memcpy(get_image_row(dst, plane, row),
+                   get_image_row(src, plane, row),
+                   get_image_row_size(src->width, src->format, plane));
+        }
+    }
+}
+
+
+// Stream every conversion in slices of `slice_rows` rows, and compare against whole-frame conversions
+// If `line_buffers` is set, the slices go through separate buffers (as filled by a camera and emptied by a display);
+// otherwise, they are views on the full frames
+static char * check_streamed_conversions (uint16_t slice_rows, uint8_t flip_flags, uint8_t line_buffers)
+{
+    int base = 0;
+    int target = 0;
+    uint16_t row = 0;
+    uint16_t rows = 0;
+    ConversionStream_t stream;
+    Image_t * base_img = NULL;
+    Image_t * converted_img = NULL;
+    Image_t * streamed_img = NULL;
+    Image_t * base_slice = NULL;
+    Image_t * converted_slice = NULL;
+    Image_t base_view;
+    Image_t streamed_view;
+
+    for (base = 0; base < ASCII; base++) {
+        for (target = 0; target <= ASCII; target++) {
+            if (!conversion_function_LUT[base][target]) continue;
+
+            base_img = create_image(TEST_WIDTH, TEST_HEIGHT, base);
+            converted_img = create_image(TEST_WIDTH, TEST_HEIGHT, target);
+            streamed_img = create_image(TEST_WIDTH, TEST_HEIGHT, target);
+            fill_pseudo_random(base_img, base * 5 + target);
+
+            CUTS_ASSERT(convert_and_flip_image(base_img, converted_img, flip_flags),
+                        "Conversion %d -> %d failed", base, target);
+            CUTS_ASSERT(init_conversion_stream(&stream, TEST_WIDTH, TEST_HEIGHT, base, target, flip_flags),
+                        "Could not start stream %d -> %d", base, target);
+
+            for (row = 0; row < TEST_HEIGHT; row += rows) {
+                rows = (TEST_HEIGHT - row < slice_rows) ? TEST_HEIGHT - row : slice_rows;
+
+                CUTS_ASSERT(!is_conversion_stream_done(&stream), "Stream %d -> %d ended too early", base, target);
+                create_image_view(base_img, 0, row, TEST_WIDTH, rows, &base_view);
+                create_image_view(streamed_img, 0, row, TEST_WIDTH, rows, &streamed_view);
+
+                if (line_buffers) {
+                    base_slice = create_image(TEST_WIDTH, rows, base);
+                    converted_slice = create_image(TEST_WIDTH, rows, target);
+                    copy_image(&base_view, base_slice);
+                } else {
+                    base_slice = &base_view;
+                    converted_slice = &streamed_view;
+                }
+
+                CUTS_ASSERT(convert_stream_slice(&stream, base_slice, converted_slice),
+                            "Could not convert rows %d to %d (%d -> %d)", row, row + rows, base, target);
+
+                if (line_buffers) {
+                    copy_image(converted_slice, &streamed_view);
+                    destroy_image(base_slice);
+                    destroy_image(converted_slice);
+                }
+            }
+
+            CUTS_ASSERT(is_conversion_stream_done(&stream), "Stream %d -> %d did not end", base, target);
+            CUTS_ASSERT(!memcmp(converted_img->data,
+                                streamed_img->data,
+                                get_image_data_size(TEST_WIDTH, TEST_HEIGHT, target)),
+                        "Stream %d -> %d (%d-row slices, flags 0x%x) differs", base, target, slice_rows, flip_flags);
+
+            destroy_image(base_img);
+            destroy_image(converted_img);
+            destroy_image(streamed_img);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_streamed_conversions ()
+{
+    char * result = NULL;
+
+    result = check_streamed_conversions(2, 0, 0);
+    if (!result) result = check_streamed_conversions(4, 0, 1);
+    if (!result) result = check_streamed_conversions(6, FLIP_Y_AXIS, 0);
+    if (!result) result = check_streamed_conversions(TEST_HEIGHT, FLIP_Y_AXIS, 1);
+
+    return result;
+}
+
+
+char * test_single_row_slices ()
+{
+    uint16_t row = 0;
+    ConversionStream_t stream;
+    Image_t * base_img = create_image(TEST_WIDTH, TEST_HEIGHT, YUV444);
+    Image_t * converted_img = create_image(TEST_WIDTH, TEST_HEIGHT, RGB565);
+    Image_t * streamed_img = create_image(TEST_WIDTH, TEST_HEIGHT, RGB565);
+    Image_t base_view;
+    Image_t streamed_view;
+
+    fill_pseudo_random(base_img, 42);
+    convert_image(base_img, converted_img);
+
+    CUTS_ASSERT(init_conversion_stream(&stream, TEST_WIDTH, TEST_HEIGHT, YUV444, RGB565, 0), "Could not start stream");
+    CUTS_ASSERT(get_conversion_stream_granularity(&stream) == 1, "Packed formats should stream row by row");
+
+    // Stream two frames, to check that the stream can be restarted
+    for (row = 0; row < 2 * TEST_HEIGHT; row++) {
+        if (row == TEST_HEIGHT) {
+            CUTS_ASSERT(is_conversion_stream_done(&stream), "First frame did not end");
+            CUTS_ASSERT(reset_conversion_stream(&stream), "Could not restart stream");
+            memset(streamed_img->data, 0, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, RGB565));
+        }
+
+        create_image_view(base_img, 0, row % TEST_HEIGHT, TEST_WIDTH, 1, &base_view);
+        create_image_view(streamed_img, 0, row % TEST_HEIGHT, TEST_WIDTH, 1, &streamed_view);
+        CUTS_ASSERT(convert_stream_slice(&stream, &base_view, &streamed_view), "Could not convert row %d", row);
+    }
+
+    CUTS_ASSERT(!memcmp(converted_img->data,
+                        streamed_img->data,
+                        get_image_data_size(TEST_WIDTH, TEST_HEIGHT, RGB565)),
+                "Row by row stream differs");
+
+    destroy_image(base_img);
+    destroy_image(converted_img);
+    destroy_image(streamed_img);
+
+    return NULL;
+}
+
+
+char * test_incorrect_streams ()
+{
+    ConversionStream_t stream;
+    Image_t * rgb24_slice = create_image(TEST_WIDTH, 2, RGB24);
+    Image_t * yuv420p_slice = create_image(TEST_WIDTH, 2, YUV420p);
+    Image_t * odd_rgb24_slice = create_image(TEST_WIDTH, 3, RGB24);
+    Image_t * odd_yuv420p_slice = create_image(TEST_WIDTH, 3, YUV420p);
+    Image_t * narrow_slice = create_image(TEST_WIDTH - 1, 2, RGB24);
+
+    CUTS_ASSERT(!init_conversion_stream(NULL, TEST_WIDTH, TEST_HEIGHT, RGB24, YUV420p, 0),
+                "NULL stream should be rejected");
+    CUTS_ASSERT(!init_conversion_stream(&stream, TEST_WIDTH, TEST_HEIGHT, ASCII, RGB24, 0),
+                "Streams from ASCII should be rejected");
+    CUTS_ASSERT(!init_conversion_stream(&stream, TEST_WIDTH, TEST_HEIGHT, RGB24, RGB24, 0),
+                "Same-format streams should be rejected");
+    CUTS_ASSERT(!init_conversion_stream(&stream, TEST_WIDTH, TEST_HEIGHT, RGB24, YUV420p, FLIP_X_AXIS),
+                "X flips should be rejected");
+
+    CUTS_ASSERT(init_conversion_stream(&stream, TEST_WIDTH, TEST_HEIGHT, RGB24, YUV420p, 0), "Could not start stream");
+    CUTS_ASSERT(get_conversion_stream_granularity(&stream) == 2, "YUV420p streams should have a granularity of 2");
+    CUTS_ASSERT(!convert_stream_slice(NULL, rgb24_slice, yuv420p_slice), "NULL stream should be rejected");
+    CUTS_ASSERT(!convert_stream_slice(&stream, NULL, yuv420p_slice), "NULL base slice should be rejected");
+    CUTS_ASSERT(!convert_stream_slice(&stream, rgb24_slice, NULL), "NULL converted slice should be rejected");
+    CUTS_ASSERT(!convert_stream_slice(&stream, yuv420p_slice, rgb24_slice), "Wrong formats should be rejected");
+    CUTS_ASSERT(!convert_stream_slice(&stream, narrow_slice, yuv420p_slice), "Wrong widths should be rejected");
+    CUTS_ASSERT(!convert_stream_slice(&stream, rgb24_slice, odd_yuv420p_slice), "Different heights should be rejected");
+    CUTS_ASSERT(!convert_stream_slice(&stream, odd_rgb24_slice, odd_yuv420p_slice),
+                "Odd slices should be rejected in the middle of YUV420p frames");
+    CUTS_ASSERT(stream.next_row == 0, "Rejected slices should not move the stream forward");
+
+    // 23 rows: 10 slices of 2 rows, then a last odd slice of 3 rows
+    while (stream.next_row + 3 < TEST_HEIGHT) {
+        CUTS_ASSERT(convert_stream_slice(&stream, rgb24_slice, yuv420p_slice), "Could not convert slice");
+    }
+    CUTS_ASSERT(stream.next_row == 20 && !is_conversion_stream_done(&stream), "Stream should not end early");
+    CUTS_ASSERT(convert_stream_slice(&stream, odd_rgb24_slice, odd_yuv420p_slice), "Odd last slice should be accepted");
+    CUTS_ASSERT(is_conversion_stream_done(&stream), "Stream did not end");
+    CUTS_ASSERT(!convert_stream_slice(&stream, rgb24_slice, yuv420p_slice), "Slices past the end should be rejected");
+    CUTS_ASSERT(is_conversion_stream_done(NULL), "NULL stream should be done");
+
+    destroy_image(rgb24_slice);
+    destroy_image(yuv420p_slice);
+    destroy_image(odd_rgb24_slice);
+    destroy_image(odd_yuv420p_slice);
+    destroy_image(narrow_slice);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_streamed_conversions);
+    CUTS_RUN_TEST(test_single_row_slices);
+    CUTS_RUN_TEST(test_incorrect_streams);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
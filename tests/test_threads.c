@@ -0,0 +1,349 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+#ifdef LIBUIMG_THREADS
+#include <pthread.h>
+#endif
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+#define TEST_THREADS 4
+#define TEST_FRAMES 9
+
+
+// Caller-supplied pool running the bands on the calling thread, in reverse order
+static void reverse_run (void * context, BandTask_t task, void * arg, uint16_t band_count)
+{
+    int band = 0;
+
+    (*(int *) context)++;
+
+    for (band = band_count - 1; band >= 0; band--) {
+        task(arg, band);
+    }
+}
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+#ifdef LIBUIMG_THREADS
+static uint8_t stop_switching = 0;
+
+
+// Switch between the scalar and the fastest kernels until told to stop
+static void * switch_simd_features (void * arg)
+{
+    uint32_t k = 0;
+
+    (void) arg;
+
+    while (!__atomic_load_n(&stop_switching, __ATOMIC_ACQUIRE)) {
+        set_simd_features((k++ & 1) ? 0xff : SIMD_NONE);
+    }
+
+    return NULL;
+}
+#endif
+
+
+static char * check_conversions (uint16_t width, uint16_t height, ThreadPool_t * pool)
+{
+    int base = 0;
+    int target = 0;
+    Image_t * base_img = NULL;
+    Image_t * serial_img = NULL;
+    Image_t * parallel_img = NULL;
+
+    for (base = 0; base < ASCII; base++) {
+        for (target = 0; target <= ASCII; target++) {
+            if (!conversion_function_LUT[base][target]) continue;
+
+            base_img = create_image(width, height, base);
+            serial_img = create_image(width, height, target);
+            parallel_img = create_image(width, height, target);
+            fill_pseudo_random(base_img, base * 7 + target);
+
+            CUTS_ASSERT(convert_image(base_img, serial_img), "Serial conversion %d -> %d failed", base, target);
+            CUTS_ASSERT(convert_image_parallel(base_img, parallel_img, pool),
+                        "Parallel conversion %d -> %d failed", base, target);
+            CUTS_ASSERT(!memcmp(serial_img->data, parallel_img->data, get_image_data_size(width, height, target)),
+                        "Parallel conversion %d -> %d (%dx%d) differs", base, target, width, height);
+
+            destroy_image(base_img);
+            destroy_image(serial_img);
+            destroy_image(parallel_img);
+        }
+    }
+
+    return NULL;
+}
+
+
+static char * check_flips (uint16_t width, uint16_t height, ThreadPool_t * pool)
+{
+    int format = 0;
+    Image_t * serial_img = NULL;
+    Image_t * parallel_img = NULL;
+    uint32_t size = 0;
+
+    for (format = 0; format <= ASCII; format++) {
+        size = get_image_data_size(width, height, format);
+        serial_img = create_image(width, height, format);
+        parallel_img = create_image(width, height, format);
+        fill_pseudo_random(serial_img, format);
+        fill_pseudo_random(parallel_img, format);
+
+        CUTS_ASSERT(flipX_image(serial_img), "Serial X flip of format %d failed", format);
+        CUTS_ASSERT(flipX_image_parallel(parallel_img, pool), "Parallel X flip of format %d failed", format);
+        CUTS_ASSERT(!memcmp(serial_img->data, parallel_img->data, size),
+                    "Parallel X flip of format %d (%dx%d) differs", format, width, height);
+
+        CUTS_ASSERT(flipY_image(serial_img), "Serial Y flip of format %d failed", format);
+        CUTS_ASSERT(flipY_image_parallel(parallel_img, pool), "Parallel Y flip of format %d failed", format);
+        CUTS_ASSERT(!memcmp(serial_img->data, parallel_img->data, size),
+                    "Parallel Y flip of format %d (%dx%d) differs", format, width, height);
+
+        destroy_image(serial_img);
+        destroy_image(parallel_img);
+    }
+
+    return NULL;
+}
+
+
+static char * check_batch_conversions (uint16_t width, uint16_t height, ThreadPool_t * pool)
+{
+    int base = 0;
+    int target = 0;
+    uint32_t k = 0;
+    uint32_t base_size = 0;
+    uint32_t size = 0;
+    uint8_t * base_data = NULL;
+    uint8_t * converted_data = NULL;
+    Image_t * base_imgs[TEST_FRAMES] = { NULL };
+    Image_t * serial_imgs[TEST_FRAMES] = { NULL };
+    Image_t * batch_imgs[TEST_FRAMES] = { NULL };
+
+    for (base = 0; base < ASCII; base++) {
+        for (target = 0; target <= ASCII; target++) {
+            if (!conversion_function_LUT[base][target]) continue;
+
+            base_size = get_image_data_size(width, height, base);
+            size = get_image_data_size(width, height, target);
+            base_data = malloc(base_size * TEST_FRAMES);
+            converted_data = malloc(size * TEST_FRAMES);
+
+            for (k = 0; k < TEST_FRAMES; k++) {
+                base_imgs[k] = create_image(width, height, base);
+                serial_imgs[k] = create_image(width, height, target);
+                batch_imgs[k] = create_image(width, height, target);
+                fill_pseudo_random(base_imgs[k], base * 7 + target + k);
+                CUTS_ASSERT(convert_image(base_imgs[k], serial_imgs[k]), "Serial conversion %d -> %d failed", base,
+                            target);
+                memcpy(base_data + base_size * k, base_imgs[k]->data, base_size);
+            }
+
+            CUTS_ASSERT(convert_images_batch(base_imgs, batch_imgs, TEST_FRAMES, pool),
+                        "Batch conversion %d -> %d failed", base, target);
+            CUTS_ASSERT(convert_frames_batch(base_data, converted_data, TEST_FRAMES, width, height, base, target, pool),
+                        "Contiguous batch conversion %d -> %d failed", base, target);
+
+            for (k = 0; k < TEST_FRAMES; k++) {
+                CUTS_ASSERT(!memcmp(serial_imgs[k]->data, batch_imgs[k]->data, size),
+                            "Frame %u of batch conversion %d -> %d differs", k, base, target);
+                CUTS_ASSERT(!memcmp(serial_imgs[k]->data, converted_data + size * k, size),
+                            "Frame %u of contiguous batch conversion %d -> %d differs", k, base, target);
+                destroy_image(base_imgs[k]);
+                destroy_image(serial_imgs[k]);
+                destroy_image(batch_imgs[k]);
+            }
+
+            free(base_data);
+            free(converted_data);
+        }
+    }
+
+    return NULL;
+}
+
+
+char * test_thread_pool_init ()
+{
+    CUTS_ASSERT(!init_thread_pool(0), "Empty thread pool should be rejected");
+    CUTS_ASSERT(!init_thread_pool(LIBUIMG_MAX_THREADS + 1), "Oversized thread pool should be rejected");
+
+#ifdef LIBUIMG_THREADS
+    CUTS_ASSERT(init_thread_pool(TEST_THREADS), "Could not start thread pool");
+    CUTS_ASSERT(get_thread_pool(), "Thread pool should be available");
+    CUTS_ASSERT(get_thread_pool()->thread_count == TEST_THREADS, "Thread pool has the wrong number of threads");
+    // Resizing
+    CUTS_ASSERT(init_thread_pool(TEST_THREADS + 1), "Could not resize thread pool");
+    CUTS_ASSERT(get_thread_pool()->thread_count == TEST_THREADS + 1, "Thread pool has the wrong number of threads");
+#else
+    CUTS_ASSERT(!init_thread_pool(TEST_THREADS), "Thread pool should not be available without LIBUIMG_THREADS");
+    CUTS_ASSERT(!get_thread_pool(), "Thread pool should not be available without LIBUIMG_THREADS");
+#endif
+
+    return NULL;
+}
+
+
+char * test_internal_pool_conversions ()
+{
+    char * result = NULL;
+
+    result = check_conversions(TEST_WIDTH, TEST_HEIGHT, NULL);
+    if (!result) result = check_conversions(TEST_WIDTH, 3, NULL);
+    if (!result) result = check_conversions(5, 1, NULL);
+
+    return result;
+}
+
+
+char * test_internal_pool_flips ()
+{
+    char * result = NULL;
+
+    result = check_flips(TEST_WIDTH, TEST_HEIGHT, NULL);
+    if (!result) result = check_flips(TEST_WIDTH, 3, NULL);
+    if (!result) result = check_flips(5, 1, NULL);
+
+    return result;
+}
+
+
+char * test_internal_pool_batch_conversions ()
+{
+    return check_batch_conversions(TEST_WIDTH, TEST_HEIGHT, NULL);
+}
+
+
+char * test_caller_supplied_pool ()
+{
+    int runs = 0;
+    char * result = NULL;
+    ThreadPool_t pool = { 7, reverse_run, &runs };
+    // More threads than supported: 16384 threads of 4 bands each would wrap the band count around to 0
+    ThreadPool_t oversized_pool = { 16384, reverse_run, &runs };
+
+    result = check_conversions(TEST_WIDTH, TEST_HEIGHT, &pool);
+    if (!result) result = check_flips(TEST_WIDTH, TEST_HEIGHT, &pool);
+    if (!result) result = check_batch_conversions(TEST_WIDTH, TEST_HEIGHT, &pool);
+    if (!result) result = check_conversions(TEST_WIDTH, TEST_HEIGHT, &oversized_pool);
+    if (!result) result = check_batch_conversions(TEST_WIDTH, TEST_HEIGHT, &oversized_pool);
+    if (result) return result;
+
+    CUTS_ASSERT(runs > 0, "Caller-supplied pool was not used");
+
+    return NULL;
+}
+
+
+char * test_incorrect_parallel_operations ()
+{
+    Image_t * img1 = create_image(TEST_WIDTH, TEST_HEIGHT, RGB24);
+    Image_t * img2 = create_image(TEST_WIDTH, TEST_HEIGHT + 1, YUV420p);
+    Image_t * img3 = create_image(TEST_WIDTH, TEST_HEIGHT, ASCII);
+    Image_t * img4 = create_image(TEST_WIDTH, TEST_HEIGHT, YUV444p);
+    Image_t * mixed_imgs[2] = { img1, img4 };
+    Image_t * converted_imgs[2] = { img4, img4 };
+    Image_t unknown_img = *img4;
+    Image_t * unknown_imgs[1] = { &unknown_img };
+
+    // Formats past the end of the conversion table
+    unknown_img.format = ASCII + 1;
+
+    CUTS_ASSERT(!convert_image_parallel(NULL, img1, NULL), "NULL base image should be rejected");
+    CUTS_ASSERT(!convert_image_parallel(img1, NULL, NULL), "NULL converted image should be rejected");
+    CUTS_ASSERT(!convert_image_parallel(img1, img2, NULL), "Different dimensions should be rejected");
+    CUTS_ASSERT(!convert_image_parallel(img3, img1, NULL), "Conversions from ASCII should be rejected");
+    CUTS_ASSERT(convert_image_parallel(img1, img1, NULL), "Same-format conversion should succeed");
+    CUTS_ASSERT(!convert_images_batch(NULL, &img1, 1, NULL), "NULL base frames should be rejected");
+    CUTS_ASSERT(!convert_images_batch(&img1, &img2, 1, NULL), "Different dimensions should be rejected");
+    CUTS_ASSERT(!convert_images_batch(&img3, &img1, 1, NULL), "Conversions from ASCII should be rejected");
+    CUTS_ASSERT(!convert_images_batch(mixed_imgs, converted_imgs, 2, NULL), "Mixed base formats should be rejected");
+    CUTS_ASSERT(!convert_images_batch(&img1, unknown_imgs, 1, NULL), "Unknown converted formats should be rejected");
+    CUTS_ASSERT(!convert_images_batch(unknown_imgs, &img1, 1, NULL), "Unknown base formats should be rejected");
+    CUTS_ASSERT(convert_images_batch(&img1, &img1, 0, NULL), "Empty batches should succeed");
+    CUTS_ASSERT(!convert_frames_batch(NULL, img1->data, 1, TEST_WIDTH, TEST_HEIGHT, RGB24, YUV420p, NULL),
+                "NULL base data should be rejected");
+    CUTS_ASSERT(!convert_frames_batch(img3->data, img1->data, 1, TEST_WIDTH, TEST_HEIGHT, ASCII, RGB24, NULL),
+                "Conversions from ASCII should be rejected");
+    CUTS_ASSERT(!flipX_image_parallel(NULL, NULL), "NULL image should be rejected");
+    CUTS_ASSERT(!flipY_image_parallel(NULL, NULL), "NULL image should be rejected");
+
+    destroy_image(img1);
+    destroy_image(img2);
+    destroy_image(img3);
+    destroy_image(img4);
+
+    return NULL;
+}
+
+
+char * test_switching_simd_features ()
+{
+#ifdef LIBUIMG_THREADS
+    char * result = NULL;
+    pthread_t thread;
+    uint8_t all_features = set_simd_features(0xff);
+
+    // Results are bit-identical whatever the kernels, so switching them mid-operation must not change anything
+    CUTS_ASSERT(!pthread_create(&thread, NULL, switch_simd_features, NULL), "Switching thread could not be created");
+    result = check_conversions(TEST_WIDTH, TEST_HEIGHT, NULL);
+    __atomic_store_n(&stop_switching, 1, __ATOMIC_RELEASE);
+    pthread_join(thread, NULL);
+
+    set_simd_features(all_features);
+
+    return result;
+#else
+    return NULL;
+#endif
+}
+
+
+char * test_thread_pool_shutdown ()
+{
+    char * result = NULL;
+
+    shutdown_thread_pool();
+    CUTS_ASSERT(!get_thread_pool(), "Thread pool should not be available after shutdown");
+
+    // Parallel operations fall back to the calling thread
+    result = check_conversions(TEST_WIDTH, TEST_HEIGHT, NULL);
+    if (!result) result = check_batch_conversions(TEST_WIDTH, TEST_HEIGHT, NULL);
+
+    return result;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_thread_pool_init);
+    CUTS_RUN_TEST(test_internal_pool_conversions);
+    CUTS_RUN_TEST(test_internal_pool_flips);
+    CUTS_RUN_TEST(test_internal_pool_batch_conversions);
+    CUTS_RUN_TEST(test_caller_supplied_pool);
+    CUTS_RUN_TEST(test_incorrect_parallel_operations);
+    CUTS_RUN_TEST(test_switching_simd_features);
+    CUTS_RUN_TEST(test_thread_pool_shutdown);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);
@@ -0,0 +1,235 @@
+#include "cuts.h"
+
+#include "libuimg.h"
+
+
+#define TEST_WIDTH 37
+#define TEST_HEIGHT 23
+#define TEST_FRAME_COUNT 6
+#define TEST_READER_MEMORY_SIZE 16384
+
+
+// The memory of the readers, in static memory
+static uint8_t reader_memory[TEST_READER_MEMORY_SIZE];
+
+
+static void fill_pseudo_random (Image_t * img, uint32_t seed)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < get_image_data_size(img->width, img->height, img->format); i++) {
+        seed = seed * 1103515245 + 12345;
+        img->data[i] = seed >> 16;
+    }
+}
+
+
+// Open a reader and give it its memory
+static uint8_t open_test_reader (Y4MReader_t * reader, FILE * file)
+{
+    if (!open_y4m_reader(reader, file)) return 0;
+    if (get_y4m_reader_memory_size(reader) > TEST_READER_MEMORY_SIZE) return 0;
+
+    return start_y4m_reader(reader, reader_memory);
+}
+
+
+char * test_y4m_round_trip ()
+{
+    PixelFormat_t formats[3] = { YUV420p, YUV444p, GRAYSCALE };
+    uint8_t k = 0;
+    uint32_t i = 0;
+    FILE * file = NULL;
+    Image_t * img = NULL;
+    Image_t frame;
+    Y4MWriter_t writer;
+    Y4MReader_t reader;
+
+    for (k = 0; k < 3; k++) {
+        file = tmpfile();
+        img = create_image(TEST_WIDTH, TEST_HEIGHT, formats[k]);
+        CUTS_ASSERT(file, "Could not create temporary file");
+
+        CUTS_ASSERT(open_y4m_writer(&writer, file, TEST_WIDTH, TEST_HEIGHT, formats[k], 30000, 1001),
+                    "Could not open writer (format %d)", formats[k]);
+        for (i = 0; i < TEST_FRAME_COUNT; i++) {
+            fill_pseudo_random(img, i);
+            CUTS_ASSERT(write_y4m_frame(&writer, img), "Could not write frame %d", i);
+        }
+
+        rewind(file);
+        CUTS_ASSERT(open_test_reader(&reader, file), "Could not open reader (format %d)", formats[k]);
+        CUTS_ASSERT(reader.width == TEST_WIDTH && reader.height == TEST_HEIGHT && reader.format == formats[k],
+                    "Wrong stream dimensions or format");
+        CUTS_ASSERT(reader.frame_rate_num == 30000 && reader.frame_rate_den == 1001, "Wrong frame rate");
+
+        // Frames come out in order, whether they are read ahead or not
+        for (i = 0; i < TEST_FRAME_COUNT; i++) {
+            fill_pseudo_random(img, i);
+            CUTS_ASSERT(read_y4m_frame(&reader, &frame), "Could not read frame %d", i);
+            CUTS_ASSERT(frame.width == TEST_WIDTH && frame.height == TEST_HEIGHT && frame.format == formats[k],
+                        "Wrong frame dimensions or format");
+            CUTS_ASSERT(!memcmp(frame.data, img->data, get_image_data_size(TEST_WIDTH, TEST_HEIGHT, formats[k])),
+                        "Frame %d differs (format %d)", i, formats[k]);
+        }
+        CUTS_ASSERT(!read_y4m_frame(&reader, &frame), "No frame should be read past the end of the stream");
+        CUTS_ASSERT(!read_y4m_frame(&reader, &frame), "No frame should be read past the end of the stream");
+
+        close_y4m_reader(&reader);
+        fclose(file);
+        destroy_image(img);
+    }
+
+    return NULL;
+}
+
+
+char * test_y4m_header_parsing ()
+{
+    const char * stream = "YUV4MPEG2 W4 H2 F25:1 It A1:1 C444 XYSCSS=444\nFRAME Ixyz\n"
+                          "abcdefghijklmnopqrstuvwx";
+    FILE * file = tmpfile();
+    Image_t frame;
+    Y4MReader_t reader;
+
+    CUTS_ASSERT(file, "Could not create temporary file");
+    fputs(stream, file);
+    rewind(file);
+
+    // Unknown parameters (stream and frame) are ignored
+    CUTS_ASSERT(open_test_reader(&reader, file), "Could not open reader");
+    CUTS_ASSERT(reader.width == 4 && reader.height == 2 && reader.format == YUV444p, "Wrong stream parameters");
+    CUTS_ASSERT(read_y4m_frame(&reader, &frame), "Could not read frame");
+    CUTS_ASSERT(!memcmp(frame.data, "abcdefghijklmnopqrstuvwx", 24), "Wrong frame data");
+    CUTS_ASSERT(!read_y4m_frame(&reader, &frame), "No frame should be read past the end of the stream");
+    close_y4m_reader(&reader);
+
+    // Streams are 4:2:0 unless specified otherwise
+    rewind(file);
+    fputs("YUV4MPEG2 W4 H2 F25:1\nFRAME\nabcdefghijkl", file);
+    rewind(file);
+    CUTS_ASSERT(open_test_reader(&reader, file), "Could not open reader");
+    CUTS_ASSERT(reader.format == YUV420p, "Streams should default to YUV420p");
+    CUTS_ASSERT(read_y4m_frame(&reader, &frame), "Could not read frame");
+    CUTS_ASSERT(!memcmp(get_image_plane(&frame, 2), "kl", 2), "Wrong V plane");
+    close_y4m_reader(&reader);
+
+    fclose(file);
+
+    return NULL;
+}
+
+
+char * test_y4m_view_writing ()
+{
+    uint8_t plane = 0;
+    uint16_t row = 0;
+    FILE * file = tmpfile();
+    Image_t * parent_img = create_image(TEST_WIDTH, TEST_HEIGHT, YUV420p);
+    Image_t view;
+    Image_t frame;
+    Y4MWriter_t writer;
+    Y4MReader_t reader;
+
+    fill_pseudo_random(parent_img, 5);
+    CUTS_ASSERT(create_image_view(parent_img, 4, 2, 20, 16, &view), "Could not create view");
+
+    CUTS_ASSERT(open_y4m_writer(&writer, file, 20, 16, YUV420p, 25, 1), "Could not open writer");
+    CUTS_ASSERT(write_y4m_frame(&writer, &view), "Could not write view");
+    rewind(file);
+
+    CUTS_ASSERT(open_test_reader(&reader, file), "Could not open reader");
+    CUTS_ASSERT(read_y4m_frame(&reader, &frame), "Could not read frame");
+    for (plane = 0; plane < 3; plane++) {
+        for (row = 0; row < get_image_plane_height(16, YUV420p, plane); row++) {
+            CUTS_ASSERT(!memcmp(get_image_row(&frame, plane, row), get_image_row(&view, plane, row),
+                                get_image_row_size(20, YUV420p, plane)),
+                        "Row %d of plane %d differs", row, plane);
+        }
+    }
+    close_y4m_reader(&reader);
+
+    fclose(file);
+    destroy_image(parent_img);
+
+    return NULL;
+}
+
+
+char * test_incorrect_y4m_streams ()
+{
+    const char * streams[6] = {
+        "YUV4MPEG W4 H2\n",
+        "YUV4MPEG2 W4 H2 C422\n",
+        "YUV4MPEG2 W4 H2 C420p10\n",
+        "YUV4MPEG2 W4 C420\n",
+        "YUV4MPEG2 W4 H2 F25",
+        // Frames of more than 4 GB, whose size wraps around to 65,534 bytes in 32 bits
+        "YUV4MPEG2 W65535 H21846 C444\n"
+    };
+    uint8_t k = 0;
+    FILE * file = NULL;
+    Image_t frame;
+    Image_t * img = create_image(4, 2, RGB24);
+    Y4MReader_t reader;
+    Y4MWriter_t writer;
+    PixelFormat_t format = ASCII;
+
+    for (k = 0; k < 6; k++) {
+        file = tmpfile();
+        fputs(streams[k], file);
+        rewind(file);
+        CUTS_ASSERT(!open_y4m_reader(&reader, file), "Stream header %d should be rejected", k);
+        fclose(file);
+    }
+
+    // Truncated frames are not handed out
+    file = tmpfile();
+    fputs("YUV4MPEG2 W4 H2 Cmono\nFRAME\nabcdefgh\nFRAME\nabc", file);
+    rewind(file);
+    CUTS_ASSERT(open_test_reader(&reader, file), "Could not open reader");
+    CUTS_ASSERT(read_y4m_frame(&reader, &frame), "Could not read frame");
+    CUTS_ASSERT(!read_y4m_frame(&reader, &frame), "Data that is not a frame should be rejected");
+    close_y4m_reader(&reader);
+
+    // Frames are only read once the reader has its memory
+    rewind(file);
+    CUTS_ASSERT(open_y4m_reader(&reader, file), "Could not open reader");
+    CUTS_ASSERT(get_y4m_reader_memory_size(&reader) >= 8, "Wrong memory size");
+    CUTS_ASSERT(!read_y4m_frame(&reader, &frame), "Readers without memory should not read frames");
+    CUTS_ASSERT(!start_y4m_reader(&reader, NULL), "NULL memory should be rejected");
+    CUTS_ASSERT(start_y4m_reader(&reader, reader_memory), "Could not start reader");
+    CUTS_ASSERT(!start_y4m_reader(&reader, reader_memory), "Readers should not be started twice");
+    CUTS_ASSERT(read_y4m_frame(&reader, &frame), "Could not read frame");
+    close_y4m_reader(&reader);
+
+    rewind(file);
+    CUTS_ASSERT(!open_y4m_writer(&writer, file, 4, 2, RGB24, 25, 1), "Non-YUV formats should be rejected");
+    CUTS_ASSERT(!open_y4m_writer(&writer, file, 4, 2, YUV420p, 25, 0), "Null frame rates should be rejected");
+    CUTS_ASSERT(open_y4m_writer(&writer, file, 4, 2, GRAYSCALE, 25, 1), "Could not open writer");
+    CUTS_ASSERT(!write_y4m_frame(&writer, img), "Frames of another format should be rejected");
+    fclose(file);
+
+    CUTS_ASSERT(!get_y4m_colorspace_format("mono16", &format), "16-bit colorspaces should be rejected");
+    CUTS_ASSERT(get_y4m_colorspace_format("420paldv", &format) && format == YUV420p, "Wrong 4:2:0 format");
+
+    destroy_image(img);
+
+    return NULL;
+}
+
+
+char * all_tests ()
+{
+    CUTS_START();
+
+    CUTS_RUN_TEST(test_y4m_round_trip);
+    CUTS_RUN_TEST(test_y4m_header_parsing);
+    CUTS_RUN_TEST(test_y4m_view_writing);
+    CUTS_RUN_TEST(test_incorrect_y4m_streams);
+
+    return NULL;
+}
+
+
+CUTS_RUN_SUITE(all_tests);